@@ -29,6 +29,21 @@ AC_DEFUN([AX_LIBEWF_CHECK_LOCAL],
 
  dnl Check for internationalization functions in libewf/libewf_i18n.c 
  AC_CHECK_FUNCS([bindtextdomain])
+
+ dnl Headers and functions used in libewf/libewf_memory_mapped_file_io_handle.c
+ AC_CHECK_HEADERS([fcntl.h sys/mman.h sys/stat.h unistd.h])
+ AC_CHECK_FUNCS([madvise mmap munmap pread])
+
+ dnl Functions used in libewf/libewf_direct_file_io_handle.c and common/memory.h
+ AC_CHECK_FUNCS([ftruncate posix_memalign pwrite])
+
+ dnl Sub-second modification time used in libewf/libewf_chunk_index.c
+ AC_CHECK_MEMBERS(
+  [struct stat.st_mtim.tv_nsec, struct stat.st_mtimespec.tv_nsec],
+  [],
+  [],
+  [[#include <sys/types.h>
+#include <sys/stat.h>]])
  ])
 
 dnl Function to determine the host operating system
@@ -0,0 +1,699 @@
+/*
+ * Compression level controller functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( WINAPI )
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "compression_level_controller.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+
+/* The compression levels ordered from the fastest to the best compression
+ */
+int8_t compression_level_controller_levels[ COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS ] = {
+	LIBEWF_COMPRESSION_NONE,
+	LIBEWF_COMPRESSION_FAST,
+	LIBEWF_COMPRESSION_DEFAULT,
+	LIBEWF_COMPRESSION_BEST };
+
+/* The compression level strings
+ */
+const char *compression_level_controller_level_strings[ COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS ] = {
+	"none:",
+	"fast:",
+	"default:",
+	"best:" };
+
+/* Creates a compression level controller
+ * Make sure the value compression_level_controller is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int compression_level_controller_initialize(
+     compression_level_controller_t **compression_level_controller,
+     int8_t compression_level,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "compression_level_controller_initialize";
+	int level_index       = 0;
+
+	if( compression_level_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression level controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_level_controller != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression level controller value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	for( level_index = 0;
+	     level_index < COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS;
+	     level_index++ )
+	{
+		if( compression_level_controller_levels[ level_index ] == compression_level )
+		{
+			break;
+		}
+	}
+	if( level_index >= COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_level_controller = memory_allocate_structure(
+	                                 compression_level_controller_t );
+
+	if( *compression_level_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression level controller.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_level_controller,
+	     0,
+	     sizeof( compression_level_controller_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression level controller.",
+		 function );
+
+		memory_free(
+		 *compression_level_controller );
+
+		*compression_level_controller = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *compression_level_controller )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	/* In single-threaded mode the chunks are processed by the reading thread
+	 */
+	if( number_of_threads == 0 )
+	{
+		number_of_threads = 1;
+	}
+	( *compression_level_controller )->number_of_threads = number_of_threads;
+	( *compression_level_controller )->level_index       = level_index;
+
+	return( 1 );
+
+on_error:
+	if( *compression_level_controller != NULL )
+	{
+		memory_free(
+		 *compression_level_controller );
+
+		*compression_level_controller = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression level controller
+ * Returns 1 if successful or -1 on error
+ */
+int compression_level_controller_free(
+     compression_level_controller_t **compression_level_controller,
+     libcerror_error_t **error )
+{
+	static char *function = "compression_level_controller_free";
+	int result            = 1;
+
+	if( compression_level_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression level controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_level_controller != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *compression_level_controller )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *compression_level_controller );
+
+		*compression_level_controller = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the current time of a monotonic clock in nano seconds
+ * Returns 1 if successful or -1 on error
+ */
+int compression_level_controller_get_current_time(
+     uint64_t *current_time,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_value;
+
+#else
+	time_t time_value     = 0;
+#endif
+
+	static char *function = "compression_level_controller_get_current_time";
+
+	if( current_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid current time.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 )
+	 || ( frequency.QuadPart <= 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve performance counter.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = ( (uint64_t) ( counter.QuadPart / frequency.QuadPart ) * 1000000000UL )
+	              + ( ( (uint64_t) ( counter.QuadPart % frequency.QuadPart ) * 1000000000UL ) / (uint64_t) frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve monotonic clock time.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec;
+
+#else
+	/* Without a high resolution clock most durations are 0 and the compression level is not changed
+	 */
+	time_value = time(
+	              NULL );
+
+	if( time_value == (time_t) -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve time.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = (uint64_t) time_value * 1000000000UL;
+#endif
+	return( 1 );
+}
+
+/* Retrieves the compression level that should be used for the next chunk
+ * Returns 1 if successful or -1 on error
+ */
+int compression_level_controller_get_compression_level(
+     compression_level_controller_t *compression_level_controller,
+     int8_t *compression_level,
+     libcerror_error_t **error )
+{
+	static char *function = "compression_level_controller_get_compression_level";
+
+	if( compression_level_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression level controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression level.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_level_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*compression_level = compression_level_controller_levels[ compression_level_controller->level_index ];
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_level_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Adds the size and duration of a read of the input
+ * Returns 1 if successful or -1 on error
+ */
+int compression_level_controller_add_read(
+     compression_level_controller_t *compression_level_controller,
+     size64_t read_size,
+     uint64_t read_time,
+     libcerror_error_t **error )
+{
+	static char *function = "compression_level_controller_add_read";
+
+	if( compression_level_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression level controller.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_level_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	compression_level_controller->window_read_size += (uint64_t) read_size;
+	compression_level_controller->window_read_time += read_time;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_level_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Adds the size and duration of processing (compressing) a chunk
+ * At the end of every window the throughput estimates are updated and
+ * the compression level is lowered if the compression can no longer keep up
+ * with the input or raised if there is headroom for a better compression
+ * Returns 1 if successful or -1 on error
+ */
+int compression_level_controller_add_process(
+     compression_level_controller_t *compression_level_controller,
+     int8_t compression_level,
+     size64_t process_size,
+     uint64_t process_time,
+     libcerror_error_t **error )
+{
+	static char *function        = "compression_level_controller_add_process";
+	uint64_t capacity            = 0;
+	uint64_t next_level_capacity = 0;
+	uint64_t target_throughput   = 0;
+	uint64_t throughput          = 0;
+	int level_index              = 0;
+
+	if( compression_level_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression level controller.",
+		 function );
+
+		return( -1 );
+	}
+	for( level_index = 0;
+	     level_index < COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS;
+	     level_index++ )
+	{
+		if( compression_level_controller_levels[ level_index ] == compression_level )
+		{
+			break;
+		}
+	}
+	if( level_index >= COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_level_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	compression_level_controller->number_of_chunks[ level_index ]    += 1;
+	compression_level_controller->window_process_size[ level_index ] += (uint64_t) process_size;
+	compression_level_controller->window_process_time[ level_index ] += process_time;
+	compression_level_controller->window_number_of_chunks            += 1;
+
+	if( compression_level_controller->window_number_of_chunks >= COMPRESSION_LEVEL_CONTROLLER_WINDOW_SIZE )
+	{
+		/* The throughput estimates are exponentially weighted moving averages in bytes per milli second
+		 */
+		if( compression_level_controller->window_read_time >= 1000000 )
+		{
+			throughput = ( compression_level_controller->window_read_size * 1000000 )
+			           / compression_level_controller->window_read_time;
+
+			if( compression_level_controller->read_throughput == 0 )
+			{
+				compression_level_controller->read_throughput = throughput;
+			}
+			else
+			{
+				compression_level_controller->read_throughput = ( ( compression_level_controller->read_throughput * 3 ) + throughput ) / 4;
+			}
+			compression_level_controller->window_read_size = 0;
+			compression_level_controller->window_read_time = 0;
+		}
+		for( level_index = 0;
+		     level_index < COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS;
+		     level_index++ )
+		{
+			if( compression_level_controller->window_process_time[ level_index ] == 0 )
+			{
+				continue;
+			}
+			throughput = ( compression_level_controller->window_process_size[ level_index ] * 1000000 )
+			           / compression_level_controller->window_process_time[ level_index ];
+
+			if( throughput == 0 )
+			{
+				throughput = 1;
+			}
+			if( compression_level_controller->process_throughput[ level_index ] == 0 )
+			{
+				compression_level_controller->process_throughput[ level_index ] = throughput;
+			}
+			else
+			{
+				compression_level_controller->process_throughput[ level_index ] = ( ( compression_level_controller->process_throughput[ level_index ] * 3 ) + throughput ) / 4;
+			}
+			compression_level_controller->window_process_size[ level_index ] = 0;
+			compression_level_controller->window_process_time[ level_index ] = 0;
+		}
+		compression_level_controller->window_number_of_chunks = 0;
+
+		level_index = compression_level_controller->level_index;
+		capacity    = compression_level_controller->process_throughput[ level_index ]
+		            * compression_level_controller->number_of_threads;
+
+		/* Without a read throughput or process throughput estimate the compression level is retained
+		 */
+		if( ( compression_level_controller->read_throughput != 0 )
+		 && ( capacity != 0 ) )
+		{
+			target_throughput = compression_level_controller->read_throughput
+			                  + ( ( compression_level_controller->read_throughput * COMPRESSION_LEVEL_CONTROLLER_HEADROOM_PERCENTAGE ) / 100 );
+
+			if( capacity < target_throughput )
+			{
+				if( level_index > 0 )
+				{
+					compression_level_controller->level_index                  -= 1;
+					compression_level_controller->number_of_windows_since_probe = 0;
+				}
+			}
+			else if( level_index < ( COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS - 1 ) )
+			{
+				next_level_capacity = compression_level_controller->process_throughput[ level_index + 1 ]
+				                    * compression_level_controller->number_of_threads;
+
+				/* A higher level that was too slow before is only tried again after a number of windows
+				 * since the compressibility of the input can change
+				 */
+				if( ( next_level_capacity == 0 )
+				 || ( next_level_capacity >= target_throughput )
+				 || ( compression_level_controller->number_of_windows_since_probe >= COMPRESSION_LEVEL_CONTROLLER_PROBE_INTERVAL ) )
+				{
+					compression_level_controller->level_index                  += 1;
+					compression_level_controller->number_of_windows_since_probe = 0;
+				}
+				else
+				{
+					compression_level_controller->number_of_windows_since_probe += 1;
+				}
+			}
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_level_controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Prints the distribution of the compression levels to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int compression_level_controller_fprint(
+     compression_level_controller_t *compression_level_controller,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function     = "compression_level_controller_fprint";
+	uint64_t number_of_chunks = 0;
+	int level_index           = 0;
+
+	if( compression_level_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression level controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	for( level_index = 0;
+	     level_index < COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS;
+	     level_index++ )
+	{
+		number_of_chunks += compression_level_controller->number_of_chunks[ level_index ];
+	}
+	fprintf(
+	 stream,
+	 "Adaptive compression level distribution:\n" );
+
+	for( level_index = 0;
+	     level_index < COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS;
+	     level_index++ )
+	{
+		fprintf(
+		 stream,
+		 "\t%-9s %" PRIu64 " chunks",
+		 compression_level_controller_level_strings[ level_index ],
+		 compression_level_controller->number_of_chunks[ level_index ] );
+
+		if( number_of_chunks > 0 )
+		{
+			fprintf(
+			 stream,
+			 " (%" PRIu64 "%%)",
+			 ( compression_level_controller->number_of_chunks[ level_index ] * 100 ) / number_of_chunks );
+		}
+		fprintf(
+		 stream,
+		 "\n" );
+	}
+	fprintf(
+	 stream,
+	 "\n" );
+
+	return( 1 );
+}
+
@@ -0,0 +1,150 @@
+/*
+ * Compression level controller functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _COMPRESSION_LEVEL_CONTROLLER_H )
+#define _COMPRESSION_LEVEL_CONTROLLER_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of compression levels the controller can select from
+ */
+#define COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS		4
+
+/* The number of chunks processed before the compression level is reconsidered
+ */
+#define COMPRESSION_LEVEL_CONTROLLER_WINDOW_SIZE		32
+
+/* The percentage the compression throughput should exceed the read throughput
+ */
+#define COMPRESSION_LEVEL_CONTROLLER_HEADROOM_PERCENTAGE	10
+
+/* The number of windows after which a previously rejected higher level is tried again
+ */
+#define COMPRESSION_LEVEL_CONTROLLER_PROBE_INTERVAL		16
+
+typedef struct compression_level_controller compression_level_controller_t;
+
+struct compression_level_controller
+{
+	/* The number of threads that process (compress) the chunks
+	 */
+	int number_of_threads;
+
+	/* The index of the current compression level
+	 */
+	int level_index;
+
+	/* The read size of the current window
+	 */
+	uint64_t window_read_size;
+
+	/* The read time of the current window in nano seconds
+	 */
+	uint64_t window_read_time;
+
+	/* The process size per compression level of the current window
+	 */
+	uint64_t window_process_size[ COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS ];
+
+	/* The process time per compression level of the current window in nano seconds
+	 */
+	uint64_t window_process_time[ COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS ];
+
+	/* The number of chunks processed in the current window
+	 */
+	int window_number_of_chunks;
+
+	/* The number of windows since a higher compression level was tried
+	 */
+	int number_of_windows_since_probe;
+
+	/* The estimated read throughput in bytes per milli second
+	 */
+	uint64_t read_throughput;
+
+	/* The estimated process throughput of a single thread per compression level
+	 * in bytes per milli second, 0 if not measured
+	 */
+	uint64_t process_throughput[ COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS ];
+
+	/* The number of chunks processed per compression level
+	 */
+	uint64_t number_of_chunks[ COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS ];
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int compression_level_controller_initialize(
+     compression_level_controller_t **compression_level_controller,
+     int8_t compression_level,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int compression_level_controller_free(
+     compression_level_controller_t **compression_level_controller,
+     libcerror_error_t **error );
+
+int compression_level_controller_get_current_time(
+     uint64_t *current_time,
+     libcerror_error_t **error );
+
+int compression_level_controller_get_compression_level(
+     compression_level_controller_t *compression_level_controller,
+     int8_t *compression_level,
+     libcerror_error_t **error );
+
+int compression_level_controller_add_read(
+     compression_level_controller_t *compression_level_controller,
+     size64_t read_size,
+     uint64_t read_time,
+     libcerror_error_t **error );
+
+int compression_level_controller_add_process(
+     compression_level_controller_t *compression_level_controller,
+     int8_t compression_level,
+     size64_t process_size,
+     uint64_t process_time,
+     libcerror_error_t **error );
+
+int compression_level_controller_fprint(
+     compression_level_controller_t *compression_level_controller,
+     FILE *stream,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _COMPRESSION_LEVEL_CONTROLLER_H ) */
+
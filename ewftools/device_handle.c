@@ -1019,6 +1019,17 @@ ssize_t device_handle_read_storage_media_buffer(
 
 		return( -1 );
 	}
+	if( read_size > storage_media_buffer->raw_buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
 	{
 		read_count = libsmdev_handle_read_buffer(
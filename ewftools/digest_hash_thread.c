@@ -0,0 +1,535 @@
+/*
+ * Digest hash thread
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_hash_thread.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a digest hash thread
+ * Make sure the value digest_hash_thread is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_thread_initialize(
+     digest_hash_thread_t **digest_hash_thread,
+     intptr_t *context,
+     int (*update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t size,
+            libcerror_error_t **error ),
+     libcthreads_queue_t *storage_media_buffer_queue,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_thread_initialize";
+
+	if( digest_hash_thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_hash_thread != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest hash thread value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( update_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid update function.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer queue.",
+		 function );
+
+		return( -1 );
+	}
+	*digest_hash_thread = memory_allocate_structure(
+	                       digest_hash_thread_t );
+
+	if( *digest_hash_thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest hash thread.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *digest_hash_thread,
+	     0,
+	     sizeof( digest_hash_thread_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest hash thread.",
+		 function );
+
+		memory_free(
+		 *digest_hash_thread );
+
+		*digest_hash_thread = NULL;
+
+		return( -1 );
+	}
+	( *digest_hash_thread )->context                    = context;
+	( *digest_hash_thread )->update_function            = update_function;
+	( *digest_hash_thread )->storage_media_buffer_queue = storage_media_buffer_queue;
+
+	/* A single thread is used so that the storage media buffers are hashed
+	 * in the order they were pushed
+	 */
+	if( libcthreads_thread_pool_create(
+	     &( ( *digest_hash_thread )->thread_pool ),
+	     NULL,
+	     1,
+	     maximum_number_of_queued_items,
+	     (int (*)(intptr_t *, void *)) &digest_hash_thread_update_callback,
+	     (void *) *digest_hash_thread,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *digest_hash_thread != NULL )
+	{
+		memory_free(
+		 *digest_hash_thread );
+
+		*digest_hash_thread = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a digest hash thread
+ * The thread is joined if this was not done before
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_thread_free(
+     digest_hash_thread_t **digest_hash_thread,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_thread_free";
+	int result            = 1;
+
+	if( digest_hash_thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_hash_thread != NULL )
+	{
+		if( ( *digest_hash_thread )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *digest_hash_thread )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *digest_hash_thread );
+
+		*digest_hash_thread = NULL;
+	}
+	return( result );
+}
+
+/* Pushes a storage media buffer onto the digest hash thread
+ * The buffer must be referenced on behalf of the digest hash thread,
+ * the reference is released after the buffer has been hashed
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_thread_push_buffer(
+     digest_hash_thread_t *digest_hash_thread,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_thread_push_buffer";
+
+	if( digest_hash_thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_pool_push(
+	     digest_hash_thread->thread_pool,
+	     (intptr_t *) storage_media_buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto thread pool queue.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Joins the digest hash thread after all pushed storage media buffers have been hashed
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_thread_join(
+     digest_hash_thread_t *digest_hash_thread,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_thread_join";
+
+	if( digest_hash_thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_hash_thread->thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( digest_hash_thread->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( digest_hash_thread->update_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest hash.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Updates the digest hash with the data of a storage media buffer
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_thread_update_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     digest_hash_thread_t *digest_hash_thread )
+{
+        libcerror_error_t *error = NULL;
+        static char *function    = "digest_hash_thread_update_callback";
+
+	if( digest_hash_thread == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash thread.",
+		 function );
+
+		goto on_error;
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	/* Once an update failed the digest hash is no longer valid
+	 */
+	if( ( digest_hash_thread->update_failed == 0 )
+	 && ( storage_media_buffer->digest_hash_data_size > 0 ) )
+	{
+		if( digest_hash_thread->update_function(
+		     digest_hash_thread->context,
+		     storage_media_buffer->raw_buffer,
+		     storage_media_buffer->digest_hash_data_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hash.",
+			 function );
+
+			digest_hash_thread->update_failed = 1;
+
+			goto on_error;
+		}
+	}
+	if( storage_media_buffer_queue_release_buffer(
+	     digest_hash_thread->storage_media_buffer_queue,
+	     storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to release storage media buffer onto queue.",
+		 function );
+
+		storage_media_buffer = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( ( digest_hash_thread != NULL )
+	 && ( storage_media_buffer != NULL ) )
+	{
+		storage_media_buffer_queue_release_buffer(
+		 digest_hash_thread->storage_media_buffer_queue,
+		 storage_media_buffer,
+		 NULL );
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Pushes a storage media buffer onto multiple digest hash threads
+ * A reference to the buffer is added for every digest hash thread, the reference
+ * of the caller is not affected
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_push_buffer(
+     digest_hash_thread_t **digest_hash_threads,
+     int number_of_digest_hash_threads,
+     storage_media_buffer_t *storage_media_buffer,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_threads_push_buffer";
+	int thread_index      = 0;
+
+	if( digest_hash_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_digest_hash_threads < 0 )
+	 || ( number_of_digest_hash_threads > DIGEST_HASH_THREAD_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of digest hash threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > storage_media_buffer->raw_buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_digest_hash_threads == 0 )
+	{
+		return( 1 );
+	}
+	storage_media_buffer->digest_hash_data_size = data_size;
+
+	/* The references are added before the buffer is pushed so that
+	 * the buffer cannot be released onto the queue while it is being hashed
+	 */
+	if( storage_media_buffer_add_references(
+	     storage_media_buffer,
+	     number_of_digest_hash_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add references to storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_digest_hash_threads;
+	     thread_index++ )
+	{
+		if( digest_hash_thread_push_buffer(
+		     digest_hash_threads[ thread_index ],
+		     storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer onto digest hash thread: %d.",
+			 function,
+			 thread_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	/* Release the references of the digest hash threads the buffer was not pushed onto
+	 */
+	while( thread_index < number_of_digest_hash_threads )
+	{
+		storage_media_buffer_remove_reference(
+		 storage_media_buffer,
+		 NULL );
+
+		thread_index++;
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,117 @@
+/*
+ * Digest hash thread
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIGEST_HASH_THREAD_H )
+#define _DIGEST_HASH_THREAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The maximum number of digest hash threads, one for MD5, SHA1 and SHA256
+ */
+#define DIGEST_HASH_THREAD_MAXIMUM_NUMBER_OF_THREADS	3
+
+typedef struct digest_hash_thread digest_hash_thread_t;
+
+/* A digest hash thread updates a single digest hash context
+ * with the data of storage media buffers in the order they were pushed
+ */
+struct digest_hash_thread
+{
+	/* The digest hash context
+	 */
+	intptr_t *context;
+
+	/* The digest hash update function
+	 */
+	int (*update_function)(
+	       intptr_t *context,
+	       const uint8_t *buffer,
+	       size_t size,
+	       libcerror_error_t **error );
+
+	/* The storage media buffer queue
+	 */
+	libcthreads_queue_t *storage_media_buffer_queue;
+
+	/* The thread pool, which consists of a single thread
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* Value to indicate the digest hash context could not be updated
+	 */
+	uint8_t update_failed;
+};
+
+int digest_hash_thread_initialize(
+     digest_hash_thread_t **digest_hash_thread,
+     intptr_t *context,
+     int (*update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t size,
+            libcerror_error_t **error ),
+     libcthreads_queue_t *storage_media_buffer_queue,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error );
+
+int digest_hash_thread_free(
+     digest_hash_thread_t **digest_hash_thread,
+     libcerror_error_t **error );
+
+int digest_hash_thread_push_buffer(
+     digest_hash_thread_t *digest_hash_thread,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+int digest_hash_thread_join(
+     digest_hash_thread_t *digest_hash_thread,
+     libcerror_error_t **error );
+
+int digest_hash_thread_update_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     digest_hash_thread_t *digest_hash_thread );
+
+int digest_hash_threads_push_buffer(
+     digest_hash_thread_t **digest_hash_threads,
+     int number_of_digest_hash_threads,
+     storage_media_buffer_t *storage_media_buffer,
+     size_t data_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIGEST_HASH_THREAD_H ) */
+
@@ -31,6 +31,7 @@
 #endif
 
 #include "byte_size_string.h"
+#include "compression_level_controller.h"
 #include "device_handle.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
@@ -121,7 +122,7 @@ void ewfacquire_usage_fprint(
 	                 "                  [ -o offset ] [ -p process_buffer_size ]\n"
 	                 "                  [ -P bytes_per_sector ] [ -r read_error_retries ]\n"
 	                 "                  [ -S segment_file_size ] [ -t target ] [ -T toc_file ]\n"
-	                 "                  [ -2 secondary_target ] [ -hqRsuvVwx ] source\n\n" );
+	                 "                  [ -2 secondary_target ] [ -hOqRsuvVwx ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file(s) or device\n\n" );
 
@@ -142,7 +143,8 @@ void ewfacquire_usage_fprint(
 	                 "\t        compression method options: deflate (default)\n"
 #endif
 	                 "\t        compression level options: none (default), empty-block,\n"
-	                 "\t        fast or best\n" );
+	                 "\t        fast, best or adaptive (adjusts the level per chunk to\n"
+	                 "\t        keep up with the read speed of the input)\n" );
 	fprintf( stream, "\t-C:     specify the case number (default is case_number).\n" );
 	fprintf( stream, "\t-d:     calculate additional digest (hash) types besides md5, options:\n"
 	                 "\t        sha1, sha256\n" );
@@ -163,6 +165,8 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-M:     specify the media flags, options: logical, physical (default)\n" );
 	fprintf( stream, "\t-N:     specify the notes (default is notes).\n" );
 	fprintf( stream, "\t-o:     specify the offset to start to acquire (default is 0)\n" );
+	fprintf( stream, "\t-O:     write the segment files using direct IO, which bypasses the page\n"
+	                 "\t        cache if supported by the operating system\n" );
 	fprintf( stream, "\t-p:     specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-P:     specify the number of bytes per sector (default is 512)\n"
 	                 "\t        (use this to override the automatic bytes per sector detection)\n" );
@@ -587,9 +591,12 @@ int ewfacquire_read_input(
 	ssize_t read_count                           = 0;
 	ssize_t process_count                        = 0;
 	ssize_t write_count                          = 0;
+	uint64_t read_end_time                       = 0;
+	uint64_t read_start_time                     = 0;
 	uint32_t chunk_size                          = 0;
 	uint8_t storage_media_buffer_mode            = 0;
 	int maximum_number_of_queued_items           = 0;
+	int result                                   = 0;
 	int number_of_read_errors                    = 0;
 	int read_error_iterator                      = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
@@ -762,6 +769,31 @@ int ewfacquire_read_input(
 
 		goto on_error;
 	}
+	/* The adaptive compression level is set per chunk which requires the chunk data functions
+	 */
+	if( imaging_handle->use_adaptive_compression_level != 0 )
+	{
+		use_chunk_data_functions = 1;
+
+		if( imaging_handle->compression_level_controller == NULL )
+		{
+			if( compression_level_controller_initialize(
+			     &( imaging_handle->compression_level_controller ),
+			     imaging_handle->compression_level,
+			     imaging_handle->number_of_threads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create compression level controller.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
 	if( use_chunk_data_functions != 0 )
 	{
 		process_buffer_size       = (size_t) chunk_size;
@@ -865,6 +897,25 @@ int ewfacquire_read_input(
 
 		goto on_error;
         }
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->number_of_threads != 0 )
+	{
+		if( imaging_handle_start_integrity_hash_threads(
+		     imaging_handle,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start integrity hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( process_status_initialize(
 	     &( imaging_handle->process_status ),
 	     _SYSTEM_STRING( "Acquiry" ),
@@ -1033,6 +1084,22 @@ int ewfacquire_read_input(
 		}
 		else
 		{
+			if( imaging_handle->compression_level_controller != NULL )
+			{
+				if( compression_level_controller_get_current_time(
+				     &read_start_time,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve read start time.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			read_count = device_handle_read_storage_media_buffer(
 				      device_handle,
 				      storage_media_buffer,
@@ -1051,6 +1118,37 @@ int ewfacquire_read_input(
 
 				goto on_error;
 			}
+			if( imaging_handle->compression_level_controller != NULL )
+			{
+				if( compression_level_controller_get_current_time(
+				     &read_end_time,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve read end time.",
+					 function );
+
+					goto on_error;
+				}
+				if( compression_level_controller_add_read(
+				     imaging_handle->compression_level_controller,
+				     (size64_t) read_count,
+				     read_end_time - read_start_time,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to add read statistics to compression level controller.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			if( read_count == 0 )
 			{
 				libcerror_error_set(
@@ -1103,11 +1201,26 @@ int ewfacquire_read_input(
 		}
 		/* Digest hashes are calcultated after swap
 		 */
-		if( imaging_handle_update_integrity_hash(
-		     imaging_handle,
-		     data,
-		     read_count,
-		     error ) != 1 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( imaging_handle->number_of_digest_hash_threads != 0 )
+		{
+			result = digest_hash_threads_push_buffer(
+			          imaging_handle->digest_hash_threads,
+			          imaging_handle->number_of_digest_hash_threads,
+			          storage_media_buffer,
+			          (size_t) read_count,
+			          error );
+		}
+		else
+#endif
+		{
+			result = imaging_handle_update_integrity_hash(
+			          imaging_handle,
+			          data,
+			          (size_t) read_count,
+			          error );
+		}
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -1137,6 +1250,29 @@ int ewfacquire_read_input(
 
 				goto on_error;
 			}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			/* The storage media buffer cannot be reused while it is referenced
+			 * by the digest hash threads
+			 */
+			if( imaging_handle->number_of_digest_hash_threads != 0 )
+			{
+				if( storage_media_buffer_queue_release_buffer(
+				     imaging_handle->storage_media_buffer_queue,
+				     storage_media_buffer,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to release storage media buffer onto queue.",
+					 function );
+
+					goto on_error;
+				}
+				storage_media_buffer = NULL;
+			}
+#endif
 		}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		else if( imaging_handle->number_of_threads != 0 )
@@ -1160,7 +1296,8 @@ int ewfacquire_read_input(
 #endif
 		else
 		{
-			process_count = storage_media_buffer_write_process(
+			process_count = imaging_handle_process_storage_media_buffer(
+					 imaging_handle,
 					 storage_media_buffer,
 					 error );
 
@@ -1260,6 +1397,22 @@ int ewfacquire_read_input(
 			goto on_error;
 		}
 	}
+	if( imaging_handle->number_of_digest_hash_threads != 0 )
+	{
+		if( imaging_handle_stop_integrity_hash_threads(
+		     imaging_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop integrity hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( imaging_handle->output_list != NULL )
 	{
 		if( imaging_handle_empty_output_list(
@@ -1453,6 +1606,20 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
+		if( imaging_handle_print_compression_statistics(
+		     imaging_handle,
+		     imaging_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print compression statistics.",
+			 function );
+
+			goto on_error;
+		}
 		if( log_handle != NULL )
 		{
 			if( device_handle_read_errors_fprint(
@@ -1483,6 +1650,20 @@ int ewfacquire_read_input(
 
 				goto on_error;
 			}
+			if( imaging_handle_print_compression_statistics(
+			     imaging_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print compression statistics in log handle.",
+				 function );
+
+				goto on_error;
+			}
 		}
 	}
 	return( 1 );
@@ -1519,6 +1700,12 @@ on_error:
 		 &( imaging_handle->output_thread_pool ),
 		 NULL );
 	}
+	if( imaging_handle->number_of_digest_hash_threads != 0 )
+	{
+		imaging_handle_stop_integrity_hash_threads(
+		 imaging_handle,
+		 NULL );
+	}
 	if( imaging_handle->output_list != NULL )
 	{
 		imaging_handle_empty_output_list(
@@ -1587,6 +1774,7 @@ int main( int argc, char * const argv[] )
 	uint8_t resume_acquiry                               = 0;
 	uint8_t swap_byte_pairs                              = 0;
 	uint8_t use_chunk_data_functions                     = 0;
+	uint8_t use_direct_io                                = 0;
 	uint8_t verbose                                      = 0;
 	uint8_t zero_buffer_on_error                         = 0;
 	int8_t acquiry_parameters_confirmed                  = 0;
@@ -1626,7 +1814,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:Op:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1741,6 +1929,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'O':
+				use_direct_io = 1;
+
+				break;
+
 			case (system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -1982,6 +2175,8 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	ewfacquire_imaging_handle->use_direct_io = use_direct_io;
+
 	if( device_handle_get_media_size(
 	     ewfacquire_device_handle,
 	     &( ewfacquire_imaging_handle->input_media_size ),
@@ -35,6 +35,7 @@
 #endif
 
 #include "byte_size_string.h"
+#include "compression_level_controller.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewfoutput.h"
@@ -137,7 +138,8 @@ void usage_fprint(
 	                 "\t    compression method options: deflate (default)\n"
 #endif
 	                 "\t    compression level options: none (default), empty-block,\n"
-	                 "\t    fast or best\n" );
+	                 "\t    fast, best or adaptive (adjusts the level per chunk to keep\n"
+	                 "\t    up with the read speed of the input)\n" );
 	fprintf( stream, "\t-C: specify the case number (default is case_number).\n" );
 	fprintf( stream, "\t-d: calculate additional digest (hash) types besides md5, options:\n"
 	                 "\t    sha1, sha256\n" );
@@ -488,8 +490,11 @@ int ewfacquirestream_read_input(
 	ssize_t read_count                           = 0;
 	ssize_t process_count                        = 0;
 	ssize_t write_count                          = 0;
+	uint64_t read_end_time                       = 0;
+	uint64_t read_start_time                     = 0;
 	uint8_t storage_media_buffer_mode            = 0;
 	int maximum_number_of_queued_items           = 0;
+	int result                                   = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
 
 	if( imaging_handle == NULL )
@@ -563,6 +568,31 @@ int ewfacquirestream_read_input(
 
 		return( -1 );
 	}
+	/* The adaptive compression level is set per chunk which requires the chunk data functions
+	 */
+	if( imaging_handle->use_adaptive_compression_level != 0 )
+	{
+		use_chunk_data_functions = 1;
+
+		if( imaging_handle->compression_level_controller == NULL )
+		{
+			if( compression_level_controller_initialize(
+			     &( imaging_handle->compression_level_controller ),
+			     imaging_handle->compression_level,
+			     imaging_handle->number_of_threads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create compression level controller.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
 	if( use_chunk_data_functions != 0 )
 	{
 		process_buffer_size       = (size_t) chunk_size;
@@ -666,6 +696,25 @@ int ewfacquirestream_read_input(
 
 		goto on_error;
         }
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->number_of_threads != 0 )
+	{
+		if( imaging_handle_start_integrity_hash_threads(
+		     imaging_handle,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start integrity hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( process_status_initialize(
 	     &( imaging_handle->process_status ),
 	     _SYSTEM_STRING( "Acquiry" ),
@@ -770,6 +819,22 @@ int ewfacquirestream_read_input(
 		{
 			read_size = (size_t) remaining_aquiry_size;
 		}
+		if( imaging_handle->compression_level_controller != NULL )
+		{
+			if( compression_level_controller_get_current_time(
+			     &read_start_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve read start time.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		/* Read a chunk from the file descriptor
 		 */
 		read_count = ewfacquirestream_read_chunk(
@@ -793,6 +858,37 @@ int ewfacquirestream_read_input(
 
 			goto on_error;
 		}
+		if( imaging_handle->compression_level_controller != NULL )
+		{
+			if( compression_level_controller_get_current_time(
+			     &read_end_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve read end time.",
+				 function );
+
+				goto on_error;
+			}
+			if( compression_level_controller_add_read(
+			     imaging_handle->compression_level_controller,
+			     (size64_t) read_count,
+			     read_end_time - read_start_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add read statistics to compression level controller.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( read_count == 0 )
 		{
 			break;
@@ -847,11 +943,26 @@ int ewfacquirestream_read_input(
 		}
 		/* Digest hashes are calcultated after swap
 		 */
-		if( imaging_handle_update_integrity_hash(
-		     imaging_handle,
-		     data,
-		     read_count,
-		     error ) != 1 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( imaging_handle->number_of_digest_hash_threads != 0 )
+		{
+			result = digest_hash_threads_push_buffer(
+			          imaging_handle->digest_hash_threads,
+			          imaging_handle->number_of_digest_hash_threads,
+			          storage_media_buffer,
+			          (size_t) read_count,
+			          error );
+		}
+		else
+#endif
+		{
+			result = imaging_handle_update_integrity_hash(
+			          imaging_handle,
+			          data,
+			          (size_t) read_count,
+			          error );
+		}
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -884,7 +995,8 @@ int ewfacquirestream_read_input(
 		else
 #endif
 		{
-			process_count = storage_media_buffer_write_process(
+			process_count = imaging_handle_process_storage_media_buffer(
+			                 imaging_handle,
 			                 storage_media_buffer,
 			                 error );
 
@@ -983,6 +1095,22 @@ int ewfacquirestream_read_input(
 			goto on_error;
 		}
 	}
+	if( imaging_handle->number_of_digest_hash_threads != 0 )
+	{
+		if( imaging_handle_stop_integrity_hash_threads(
+		     imaging_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop integrity hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( imaging_handle->output_list != NULL )
 	{
 		if( imaging_handle_empty_output_list(
@@ -1108,6 +1236,20 @@ int ewfacquirestream_read_input(
 
 			goto on_error;
 		}
+		if( imaging_handle_print_compression_statistics(
+		     imaging_handle,
+		     imaging_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print compression statistics.",
+			 function );
+
+			goto on_error;
+		}
 		if( log_handle != NULL )
 		{
 			if( imaging_handle_print_hashes(
@@ -1124,6 +1266,20 @@ int ewfacquirestream_read_input(
 
 				goto on_error;
 			}
+			if( imaging_handle_print_compression_statistics(
+			     imaging_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print compression statistics in log handle.",
+				 function );
+
+				goto on_error;
+			}
 		}
 	}
 	return( 1 );
@@ -1160,6 +1316,12 @@ on_error:
 		 &( imaging_handle->output_thread_pool ),
 		 NULL );
 	}
+	if( imaging_handle->number_of_digest_hash_threads != 0 )
+	{
+		imaging_handle_stop_integrity_hash_threads(
+		 imaging_handle,
+		 NULL );
+	}
 	if( imaging_handle->output_list != NULL )
 	{
 		imaging_handle_empty_output_list(
@@ -35,6 +35,7 @@
 
 #include "byte_size_string.h"
 #include "digest_hash.h"
+#include "digest_hash_thread.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_libcerror.h"
@@ -4432,6 +4433,187 @@ ssize_t export_handle_finalize(
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
+/* Starts the integrity hash threads
+ * A digest hash thread is started for every integrity hash that is calculated
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_start_integrity_hash_threads(
+     export_handle_t *export_handle,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_start_integrity_hash_threads";
+	int thread_index      = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->number_of_digest_hash_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - integrity hash threads already started.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->calculate_md5 != 0 )
+	{
+		if( digest_hash_thread_initialize(
+		     &( export_handle->digest_hash_threads[ thread_index ] ),
+		     (intptr_t *) export_handle->md5_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_md5_update,
+		     export_handle->storage_media_buffer_queue,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create MD5 digest hash thread.",
+			 function );
+
+			goto on_error;
+		}
+		thread_index++;
+	}
+	if( export_handle->calculate_sha1 != 0 )
+	{
+		if( digest_hash_thread_initialize(
+		     &( export_handle->digest_hash_threads[ thread_index ] ),
+		     (intptr_t *) export_handle->sha1_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha1_update,
+		     export_handle->storage_media_buffer_queue,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA1 digest hash thread.",
+			 function );
+
+			goto on_error;
+		}
+		thread_index++;
+	}
+	if( export_handle->calculate_sha256 != 0 )
+	{
+		if( digest_hash_thread_initialize(
+		     &( export_handle->digest_hash_threads[ thread_index ] ),
+		     (intptr_t *) export_handle->sha256_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha256_update,
+		     export_handle->storage_media_buffer_queue,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA256 digest hash thread.",
+			 function );
+
+			goto on_error;
+		}
+		thread_index++;
+	}
+	export_handle->number_of_digest_hash_threads = thread_index;
+
+	return( 1 );
+
+on_error:
+	while( thread_index > 0 )
+	{
+		thread_index--;
+
+		digest_hash_thread_free(
+		 &( export_handle->digest_hash_threads[ thread_index ] ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Stops the integrity hash threads
+ * Waits until the digest hash threads have hashed all pushed storage media buffers
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_stop_integrity_hash_threads(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_stop_integrity_hash_threads";
+	int result            = 1;
+	int thread_index      = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	for( thread_index = 0;
+	     thread_index < export_handle->number_of_digest_hash_threads;
+	     thread_index++ )
+	{
+		if( result == 1 )
+		{
+			if( digest_hash_thread_join(
+			     export_handle->digest_hash_threads[ thread_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join digest hash thread: %d.",
+				 function,
+				 thread_index );
+
+				result = -1;
+			}
+		}
+		/* Make sure the remaining threads are joined even if an error occurred
+		 */
+		if( digest_hash_thread_free(
+		     &( export_handle->digest_hash_threads[ thread_index ] ),
+		     NULL ) != 1 )
+		{
+			if( result == 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest hash thread: %d.",
+				 function,
+				 thread_index );
+			}
+			result = -1;
+		}
+	}
+	export_handle->number_of_digest_hash_threads = 0;
+
+	return( result );
+}
+
 /* Prepares a storage media buffer for export
  * Callback function for the process thread pool
  * Returns 1 if successful or -1 on error
@@ -4560,6 +4742,7 @@ int export_handle_output_storage_media_buffer_callback(
         static char *function                               = "export_handle_process_storage_media_buffer_callback";
 	size_t data_size                                    = 0;
 	ssize_t write_count                                 = 0;
+	int result                                          = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4689,11 +4872,24 @@ int export_handle_output_storage_media_buffer_callback(
 		}
 		/* Digest hashes are calcultated after swap
 		 */
-		if( export_handle_update_integrity_hash(
-		     export_handle,
-		     data,
-		     storage_media_buffer->processed_size,
-		     &error ) != 1 )
+		if( export_handle->number_of_digest_hash_threads != 0 )
+		{
+			result = digest_hash_threads_push_buffer(
+			          export_handle->digest_hash_threads,
+			          export_handle->number_of_digest_hash_threads,
+			          storage_media_buffer,
+			          storage_media_buffer->processed_size,
+			          &error );
+		}
+		else
+		{
+			result = export_handle_update_integrity_hash(
+			          export_handle,
+			          data,
+			          storage_media_buffer->processed_size,
+			          &error );
+		}
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 &error,
@@ -5278,6 +5474,25 @@ int export_handle_export_input(
 
 		goto on_error;
         }
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->number_of_threads != 0 )
+	{
+		if( export_handle_start_integrity_hash_threads(
+		     export_handle,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start integrity hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( process_status_initialize(
 	     &( export_handle->process_status ),
 	     _SYSTEM_STRING( "Export" ),
@@ -5636,6 +5851,22 @@ int export_handle_export_input(
 			goto on_error;
 		}
 	}
+	if( export_handle->number_of_digest_hash_threads != 0 )
+	{
+		if( export_handle_stop_integrity_hash_threads(
+		     export_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop integrity hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( export_handle->output_list != NULL )
 	{
 		if( export_handle_empty_output_list(
@@ -5845,6 +6076,12 @@ on_error:
 		 &( export_handle->output_thread_pool ),
 		 NULL );
 	}
+	if( export_handle->number_of_digest_hash_threads != 0 )
+	{
+		export_handle_stop_integrity_hash_threads(
+		 export_handle,
+		 NULL );
+	}
 	if( export_handle->output_list != NULL )
 	{
 		export_handle_empty_output_list(
@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "digest_hash.h"
+#include "digest_hash_thread.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -181,6 +182,14 @@ struct export_handle
 	 */
 	libcthreads_queue_t *storage_media_buffer_queue;
 
+	/* The digest hash threads
+	 */
+	digest_hash_thread_t *digest_hash_threads[ DIGEST_HASH_THREAD_MAXIMUM_NUMBER_OF_THREADS ];
+
+	/* The number of digest hash threads
+	 */
+	int number_of_digest_hash_threads;
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	/* The libewf input handle
@@ -474,6 +483,15 @@ ssize_t export_handle_finalize(
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
+int export_handle_start_integrity_hash_threads(
+     export_handle_t *export_handle,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error );
+
+int export_handle_stop_integrity_hash_threads(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
 int export_handle_process_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle );
@@ -34,7 +34,9 @@
 #endif
 
 #include "byte_size_string.h"
+#include "compression_level_controller.h"
 #include "digest_hash.h"
+#include "digest_hash_thread.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_libcerror.h"
@@ -290,6 +292,22 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->notes );
 		}
+		if( ( *imaging_handle )->compression_level_controller != NULL )
+		{
+			if( compression_level_controller_free(
+			     &( ( *imaging_handle )->compression_level_controller ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free compression level controller.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( ( *imaging_handle )->md5_context != NULL )
 		{
 			if( libhmac_md5_free(
@@ -639,6 +657,24 @@ int imaging_handle_open_output(
 	{
 		libewf_filenames = filenames;
 		access_flags     = LIBEWF_OPEN_WRITE;
+
+		if( imaging_handle->use_direct_io != 0 )
+		{
+			if( libewf_handle_set_io_engine(
+			     imaging_handle->output_handle,
+			     LIBEWF_IO_ENGINE_DIRECT,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set IO engine.",
+				 function );
+
+				goto on_error;
+			}
+		}
 	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
@@ -813,6 +849,24 @@ int imaging_handle_open_secondary_output(
 
 		goto on_error;
 	}
+	if( ( resume == 0 )
+	 && ( imaging_handle->use_direct_io != 0 ) )
+	{
+		if( libewf_handle_set_io_engine(
+		     imaging_handle->secondary_output_handle,
+		     LIBEWF_IO_ENGINE_DIRECT,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set IO engine.",
+			 function );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
 	     imaging_handle->secondary_output_handle,
@@ -1631,8 +1685,335 @@ int imaging_handle_finalize_integrity_hash(
 	return( 1 );
 }
 
+/* Prepares a storage media buffer for imaging
+ * If the adaptive compression level is used the chunk is packed with the compression level
+ * selected by the compression level controller and the time it took is reported back
+ * Returns the resulting buffer size or -1 on error
+ */
+ssize_t imaging_handle_process_storage_media_buffer(
+         imaging_handle_t *imaging_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         libcerror_error_t **error )
+{
+	static char *function    = "imaging_handle_process_storage_media_buffer";
+	uint64_t end_time        = 0;
+	uint64_t start_time      = 0;
+	ssize_t process_count    = 0;
+	int8_t compression_level = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( imaging_handle->compression_level_controller == NULL )
+	 || ( storage_media_buffer->mode != STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA ) )
+	{
+		process_count = storage_media_buffer_write_process(
+				 storage_media_buffer,
+				 error );
+
+		if( process_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to prepare storage media buffer before write.",
+			 function );
+
+			return( -1 );
+		}
+		return( process_count );
+	}
+	if( compression_level_controller_get_compression_level(
+	     imaging_handle->compression_level_controller,
+	     &compression_level,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_data_chunk_set_compression_level(
+	     storage_media_buffer->data_chunk,
+	     compression_level,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compression level in data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level_controller_get_current_time(
+	     &start_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start time.",
+		 function );
+
+		return( -1 );
+	}
+	process_count = storage_media_buffer_write_process(
+			 storage_media_buffer,
+			 error );
+
+	if( process_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to prepare storage media buffer before write.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level_controller_get_current_time(
+	     &end_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end time.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level_controller_add_process(
+	     imaging_handle->compression_level_controller,
+	     compression_level,
+	     (size64_t) storage_media_buffer->raw_buffer_data_size,
+	     end_time - start_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add process statistics to compression level controller.",
+		 function );
+
+		return( -1 );
+	}
+	return( process_count );
+}
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
+/* Starts the integrity hash threads
+ * A digest hash thread is started for every integrity hash that is calculated
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_start_integrity_hash_threads(
+     imaging_handle_t *imaging_handle,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_start_integrity_hash_threads";
+	int thread_index      = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->number_of_digest_hash_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid imaging handle - integrity hash threads already started.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->calculate_md5 != 0 )
+	{
+		if( digest_hash_thread_initialize(
+		     &( imaging_handle->digest_hash_threads[ thread_index ] ),
+		     (intptr_t *) imaging_handle->md5_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_md5_update,
+		     imaging_handle->storage_media_buffer_queue,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create MD5 digest hash thread.",
+			 function );
+
+			goto on_error;
+		}
+		thread_index++;
+	}
+	if( imaging_handle->calculate_sha1 != 0 )
+	{
+		if( digest_hash_thread_initialize(
+		     &( imaging_handle->digest_hash_threads[ thread_index ] ),
+		     (intptr_t *) imaging_handle->sha1_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha1_update,
+		     imaging_handle->storage_media_buffer_queue,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA1 digest hash thread.",
+			 function );
+
+			goto on_error;
+		}
+		thread_index++;
+	}
+	if( imaging_handle->calculate_sha256 != 0 )
+	{
+		if( digest_hash_thread_initialize(
+		     &( imaging_handle->digest_hash_threads[ thread_index ] ),
+		     (intptr_t *) imaging_handle->sha256_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha256_update,
+		     imaging_handle->storage_media_buffer_queue,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA256 digest hash thread.",
+			 function );
+
+			goto on_error;
+		}
+		thread_index++;
+	}
+	imaging_handle->number_of_digest_hash_threads = thread_index;
+
+	return( 1 );
+
+on_error:
+	while( thread_index > 0 )
+	{
+		thread_index--;
+
+		digest_hash_thread_free(
+		 &( imaging_handle->digest_hash_threads[ thread_index ] ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Stops the integrity hash threads
+ * Waits until the digest hash threads have hashed all pushed storage media buffers
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_stop_integrity_hash_threads(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_stop_integrity_hash_threads";
+	int result            = 1;
+	int thread_index      = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	for( thread_index = 0;
+	     thread_index < imaging_handle->number_of_digest_hash_threads;
+	     thread_index++ )
+	{
+		if( result == 1 )
+		{
+			if( digest_hash_thread_join(
+			     imaging_handle->digest_hash_threads[ thread_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join digest hash thread: %d.",
+				 function,
+				 thread_index );
+
+				result = -1;
+			}
+		}
+		/* Make sure the remaining threads are joined even if an error occurred
+		 */
+		if( digest_hash_thread_free(
+		     &( imaging_handle->digest_hash_threads[ thread_index ] ),
+		     NULL ) != 1 )
+		{
+			if( result == 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest hash thread: %d.",
+				 function,
+				 thread_index );
+			}
+			result = -1;
+		}
+	}
+	imaging_handle->number_of_digest_hash_threads = 0;
+
+	return( result );
+}
+
 /* Prepares a storage media buffer for imaging
  * Callback function for the process thread pool
  * Returns 1 if successful or -1 on error
@@ -1656,7 +2037,8 @@ int imaging_handle_process_storage_media_buffer_callback(
 
 		goto on_error;
 	}
-	process_count = storage_media_buffer_write_process(
+	process_count = imaging_handle_process_storage_media_buffer(
+			 imaging_handle,
 			 storage_media_buffer,
 			 &error );
 
@@ -3555,22 +3937,42 @@ int imaging_handle_set_compression_values(
 
 		goto on_error;
 	}
-	result = ewfinput_determine_compression_values(
-	          string_segment,
-	          &( imaging_handle->compression_level ),
-	          &( imaging_handle->compression_flags ),
-	          error );
+	imaging_handle->use_adaptive_compression_level = 0;
 
-	if( result == -1 )
+	/* The adaptive compression level starts with the fast compression level
+	 * and is adjusted per chunk while acquiring
+	 */
+	if( ( string_segment_size == 9 )
+	 && ( system_string_compare(
+	       string_segment,
+	       _SYSTEM_STRING( "adaptive" ),
+	       8 ) == 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine compression values.",
-		 function );
+		imaging_handle->compression_level              = LIBEWF_COMPRESSION_FAST;
+		imaging_handle->compression_flags              = LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
+		imaging_handle->use_adaptive_compression_level = 1;
 
-		goto on_error;
+		result = 1;
+	}
+	else
+	{
+		result = ewfinput_determine_compression_values(
+			  string_segment,
+			  &( imaging_handle->compression_level ),
+			  &( imaging_handle->compression_flags ),
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine compression values.",
+			 function );
+
+			goto on_error;
+		}
 	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libcsplit_wide_split_string_free(
@@ -6285,7 +6687,13 @@ int imaging_handle_print_parameters(
 	 imaging_handle->notify_stream,
 	 "Compression level:\t\t\t" );
 
-	if( imaging_handle->compression_level == LIBEWF_COMPRESSION_FAST )
+	if( imaging_handle->use_adaptive_compression_level != 0 )
+	{
+		fprintf(
+		 imaging_handle->notify_stream,
+		 "adaptive" );
+	}
+	else if( imaging_handle->compression_level == LIBEWF_COMPRESSION_FAST )
 	{
 		fprintf(
 		 imaging_handle->notify_stream,
@@ -6501,3 +6909,90 @@ int imaging_handle_print_hashes(
 	return( 1 );
 }
 
+/* Print the compression statistics to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_print_compression_statistics(
+     imaging_handle_t *imaging_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function                    = "imaging_handle_print_compression_statistics";
+	uint64_t number_of_compressed_chunks     = 0;
+	uint64_t number_of_incompressible_chunks = 0;
+	uint64_t number_of_skipped_chunks        = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->compression_level_controller == NULL )
+	{
+		return( 1 );
+	}
+	if( libewf_handle_get_compression_statistics(
+	     imaging_handle->output_handle,
+	     &number_of_compressed_chunks,
+	     &number_of_incompressible_chunks,
+	     &number_of_skipped_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve compression statistics.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 stream,
+	 "\n" );
+
+	if( compression_level_controller_fprint(
+	     imaging_handle->compression_level_controller,
+	     stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print compression level controller.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 stream,
+	 "Chunks compressed:\t\t\t%" PRIu64 "\n",
+	 number_of_compressed_chunks );
+
+	fprintf(
+	 stream,
+	 "Chunks stored uncompressed:\t\t%" PRIu64 " (compression skipped: %" PRIu64 ")\n",
+	 number_of_incompressible_chunks + number_of_skipped_chunks,
+	 number_of_skipped_chunks );
+
+	return( 1 );
+}
+
@@ -26,6 +26,8 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "compression_level_controller.h"
+#include "digest_hash_thread.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -118,6 +120,19 @@ struct imaging_handle
 	 */
 	uint8_t compression_flags;
 
+	/* Value to indicate if the compression level should be adapted per chunk
+	 * to the read throughput of the input
+	 */
+	uint8_t use_adaptive_compression_level;
+
+	/* Value to indicate if the segment files should be written using direct IO
+	 */
+	uint8_t use_direct_io;
+
+	/* The compression level controller
+	 */
+	compression_level_controller_t *compression_level_controller;
+
 	/* The EWF format
 	 */
 	uint8_t ewf_format;
@@ -232,6 +247,14 @@ struct imaging_handle
 	 */
 	libcthreads_queue_t *storage_media_buffer_queue;
 
+	/* The digest hash threads
+	 */
+	digest_hash_thread_t *digest_hash_threads[ DIGEST_HASH_THREAD_MAXIMUM_NUMBER_OF_THREADS ];
+
+	/* The number of digest hash threads
+	 */
+	int number_of_digest_hash_threads;
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	/* The libewf output handle
@@ -340,8 +363,22 @@ int imaging_handle_finalize_integrity_hash(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error );
 
+ssize_t imaging_handle_process_storage_media_buffer(
+         imaging_handle_t *imaging_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         libcerror_error_t **error );
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
+int imaging_handle_start_integrity_hash_threads(
+     imaging_handle_t *imaging_handle,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error );
+
+int imaging_handle_stop_integrity_hash_threads(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error );
+
 int imaging_handle_process_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle );
@@ -570,6 +607,11 @@ int imaging_handle_print_hashes(
      FILE *stream,
      libcerror_error_t **error );
 
+int imaging_handle_print_compression_statistics(
+     imaging_handle_t *imaging_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -357,6 +357,22 @@ int info_handle_open_input(
 		}
 		filenames = (system_character_t * const *) libewf_filenames;
 	}
+	/* The media data is not read hence only the first and last segment file are needed
+	 */
+	if( libewf_handle_set_lazy_open(
+	     info_handle->input_handle,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set lazy open.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
 	     info_handle->input_handle,
@@ -120,12 +120,13 @@ int storage_media_buffer_initialize(
 	}
 	if( size > 0 )
 	{
-/* TODO can low level functions and direct IO be combined ? */
+/* The raw buffer is page aligned so that it can be used with direct IO
+ */
 #if defined( memory_allocate_aligned )
 		if( memory_allocate_aligned(
 		     (void **) &( ( *buffer )->raw_buffer ),
 		     size,
-		     512 ) != 0 )
+		     STORAGE_MEDIA_BUFFER_ALIGNMENT ) != 0 )
 		{
 			libcerror_error_set(
 			 error,
@@ -172,6 +173,21 @@ int storage_media_buffer_initialize(
 			goto on_error;
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *buffer )->reference_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reference mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	( *buffer )->mode = mode;
 
 	return( 1 );
@@ -242,6 +258,24 @@ int storage_media_buffer_free(
 				result = -1;
 			}
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *buffer )->reference_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *buffer )->reference_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free reference mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		memory_free(
 		 *buffer );
 
@@ -250,6 +284,147 @@ int storage_media_buffer_free(
 	return( result );
 }
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Adds references to a storage media buffer
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_add_references(
+     storage_media_buffer_t *buffer,
+     int number_of_references,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_add_references";
+	int result            = 1;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_references < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of references value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     buffer->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer->number_of_references > ( INT_MAX - number_of_references ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of references value exceeds maximum.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		buffer->number_of_references += number_of_references;
+	}
+	if( libcthreads_mutex_release(
+	     buffer->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Removes a reference from a storage media buffer
+ * Returns 1 if the last reference was removed, 0 if the buffer is still referenced or -1 on error
+ */
+int storage_media_buffer_remove_reference(
+     storage_media_buffer_t *buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_remove_reference";
+	int result            = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     buffer->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* A buffer without references is treated as having a single reference
+	 */
+	if( buffer->number_of_references > 0 )
+	{
+		buffer->number_of_references -= 1;
+	}
+	if( buffer->number_of_references == 0 )
+	{
+		result = 1;
+	}
+	if( libcthreads_mutex_release(
+	     buffer->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* Retrieves the reference to the actual data and its size
  * Returns 1 if successful or -1 on error
  */
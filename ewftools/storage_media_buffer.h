@@ -26,12 +26,18 @@
 #include <types.h>
 
 #include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The alignment of the raw buffer, which is a multiple of the sector size
+ * and the page size required by direct IO
+ */
+#define STORAGE_MEDIA_BUFFER_ALIGNMENT		4096
+
 enum STORAGE_MEDIA_BUFFER_MODES
 {
 	STORAGE_MEDIA_BUFFER_MODE_BUFFERED	= 0,
@@ -73,6 +79,20 @@ struct storage_media_buffer
 	/* The processed size
 	 */
 	size_t processed_size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The size of the data in the raw buffer to be hashed by the digest hash threads
+	 */
+	size_t digest_hash_data_size;
+
+	/* The number of references
+	 */
+	int number_of_references;
+
+	/* The reference mutex
+	 */
+	libcthreads_mutex_t *reference_mutex;
+#endif
 };
 
 int storage_media_buffer_initialize(
@@ -86,6 +106,19 @@ int storage_media_buffer_free(
      storage_media_buffer_t **buffer,
      libcerror_error_t **error );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int storage_media_buffer_add_references(
+     storage_media_buffer_t *buffer,
+     int number_of_references,
+     libcerror_error_t **error );
+
+int storage_media_buffer_remove_reference(
+     storage_media_buffer_t *buffer,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 int storage_media_buffer_get_data(
      storage_media_buffer_t *buffer,
      uint8_t **data,
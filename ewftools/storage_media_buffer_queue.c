@@ -215,10 +215,27 @@ int storage_media_buffer_queue_grab_buffer(
 
 		return( -1 );
 	}
+	/* The buffer is referenced by the caller
+	 */
+	if( storage_media_buffer_add_references(
+	     *buffer,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add reference to storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
 	return( 1 );
 }
 
-/* Releases a storage media buffer onto the queue
+/* Releases a reference to a storage media buffer
+ * The buffer is pushed back onto the queue when its last reference is released
  * Returns 1 if successful or -1 on error
  */
 int storage_media_buffer_queue_release_buffer(
@@ -227,7 +244,27 @@ int storage_media_buffer_queue_release_buffer(
      libcerror_error_t **error )
 {
 	static char *function = "storage_media_buffer_queue_release_buffer";
+	int result            = 0;
+
+	result = storage_media_buffer_remove_reference(
+	          buffer,
+	          error );
 
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to remove reference from storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 1 );
+	}
 	if( libcthreads_queue_push(
 	     queue,
 	     (intptr_t *) buffer,
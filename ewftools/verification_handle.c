@@ -28,6 +28,7 @@
 
 #include "byte_size_string.h"
 #include "digest_hash.h"
+#include "digest_hash_thread.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_libcdata.h"
@@ -1079,6 +1080,187 @@ int verification_handle_finalize_integrity_hash(
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
+/* Starts the integrity hash threads
+ * A digest hash thread is started for every integrity hash that is calculated
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_start_integrity_hash_threads(
+     verification_handle_t *verification_handle,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_start_integrity_hash_threads";
+	int thread_index      = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->number_of_digest_hash_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - integrity hash threads already started.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->calculate_md5 != 0 )
+	{
+		if( digest_hash_thread_initialize(
+		     &( verification_handle->digest_hash_threads[ thread_index ] ),
+		     (intptr_t *) verification_handle->md5_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_md5_update,
+		     verification_handle->storage_media_buffer_queue,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create MD5 digest hash thread.",
+			 function );
+
+			goto on_error;
+		}
+		thread_index++;
+	}
+	if( verification_handle->calculate_sha1 != 0 )
+	{
+		if( digest_hash_thread_initialize(
+		     &( verification_handle->digest_hash_threads[ thread_index ] ),
+		     (intptr_t *) verification_handle->sha1_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha1_update,
+		     verification_handle->storage_media_buffer_queue,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA1 digest hash thread.",
+			 function );
+
+			goto on_error;
+		}
+		thread_index++;
+	}
+	if( verification_handle->calculate_sha256 != 0 )
+	{
+		if( digest_hash_thread_initialize(
+		     &( verification_handle->digest_hash_threads[ thread_index ] ),
+		     (intptr_t *) verification_handle->sha256_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha256_update,
+		     verification_handle->storage_media_buffer_queue,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA256 digest hash thread.",
+			 function );
+
+			goto on_error;
+		}
+		thread_index++;
+	}
+	verification_handle->number_of_digest_hash_threads = thread_index;
+
+	return( 1 );
+
+on_error:
+	while( thread_index > 0 )
+	{
+		thread_index--;
+
+		digest_hash_thread_free(
+		 &( verification_handle->digest_hash_threads[ thread_index ] ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Stops the integrity hash threads
+ * Waits until the digest hash threads have hashed all pushed storage media buffers
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_stop_integrity_hash_threads(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_stop_integrity_hash_threads";
+	int result            = 1;
+	int thread_index      = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	for( thread_index = 0;
+	     thread_index < verification_handle->number_of_digest_hash_threads;
+	     thread_index++ )
+	{
+		if( result == 1 )
+		{
+			if( digest_hash_thread_join(
+			     verification_handle->digest_hash_threads[ thread_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join digest hash thread: %d.",
+				 function,
+				 thread_index );
+
+				result = -1;
+			}
+		}
+		/* Make sure the remaining threads are joined even if an error occurred
+		 */
+		if( digest_hash_thread_free(
+		     &( verification_handle->digest_hash_threads[ thread_index ] ),
+		     NULL ) != 1 )
+		{
+			if( result == 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest hash thread: %d.",
+				 function,
+				 thread_index );
+			}
+			result = -1;
+		}
+	}
+	verification_handle->number_of_digest_hash_threads = 0;
+
+	return( result );
+}
+
 /* Prepares a storage media buffer for verification
  * Callback function for the process thread pool
  * Returns 1 if successful or -1 on error
@@ -1207,6 +1389,7 @@ int verification_handle_output_storage_media_buffer_callback(
 	uint8_t *data                         = NULL;
         static char *function                 = "verification_handle_process_storage_media_buffer_callback";
 	size_t data_size                      = 0;
+	int result                            = 0;
 
 	if( verification_handle == NULL )
 	{
@@ -1312,11 +1495,24 @@ int verification_handle_output_storage_media_buffer_callback(
 
 			goto on_error;
 		}
-		if( verification_handle_update_integrity_hash(
-		     verification_handle,
-		     data,
-		     storage_media_buffer->processed_size,
-		     &error ) != 1 )
+		if( verification_handle->number_of_digest_hash_threads != 0 )
+		{
+			result = digest_hash_threads_push_buffer(
+			          verification_handle->digest_hash_threads,
+			          verification_handle->number_of_digest_hash_threads,
+			          storage_media_buffer,
+			          storage_media_buffer->processed_size,
+			          &error );
+		}
+		else
+		{
+			result = verification_handle_update_integrity_hash(
+			          verification_handle,
+			          data,
+			          storage_media_buffer->processed_size,
+			          &error );
+		}
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 &error,
@@ -1783,6 +1979,25 @@ int verification_handle_verify_input(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		if( verification_handle_start_integrity_hash_threads(
+		     verification_handle,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start integrity hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( process_status_initialize(
 	     &( verification_handle->process_status ),
 	     _SYSTEM_STRING( "Verify" ),
@@ -2067,6 +2282,22 @@ int verification_handle_verify_input(
 			goto on_error;
 		}
 	}
+	if( verification_handle->number_of_digest_hash_threads != 0 )
+	{
+		if( verification_handle_stop_integrity_hash_threads(
+		     verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop integrity hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( verification_handle->output_list != NULL )
 	{
 		if( verification_handle_empty_output_list(
@@ -2367,6 +2598,12 @@ on_error:
 		 &( verification_handle->output_thread_pool ),
 		 NULL );
 	}
+	if( verification_handle->number_of_digest_hash_threads != 0 )
+	{
+		verification_handle_stop_integrity_hash_threads(
+		 verification_handle,
+		 NULL );
+	}
 	if( verification_handle->output_list != NULL )
 	{
 		verification_handle_empty_output_list(
@@ -0,0 +1,213 @@
+/*
+ * EWF chunk index (.ewfidx)
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EWF_CHUNK_INDEX_H )
+#define _EWF_CHUNK_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The chunk index is not part of the EWF format, it is a sidecar file
+ * written by libewf that consists of:
+ * the header
+ * a segment entry per segment file
+ * a section entry per section descriptor
+ * a chunk group entry per table section
+ * a 32-bit Adler-32 checksum of the preceding data
+ * All values are stored in little-endian
+ */
+
+typedef struct ewf_chunk_index_header ewf_chunk_index_header_t;
+
+struct ewf_chunk_index_header
+{
+	/* The signature
+	 * Consists of 8 bytes
+	 * Contains: ewfidx 0x00 0x00
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 * Contains: 3
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The chunk size
+	 * Consists of 4 bytes
+	 */
+	uint8_t chunk_size[ 4 ];
+
+	/* The number of segments
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_segments[ 4 ];
+
+	/* The number of chunk groups
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_chunk_groups[ 4 ];
+
+	/* The segment file set identifier
+	 * Consists of 16 bytes
+	 * Contains a GUID or 0-byte values for EWF version 1
+	 */
+	uint8_t set_identifier[ 16 ];
+
+	/* The number of sections
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_sections[ 4 ];
+
+	/* Unknown (reserved)
+	 * Consists of 4 bytes
+	 */
+	uint8_t reserved[ 4 ];
+};
+
+typedef struct ewf_chunk_index_segment ewf_chunk_index_segment_t;
+
+struct ewf_chunk_index_segment
+{
+	/* The segment file size
+	 * Consists of 8 bytes
+	 */
+	uint8_t file_size[ 8 ];
+
+	/* The segment file modification time
+	 * Consists of 8 bytes
+	 * Contains a POSIX timestamp in nanoseconds
+	 * or in seconds if the platform has no sub-second precision
+	 */
+	uint8_t modification_time[ 8 ];
+
+	/* The identifier of the device containing the segment file
+	 * Consists of 8 bytes
+	 */
+	uint8_t device_identifier[ 8 ];
+
+	/* The inode number of the segment file
+	 * Consists of 8 bytes
+	 */
+	uint8_t inode_number[ 8 ];
+
+	/* The previous last chunk filled
+	 * Consists of 8 bytes
+	 */
+	uint8_t previous_last_chunk_filled[ 8 ];
+
+	/* The last chunk filled
+	 * Consists of 8 bytes
+	 */
+	uint8_t last_chunk_filled[ 8 ];
+
+	/* The segment number
+	 * Consists of 4 bytes
+	 */
+	uint8_t segment_number[ 4 ];
+
+	/* The segment file flags
+	 * Consists of 4 bytes
+	 */
+	uint8_t flags[ 4 ];
+
+	/* The index of the first chunk group
+	 * Consists of 4 bytes
+	 */
+	uint8_t first_chunk_group_index[ 4 ];
+
+	/* The number of chunk groups
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_chunk_groups[ 4 ];
+
+	/* The last section offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t last_section_offset[ 8 ];
+
+	/* The index of the first section
+	 * Consists of 4 bytes
+	 */
+	uint8_t first_section_index[ 4 ];
+
+	/* The number of sections
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_sections[ 4 ];
+
+	/* The index of the device information section
+	 * Consists of 4 bytes
+	 * Contains -1 if not available
+	 */
+	uint8_t device_information_section_index[ 4 ];
+
+	/* Unknown (reserved)
+	 * Consists of 4 bytes
+	 */
+	uint8_t reserved[ 4 ];
+};
+
+typedef struct ewf_chunk_index_section ewf_chunk_index_section_t;
+
+struct ewf_chunk_index_section
+{
+	/* The section descriptor offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t descriptor_offset[ 8 ];
+};
+
+typedef struct ewf_chunk_index_chunk_group ewf_chunk_index_chunk_group_t;
+
+struct ewf_chunk_index_chunk_group
+{
+	/* The chunk group data offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t data_offset[ 8 ];
+
+	/* The chunk group data size
+	 * Consists of 8 bytes
+	 */
+	uint8_t data_size[ 8 ];
+
+	/* The number of chunks
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_chunks[ 4 ];
+
+	/* The range flags
+	 * Consists of 4 bytes
+	 */
+	uint8_t range_flags[ 4 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
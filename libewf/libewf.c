@@ -25,6 +25,9 @@
 #include <windows.h>
 #endif
 
+#include "libewf_compression_context.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
 #include "libewf_unused.h"
 
 /* Define HAVE_LOCAL_LIBEWF for local use of libewf
@@ -76,5 +79,31 @@ int libewf_is_dll(
 
 #endif /* defined( WINAPI ) && defined( HAVE_DLLMAIN ) */
 
+#if defined( HAVE_LIBEWF_COMPRESSION_CONTEXT ) && defined( __GNUC__ )
+
+/* Finalizes the library when it is unloaded
+ */
+static void __attribute__((destructor)) libewf_finalize(
+             void )
+{
+	libcerror_error_t *error = NULL;
+
+	if( libewf_compression_context_finalize(
+	     &error ) != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+}
+
+#endif /* defined( HAVE_LIBEWF_COMPRESSION_CONTEXT ) && defined( __GNUC__ ) */
+
 #endif /* !defined( HAVE_LOCAL_LIBEWF ) */
 
@@ -0,0 +1,1040 @@
+/*
+ * Buffer pool functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_LIMITS_H ) || defined( WINAPI )
+#include <limits.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#include "libewf_buffer_pool.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( HAVE_LIBEWF_BUFFER_POOL_HUGE_PAGES )
+#if !defined( MAP_ANONYMOUS ) && defined( MAP_ANON )
+#define MAP_ANONYMOUS	MAP_ANON
+#endif
+#endif
+
+/* Creates a buffer pool
+ * Make sure the value buffer_pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffer_pool_initialize(
+     libewf_buffer_pool_t **buffer_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffer_pool_initialize";
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid buffer pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*buffer_pool = memory_allocate_structure(
+	                libewf_buffer_pool_t );
+
+	if( *buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *buffer_pool,
+	     0,
+	     sizeof( libewf_buffer_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffer pool.",
+		 function );
+
+		memory_free(
+		 *buffer_pool );
+
+		*buffer_pool = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *buffer_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *buffer_pool )->maximum_size = LIBEWF_BUFFER_POOL_DEFAULT_MAXIMUM_SIZE;
+
+	return( 1 );
+
+on_error:
+	if( *buffer_pool != NULL )
+	{
+		memory_free(
+		 *buffer_pool );
+
+		*buffer_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a buffer pool
+ * The buffers that are in use must be released before the buffer pool is freed,
+ * otherwise the buffer pool is not freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffer_pool_free(
+     libewf_buffer_pool_t **buffer_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffer_pool_free";
+	int result            = 1;
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer_pool != NULL )
+	{
+		if( ( *buffer_pool )->number_of_used_buffers != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid buffer pool - buffers are in use.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_buffer_pool_empty(
+		     *buffer_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty buffer pool.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *buffer_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *buffer_pool );
+
+		*buffer_pool = NULL;
+	}
+	return( result );
+}
+
+/* Clones the buffer pool
+ * Only the values are cloned, the buffers and the arena are not shared with the destination
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffer_pool_clone(
+     libewf_buffer_pool_t **destination_buffer_pool,
+     libewf_buffer_pool_t *source_buffer_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffer_pool_clone";
+
+	if( destination_buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_buffer_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination buffer pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_buffer_pool == NULL )
+	{
+		*destination_buffer_pool = NULL;
+
+		return( 1 );
+	}
+	if( libewf_buffer_pool_initialize(
+	     destination_buffer_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	( *destination_buffer_pool )->maximum_size = source_buffer_pool->maximum_size;
+	( *destination_buffer_pool )->flags        = source_buffer_pool->flags;
+
+	return( 1 );
+}
+
+/* Empties the buffer pool
+ * Frees the buffers that are available for reuse and unmaps the arena if mapped by the pool
+ * The buffer pool cannot be emptied while buffers are in use
+ * This function does not grab the mutex
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffer_pool_empty(
+     libewf_buffer_pool_t *buffer_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffer_pool_empty";
+	uint8_t *buffer       = NULL;
+	int buffer_index      = 0;
+	int result            = 1;
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_pool->number_of_used_buffers != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid buffer pool - buffers are in use.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_pool->free_buffers != NULL )
+	{
+		for( buffer_index = 0;
+		     buffer_index < buffer_pool->number_of_free_buffers;
+		     buffer_index++ )
+		{
+			buffer = buffer_pool->free_buffers[ buffer_index ];
+
+			if( ( buffer_pool->arena == NULL )
+			 || ( buffer < buffer_pool->arena )
+			 || ( buffer >= &( buffer_pool->arena[ buffer_pool->arena_size ] ) ) )
+			{
+				memory_free(
+				 buffer );
+			}
+		}
+		memory_free(
+		 buffer_pool->free_buffers );
+
+		buffer_pool->free_buffers = NULL;
+	}
+#if defined( HAVE_LIBEWF_BUFFER_POOL_HUGE_PAGES )
+	if( buffer_pool->arena_is_mapped != 0 )
+	{
+		if( munmap(
+		     (void *) buffer_pool->arena,
+		     buffer_pool->arena_size ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to unmap arena.",
+			 function );
+
+			result = -1;
+		}
+		buffer_pool->arena           = NULL;
+		buffer_pool->arena_size      = 0;
+		buffer_pool->arena_is_mapped = 0;
+	}
+#endif
+	buffer_pool->buffer_size                    = 0;
+	buffer_pool->number_of_free_buffers         = 0;
+	buffer_pool->number_of_free_heap_buffers    = 0;
+	buffer_pool->maximum_number_of_heap_buffers = 0;
+	buffer_pool->number_of_arena_buffers        = 0;
+
+	return( result );
+}
+
+/* Sets the buffer size of the buffer pool
+ * Carves the arena, if available, into buffers of the buffer size
+ * This function does not grab the mutex
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffer_pool_set_buffer_size(
+     libewf_buffer_pool_t *buffer_pool,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_BUFFER_POOL_HUGE_PAGES )
+	void *mapped_data                       = NULL;
+	size_t mapped_size                      = 0;
+#endif
+	static char *function                   = "libewf_buffer_pool_set_buffer_size";
+	size64_t maximum_number_of_heap_buffers = 0;
+	size_t arena_offset                     = 0;
+	int buffer_index                        = 0;
+	int number_of_buffers                   = 0;
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_pool->number_of_used_buffers != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid buffer pool - buffers are in use.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_pool->free_buffers != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid buffer pool - free buffers value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_heap_buffers = buffer_pool->maximum_size / buffer_size;
+
+	if( maximum_number_of_heap_buffers > (size64_t) ( INT_MAX / 2 ) )
+	{
+		maximum_number_of_heap_buffers = (size64_t) ( INT_MAX / 2 );
+	}
+#if defined( HAVE_LIBEWF_BUFFER_POOL_HUGE_PAGES )
+	/* A failure to map the arena is not an error, the buffers are then allocated from the heap
+	 */
+	if( ( buffer_pool->arena == NULL )
+	 && ( ( buffer_pool->flags & LIBEWF_BUFFER_POOL_FLAG_USE_HUGE_PAGES ) != 0 )
+	 && ( maximum_number_of_heap_buffers > 0 )
+	 && ( maximum_number_of_heap_buffers <= (size64_t) ( ( SSIZE_MAX - LIBEWF_BUFFER_POOL_HUGE_PAGE_SIZE ) / buffer_size ) ) )
+	{
+		mapped_size = (size_t) maximum_number_of_heap_buffers * buffer_size;
+
+		if( ( mapped_size % LIBEWF_BUFFER_POOL_HUGE_PAGE_SIZE ) != 0 )
+		{
+			mapped_size += LIBEWF_BUFFER_POOL_HUGE_PAGE_SIZE - ( mapped_size % LIBEWF_BUFFER_POOL_HUGE_PAGE_SIZE );
+		}
+		mapped_data = MAP_FAILED;
+
+#if defined( MAP_HUGETLB )
+		mapped_data = mmap(
+		               NULL,
+		               mapped_size,
+		               PROT_READ | PROT_WRITE,
+		               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+		               -1,
+		               0 );
+#endif
+		/* Fall back to transparent huge pages if no huge pages are reserved
+		 */
+		if( mapped_data == MAP_FAILED )
+		{
+			mapped_data = mmap(
+			               NULL,
+			               mapped_size,
+			               PROT_READ | PROT_WRITE,
+			               MAP_PRIVATE | MAP_ANONYMOUS,
+			               -1,
+			               0 );
+
+#if defined( HAVE_MADVISE ) && defined( MADV_HUGEPAGE )
+			if( mapped_data != MAP_FAILED )
+			{
+				madvise(
+				 mapped_data,
+				 mapped_size,
+				 MADV_HUGEPAGE );
+			}
+#endif
+		}
+		if( mapped_data != MAP_FAILED )
+		{
+			buffer_pool->arena           = (uint8_t *) mapped_data;
+			buffer_pool->arena_size      = mapped_size;
+			buffer_pool->arena_is_mapped = 1;
+		}
+	}
+#endif /* defined( HAVE_LIBEWF_BUFFER_POOL_HUGE_PAGES ) */
+
+	if( buffer_pool->arena != NULL )
+	{
+		arena_offset = (size_t) ( (intptr_t) buffer_pool->arena % LIBEWF_BUFFER_POOL_ALIGNMENT );
+
+		if( arena_offset != 0 )
+		{
+			arena_offset = LIBEWF_BUFFER_POOL_ALIGNMENT - arena_offset;
+		}
+		if( arena_offset < buffer_pool->arena_size )
+		{
+			if( ( ( buffer_pool->arena_size - arena_offset ) / buffer_size ) > (size_t) ( INT_MAX / 2 ) )
+			{
+				buffer_pool->number_of_arena_buffers = INT_MAX / 2;
+			}
+			else
+			{
+				buffer_pool->number_of_arena_buffers = (int) ( ( buffer_pool->arena_size - arena_offset ) / buffer_size );
+			}
+		}
+		/* The arena counts towards the maximum size of the retained buffers
+		 */
+		if( buffer_pool->arena_is_mapped != 0 )
+		{
+			maximum_number_of_heap_buffers = 0;
+		}
+		else if( maximum_number_of_heap_buffers > (size64_t) buffer_pool->number_of_arena_buffers )
+		{
+			maximum_number_of_heap_buffers -= buffer_pool->number_of_arena_buffers;
+		}
+		else
+		{
+			maximum_number_of_heap_buffers = 0;
+		}
+	}
+	buffer_pool->maximum_number_of_heap_buffers = (int) maximum_number_of_heap_buffers;
+
+	number_of_buffers = buffer_pool->number_of_arena_buffers + buffer_pool->maximum_number_of_heap_buffers;
+
+	if( number_of_buffers > 0 )
+	{
+		buffer_pool->free_buffers = (uint8_t **) memory_allocate(
+		                                          sizeof( uint8_t * ) * number_of_buffers );
+
+		if( buffer_pool->free_buffers == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create free buffers.",
+			 function );
+
+			goto on_error;
+		}
+		for( buffer_index = 0;
+		     buffer_index < buffer_pool->number_of_arena_buffers;
+		     buffer_index++ )
+		{
+			buffer_pool->free_buffers[ buffer_index ] = &( buffer_pool->arena[ arena_offset ] );
+
+			arena_offset += buffer_size;
+		}
+		buffer_pool->number_of_free_buffers = buffer_pool->number_of_arena_buffers;
+	}
+	buffer_pool->buffer_size = buffer_size;
+
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_BUFFER_POOL_HUGE_PAGES )
+	if( buffer_pool->arena_is_mapped != 0 )
+	{
+		munmap(
+		 (void *) buffer_pool->arena,
+		 buffer_pool->arena_size );
+
+		buffer_pool->arena           = NULL;
+		buffer_pool->arena_size      = 0;
+		buffer_pool->arena_is_mapped = 0;
+	}
+#endif
+	buffer_pool->number_of_arena_buffers        = 0;
+	buffer_pool->maximum_number_of_heap_buffers = 0;
+
+	return( -1 );
+}
+
+/* Sets the buffer pool values
+ * A maximum size of 0 disables the retention of heap allocated buffers
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffer_pool_set_values(
+     libewf_buffer_pool_t *buffer_pool,
+     size64_t maximum_size,
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffer_pool_set_values";
+	int result            = 1;
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( flags & ~( LIBEWF_BUFFER_POOL_FLAG_USE_HUGE_PAGES ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported flags: 0x%02" PRIx8 ".",
+		 function,
+		 flags );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     buffer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( buffer_pool->number_of_used_buffers != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid buffer pool - buffers are in use.",
+		 function );
+
+		result = -1;
+	}
+	else if( libewf_buffer_pool_empty(
+	          buffer_pool,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty buffer pool.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		buffer_pool->maximum_size = maximum_size;
+		buffer_pool->flags        = flags;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     buffer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets a caller provided arena the buffers are carved from
+ * The arena is not managed by the buffer pool and must remain available while the buffer pool is used
+ * An arena of NULL removes a previously set arena
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffer_pool_set_arena(
+     libewf_buffer_pool_t *buffer_pool,
+     uint8_t *arena,
+     size_t arena_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffer_pool_set_arena";
+	int result            = 1;
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( arena != NULL )
+	 && ( ( arena_size == 0 )
+	  ||  ( arena_size > (size_t) SSIZE_MAX ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid arena size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     buffer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( buffer_pool->number_of_used_buffers != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid buffer pool - buffers are in use.",
+		 function );
+
+		result = -1;
+	}
+	else if( libewf_buffer_pool_empty(
+	          buffer_pool,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty buffer pool.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		buffer_pool->arena      = arena;
+		buffer_pool->arena_size = 0;
+
+		if( arena != NULL )
+		{
+			buffer_pool->arena_size = arena_size;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     buffer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a buffer from the buffer pool
+ * The buffer size is rounded up to the alignment and the pool is sized for the first buffer size requested.
+ * A different buffer size is only supported when none of the buffers are in use.
+ * Returns 1 if successful, 0 if no buffer is available from the pool or -1 on error
+ */
+int libewf_buffer_pool_get_buffer(
+     libewf_buffer_pool_t *buffer_pool,
+     size_t buffer_size,
+     uint8_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffer_pool_get_buffer";
+	int result            = 0;
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) ( SSIZE_MAX - LIBEWF_BUFFER_POOL_ALIGNMENT ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size % LIBEWF_BUFFER_POOL_ALIGNMENT ) != 0 )
+	{
+		buffer_size += LIBEWF_BUFFER_POOL_ALIGNMENT - ( buffer_size % LIBEWF_BUFFER_POOL_ALIGNMENT );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     buffer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( buffer_pool->buffer_size != buffer_size )
+	{
+		if( buffer_pool->number_of_used_buffers != 0 )
+		{
+			goto on_release;
+		}
+		if( libewf_buffer_pool_empty(
+		     buffer_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty buffer pool.",
+			 function );
+
+			result = -1;
+
+			goto on_release;
+		}
+		if( libewf_buffer_pool_set_buffer_size(
+		     buffer_pool,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set buffer size.",
+			 function );
+
+			result = -1;
+
+			goto on_release;
+		}
+	}
+	if( buffer_pool->free_buffers == NULL )
+	{
+		goto on_release;
+	}
+	if( buffer_pool->number_of_free_buffers > 0 )
+	{
+		buffer_pool->number_of_free_buffers -= 1;
+
+		*buffer = buffer_pool->free_buffers[ buffer_pool->number_of_free_buffers ];
+
+		if( ( buffer_pool->arena == NULL )
+		 || ( *buffer < buffer_pool->arena )
+		 || ( *buffer >= &( buffer_pool->arena[ buffer_pool->arena_size ] ) ) )
+		{
+			buffer_pool->number_of_free_heap_buffers -= 1;
+		}
+	}
+	else
+	{
+		*buffer = (uint8_t *) memory_allocate(
+		                       sizeof( uint8_t ) * buffer_size );
+
+		if( *buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			result = -1;
+
+			goto on_release;
+		}
+	}
+	buffer_pool->number_of_used_buffers += 1;
+
+	result = 1;
+
+on_release:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     buffer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Releases a buffer retrieved from the buffer pool
+ * The buffer is retained for reuse or freed if the pool is full
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffer_pool_release_buffer(
+     libewf_buffer_pool_t *buffer_pool,
+     uint8_t *buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffer_pool_release_buffer";
+	int result            = 1;
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     buffer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( buffer_pool->number_of_used_buffers <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer pool - number of used buffers value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		if( ( buffer_pool->arena != NULL )
+		 && ( buffer >= buffer_pool->arena )
+		 && ( buffer < &( buffer_pool->arena[ buffer_pool->arena_size ] ) ) )
+		{
+			buffer_pool->free_buffers[ buffer_pool->number_of_free_buffers ] = buffer;
+
+			buffer_pool->number_of_free_buffers += 1;
+		}
+		else if( buffer_pool->number_of_free_heap_buffers < buffer_pool->maximum_number_of_heap_buffers )
+		{
+			buffer_pool->free_buffers[ buffer_pool->number_of_free_buffers ] = buffer;
+
+			buffer_pool->number_of_free_buffers      += 1;
+			buffer_pool->number_of_free_heap_buffers += 1;
+		}
+		else
+		{
+			memory_free(
+			 buffer );
+		}
+		buffer_pool->number_of_used_buffers -= 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     buffer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
@@ -0,0 +1,162 @@
+/*
+ * Buffer pool functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_BUFFER_POOL_H )
+#define _LIBEWF_BUFFER_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* Huge pages are only used when anonymous memory can be mapped
+ */
+#if defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && defined( HAVE_SYS_MMAN_H ) && !defined( WINAPI )
+#define HAVE_LIBEWF_BUFFER_POOL_HUGE_PAGES	1
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default maximum size of the buffers retained by a buffer pool
+ */
+#define LIBEWF_BUFFER_POOL_DEFAULT_MAXIMUM_SIZE		( 16 * 1024 * 1024 )
+
+/* The alignment of the buffers carved from an arena
+ */
+#define LIBEWF_BUFFER_POOL_ALIGNMENT			64
+
+/* The size of a huge page an arena is rounded up to
+ */
+#define LIBEWF_BUFFER_POOL_HUGE_PAGE_SIZE		( 2 * 1024 * 1024 )
+
+typedef struct libewf_buffer_pool libewf_buffer_pool_t;
+
+struct libewf_buffer_pool
+{
+	/* The maximum size of the buffers retained by the pool
+	 */
+	size64_t maximum_size;
+
+	/* The flags
+	 */
+	uint8_t flags;
+
+	/* The buffer size, 0 if not determined
+	 */
+	size_t buffer_size;
+
+	/* The buffers that are available for reuse
+	 */
+	uint8_t **free_buffers;
+
+	/* The number of buffers that are available for reuse
+	 */
+	int number_of_free_buffers;
+
+	/* The number of heap allocated buffers that are available for reuse
+	 */
+	int number_of_free_heap_buffers;
+
+	/* The maximum number of heap allocated buffers that are retained
+	 */
+	int maximum_number_of_heap_buffers;
+
+	/* The number of buffers that are in use
+	 */
+	int number_of_used_buffers;
+
+	/* The arena
+	 */
+	uint8_t *arena;
+
+	/* The arena size
+	 */
+	size_t arena_size;
+
+	/* Value to indicate the arena was mapped by the pool
+	 */
+	uint8_t arena_is_mapped;
+
+	/* The number of buffers carved from the arena
+	 */
+	int number_of_arena_buffers;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_buffer_pool_initialize(
+     libewf_buffer_pool_t **buffer_pool,
+     libcerror_error_t **error );
+
+int libewf_buffer_pool_free(
+     libewf_buffer_pool_t **buffer_pool,
+     libcerror_error_t **error );
+
+int libewf_buffer_pool_clone(
+     libewf_buffer_pool_t **destination_buffer_pool,
+     libewf_buffer_pool_t *source_buffer_pool,
+     libcerror_error_t **error );
+
+int libewf_buffer_pool_empty(
+     libewf_buffer_pool_t *buffer_pool,
+     libcerror_error_t **error );
+
+int libewf_buffer_pool_set_buffer_size(
+     libewf_buffer_pool_t *buffer_pool,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libewf_buffer_pool_set_values(
+     libewf_buffer_pool_t *buffer_pool,
+     size64_t maximum_size,
+     uint8_t flags,
+     libcerror_error_t **error );
+
+int libewf_buffer_pool_set_arena(
+     libewf_buffer_pool_t *buffer_pool,
+     uint8_t *arena,
+     size_t arena_size,
+     libcerror_error_t **error );
+
+int libewf_buffer_pool_get_buffer(
+     libewf_buffer_pool_t *buffer_pool,
+     size_t buffer_size,
+     uint8_t **buffer,
+     libcerror_error_t **error );
+
+int libewf_buffer_pool_release_buffer(
+     libewf_buffer_pool_t *buffer_pool,
+     uint8_t *buffer,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_BUFFER_POOL_H ) */
+
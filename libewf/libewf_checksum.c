@@ -23,18 +23,573 @@
 #include <byte_stream.h>
 #include <types.h>
 
-#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
-#include <zlib.h>
-#endif
-
 #include "libewf_checksum.h"
 #include "libewf_libcerror.h"
 #include "libewf_types.h"
 
-#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+#if defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD )
+#include <immintrin.h>
+#endif
+
+/* Calculates the Adler-32 of a buffer without SIMD instructions
+ * It uses the initial value to calculate a new Adler-32
+ * Returns the Adler-32
+ */
+uint32_t libewf_checksum_calculate_adler32_scalar(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	size_t buffer_offset = 0;
+	uint32_t lower_word  = 0;
+	uint32_t upper_word  = 0;
+	uint32_t value_32bit = 0;
+	int block_index      = 0;
+
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( size >= 0x15b0 )
+	{
+		/* The modulo calculation is needed per 5552 (0x15b0) bytes
+		 * 5552 / 16 = 347
+		 */
+		for( block_index = 0;
+		     block_index < 347;
+		     block_index++ )
+		{
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+		}
+		/* Optimized equivalent of:
+		 * lower_word %= 0xfff1
+		 */
+		value_32bit = lower_word >> 16;
+		lower_word &= 0x0000ffffUL;
+		lower_word += ( value_32bit << 4 ) - value_32bit;
+
+		if( lower_word > 65521 )
+		{
+			value_32bit = lower_word >> 16;
+			lower_word &= 0x0000ffffUL;
+			lower_word += ( value_32bit << 4 ) - value_32bit;
+		}
+		if( lower_word >= 65521 )
+		{
+			lower_word -= 65521;
+		}
+		/* Optimized equivalent of:
+		 * upper_word %= 0xfff1
+		 */
+		value_32bit = upper_word >> 16;
+		upper_word &= 0x0000ffffUL;
+		upper_word += ( value_32bit << 4 ) - value_32bit;
+
+		if( upper_word > 65521 )
+		{
+			value_32bit = upper_word >> 16;
+			upper_word &= 0x0000ffffUL;
+			upper_word += ( value_32bit << 4 ) - value_32bit;
+		}
+		if( upper_word >= 65521 )
+		{
+			upper_word -= 65521;
+		}
+		size -= 0x15b0;
+	}
+	if( size > 0 )
+	{
+		while( size > 16 )
+		{
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			size -= 16;
+		}
+		while( size > 0 )
+		{
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			size--;
+		}
+		/* Optimized equivalent of:
+		 * lower_word %= 0xfff1
+		 */
+		value_32bit = lower_word >> 16;
+		lower_word &= 0x0000ffffUL;
+		lower_word += ( value_32bit << 4 ) - value_32bit;
+
+		if( lower_word > 65521 )
+		{
+			value_32bit = lower_word >> 16;
+			lower_word &= 0x0000ffffUL;
+			lower_word += ( value_32bit << 4 ) - value_32bit;
+		}
+		if( lower_word >= 65521 )
+		{
+			lower_word -= 65521;
+		}
+		/* Optimized equivalent of:
+		 * upper_word %= 0xfff1
+		 */
+		value_32bit = upper_word >> 16;
+		upper_word &= 0x0000ffffUL;
+		upper_word += ( value_32bit << 4 ) - value_32bit;
+
+		if( upper_word > 65521 )
+		{
+			value_32bit = upper_word >> 16;
+			upper_word &= 0x0000ffffUL;
+			upper_word += ( value_32bit << 4 ) - value_32bit;
+		}
+		if( upper_word >= 65521 )
+		{
+			upper_word -= 65521;
+		}
+	}
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+#if defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD )
+
+/* Calculates the Adler-32 of a buffer using SSE2 instructions
+ * The buffer is processed in blocks of 32 bytes, the remainder is processed by the scalar implementation
+ * It uses the initial value to calculate a new Adler-32
+ * Returns the Adler-32
+ */
+__attribute__ ((target( "sse2" )))
+uint32_t libewf_checksum_calculate_adler32_sse2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	uint32_t values_32bit[ 4 ];
+
+	__m128i block_data;
+	__m128i block_data_high;
+	__m128i block_data_low;
+	__m128i lower_word_sums;
+	__m128i previous_lower_word_sums;
+	__m128i upper_word_sums;
+	__m128i weights1;
+	__m128i weights2;
+	__m128i weights3;
+	__m128i weights4;
+	__m128i zero;
+
+	size_t number_of_blocks = 0;
+	size_t block_index      = 0;
+	uint32_t lower_word     = 0;
+	uint32_t upper_word     = 0;
+
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	weights1 = _mm_setr_epi16( 32, 31, 30, 29, 28, 27, 26, 25 );
+	weights2 = _mm_setr_epi16( 24, 23, 22, 21, 20, 19, 18, 17 );
+	weights3 = _mm_setr_epi16( 16, 15, 14, 13, 12, 11, 10, 9 );
+	weights4 = _mm_setr_epi16( 8, 7, 6, 5, 4, 3, 2, 1 );
+	zero     = _mm_setzero_si128();
+
+	while( size >= 32 )
+	{
+		/* The modulo calculation is needed per 5552 (0x15b0) bytes
+		 * 5552 / 32 = 173
+		 */
+		number_of_blocks = size / 32;
+
+		if( number_of_blocks > 173 )
+		{
+			number_of_blocks = 173;
+		}
+		size -= number_of_blocks * 32;
+
+		/* Every block adds 32 times the lower word of the previous blocks to the upper word
+		 */
+		previous_lower_word_sums = _mm_setr_epi32( (int) ( lower_word * number_of_blocks ), 0, 0, 0 );
+		upper_word_sums          = _mm_setr_epi32( (int) upper_word, 0, 0, 0 );
+		lower_word_sums          = _mm_setzero_si128();
+
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			previous_lower_word_sums = _mm_add_epi32(
+			                            previous_lower_word_sums,
+			                            lower_word_sums );
+
+			block_data = _mm_loadu_si128(
+			              (const __m128i *) buffer );
+
+			lower_word_sums = _mm_add_epi32(
+			                   lower_word_sums,
+			                   _mm_sad_epu8( block_data, zero ) );
+
+			block_data_low  = _mm_unpacklo_epi8( block_data, zero );
+			block_data_high = _mm_unpackhi_epi8( block_data, zero );
+
+			upper_word_sums = _mm_add_epi32(
+			                   upper_word_sums,
+			                   _mm_madd_epi16( block_data_low, weights1 ) );
+			upper_word_sums = _mm_add_epi32(
+			                   upper_word_sums,
+			                   _mm_madd_epi16( block_data_high, weights2 ) );
+
+			block_data = _mm_loadu_si128(
+			              (const __m128i *) &( buffer[ 16 ] ) );
+
+			lower_word_sums = _mm_add_epi32(
+			                   lower_word_sums,
+			                   _mm_sad_epu8( block_data, zero ) );
+
+			block_data_low  = _mm_unpacklo_epi8( block_data, zero );
+			block_data_high = _mm_unpackhi_epi8( block_data, zero );
+
+			upper_word_sums = _mm_add_epi32(
+			                   upper_word_sums,
+			                   _mm_madd_epi16( block_data_low, weights3 ) );
+			upper_word_sums = _mm_add_epi32(
+			                   upper_word_sums,
+			                   _mm_madd_epi16( block_data_high, weights4 ) );
+
+			buffer += 32;
+		}
+		upper_word_sums = _mm_add_epi32(
+		                   upper_word_sums,
+		                   _mm_slli_epi32( previous_lower_word_sums, 5 ) );
+
+		_mm_storeu_si128(
+		 (__m128i *) values_32bit,
+		 lower_word_sums );
+
+		lower_word += values_32bit[ 0 ] + values_32bit[ 1 ] + values_32bit[ 2 ] + values_32bit[ 3 ];
+
+		_mm_storeu_si128(
+		 (__m128i *) values_32bit,
+		 upper_word_sums );
+
+		upper_word = values_32bit[ 0 ] + values_32bit[ 1 ] + values_32bit[ 2 ] + values_32bit[ 3 ];
+
+		lower_word %= 65521;
+		upper_word %= 65521;
+	}
+	return( libewf_checksum_calculate_adler32_scalar(
+	         buffer,
+	         size,
+	         ( upper_word << 16 ) | lower_word ) );
+}
+
+/* Calculates the Adler-32 of a buffer using SSSE3 instructions
+ * The buffer is processed in blocks of 32 bytes, the remainder is processed by the scalar implementation
+ * It uses the initial value to calculate a new Adler-32
+ * Returns the Adler-32
+ */
+__attribute__ ((target( "ssse3" )))
+uint32_t libewf_checksum_calculate_adler32_ssse3(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	uint32_t values_32bit[ 4 ];
+
+	__m128i block_data;
+	__m128i lower_word_sums;
+	__m128i ones;
+	__m128i previous_lower_word_sums;
+	__m128i upper_word_sums;
+	__m128i weights1;
+	__m128i weights2;
+	__m128i zero;
+
+	size_t number_of_blocks = 0;
+	size_t block_index      = 0;
+	uint32_t lower_word     = 0;
+	uint32_t upper_word     = 0;
+
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	weights1 = _mm_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17 );
+	weights2 = _mm_setr_epi8( 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	ones     = _mm_set1_epi16( 1 );
+	zero     = _mm_setzero_si128();
+
+	while( size >= 32 )
+	{
+		/* The modulo calculation is needed per 5552 (0x15b0) bytes
+		 * 5552 / 32 = 173
+		 */
+		number_of_blocks = size / 32;
+
+		if( number_of_blocks > 173 )
+		{
+			number_of_blocks = 173;
+		}
+		size -= number_of_blocks * 32;
+
+		previous_lower_word_sums = _mm_setr_epi32( (int) ( lower_word * number_of_blocks ), 0, 0, 0 );
+		upper_word_sums          = _mm_setr_epi32( (int) upper_word, 0, 0, 0 );
+		lower_word_sums          = _mm_setzero_si128();
+
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			previous_lower_word_sums = _mm_add_epi32(
+			                            previous_lower_word_sums,
+			                            lower_word_sums );
+
+			block_data = _mm_loadu_si128(
+			              (const __m128i *) buffer );
+
+			lower_word_sums = _mm_add_epi32(
+			                   lower_word_sums,
+			                   _mm_sad_epu8( block_data, zero ) );
+			upper_word_sums = _mm_add_epi32(
+			                   upper_word_sums,
+			                   _mm_madd_epi16( _mm_maddubs_epi16( block_data, weights1 ), ones ) );
+
+			block_data = _mm_loadu_si128(
+			              (const __m128i *) &( buffer[ 16 ] ) );
+
+			lower_word_sums = _mm_add_epi32(
+			                   lower_word_sums,
+			                   _mm_sad_epu8( block_data, zero ) );
+			upper_word_sums = _mm_add_epi32(
+			                   upper_word_sums,
+			                   _mm_madd_epi16( _mm_maddubs_epi16( block_data, weights2 ), ones ) );
+
+			buffer += 32;
+		}
+		upper_word_sums = _mm_add_epi32(
+		                   upper_word_sums,
+		                   _mm_slli_epi32( previous_lower_word_sums, 5 ) );
+
+		_mm_storeu_si128(
+		 (__m128i *) values_32bit,
+		 lower_word_sums );
+
+		lower_word += values_32bit[ 0 ] + values_32bit[ 1 ] + values_32bit[ 2 ] + values_32bit[ 3 ];
+
+		_mm_storeu_si128(
+		 (__m128i *) values_32bit,
+		 upper_word_sums );
+
+		upper_word = values_32bit[ 0 ] + values_32bit[ 1 ] + values_32bit[ 2 ] + values_32bit[ 3 ];
+
+		lower_word %= 65521;
+		upper_word %= 65521;
+	}
+	return( libewf_checksum_calculate_adler32_scalar(
+	         buffer,
+	         size,
+	         ( upper_word << 16 ) | lower_word ) );
+}
+
+/* Calculates the Adler-32 of a buffer using AVX2 instructions
+ * The buffer is processed in blocks of 32 bytes, the remainder is processed by the scalar implementation
+ * It uses the initial value to calculate a new Adler-32
+ * Returns the Adler-32
+ */
+__attribute__ ((target( "avx2" )))
+uint32_t libewf_checksum_calculate_adler32_avx2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+	uint32_t values_32bit[ 8 ];
+
+	__m256i block_data;
+	__m256i lower_word_sums;
+	__m256i ones;
+	__m256i previous_lower_word_sums;
+	__m256i upper_word_sums;
+	__m256i weights;
+	__m256i zero;
+
+	size_t number_of_blocks = 0;
+	size_t block_index      = 0;
+	uint32_t lower_word     = 0;
+	uint32_t upper_word     = 0;
+	int value_index         = 0;
+
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	weights = _mm256_setr_epi8(
+	           32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+	           16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	ones    = _mm256_set1_epi16( 1 );
+	zero    = _mm256_setzero_si256();
+
+	while( size >= 32 )
+	{
+		/* The modulo calculation is needed per 5552 (0x15b0) bytes
+		 * 5552 / 32 = 173
+		 */
+		number_of_blocks = size / 32;
+
+		if( number_of_blocks > 173 )
+		{
+			number_of_blocks = 173;
+		}
+		size -= number_of_blocks * 32;
+
+		previous_lower_word_sums = _mm256_setr_epi32( (int) ( lower_word * number_of_blocks ), 0, 0, 0, 0, 0, 0, 0 );
+		upper_word_sums          = _mm256_setr_epi32( (int) upper_word, 0, 0, 0, 0, 0, 0, 0 );
+		lower_word_sums          = _mm256_setzero_si256();
+
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			previous_lower_word_sums = _mm256_add_epi32(
+			                            previous_lower_word_sums,
+			                            lower_word_sums );
+
+			block_data = _mm256_loadu_si256(
+			              (const __m256i *) buffer );
+
+			lower_word_sums = _mm256_add_epi32(
+			                   lower_word_sums,
+			                   _mm256_sad_epu8( block_data, zero ) );
+			upper_word_sums = _mm256_add_epi32(
+			                   upper_word_sums,
+			                   _mm256_madd_epi16( _mm256_maddubs_epi16( block_data, weights ), ones ) );
+
+			buffer += 32;
+		}
+		upper_word_sums = _mm256_add_epi32(
+		                   upper_word_sums,
+		                   _mm256_slli_epi32( previous_lower_word_sums, 5 ) );
+
+		_mm256_storeu_si256(
+		 (__m256i *) values_32bit,
+		 lower_word_sums );
+
+		for( value_index = 0;
+		     value_index < 8;
+		     value_index++ )
+		{
+			lower_word += values_32bit[ value_index ];
+		}
+		_mm256_storeu_si256(
+		 (__m256i *) values_32bit,
+		 upper_word_sums );
+
+		upper_word = 0;
+
+		for( value_index = 0;
+		     value_index < 8;
+		     value_index++ )
+		{
+			upper_word += values_32bit[ value_index ];
+		}
+		lower_word %= 65521;
+		upper_word %= 65521;
+	}
+	return( libewf_checksum_calculate_adler32_scalar(
+	         buffer,
+	         size,
+	         ( upper_word << 16 ) | lower_word ) );
+}
+
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD ) */
 
 /* Calculates the little-endian Adler-32 of a buffer
  * It uses the initial value to calculate a new Adler-32
+ * The implementation is selected at run-time based on the instructions supported by the CPU
  * Returns 1 if successful or -1 on error
  */
 int libewf_checksum_calculate_adler32(
@@ -68,7 +623,7 @@ int libewf_checksum_calculate_adler32(
 
 		return( -1 );
 	}
-	if( size > (size_t) UINT_MAX )
+	if( size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
@@ -79,13 +634,44 @@ int libewf_checksum_calculate_adler32(
 
 		return( -1 );
 	}
-	*checksum_value = adler32(
-	                   (uLong) initial_value,
-	                   (const Bytef *) buffer,
-	                   (uInt) size );
+#if defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD )
+	if( size >= 64 )
+	{
+		if( __builtin_cpu_supports( "avx2" ) )
+		{
+			*checksum_value = libewf_checksum_calculate_adler32_avx2(
+			                   buffer,
+			                   size,
+			                   initial_value );
+
+			return( 1 );
+		}
+		if( __builtin_cpu_supports( "ssse3" ) )
+		{
+			*checksum_value = libewf_checksum_calculate_adler32_ssse3(
+			                   buffer,
+			                   size,
+			                   initial_value );
+
+			return( 1 );
+		}
+		if( __builtin_cpu_supports( "sse2" ) )
+		{
+			*checksum_value = libewf_checksum_calculate_adler32_sse2(
+			                   buffer,
+			                   size,
+			                   initial_value );
+
+			return( 1 );
+		}
+	}
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD ) */
+
+	*checksum_value = libewf_checksum_calculate_adler32_scalar(
+	                   buffer,
+	                   size,
+	                   initial_value );
 
 	return( 1 );
 }
 
-#endif /* defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
-
@@ -25,14 +25,44 @@
 #include <common.h>
 #include <types.h>
 
-#include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 
+/* The x86 SIMD implementations require compiler support for the target function attribute
+ * and run-time CPU feature detection
+ */
+#if !defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#if defined( __clang__ ) || ( defined( __GNUC__ ) && ( ( __GNUC__ > 4 ) || ( ( __GNUC__ == 4 ) && ( __GNUC_MINOR__ >= 9 ) ) ) )
+#define LIBEWF_CHECKSUM_HAVE_X86_SIMD
+#endif
+#endif
+
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
-#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+uint32_t libewf_checksum_calculate_adler32_scalar(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value );
+
+#if defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD )
+
+uint32_t libewf_checksum_calculate_adler32_sse2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value );
+
+uint32_t libewf_checksum_calculate_adler32_ssse3(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value );
+
+uint32_t libewf_checksum_calculate_adler32_avx2(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value );
+
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD ) */
 
 int libewf_checksum_calculate_adler32(
      uint32_t *checksum_value,
@@ -41,12 +71,6 @@ int libewf_checksum_calculate_adler32(
      uint32_t initial_value,
      libcerror_error_t **error );
 
-#else
-#define libewf_checksum_calculate_adler32( checksum_value, buffer, size, initial_value, error ) \
-	libewf_deflate_calculate_adler32( checksum_value, buffer, size, initial_value, error )
-
-#endif /* defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
-
 #if defined( __cplusplus )
 }
 #endif
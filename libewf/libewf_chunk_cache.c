@@ -0,0 +1,1040 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_cache.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+
+/* The chunk cache uses the 2Q replacement policy.
+ * A chunk that is added to the cache for the first time is placed in the in queue,
+ * which is a FIFO that holds about a quarter of the cached chunks. When a chunk
+ * is removed from the in queue only its index is kept in the out queue. A chunk
+ * that is added while its index is in the out queue is placed in the main queue,
+ * which is a LRU. A single linear scan therefore only replaces the in queue and
+ * leaves the chunks that are used repeatedly in the main queue.
+ */
+
+/* Creates a chunk cache
+ * Make sure the value chunk_cache is referencing, is set to NULL
+ * The maximum cache size must at least fit a single chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     size64_t maximum_cache_size,
+     size32_t chunk_size,
+     libcerror_error_t **error )
+{
+	static char *function              = "libewf_chunk_cache_initialize";
+	size64_t entry_size                = 0;
+	size64_t maximum_number_of_entries = 0;
+	size_t entries_size                = 0;
+	size_t hash_buckets_size           = 0;
+	int entry_index                    = 0;
+	int hash_bucket_index              = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entry_size = (size64_t) chunk_size + sizeof( libewf_chunk_cache_entry_t );
+
+	maximum_number_of_entries = maximum_cache_size / entry_size;
+
+	if( maximum_number_of_entries == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid maximum cache size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	else if( maximum_number_of_entries > LIBEWF_MAXIMUM_CHUNK_CACHE_NUMBER_OF_ENTRIES )
+	{
+		maximum_number_of_entries = LIBEWF_MAXIMUM_CHUNK_CACHE_NUMBER_OF_ENTRIES;
+	}
+	*chunk_cache = memory_allocate_structure(
+	                libewf_chunk_cache_t );
+
+	if( *chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_cache,
+	     0,
+	     sizeof( libewf_chunk_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk cache.",
+		 function );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+
+		return( -1 );
+	}
+	( *chunk_cache )->chunk_size                    = chunk_size;
+	( *chunk_cache )->maximum_number_of_entries     = (int) maximum_number_of_entries;
+	( *chunk_cache )->maximum_number_of_in_entries  = (int) ( maximum_number_of_entries / 4 );
+	( *chunk_cache )->maximum_number_of_out_entries = (int) ( maximum_number_of_entries / 2 );
+
+	if( ( *chunk_cache )->maximum_number_of_in_entries == 0 )
+	{
+		( *chunk_cache )->maximum_number_of_in_entries = 1;
+	}
+	if( ( *chunk_cache )->maximum_number_of_out_entries == 0 )
+	{
+		( *chunk_cache )->maximum_number_of_out_entries = 1;
+	}
+	/* The entries in the out queue do not contain data
+	 */
+	( *chunk_cache )->number_of_entries = ( *chunk_cache )->maximum_number_of_entries
+	                                    + ( *chunk_cache )->maximum_number_of_out_entries;
+
+	entries_size = sizeof( libewf_chunk_cache_entry_t ) * ( *chunk_cache )->number_of_entries;
+
+	( *chunk_cache )->entries = (libewf_chunk_cache_entry_t *) memory_allocate(
+	                                                            entries_size );
+
+	if( ( *chunk_cache )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache )->entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	/* The unused entries are chained using the next entry index
+	 */
+	for( entry_index = 0;
+	     entry_index < ( *chunk_cache )->number_of_entries;
+	     entry_index++ )
+	{
+		( *chunk_cache )->entries[ entry_index ].previous_entry_index  = -1;
+		( *chunk_cache )->entries[ entry_index ].next_entry_index      = entry_index + 1;
+		( *chunk_cache )->entries[ entry_index ].next_hash_entry_index = -1;
+	}
+	( *chunk_cache )->entries[ ( *chunk_cache )->number_of_entries - 1 ].next_entry_index = -1;
+
+	( *chunk_cache )->first_unused_entry_index = 0;
+
+	( *chunk_cache )->number_of_hash_buckets = 1;
+
+	while( ( *chunk_cache )->number_of_hash_buckets < ( *chunk_cache )->number_of_entries )
+	{
+		( *chunk_cache )->number_of_hash_buckets <<= 1;
+	}
+	hash_buckets_size = sizeof( int ) * ( *chunk_cache )->number_of_hash_buckets;
+
+	( *chunk_cache )->hash_buckets = (int *) memory_allocate(
+	                                          hash_buckets_size );
+
+	if( ( *chunk_cache )->hash_buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash buckets.",
+		 function );
+
+		goto on_error;
+	}
+	for( hash_bucket_index = 0;
+	     hash_bucket_index < ( *chunk_cache )->number_of_hash_buckets;
+	     hash_bucket_index++ )
+	{
+		( *chunk_cache )->hash_buckets[ hash_bucket_index ] = -1;
+	}
+	( *chunk_cache )->in_queue.first_entry_index   = -1;
+	( *chunk_cache )->in_queue.last_entry_index    = -1;
+	( *chunk_cache )->main_queue.first_entry_index = -1;
+	( *chunk_cache )->main_queue.last_entry_index  = -1;
+	( *chunk_cache )->out_queue.first_entry_index  = -1;
+	( *chunk_cache )->out_queue.last_entry_index   = -1;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_cache != NULL )
+	{
+		if( ( *chunk_cache )->entries != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->entries );
+		}
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_free";
+	int entry_index       = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		for( entry_index = 0;
+		     entry_index < ( *chunk_cache )->number_of_entries;
+		     entry_index++ )
+		{
+			if( ( *chunk_cache )->entries[ entry_index ].data != NULL )
+			{
+				memory_free(
+				 ( *chunk_cache )->entries[ entry_index ].data );
+			}
+		}
+		memory_free(
+		 ( *chunk_cache )->hash_buckets );
+
+		memory_free(
+		 ( *chunk_cache )->entries );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the data of a specific chunk
+ * The data is owned by the cache and remains valid until the next call to libewf_chunk_cache_set_data
+ * Returns 1 if successful, 0 if the chunk is not cached or -1 on error
+ */
+int libewf_chunk_cache_get_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_get_data";
+	int entry_index                   = 0;
+	int result                        = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_cache_get_entry_index(
+	          chunk_cache,
+	          chunk_index,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	entry = &( chunk_cache->entries[ entry_index ] );
+
+	if( entry->queue == LIBEWF_CHUNK_CACHE_QUEUE_OUT )
+	{
+		return( 0 );
+	}
+	/* Chunks in the in queue keep their position, chunks in the main queue
+	 * are moved to the front
+	 */
+	if( entry->queue == LIBEWF_CHUNK_CACHE_QUEUE_MAIN )
+	{
+		if( libewf_chunk_cache_queue_remove_entry(
+		     chunk_cache,
+		     &( chunk_cache->main_queue ),
+		     entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry: %d from main queue.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( libewf_chunk_cache_queue_prepend_entry(
+		     chunk_cache,
+		     &( chunk_cache->main_queue ),
+		     entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to prepend entry: %d to main queue.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	*data      = entry->data;
+	*data_size = entry->data_size;
+
+	return( 1 );
+}
+
+/* Sets the data of a specific chunk
+ * The data is copied into the cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_set_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry        = NULL;
+	libewf_chunk_cache_queue_t *target_queue = NULL;
+	uint8_t *entry_data                      = NULL;
+	static char *function                    = "libewf_chunk_cache_set_data";
+	int entry_index                          = 0;
+	int hash_bucket_index                    = 0;
+	int victim_entry_index                   = 0;
+	int result                               = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) chunk_cache->chunk_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_cache_get_entry_index(
+	          chunk_cache,
+	          chunk_index,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		entry = &( chunk_cache->entries[ entry_index ] );
+
+		if( entry->queue != LIBEWF_CHUNK_CACHE_QUEUE_OUT )
+		{
+			/* The chunk is already cached, replace its data
+			 */
+			if( memory_copy(
+			     entry->data,
+			     data,
+			     data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data.",
+				 function );
+
+				return( -1 );
+			}
+			entry->data_size = data_size;
+
+			return( 1 );
+		}
+		/* The chunk was recently removed from the in queue and is used again
+		 */
+		if( libewf_chunk_cache_queue_remove_entry(
+		     chunk_cache,
+		     &( chunk_cache->out_queue ),
+		     entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry: %d from out queue.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		target_queue = &( chunk_cache->main_queue );
+	}
+	else
+	{
+		entry_index  = -1;
+		target_queue = &( chunk_cache->in_queue );
+	}
+	/* Make room for the chunk
+	 */
+	if( ( chunk_cache->in_queue.number_of_entries + chunk_cache->main_queue.number_of_entries ) >= chunk_cache->maximum_number_of_entries )
+	{
+		if( ( chunk_cache->in_queue.number_of_entries > chunk_cache->maximum_number_of_in_entries )
+		 || ( chunk_cache->main_queue.number_of_entries == 0 ) )
+		{
+			/* Move the oldest chunk of the in queue to the out queue
+			 */
+			victim_entry_index = chunk_cache->in_queue.last_entry_index;
+
+			if( libewf_chunk_cache_queue_remove_entry(
+			     chunk_cache,
+			     &( chunk_cache->in_queue ),
+			     victim_entry_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove entry: %d from in queue.",
+				 function,
+				 victim_entry_index );
+
+				return( -1 );
+			}
+			entry_data = chunk_cache->entries[ victim_entry_index ].data;
+
+			chunk_cache->entries[ victim_entry_index ].data      = NULL;
+			chunk_cache->entries[ victim_entry_index ].data_size = 0;
+
+			if( chunk_cache->out_queue.number_of_entries >= chunk_cache->maximum_number_of_out_entries )
+			{
+				if( libewf_chunk_cache_remove_hash_entry(
+				     chunk_cache,
+				     chunk_cache->out_queue.last_entry_index,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+					 "%s: unable to remove oldest entry of out queue.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( libewf_chunk_cache_queue_prepend_entry(
+			     chunk_cache,
+			     &( chunk_cache->out_queue ),
+			     victim_entry_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to prepend entry: %d to out queue.",
+				 function,
+				 victim_entry_index );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			/* Remove the least recently used chunk of the main queue
+			 */
+			victim_entry_index = chunk_cache->main_queue.last_entry_index;
+
+			entry_data = chunk_cache->entries[ victim_entry_index ].data;
+
+			chunk_cache->entries[ victim_entry_index ].data      = NULL;
+			chunk_cache->entries[ victim_entry_index ].data_size = 0;
+
+			if( libewf_chunk_cache_remove_hash_entry(
+			     chunk_cache,
+			     victim_entry_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove entry: %d from main queue.",
+				 function,
+				 victim_entry_index );
+
+				goto on_error;
+			}
+		}
+	}
+	if( entry_index == -1 )
+	{
+		entry_index = chunk_cache->first_unused_entry_index;
+
+		if( entry_index == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid chunk cache - missing unused entry.",
+			 function );
+
+			goto on_error;
+		}
+		entry = &( chunk_cache->entries[ entry_index ] );
+
+		chunk_cache->first_unused_entry_index = entry->next_entry_index;
+
+		hash_bucket_index = (int) ( chunk_index & (uint64_t) ( chunk_cache->number_of_hash_buckets - 1 ) );
+
+		entry->chunk_index           = chunk_index;
+		entry->next_hash_entry_index = chunk_cache->hash_buckets[ hash_bucket_index ];
+
+		chunk_cache->hash_buckets[ hash_bucket_index ] = entry_index;
+	}
+	if( entry_data == NULL )
+	{
+		entry_data = (uint8_t *) memory_allocate(
+		                          sizeof( uint8_t ) * chunk_cache->chunk_size );
+
+		if( entry_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entry data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( memory_copy(
+	     entry_data,
+	     data,
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy data.",
+		 function );
+
+		goto on_error;
+	}
+	entry->data      = entry_data;
+	entry->data_size = data_size;
+
+	if( libewf_chunk_cache_queue_prepend_entry(
+	     chunk_cache,
+	     target_queue,
+	     entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to prepend entry: %d to queue.",
+		 function,
+		 entry_index );
+
+		entry->data      = NULL;
+		entry->data_size = 0;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( entry_data != NULL )
+	{
+		memory_free(
+		 entry_data );
+	}
+	return( -1 );
+}
+
+/* Retrieves the index of the entry of a specific chunk
+ * Returns 1 if successful, 0 if no such entry or -1 on error
+ */
+int libewf_chunk_cache_get_entry_index(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     int *entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_get_entry_index";
+	int hash_bucket_index = 0;
+	int safe_entry_index  = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	hash_bucket_index = (int) ( chunk_index & (uint64_t) ( chunk_cache->number_of_hash_buckets - 1 ) );
+
+	safe_entry_index = chunk_cache->hash_buckets[ hash_bucket_index ];
+
+	while( safe_entry_index != -1 )
+	{
+		if( chunk_cache->entries[ safe_entry_index ].chunk_index == chunk_index )
+		{
+			*entry_index = safe_entry_index;
+
+			return( 1 );
+		}
+		safe_entry_index = chunk_cache->entries[ safe_entry_index ].next_hash_entry_index;
+	}
+	return( 0 );
+}
+
+/* Removes an entry from a queue
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_queue_remove_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_queue_t *queue,
+     int entry_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_queue_remove_entry";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= chunk_cache->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entry = &( chunk_cache->entries[ entry_index ] );
+
+	if( entry->previous_entry_index != -1 )
+	{
+		chunk_cache->entries[ entry->previous_entry_index ].next_entry_index = entry->next_entry_index;
+	}
+	else
+	{
+		queue->first_entry_index = entry->next_entry_index;
+	}
+	if( entry->next_entry_index != -1 )
+	{
+		chunk_cache->entries[ entry->next_entry_index ].previous_entry_index = entry->previous_entry_index;
+	}
+	else
+	{
+		queue->last_entry_index = entry->previous_entry_index;
+	}
+	entry->previous_entry_index = -1;
+	entry->next_entry_index     = -1;
+	entry->queue                = LIBEWF_CHUNK_CACHE_QUEUE_UNUSED;
+
+	queue->number_of_entries -= 1;
+
+	return( 1 );
+}
+
+/* Prepends an entry to a queue
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_queue_prepend_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_queue_t *queue,
+     int entry_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_queue_prepend_entry";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= chunk_cache->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entry = &( chunk_cache->entries[ entry_index ] );
+
+	entry->previous_entry_index = -1;
+	entry->next_entry_index     = queue->first_entry_index;
+
+	if( queue->first_entry_index != -1 )
+	{
+		chunk_cache->entries[ queue->first_entry_index ].previous_entry_index = entry_index;
+	}
+	else
+	{
+		queue->last_entry_index = entry_index;
+	}
+	queue->first_entry_index = entry_index;
+
+	if( queue == &( chunk_cache->in_queue ) )
+	{
+		entry->queue = LIBEWF_CHUNK_CACHE_QUEUE_IN;
+	}
+	else if( queue == &( chunk_cache->main_queue ) )
+	{
+		entry->queue = LIBEWF_CHUNK_CACHE_QUEUE_MAIN;
+	}
+	else
+	{
+		entry->queue = LIBEWF_CHUNK_CACHE_QUEUE_OUT;
+	}
+	queue->number_of_entries += 1;
+
+	return( 1 );
+}
+
+/* Removes an entry from its queue and the hash buckets and marks it as unused
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_remove_hash_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     int entry_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	libewf_chunk_cache_queue_t *queue = NULL;
+	static char *function             = "libewf_chunk_cache_remove_hash_entry";
+	int hash_bucket_index             = 0;
+	int previous_entry_index          = 0;
+	int safe_entry_index              = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= chunk_cache->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entry = &( chunk_cache->entries[ entry_index ] );
+
+	switch( entry->queue )
+	{
+		case LIBEWF_CHUNK_CACHE_QUEUE_IN:
+			queue = &( chunk_cache->in_queue );
+			break;
+
+		case LIBEWF_CHUNK_CACHE_QUEUE_MAIN:
+			queue = &( chunk_cache->main_queue );
+			break;
+
+		case LIBEWF_CHUNK_CACHE_QUEUE_OUT:
+			queue = &( chunk_cache->out_queue );
+			break;
+
+		default:
+			break;
+	}
+	if( queue != NULL )
+	{
+		if( libewf_chunk_cache_queue_remove_entry(
+		     chunk_cache,
+		     queue,
+		     entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry: %d from queue.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	hash_bucket_index = (int) ( entry->chunk_index & (uint64_t) ( chunk_cache->number_of_hash_buckets - 1 ) );
+
+	previous_entry_index = -1;
+	safe_entry_index     = chunk_cache->hash_buckets[ hash_bucket_index ];
+
+	while( safe_entry_index != -1 )
+	{
+		if( safe_entry_index == entry_index )
+		{
+			if( previous_entry_index == -1 )
+			{
+				chunk_cache->hash_buckets[ hash_bucket_index ] = entry->next_hash_entry_index;
+			}
+			else
+			{
+				chunk_cache->entries[ previous_entry_index ].next_hash_entry_index = entry->next_hash_entry_index;
+			}
+			break;
+		}
+		previous_entry_index = safe_entry_index;
+		safe_entry_index     = chunk_cache->entries[ safe_entry_index ].next_hash_entry_index;
+	}
+	entry->next_hash_entry_index = -1;
+	entry->next_entry_index      = chunk_cache->first_unused_entry_index;
+
+	chunk_cache->first_unused_entry_index = entry_index;
+
+	return( 1 );
+}
+
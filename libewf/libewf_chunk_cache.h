@@ -0,0 +1,189 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_CACHE_H )
+#define _LIBEWF_CHUNK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_cache_entry libewf_chunk_cache_entry_t;
+
+struct libewf_chunk_cache_entry
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The data, which is NULL for an entry in the out queue
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The queue the entry is in
+	 */
+	uint8_t queue;
+
+	/* The index of the previous entry in the queue
+	 */
+	int previous_entry_index;
+
+	/* The index of the next entry in the queue
+	 */
+	int next_entry_index;
+
+	/* The index of the next entry in the hash bucket
+	 */
+	int next_hash_entry_index;
+};
+
+typedef struct libewf_chunk_cache_queue libewf_chunk_cache_queue_t;
+
+struct libewf_chunk_cache_queue
+{
+	/* The index of the first (most recently used) entry
+	 */
+	int first_entry_index;
+
+	/* The index of the last (least recently used) entry
+	 */
+	int last_entry_index;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+};
+
+typedef struct libewf_chunk_cache libewf_chunk_cache_t;
+
+struct libewf_chunk_cache
+{
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The maximum number of entries that contain data
+	 */
+	int maximum_number_of_entries;
+
+	/* The maximum number of entries in the in queue
+	 */
+	int maximum_number_of_in_entries;
+
+	/* The maximum number of entries in the out queue
+	 */
+	int maximum_number_of_out_entries;
+
+	/* The entries
+	 */
+	libewf_chunk_cache_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The index of the first unused entry
+	 */
+	int first_unused_entry_index;
+
+	/* The hash buckets
+	 */
+	int *hash_buckets;
+
+	/* The number of hash buckets, which is a power of 2
+	 */
+	int number_of_hash_buckets;
+
+	/* The in queue, which contains chunks that were used once
+	 */
+	libewf_chunk_cache_queue_t in_queue;
+
+	/* The main queue, which contains chunks that were used more than once
+	 */
+	libewf_chunk_cache_queue_t main_queue;
+
+	/* The out queue, which contains the chunk indexes recently removed from the in queue
+	 */
+	libewf_chunk_cache_queue_t out_queue;
+};
+
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     size64_t maximum_cache_size,
+     size32_t chunk_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_set_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_entry_index(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     int *entry_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_queue_remove_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_queue_t *queue,
+     int entry_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_queue_prepend_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_queue_t *queue,
+     int entry_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_remove_hash_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     int entry_index,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_CACHE_H ) */
+
@@ -24,10 +24,14 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_buffer_pool.h"
 #include "libewf_checksum.h"
 #include "libewf_chunk_data.h"
+#include "libewf_coalesced_read_buffer.h"
 #include "libewf_compression.h"
 #include "libewf_definitions.h"
+#include "libewf_file_io_pool.h"
+#include "libewf_fill.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
@@ -35,19 +39,23 @@
 #include "libewf_libfdata.h"
 #include "libewf_types.h"
 #include "libewf_unused.h"
+#include "libewf_write_behind_buffer.h"
 
 /* Creates chunk data
  * Make sure the value chunk_data is referencing, is set to NULL
+ * The buffer pool is optional and is not managed by the chunk data
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_data_initialize(
      libewf_chunk_data_t **chunk_data,
      size32_t chunk_size,
+     libewf_buffer_pool_t *buffer_pool,
      uint8_t clear_data,
      libcerror_error_t **error )
 {
 	static char *function      = "libewf_chunk_data_initialize";
 	size_t allocated_data_size = 0;
+	uint8_t is_pooled          = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -128,10 +136,15 @@ int libewf_chunk_data_initialize(
 	}
 	allocated_data_size = ( allocated_data_size / 16 ) * 16;
 
-	( *chunk_data )->data = (uint8_t *) memory_allocate(
-					     sizeof( uint8_t ) * allocated_data_size );
+	( *chunk_data )->chunk_size  = chunk_size;
+	( *chunk_data )->buffer_pool = buffer_pool;
 
-	if( ( *chunk_data )->data == NULL )
+	if( libewf_chunk_data_allocate_buffer(
+	     *chunk_data,
+	     allocated_data_size,
+	     &( ( *chunk_data )->data ),
+	     &is_pooled,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -159,10 +172,13 @@ int libewf_chunk_data_initialize(
 			goto on_error;
 		}
 	}
-	( *chunk_data )->chunk_size          = chunk_size;
 	( *chunk_data )->allocated_data_size = allocated_data_size;
 	( *chunk_data )->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
 
+	if( is_pooled != 0 )
+	{
+		( *chunk_data )->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA;
+	}
 	return( 1 );
 
 on_error:
@@ -170,8 +186,11 @@ on_error:
 	{
 		if( ( *chunk_data )->data != NULL )
 		{
-			memory_free(
-			 ( *chunk_data )->data );
+			libewf_chunk_data_free_buffer(
+			 *chunk_data,
+			 ( *chunk_data )->data,
+			 is_pooled,
+			 NULL );
 		}
 		memory_free(
 		 *chunk_data );
@@ -189,6 +208,7 @@ int libewf_chunk_data_free(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_chunk_data_free";
+	int result            = 1;
 
 	if( chunk_data == NULL )
 	{
@@ -207,20 +227,221 @@ int libewf_chunk_data_free(
 		{
 			if( ( *chunk_data )->data != NULL )
 			{
-				memory_free(
-				 ( *chunk_data )->data );
+				if( libewf_chunk_data_free_buffer(
+				     *chunk_data,
+				     ( *chunk_data )->data,
+				     ( *chunk_data )->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free data.",
+					 function );
+
+					result = -1;
+				}
 			}
 		}
 		if( ( *chunk_data )->compressed_data != NULL )
 		{
-			memory_free(
-			 ( *chunk_data )->compressed_data );
+			if( libewf_chunk_data_free_buffer(
+			     *chunk_data,
+			     ( *chunk_data )->compressed_data,
+			     ( *chunk_data )->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free compressed data.",
+				 function );
+
+				result = -1;
+			}
 		}
 		memory_free(
 		 *chunk_data );
 
 		*chunk_data = NULL;
 	}
+	return( result );
+}
+
+/* Allocates a buffer for the chunk data
+ * The buffer is retrieved from the buffer pool if available and the buffer size
+ * does not exceed the allocated data size of the chunk, otherwise it is allocated from the heap
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_allocate_buffer(
+     libewf_chunk_data_t *chunk_data,
+     size_t buffer_size,
+     uint8_t **buffer,
+     uint8_t *is_pooled,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_chunk_data_allocate_buffer";
+	size_t allocated_data_size = 0;
+	int result                 = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_pooled == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is pooled.",
+		 function );
+
+		return( -1 );
+	}
+	*is_pooled = 0;
+
+	if( chunk_data->buffer_pool != NULL )
+	{
+		/* All the buffers of the pool have the size of the allocated data of a chunk
+		 * so that the data and compressed data buffers can be swapped and reused
+		 */
+		allocated_data_size = (size_t) chunk_data->chunk_size + 4;
+
+		if( ( allocated_data_size % 16 ) != 0 )
+		{
+			allocated_data_size += 16;
+		}
+		allocated_data_size = ( allocated_data_size / 16 ) * 16;
+
+		if( buffer_size <= allocated_data_size )
+		{
+			result = libewf_buffer_pool_get_buffer(
+			          chunk_data->buffer_pool,
+			          allocated_data_size,
+			          buffer,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve buffer from pool.",
+				 function );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				*is_pooled = 1;
+
+				return( 1 );
+			}
+		}
+	}
+	*buffer = (uint8_t *) memory_allocate(
+	                       sizeof( uint8_t ) * buffer_size );
+
+	if( *buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Frees a buffer of the chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_free_buffer(
+     libewf_chunk_data_t *chunk_data,
+     uint8_t *buffer,
+     uint8_t is_pooled,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_free_buffer";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_pooled == 0 )
+	{
+		memory_free(
+		 buffer );
+	}
+	else if( libewf_buffer_pool_release_buffer(
+	          chunk_data->buffer_pool,
+	          buffer,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release buffer to pool.",
+		 function );
+
+		return( -1 );
+	}
 	return( 1 );
 }
 
@@ -295,8 +516,13 @@ int libewf_chunk_data_clone(
 
 		return( -1 );
 	}
+	/* The destination chunk data is not bound to the buffer pool of the source
+	 * since it can outlive the handle
+	 */
 	( *destination_chunk_data )->data            = NULL;
 	( *destination_chunk_data )->compressed_data = NULL;
+	( *destination_chunk_data )->buffer_pool     = NULL;
+	( *destination_chunk_data )->flags          &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA | LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA );
 
 	if( source_chunk_data->data != NULL )
 	{
@@ -553,11 +779,13 @@ ssize_t libewf_chunk_data_write_buffer(
 
 /* Packs the chunk data
  * This function either adds the checksum or compresses the chunk data
+ * The compression level is used instead of the compression level of the IO handle
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_data_pack(
      libewf_chunk_data_t *chunk_data,
      libewf_io_handle_t *io_handle,
+     int8_t compression_level,
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
      uint8_t pack_flags,
@@ -566,6 +794,9 @@ int libewf_chunk_data_pack(
 	static char *function            = "libewf_chunk_data_pack";
 	size_t safe_compressed_data_size = 0;
 	uint64_t fill_pattern            = 0;
+	uint8_t fill_type                = 0;
+	uint8_t is_pooled                = 0;
+	uint8_t skip_compression         = 0;
 	int result                       = 0;
 
 	if( chunk_data == NULL )
@@ -624,79 +855,96 @@ int libewf_chunk_data_pack(
 	if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
 	 || ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 ) )
 	{
-		if( ( chunk_data->data_size % 8 ) == 0 )
+		/* Determine if the chunk data is an empty block or a 64-bit pattern fill in a single pass
+		 */
+		if( libewf_fill_get_type(
+		     chunk_data->data,
+		     chunk_data->data_size,
+		     &fill_type,
+		     &fill_pattern,
+		     error ) != 1 )
 		{
-			result = libewf_chunk_data_check_for_64_bit_pattern_fill(
-				  chunk_data->data,
-				  chunk_data->data_size,
-				  &fill_pattern,
-				  error );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if chunk data contains a fill pattern.",
+			 function );
 
-			if( result == -1 )
+			goto on_error;
+		}
+		if( fill_type == LIBEWF_FILL_TYPE_64_BIT_PATTERN )
+		{
+			if( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) == 0 )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if chunk data contains a fill pattern.",
-				 function );
-
-				goto on_error;
+				fill_type = LIBEWF_FILL_TYPE_NONE;
 			}
-			else if( result != 0 )
+		}
+		else if( fill_type == LIBEWF_FILL_TYPE_EMPTY_BLOCK )
+		{
+			/* Data that is not a multiple of 8 bytes is only stored as an empty block
+			 * if empty-block compression is enabled
+			 */
+			if( ( ( chunk_data->data_size % 8 ) != 0 )
+			 && ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) == 0 ) )
 			{
-				if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
-				 || ( fill_pattern == 0 ) )
-				{
-					pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
-					pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION;
-
-					if( io_handle->major_version == 2 )
-					{
-						pack_flags |= LIBEWF_PACK_FLAG_USE_PATTERN_FILL_COMPRESSION;
-					}
-					else
-					{
-						pack_flags |= LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
-					}
-				}
+				fill_type = LIBEWF_FILL_TYPE_NONE;
 			}
 		}
-		else if( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
+		if( fill_type != LIBEWF_FILL_TYPE_NONE )
 		{
-			result = libewf_chunk_data_check_for_empty_block(
-				  chunk_data->data,
-				  chunk_data->data_size,
-				  error );
+			pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
+			pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION;
 
-			if( result == -1 )
+			if( ( io_handle->major_version == 2 )
+			 && ( ( chunk_data->data_size % 8 ) == 0 ) )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if chunk data is an empty block.",
-				 function );
-
-				goto on_error;
+				pack_flags |= LIBEWF_PACK_FLAG_USE_PATTERN_FILL_COMPRESSION;
 			}
-			else if( result != 0 )
+			else
 			{
-				if( chunk_data->data[ 0 ] == 0 )
-				{
-					pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
-					pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION;
-					pack_flags |= LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
-				}
+				pack_flags |= LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
 			}
 		}
 	}
+	/* Skip the compression of chunk data that is estimated to be incompressible,
+	 * such as encrypted data, unless compression is forced
+	 */
+	if( ( compression_level != LIBEWF_COMPRESSION_NONE )
+	 && ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 ) )
+	{
+		result = libewf_compression_is_incompressible(
+		          chunk_data->data,
+		          chunk_data->data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if chunk data is incompressible.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			skip_compression = 1;
+		}
+	}
 	/* Make sure range flags are cleared before usage.
 	 */
 	chunk_data->range_flags = 0;
+	chunk_data->pack_status = LIBEWF_PACK_STATUS_UNCOMPRESSED;
 
-	if( ( io_handle->compression_level != LIBEWF_COMPRESSION_NONE )
-	 || ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 ) )
+	if( skip_compression != 0 )
+	{
+		chunk_data->pack_status = LIBEWF_PACK_STATUS_SKIPPED;
+	}
+	else if( ( compression_level != LIBEWF_COMPRESSION_NONE )
+	      || ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 ) )
 	{
 		if( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 )
 		{
@@ -723,10 +971,36 @@ int libewf_chunk_data_pack(
 		{
 			chunk_data->compressed_data_size = 2 * chunk_data->chunk_size;
 		}
-		chunk_data->compressed_data = (uint8_t *) memory_allocate(
-		                                           sizeof( uint8_t ) * chunk_data->compressed_data_size );
+		/* The compressed data of a previous pack can be retained when it was not used
+		 */
+		if( chunk_data->compressed_data != NULL )
+		{
+			if( libewf_chunk_data_free_buffer(
+			     chunk_data,
+			     chunk_data->compressed_data,
+			     chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free compressed data.",
+				 function );
 
-		if( chunk_data->compressed_data == NULL )
+				chunk_data->compressed_data = NULL;
+
+				goto on_error;
+			}
+			chunk_data->compressed_data = NULL;
+			chunk_data->flags          &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA );
+		}
+		if( libewf_chunk_data_allocate_buffer(
+		     chunk_data,
+		     chunk_data->compressed_data_size,
+		     &( chunk_data->compressed_data ),
+		     &is_pooled,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -737,6 +1011,10 @@ int libewf_chunk_data_pack(
 
 			goto on_error;
 		}
+		if( is_pooled != 0 )
+		{
+			chunk_data->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA;
+		}
 		if( ( ( pack_flags & LIBEWF_PACK_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
 		 && ( chunk_data->data_size == (size_t) chunk_data->chunk_size ) )
 		{
@@ -802,18 +1080,18 @@ int libewf_chunk_data_pack(
 		{
 			/* If compression was forced but no compression level provided use the default
 			 */
-			if( io_handle->compression_level == LIBEWF_COMPRESSION_NONE )
+			if( compression_level == LIBEWF_COMPRESSION_NONE )
 			{
-				io_handle->compression_level = LIBEWF_COMPRESSION_DEFAULT;
+				compression_level = LIBEWF_COMPRESSION_DEFAULT;
 			}
 			safe_compressed_data_size = chunk_data->compressed_data_size;
 
-/* TODO add a light weight entropy test */
 			result = libewf_compress_data(
 				  chunk_data->compressed_data,
 				  &safe_compressed_data_size,
 				  io_handle->compression_method,
-				  io_handle->compression_level,
+				  compression_level,
+				  io_handle->deflate_codec,
 				  chunk_data->data,
 				  chunk_data->data_size,
 				  error );
@@ -868,6 +1146,7 @@ int libewf_chunk_data_pack(
 				goto on_error;
 			}
 			chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+			chunk_data->pack_status = LIBEWF_PACK_STATUS_COMPRESSED;
 
 			if( ( pack_flags & LIBEWF_PACK_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
 			{
@@ -930,6 +1209,10 @@ int libewf_chunk_data_pack(
 			}
 			chunk_data->compressed_data_size = safe_compressed_data_size;
 		}
+		else
+		{
+			chunk_data->pack_status = LIBEWF_PACK_STATUS_INCOMPRESSIBLE;
+		}
 	}
 	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
 	 && ( ( pack_flags & LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM ) != 0 ) )
@@ -1006,12 +1289,34 @@ int libewf_chunk_data_pack(
 	{
 		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 		{
-			memory_free(
-			 chunk_data->data );
+			if( libewf_chunk_data_free_buffer(
+			     chunk_data,
+			     chunk_data->data,
+			     chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data.",
+				 function );
+
+				chunk_data->data = NULL;
+
+				goto on_error;
+			}
 		}
-		chunk_data->data  = chunk_data->compressed_data;
-		chunk_data->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+		chunk_data->data = chunk_data->compressed_data;
 
+		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA ) != 0 )
+		{
+			chunk_data->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA | LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA;
+		}
+		else
+		{
+			chunk_data->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+		}
 		chunk_data->compressed_data      = NULL;
 		chunk_data->compressed_data_size = 0;
 	}
@@ -1022,10 +1327,14 @@ int libewf_chunk_data_pack(
 on_error:
 	if( chunk_data->compressed_data != NULL )
 	{
-		memory_free(
-		 chunk_data->compressed_data );
+		libewf_chunk_data_free_buffer(
+		 chunk_data,
+		 chunk_data->compressed_data,
+		 chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA,
+		 NULL );
 
 		chunk_data->compressed_data = NULL;
+		chunk_data->flags          &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA );
 	}
 	chunk_data->compressed_data_size = 0;
 
@@ -1044,6 +1353,7 @@ int libewf_chunk_data_unpack(
 	static char *function        = "libewf_chunk_data_unpack";
 	size_t remaining_chunk_size  = 0;
 	uint32_t calculated_checksum = 0;
+	uint8_t is_pooled            = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -1111,6 +1421,13 @@ int libewf_chunk_data_unpack(
 			}
 			chunk_data->compressed_data      = chunk_data->data;
 			chunk_data->compressed_data_size = chunk_data->data_size;
+			chunk_data->data                 = NULL;
+
+			if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA ) != 0 )
+			{
+				chunk_data->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA;
+			}
+			chunk_data->flags &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA );
 
 			/* Reserve 4 bytes for the checksum
 			 */
@@ -1124,10 +1441,12 @@ int libewf_chunk_data_unpack(
 			}
 			chunk_data->allocated_data_size = ( chunk_data->allocated_data_size / 16 ) * 16;
 
-			chunk_data->data = (uint8_t *) memory_allocate(
-			                                sizeof( uint8_t ) * chunk_data->allocated_data_size );
-
-			if( chunk_data->data == NULL )
+			if( libewf_chunk_data_allocate_buffer(
+			     chunk_data,
+			     chunk_data->allocated_data_size,
+			     &( chunk_data->data ),
+			     &is_pooled,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -1138,6 +1457,10 @@ int libewf_chunk_data_unpack(
 
 				goto on_error;
 			}
+			if( is_pooled != 0 )
+			{
+				chunk_data->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA;
+			}
 			if( memory_set(
 			     chunk_data->data,
 			     0,
@@ -1205,6 +1528,7 @@ int libewf_chunk_data_unpack(
 				     chunk_data->compressed_data,
 				     chunk_data->compressed_data_size,
 				     io_handle->compression_method,
+				     io_handle->deflate_codec,
 				     chunk_data->data,
 				     &( chunk_data->data_size ),
 				     error ) != 1 )
@@ -1328,247 +1652,229 @@ on_error:
 	{
 		if( chunk_data->data != NULL )
 		{
-			memory_free(
-			 chunk_data->data );
+			libewf_chunk_data_free_buffer(
+			 chunk_data,
+			 chunk_data->data,
+			 chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA,
+			 NULL );
 		}
 		chunk_data->data      = chunk_data->compressed_data;
 		chunk_data->data_size = chunk_data->compressed_data_size;
 
+		chunk_data->flags &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA );
+
+		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA ) != 0 )
+		{
+			chunk_data->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA;
+		}
+		chunk_data->flags &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA );
+
 		chunk_data->compressed_data      = NULL;
 		chunk_data->compressed_data_size = 0;
 	}
 	return( -1 );
 }
 
-/* Checks if a buffer containing the chunk data is filled with same value bytes (empty-block)
- * Returns 1 if a pattern was found, 0 if not or -1 on error
+/* Fills a buffer with a 64-bit pattern
+ * The data offset is the offset of the buffer relative to the start of the chunk data
+ * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_data_check_for_empty_block(
-     const uint8_t *data,
-     size_t data_size,
+int libewf_chunk_data_fill_buffer_with_64_bit_pattern(
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t data_offset,
+     uint64_t pattern,
      libcerror_error_t **error )
 {
-	libewf_aligned_t *aligned_data_index = NULL;
-	libewf_aligned_t *aligned_data_start = NULL;
-	uint8_t *data_index                  = NULL;
-	uint8_t *data_start                  = NULL;
-	static char *function                = "libewf_chunk_data_check_for_empty_block";
+	uint8_t pattern_data[ 8 ];
 
-	if( data == NULL )
+	static char *function = "libewf_chunk_data_fill_buffer_with_64_bit_pattern";
+	size_t buffer_offset  = 0;
+	size_t copy_size      = 0;
+
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data.",
+		 "%s: invalid buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_size > (size_t) SSIZE_MAX )
+	if( buffer_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid data size value exceeds maximum.",
+		 "%s: invalid buffer size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_size <= 1 )
+	if( pattern == 0 )
 	{
-		return( 0 );
-	}
-	data_start = (uint8_t *) data;
-	data_index = (uint8_t *) data + 1;
+		if( memory_set(
+		     buffer,
+		     0,
+		     buffer_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear buffer.",
+			 function );
 
-	data_size--;
+			return( -1 );
+		}
+		return( 1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 pattern_data,
+	 pattern );
 
-	/* Only optimize for data larger than the alignment
+	/* Fill the first 8 bytes and double the filled part of the buffer
+	 * until the buffer is filled
 	 */
-	if( data_size > ( sizeof( libewf_aligned_t ) + sizeof( libewf_aligned_t ) ) )
+	while( ( buffer_offset < buffer_size )
+	    && ( buffer_offset < 8 ) )
 	{
-		/* Align the data start
-		 */
-		while( ( (intptr_t) data_start % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_start++;
-			data_index++;
-			data_size--;
-		}
-		/* Align the data index
-		 */
-		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_index++;
-			data_size--;
-		}
-		aligned_data_start = (libewf_aligned_t *) data_start;
-		aligned_data_index = (libewf_aligned_t *) data_index;
-
-		while( data_size > sizeof( libewf_aligned_t ) )
-		{
-			if( *aligned_data_start != *aligned_data_index )
-			{
-				return( 0 );
-			}
-			aligned_data_index++;
+		buffer[ buffer_offset ] = pattern_data[ ( data_offset + buffer_offset ) % 8 ];
 
-			data_size -= sizeof( libewf_aligned_t );
-		}
-		data_index = (uint8_t *) aligned_data_index;
+		buffer_offset++;
 	}
-	while( data_size != 0 )
+	while( buffer_offset < buffer_size )
 	{
-		if( *data_start != *data_index )
+		copy_size = buffer_size - buffer_offset;
+
+		if( copy_size > buffer_offset )
 		{
-			return( 0 );
+			copy_size = buffer_offset;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     buffer,
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy pattern to buffer.",
+			 function );
+
+			return( -1 );
 		}
-		data_index++;
-		data_size--;
+		buffer_offset += copy_size;
 	}
 	return( 1 );
 }
 
-/* Checks if a buffer containing the chunk data is filled with a 64-bit pattern
- * Returns 1 if a pattern was found, 0 if not or -1 on error
+/* Writes a chunk
+ * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_data_check_for_64_bit_pattern_fill(
-     const uint8_t *data,
-     size_t data_size,
-     uint64_t *pattern,
-     libcerror_error_t **error )
+ssize_t libewf_chunk_data_write(
+         libewf_chunk_data_t *chunk_data,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         libcerror_error_t **error )
 {
-	libewf_aligned_t *aligned_data_index = NULL;
-	libewf_aligned_t *aligned_data_start = NULL;
-	uint8_t *data_index                  = NULL;
-	uint8_t *data_start                  = NULL;
-	static char *function                = "libewf_chunk_data_check_for_64_bit_pattern_fill";
+	uint8_t checksum_buffer[ 4 ];
 
-	if( data == NULL )
+	static char *function     = "libewf_chunk_data_write";
+	size_t write_size         = 0;
+	ssize_t total_write_count = 0;
+	ssize_t write_count       = 0;
+
+	if( chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data.",
+		 "%s: invalid chunk data.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_size > (size_t) SSIZE_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid data size value exceeds maximum.",
-		 function );
+	write_size = chunk_data->data_size + chunk_data->padding_size;
 
-		return( -1 );
-	}
-	if( pattern == NULL )
+	/* Write the chunk data to the segment file
+	 */
+	write_count = libbfio_pool_write_buffer(
+	               file_io_pool,
+	               file_io_pool_entry,
+	               chunk_data->data,
+	               write_size,
+	               error );
+
+	if( write_count != (ssize_t) write_size )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid pattern.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk data.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( data_size <= 8 )
-	 || ( data_size % 8 ) != 0 )
-	{
-		return( 0 );
-	}
-	data_start = (uint8_t *) data;
-	data_index = (uint8_t *) data + 8;
-	data_size -= 8;
+	total_write_count += write_count;
 
-	/* Only optimize for data larger than the alignment
-	 */
-	if( data_size > ( sizeof( libewf_aligned_t ) + sizeof( libewf_aligned_t ) ) )
+	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+	 && ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 ) )
 	{
-		/* Align the data start
-		 */
-		while( ( (intptr_t) data_start % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_start++;
-			data_index++;
-			data_size--;
-		}
-		/* Align the data index
+		/* Check if the chunk and checksum buffers are aligned
+		 * if not the checksum needs to be written separately
 		 */
-		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
+		if( ( chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) != 0 )
 		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_index++;
-			data_size--;
-		}
-		aligned_data_start = (libewf_aligned_t *) data_start;
-		aligned_data_index = (libewf_aligned_t *) data_index;
+			byte_stream_copy_from_uint32_little_endian(
+			 checksum_buffer,
+			 chunk_data->checksum );
 
-		while( data_size > sizeof( libewf_aligned_t ) )
-		{
-			if( *aligned_data_start != *aligned_data_index )
+			write_count = libbfio_pool_write_buffer(
+				       file_io_pool,
+				       file_io_pool_entry,
+				       checksum_buffer,
+				       4,
+				       error );
+
+			if( write_count != (ssize_t) 4 )
 			{
-				return( 0 );
-			}
-			aligned_data_start++;
-			aligned_data_index++;
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write chunk checksum.",
+				 function );
 
-			data_size -= sizeof( libewf_aligned_t );
-		}
-		data_start = (uint8_t *) aligned_data_start;
-		data_index = (uint8_t *) aligned_data_index;
-	}
-	while( data_size != 0 )
-	{
-		if( *data_start != *data_index )
-		{
-			return( 0 );
+				return( -1 );
+			}
+			total_write_count += write_count;
 		}
-		data_start++;
-		data_index++;
-		data_size--;
 	}
-	byte_stream_copy_to_uint64_little_endian(
-	 data,
-	 *pattern );
-
-	return( 1 );
+	return( total_write_count );
 }
 
-/* Writes a chunk
- * Returns 1 if successful or -1 on error
+/* Writes a chunk by means of the write-behind buffer
+ * The chunk data and checksum are appended to the write-behind buffer
+ * which writes them to the file IO pool entry when full
+ * Returns the number of bytes written or -1 on error
  */
-ssize_t libewf_chunk_data_write(
+ssize_t libewf_chunk_data_write_to_write_behind_buffer(
          libewf_chunk_data_t *chunk_data,
+         libewf_write_behind_buffer_t *write_behind_buffer,
          libbfio_pool_t *file_io_pool,
          int file_io_pool_entry,
          libcerror_error_t **error )
 {
 	uint8_t checksum_buffer[ 4 ];
 
-	static char *function     = "libewf_chunk_data_write";
+	static char *function     = "libewf_chunk_data_write_to_write_behind_buffer";
 	size_t write_size         = 0;
 	ssize_t total_write_count = 0;
 	ssize_t write_count       = 0;
@@ -1586,9 +1892,8 @@ ssize_t libewf_chunk_data_write(
 	}
 	write_size = chunk_data->data_size + chunk_data->padding_size;
 
-	/* Write the chunk data to the segment file
-	 */
-	write_count = libbfio_pool_write_buffer(
+	write_count = libewf_write_behind_buffer_write_buffer(
+	               write_behind_buffer,
 	               file_io_pool,
 	               file_io_pool_entry,
 	               chunk_data->data,
@@ -1611,16 +1916,14 @@ ssize_t libewf_chunk_data_write(
 	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
 	 && ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 ) )
 	{
-		/* Check if the chunk and checksum buffers are aligned
-		 * if not the checksum needs to be written separately
-		 */
 		if( ( chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) != 0 )
 		{
 			byte_stream_copy_from_uint32_little_endian(
 			 checksum_buffer,
 			 chunk_data->checksum );
 
-			write_count = libbfio_pool_write_buffer(
+			write_count = libewf_write_behind_buffer_write_buffer(
+				       write_behind_buffer,
 				       file_io_pool,
 				       file_io_pool_entry,
 				       checksum_buffer,
@@ -1891,29 +2194,93 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( libbfio_pool_seek_offset(
-	     file_io_pool,
-	     file_io_pool_entry,
-	     chunk_data_offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	read_count = libewf_file_io_pool_read_buffer_at_offset(
+		      file_io_pool,
+		      file_io_pool_entry,
+		      chunk_data->data,
+		      (size_t) chunk_data_size,
+		      chunk_data_offset,
+		      error );
+
+	if( read_count != (ssize_t) chunk_data_size )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset: %" PRIi64 " in file IO pool entry: %d.",
-		 function,
-		 chunk_data_offset,
-		 file_io_pool_entry );
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_data_set_packed_data_size(
+	     chunk_data,
+	     (size_t) read_count,
+	     chunk_data_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set packed chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads chunk data from the file IO pool by means of the coalesced read buffer
+ * The read size is the size of the chunk data and the chunk data that directly follows it,
+ * which is read with a single read when the chunk data is not in the coalesced read buffer
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_chunk_data_read_from_coalesced_read_buffer(
+         libewf_chunk_data_t *chunk_data,
+         libewf_coalesced_read_buffer_t *coalesced_read_buffer,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t chunk_data_offset,
+         size64_t chunk_data_size,
+         uint32_t chunk_data_flags,
+         size64_t read_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_read_from_coalesced_read_buffer";
+	ssize_t read_count    = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data_size == (size64_t) 0 )
+	 || ( chunk_data_size > (size64_t) chunk_data->allocated_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data size value out of bounds.",
+		 function );
 
 		return( -1 );
 	}
-	read_count = libbfio_pool_read_buffer(
+	read_count = libewf_coalesced_read_buffer_read_buffer_at_offset(
+		      coalesced_read_buffer,
 		      file_io_pool,
 		      file_io_pool_entry,
 		      chunk_data->data,
 		      (size_t) chunk_data_size,
+		      chunk_data_offset,
+		      read_size,
 		      error );
 
 	if( read_count != (ssize_t) chunk_data_size )
@@ -1927,12 +2294,64 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
 
 		return( -1 );
 	}
-	chunk_data->data_size = (size_t) read_count;
+	if( libewf_chunk_data_set_packed_data_size(
+	     chunk_data,
+	     (size_t) read_count,
+	     chunk_data_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set packed chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Sets the size of the packed chunk data that was read into the data
+ * The chunk data flags are the range flags of the chunk in the segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_set_packed_data_size(
+     libewf_chunk_data_t *chunk_data,
+     size_t data_size,
+     uint32_t chunk_data_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_set_packed_data_size";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > chunk_data->allocated_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data->data_size = data_size;
 
 	chunk_data->range_flags = ( chunk_data_flags | LIBEWF_RANGE_FLAG_IS_PACKED )
 	                        & ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
 
-	return( read_count );
+	return( 1 );
 }
 
 /* Reads chunk data
@@ -1993,6 +2412,7 @@ int libewf_chunk_data_read_element_data(
 	if( libewf_chunk_data_initialize(
 	     &chunk_data,
 	     io_handle->chunk_size,
+	     io_handle->buffer_pool,
 	     0,
 	     error ) != 1 )
 	{
@@ -25,11 +25,14 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_buffer_pool.h"
+#include "libewf_coalesced_read_buffer.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_write_behind_buffer.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -86,11 +89,21 @@ struct libewf_chunk_data
 	/* The chunk IO flags
 	 */
 	int8_t chunk_io_flags;
+
+	/* The pack status
+	 */
+	uint8_t pack_status;
+
+	/* The buffer pool
+	 * The buffer pool is not managed by the chunk data
+	 */
+	libewf_buffer_pool_t *buffer_pool;
 };
 
 int libewf_chunk_data_initialize(
      libewf_chunk_data_t **chunk_data,
      size32_t chunk_size,
+     libewf_buffer_pool_t *buffer_pool,
      uint8_t clear_data,
      libcerror_error_t **error );
 
@@ -98,6 +111,19 @@ int libewf_chunk_data_free(
      libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error );
 
+int libewf_chunk_data_allocate_buffer(
+     libewf_chunk_data_t *chunk_data,
+     size_t buffer_size,
+     uint8_t **buffer,
+     uint8_t *is_pooled,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_free_buffer(
+     libewf_chunk_data_t *chunk_data,
+     uint8_t *buffer,
+     uint8_t is_pooled,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_clone(
      libewf_chunk_data_t **destination_chunk_data,
      libewf_chunk_data_t *source_chunk_data,
@@ -118,6 +144,7 @@ ssize_t libewf_chunk_data_write_buffer(
 int libewf_chunk_data_pack(
      libewf_chunk_data_t *chunk_data,
      libewf_io_handle_t *io_handle,
+     int8_t compression_level,
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
      uint8_t pack_flags,
@@ -128,15 +155,11 @@ int libewf_chunk_data_unpack(
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error );
 
-int libewf_chunk_data_check_for_empty_block(
-     const uint8_t *data,
-     size_t data_size,
-     libcerror_error_t **error );
-
-int libewf_chunk_data_check_for_64_bit_pattern_fill(
-     const uint8_t *data,
-     size_t data_size,
-     uint64_t *pattern,
+int libewf_chunk_data_fill_buffer_with_64_bit_pattern(
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t data_offset,
+     uint64_t pattern,
      libcerror_error_t **error );
 
 ssize_t libewf_chunk_data_write(
@@ -145,6 +168,13 @@ ssize_t libewf_chunk_data_write(
          int file_io_pool_entry,
          libcerror_error_t **error );
 
+ssize_t libewf_chunk_data_write_to_write_behind_buffer(
+         libewf_chunk_data_t *chunk_data,
+         libewf_write_behind_buffer_t *write_behind_buffer,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         libcerror_error_t **error );
+
 int libewf_chunk_data_get_write_size(
      libewf_chunk_data_t *chunk_data,
      uint32_t *write_size,
@@ -165,6 +195,23 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
          uint32_t chunk_data_flags,
          libcerror_error_t **error );
 
+ssize_t libewf_chunk_data_read_from_coalesced_read_buffer(
+         libewf_chunk_data_t *chunk_data,
+         libewf_coalesced_read_buffer_t *coalesced_read_buffer,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t chunk_data_offset,
+         size64_t chunk_data_size,
+         uint32_t chunk_data_flags,
+         size64_t read_size,
+         libcerror_error_t **error );
+
+int libewf_chunk_data_set_packed_data_size(
+     libewf_chunk_data_t *chunk_data,
+     size_t data_size,
+     uint32_t chunk_data_flags,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
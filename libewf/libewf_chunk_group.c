@@ -26,6 +26,7 @@
 
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
+#include "libewf_coalesced_read_buffer.h"
 #include "libewf_definitions.h"
 #include "libewf_io_handle.h"
 #include "libewf_libcerror.h"
@@ -157,6 +158,19 @@ int libewf_chunk_group_free(
 	}
 	if( *chunk_group != NULL )
 	{
+		if( libewf_chunk_group_free_packed_chunks(
+		     *chunk_group,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free packed chunks.",
+			 function );
+
+			result = -1;
+		}
 		if( libfdata_list_free(
 		     &( ( *chunk_group )->chunks_list ),
 		     error ) != 1 )
@@ -164,108 +178,1622 @@ int libewf_chunk_group_free(
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunkse list.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunkse list.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *chunk_group );
+
+		*chunk_group = NULL;
+	}
+	return( result );
+}
+
+/* Clones the chunk group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_clone(
+     libewf_chunk_group_t **destination_chunk_group,
+     libewf_chunk_group_t *source_chunk_group,
+     libcerror_error_t **error )
+{
+	static char *function   = "libewf_chunk_group_clone";
+	size_t number_of_chunks = 0;
+
+	if( destination_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_chunk_group != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination chunk group already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_chunk_group == NULL )
+	{
+		*destination_chunk_group = NULL;
+
+		return( 1 );
+	}
+	*destination_chunk_group = memory_allocate_structure(
+		                    libewf_chunk_group_t );
+
+	if( *destination_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination chunk group.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     *destination_chunk_group,
+	     source_chunk_group,
+	     sizeof( libewf_chunk_group_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy source to destination chunk group.",
+		 function );
+
+		memory_free(
+		 *destination_chunk_group );
+
+		*destination_chunk_group = NULL;
+
+		return( -1 );
+	}
+	( *destination_chunk_group )->packed_offsets = NULL;
+	( *destination_chunk_group )->packed_sizes   = NULL;
+	( *destination_chunk_group )->packed_flags   = NULL;
+
+	if( source_chunk_group->packed_offsets != NULL )
+	{
+		number_of_chunks = (size_t) source_chunk_group->number_of_allocated_packed_chunks;
+
+		( *destination_chunk_group )->packed_offsets = (uint32_t *) memory_allocate(
+		                                                             sizeof( uint32_t ) * number_of_chunks );
+
+		if( ( *destination_chunk_group )->packed_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create destination packed offsets.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_chunk_group )->packed_offsets,
+		     source_chunk_group->packed_offsets,
+		     sizeof( uint32_t ) * number_of_chunks ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy source to destination packed offsets.",
+			 function );
+
+			goto on_error;
+		}
+		( *destination_chunk_group )->packed_sizes = (uint32_t *) memory_allocate(
+		                                                           sizeof( uint32_t ) * number_of_chunks );
+
+		if( ( *destination_chunk_group )->packed_sizes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create destination packed sizes.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_chunk_group )->packed_sizes,
+		     source_chunk_group->packed_sizes,
+		     sizeof( uint32_t ) * number_of_chunks ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy source to destination packed sizes.",
+			 function );
+
+			goto on_error;
+		}
+		( *destination_chunk_group )->packed_flags = (uint8_t *) memory_allocate(
+		                                                          sizeof( uint8_t ) * ( ( number_of_chunks + 1 ) / 2 ) );
+
+		if( ( *destination_chunk_group )->packed_flags == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create destination packed flags.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_chunk_group )->packed_flags,
+		     source_chunk_group->packed_flags,
+		     sizeof( uint8_t ) * ( ( number_of_chunks + 1 ) / 2 ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy source to destination packed flags.",
+			 function );
+
+			goto on_error;
+		}
+	}
+/* TODO clone chunks_list */
+	return( 1 );
+
+on_error:
+	if( *destination_chunk_group != NULL )
+	{
+		libewf_chunk_group_free_packed_chunks(
+		 *destination_chunk_group,
+		 NULL );
+
+		memory_free(
+		 *destination_chunk_group );
+
+		*destination_chunk_group = NULL;
+	}
+	return( -1 );
+}
+
+/* Empties a chunk group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_empty(
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error )
+{
+        static char *function = "libewf_chunk_group_empty";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_empty(
+	     chunk_group->chunks_list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to empty chunks list.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_group_free_packed_chunks(
+	     chunk_group,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free packed chunks.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Initializes the packed chunks of a chunk group
+ * The packed chunks are used instead of the chunks list to reduce the memory
+ * needed to store the chunks of a table section
+ * Returns 1 if successful, 0 if the chunk group already contains chunks or -1 on error
+ */
+int libewf_chunk_group_initialize_packed_chunks(
+     libewf_chunk_group_t *chunk_group,
+     uint32_t number_of_chunks,
+     size32_t chunk_size,
+     int file_io_pool_entry,
+     off64_t base_offset,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_chunk_group_initialize_packed_chunks";
+	size_t flags_size      = 0;
+	int number_of_elements = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunks == 0 )
+	 || ( (size_t) number_of_chunks > (size_t) ( SSIZE_MAX / sizeof( uint32_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid chunk size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( base_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid base offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->packed_offsets != NULL )
+	{
+		return( 0 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     chunk_group->chunks_list,
+	     &number_of_elements,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from chunks list.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_elements != 0 )
+	{
+		return( 0 );
+	}
+	if( libfcache_date_time_get_timestamp(
+	     &( chunk_group->timestamp ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_group->packed_offsets = (uint32_t *) memory_allocate(
+	                                            sizeof( uint32_t ) * number_of_chunks );
+
+	if( chunk_group->packed_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create packed offsets.",
+		 function );
+
+		goto on_error;
+	}
+	chunk_group->packed_sizes = (uint32_t *) memory_allocate(
+	                                          sizeof( uint32_t ) * number_of_chunks );
+
+	if( chunk_group->packed_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create packed sizes.",
+		 function );
+
+		goto on_error;
+	}
+	flags_size = ( (size_t) number_of_chunks + 1 ) / 2;
+
+	chunk_group->packed_flags = (uint8_t *) memory_allocate(
+	                                         sizeof( uint8_t ) * flags_size );
+
+	if( chunk_group->packed_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create packed flags.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     chunk_group->packed_flags,
+	     0,
+	     sizeof( uint8_t ) * flags_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear packed flags.",
+		 function );
+
+		goto on_error;
+	}
+	chunk_group->number_of_packed_chunks           = 0;
+	chunk_group->number_of_allocated_packed_chunks = number_of_chunks;
+	chunk_group->file_io_pool_entry                = file_io_pool_entry;
+	chunk_group->base_offset                       = base_offset;
+	chunk_group->chunk_size                        = chunk_size;
+	chunk_group->packed_range_flags                = range_flags;
+
+	return( 1 );
+
+on_error:
+	if( chunk_group->packed_flags != NULL )
+	{
+		memory_free(
+		 chunk_group->packed_flags );
+
+		chunk_group->packed_flags = NULL;
+	}
+	if( chunk_group->packed_sizes != NULL )
+	{
+		memory_free(
+		 chunk_group->packed_sizes );
+
+		chunk_group->packed_sizes = NULL;
+	}
+	if( chunk_group->packed_offsets != NULL )
+	{
+		memory_free(
+		 chunk_group->packed_offsets );
+
+		chunk_group->packed_offsets = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees the packed chunks of a chunk group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_free_packed_chunks(
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_free_packed_chunks";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->packed_flags != NULL )
+	{
+		memory_free(
+		 chunk_group->packed_flags );
+
+		chunk_group->packed_flags = NULL;
+	}
+	if( chunk_group->packed_sizes != NULL )
+	{
+		memory_free(
+		 chunk_group->packed_sizes );
+
+		chunk_group->packed_sizes = NULL;
+	}
+	if( chunk_group->packed_offsets != NULL )
+	{
+		memory_free(
+		 chunk_group->packed_offsets );
+
+		chunk_group->packed_offsets = NULL;
+	}
+	chunk_group->number_of_packed_chunks           = 0;
+	chunk_group->number_of_allocated_packed_chunks = 0;
+	chunk_group->table_entries_offset              = 0;
+
+	return( 1 );
+}
+
+/* Retrieves a specific packed chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_get_packed_chunk(
+     libewf_chunk_group_t *chunk_group,
+     uint32_t packed_chunk_index,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_get_packed_chunk";
+	uint8_t packed_flags  = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->packed_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk group - missing packed chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( packed_chunk_index >= chunk_group->number_of_packed_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid packed chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	packed_flags = chunk_group->packed_flags[ packed_chunk_index / 2 ];
+
+	if( ( packed_chunk_index % 2 ) != 0 )
+	{
+		packed_flags >>= 4;
+	}
+	/* The offset and size of a pattern fill chunk contain the pattern
+	 * the chunk data is stored in the table entry
+	 */
+	if( ( ( packed_flags & LIBEWF_PACKED_CHUNK_FLAG_USES_PATTERN_FILL ) != 0 )
+	 && ( chunk_group->table_entries_offset != 0 ) )
+	{
+		*chunk_data_offset = chunk_group->table_entries_offset + ( (off64_t) packed_chunk_index * sizeof( ewf_table_entry_v2_t ) );
+		*chunk_data_size   = 8;
+	}
+	else
+	{
+		*chunk_data_offset = chunk_group->base_offset + chunk_group->packed_offsets[ packed_chunk_index ];
+		*chunk_data_size   = (size64_t) chunk_group->packed_sizes[ packed_chunk_index ];
+	}
+	*range_flags = chunk_group->packed_range_flags;
+
+	if( ( packed_flags & LIBEWF_PACKED_CHUNK_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		*range_flags |= LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+	}
+	if( ( packed_flags & LIBEWF_PACKED_CHUNK_FLAG_HAS_CHECKSUM ) != 0 )
+	{
+		*range_flags |= LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+	}
+	if( ( packed_flags & LIBEWF_PACKED_CHUNK_FLAG_USES_PATTERN_FILL ) != 0 )
+	{
+		*range_flags |= LIBEWF_RANGE_FLAG_USES_PATTERN_FILL;
+	}
+	if( ( packed_flags & LIBEWF_PACKED_CHUNK_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		*range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+	}
+	return( 1 );
+}
+
+/* Moves the packed chunks of a chunk group into the chunks list
+ * This is used when a chunk cannot be stored as a packed chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_expand_packed_chunks(
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_chunk_group_expand_packed_chunks";
+	off64_t chunk_data_offset   = 0;
+	size64_t chunk_data_size    = 0;
+	uint32_t packed_chunk_index = 0;
+	uint32_t range_flags        = 0;
+	int element_index           = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->packed_offsets == NULL )
+	{
+		return( 1 );
+	}
+	for( packed_chunk_index = 0;
+	     packed_chunk_index < chunk_group->number_of_packed_chunks;
+	     packed_chunk_index++ )
+	{
+		if( libewf_chunk_group_get_packed_chunk(
+		     chunk_group,
+		     packed_chunk_index,
+		     &chunk_data_offset,
+		     &chunk_data_size,
+		     &range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve packed chunk: %" PRIu32 ".",
+			 function,
+			 packed_chunk_index );
+
+			return( -1 );
+		}
+		if( libfdata_list_append_element_with_mapped_size(
+		     chunk_group->chunks_list,
+		     &element_index,
+		     chunk_group->file_io_pool_entry,
+		     chunk_data_offset,
+		     chunk_data_size,
+		     range_flags,
+		     chunk_group->chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
+			 function,
+			 packed_chunk_index );
+
+			return( -1 );
+		}
+	}
+	if( libewf_chunk_group_free_packed_chunks(
+	     chunk_group,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free packed chunks.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends a packed chunk
+ * The values contain the chunk data offset relative to the base offset and the chunk data size
+ * or the pattern of a pattern fill chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_append_packed_chunk(
+     libewf_chunk_group_t *chunk_group,
+     uint32_t first_value,
+     uint32_t second_value,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_chunk_group_append_packed_chunk";
+	uint32_t packed_chunk_index = 0;
+	uint8_t packed_flags        = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->packed_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk group - missing packed chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->number_of_packed_chunks >= chunk_group->number_of_allocated_packed_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk group - number of packed chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		packed_flags |= LIBEWF_PACKED_CHUNK_FLAG_IS_COMPRESSED;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+	{
+		packed_flags |= LIBEWF_PACKED_CHUNK_FLAG_HAS_CHECKSUM;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+	{
+		packed_flags |= LIBEWF_PACKED_CHUNK_FLAG_USES_PATTERN_FILL;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		packed_flags |= LIBEWF_PACKED_CHUNK_FLAG_IS_CORRUPTED;
+	}
+	packed_chunk_index = chunk_group->number_of_packed_chunks;
+
+	if( ( packed_chunk_index % 2 ) != 0 )
+	{
+		packed_flags <<= 4;
+	}
+	chunk_group->packed_offsets[ packed_chunk_index ]    = first_value;
+	chunk_group->packed_sizes[ packed_chunk_index ]      = second_value;
+	chunk_group->packed_flags[ packed_chunk_index / 2 ] |= packed_flags;
+
+	chunk_group->number_of_packed_chunks += 1;
+
+	return( 1 );
+}
+
+/* Appends a chunk to the chunk group
+ * The chunk is stored as a packed chunk if possible otherwise in the chunks list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_append_chunk(
+     libewf_chunk_group_t *chunk_group,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     size32_t chunk_size,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_chunk_group_append_chunk";
+	uint32_t packed_range_flags = 0;
+	int element_index           = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->packed_offsets != NULL )
+	{
+		packed_range_flags = range_flags & ~( LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_HAS_CHECKSUM | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+
+		if( ( file_io_pool_entry == chunk_group->file_io_pool_entry )
+		 && ( chunk_size == chunk_group->chunk_size )
+		 && ( packed_range_flags == chunk_group->packed_range_flags )
+		 && ( ( ( range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) == 0 )
+		  ||  ( chunk_group->table_entries_offset == 0 ) )
+		 && ( chunk_group->number_of_packed_chunks < chunk_group->number_of_allocated_packed_chunks )
+		 && ( chunk_data_offset >= chunk_group->base_offset )
+		 && ( (size64_t) ( chunk_data_offset - chunk_group->base_offset ) <= (size64_t) UINT32_MAX )
+		 && ( chunk_data_size <= (size64_t) UINT32_MAX ) )
+		{
+			if( libewf_chunk_group_append_packed_chunk(
+			     chunk_group,
+			     (uint32_t) ( chunk_data_offset - chunk_group->base_offset ),
+			     (uint32_t) chunk_data_size,
+			     range_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append packed chunk.",
+				 function );
+
+				return( -1 );
+			}
+			return( 1 );
+		}
+		if( libewf_chunk_group_expand_packed_chunks(
+		     chunk_group,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to expand packed chunks.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libfdata_list_append_element_with_mapped_size(
+	     chunk_group->chunks_list,
+	     &element_index,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     chunk_data_size,
+	     range_flags,
+	     chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append element with mapped size to chunks list.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends a pattern fill chunk to the chunk group
+ * The pattern is stored as a packed chunk if possible otherwise the chunk is stored
+ * in the chunks list and refers to the pattern in the table entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_append_pattern_fill_chunk(
+     libewf_chunk_group_t *chunk_group,
+     int file_io_pool_entry,
+     off64_t table_entry_offset,
+     uint64_t pattern,
+     uint32_t range_flags,
+     size32_t chunk_size,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_chunk_group_append_pattern_fill_chunk";
+	uint32_t packed_range_flags = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_group->packed_offsets != NULL )
+	 && ( chunk_group->table_entries_offset != 0 ) )
+	{
+		packed_range_flags = range_flags & ~( LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_HAS_CHECKSUM | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+
+		if( ( file_io_pool_entry == chunk_group->file_io_pool_entry )
+		 && ( chunk_size == chunk_group->chunk_size )
+		 && ( packed_range_flags == chunk_group->packed_range_flags )
+		 && ( ( range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+		 && ( chunk_group->number_of_packed_chunks < chunk_group->number_of_allocated_packed_chunks )
+		 && ( table_entry_offset == ( chunk_group->table_entries_offset + ( (off64_t) chunk_group->number_of_packed_chunks * sizeof( ewf_table_entry_v2_t ) ) ) ) )
+		{
+			if( libewf_chunk_group_append_packed_chunk(
+			     chunk_group,
+			     (uint32_t) ( pattern & 0xffffffffUL ),
+			     (uint32_t) ( pattern >> 32 ),
+			     range_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append packed chunk.",
+				 function );
+
+				return( -1 );
+			}
+			return( 1 );
+		}
+	}
+	if( libewf_chunk_group_append_chunk(
+	     chunk_group,
+	     file_io_pool_entry,
+	     table_entry_offset,
+	     8,
+	     range_flags,
+	     chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append chunk.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the chunk at a specific offset relative to the start of the chunk group
+ * The chunk offset is the offset relative to the start of the chunk
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libewf_chunk_group_get_chunk_at_offset(
+     libewf_chunk_group_t *chunk_group,
+     off64_t chunk_group_data_offset,
+     int *chunk_index,
+     off64_t *chunk_offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_chunk_group_get_chunk_at_offset";
+	uint64_t packed_chunk_index = 0;
+	int result                  = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->packed_offsets == NULL )
+	{
+		result = libfdata_list_get_element_at_offset(
+		          chunk_group->chunks_list,
+		          chunk_group_data_offset,
+		          chunk_index,
+		          chunk_offset,
+		          file_io_pool_entry,
+		          chunk_data_offset,
+		          chunk_data_size,
+		          range_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element at offset: 0x%08" PRIx64 " from chunks list.",
+			 function,
+			 chunk_group_data_offset );
+
+			return( -1 );
+		}
+		return( result );
+	}
+	if( chunk_group_data_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid chunk group data offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	/* The packed chunks all have the same mapped size
+	 * so the chunk can be determined without a search
+	 */
+	packed_chunk_index = (uint64_t) chunk_group_data_offset / chunk_group->chunk_size;
+
+	if( packed_chunk_index >= (uint64_t) chunk_group->number_of_packed_chunks )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_group_get_packed_chunk(
+	     chunk_group,
+	     (uint32_t) packed_chunk_index,
+	     chunk_data_offset,
+	     chunk_data_size,
+	     range_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve packed chunk: %" PRIu64 ".",
+		 function,
+		 packed_chunk_index );
+
+		return( -1 );
+	}
+	*chunk_index        = (int) packed_chunk_index;
+	*chunk_offset       = chunk_group_data_offset - (off64_t) ( packed_chunk_index * chunk_group->chunk_size );
+	*file_io_pool_entry = chunk_group->file_io_pool_entry;
+
+	return( 1 );
+}
+
+/* Retrieves the fill pattern of the chunk at a specific offset relative to the start of the chunk group
+ * This is used to fill the data of sparse and pattern fill chunks without reading the chunk data
+ * Returns 1 if successful, 0 if the chunk has no known fill pattern or -1 on error
+ */
+int libewf_chunk_group_get_chunk_fill_pattern_at_offset(
+     libewf_chunk_group_t *chunk_group,
+     off64_t chunk_group_data_offset,
+     uint64_t *pattern,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_chunk_group_get_chunk_fill_pattern_at_offset";
+	off64_t chunk_data_offset = 0;
+	off64_t chunk_offset      = 0;
+	size64_t chunk_data_size  = 0;
+	uint32_t range_flags      = 0;
+	int chunk_index           = 0;
+	int file_io_pool_entry    = 0;
+	int result                = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pattern.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_group_get_chunk_at_offset(
+	          chunk_group,
+	          chunk_group_data_offset,
+	          &chunk_index,
+	          &chunk_offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk at offset: 0x%08" PRIx64 ".",
+		 function,
+		 chunk_group_data_offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		return( 0 );
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		*pattern = 0;
+
+		return( 1 );
+	}
+	if( ( chunk_group->packed_offsets == NULL )
+	 || ( chunk_group->table_entries_offset == 0 )
+	 || ( ( range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) == 0 ) )
+	{
+		return( 0 );
+	}
+	*pattern = ( (uint64_t) chunk_group->packed_sizes[ chunk_index ] << 32 )
+	         | chunk_group->packed_offsets[ chunk_index ];
+
+	return( 1 );
+}
+
+/* Retrieves the contiguous chunk data size of the chunk at a specific offset relative to the start of the chunk group
+ * The contiguous chunk data size is the size of the chunk data of the chunk and of the chunks
+ * that follow it and that are stored directly after it in the same segment file,
+ * up to the maximum data size. This is used to read a run of chunks with a single read
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_chunk_group_get_contiguous_chunk_data_size(
+     libewf_chunk_group_t *chunk_group,
+     off64_t chunk_group_data_offset,
+     size64_t maximum_data_size,
+     size64_t *contiguous_data_size,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_chunk_group_get_contiguous_chunk_data_size";
+	off64_t chunk_data_offset   = 0;
+	off64_t next_chunk_offset   = 0;
+	size64_t chunk_data_size    = 0;
+	size64_t safe_data_size     = 0;
+	uint64_t packed_chunk_index = 0;
+	uint32_t range_flags        = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group_data_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid chunk group data offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( contiguous_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid contiguous data size.",
+		 function );
+
+		return( -1 );
+	}
+	/* The chunks in the chunks list are not necessarily stored back to back
+	 */
+	if( ( chunk_group->packed_offsets == NULL )
+	 || ( ( chunk_group->packed_range_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 ) )
+	{
+		return( 0 );
+	}
+	packed_chunk_index = (uint64_t) chunk_group_data_offset / chunk_group->chunk_size;
+
+	while( packed_chunk_index < (uint64_t) chunk_group->number_of_packed_chunks )
+	{
+		if( libewf_chunk_group_get_packed_chunk(
+		     chunk_group,
+		     (uint32_t) packed_chunk_index,
+		     &chunk_data_offset,
+		     &chunk_data_size,
+		     &range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve packed chunk: %" PRIu64 ".",
+			 function,
+			 packed_chunk_index );
+
+			return( -1 );
+		}
+		if( ( range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+		{
+			break;
+		}
+		if( ( safe_data_size > 0 )
+		 && ( chunk_data_offset != next_chunk_offset ) )
+		{
+			break;
+		}
+		if( chunk_data_size > ( maximum_data_size - safe_data_size ) )
+		{
+			break;
+		}
+		safe_data_size   += chunk_data_size;
+		next_chunk_offset = chunk_data_offset + (off64_t) chunk_data_size;
+
+		packed_chunk_index++;
+	}
+	if( safe_data_size == 0 )
+	{
+		return( 0 );
+	}
+	*contiguous_data_size = safe_data_size;
+
+	return( 1 );
+}
+
+/* Retrieves the chunk data of the chunk at a specific offset relative to the start of the chunk group
+ * The chunk offset is the offset relative to the start of the chunk
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libewf_chunk_group_get_chunk_data_at_offset(
+     libewf_chunk_group_t *chunk_group,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *chunks_cache,
+     libewf_buffer_pool_t *buffer_pool,
+     libewf_coalesced_read_buffer_t *coalesced_read_buffer,
+     off64_t chunk_group_data_offset,
+     int *chunk_index,
+     off64_t *chunk_offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *safe_chunk_data = NULL;
+	libfcache_cache_value_t *cache_value = NULL;
+	static char *function                = "libewf_chunk_group_get_chunk_data_at_offset";
+	off64_t cache_value_offset           = 0;
+	off64_t chunk_data_offset            = 0;
+	size64_t chunk_data_size             = 0;
+	size64_t contiguous_data_size        = 0;
+	ssize_t read_count                   = 0;
+	int64_t cache_value_timestamp        = 0;
+	uint32_t range_flags                 = 0;
+	int cache_entry_index                = 0;
+	int cache_value_file_index           = -1;
+	int file_io_pool_entry               = 0;
+	int number_of_cache_entries          = 0;
+	int result                           = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group->packed_offsets == NULL )
+	{
+		result = libfdata_list_get_element_value_at_offset(
+		          chunk_group->chunks_list,
+		          (intptr_t *) file_io_pool,
+		          chunks_cache,
+		          chunk_group_data_offset,
+		          chunk_index,
+		          chunk_offset,
+		          (intptr_t **) chunk_data,
+		          0,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element value at offset: 0x%08" PRIx64 " from chunks list.",
+			 function,
+			 chunk_group_data_offset );
 
-			result = -1;
+			return( -1 );
 		}
-		memory_free(
-		 *chunk_group );
-
-		*chunk_group = NULL;
+		return( result );
 	}
-	return( result );
-}
+	result = libewf_chunk_group_get_chunk_at_offset(
+	          chunk_group,
+	          chunk_group_data_offset,
+	          chunk_index,
+	          chunk_offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          error );
 
-/* Clones the chunk group
- * Returns 1 if successful or -1 on error
- */
-int libewf_chunk_group_clone(
-     libewf_chunk_group_t **destination_chunk_group,
-     libewf_chunk_group_t *source_chunk_group,
-     libcerror_error_t **error )
-{
-	static char *function = "libewf_chunk_group_clone";
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk at offset: 0x%08" PRIx64 ".",
+		 function,
+		 chunk_group_data_offset );
 
-	if( destination_chunk_group == NULL )
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     chunks_cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid destination chunk group.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( *destination_chunk_group != NULL )
+	if( number_of_cache_entries <= 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid destination chunk group already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cache entries value out of bounds.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( source_chunk_group == NULL )
+	cache_entry_index = *chunk_index % number_of_cache_entries;
+
+	if( libfcache_cache_get_value_by_index(
+	     chunks_cache,
+	     cache_entry_index,
+	     &cache_value,
+	     error ) != 1 )
 	{
-		*destination_chunk_group = NULL;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache entry: %d value.",
+		 function,
+		 cache_entry_index );
 
-		return( 1 );
+		goto on_error;
 	}
-	*destination_chunk_group = memory_allocate_structure(
-		                    libewf_chunk_group_t );
+	if( cache_value != NULL )
+	{
+		if( libfcache_cache_value_get_identifier(
+		     cache_value,
+		     &cache_value_file_index,
+		     &cache_value_offset,
+		     &cache_value_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache value identifier.",
+			 function );
 
-	if( *destination_chunk_group == NULL )
+			goto on_error;
+		}
+		if( ( cache_value_file_index == file_io_pool_entry )
+		 && ( cache_value_offset == chunk_data_offset )
+		 && ( cache_value_timestamp == chunk_group->timestamp ) )
+		{
+			if( libfcache_cache_value_get_value(
+			     cache_value,
+			     (intptr_t **) chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve cache value.",
+				 function );
+
+				goto on_error;
+			}
+			if( *chunk_data != NULL )
+			{
+				return( 1 );
+			}
+		}
+	}
+	if( libewf_chunk_data_initialize(
+	     &safe_chunk_data,
+	     chunk_group->chunk_size,
+	     buffer_pool,
+	     0,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create destination chunk group.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data.",
 		 function );
 
 		goto on_error;
 	}
-	if( memory_copy(
-	     *destination_chunk_group,
-	     source_chunk_group,
-	     sizeof( libewf_chunk_group_t ) ) == NULL )
+	/* Chunks that are stored back to back are read with a single read
+	 * into the coalesced read buffer, if available
+	 */
+	result = 0;
+
+	if( coalesced_read_buffer != NULL )
+	{
+		result = libewf_chunk_group_get_contiguous_chunk_data_size(
+		          chunk_group,
+		          chunk_group_data_offset,
+		          (size64_t) coalesced_read_buffer->maximum_data_size,
+		          &contiguous_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve contiguous chunk data size at offset: 0x%08" PRIx64 ".",
+			 function,
+			 chunk_group_data_offset );
+
+			goto on_error;
+		}
+	}
+	if( result != 0 )
+	{
+		read_count = libewf_chunk_data_read_from_coalesced_read_buffer(
+			      safe_chunk_data,
+			      coalesced_read_buffer,
+			      file_io_pool,
+			      file_io_pool_entry,
+			      chunk_data_offset,
+			      chunk_data_size,
+			      range_flags,
+			      contiguous_data_size,
+			      error );
+	}
+	else
+	{
+		read_count = libewf_chunk_data_read_from_file_io_pool(
+			      safe_chunk_data,
+			      file_io_pool,
+			      file_io_pool_entry,
+			      chunk_data_offset,
+			      chunk_data_size,
+			      range_flags,
+			      error );
+	}
+	if( read_count < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy source to destination chunk group.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk data.",
 		 function );
 
 		goto on_error;
 	}
-/* TODO clone chunks_list */
+	if( libfcache_cache_set_value_by_index(
+	     chunks_cache,
+	     cache_entry_index,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     chunk_group->timestamp,
+	     (intptr_t *) safe_chunk_data,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+	     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk data in cache entry: %d.",
+		 function,
+		 cache_entry_index );
+
+		goto on_error;
+	}
+	/* chunks_cache takes over management of chunk_data
+	 */
+	*chunk_data = safe_chunk_data;
+
 	return( 1 );
 
 on_error:
-	if( *destination_chunk_group != NULL )
+	if( safe_chunk_data != NULL )
 	{
-		memory_free(
-		 *destination_chunk_group );
-
-		*destination_chunk_group = NULL;
+		libewf_chunk_data_free(
+		 &safe_chunk_data,
+		 NULL );
 	}
+	*chunk_data = NULL;
+
 	return( -1 );
 }
 
-/* Empties a chunk group
+/* Sets the chunk data of the chunk at a specific offset relative to the start of the chunk group
+ * The chunks cache takes over management of the chunk data
  * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_group_empty(
+int libewf_chunk_group_set_chunk_data_at_offset(
      libewf_chunk_group_t *chunk_group,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *chunks_cache,
+     off64_t chunk_group_data_offset,
+     libewf_chunk_data_t *chunk_data,
      libcerror_error_t **error )
 {
-        static char *function = "libewf_chunk_group_empty";
+	static char *function       = "libewf_chunk_group_set_chunk_data_at_offset";
+	off64_t chunk_data_offset   = 0;
+	off64_t chunk_offset        = 0;
+	size64_t chunk_data_size    = 0;
+	uint32_t range_flags        = 0;
+	int chunk_index             = 0;
+	int file_io_pool_entry      = 0;
+	int number_of_cache_entries = 0;
+	int result                  = 0;
 
 	if( chunk_group == NULL )
 	{
@@ -278,19 +1806,99 @@ int libewf_chunk_group_empty(
 
 		return( -1 );
 	}
-	if( libfdata_list_empty(
-	     chunk_group->chunks_list,
+	if( chunk_group->packed_offsets == NULL )
+	{
+		if( libfdata_list_set_element_value_at_offset(
+		     chunk_group->chunks_list,
+		     (intptr_t *) file_io_pool,
+		     chunks_cache,
+		     chunk_group_data_offset,
+		     (intptr_t *) chunk_data,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+		     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set element value at offset: 0x%08" PRIx64 " in chunks list.",
+			 function,
+			 chunk_group_data_offset );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	result = libewf_chunk_group_get_chunk_at_offset(
+	          chunk_group,
+	          chunk_group_data_offset,
+	          &chunk_index,
+	          &chunk_offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk at offset: 0x%08" PRIx64 ".",
+		 function,
+		 chunk_group_data_offset );
+
+		return( -1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     chunks_cache,
+	     &number_of_cache_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to empty chunks list.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of cache entries value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
+	if( libfcache_cache_set_value_by_index(
+	     chunks_cache,
+	     chunk_index % number_of_cache_entries,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     chunk_group->timestamp,
+	     (intptr_t *) chunk_data,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+	     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk data in cache entry: %d.",
+		 function,
+		 chunk_index % number_of_cache_entries );
+
+		return( -1 );
+	}
 	return( 1 );
 }
 
@@ -323,7 +1931,7 @@ int libewf_chunk_group_fill_v1(
 	uint8_t corrupted              = 0;
 	uint8_t is_compressed          = 0;
 	uint8_t overflow               = 0;
-	int element_index              = 0;
+	int result                     = 0;
 
 	if( chunk_group == NULL )
 	{
@@ -380,6 +1988,32 @@ int libewf_chunk_group_fill_v1(
 
 		return( -1 );
 	}
+	if( tainted != 0 )
+	{
+		range_flags = LIBEWF_RANGE_FLAG_IS_TAINTED;
+	}
+	/* The chunk data offsets are stored relative to the base offset
+	 */
+	result = libewf_chunk_group_initialize_packed_chunks(
+	          chunk_group,
+	          number_of_entries,
+	          chunk_size,
+	          file_io_pool_entry,
+	          base_offset,
+	          range_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize packed chunks.",
+		 function );
+
+		return( -1 );
+	}
 	byte_stream_copy_to_uint32_little_endian(
 	 ( ( (ewf_table_entry_v1_t *) table_entries_data )[ table_entry_index ] ).chunk_data_offset,
 	 stored_offset );
@@ -540,9 +2174,8 @@ int libewf_chunk_group_fill_v1(
 			 "\n" );
 		}
 #endif
-		if( libfdata_list_append_element_with_mapped_size(
-		     chunk_group->chunks_list,
-		     &element_index,
+		if( libewf_chunk_group_append_chunk(
+		     chunk_group,
 		     file_io_pool_entry,
 		     base_offset + current_offset,
 		     (size64_t) chunk_data_size,
@@ -554,7 +2187,7 @@ int libewf_chunk_group_fill_v1(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
+			 "%s: unable to append chunk: %" PRIu32 " to chunk group.",
 			 function,
 			 table_entry_index );
 
@@ -755,9 +2388,8 @@ int libewf_chunk_group_fill_v1(
 		 "\n" );
 	}
 #endif
-	if( libfdata_list_append_element_with_mapped_size(
-	     chunk_group->chunks_list,
-	     &element_index,
+	if( libewf_chunk_group_append_chunk(
+	     chunk_group,
 	     file_io_pool_entry,
 	     last_chunk_data_offset,
 	     (size64_t) last_chunk_data_size,
@@ -769,7 +2401,7 @@ int libewf_chunk_group_fill_v1(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
+		 "%s: unable to append chunk: %" PRIu32 " to chunk group.",
 		 function,
 		 table_entry_index );
 
@@ -800,14 +2432,16 @@ int libewf_chunk_group_fill_v2(
      uint8_t tainted,
      libcerror_error_t **error )
 {
-	static char *function      = "libewf_chunk_group_fill_v2";
-	off64_t table_entry_offset = 0;
-	uint64_t chunk_data_offset = 0;
-	uint32_t chunk_data_flags  = 0;
-	uint32_t chunk_data_size   = 0;
-	uint32_t range_flags       = 0;
-	uint32_t table_entry_index = 0;
-	int element_index          = 0;
+	static char *function          = "libewf_chunk_group_fill_v2";
+	off64_t base_offset            = 0;
+	off64_t table_entry_offset     = 0;
+	size_t table_entry_data_offset = 0;
+	uint64_t chunk_data_offset     = 0;
+	uint32_t chunk_data_flags      = 0;
+	uint32_t chunk_data_size       = 0;
+	uint32_t range_flags           = 0;
+	uint32_t table_entry_index     = 0;
+	int result                     = 0;
 
 	if( chunk_group == NULL )
 	{
@@ -855,6 +2489,61 @@ int libewf_chunk_group_fill_v2(
 	}
 	table_entry_offset = table_section->start_offset + sizeof( ewf_table_header_v2_t );
 
+	/* The chunk data offsets are stored relative to the smallest chunk data offset
+	 * pattern fill chunks refer to the table entry which are stored after the table entry offset
+	 */
+	base_offset = table_entry_offset;
+
+	for( table_entry_data_offset = 0;
+	     ( table_entry_data_offset + sizeof( ewf_table_entry_v2_t ) ) <= table_entries_data_size;
+	     table_entry_data_offset += sizeof( ewf_table_entry_v2_t ) )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_table_entry_v2_t *) &( table_entries_data[ table_entry_data_offset ] ) )->chunk_data_offset,
+		 chunk_data_offset );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_table_entry_v2_t *) &( table_entries_data[ table_entry_data_offset ] ) )->chunk_data_flags,
+		 chunk_data_flags );
+
+		if( ( ( chunk_data_flags & LIBEWF_CHUNK_DATA_FLAG_IS_COMPRESSED ) != 0 )
+		 && ( ( chunk_data_flags & LIBEWF_CHUNK_DATA_FLAG_USES_PATTERN_FILL ) != 0 ) )
+		{
+			continue;
+		}
+		if( chunk_data_offset < (uint64_t) base_offset )
+		{
+			base_offset = (off64_t) chunk_data_offset;
+		}
+	}
+	if( tainted != 0 )
+	{
+		range_flags = LIBEWF_RANGE_FLAG_IS_TAINTED;
+	}
+	result = libewf_chunk_group_initialize_packed_chunks(
+	          chunk_group,
+	          number_of_offsets,
+	          chunk_size,
+	          file_io_pool_entry,
+	          base_offset,
+	          range_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize packed chunks.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		chunk_group->table_entries_offset = table_entry_offset;
+	}
 	while( table_entries_data_size >= sizeof( ewf_table_entry_v2_t ) )
 	{
 		byte_stream_copy_to_uint64_little_endian(
@@ -952,26 +2641,37 @@ int libewf_chunk_group_fill_v2(
 		}
 		if( ( range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
 		{
-			chunk_data_offset = table_entry_offset;
-			chunk_data_size   = 8;
+			/* The chunk data offset contains the pattern
+			 */
+			result = libewf_chunk_group_append_pattern_fill_chunk(
+			          chunk_group,
+			          file_io_pool_entry,
+			          table_entry_offset,
+			          chunk_data_offset,
+			          range_flags,
+			          chunk_size,
+			          error );
+		}
+		else
+		{
+			result = libewf_chunk_group_append_chunk(
+			          chunk_group,
+			          file_io_pool_entry,
+			          (off64_t) chunk_data_offset,
+			          (size64_t) chunk_data_size,
+			          range_flags,
+			          chunk_size,
+			          error );
 		}
 		table_entry_offset += sizeof( ewf_table_entry_v2_t );
 
-		if( libfdata_list_append_element_with_mapped_size(
-		     chunk_group->chunks_list,
-		     &element_index,
-		     file_io_pool_entry,
-		     chunk_data_offset,
-		     (size64_t) chunk_data_size,
-		     range_flags,
-		     chunk_size,
-		     error ) != 1 )
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
+			 "%s: unable to append chunk: %" PRIu32 " to chunk group.",
 			 function,
 			 table_entry_index );
 
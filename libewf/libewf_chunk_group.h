@@ -25,8 +25,13 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_buffer_pool.h"
+#include "libewf_chunk_data.h"
+#include "libewf_coalesced_read_buffer.h"
 #include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
+#include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_section.h"
 
@@ -41,6 +46,52 @@ struct libewf_chunk_group
 	/* The chunks list
 	 */
 	libfdata_list_t *chunks_list;
+
+	/* The number of packed chunks
+	 * 0 if the chunks are stored in the chunks list
+	 */
+	uint32_t number_of_packed_chunks;
+
+	/* The number of allocated packed chunks
+	 */
+	uint32_t number_of_allocated_packed_chunks;
+
+	/* The file IO pool entry of the packed chunks
+	 */
+	int file_io_pool_entry;
+
+	/* The base offset of the packed chunks
+	 */
+	off64_t base_offset;
+
+	/* The chunk size, which is the mapped size of every packed chunk
+	 */
+	size32_t chunk_size;
+
+	/* The packed chunk data offsets, relative to the base offset
+	 */
+	uint32_t *packed_offsets;
+
+	/* The packed chunk data sizes
+	 */
+	uint32_t *packed_sizes;
+
+	/* The packed chunk flags, 4 bits per chunk
+	 */
+	uint8_t *packed_flags;
+
+	/* The offset of the table entries
+	 * the chunk data of packed pattern fill chunks is stored in the table entry
+	 */
+	off64_t table_entries_offset;
+
+	/* The range flags that apply to all packed chunks
+	 */
+	uint32_t packed_range_flags;
+
+	/* The timestamp that identifies the cached chunk data of the packed chunks
+	 */
+	int64_t timestamp;
 };
 
 int libewf_chunk_group_initialize(
@@ -61,6 +112,100 @@ int libewf_chunk_group_empty(
      libewf_chunk_group_t *chunk_group,
      libcerror_error_t **error );
 
+int libewf_chunk_group_initialize_packed_chunks(
+     libewf_chunk_group_t *chunk_group,
+     uint32_t number_of_chunks,
+     size32_t chunk_size,
+     int file_io_pool_entry,
+     off64_t base_offset,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_free_packed_chunks(
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_packed_chunk(
+     libewf_chunk_group_t *chunk_group,
+     uint32_t packed_chunk_index,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_expand_packed_chunks(
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_append_packed_chunk(
+     libewf_chunk_group_t *chunk_group,
+     uint32_t first_value,
+     uint32_t second_value,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_append_chunk(
+     libewf_chunk_group_t *chunk_group,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     size32_t chunk_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_append_pattern_fill_chunk(
+     libewf_chunk_group_t *chunk_group,
+     int file_io_pool_entry,
+     off64_t table_entry_offset,
+     uint64_t pattern,
+     uint32_t range_flags,
+     size32_t chunk_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_chunk_at_offset(
+     libewf_chunk_group_t *chunk_group,
+     off64_t chunk_group_data_offset,
+     int *chunk_index,
+     off64_t *chunk_offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_chunk_fill_pattern_at_offset(
+     libewf_chunk_group_t *chunk_group,
+     off64_t chunk_group_data_offset,
+     uint64_t *pattern,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_contiguous_chunk_data_size(
+     libewf_chunk_group_t *chunk_group,
+     off64_t chunk_group_data_offset,
+     size64_t maximum_data_size,
+     size64_t *contiguous_data_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_chunk_data_at_offset(
+     libewf_chunk_group_t *chunk_group,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *chunks_cache,
+     libewf_buffer_pool_t *buffer_pool,
+     libewf_coalesced_read_buffer_t *coalesced_read_buffer,
+     off64_t chunk_group_data_offset,
+     int *chunk_index,
+     off64_t *chunk_offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_set_chunk_data_at_offset(
+     libewf_chunk_group_t *chunk_group,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *chunks_cache,
+     off64_t chunk_group_data_offset,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
 int libewf_chunk_group_fill_v1(
      libewf_chunk_group_t *chunk_group,
      uint64_t chunk_index,
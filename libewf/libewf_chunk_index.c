@@ -0,0 +1,2015 @@
+/*
+ * Chunk index (.ewfidx) functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#include "libewf_checksum.h"
+#include "libewf_chunk_index.h"
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_memory_mapped_file_io_handle.h"
+
+#include "ewf_chunk_index.h"
+
+const uint8_t ewf_chunk_index_signature[ 8 ] = { 'e', 'w', 'f', 'i', 'd', 'x', 0x00, 0x00 };
+
+/* The chunk index contains the chunk groups of the segment files,
+ * as otherwise determined by reading the table sections on open.
+ * The chunks within a chunk group are still read from the table section
+ * when the chunk group is first accessed.
+ */
+
+/* Creates a chunk index
+ * Make sure the value chunk_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_index_initialize(
+     libewf_chunk_index_t **chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_index_initialize";
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_index = memory_allocate_structure(
+	                libewf_chunk_index_t );
+
+	if( *chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_index,
+	     0,
+	     sizeof( libewf_chunk_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *chunk_index != NULL )
+	{
+		memory_free(
+		 *chunk_index );
+
+		*chunk_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_index_free(
+     libewf_chunk_index_t **chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_index_free";
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_index != NULL )
+	{
+		if( ( *chunk_index )->chunk_groups != NULL )
+		{
+			memory_free(
+			 ( *chunk_index )->chunk_groups );
+		}
+		if( ( *chunk_index )->sections != NULL )
+		{
+			memory_free(
+			 ( *chunk_index )->sections );
+		}
+		if( ( *chunk_index )->segments != NULL )
+		{
+			memory_free(
+			 ( *chunk_index )->segments );
+		}
+		memory_free(
+		 *chunk_index );
+
+		*chunk_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the number of segments
+ * The segments are cleared
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_index_set_number_of_segments(
+     libewf_chunk_index_t *chunk_index,
+     uint32_t number_of_segments,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_index_set_number_of_segments";
+	size_t segments_size  = 0;
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_segments == 0 )
+	 || ( (size_t) number_of_segments > ( (size_t) SSIZE_MAX / sizeof( libewf_chunk_index_segment_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index->segments != NULL )
+	{
+		memory_free(
+		 chunk_index->segments );
+
+		chunk_index->segments           = NULL;
+		chunk_index->number_of_segments = 0;
+	}
+	segments_size = sizeof( libewf_chunk_index_segment_t ) * number_of_segments;
+
+	chunk_index->segments = (libewf_chunk_index_segment_t *) memory_allocate(
+	                                                          segments_size );
+
+	if( chunk_index->segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     chunk_index->segments,
+	     0,
+	     segments_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segments.",
+		 function );
+
+		memory_free(
+		 chunk_index->segments );
+
+		chunk_index->segments = NULL;
+
+		return( -1 );
+	}
+	chunk_index->number_of_segments = number_of_segments;
+
+	return( 1 );
+}
+
+/* Retrieves a specific segment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_index_get_segment_by_index(
+     libewf_chunk_index_t *chunk_index,
+     uint32_t segment_index,
+     libewf_chunk_index_segment_t **segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_index_get_segment_by_index";
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_index >= chunk_index->number_of_segments )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	*segment = &( chunk_index->segments[ segment_index ] );
+
+	return( 1 );
+}
+
+/* Retrieves a specific section of a segment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_index_get_section_by_index(
+     libewf_chunk_index_t *chunk_index,
+     libewf_chunk_index_segment_t *segment,
+     uint32_t section_index,
+     libewf_chunk_index_section_t **section,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_index_get_section_by_index";
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( section_index >= segment->number_of_sections )
+	 || ( segment->first_section_index >= chunk_index->number_of_sections )
+	 || ( section_index >= ( chunk_index->number_of_sections - segment->first_section_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid section index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( section == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section.",
+		 function );
+
+		return( -1 );
+	}
+	*section = &( chunk_index->sections[ segment->first_section_index + section_index ] );
+
+	return( 1 );
+}
+
+/* Appends a section to a segment
+ * The sections of a segment must be appended consecutively
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_index_append_section(
+     libewf_chunk_index_t *chunk_index,
+     libewf_chunk_index_segment_t *segment,
+     off64_t descriptor_offset,
+     libcerror_error_t **error )
+{
+	void *reallocation                    = NULL;
+	static char *function                 = "libewf_chunk_index_append_section";
+	uint32_t number_of_allocated_sections = 0;
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment->number_of_sections != 0 )
+	 && ( ( segment->first_section_index + segment->number_of_sections ) != chunk_index->number_of_sections ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported segment - sections are not consecutive.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index->number_of_sections == UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index - number of sections value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index->number_of_sections >= chunk_index->number_of_allocated_sections )
+	{
+		number_of_allocated_sections = chunk_index->number_of_allocated_sections;
+
+		if( number_of_allocated_sections == 0 )
+		{
+			number_of_allocated_sections = 64;
+		}
+		else if( number_of_allocated_sections < ( UINT32_MAX / 2 ) )
+		{
+			number_of_allocated_sections *= 2;
+		}
+		else
+		{
+			number_of_allocated_sections = UINT32_MAX;
+		}
+		if( (size_t) number_of_allocated_sections > ( (size_t) SSIZE_MAX / sizeof( libewf_chunk_index_section_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of allocated sections value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                chunk_index->sections,
+		                sizeof( libewf_chunk_index_section_t ) * number_of_allocated_sections );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize sections.",
+			 function );
+
+			return( -1 );
+		}
+		chunk_index->sections                     = (libewf_chunk_index_section_t *) reallocation;
+		chunk_index->number_of_allocated_sections = number_of_allocated_sections;
+	}
+	if( segment->number_of_sections == 0 )
+	{
+		segment->first_section_index = chunk_index->number_of_sections;
+	}
+	chunk_index->sections[ chunk_index->number_of_sections ].descriptor_offset = descriptor_offset;
+
+	chunk_index->number_of_sections += 1;
+	segment->number_of_sections     += 1;
+
+	return( 1 );
+}
+
+/* Retrieves a specific chunk group of a segment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_index_get_chunk_group_by_index(
+     libewf_chunk_index_t *chunk_index,
+     libewf_chunk_index_segment_t *segment,
+     uint32_t chunk_group_index,
+     libewf_chunk_index_chunk_group_t **chunk_group,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_index_get_chunk_group_by_index";
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_group_index >= segment->number_of_chunk_groups )
+	 || ( segment->first_chunk_group_index >= chunk_index->number_of_chunk_groups )
+	 || ( chunk_group_index >= ( chunk_index->number_of_chunk_groups - segment->first_chunk_group_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk group index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_group = &( chunk_index->chunk_groups[ segment->first_chunk_group_index + chunk_group_index ] );
+
+	return( 1 );
+}
+
+/* Appends a chunk group to a segment
+ * The chunk groups of a segment must be appended consecutively
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_index_append_chunk_group(
+     libewf_chunk_index_t *chunk_index,
+     libewf_chunk_index_segment_t *segment,
+     off64_t data_offset,
+     size64_t data_size,
+     uint32_t number_of_chunks,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	void *reallocation                  = NULL;
+	static char *function               = "libewf_chunk_index_append_chunk_group";
+	uint32_t number_of_allocated_groups = 0;
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment->number_of_chunk_groups != 0 )
+	 && ( ( segment->first_chunk_group_index + segment->number_of_chunk_groups ) != chunk_index->number_of_chunk_groups ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported segment - chunk groups are not consecutive.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index->number_of_chunk_groups == UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index - number of chunk groups value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index->number_of_chunk_groups >= chunk_index->number_of_allocated_chunk_groups )
+	{
+		number_of_allocated_groups = chunk_index->number_of_allocated_chunk_groups;
+
+		if( number_of_allocated_groups == 0 )
+		{
+			number_of_allocated_groups = 64;
+		}
+		else if( number_of_allocated_groups < ( UINT32_MAX / 2 ) )
+		{
+			number_of_allocated_groups *= 2;
+		}
+		else
+		{
+			number_of_allocated_groups = UINT32_MAX;
+		}
+		if( (size_t) number_of_allocated_groups > ( (size_t) SSIZE_MAX / sizeof( libewf_chunk_index_chunk_group_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of allocated chunk groups value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                chunk_index->chunk_groups,
+		                sizeof( libewf_chunk_index_chunk_group_t ) * number_of_allocated_groups );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize chunk groups.",
+			 function );
+
+			return( -1 );
+		}
+		chunk_index->chunk_groups                     = (libewf_chunk_index_chunk_group_t *) reallocation;
+		chunk_index->number_of_allocated_chunk_groups = number_of_allocated_groups;
+	}
+	if( segment->number_of_chunk_groups == 0 )
+	{
+		segment->first_chunk_group_index = chunk_index->number_of_chunk_groups;
+	}
+	chunk_index->chunk_groups[ chunk_index->number_of_chunk_groups ].data_offset      = data_offset;
+	chunk_index->chunk_groups[ chunk_index->number_of_chunk_groups ].data_size        = data_size;
+	chunk_index->chunk_groups[ chunk_index->number_of_chunk_groups ].number_of_chunks = number_of_chunks;
+	chunk_index->chunk_groups[ chunk_index->number_of_chunk_groups ].range_flags      = range_flags;
+
+	chunk_index->number_of_chunk_groups += 1;
+	segment->number_of_chunk_groups     += 1;
+
+	return( 1 );
+}
+
+/* Reads the chunk index from data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_index_read_data(
+     libewf_chunk_index_t *chunk_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_index_segment_t *segment = NULL;
+	static char *function                 = "libewf_chunk_index_read_data";
+	size_t data_offset                    = 0;
+	size64_t required_data_size           = 0;
+	uint64_t value_64bit                  = 0;
+	uint32_t calculated_checksum          = 0;
+	uint32_t value_32bit                  = 0;
+	uint32_t chunk_group_index            = 0;
+	uint32_t format_version               = 0;
+	uint32_t number_of_chunk_groups       = 0;
+	uint32_t number_of_sections           = 0;
+	uint32_t number_of_segments           = 0;
+	uint32_t section_index                = 0;
+	uint32_t segment_index                = 0;
+	uint32_t stored_checksum              = 0;
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_index->segments != NULL )
+	 || ( chunk_index->sections != NULL )
+	 || ( chunk_index->chunk_groups != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk index - values already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < ( sizeof( ewf_chunk_index_header_t ) + 4 ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     ( (ewf_chunk_index_header_t *) data )->signature,
+	     ewf_chunk_index_signature,
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_SIGNATURE_MISMATCH,
+		 "%s: unsupported chunk index signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_chunk_index_header_t *) data )->format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_chunk_index_header_t *) data )->chunk_size,
+	 chunk_index->chunk_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_chunk_index_header_t *) data )->number_of_segments,
+	 number_of_segments );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_chunk_index_header_t *) data )->number_of_chunk_groups,
+	 number_of_chunk_groups );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_chunk_index_header_t *) data )->number_of_sections,
+	 number_of_sections );
+
+	if( memory_copy(
+	     chunk_index->set_identifier,
+	     ( (ewf_chunk_index_header_t *) data )->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( format_version != 3 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version: %" PRIu32 ".",
+		 function,
+		 format_version );
+
+		goto on_error;
+	}
+	if( chunk_index->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	required_data_size = sizeof( ewf_chunk_index_header_t )
+	                   + ( (size64_t) sizeof( ewf_chunk_index_segment_t ) * number_of_segments )
+	                   + ( (size64_t) sizeof( ewf_chunk_index_section_t ) * number_of_sections )
+	                   + ( (size64_t) sizeof( ewf_chunk_index_chunk_group_t ) * number_of_chunk_groups )
+	                   + 4;
+
+	if( required_data_size != (size64_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: mismatch in data size.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( data[ data_size - 4 ] ),
+	 stored_checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     data,
+	     data_size - 4,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+		 "%s: mismatch in checksum ( 0x%08" PRIx32 " != 0x%08" PRIx32 " ).",
+		 function,
+		 stored_checksum,
+		 calculated_checksum );
+
+		goto on_error;
+	}
+	if( libewf_chunk_index_set_number_of_segments(
+	     chunk_index,
+	     number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	data_offset = sizeof( ewf_chunk_index_header_t );
+
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		segment = &( chunk_index->segments[ segment_index ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->file_size,
+		 segment->file_size );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->modification_time,
+		 segment->modification_time );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->device_identifier,
+		 segment->device_identifier );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->inode_number,
+		 segment->inode_number );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->previous_last_chunk_filled,
+		 value_64bit );
+
+		segment->previous_last_chunk_filled = (int64_t) value_64bit;
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->last_chunk_filled,
+		 value_64bit );
+
+		segment->last_chunk_filled = (int64_t) value_64bit;
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->segment_number,
+		 segment->segment_number );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->flags,
+		 segment->flags );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->first_chunk_group_index,
+		 segment->first_chunk_group_index );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->number_of_chunk_groups,
+		 segment->number_of_chunk_groups );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->last_section_offset,
+		 value_64bit );
+
+		segment->last_section_offset = (off64_t) value_64bit;
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->first_section_index,
+		 segment->first_section_index );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->number_of_sections,
+		 segment->number_of_sections );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->device_information_section_index,
+		 value_32bit );
+
+		segment->device_information_section_index = (int) (int32_t) value_32bit;
+
+		if( ( segment->first_section_index > number_of_sections )
+		 || ( segment->number_of_sections > ( number_of_sections - segment->first_section_index ) )
+		 || ( segment->device_information_section_index < -1 )
+		 || ( segment->device_information_section_index >= (int) segment->number_of_sections ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment: %" PRIu32 " sections value out of bounds.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( ( segment->first_chunk_group_index > number_of_chunk_groups )
+		 || ( segment->number_of_chunk_groups > ( number_of_chunk_groups - segment->first_chunk_group_index ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment: %" PRIu32 " chunk groups value out of bounds.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		data_offset += sizeof( ewf_chunk_index_segment_t );
+	}
+	if( number_of_sections > 0 )
+	{
+		chunk_index->sections = (libewf_chunk_index_section_t *) memory_allocate(
+		                                                          sizeof( libewf_chunk_index_section_t ) * number_of_sections );
+
+		if( chunk_index->sections == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sections.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_index->number_of_allocated_sections = number_of_sections;
+	}
+	for( section_index = 0;
+	     section_index < number_of_sections;
+	     section_index++ )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_chunk_index_section_t *) &( data[ data_offset ] ) )->descriptor_offset,
+		 value_64bit );
+
+		chunk_index->sections[ section_index ].descriptor_offset = (off64_t) value_64bit;
+
+		if( chunk_index->sections[ section_index ].descriptor_offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid section: %" PRIu32 " value out of bounds.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+		data_offset += sizeof( ewf_chunk_index_section_t );
+	}
+	chunk_index->number_of_sections = number_of_sections;
+
+	if( number_of_chunk_groups > 0 )
+	{
+		chunk_index->chunk_groups = (libewf_chunk_index_chunk_group_t *) memory_allocate(
+		                                                                  sizeof( libewf_chunk_index_chunk_group_t ) * number_of_chunk_groups );
+
+		if( chunk_index->chunk_groups == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create chunk groups.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_index->number_of_allocated_chunk_groups = number_of_chunk_groups;
+	}
+	for( chunk_group_index = 0;
+	     chunk_group_index < number_of_chunk_groups;
+	     chunk_group_index++ )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_chunk_index_chunk_group_t *) &( data[ data_offset ] ) )->data_offset,
+		 value_64bit );
+
+		chunk_index->chunk_groups[ chunk_group_index ].data_offset = (off64_t) value_64bit;
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_chunk_index_chunk_group_t *) &( data[ data_offset ] ) )->data_size,
+		 chunk_index->chunk_groups[ chunk_group_index ].data_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_chunk_index_chunk_group_t *) &( data[ data_offset ] ) )->number_of_chunks,
+		 chunk_index->chunk_groups[ chunk_group_index ].number_of_chunks );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_chunk_index_chunk_group_t *) &( data[ data_offset ] ) )->range_flags,
+		 chunk_index->chunk_groups[ chunk_group_index ].range_flags );
+
+		if( ( chunk_index->chunk_groups[ chunk_group_index ].data_offset < 0 )
+		 || ( chunk_index->chunk_groups[ chunk_group_index ].number_of_chunks == 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid chunk group: %" PRIu32 " value out of bounds.",
+			 function,
+			 chunk_group_index );
+
+			goto on_error;
+		}
+		data_offset += sizeof( ewf_chunk_index_chunk_group_t );
+	}
+	chunk_index->number_of_chunk_groups = number_of_chunk_groups;
+
+	return( 1 );
+
+on_error:
+	if( chunk_index->chunk_groups != NULL )
+	{
+		memory_free(
+		 chunk_index->chunk_groups );
+
+		chunk_index->chunk_groups = NULL;
+	}
+	chunk_index->number_of_chunk_groups           = 0;
+	chunk_index->number_of_allocated_chunk_groups = 0;
+
+	if( chunk_index->sections != NULL )
+	{
+		memory_free(
+		 chunk_index->sections );
+
+		chunk_index->sections = NULL;
+	}
+	chunk_index->number_of_sections           = 0;
+	chunk_index->number_of_allocated_sections = 0;
+
+	if( chunk_index->segments != NULL )
+	{
+		memory_free(
+		 chunk_index->segments );
+
+		chunk_index->segments = NULL;
+	}
+	chunk_index->number_of_segments = 0;
+
+	return( -1 );
+}
+
+/* Reads the chunk index from a file
+ * Returns 1 if successful, 0 if the file does not exist or -1 on error
+ */
+int libewf_chunk_index_read_file(
+     libewf_chunk_index_t *chunk_index,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	uint8_t *data                    = NULL;
+	static char *function            = "libewf_chunk_index_read_file";
+	size64_t file_size               = 0;
+	ssize_t read_count               = 0;
+	int result                       = 0;
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libbfio_handle_exists(
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if file exists.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_get_size(
+		     file_io_handle,
+		     &file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file size.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( file_size < (size64_t) ( sizeof( ewf_chunk_index_header_t ) + 4 ) )
+		 || ( file_size > (size64_t) SSIZE_MAX ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid file size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		data = (uint8_t *) memory_allocate(
+		                    sizeof( uint8_t ) * (size_t) file_size );
+
+		if( data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              data,
+		              (size_t) file_size,
+		              error );
+
+		if( read_count != (ssize_t) file_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_chunk_index_read_data(
+		     chunk_index,
+		     data,
+		     (size_t) file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk index.",
+			 function );
+
+			goto on_error;
+		}
+		memory_free(
+		 data );
+
+		data = NULL;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the chunk index to a file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_index_write_file(
+     libewf_chunk_index_t *chunk_index,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle      = NULL;
+	libewf_chunk_index_segment_t *segment = NULL;
+	uint8_t *data                         = NULL;
+	static char *function                 = "libewf_chunk_index_write_file";
+	size_t data_offset                    = 0;
+	size64_t data_size                    = 0;
+	ssize_t write_count                   = 0;
+	uint32_t calculated_checksum          = 0;
+	uint32_t chunk_group_index            = 0;
+	uint32_t section_index                = 0;
+	uint32_t segment_index                = 0;
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	data_size = sizeof( ewf_chunk_index_header_t )
+	          + ( (size64_t) sizeof( ewf_chunk_index_segment_t ) * chunk_index->number_of_segments )
+	          + ( (size64_t) sizeof( ewf_chunk_index_section_t ) * chunk_index->number_of_sections )
+	          + ( (size64_t) sizeof( ewf_chunk_index_chunk_group_t ) * chunk_index->number_of_chunk_groups )
+	          + 4;
+
+	if( data_size > (size64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * (size_t) data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     (size_t) data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     ( (ewf_chunk_index_header_t *) data )->signature,
+	     ewf_chunk_index_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_chunk_index_header_t *) data )->format_version,
+	 3 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_chunk_index_header_t *) data )->chunk_size,
+	 chunk_index->chunk_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_chunk_index_header_t *) data )->number_of_segments,
+	 chunk_index->number_of_segments );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_chunk_index_header_t *) data )->number_of_chunk_groups,
+	 chunk_index->number_of_chunk_groups );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_chunk_index_header_t *) data )->number_of_sections,
+	 chunk_index->number_of_sections );
+
+	if( memory_copy(
+	     ( (ewf_chunk_index_header_t *) data )->set_identifier,
+	     chunk_index->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		goto on_error;
+	}
+	data_offset = sizeof( ewf_chunk_index_header_t );
+
+	for( segment_index = 0;
+	     segment_index < chunk_index->number_of_segments;
+	     segment_index++ )
+	{
+		segment = &( chunk_index->segments[ segment_index ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->file_size,
+		 segment->file_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->modification_time,
+		 segment->modification_time );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->device_identifier,
+		 segment->device_identifier );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->inode_number,
+		 segment->inode_number );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->previous_last_chunk_filled,
+		 (uint64_t) segment->previous_last_chunk_filled );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->last_chunk_filled,
+		 (uint64_t) segment->last_chunk_filled );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->segment_number,
+		 segment->segment_number );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->flags,
+		 segment->flags );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->first_chunk_group_index,
+		 segment->first_chunk_group_index );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->number_of_chunk_groups,
+		 segment->number_of_chunk_groups );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->last_section_offset,
+		 (uint64_t) segment->last_section_offset );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->first_section_index,
+		 segment->first_section_index );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->number_of_sections,
+		 segment->number_of_sections );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_chunk_index_segment_t *) &( data[ data_offset ] ) )->device_information_section_index,
+		 (uint32_t) (int32_t) segment->device_information_section_index );
+
+		data_offset += sizeof( ewf_chunk_index_segment_t );
+	}
+	for( section_index = 0;
+	     section_index < chunk_index->number_of_sections;
+	     section_index++ )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_chunk_index_section_t *) &( data[ data_offset ] ) )->descriptor_offset,
+		 (uint64_t) chunk_index->sections[ section_index ].descriptor_offset );
+
+		data_offset += sizeof( ewf_chunk_index_section_t );
+	}
+	for( chunk_group_index = 0;
+	     chunk_group_index < chunk_index->number_of_chunk_groups;
+	     chunk_group_index++ )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_chunk_index_chunk_group_t *) &( data[ data_offset ] ) )->data_offset,
+		 (uint64_t) chunk_index->chunk_groups[ chunk_group_index ].data_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_chunk_index_chunk_group_t *) &( data[ data_offset ] ) )->data_size,
+		 chunk_index->chunk_groups[ chunk_group_index ].data_size );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_chunk_index_chunk_group_t *) &( data[ data_offset ] ) )->number_of_chunks,
+		 chunk_index->chunk_groups[ chunk_group_index ].number_of_chunks );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_chunk_index_chunk_group_t *) &( data[ data_offset ] ) )->range_flags,
+		 chunk_index->chunk_groups[ chunk_group_index ].range_flags );
+
+		data_offset += sizeof( ewf_chunk_index_chunk_group_t );
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     data,
+	     data_offset,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ data_offset ] ),
+	 calculated_checksum );
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               data,
+	               (size_t) data_size,
+	               error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
+/* Retrieves the size, modification time, device identifier and inode number of a file
+ * These values are used to determine if a segment file changed after the chunk index was written
+ * The modification time is in nanoseconds if the platform provides sub-second precision
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int libewf_chunk_index_get_file_values(
+     const char *filename,
+     size64_t *file_size,
+     uint64_t *modification_time,
+     uint64_t *device_identifier,
+     uint64_t *inode_number,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_SYS_STAT_H ) && !defined( WINAPI )
+	struct stat file_statistics;
+#endif
+
+	static char *function = "libewf_chunk_index_get_file_values";
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file size.",
+		 function );
+
+		return( -1 );
+	}
+	if( modification_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid modification time.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( inode_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid inode number.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_SYS_STAT_H ) && !defined( WINAPI )
+	if( stat(
+	     filename,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		return( -1 );
+	}
+	*file_size         = (size64_t) file_statistics.st_size;
+	*modification_time = (uint64_t) file_statistics.st_mtime;
+	*device_identifier = (uint64_t) file_statistics.st_dev;
+	*inode_number      = (uint64_t) file_statistics.st_ino;
+
+	/* A segment file can be rewritten within the same second
+	 * with the same size hence the sub-second part is included if available
+	 */
+#if defined( HAVE_STRUCT_STAT_ST_MTIM_TV_NSEC )
+	*modification_time *= 1000000000UL;
+	*modification_time += (uint64_t) file_statistics.st_mtim.tv_nsec;
+
+#elif defined( HAVE_STRUCT_STAT_ST_MTIMESPEC_TV_NSEC )
+	*modification_time *= 1000000000UL;
+	*modification_time += (uint64_t) file_statistics.st_mtimespec.tv_nsec;
+
+#endif
+
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Retrieves the size, modification time, device identifier and inode number of the file of a file IO handle
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int libewf_chunk_index_get_file_io_handle_values(
+     libbfio_handle_t *file_io_handle,
+     int io_engine,
+     size64_t *file_size,
+     uint64_t *modification_time,
+     uint64_t *device_identifier,
+     uint64_t *inode_number,
+     libcerror_error_t **error )
+{
+	char *filename        = NULL;
+	static char *function = "libewf_chunk_index_get_file_io_handle_values";
+	size_t filename_size  = 0;
+	int result            = 0;
+
+#if defined( HAVE_LIBEWF_MEMORY_MAPPED_FILE_IO_HANDLE )
+	if( io_engine == LIBEWF_IO_ENGINE_MEMORY_MAPPED )
+	{
+		result = libewf_memory_mapped_file_get_name_size(
+		          file_io_handle,
+		          &filename_size,
+		          error );
+	}
+	else
+#endif
+	{
+		result = libbfio_file_get_name_size(
+		          file_io_handle,
+		          &filename_size,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( filename_size == 0 )
+	 || ( filename_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	filename = narrow_string_allocate(
+	            filename_size );
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MEMORY_MAPPED_FILE_IO_HANDLE )
+	if( io_engine == LIBEWF_IO_ENGINE_MEMORY_MAPPED )
+	{
+		result = libewf_memory_mapped_file_get_name(
+		          file_io_handle,
+		          filename,
+		          filename_size,
+		          error );
+	}
+	else
+#endif
+	{
+		result = libbfio_file_get_name(
+		          file_io_handle,
+		          filename,
+		          filename_size,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_chunk_index_get_file_values(
+	          filename,
+	          file_size,
+	          modification_time,
+	          device_identifier,
+	          inode_number,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file values of: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	memory_free(
+	 filename );
+
+	return( result );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( -1 );
+}
+
+/* Determines if the chunk index matches the files in the file IO pool
+ * Returns 1 if the chunk index matches, 0 if not or -1 on error
+ */
+int libewf_chunk_index_matches_file_io_pool(
+     libewf_chunk_index_t *chunk_index,
+     libbfio_pool_t *file_io_pool,
+     int io_engine,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_chunk_index_matches_file_io_pool";
+	size64_t file_size               = 0;
+	uint64_t device_identifier       = 0;
+	uint64_t inode_number            = 0;
+	uint64_t modification_time       = 0;
+	int file_io_pool_entry           = 0;
+	int number_of_file_io_handles    = 0;
+	int result                       = 0;
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_get_number_of_handles(
+	     file_io_pool,
+	     &number_of_file_io_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of file IO handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_file_io_handles <= 0 )
+	 || ( (uint32_t) number_of_file_io_handles != chunk_index->number_of_segments ) )
+	{
+		return( 0 );
+	}
+	for( file_io_pool_entry = 0;
+	     file_io_pool_entry < number_of_file_io_handles;
+	     file_io_pool_entry++ )
+	{
+		if( libbfio_pool_get_handle(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d from pool.",
+			 function,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+		result = libewf_chunk_index_get_file_io_handle_values(
+		          file_io_handle,
+		          io_engine,
+		          &file_size,
+		          &modification_time,
+		          &device_identifier,
+		          &inode_number,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file values of file IO handle: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		if( ( chunk_index->segments[ file_io_pool_entry ].file_size != file_size )
+		 || ( chunk_index->segments[ file_io_pool_entry ].modification_time != modification_time )
+		 || ( chunk_index->segments[ file_io_pool_entry ].device_identifier != device_identifier )
+		 || ( chunk_index->segments[ file_io_pool_entry ].inode_number != inode_number ) )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
@@ -0,0 +1,265 @@
+/*
+ * Chunk index (.ewfidx) functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_INDEX_H )
+#define _LIBEWF_CHUNK_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_index_segment libewf_chunk_index_segment_t;
+
+struct libewf_chunk_index_segment
+{
+	/* The segment file size
+	 */
+	size64_t file_size;
+
+	/* The segment file modification time
+	 */
+	uint64_t modification_time;
+
+	/* The identifier of the device containing the segment file
+	 */
+	uint64_t device_identifier;
+
+	/* The inode number of the segment file
+	 */
+	uint64_t inode_number;
+
+	/* The previous last chunk filled
+	 */
+	int64_t previous_last_chunk_filled;
+
+	/* The last chunk filled
+	 */
+	int64_t last_chunk_filled;
+
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The segment file flags
+	 */
+	uint32_t flags;
+
+	/* The index of the first chunk group
+	 */
+	uint32_t first_chunk_group_index;
+
+	/* The number of chunk groups
+	 */
+	uint32_t number_of_chunk_groups;
+
+	/* The last section offset
+	 */
+	off64_t last_section_offset;
+
+	/* The index of the first section
+	 */
+	uint32_t first_section_index;
+
+	/* The number of sections
+	 */
+	uint32_t number_of_sections;
+
+	/* The index of the device information section
+	 */
+	int device_information_section_index;
+};
+
+typedef struct libewf_chunk_index_section libewf_chunk_index_section_t;
+
+struct libewf_chunk_index_section
+{
+	/* The section descriptor offset
+	 */
+	off64_t descriptor_offset;
+};
+
+typedef struct libewf_chunk_index_chunk_group libewf_chunk_index_chunk_group_t;
+
+struct libewf_chunk_index_chunk_group
+{
+	/* The chunk group data offset
+	 */
+	off64_t data_offset;
+
+	/* The chunk group data size
+	 */
+	size64_t data_size;
+
+	/* The number of chunks
+	 */
+	uint32_t number_of_chunks;
+
+	/* The range flags
+	 */
+	uint32_t range_flags;
+};
+
+typedef struct libewf_chunk_index libewf_chunk_index_t;
+
+struct libewf_chunk_index
+{
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The segment file set identifier
+	 */
+	uint8_t set_identifier[ 16 ];
+
+	/* The segments, one per file IO pool entry
+	 */
+	libewf_chunk_index_segment_t *segments;
+
+	/* The number of segments
+	 */
+	uint32_t number_of_segments;
+
+	/* The sections
+	 */
+	libewf_chunk_index_section_t *sections;
+
+	/* The number of sections
+	 */
+	uint32_t number_of_sections;
+
+	/* The number of allocated sections
+	 */
+	uint32_t number_of_allocated_sections;
+
+	/* The chunk groups
+	 */
+	libewf_chunk_index_chunk_group_t *chunk_groups;
+
+	/* The number of chunk groups
+	 */
+	uint32_t number_of_chunk_groups;
+
+	/* The number of allocated chunk groups
+	 */
+	uint32_t number_of_allocated_chunk_groups;
+};
+
+int libewf_chunk_index_initialize(
+     libewf_chunk_index_t **chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_free(
+     libewf_chunk_index_t **chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_set_number_of_segments(
+     libewf_chunk_index_t *chunk_index,
+     uint32_t number_of_segments,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_get_segment_by_index(
+     libewf_chunk_index_t *chunk_index,
+     uint32_t segment_index,
+     libewf_chunk_index_segment_t **segment,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_get_section_by_index(
+     libewf_chunk_index_t *chunk_index,
+     libewf_chunk_index_segment_t *segment,
+     uint32_t section_index,
+     libewf_chunk_index_section_t **section,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_append_section(
+     libewf_chunk_index_t *chunk_index,
+     libewf_chunk_index_segment_t *segment,
+     off64_t descriptor_offset,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_get_chunk_group_by_index(
+     libewf_chunk_index_t *chunk_index,
+     libewf_chunk_index_segment_t *segment,
+     uint32_t chunk_group_index,
+     libewf_chunk_index_chunk_group_t **chunk_group,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_append_chunk_group(
+     libewf_chunk_index_t *chunk_index,
+     libewf_chunk_index_segment_t *segment,
+     off64_t data_offset,
+     size64_t data_size,
+     uint32_t number_of_chunks,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_read_data(
+     libewf_chunk_index_t *chunk_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_read_file(
+     libewf_chunk_index_t *chunk_index,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_write_file(
+     libewf_chunk_index_t *chunk_index,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_get_file_values(
+     const char *filename,
+     size64_t *file_size,
+     uint64_t *modification_time,
+     uint64_t *device_identifier,
+     uint64_t *inode_number,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_get_file_io_handle_values(
+     libbfio_handle_t *file_io_handle,
+     int io_engine,
+     size64_t *file_size,
+     uint64_t *modification_time,
+     uint64_t *device_identifier,
+     uint64_t *inode_number,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_matches_file_io_pool(
+     libewf_chunk_index_t *chunk_index,
+     libbfio_pool_t *file_io_pool,
+     int io_engine,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_INDEX_H ) */
+
@@ -647,17 +647,20 @@ int libewf_chunk_table_chunk_exists_for_offset(
      off64_t offset,
      libcerror_error_t **error )
 {
-	libewf_chunk_group_t *chunk_group           = NULL;
-	libewf_segment_file_t *segment_file         = NULL;
-	libfdata_list_element_t *chunk_list_element = NULL;
-	static char *function                       = "libewf_chunk_table_chunk_exists_for_offset";
-	off64_t chunk_data_offset                   = 0;
-	off64_t chunk_group_data_offset             = 0;
-	off64_t segment_file_data_offset            = 0;
-	uint32_t segment_number                     = 0;
-	int chunk_groups_list_index                 = 0;
-	int chunks_list_index                       = 0;
-	int result                                  = 0;
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_chunk_table_chunk_exists_for_offset";
+	off64_t chunk_data_offset           = 0;
+	off64_t chunk_group_data_offset     = 0;
+	off64_t chunk_offset                = 0;
+	off64_t segment_file_data_offset    = 0;
+	size64_t chunk_data_size            = 0;
+	uint32_t chunk_data_flags           = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int chunks_list_index               = 0;
+	int file_io_pool_entry              = 0;
+	int result                          = 0;
 
 	if( chunk_table == NULL )
 	{
@@ -710,12 +713,15 @@ int libewf_chunk_table_chunk_exists_for_offset(
 
 			return( -1 );
 		}
-		result = libfdata_list_get_list_element_at_offset(
-			  chunk_group->chunks_list,
+		result = libewf_chunk_group_get_chunk_at_offset(
+			  chunk_group,
 			  chunk_group_data_offset,
 			  &chunks_list_index,
+			  &chunk_offset,
+			  &file_io_pool_entry,
 			  &chunk_data_offset,
-			  &chunk_list_element,
+			  &chunk_data_size,
+			  &chunk_data_flags,
 			  error );
 
 		if( result == -1 )
@@ -737,6 +743,472 @@ int libewf_chunk_table_chunk_exists_for_offset(
 	return( result );
 }
 
+/* Retrieves the fill pattern of a chunk at a specific offset
+ * This allows the data of sparse and pattern fill chunks to be determined without reading the chunk data
+ * Returns 1 if successful, 0 if the chunk has no known fill pattern or -1 on error
+ */
+int libewf_chunk_table_get_chunk_fill_pattern_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     uint64_t *pattern,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_chunk_table_get_chunk_fill_pattern_by_offset";
+	off64_t chunk_group_data_offset     = 0;
+	off64_t segment_file_data_offset    = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int result                          = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+	          chunk_table,
+	          file_io_pool,
+	          segment_table,
+	          chunk_groups_cache,
+	          offset,
+	          &segment_number,
+	          &segment_file_data_offset,
+	          &segment_file,
+	          &chunk_groups_list_index,
+	          &chunk_group_data_offset,
+	          &chunk_group,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( result != 0 )
+	{
+		if( chunk_group == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk group: %d.",
+			 function,
+			 chunk_groups_list_index );
+
+			return( -1 );
+		}
+		result = libewf_chunk_group_get_chunk_fill_pattern_at_offset(
+			  chunk_group,
+			  chunk_group_data_offset,
+			  pattern,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " fill pattern from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+			 function,
+			 chunk_index,
+			 chunk_groups_list_index,
+			 segment_number,
+			 segment_file_data_offset );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the descriptor of a chunk at a specific offset
+ * The descriptor is determined from the table entries without reading the chunk data
+ * Returns 1 if successful, 0 if the chunk is not available or -1 on error
+ */
+int libewf_chunk_table_get_chunk_descriptor_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     uint32_t *segment_number,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_flags,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_chunk_table_get_chunk_descriptor_by_offset";
+	off64_t chunk_group_data_offset     = 0;
+	off64_t chunk_offset                = 0;
+	off64_t segment_file_data_offset    = 0;
+	uint64_t pattern                    = 0;
+	uint32_t range_flags                = 0;
+	int chunk_groups_list_index         = 0;
+	int chunks_list_index               = 0;
+	int file_io_pool_entry              = 0;
+	int result                          = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment number.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk flags.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+	          chunk_table,
+	          file_io_pool,
+	          segment_table,
+	          chunk_groups_cache,
+	          offset,
+	          segment_number,
+	          &segment_file_data_offset,
+	          &segment_file,
+	          &chunk_groups_list_index,
+	          &chunk_group_data_offset,
+	          &chunk_group,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk group: %d.",
+		 function,
+		 chunk_groups_list_index );
+
+		return( -1 );
+	}
+	result = libewf_chunk_group_get_chunk_at_offset(
+		  chunk_group,
+		  chunk_group_data_offset,
+		  &chunks_list_index,
+		  &chunk_offset,
+		  &file_io_pool_entry,
+		  chunk_data_offset,
+		  chunk_data_size,
+		  &range_flags,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+		 function,
+		 chunk_index,
+		 chunk_groups_list_index,
+		 *segment_number,
+		 segment_file_data_offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	*chunk_flags = 0;
+
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		*chunk_flags |= LIBEWF_CHUNK_FLAG_IS_COMPRESSED;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+	{
+		*chunk_flags |= LIBEWF_CHUNK_FLAG_HAS_CHECKSUM;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+	{
+		*chunk_flags |= LIBEWF_CHUNK_FLAG_USES_PATTERN_FILL;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		*chunk_flags |= LIBEWF_CHUNK_FLAG_IS_SPARSE;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_TAINTED ) != 0 )
+	{
+		*chunk_flags |= LIBEWF_CHUNK_FLAG_IS_TAINTED;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		*chunk_flags |= LIBEWF_CHUNK_FLAG_IS_CORRUPTED;
+	}
+	result = libewf_chunk_group_get_chunk_fill_pattern_at_offset(
+		  chunk_group,
+		  chunk_group_data_offset,
+		  &pattern,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " fill pattern.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( ( result != 0 )
+	      && ( pattern == 0 ) )
+	{
+		*chunk_flags |= LIBEWF_CHUNK_FLAG_IS_EMPTY_BLOCK;
+	}
+	return( 1 );
+}
+
+/* Retrieves the range of the data of a chunk at a specific offset
+ * The range is determined from the table entries without reading the chunk data,
+ * this allows the chunk data to be read without using the chunks cache
+ * If the maximum contiguous data size is not 0 the contiguous data size contains the size
+ * of the chunk data and the chunk data that directly follows it, otherwise 0
+ * Returns 1 if successful, 0 if the chunk is not available or -1 on error
+ */
+int libewf_chunk_table_get_chunk_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     size64_t maximum_contiguous_data_size,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     size64_t *contiguous_data_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_chunk_table_get_chunk_range_by_offset";
+	off64_t chunk_group_data_offset     = 0;
+	off64_t chunk_offset                = 0;
+	off64_t segment_file_data_offset    = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int chunks_list_index               = 0;
+	int result                          = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( contiguous_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid contiguous data size.",
+		 function );
+
+		return( -1 );
+	}
+	*contiguous_data_size = 0;
+
+	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+	          chunk_table,
+	          file_io_pool,
+	          segment_table,
+	          chunk_groups_cache,
+	          offset,
+	          &segment_number,
+	          &segment_file_data_offset,
+	          &segment_file,
+	          &chunk_groups_list_index,
+	          &chunk_group_data_offset,
+	          &chunk_group,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk group: %d.",
+		 function,
+		 chunk_groups_list_index );
+
+		return( -1 );
+	}
+	result = libewf_chunk_group_get_chunk_at_offset(
+		  chunk_group,
+		  chunk_group_data_offset,
+		  &chunks_list_index,
+		  &chunk_offset,
+		  file_io_pool_entry,
+		  chunk_data_offset,
+		  chunk_data_size,
+		  range_flags,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+		 function,
+		 chunk_index,
+		 chunk_groups_list_index,
+		 segment_number,
+		 segment_file_data_offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( maximum_contiguous_data_size > 0 )
+	{
+		result = libewf_chunk_group_get_contiguous_chunk_data_size(
+		          chunk_group,
+		          chunk_group_data_offset,
+		          maximum_contiguous_data_size,
+		          contiguous_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " contiguous data size.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			*contiguous_data_size = 0;
+		}
+	}
+	return( 1 );
+}
+
 /* Retrieves the chunk data of a chunk at a specific offset
  * Adds a checksum error if the data is corrupted
  * Returns 1 if successful or -1 on error
@@ -865,15 +1337,16 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 			goto on_error;
 		}
-		result = libfdata_list_get_element_value_at_offset(
-			  chunk_group->chunks_list,
-			  (intptr_t *) file_io_pool,
+		result = libewf_chunk_group_get_chunk_data_at_offset(
+			  chunk_group,
+			  file_io_pool,
 			  chunks_cache,
+			  io_handle->buffer_pool,
+			  io_handle->coalesced_read_buffer,
 			  chunk_group_data_offset,
 			  &chunks_list_index,
 			  chunk_data_offset,
-			  (intptr_t **) chunk_data,
-			  0,
+			  chunk_data,
 			  error );
 
 		if( result == -1 )
@@ -940,6 +1413,7 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 		if( libewf_chunk_data_initialize(
 		     &corrupted_chunk_data,
 		     media_values->chunk_size,
+		     io_handle->buffer_pool,
 		     1,
 		     error ) != 1 )
 		{
@@ -1128,14 +1602,12 @@ int libewf_chunk_table_set_chunk_data_by_offset(
 
 		return( -1 );
 	}
-	result = libfdata_list_set_element_value_at_offset(
-		  chunk_group->chunks_list,
-		  (intptr_t *) file_io_pool,
+	result = libewf_chunk_group_set_chunk_data_at_offset(
+		  chunk_group,
+		  file_io_pool,
 		  chunks_cache,
 		  chunk_group_data_offset,
-		  (intptr_t *) chunk_data,
-		  (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
-		  LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+		  chunk_data,
 		  error );
 
 	if( result != 1 )
@@ -118,6 +118,44 @@ int libewf_chunk_table_chunk_exists_for_offset(
      off64_t offset,
      libcerror_error_t **error );
 
+int libewf_chunk_table_get_chunk_fill_pattern_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     uint64_t *pattern,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_chunk_descriptor_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     uint32_t *segment_number,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_chunk_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     size64_t maximum_contiguous_data_size,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     size64_t *contiguous_data_size,
+     libcerror_error_t **error );
+
 int libewf_chunk_table_get_chunk_data_by_offset(
      libewf_chunk_table_t *chunk_table,
      uint64_t chunk_index,
@@ -0,0 +1,395 @@
+/*
+ * Coalesced read buffer functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_coalesced_read_buffer.h"
+#include "libewf_definitions.h"
+#include "libewf_file_io_pool.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+
+/* Creates a coalesced read buffer
+ * Make sure the value coalesced_read_buffer is referencing, is set to NULL
+ * The data is allocated when it is first read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_coalesced_read_buffer_initialize(
+     libewf_coalesced_read_buffer_t **coalesced_read_buffer,
+     size_t maximum_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_coalesced_read_buffer_initialize";
+
+	if( coalesced_read_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid coalesced read buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *coalesced_read_buffer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid coalesced read buffer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_data_size == 0 )
+	 || ( maximum_data_size > (size_t) LIBEWF_MAXIMUM_COALESCED_READ_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*coalesced_read_buffer = memory_allocate_structure(
+	                          libewf_coalesced_read_buffer_t );
+
+	if( *coalesced_read_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create coalesced read buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *coalesced_read_buffer,
+	     0,
+	     sizeof( libewf_coalesced_read_buffer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear coalesced read buffer.",
+		 function );
+
+		goto on_error;
+	}
+	( *coalesced_read_buffer )->maximum_data_size           = maximum_data_size;
+	( *coalesced_read_buffer )->file_io_pool_entry          = -1;
+	( *coalesced_read_buffer )->previous_file_io_pool_entry = -1;
+
+	return( 1 );
+
+on_error:
+	if( *coalesced_read_buffer != NULL )
+	{
+		memory_free(
+		 *coalesced_read_buffer );
+
+		*coalesced_read_buffer = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a coalesced read buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_coalesced_read_buffer_free(
+     libewf_coalesced_read_buffer_t **coalesced_read_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_coalesced_read_buffer_free";
+
+	if( coalesced_read_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid coalesced read buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *coalesced_read_buffer != NULL )
+	{
+		if( ( *coalesced_read_buffer )->data != NULL )
+		{
+			memory_free(
+			 ( *coalesced_read_buffer )->data );
+		}
+		memory_free(
+		 *coalesced_read_buffer );
+
+		*coalesced_read_buffer = NULL;
+	}
+	return( 1 );
+}
+
+/* Clears the coalesced read buffer
+ * The allocated data is retained for reuse
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_coalesced_read_buffer_clear(
+     libewf_coalesced_read_buffer_t *coalesced_read_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_coalesced_read_buffer_clear";
+
+	if( coalesced_read_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid coalesced read buffer.",
+		 function );
+
+		return( -1 );
+	}
+	coalesced_read_buffer->data_size                   = 0;
+	coalesced_read_buffer->file_io_pool_entry          = -1;
+	coalesced_read_buffer->data_offset                 = 0;
+	coalesced_read_buffer->previous_file_io_pool_entry = -1;
+	coalesced_read_buffer->previous_end_offset         = 0;
+
+	return( 1 );
+}
+
+/* Reads a buffer at a specific offset from a file IO pool entry by means of the coalesced read buffer
+ * If the buffer is not in the coalesced read buffer, the read size bytes at the offset are read
+ * into the coalesced read buffer with a single read, the read size is typically the size of
+ * a run of chunks that are stored back to back. Subsequent reads within the run are copied
+ * from the coalesced read buffer without accessing the file IO pool
+ * The read size is only used when the buffer directly follows the previous read,
+ * otherwise only the buffer is read so that random access does not read ahead
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_coalesced_read_buffer_read_buffer_at_offset(
+         libewf_coalesced_read_buffer_t *coalesced_read_buffer,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         size64_t read_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_coalesced_read_buffer_read_buffer_at_offset";
+	size_t data_offset    = 0;
+	ssize_t read_count    = 0;
+	uint8_t is_sequential = 0;
+
+	if( coalesced_read_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid coalesced read buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == 0 )
+	{
+		return( 0 );
+	}
+	if( ( file_io_pool_entry == coalesced_read_buffer->previous_file_io_pool_entry )
+	 && ( offset == coalesced_read_buffer->previous_end_offset ) )
+	{
+		is_sequential = 1;
+	}
+	coalesced_read_buffer->previous_file_io_pool_entry = file_io_pool_entry;
+	coalesced_read_buffer->previous_end_offset         = offset + (off64_t) buffer_size;
+
+	/* A buffer that does not fit in the coalesced read buffer is read directly
+	 */
+	if( buffer_size > coalesced_read_buffer->maximum_data_size )
+	{
+		read_count = libewf_file_io_pool_read_buffer_at_offset(
+		              file_io_pool,
+		              file_io_pool_entry,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") from file IO pool entry: %d.",
+			 function,
+			 offset,
+			 offset,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
+	if( ( file_io_pool_entry != coalesced_read_buffer->file_io_pool_entry )
+	 || ( offset < coalesced_read_buffer->data_offset )
+	 || ( (size64_t) ( offset - coalesced_read_buffer->data_offset ) >= (size64_t) coalesced_read_buffer->data_size )
+	 || ( buffer_size > ( coalesced_read_buffer->data_size - (size_t) ( offset - coalesced_read_buffer->data_offset ) ) ) )
+	{
+		if( ( is_sequential == 0 )
+		 || ( read_size < (size64_t) buffer_size ) )
+		{
+			read_size = (size64_t) buffer_size;
+		}
+		else if( read_size > (size64_t) coalesced_read_buffer->maximum_data_size )
+		{
+			read_size = (size64_t) coalesced_read_buffer->maximum_data_size;
+		}
+		if( coalesced_read_buffer->data == NULL )
+		{
+			coalesced_read_buffer->data = (uint8_t *) memory_allocate(
+			                                           sizeof( uint8_t ) * coalesced_read_buffer->maximum_data_size );
+
+			if( coalesced_read_buffer->data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		/* Invalidate the data in case the read fails
+		 */
+		coalesced_read_buffer->data_size          = 0;
+		coalesced_read_buffer->file_io_pool_entry = -1;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading %" PRIu64 " bytes at offset: 0x%08" PRIx64 " in file IO pool entry: %d.\n",
+			 function,
+			 read_size,
+			 offset,
+			 file_io_pool_entry );
+		}
+#endif
+		read_count = libewf_file_io_pool_read_buffer_at_offset(
+		              file_io_pool,
+		              file_io_pool_entry,
+		              coalesced_read_buffer->data,
+		              (size_t) read_size,
+		              offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ") from file IO pool entry: %d.",
+			 function,
+			 offset,
+			 offset,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+		coalesced_read_buffer->data_size          = (size_t) read_count;
+		coalesced_read_buffer->file_io_pool_entry = file_io_pool_entry;
+		coalesced_read_buffer->data_offset        = offset;
+
+		/* The data can be smaller than the buffer at the end of the file
+		 */
+		if( buffer_size > coalesced_read_buffer->data_size )
+		{
+			buffer_size = coalesced_read_buffer->data_size;
+		}
+	}
+	data_offset = (size_t) ( offset - coalesced_read_buffer->data_offset );
+
+	if( memory_copy(
+	     buffer,
+	     &( ( coalesced_read_buffer->data )[ data_offset ] ),
+	     buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy data to buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( (ssize_t) buffer_size );
+}
+
@@ -0,0 +1,96 @@
+/*
+ * Coalesced read buffer functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_COALESCED_READ_BUFFER_H )
+#define _LIBEWF_COALESCED_READ_BUFFER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_coalesced_read_buffer libewf_coalesced_read_buffer_t;
+
+struct libewf_coalesced_read_buffer
+{
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The maximum data size, which is the maximum size of a single read
+	 */
+	size_t maximum_data_size;
+
+	/* The file IO pool entry of the data
+	 */
+	int file_io_pool_entry;
+
+	/* The offset of the data in the file IO pool entry
+	 */
+	off64_t data_offset;
+
+	/* The file IO pool entry of the previous read
+	 */
+	int previous_file_io_pool_entry;
+
+	/* The offset directly after the previous read, used to detect sequential access
+	 */
+	off64_t previous_end_offset;
+};
+
+int libewf_coalesced_read_buffer_initialize(
+     libewf_coalesced_read_buffer_t **coalesced_read_buffer,
+     size_t maximum_data_size,
+     libcerror_error_t **error );
+
+int libewf_coalesced_read_buffer_free(
+     libewf_coalesced_read_buffer_t **coalesced_read_buffer,
+     libcerror_error_t **error );
+
+int libewf_coalesced_read_buffer_clear(
+     libewf_coalesced_read_buffer_t *coalesced_read_buffer,
+     libcerror_error_t **error );
+
+ssize_t libewf_coalesced_read_buffer_read_buffer_at_offset(
+         libewf_coalesced_read_buffer_t *coalesced_read_buffer,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         size64_t read_size,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_COALESCED_READ_BUFFER_H ) */
+
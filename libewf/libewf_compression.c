@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -34,13 +35,562 @@
 #include <zlib.h>
 #endif
 
+#if defined( HAVE_LIBDEFLATE )
+#include <libdeflate.h>
+#endif
+
+#if defined( HAVE_LIBISAL )
+#include <isa-l.h>
+#endif
+
 #include "libewf_compression.h"
+#include "libewf_compression_context.h"
 #include "libewf_definitions.h"
 #include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
 
+#if defined( HAVE_LIBDEFLATE )
+
+/* Compresses data using deflate with libdeflate
+ * The compressed data is stored in the zlib format
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compress_data_libdeflate(
+     libewf_compression_context_t *compression_context,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int8_t compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	struct libdeflate_compressor *compressor = NULL;
+	static char *function                    = "libewf_compress_data_libdeflate";
+	size_t libdeflate_compressed_data_size   = 0;
+	int libdeflate_compression_level         = 0;
+	int result                               = 0;
+
+	if( compressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level == LIBEWF_COMPRESSION_DEFAULT )
+	{
+		libdeflate_compression_level = 6;
+	}
+	else if( compression_level == LIBEWF_COMPRESSION_FAST )
+	{
+		libdeflate_compression_level = 1;
+	}
+	else if( compression_level == LIBEWF_COMPRESSION_BEST )
+	{
+		libdeflate_compression_level = 9;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context != NULL )
+	{
+		if( ( compression_context->libdeflate_compressor != NULL )
+		 && ( compression_context->libdeflate_compressor_level != libdeflate_compression_level ) )
+		{
+			libdeflate_free_compressor(
+			 compression_context->libdeflate_compressor );
+
+			compression_context->libdeflate_compressor = NULL;
+		}
+		if( compression_context->libdeflate_compressor == NULL )
+		{
+			compression_context->libdeflate_compressor = libdeflate_alloc_compressor(
+			                                              libdeflate_compression_level );
+
+			compression_context->libdeflate_compressor_level = libdeflate_compression_level;
+		}
+		compressor = compression_context->libdeflate_compressor;
+	}
+	else
+	{
+		compressor = libdeflate_alloc_compressor(
+		              libdeflate_compression_level );
+	}
+	if( compressor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compressor.",
+		 function );
+
+		return( -1 );
+	}
+	libdeflate_compressed_data_size = libdeflate_zlib_compress(
+	                                   compressor,
+	                                   uncompressed_data,
+	                                   uncompressed_data_size,
+	                                   compressed_data,
+	                                   *compressed_data_size );
+
+	if( libdeflate_compressed_data_size != 0 )
+	{
+		*compressed_data_size = libdeflate_compressed_data_size;
+
+		result = 1;
+	}
+	else
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+		 	"%s: unable to write compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		*compressed_data_size = libdeflate_zlib_compress_bound(
+		                         compressor,
+		                         uncompressed_data_size );
+
+		result = 0;
+	}
+	if( compression_context == NULL )
+	{
+		libdeflate_free_compressor(
+		 compressor );
+	}
+	return( result );
+}
+
+/* Decompresses deflate compressed data using libdeflate
+ * The compressed data is expected to be stored in the zlib format
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_decompress_data_libdeflate(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	struct libdeflate_decompressor *decompressor = NULL;
+	static char *function                        = "libewf_decompress_data_libdeflate";
+	size_t libdeflate_uncompressed_data_size     = 0;
+	enum libdeflate_result libdeflate_result     = LIBDEFLATE_SUCCESS;
+	int result                                   = 0;
+
+	if( uncompressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context != NULL )
+	{
+		if( compression_context->libdeflate_decompressor == NULL )
+		{
+			compression_context->libdeflate_decompressor = libdeflate_alloc_decompressor();
+		}
+		decompressor = compression_context->libdeflate_decompressor;
+	}
+	else
+	{
+		decompressor = libdeflate_alloc_decompressor();
+	}
+	if( decompressor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create decompressor.",
+		 function );
+
+		return( -1 );
+	}
+	libdeflate_result = libdeflate_zlib_decompress(
+	                     decompressor,
+	                     compressed_data,
+	                     compressed_data_size,
+	                     uncompressed_data,
+	                     *uncompressed_data_size,
+	                     &libdeflate_uncompressed_data_size );
+
+	if( libdeflate_result == LIBDEFLATE_SUCCESS )
+	{
+		*uncompressed_data_size = libdeflate_uncompressed_data_size;
+
+		result = 1;
+	}
+	else if( libdeflate_result == LIBDEFLATE_INSUFFICIENT_SPACE )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			"%s: unable to read compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		/* Estimate that a factor 2 enlargement should suffice
+		 */
+		*uncompressed_data_size *= 2;
+
+		result = 0;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: unable to read compressed data: libdeflate returned error: %d.",
+		 function,
+		 (int) libdeflate_result );
+
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	if( compression_context == NULL )
+	{
+		libdeflate_free_decompressor(
+		 decompressor );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBDEFLATE ) */
+
+#if defined( HAVE_LIBISAL )
+
+/* Compresses data using deflate with ISA-L igzip
+ * The compressed data is stored in the zlib format
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compress_data_isal(
+     libewf_compression_context_t *compression_context,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int8_t compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	struct isal_zstream stream;
+
+	uint8_t *level_buffer      = NULL;
+	static char *function      = "libewf_compress_data_isal";
+	uint32_t level_buffer_size = 0;
+	uint32_t isal_level        = 0;
+	int result                 = 0;
+
+	if( compressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( *compressed_data_size > (size_t) UINT32_MAX )
+	 || ( uncompressed_data_size > (size_t) UINT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level == LIBEWF_COMPRESSION_DEFAULT )
+	{
+		isal_level        = 1;
+		level_buffer_size = ISAL_DEF_LVL1_DEFAULT;
+	}
+	else if( compression_level == LIBEWF_COMPRESSION_FAST )
+	{
+		isal_level        = 0;
+		level_buffer_size = 0;
+	}
+	else if( compression_level == LIBEWF_COMPRESSION_BEST )
+	{
+		isal_level        = 3;
+		level_buffer_size = ISAL_DEF_LVL3_DEFAULT;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_context != NULL )
+	 && ( compression_context->isal_level_buffer_size < level_buffer_size ) )
+	{
+		if( compression_context->isal_level_buffer != NULL )
+		{
+			memory_free(
+			 compression_context->isal_level_buffer );
+		}
+		compression_context->isal_level_buffer = (uint8_t *) memory_allocate(
+		                                                      sizeof( uint8_t ) * level_buffer_size );
+
+		if( compression_context->isal_level_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create level buffer.",
+			 function );
+
+			compression_context->isal_level_buffer_size = 0;
+
+			return( -1 );
+		}
+		compression_context->isal_level_buffer_size = level_buffer_size;
+	}
+	if( compression_context != NULL )
+	{
+		level_buffer = compression_context->isal_level_buffer;
+	}
+	else if( level_buffer_size > 0 )
+	{
+		level_buffer = (uint8_t *) memory_allocate(
+		                            sizeof( uint8_t ) * level_buffer_size );
+
+		if( level_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create level buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	isal_deflate_stateless_init(
+	 &stream );
+
+	stream.next_in        = (uint8_t *) uncompressed_data;
+	stream.avail_in       = (uint32_t) uncompressed_data_size;
+	stream.next_out       = compressed_data;
+	stream.avail_out      = (uint32_t) *compressed_data_size;
+	stream.end_of_stream  = 1;
+	stream.flush          = NO_FLUSH;
+	stream.gzip_flag      = IGZIP_ZLIB;
+	stream.level          = isal_level;
+	stream.level_buf      = level_buffer;
+	stream.level_buf_size = level_buffer_size;
+
+	result = isal_deflate_stateless(
+	          &stream );
+
+	if( result == COMP_OK )
+	{
+		*compressed_data_size = (size_t) stream.total_out;
+
+		result = 1;
+	}
+	else if( result == STATELESS_OVERFLOW )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+		 	"%s: unable to write compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		/* Estimate that a factor 2 enlargement should suffice
+		 */
+		*compressed_data_size *= 2;
+
+		result = 0;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: ISA-L returned undefined error: %d.",
+		 function,
+		 result );
+
+		*compressed_data_size = 0;
+
+		result = -1;
+	}
+	if( ( compression_context == NULL )
+	 && ( level_buffer != NULL ) )
+	{
+		memory_free(
+		 level_buffer );
+	}
+	return( result );
+}
+
+/* Decompresses deflate compressed data using ISA-L igzip
+ * The compressed data is expected to be stored in the zlib format
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_decompress_data_isal(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	struct inflate_state *state = NULL;
+	static char *function       = "libewf_decompress_data_isal";
+	int result                  = 0;
+
+	if( uncompressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compressed_data_size > (size_t) UINT32_MAX )
+	 || ( *uncompressed_data_size > (size_t) UINT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* The inflate state is too large to be stored on the stack
+	 */
+	if( compression_context != NULL )
+	{
+		if( compression_context->isal_inflate_state == NULL )
+		{
+			compression_context->isal_inflate_state = memory_allocate_structure(
+			                                           struct inflate_state );
+		}
+		state = compression_context->isal_inflate_state;
+	}
+	else
+	{
+		state = memory_allocate_structure(
+		         struct inflate_state );
+	}
+	if( state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create inflate state.",
+		 function );
+
+		return( -1 );
+	}
+	isal_inflate_init(
+	 state );
+
+	state->next_in   = (uint8_t *) compressed_data;
+	state->avail_in  = (uint32_t) compressed_data_size;
+	state->next_out  = uncompressed_data;
+	state->avail_out = (uint32_t) *uncompressed_data_size;
+	state->crc_flag  = ISAL_ZLIB;
+
+	result = isal_inflate_stateless(
+	          state );
+
+	if( result == ISAL_DECOMP_OK )
+	{
+		*uncompressed_data_size = (size_t) state->total_out;
+
+		result = 1;
+	}
+	else if( result == ISAL_OUT_OVERFLOW )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			"%s: unable to read compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		/* Estimate that a factor 2 enlargement should suffice
+		 */
+		*uncompressed_data_size *= 2;
+
+		result = 0;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: unable to read compressed data: ISA-L returned error: %d.",
+		 function,
+		 result );
+
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	if( compression_context == NULL )
+	{
+		memory_free(
+		 state );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBISAL ) */
+
 /* Compresses data using the compression method
+ * The deflate codec is used for the deflate compression method,
+ * the zlib codec is used if the codec is not supported
  * Returns 1 on success, 0 if buffer is too small or -1 on error
  */
 int libewf_compress_data(
@@ -48,12 +598,14 @@ int libewf_compress_data(
      size_t *compressed_data_size,
      uint16_t compression_method,
      int8_t compression_level,
+     uint8_t deflate_codec,
      const uint8_t *uncompressed_data,
      size_t uncompressed_data_size,
      libcerror_error_t **error )
 {
-	static char *function                   = "libewf_compress_data";
-	int result                              = 0;
+	libewf_compression_context_t *compression_context = NULL;
+	static char *function                             = "libewf_compress_data";
+	int result                                        = 0;
 
 #if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
 	unsigned int bzip2_compressed_data_size = 0;
@@ -108,6 +660,73 @@ int libewf_compress_data(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBEWF_COMPRESSION_CONTEXT )
+	if( libewf_compression_context_get_thread_context(
+	     &compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve compression context.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+#if defined( HAVE_LIBDEFLATE )
+	if( ( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 && ( deflate_codec == LIBEWF_DEFLATE_CODEC_LIBDEFLATE )
+	 && ( compression_level != LIBEWF_COMPRESSION_NONE ) )
+	{
+		result = libewf_compress_data_libdeflate(
+		          compression_context,
+		          compressed_data,
+		          compressed_data_size,
+		          compression_level,
+		          uncompressed_data,
+		          uncompressed_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to compress data using libdeflate.",
+			 function );
+		}
+		return( result );
+	}
+#endif /* defined( HAVE_LIBDEFLATE ) */
+#if defined( HAVE_LIBISAL )
+	if( ( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 && ( deflate_codec == LIBEWF_DEFLATE_CODEC_ISAL )
+	 && ( compression_level != LIBEWF_COMPRESSION_NONE ) )
+	{
+		result = libewf_compress_data_isal(
+		          compression_context,
+		          compressed_data,
+		          compressed_data_size,
+		          compression_level,
+		          uncompressed_data,
+		          uncompressed_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to compress data using ISA-L.",
+			 function );
+		}
+		return( result );
+	}
+#endif /* defined( HAVE_LIBISAL ) */
 	if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
 	{
 #if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
@@ -162,7 +781,8 @@ int libewf_compress_data(
 		}
 		zlib_compressed_data_size = (uLongf) *compressed_data_size;
 
-		result = compress2(
+		result = libewf_compression_context_zlib_compress(
+			  compression_context,
 			  (Bytef *) compressed_data,
 			  &zlib_compressed_data_size,
 			  (Bytef *) uncompressed_data,
@@ -282,14 +902,13 @@ int libewf_compress_data(
 		}
 		bzip2_compressed_data_size = (unsigned int) *compressed_data_size;
 
-		result = BZ2_bzBuffToBuffCompress(
+		result = libewf_compression_context_bzip2_compress(
+			  compression_context,
 			  (char *) compressed_data,
 			  &bzip2_compressed_data_size,
 			  (char *) uncompressed_data,
 			  (unsigned int) uncompressed_data_size,
-			  bzip2_compression_level,
-			  0,
-			  30 );
+			  bzip2_compression_level );
 
 		if( result == BZ_OK )
 		{
@@ -366,18 +985,22 @@ int libewf_compress_data(
 }
 
 /* Decompresses data using the compression method
+ * The deflate codec is used for the deflate compression method,
+ * the zlib codec is used if the codec is not supported
  * Returns 1 on success, 0 on failure or -1 on error
  */
 int libewf_decompress_data(
      const uint8_t *compressed_data,
      size_t compressed_data_size,
      uint16_t compression_method,
+     uint8_t deflate_codec,
      uint8_t *uncompressed_data,
      size_t *uncompressed_data_size,
      libcerror_error_t **error )
 {
-	static char *function                     = "libewf_decompress_data";
-	int result                                = 0;
+	libewf_compression_context_t *compression_context = NULL;
+	static char *function                             = "libewf_decompress_data";
+	int result                                        = 0;
 
 #if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
 	unsigned int bzip2_uncompressed_data_size = 0;
@@ -430,6 +1053,69 @@ int libewf_decompress_data(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBEWF_COMPRESSION_CONTEXT )
+	if( libewf_compression_context_get_thread_context(
+	     &compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve compression context.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+#if defined( HAVE_LIBDEFLATE )
+	if( ( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 && ( deflate_codec == LIBEWF_DEFLATE_CODEC_LIBDEFLATE ) )
+	{
+		result = libewf_decompress_data_libdeflate(
+		          compression_context,
+		          compressed_data,
+		          compressed_data_size,
+		          uncompressed_data,
+		          uncompressed_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress data using libdeflate.",
+			 function );
+		}
+		return( result );
+	}
+#endif /* defined( HAVE_LIBDEFLATE ) */
+#if defined( HAVE_LIBISAL )
+	if( ( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 && ( deflate_codec == LIBEWF_DEFLATE_CODEC_ISAL ) )
+	{
+		result = libewf_decompress_data_isal(
+		          compression_context,
+		          compressed_data,
+		          compressed_data_size,
+		          uncompressed_data,
+		          uncompressed_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress data using ISA-L.",
+			 function );
+		}
+		return( result );
+	}
+#endif /* defined( HAVE_LIBISAL ) */
 	if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
 	{
 #if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
@@ -457,7 +1143,8 @@ int libewf_decompress_data(
 		}
 		zlib_uncompressed_data_size = (uLongf) *uncompressed_data_size;
 
-		result = uncompress(
+		result = libewf_compression_context_zlib_uncompress(
+			  compression_context,
 			  (Bytef *) uncompressed_data,
 			  &zlib_uncompressed_data_size,
 			  (Bytef *) compressed_data,
@@ -574,13 +1261,12 @@ int libewf_decompress_data(
 		}
 		bzip2_uncompressed_data_size = (unsigned int) *uncompressed_data_size;
 
-		result = BZ2_bzBuffToBuffDecompress(
+		result = libewf_compression_context_bzip2_decompress(
+			  compression_context,
 			  (char *) uncompressed_data,
 			  &bzip2_uncompressed_data_size,
 			  (char *) compressed_data,
-			  (unsigned int) compressed_data_size,
-			  0,
-			  0 );
+			  (unsigned int) compressed_data_size );
 
 		if( result == BZ_OK )
 		{
@@ -671,3 +1357,102 @@ int libewf_decompress_data(
 	return( result );
 }
 
+/* Estimates if data is incompressible
+ * The estimate is based on the byte distribution of samples taken at evenly spaced offsets in the data,
+ * data of which the byte distribution cannot be distinguished from uniformly distributed bytes,
+ * such as encrypted or already compressed data, is estimated to be incompressible
+ * Returns 1 if the data is estimated to be incompressible, 0 if not or -1 on error
+ */
+int libewf_compression_is_incompressible(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint32_t byte_value_counts[ 256 ];
+
+	const uint8_t *sample_data = NULL;
+	static char *function      = "libewf_compression_is_incompressible";
+	size_t sample_data_offset  = 0;
+	size_t sample_offset       = 0;
+	uint64_t chi_square        = 0;
+	uint64_t sum_of_squares    = 0;
+	uint32_t number_of_values  = 0;
+	int byte_value             = 0;
+	int sample_index           = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Data smaller than the combined samples is not estimated
+	 */
+	if( data_size < ( LIBEWF_INCOMPRESSIBLE_ESTIMATE_NUMBER_OF_SAMPLES * LIBEWF_INCOMPRESSIBLE_ESTIMATE_SAMPLE_SIZE ) )
+	{
+		return( 0 );
+	}
+	if( memory_set(
+	     byte_value_counts,
+	     0,
+	     sizeof( uint32_t ) * 256 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear byte value counts.",
+		 function );
+
+		return( -1 );
+	}
+	for( sample_index = 0;
+	     sample_index < LIBEWF_INCOMPRESSIBLE_ESTIMATE_NUMBER_OF_SAMPLES;
+	     sample_index++ )
+	{
+		sample_offset = ( ( data_size - LIBEWF_INCOMPRESSIBLE_ESTIMATE_SAMPLE_SIZE ) / ( LIBEWF_INCOMPRESSIBLE_ESTIMATE_NUMBER_OF_SAMPLES - 1 ) ) * sample_index;
+		sample_data   = &( data[ sample_offset ] );
+
+		for( sample_data_offset = 0;
+		     sample_data_offset < LIBEWF_INCOMPRESSIBLE_ESTIMATE_SAMPLE_SIZE;
+		     sample_data_offset++ )
+		{
+			byte_value_counts[ sample_data[ sample_data_offset ] ] += 1;
+		}
+	}
+	number_of_values = LIBEWF_INCOMPRESSIBLE_ESTIMATE_NUMBER_OF_SAMPLES * LIBEWF_INCOMPRESSIBLE_ESTIMATE_SAMPLE_SIZE;
+
+	for( byte_value = 0;
+	     byte_value < 256;
+	     byte_value++ )
+	{
+		sum_of_squares += (uint64_t) byte_value_counts[ byte_value ] * byte_value_counts[ byte_value ];
+	}
+	/* The chi-square value of the byte distribution compared to uniformly distributed bytes
+	 * is: ( 256 x sum of squares / number of values ) - number of values
+	 */
+	chi_square = ( ( sum_of_squares * 256 ) / number_of_values ) - number_of_values;
+
+	if( chi_square <= LIBEWF_INCOMPRESSIBLE_ESTIMATE_MAXIMUM_CHI_SQUARE )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
@@ -25,17 +25,61 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_compression_context.h"
 #include "libewf_libcerror.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+#if defined( HAVE_LIBDEFLATE )
+
+int libewf_compress_data_libdeflate(
+     libewf_compression_context_t *compression_context,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int8_t compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error );
+
+int libewf_decompress_data_libdeflate(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBDEFLATE ) */
+
+#if defined( HAVE_LIBISAL )
+
+int libewf_compress_data_isal(
+     libewf_compression_context_t *compression_context,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int8_t compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error );
+
+int libewf_decompress_data_isal(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBISAL ) */
+
 int libewf_compress_data(
      uint8_t *compressed_data,
      size_t *compressed_data_size,
      uint16_t compression_method,
      int8_t compression_level,
+     uint8_t deflate_codec,
      const uint8_t *uncompressed_data,
      size_t uncompressed_data_size,
      libcerror_error_t **error );
@@ -44,10 +88,16 @@ int libewf_decompress_data(
      const uint8_t *compressed_data,
      size_t compressed_data_size,
      uint16_t compression_method,
+     uint8_t deflate_codec,
      uint8_t *uncompressed_data,
      size_t *uncompressed_data_size,
      libcerror_error_t **error );
 
+int libewf_compression_is_incompressible(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
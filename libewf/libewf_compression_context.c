@@ -0,0 +1,831 @@
+/*
+ * Compression context functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_LIMITS_H ) || defined( WINAPI )
+#include <limits.h>
+#endif
+
+#include "libewf_compression_context.h"
+#include "libewf_libcerror.h"
+
+#if defined( HAVE_LIBEWF_COMPRESSION_CONTEXT )
+#include <pthread.h>
+#endif
+
+/* The size of the header of a retained bzip2 allocation,
+ * which contains the allocation size and preserves the alignment
+ */
+#define LIBEWF_COMPRESSION_CONTEXT_BZIP2_ALLOCATION_HEADER_SIZE		16
+
+#if defined( HAVE_LIBEWF_COMPRESSION_CONTEXT )
+
+static pthread_once_t libewf_compression_context_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t libewf_compression_context_key;
+static int libewf_compression_context_key_is_set          = 0;
+
+/* Frees the compression context of a thread
+ * Callback function for the thread-specific data key, called when the thread exits
+ */
+static void libewf_compression_context_key_free(
+             void *value )
+{
+	libewf_compression_context_t *compression_context = NULL;
+
+	compression_context = (libewf_compression_context_t *) value;
+
+	libewf_compression_context_free(
+	 &compression_context,
+	 NULL );
+}
+
+/* Creates the thread-specific data key
+ * Callback function for pthread_once
+ */
+static void libewf_compression_context_key_initialize(
+             void )
+{
+	if( pthread_key_create(
+	     &libewf_compression_context_key,
+	     &libewf_compression_context_key_free ) == 0 )
+	{
+		libewf_compression_context_key_is_set = 1;
+	}
+}
+
+#endif /* defined( HAVE_LIBEWF_COMPRESSION_CONTEXT ) */
+
+/* Creates a compression context
+ * Make sure the value compression_context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_initialize(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_initialize";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_context = memory_allocate_structure(
+	                        libewf_compression_context_t );
+
+	if( *compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_context,
+	     0,
+	     sizeof( libewf_compression_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *compression_context != NULL )
+	{
+		memory_free(
+		 *compression_context );
+
+		*compression_context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression context
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_free(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_free";
+
+#if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
+	int allocation_index  = 0;
+#endif
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+		if( ( *compression_context )->deflate_stream_initialized != 0 )
+		{
+			deflateEnd(
+			 &( ( *compression_context )->deflate_stream ) );
+		}
+		if( ( *compression_context )->inflate_stream_initialized != 0 )
+		{
+			inflateEnd(
+			 &( ( *compression_context )->inflate_stream ) );
+		}
+#endif
+#if defined( HAVE_LIBDEFLATE )
+		if( ( *compression_context )->libdeflate_compressor != NULL )
+		{
+			libdeflate_free_compressor(
+			 ( *compression_context )->libdeflate_compressor );
+		}
+		if( ( *compression_context )->libdeflate_decompressor != NULL )
+		{
+			libdeflate_free_decompressor(
+			 ( *compression_context )->libdeflate_decompressor );
+		}
+#endif
+#if defined( HAVE_LIBISAL )
+		if( ( *compression_context )->isal_level_buffer != NULL )
+		{
+			memory_free(
+			 ( *compression_context )->isal_level_buffer );
+		}
+		if( ( *compression_context )->isal_inflate_state != NULL )
+		{
+			memory_free(
+			 ( *compression_context )->isal_inflate_state );
+		}
+#endif
+#if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
+		for( allocation_index = 0;
+		     allocation_index < ( *compression_context )->number_of_bzip2_allocations;
+		     allocation_index++ )
+		{
+			memory_free(
+			 ( *compression_context )->bzip2_allocations[ allocation_index ] );
+		}
+#endif
+		memory_free(
+		 *compression_context );
+
+		*compression_context = NULL;
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_LIBEWF_COMPRESSION_CONTEXT )
+
+/* Retrieves the compression context of the current thread
+ * The compression context is created on first use and freed when the thread exits
+ * or by libewf_compression_context_finalize for the thread that unloads the library
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_get_thread_context(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	libewf_compression_context_t *thread_compression_context = NULL;
+	static char *function                                    = "libewf_compression_context_get_thread_context";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( pthread_once(
+	     &libewf_compression_context_key_once,
+	     &libewf_compression_context_key_initialize ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize thread-specific data key.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_compression_context_key_is_set == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing thread-specific data key.",
+		 function );
+
+		return( -1 );
+	}
+	thread_compression_context = (libewf_compression_context_t *) pthread_getspecific(
+	                                                               libewf_compression_context_key );
+
+	if( thread_compression_context == NULL )
+	{
+		if( libewf_compression_context_initialize(
+		     &thread_compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create compression context.",
+			 function );
+
+			goto on_error;
+		}
+		if( pthread_setspecific(
+		     libewf_compression_context_key,
+		     thread_compression_context ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set thread-specific compression context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	*compression_context = thread_compression_context;
+
+	return( 1 );
+
+on_error:
+	if( thread_compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &thread_compression_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Finalizes the thread compression contexts
+ * Frees the compression context of the current thread and deletes the thread-specific data key,
+ * so that no key destructor refers to the library after it has been unloaded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_finalize(
+     libcerror_error_t **error )
+{
+	libewf_compression_context_t *thread_compression_context = NULL;
+	static char *function                                    = "libewf_compression_context_finalize";
+	int result                                               = 1;
+
+	if( libewf_compression_context_key_is_set == 0 )
+	{
+		return( 1 );
+	}
+	thread_compression_context = (libewf_compression_context_t *) pthread_getspecific(
+	                                                               libewf_compression_context_key );
+
+	if( thread_compression_context != NULL )
+	{
+		if( pthread_setspecific(
+		     libewf_compression_context_key,
+		     NULL ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set thread-specific compression context.",
+			 function );
+
+			result = -1;
+		}
+		else if( libewf_compression_context_free(
+		          &thread_compression_context,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression context.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( pthread_key_delete(
+	     libewf_compression_context_key ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to delete thread-specific data key.",
+		 function );
+
+		result = -1;
+	}
+	libewf_compression_context_key_is_set = 0;
+
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_COMPRESSION_CONTEXT ) */
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+
+/* Compresses data using zlib
+ * Behaves as compress2 but reuses the deflate stream of the compression context,
+ * compress2 is used if no compression context is provided
+ * Returns a zlib return value
+ */
+int libewf_compression_context_zlib_compress(
+     libewf_compression_context_t *compression_context,
+     Bytef *compressed_data,
+     uLongf *compressed_data_size,
+     const Bytef *uncompressed_data,
+     uLong uncompressed_data_size,
+     int compression_level )
+{
+	int result = 0;
+
+	/* The stream can only be used if the sizes fit in the available values of the stream
+	 */
+	if( ( compression_context == NULL )
+	 || ( *compressed_data_size > (uLongf) UINT_MAX )
+	 || ( uncompressed_data_size > (uLong) UINT_MAX ) )
+	{
+		return( compress2(
+		         compressed_data,
+		         compressed_data_size,
+		         uncompressed_data,
+		         uncompressed_data_size,
+		         compression_level ) );
+	}
+	if( ( compression_context->deflate_stream_initialized != 0 )
+	 && ( compression_context->deflate_stream_level != compression_level ) )
+	{
+		deflateEnd(
+		 &( compression_context->deflate_stream ) );
+
+		compression_context->deflate_stream_initialized = 0;
+	}
+	if( compression_context->deflate_stream_initialized == 0 )
+	{
+		memory_set(
+		 &( compression_context->deflate_stream ),
+		 0,
+		 sizeof( z_stream ) );
+
+		result = deflateInit(
+		          &( compression_context->deflate_stream ),
+		          compression_level );
+
+		if( result != Z_OK )
+		{
+			return( result );
+		}
+		compression_context->deflate_stream_initialized = 1;
+		compression_context->deflate_stream_level       = compression_level;
+	}
+	else
+	{
+		result = deflateReset(
+		          &( compression_context->deflate_stream ) );
+
+		if( result != Z_OK )
+		{
+			deflateEnd(
+			 &( compression_context->deflate_stream ) );
+
+			compression_context->deflate_stream_initialized = 0;
+
+			return( result );
+		}
+	}
+	compression_context->deflate_stream.next_in   = (Bytef *) uncompressed_data;
+	compression_context->deflate_stream.avail_in  = (uInt) uncompressed_data_size;
+	compression_context->deflate_stream.next_out  = compressed_data;
+	compression_context->deflate_stream.avail_out = (uInt) *compressed_data_size;
+
+	result = deflate(
+	          &( compression_context->deflate_stream ),
+	          Z_FINISH );
+
+	if( result == Z_STREAM_END )
+	{
+		*compressed_data_size = (uLongf) compression_context->deflate_stream.total_out;
+
+		result = Z_OK;
+	}
+	else if( result == Z_OK )
+	{
+		/* The compressed data did not fit in the buffer
+		 */
+		result = Z_BUF_ERROR;
+	}
+	return( result );
+}
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+
+/* Decompresses data using zlib
+ * Behaves as uncompress but reuses the inflate stream of the compression context,
+ * uncompress is used if no compression context is provided
+ * Returns a zlib return value
+ */
+int libewf_compression_context_zlib_uncompress(
+     libewf_compression_context_t *compression_context,
+     Bytef *uncompressed_data,
+     uLongf *uncompressed_data_size,
+     const Bytef *compressed_data,
+     uLong compressed_data_size )
+{
+	int result = 0;
+
+	/* The stream can only be used if the sizes fit in the available values of the stream
+	 */
+	if( ( compression_context == NULL )
+	 || ( *uncompressed_data_size > (uLongf) UINT_MAX )
+	 || ( compressed_data_size > (uLong) UINT_MAX ) )
+	{
+		return( uncompress(
+		         uncompressed_data,
+		         uncompressed_data_size,
+		         compressed_data,
+		         compressed_data_size ) );
+	}
+	if( compression_context->inflate_stream_initialized == 0 )
+	{
+		memory_set(
+		 &( compression_context->inflate_stream ),
+		 0,
+		 sizeof( z_stream ) );
+
+		result = inflateInit(
+		          &( compression_context->inflate_stream ) );
+
+		if( result != Z_OK )
+		{
+			return( result );
+		}
+		compression_context->inflate_stream_initialized = 1;
+	}
+	else
+	{
+		result = inflateReset(
+		          &( compression_context->inflate_stream ) );
+
+		if( result != Z_OK )
+		{
+			inflateEnd(
+			 &( compression_context->inflate_stream ) );
+
+			compression_context->inflate_stream_initialized = 0;
+
+			return( result );
+		}
+	}
+	compression_context->inflate_stream.next_in   = (Bytef *) compressed_data;
+	compression_context->inflate_stream.avail_in  = (uInt) compressed_data_size;
+	compression_context->inflate_stream.next_out  = uncompressed_data;
+	compression_context->inflate_stream.avail_out = (uInt) *uncompressed_data_size;
+
+	result = inflate(
+	          &( compression_context->inflate_stream ),
+	          Z_FINISH );
+
+	if( result == Z_STREAM_END )
+	{
+		*uncompressed_data_size = (uLongf) compression_context->inflate_stream.total_out;
+
+		result = Z_OK;
+	}
+	else if( result == Z_NEED_DICT )
+	{
+		result = Z_DATA_ERROR;
+	}
+	else if( ( result == Z_OK )
+	      || ( result == Z_BUF_ERROR ) )
+	{
+		/* If the buffer was not filled the compressed data is truncated
+		 */
+		if( compression_context->inflate_stream.avail_out == 0 )
+		{
+			result = Z_BUF_ERROR;
+		}
+		else
+		{
+			result = Z_DATA_ERROR;
+		}
+	}
+	return( result );
+}
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) */
+
+#if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
+
+/* Allocates memory for bzip2
+ * A retained allocation of the same size is reused if available
+ * Callback function for the bzip2 stream
+ * Returns a pointer to the allocated memory or NULL on error
+ */
+void *libewf_compression_context_bzip2_allocate(
+       void *opaque,
+       int number_of_items,
+       int item_size )
+{
+	libewf_compression_context_t *compression_context = NULL;
+	uint8_t *allocation                               = NULL;
+	size_t allocation_size                            = 0;
+	int allocation_index                              = 0;
+
+	if( ( opaque == NULL )
+	 || ( number_of_items < 0 )
+	 || ( item_size < 0 ) )
+	{
+		return( NULL );
+	}
+	if( ( item_size != 0 )
+	 && ( (size_t) number_of_items > ( (size_t) ( SSIZE_MAX - LIBEWF_COMPRESSION_CONTEXT_BZIP2_ALLOCATION_HEADER_SIZE ) / (size_t) item_size ) ) )
+	{
+		return( NULL );
+	}
+	compression_context = (libewf_compression_context_t *) opaque;
+
+	allocation_size = (size_t) number_of_items * (size_t) item_size;
+
+	for( allocation_index = 0;
+	     allocation_index < compression_context->number_of_bzip2_allocations;
+	     allocation_index++ )
+	{
+		allocation = (uint8_t *) compression_context->bzip2_allocations[ allocation_index ];
+
+		if( *( (size_t *) allocation ) == allocation_size )
+		{
+			compression_context->number_of_bzip2_allocations -= 1;
+
+			compression_context->bzip2_allocations[ allocation_index ] = compression_context->bzip2_allocations[ compression_context->number_of_bzip2_allocations ];
+
+			return( &( allocation[ LIBEWF_COMPRESSION_CONTEXT_BZIP2_ALLOCATION_HEADER_SIZE ] ) );
+		}
+	}
+	allocation = (uint8_t *) memory_allocate(
+	                          LIBEWF_COMPRESSION_CONTEXT_BZIP2_ALLOCATION_HEADER_SIZE + allocation_size );
+
+	if( allocation == NULL )
+	{
+		return( NULL );
+	}
+	*( (size_t *) allocation ) = allocation_size;
+
+	return( &( allocation[ LIBEWF_COMPRESSION_CONTEXT_BZIP2_ALLOCATION_HEADER_SIZE ] ) );
+}
+
+/* Frees memory for bzip2
+ * The allocation is retained for reuse if possible
+ * Callback function for the bzip2 stream
+ */
+void libewf_compression_context_bzip2_free(
+      void *opaque,
+      void *data )
+{
+	libewf_compression_context_t *compression_context = NULL;
+	uint8_t *allocation                               = NULL;
+
+	if( data == NULL )
+	{
+		return;
+	}
+	compression_context = (libewf_compression_context_t *) opaque;
+
+	allocation = &( ( (uint8_t *) data )[ -LIBEWF_COMPRESSION_CONTEXT_BZIP2_ALLOCATION_HEADER_SIZE ] );
+
+	if( ( compression_context != NULL )
+	 && ( compression_context->number_of_bzip2_allocations < LIBEWF_COMPRESSION_CONTEXT_MAXIMUM_NUMBER_OF_BZIP2_ALLOCATIONS ) )
+	{
+		compression_context->bzip2_allocations[ compression_context->number_of_bzip2_allocations ] = allocation;
+
+		compression_context->number_of_bzip2_allocations += 1;
+	}
+	else
+	{
+		memory_free(
+		 allocation );
+	}
+}
+
+/* Compresses data using bzip2
+ * Behaves as BZ2_bzBuffToBuffCompress but retains the allocations of the stream in the compression context,
+ * BZ2_bzBuffToBuffCompress is used if no compression context is provided
+ * Returns a bzip2 return value
+ */
+int libewf_compression_context_bzip2_compress(
+     libewf_compression_context_t *compression_context,
+     char *compressed_data,
+     unsigned int *compressed_data_size,
+     char *uncompressed_data,
+     unsigned int uncompressed_data_size,
+     int compression_level )
+{
+	bz_stream stream;
+
+	int result = 0;
+
+	if( compression_context == NULL )
+	{
+		return( BZ2_bzBuffToBuffCompress(
+		         compressed_data,
+		         compressed_data_size,
+		         uncompressed_data,
+		         uncompressed_data_size,
+		         compression_level,
+		         0,
+		         30 ) );
+	}
+	memory_set(
+	 &stream,
+	 0,
+	 sizeof( bz_stream ) );
+
+	stream.bzalloc = &libewf_compression_context_bzip2_allocate;
+	stream.bzfree  = &libewf_compression_context_bzip2_free;
+	stream.opaque  = compression_context;
+
+	result = BZ2_bzCompressInit(
+	          &stream,
+	          compression_level,
+	          0,
+	          30 );
+
+	if( result != BZ_OK )
+	{
+		return( result );
+	}
+	stream.next_in   = uncompressed_data;
+	stream.avail_in  = uncompressed_data_size;
+	stream.next_out  = compressed_data;
+	stream.avail_out = *compressed_data_size;
+
+	result = BZ2_bzCompress(
+	          &stream,
+	          BZ_FINISH );
+
+	if( result == BZ_STREAM_END )
+	{
+		*compressed_data_size = stream.total_out_lo32;
+
+		result = BZ_OK;
+	}
+	else if( result == BZ_FINISH_OK )
+	{
+		/* The compressed data did not fit in the buffer
+		 */
+		result = BZ_OUTBUFF_FULL;
+	}
+	BZ2_bzCompressEnd(
+	 &stream );
+
+	return( result );
+}
+
+/* Decompresses data using bzip2
+ * Behaves as BZ2_bzBuffToBuffDecompress but retains the allocations of the stream in the compression context,
+ * BZ2_bzBuffToBuffDecompress is used if no compression context is provided
+ * Returns a bzip2 return value
+ */
+int libewf_compression_context_bzip2_decompress(
+     libewf_compression_context_t *compression_context,
+     char *uncompressed_data,
+     unsigned int *uncompressed_data_size,
+     char *compressed_data,
+     unsigned int compressed_data_size )
+{
+	bz_stream stream;
+
+	int result = 0;
+
+	if( compression_context == NULL )
+	{
+		return( BZ2_bzBuffToBuffDecompress(
+		         uncompressed_data,
+		         uncompressed_data_size,
+		         compressed_data,
+		         compressed_data_size,
+		         0,
+		         0 ) );
+	}
+	memory_set(
+	 &stream,
+	 0,
+	 sizeof( bz_stream ) );
+
+	stream.bzalloc = &libewf_compression_context_bzip2_allocate;
+	stream.bzfree  = &libewf_compression_context_bzip2_free;
+	stream.opaque  = compression_context;
+
+	result = BZ2_bzDecompressInit(
+	          &stream,
+	          0,
+	          0 );
+
+	if( result != BZ_OK )
+	{
+		return( result );
+	}
+	stream.next_in   = compressed_data;
+	stream.avail_in  = compressed_data_size;
+	stream.next_out  = uncompressed_data;
+	stream.avail_out = *uncompressed_data_size;
+
+	result = BZ2_bzDecompress(
+	          &stream );
+
+	if( result == BZ_STREAM_END )
+	{
+		*uncompressed_data_size = stream.total_out_lo32;
+
+		result = BZ_OK;
+	}
+	else if( result == BZ_OK )
+	{
+		/* If the buffer was not filled the compressed data is truncated
+		 */
+		if( stream.avail_out == 0 )
+		{
+			result = BZ_OUTBUFF_FULL;
+		}
+		else
+		{
+			result = BZ_UNEXPECTED_EOF;
+		}
+	}
+	BZ2_bzDecompressEnd(
+	 &stream );
+
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL ) */
+
@@ -0,0 +1,205 @@
+/*
+ * Compression context functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_COMPRESSION_CONTEXT_H )
+#define _LIBEWF_COMPRESSION_CONTEXT_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
+#include <bzlib.h>
+#endif
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#if defined( HAVE_LIBDEFLATE )
+#include <libdeflate.h>
+#endif
+
+#if defined( HAVE_LIBISAL )
+#include <isa-l.h>
+#endif
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* The compression contexts are kept per thread, which requires thread-specific storage
+ */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) && defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#define HAVE_LIBEWF_COMPRESSION_CONTEXT	1
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of bzip2 allocations retained by a compression context
+ */
+#define LIBEWF_COMPRESSION_CONTEXT_MAXIMUM_NUMBER_OF_BZIP2_ALLOCATIONS	8
+
+typedef struct libewf_compression_context libewf_compression_context_t;
+
+struct libewf_compression_context
+{
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	/* The zlib deflate stream
+	 */
+	z_stream deflate_stream;
+
+	/* The zlib compression level of the deflate stream
+	 */
+	int deflate_stream_level;
+
+	/* Value to indicate the deflate stream was initialized
+	 */
+	uint8_t deflate_stream_initialized;
+
+	/* The zlib inflate stream
+	 */
+	z_stream inflate_stream;
+
+	/* Value to indicate the inflate stream was initialized
+	 */
+	uint8_t inflate_stream_initialized;
+#endif
+
+#if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
+	/* The bzip2 allocations that are retained for reuse
+	 */
+	void *bzip2_allocations[ LIBEWF_COMPRESSION_CONTEXT_MAXIMUM_NUMBER_OF_BZIP2_ALLOCATIONS ];
+
+	/* The number of bzip2 allocations that are retained for reuse
+	 */
+	int number_of_bzip2_allocations;
+#endif
+
+#if defined( HAVE_LIBDEFLATE )
+	/* The libdeflate compressor
+	 */
+	struct libdeflate_compressor *libdeflate_compressor;
+
+	/* The libdeflate compression level of the compressor
+	 */
+	int libdeflate_compressor_level;
+
+	/* The libdeflate decompressor
+	 */
+	struct libdeflate_decompressor *libdeflate_decompressor;
+#endif
+
+#if defined( HAVE_LIBISAL )
+	/* The ISA-L deflate level buffer
+	 */
+	uint8_t *isal_level_buffer;
+
+	/* The ISA-L deflate level buffer size
+	 */
+	uint32_t isal_level_buffer_size;
+
+	/* The ISA-L inflate state
+	 */
+	struct inflate_state *isal_inflate_state;
+#endif
+
+	/* Dummy value to prevent an empty structure
+	 */
+	int dummy;
+};
+
+int libewf_compression_context_initialize(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_compression_context_free(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_COMPRESSION_CONTEXT )
+
+int libewf_compression_context_get_thread_context(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_compression_context_finalize(
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_COMPRESSION_CONTEXT ) */
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+
+int libewf_compression_context_zlib_compress(
+     libewf_compression_context_t *compression_context,
+     Bytef *compressed_data,
+     uLongf *compressed_data_size,
+     const Bytef *uncompressed_data,
+     uLong uncompressed_data_size,
+     int compression_level );
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+
+int libewf_compression_context_zlib_uncompress(
+     libewf_compression_context_t *compression_context,
+     Bytef *uncompressed_data,
+     uLongf *uncompressed_data_size,
+     const Bytef *compressed_data,
+     uLong compressed_data_size );
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) */
+
+#if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
+
+void *libewf_compression_context_bzip2_allocate(
+       void *opaque,
+       int number_of_items,
+       int item_size );
+
+void libewf_compression_context_bzip2_free(
+      void *opaque,
+      void *data );
+
+int libewf_compression_context_bzip2_compress(
+     libewf_compression_context_t *compression_context,
+     char *compressed_data,
+     unsigned int *compressed_data_size,
+     char *uncompressed_data,
+     unsigned int uncompressed_data_size,
+     int compression_level );
+
+int libewf_compression_context_bzip2_decompress(
+     libewf_compression_context_t *compression_context,
+     char *uncompressed_data,
+     unsigned int *uncompressed_data_size,
+     char *compressed_data,
+     unsigned int compressed_data_size );
+
+#endif /* defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_COMPRESSION_CONTEXT_H ) */
+
@@ -439,6 +439,7 @@ ssize_t libewf_data_chunk_write_buffer(
 	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
 	static char *function                             = "libewf_data_chunk_write_buffer";
 	ssize_t write_count                               = 0;
+	int8_t compression_level                          = 0;
 
 	if( data_chunk == NULL )
 	{
@@ -506,9 +507,13 @@ ssize_t libewf_data_chunk_write_buffer(
 			goto on_error;
 		}
 	}
+	/* The chunk data is not bound to the buffer pool of the handle
+	 * since the data chunk can outlive the handle
+	 */
 	if( libewf_chunk_data_initialize(
 	     &( internal_data_chunk->chunk_data ),
 	     internal_data_chunk->io_handle->chunk_size,
+	     NULL,
 	     0,
 	     error ) != 1 )
 	{
@@ -540,9 +545,18 @@ ssize_t libewf_data_chunk_write_buffer(
 	}
 	internal_data_chunk->data_size = buffer_size;
 
+	if( internal_data_chunk->compression_level_is_set != 0 )
+	{
+		compression_level = internal_data_chunk->compression_level;
+	}
+	else
+	{
+		compression_level = internal_data_chunk->io_handle->compression_level;
+	}
 	if( libewf_chunk_data_pack(
 	     internal_data_chunk->chunk_data,
 	     internal_data_chunk->io_handle,
+	     compression_level,
 	     internal_data_chunk->write_io_handle->compressed_zero_byte_empty_block,
 	     internal_data_chunk->write_io_handle->compressed_zero_byte_empty_block_size,
 	     internal_data_chunk->write_io_handle->pack_flags,
@@ -584,3 +598,77 @@ on_error:
 	return( -1 );
 }
 
+/* Sets the compression level used to pack the data chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_data_chunk_set_compression_level(
+     libewf_data_chunk_t *data_chunk,
+     int8_t compression_level,
+     libcerror_error_t **error )
+{
+	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
+	static char *function                             = "libewf_data_chunk_set_compression_level";
+
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_chunk = (libewf_internal_data_chunk_t *) data_chunk;
+
+	if( ( compression_level != LIBEWF_COMPRESSION_DEFAULT )
+	 && ( compression_level != LIBEWF_COMPRESSION_NONE )
+	 && ( compression_level != LIBEWF_COMPRESSION_FAST )
+	 && ( compression_level != LIBEWF_COMPRESSION_BEST ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_data_chunk->compression_level        = compression_level;
+	internal_data_chunk->compression_level_is_set = 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
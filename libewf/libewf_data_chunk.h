@@ -61,6 +61,14 @@ struct libewf_internal_data_chunk
 	 */
 	libewf_chunk_data_t *chunk_data;
 
+	/* The compression level used to pack the chunk data
+	 */
+	int8_t compression_level;
+
+	/* Value to indicate the compression level was set
+	 */
+	uint8_t compression_level_is_set;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -99,6 +107,12 @@ ssize_t libewf_data_chunk_write_buffer(
          size_t buffer_size,
          libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_data_chunk_set_compression_level(
+     libewf_data_chunk_t *data_chunk,
+     int8_t compression_level,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -24,9 +24,98 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_checksum.h"
 #include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 
+/* Fills the bit buffer from the byte stream
+ * The bit buffer is filled with whole bytes upto 64 bits or until the end of the byte stream
+ * Returns 1 on success or -1 on error
+ */
+int libewf_deflate_bit_stream_fill_bit_buffer(
+     libewf_deflate_bit_stream_t *bit_stream,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_deflate_bit_stream_fill_bit_buffer";
+	uint64_t value_64bit  = 0;
+	uint8_t read_count    = 0;
+
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( bit_stream->bit_buffer_size > 56 )
+	{
+		return( 1 );
+	}
+	if( ( bit_stream->byte_stream_size - bit_stream->byte_stream_offset ) >= 8 )
+	{
+		/* Read 8 bytes at once and only keep the whole bytes that fit in the bit buffer
+		 */
+		byte_stream_copy_to_uint64_little_endian(
+		 &( bit_stream->byte_stream[ bit_stream->byte_stream_offset ] ),
+		 value_64bit );
+
+		read_count = ( 64 - bit_stream->bit_buffer_size ) / 8;
+
+		if( read_count < 8 )
+		{
+			value_64bit &= ( (uint64_t) 1 << ( read_count * 8 ) ) - 1;
+		}
+		bit_stream->bit_buffer         |= value_64bit << bit_stream->bit_buffer_size;
+		bit_stream->bit_buffer_size    += read_count * 8;
+		bit_stream->byte_stream_offset += read_count;
+	}
+	else
+	{
+		while( ( bit_stream->bit_buffer_size <= 56 )
+		    && ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size ) )
+		{
+			value_64bit = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
+
+			bit_stream->bit_buffer      |= value_64bit << bit_stream->bit_buffer_size;
+			bit_stream->bit_buffer_size += 8;
+		}
+	}
+	return( 1 );
+}
+
+/* Aligns the bit stream to the next byte
+ * The bits remaining of the current byte are discarded and the whole bytes
+ * remaining in the bit buffer are returned to the byte stream
+ * Returns 1 on success or -1 on error
+ */
+int libewf_deflate_bit_stream_align_to_byte(
+     libewf_deflate_bit_stream_t *bit_stream,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_deflate_bit_stream_align_to_byte";
+
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	bit_stream->byte_stream_offset -= bit_stream->bit_buffer_size / 8;
+	bit_stream->bit_buffer          = 0;
+	bit_stream->bit_buffer_size     = 0;
+
+	return( 1 );
+}
+
 /* Retrieves a value from the bit stream
  * Returns 1 on success or -1 on error
  */
@@ -77,9 +166,22 @@ int libewf_deflate_bit_stream_get_value(
 
 		return( 1 );
 	}
-	while( bit_stream->bit_buffer_size < number_of_bits )
+	if( bit_stream->bit_buffer_size < number_of_bits )
 	{
-		if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
+		if( libewf_deflate_bit_stream_fill_bit_buffer(
+		     bit_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill bit buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( bit_stream->bit_buffer_size < number_of_bits )
 		{
 			libcerror_error_set(
 			 error,
@@ -90,13 +192,8 @@ int libewf_deflate_bit_stream_get_value(
 
 			return( -1 );
 		}
-		*value_32bit   = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
-		*value_32bit <<= bit_stream->bit_buffer_size;
-
-		bit_stream->bit_buffer      |= *value_32bit;
-		bit_stream->bit_buffer_size += 8;
 	}
-	*value_32bit = bit_stream->bit_buffer & ~( -1L << number_of_bits );
+	*value_32bit = (uint32_t) ( bit_stream->bit_buffer & ( ( (uint64_t) 1 << number_of_bits ) - 1 ) );
 
 	bit_stream->bit_buffer     >>= number_of_bits;
 	bit_stream->bit_buffer_size -= number_of_bits;
@@ -105,22 +202,40 @@ int libewf_deflate_bit_stream_get_value(
 }
 
 /* Constructs the Huffman table
+ * The lookup table is constructed from the canonical Huffman codes where the codes
+ * are stored in reversed bit order, since the bit stream is read least significant bit first
+ * Codes that are larger than the number of lookup bits are stored in sub tables
  * Returns 1 on success, 0 if the table is empty or -1 on error
  */
 int libewf_deflate_huffman_table_construct(
      libewf_deflate_huffman_table_t *table,
      const uint16_t *code_sizes_array,
      int number_of_code_sizes,
+     uint8_t number_of_lookup_bits,
      libcerror_error_t **error )
 {
+	int code_counts_array[ 16 ];
 	int code_offsets_array[ 16 ];
-
-	static char *function = "libewf_deflate_huffman_table_construct";
-	uint16_t code_size    = 0;
-	uint8_t bit_index     = 0;
-	int code_offset       = 0;
-	int left_value        = 0;
-	int symbol            = 0;
+	uint16_t symbols_array[ 320 ];
+
+	static char *function           = "libewf_deflate_huffman_table_construct";
+	uint32_t fill_index             = 0;
+	uint32_t huffman_code           = 0;
+	uint32_t increment              = 0;
+	uint32_t lookup_mask            = 0;
+	uint32_t low_index              = 0;
+	uint32_t number_of_entries_used = 0;
+	uint32_t table_entry            = 0;
+	uint32_t table_offset           = 0;
+	uint32_t table_size             = 0;
+	uint16_t code_size              = 0;
+	uint8_t bit_index               = 0;
+	uint8_t drop_bits               = 0;
+	uint8_t minimum_number_of_bits  = 0;
+	uint8_t sub_table_bits          = 0;
+	int left_value                  = 0;
+	int symbol                      = 0;
+	int symbol_index                = 0;
 
 	if( table == NULL )
 	{
@@ -144,7 +259,8 @@ int libewf_deflate_huffman_table_construct(
 
 		return( -1 );
 	}
-	if( number_of_code_sizes < 0 )
+	if( ( number_of_code_sizes < 0 )
+	 || ( number_of_code_sizes > 320 ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -155,38 +271,20 @@ int libewf_deflate_huffman_table_construct(
 
 		return( -1 );
 	}
-/* TODO hardcoded for now */
-	table->maximum_number_of_bits = 15;
-
-	if( table->maximum_number_of_bits > 15 )
+	if( ( number_of_lookup_bits == 0 )
+	 || ( number_of_lookup_bits > 15 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid table - number of bits values out of bounds.",
-		 function );
-
-		return( -1 );
-	}
-	table->number_of_codes = (int) table->maximum_number_of_bits + 1;
-
-	if( memory_set(
-	     &( table->codes_array ),
-	     0,
-	     288 * sizeof( int ) ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear code counts array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of lookup bits value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
 	if( memory_set(
-	     &( table->code_counts_array ),
+	     code_counts_array,
 	     0,
 	     16 * sizeof( int ) ) == NULL )
 	{
@@ -205,7 +303,7 @@ int libewf_deflate_huffman_table_construct(
 	{
 		code_size = code_sizes_array[ symbol ];
 
-		if( code_size > table->number_of_codes )
+		if( code_size > 15 )
 		{
 			libcerror_error_set(
 			 error,
@@ -218,24 +316,46 @@ int libewf_deflate_huffman_table_construct(
 
 			return( -1 );
 		}
-		table->code_counts_array[ code_size ] += 1;
+		code_counts_array[ code_size ] += 1;
 	}
 	/* The table has no codes
 	 */
-	if( table->code_counts_array[ 0 ] == number_of_code_sizes )
+	if( code_counts_array[ 0 ] == number_of_code_sizes )
 	{
 		return( 0 );
 	}
+	table->maximum_number_of_bits = 15;
+
+	while( code_counts_array[ table->maximum_number_of_bits ] == 0 )
+	{
+		table->maximum_number_of_bits--;
+	}
+	minimum_number_of_bits = 1;
+
+	while( code_counts_array[ minimum_number_of_bits ] == 0 )
+	{
+		minimum_number_of_bits++;
+	}
+	if( number_of_lookup_bits > table->maximum_number_of_bits )
+	{
+		number_of_lookup_bits = table->maximum_number_of_bits;
+	}
+	if( number_of_lookup_bits < minimum_number_of_bits )
+	{
+		number_of_lookup_bits = minimum_number_of_bits;
+	}
+	table->number_of_lookup_bits = number_of_lookup_bits;
+
 	/* Check if the set of code sizes is incomplete or over-subscribed
 	 */
 	left_value = 1;
 
 	for( bit_index = 1;
-	     bit_index <= table->maximum_number_of_bits;
+	     bit_index <= 15;
 	     bit_index++ )
 	{
 		left_value <<= 1;
-		left_value  -= table->code_counts_array[ bit_index ];
+		left_value  -= code_counts_array[ bit_index ];
 
 		if( left_value < 0 )
 		{
@@ -249,17 +369,31 @@ int libewf_deflate_huffman_table_construct(
 			return( -1 );
 		}
 	}
+	/* An incomplete set of code sizes is only allowed for a single code of 1 bit
+	 */
+	if( ( left_value > 0 )
+	 && ( table->maximum_number_of_bits != 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: code sizes are incomplete.",
+		 function );
+
+		return( -1 );
+	}
 	/* Calculate the offsets for sorting the symbol table
 	 */
 	code_offsets_array[ 0 ] = 0;
 	code_offsets_array[ 1 ] = 0;
 
 	for( bit_index = 1;
-	     bit_index < table->maximum_number_of_bits;
+	     bit_index < 15;
 	     bit_index++ )
 	{
 		code_offsets_array[ bit_index + 1 ] = code_offsets_array[ bit_index ]
-		                                    + table->code_counts_array[ bit_index ];
+		                                    + code_counts_array[ bit_index ];
 	}
 	for( symbol = 0;
 	     symbol < number_of_code_sizes;
@@ -267,42 +401,130 @@ int libewf_deflate_huffman_table_construct(
 	{
 		code_size = code_sizes_array[ symbol ];
 
-		if( code_size == 0 )
+		if( code_size != 0 )
 		{
-			continue;
+			symbols_array[ code_offsets_array[ code_size ]++ ] = (uint16_t) symbol;
 		}
-		code_offset = code_offsets_array[ code_size ];
-
-		if( ( code_offset < 0 )
-		 || ( code_offset > number_of_code_sizes ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid symbol: %d code offset: %d value out of bounds.",
-			 function,
-			 symbol,
-			 code_offset );
-
-			return( -1 );
-		}
-		code_offsets_array[ code_size ]  += 1;
-		table->codes_array[ code_offset ] = symbol;
 	}
-/* TODO only used by dynamic Huffman
-	if( left_value > 0 )
+	number_of_entries_used = (uint32_t) 1 << number_of_lookup_bits;
+	lookup_mask            = number_of_entries_used - 1;
+	low_index              = (uint32_t) -1;
+	code_size              = minimum_number_of_bits;
+	sub_table_bits         = number_of_lookup_bits;
+
+	/* Clear the primary lookup table so that the entries of an incomplete set of codes are invalid
+	 */
+	if( memory_set(
+	     table->lookup_table,
+	     0,
+	     sizeof( uint32_t ) * number_of_entries_used ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: code sizes are incomplete.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear lookup table.",
 		 function );
 
 		return( -1 );
 	}
-*/
+	for( symbol_index = 0;
+	     symbol_index < number_of_code_sizes;
+	     symbol_index++ )
+	{
+		table_entry = (uint32_t) symbols_array[ symbol_index ]
+		            | ( (uint32_t) ( code_size - drop_bits ) << 16 )
+		            | ( (uint32_t) LIBEWF_DEFLATE_HUFFMAN_TABLE_ENTRY_FLAG_IS_SYMBOL << 24 );
+
+		/* Fill all the entries of the current table that start with the code
+		 */
+		increment  = (uint32_t) 1 << ( code_size - drop_bits );
+		table_size = (uint32_t) 1 << sub_table_bits;
+		fill_index = table_size;
+
+		do
+		{
+			fill_index -= increment;
+
+			table->lookup_table[ table_offset + ( huffman_code >> drop_bits ) + fill_index ] = table_entry;
+		}
+		while( fill_index != 0 );
+
+		/* Determine the next code in reversed bit order
+		 */
+		increment = (uint32_t) 1 << ( code_size - 1 );
+
+		while( ( huffman_code & increment ) != 0 )
+		{
+			increment >>= 1;
+		}
+		if( increment != 0 )
+		{
+			huffman_code &= increment - 1;
+			huffman_code += increment;
+		}
+		else
+		{
+			huffman_code = 0;
+		}
+		code_counts_array[ code_size ] -= 1;
+
+		if( code_counts_array[ code_size ] == 0 )
+		{
+			if( code_size == table->maximum_number_of_bits )
+			{
+				break;
+			}
+			code_size = code_sizes_array[ symbols_array[ symbol_index + 1 ] ];
+		}
+		/* Create a new sub table when the code does not fit in the primary lookup table
+		 * and the first number of lookup bits differ from the previous sub table
+		 */
+		if( ( code_size > number_of_lookup_bits )
+		 && ( ( huffman_code & lookup_mask ) != low_index ) )
+		{
+			if( drop_bits == 0 )
+			{
+				drop_bits = number_of_lookup_bits;
+			}
+			table_offset  += table_size;
+			sub_table_bits = (uint8_t) ( code_size - drop_bits );
+			left_value     = 1 << sub_table_bits;
+
+			/* Determine the number of bits of the sub table from the remaining codes
+			 */
+			while( ( sub_table_bits + drop_bits ) < table->maximum_number_of_bits )
+			{
+				left_value -= code_counts_array[ sub_table_bits + drop_bits ];
+
+				if( left_value <= 0 )
+				{
+					break;
+				}
+				sub_table_bits++;
+
+				left_value <<= 1;
+			}
+			number_of_entries_used += (uint32_t) 1 << sub_table_bits;
+
+			if( number_of_entries_used > LIBEWF_DEFLATE_HUFFMAN_TABLE_MAXIMUM_NUMBER_OF_ENTRIES )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid number of lookup table entries value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			low_index = huffman_code & lookup_mask;
+
+			table->lookup_table[ low_index ] = table_offset
+			                                 | ( (uint32_t) sub_table_bits << 16 )
+			                                 | ( (uint32_t) LIBEWF_DEFLATE_HUFFMAN_TABLE_ENTRY_FLAG_IS_SUB_TABLE << 24 );
+		}
+	}
 	return( 1 );
 }
 
@@ -316,14 +538,9 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
      libcerror_error_t **error )
 {
 	static char *function  = "libewf_deflate_bit_stream_get_huffman_encoded_value";
-	uint32_t bit_buffer    = 0;
-	uint8_t bit_index      = 0;
+	uint32_t table_entry   = 0;
+	uint8_t entry_flags    = 0;
 	uint8_t number_of_bits = 0;
-	int code_size_count    = 0;
-	int first_huffman_code = 0;
-	int first_index        = 0;
-	int huffman_code       = 0;
-	int result             = 0;
 
 	if( bit_stream == NULL )
 	{
@@ -360,56 +577,63 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
 	}
 	/* Try to fill the bit buffer with the maximum number of bits
 	 */
-	while( bit_stream->bit_buffer_size < table->maximum_number_of_bits )
+	if( bit_stream->bit_buffer_size < table->maximum_number_of_bits )
 	{
-		if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
+		if( libewf_deflate_bit_stream_fill_bit_buffer(
+		     bit_stream,
+		     error ) != 1 )
 		{
-			break;
-		}
-		*value_32bit   = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
-		*value_32bit <<= bit_stream->bit_buffer_size;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill bit buffer.",
+			 function );
 
-		bit_stream->bit_buffer      |= *value_32bit;
-		bit_stream->bit_buffer_size += 8;
+			return( -1 );
+		}
 	}
-	if( table->maximum_number_of_bits < bit_stream->bit_buffer_size )
+	table_entry = table->lookup_table[ bit_stream->bit_buffer & ( ( (uint64_t) 1 << table->number_of_lookup_bits ) - 1 ) ];
+
+	number_of_bits = (uint8_t) ( table_entry >> 16 );
+	entry_flags    = (uint8_t) ( table_entry >> 24 );
+
+	if( ( entry_flags & LIBEWF_DEFLATE_HUFFMAN_TABLE_ENTRY_FLAG_IS_SUB_TABLE ) != 0 )
 	{
-		number_of_bits = table->maximum_number_of_bits;
+		table_entry = table->lookup_table[ ( table_entry & 0x0000ffffUL )
+		                                 + (uint32_t) ( ( bit_stream->bit_buffer >> table->number_of_lookup_bits ) & ( ( (uint64_t) 1 << number_of_bits ) - 1 ) ) ];
+
+		number_of_bits = table->number_of_lookup_bits + (uint8_t) ( table_entry >> 16 );
+		entry_flags    = (uint8_t) ( table_entry >> 24 );
 	}
-	else
+	if( ( entry_flags & LIBEWF_DEFLATE_HUFFMAN_TABLE_ENTRY_FLAG_IS_SYMBOL ) == 0 )
 	{
-		number_of_bits = bit_stream->bit_buffer_size;
-	}
-	bit_buffer = bit_stream->bit_buffer;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid Huffman code.",
+		 function );
 
-	for( bit_index = 1;
-	     bit_index <= number_of_bits;
-	     bit_index++ )
+		return( -1 );
+	}
+	if( number_of_bits > bit_stream->bit_buffer_size )
 	{
-		huffman_code <<= 1;
-		huffman_code  |= (int) bit_buffer & 0x00000001UL;
-		bit_buffer   >>= 1;
-
-		code_size_count = table->code_counts_array[ bit_index ];
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid byte stream value to small.",
+		 function );
 
-		if( ( huffman_code - code_size_count ) < first_huffman_code )
-		{
-			*value_32bit = table->codes_array[ first_index + ( huffman_code - first_huffman_code ) ];
+		return( -1 );
+	}
+	*value_32bit = table_entry & 0x0000ffffUL;
 
-			result = 1;
+	bit_stream->bit_buffer     >>= number_of_bits;
+	bit_stream->bit_buffer_size -= number_of_bits;
 
-			break;
-		}
-		first_huffman_code  += code_size_count;
-		first_huffman_code <<= 1;
-		first_index         += code_size_count;
-	}
-	if( result != 0 )
-	{
-		bit_stream->bit_buffer     >>= bit_index;
-		bit_stream->bit_buffer_size -= bit_index;
-	}
-	return( result );
+	return( 1 );
 }
 
 /* Initializes the dynamic Huffman tables
@@ -520,6 +744,7 @@ int libewf_deflate_initialize_dynamic_huffman_tables(
 	     &codes_table,
 	     code_size_array,
 	     19,
+	     7,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -674,6 +899,7 @@ int libewf_deflate_initialize_dynamic_huffman_tables(
 	     literals_table,
 	     code_size_array,
 	     number_of_literal_codes,
+	     LIBEWF_DEFLATE_LITERALS_TABLE_NUMBER_OF_LOOKUP_BITS,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -689,6 +915,7 @@ int libewf_deflate_initialize_dynamic_huffman_tables(
 	     distances_table,
 	     &( code_size_array[ number_of_literal_codes ] ),
 	     number_of_distance_codes,
+	     LIBEWF_DEFLATE_DISTANCES_TABLE_NUMBER_OF_LOOKUP_BITS,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -711,13 +938,13 @@ int libewf_deflate_initialize_fixed_huffman_tables(
      libewf_deflate_huffman_table_t *distances_table,
      libcerror_error_t **error )
 {
-	uint16_t code_size_array[ 318 ];
+	uint16_t code_size_array[ 320 ];
 
 	static char *function = "libewf_deflate_initialize_fixed_huffman_tables";
 	uint16_t symbol       = 0;
 
 	for( symbol = 0;
-	     symbol < 318;
+	     symbol < 320;
 	     symbol++ )
 	{
 		if( symbol < 144 )
@@ -741,10 +968,14 @@ int libewf_deflate_initialize_fixed_huffman_tables(
 			code_size_array[ symbol ] = 5;
 		}
 	}
+	/* The fixed distances table contains 32 codes of which the distance codes 30 and 31 are not used,
+	 * so that the set of codes is complete
+	 */
 	if( libewf_deflate_huffman_table_construct(
 	     literals_table,
 	     code_size_array,
 	     288,
+	     LIBEWF_DEFLATE_LITERALS_TABLE_NUMBER_OF_LOOKUP_BITS,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -759,7 +990,8 @@ int libewf_deflate_initialize_fixed_huffman_tables(
 	if( libewf_deflate_huffman_table_construct(
 	     distances_table,
 	     &( code_size_array[ 288 ] ),
-	     30,
+	     32,
+	     LIBEWF_DEFLATE_DISTANCES_TABLE_NUMBER_OF_LOOKUP_BITS,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -809,6 +1041,7 @@ int libewf_deflate_decode_huffman(
 	uint32_t extra_bits           = 0;
 	uint16_t compression_offset   = 0;
 	uint16_t compression_size     = 0;
+	uint16_t copy_size            = 0;
 	uint16_t number_of_extra_bits = 0;
 
 	if( uncompressed_data == NULL )
@@ -917,6 +1150,18 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
+			if( code_value >= 30 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid distance code value: %" PRIu32 " out of bounds.",
+				 function,
+				 code_value );
+
+				return( -1 );
+			}
 			number_of_extra_bits = distance_codes_number_of_extra_bits[ code_value ];
 
 			if( libewf_deflate_bit_stream_get_value(
@@ -958,12 +1203,54 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
-			while( compression_size > 0 )
+			/* A compression offset smaller than the compression size refers to data that is
+			 * being copied, hence the data can only be copied in blocks of compression offset
+			 */
+			if( compression_offset == 1 )
+			{
+				if( memory_set(
+				     &( uncompressed_data[ data_offset ] ),
+				     uncompressed_data[ data_offset - 1 ],
+				     (size_t) compression_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to set uncompressed data.",
+					 function );
+
+					return( -1 );
+				}
+				data_offset += compression_size;
+			}
+			else
 			{
-				uncompressed_data[ data_offset ] = uncompressed_data[ data_offset - compression_offset ];
+				while( compression_size > 0 )
+				{
+					copy_size = compression_offset;
+
+					if( copy_size > compression_size )
+					{
+						copy_size = compression_size;
+					}
+					if( memory_copy(
+					     &( uncompressed_data[ data_offset ] ),
+					     &( uncompressed_data[ data_offset - compression_offset ] ),
+					     (size_t) copy_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+						 "%s: unable to copy uncompressed data.",
+						 function );
 
-				data_offset++;
-				compression_size--;
+						return( -1 );
+					}
+					data_offset      += copy_size;
+					compression_size -= copy_size;
+				}
 			}
 		}
 		else if( code_value != 256 )
@@ -998,239 +1285,23 @@ int libewf_deflate_calculate_adler32(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_deflate_calculate_adler32";
-	size_t buffer_offset  = 0;
-	uint32_t lower_word   = 0;
-	uint32_t upper_word   = 0;
-	uint32_t value_32bit  = 0;
-	int block_index       = 0;
-
-	if( checksum_value == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid checksum value.",
-		 function );
 
-		return( -1 );
-	}
-	if( buffer == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
-
-		return( -1 );
-	}
-	if( size > (size_t) SSIZE_MAX )
+	if( libewf_checksum_calculate_adler32(
+	     checksum_value,
+	     buffer,
+	     size,
+	     initial_value,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate Adler-32.",
 		 function );
 
 		return( -1 );
 	}
-	lower_word = initial_value & 0xffff;
-	upper_word = ( initial_value >> 16 ) & 0xffff;
-
-	while( size >= 0x15b0 )
-	{
-		/* The modulo calculation is needed per 5552 (0x15b0) bytes
-		 * 5552 / 16 = 347
-		 */
-		for( block_index = 0;
-		     block_index < 347;
-		     block_index++ )
-		{
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-		}
-		/* Optimized equivalent of:
-		 * lower_word %= 0xfff1
-		 */
-		value_32bit = lower_word >> 16;
-		lower_word &= 0x0000ffffUL;
-		lower_word += ( value_32bit << 4 ) - value_32bit;
-
-		if( lower_word > 65521 )
-		{
-			value_32bit = lower_word >> 16;
-			lower_word &= 0x0000ffffUL;
-			lower_word += ( value_32bit << 4 ) - value_32bit;
-		}
-		if( lower_word >= 65521 )
-		{
-			lower_word -= 65521;
-		}
-		/* Optimized equivalent of:
-		 * upper_word %= 0xfff1
-		 */
-		value_32bit = upper_word >> 16;
-		upper_word &= 0x0000ffffUL;
-		upper_word += ( value_32bit << 4 ) - value_32bit;
-
-		if( upper_word > 65521 )
-		{
-			value_32bit = upper_word >> 16;
-			upper_word &= 0x0000ffffUL;
-			upper_word += ( value_32bit << 4 ) - value_32bit;
-		}
-		if( upper_word >= 65521 )
-		{
-			upper_word -= 65521;
-		}
-		size -= 0x15b0;
-	}
-	if( size > 0 )
-	{
-		while( size > 16 )
-		{
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			size -= 16;
-		}
-		while( size > 0 )
-		{
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			size--;
-		}
-		/* Optimized equivalent of:
-		 * lower_word %= 0xfff1
-		 */
-		value_32bit = lower_word >> 16;
-		lower_word &= 0x0000ffffUL;
-		lower_word += ( value_32bit << 4 ) - value_32bit;
-
-		if( lower_word > 65521 )
-		{
-			value_32bit = lower_word >> 16;
-			lower_word &= 0x0000ffffUL;
-			lower_word += ( value_32bit << 4 ) - value_32bit;
-		}
-		if( lower_word >= 65521 )
-		{
-			lower_word -= 65521;
-		}
-		/* Optimized equivalent of:
-		 * upper_word %= 0xfff1
-		 */
-		value_32bit = upper_word >> 16;
-		upper_word &= 0x0000ffffUL;
-		upper_word += ( value_32bit << 4 ) - value_32bit;
-
-		if( upper_word > 65521 )
-		{
-			value_32bit = upper_word >> 16;
-			upper_word &= 0x0000ffffUL;
-			upper_word += ( value_32bit << 4 ) - value_32bit;
-		}
-		if( upper_word >= 65521 )
-		{
-			upper_word -= 65521;
-		}
-	}
-	*checksum_value = ( upper_word << 16 ) | lower_word;
-
 	return( 1 );
 }
 
@@ -1265,7 +1336,6 @@ int libewf_deflate_decompress(
 	uint8_t compression_method            = 0;
 	uint8_t compression_window_bits       = 0;
 	uint8_t last_block_flag               = 0;
-	uint8_t skip_bits                     = 0;
 
 	if( compressed_data == NULL )
 	{
@@ -1419,8 +1489,8 @@ int libewf_deflate_decompress(
 		return( -1 );
 	}
 
-/* TODO find optimized solution to read bit stream from bytes */
-	while( bit_stream.byte_stream_offset < bit_stream.byte_stream_size )
+	while( ( bit_stream.byte_stream_offset < bit_stream.byte_stream_size )
+	    || ( bit_stream.bit_buffer_size > 0 ) )
 	{
 		if( libewf_deflate_bit_stream_get_value(
 		     &bit_stream,
@@ -1446,41 +1516,36 @@ int libewf_deflate_decompress(
 			case LIBEWF_DEFLATE_BLOCK_TYPE_UNCOMPRESSED:
 				/* Ignore the bits in the buffer upto the next byte
 				 */
-				skip_bits = bit_stream.bit_buffer_size & 0x07;
-
-				if( skip_bits > 0 )
-				{
-					if( libewf_deflate_bit_stream_get_value(
-					     &bit_stream,
-					     skip_bits,
-					     &value_32bit,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-						 "%s: unable to retrieve value from bit stream.",
-						 function );
-
-						return( -1 );
-					}
-				}
-				if( libewf_deflate_bit_stream_get_value(
+				if( libewf_deflate_bit_stream_align_to_byte(
 				     &bit_stream,
-				     32,
-				     &block_size,
 				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve value from bit stream.",
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to align bit stream to byte.",
+					 function );
+
+					return( -1 );
+				}
+				if( ( bit_stream.byte_stream_size - bit_stream.byte_stream_offset ) < 4 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+					 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+					 "%s: invalid compressed data value too small.",
 					 function );
 
 					return( -1 );
 				}
+				byte_stream_copy_to_uint32_little_endian(
+				 &( compressed_data[ bit_stream.byte_stream_offset ] ),
+				 block_size );
+
+				bit_stream.byte_stream_offset += 4;
+
 				block_size_copy = ( block_size >> 16 ) ^ 0x0000ffffUL;
 				block_size     &= 0x0000ffffUL;
 
@@ -1615,6 +1680,21 @@ int libewf_deflate_decompress(
 			break;
 		}
 	}
+	/* Return the whole bytes remaining in the bit buffer to the byte stream
+	 */
+	if( libewf_deflate_bit_stream_align_to_byte(
+	     &bit_stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to align bit stream to byte.",
+		 function );
+
+		return( -1 );
+	}
 	if( ( bit_stream.byte_stream_size - bit_stream.byte_stream_offset ) >= 4 )
 	{
 		byte_stream_copy_to_uint32_big_endian(
@@ -59,13 +59,32 @@ struct libewf_deflate_bit_stream
 
 	/* The bit buffer
 	 */
-	uint32_t bit_buffer;
+	uint64_t bit_buffer;
 
 	/* The number of bits remaining in the bit buffer
 	 */
 	uint8_t bit_buffer_size;
 };
 
+/* The Huffman table entry flags
+ */
+enum LIBEWF_DEFLATE_HUFFMAN_TABLE_ENTRY_FLAGS
+{
+	LIBEWF_DEFLATE_HUFFMAN_TABLE_ENTRY_FLAG_IS_SYMBOL	= 0x01,
+	LIBEWF_DEFLATE_HUFFMAN_TABLE_ENTRY_FLAG_IS_SUB_TABLE	= 0x02
+};
+
+/* The number of bits of the primary lookup tables
+ */
+#define LIBEWF_DEFLATE_LITERALS_TABLE_NUMBER_OF_LOOKUP_BITS	9
+#define LIBEWF_DEFLATE_DISTANCES_TABLE_NUMBER_OF_LOOKUP_BITS	6
+
+/* The maximum number of entries of the lookup table
+ * 852 entries are sufficient for 286 literal and length codes with a primary lookup table of 9 bits
+ * and for 30 distance codes with a primary lookup table of 6 bits
+ */
+#define LIBEWF_DEFLATE_HUFFMAN_TABLE_MAXIMUM_NUMBER_OF_ENTRIES	852
+
 typedef struct libewf_deflate_huffman_table libewf_deflate_huffman_table_t;
 
 struct libewf_deflate_huffman_table
@@ -74,20 +93,27 @@ struct libewf_deflate_huffman_table
 	 */
 	uint8_t maximum_number_of_bits;
 
-/* TODO create initialize and set size? */
-	/* The codes array
+	/* The number of bits of the primary lookup table
 	 */
-	int codes_array[ 288 ];
+	uint8_t number_of_lookup_bits;
 
-	/* The code counts array
+	/* The lookup table
+	 * The primary lookup table is indexed by the first number of lookup bits of a code
+	 * and is followed by the sub tables of codes that are larger than the number of lookup bits
+	 * Every entry contains the symbol or sub table offset in the lower 16 bits,
+	 * the number of bits in the next 8 bits and the entry flags in the upper 8 bits
 	 */
-	int code_counts_array[ 16 ];
-
-	/* The number of codes
-	 */
-	int number_of_codes;
+	uint32_t lookup_table[ LIBEWF_DEFLATE_HUFFMAN_TABLE_MAXIMUM_NUMBER_OF_ENTRIES ];
 };
 
+int libewf_deflate_bit_stream_fill_bit_buffer(
+     libewf_deflate_bit_stream_t *bit_stream,
+     libcerror_error_t **error );
+
+int libewf_deflate_bit_stream_align_to_byte(
+     libewf_deflate_bit_stream_t *bit_stream,
+     libcerror_error_t **error );
+
 int libewf_deflate_bit_stream_get_value(
      libewf_deflate_bit_stream_t *bit_stream,
      uint8_t number_of_bits,
@@ -98,12 +124,7 @@ int libewf_deflate_huffman_table_construct(
      libewf_deflate_huffman_table_t *table,
      const uint16_t *code_sizes_array,
      int number_of_code_sizes,
-     libcerror_error_t **error );
-
-int libewf_deflate_bit_stream_get_huffman_encoded_value(
-     libewf_deflate_bit_stream_t *bit_stream,
-     libewf_deflate_huffman_table_t *table,
-     uint32_t *value_32bit,
+     uint8_t number_of_lookup_bits,
      libcerror_error_t **error );
 
 int libewf_deflate_bit_stream_get_huffman_encoded_value(
@@ -0,0 +1,1729 @@
+/*
+ * Direct file IO handle functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* O_DIRECT is only defined by the GNU C library when _GNU_SOURCE is defined
+ */
+#if !defined( _GNU_SOURCE )
+#define _GNU_SOURCE 1
+#endif
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_definitions.h"
+#include "libewf_direct_file_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libclocale.h"
+#include "libewf_libuna.h"
+
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_HANDLE )
+
+/* Creates a direct file IO handle
+ * Make sure the value file_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_initialize(
+     libewf_direct_file_io_handle_t **file_io_handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_initialize";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_length == 0 )
+	 || ( name_length > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*file_io_handle = memory_allocate_structure(
+	                   libewf_direct_file_io_handle_t );
+
+	if( *file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_io_handle,
+	     0,
+	     sizeof( libewf_direct_file_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file IO handle.",
+		 function );
+
+		memory_free(
+		 *file_io_handle );
+
+		*file_io_handle = NULL;
+
+		return( -1 );
+	}
+	( *file_io_handle )->name = narrow_string_allocate(
+	                             name_length + 1 );
+
+	if( ( *file_io_handle )->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		goto on_error;
+	}
+	if( narrow_string_copy(
+	     ( *file_io_handle )->name,
+	     name,
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		goto on_error;
+	}
+	( *file_io_handle )->name[ name_length ] = 0;
+
+	( *file_io_handle )->name_size  = name_length + 1;
+	( *file_io_handle )->descriptor = -1;
+
+	return( 1 );
+
+on_error:
+	if( *file_io_handle != NULL )
+	{
+		if( ( *file_io_handle )->name != NULL )
+		{
+			memory_free(
+			 ( *file_io_handle )->name );
+		}
+		memory_free(
+		 *file_io_handle );
+
+		*file_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates a file IO handle that reads and writes the file using direct IO
+ * Make sure the value handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_initialize(
+     libbfio_handle_t **handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	libewf_direct_file_io_handle_t *file_io_handle = NULL;
+	static char *function                          = "libewf_direct_file_initialize";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_direct_file_io_handle_initialize(
+	     &file_io_handle,
+	     name,
+	     name_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     handle,
+	     (intptr_t *) file_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libewf_direct_file_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libewf_direct_file_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libewf_direct_file_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_direct_file_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libewf_direct_file_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libewf_direct_file_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libewf_direct_file_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_direct_file_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_direct_file_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libewf_direct_file_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libewf_direct_file_io_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a direct file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_free(
+     libewf_direct_file_io_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_free";
+	int result            = 1;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle != NULL )
+	{
+		if( ( *file_io_handle )->descriptor != -1 )
+		{
+			if( libewf_direct_file_io_handle_close(
+			     *file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *file_io_handle )->name != NULL )
+		{
+			memory_free(
+			 ( *file_io_handle )->name );
+		}
+		memory_free(
+		 *file_io_handle );
+
+		*file_io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the direct file IO handle and its attributes
+ * The destination file IO handle is not opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_clone(
+     libewf_direct_file_io_handle_t **destination_file_io_handle,
+     libewf_direct_file_io_handle_t *source_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_clone";
+
+	if( destination_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_file_io_handle == NULL )
+	{
+		*destination_file_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libewf_direct_file_io_handle_initialize(
+	     destination_file_io_handle,
+	     source_file_io_handle->name,
+	     source_file_io_handle->name_size - 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the direct file IO handle
+ * The file is opened with direct IO, which bypasses the page cache, if supported
+ * by the platform and the file system, otherwise the file is opened with buffered IO
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_open(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "libewf_direct_file_io_handle_open";
+	off_t end_offset      = 0;
+	int file_io_flags     = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle - descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	/* When writing the file is also read to fill the partial blocks
+	 */
+	if( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		file_io_flags = O_RDWR | O_CREAT;
+
+		if( ( access_flags & LIBBFIO_ACCESS_FLAG_TRUNCATE ) != 0 )
+		{
+			file_io_flags |= O_TRUNC;
+		}
+	}
+	else if( ( access_flags & LIBBFIO_ACCESS_FLAG_READ ) != 0 )
+	{
+		file_io_flags = O_RDONLY;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( O_DIRECT )
+	file_io_handle->descriptor = open(
+	                              file_io_handle->name,
+	                              file_io_flags | O_DIRECT,
+	                              0644 );
+
+	/* File systems that do not support direct IO fail with EINVAL
+	 */
+	if( file_io_handle->descriptor != -1 )
+	{
+		file_io_handle->is_direct = 1;
+	}
+	else if( errno == EINVAL )
+#endif
+	{
+		file_io_handle->descriptor = open(
+		                              file_io_handle->name,
+		                              file_io_flags,
+		                              0644 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 file_io_handle->name );
+
+		return( -1 );
+	}
+#if defined( F_NOCACHE )
+	/* Disabling the cache is an optimization, failure is not an error
+	 */
+	if( fcntl(
+	     file_io_handle->descriptor,
+	     F_NOCACHE,
+	     1 ) != -1 )
+	{
+		file_io_handle->is_direct = 1;
+	}
+#endif
+	if( fstat(
+	     file_io_handle->descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( S_ISREG( file_statistics.st_mode ) )
+	{
+		file_io_handle->size = (size64_t) file_statistics.st_size;
+	}
+	else
+	{
+		end_offset = lseek(
+		              file_io_handle->descriptor,
+		              0,
+		              SEEK_END );
+
+		if( end_offset == -1 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 errno,
+			 "%s: unable to determine size.",
+			 function );
+
+			goto on_error;
+		}
+		file_io_handle->size = (size64_t) end_offset;
+	}
+	/* The buffer contains an additional block that is used to fill the last partial block
+	 */
+	if( memory_allocate_aligned(
+	     &( file_io_handle->buffer ),
+	     LIBEWF_DIRECT_FILE_BUFFER_SIZE + LIBEWF_DIRECT_FILE_BLOCK_SIZE,
+	     LIBEWF_DIRECT_FILE_BLOCK_SIZE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		file_io_handle->buffer = NULL;
+
+		goto on_error;
+	}
+	file_io_handle->buffer_offset    = 0;
+	file_io_handle->buffer_data_size = 0;
+	file_io_handle->current_offset   = 0;
+	file_io_handle->access_flags     = access_flags;
+
+	return( 1 );
+
+on_error:
+	close(
+	 file_io_handle->descriptor );
+
+	file_io_handle->descriptor = -1;
+	file_io_handle->is_direct  = 0;
+	file_io_handle->size       = 0;
+
+	return( -1 );
+}
+
+/* Closes the direct file IO handle
+ * The buffered data is flushed and the padding of the last block is truncated
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_close(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_close";
+	int result            = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_direct_file_io_handle_flush(
+	     file_io_handle,
+	     error ) < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush buffer.",
+		 function );
+
+		result = -1;
+	}
+	if( ( file_io_handle->access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		if( ftruncate(
+		     file_io_handle->descriptor,
+		     (off_t) file_io_handle->size ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to truncate file.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( close(
+	     file_io_handle->descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file.",
+		 function );
+
+		result = -1;
+	}
+	if( file_io_handle->buffer != NULL )
+	{
+		memory_free(
+		 file_io_handle->buffer );
+
+		file_io_handle->buffer = NULL;
+	}
+	file_io_handle->descriptor       = -1;
+	file_io_handle->is_direct        = 0;
+	file_io_handle->buffer_offset    = 0;
+	file_io_handle->buffer_data_size = 0;
+	file_io_handle->size             = 0;
+	file_io_handle->current_offset   = 0;
+	file_io_handle->access_flags     = 0;
+
+	return( result );
+}
+
+/* Flushes the buffer of the direct file IO handle
+ * The data is written as whole blocks, the last partial block is filled
+ * with the data that follows it in the file or padded with zero bytes
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_direct_file_io_handle_flush(
+         libewf_direct_file_io_handle_t *file_io_handle,
+         libcerror_error_t **error )
+{
+	uint8_t *block_data   = NULL;
+	static char *function = "libewf_direct_file_io_handle_flush";
+	size_t block_offset   = 0;
+	size_t padding_size   = 0;
+	size_t write_offset   = 0;
+	size_t write_size     = 0;
+	ssize_t read_count    = 0;
+	ssize_t write_count   = 0;
+	off64_t data_end      = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->buffer_data_size == 0 )
+	{
+		return( 0 );
+	}
+	write_size = file_io_handle->buffer_data_size;
+
+	block_offset = write_size % LIBEWF_DIRECT_FILE_BLOCK_SIZE;
+
+	if( block_offset != 0 )
+	{
+		padding_size = LIBEWF_DIRECT_FILE_BLOCK_SIZE - block_offset;
+
+		if( memory_set(
+		     &( ( file_io_handle->buffer )[ write_size ] ),
+		     0,
+		     padding_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear padding.",
+			 function );
+
+			return( -1 );
+		}
+		data_end = file_io_handle->buffer_offset + (off64_t) write_size;
+
+		/* Data that follows the buffered data in the last block is preserved
+		 */
+		if( (size64_t) data_end < file_io_handle->size )
+		{
+			block_data = &( ( file_io_handle->buffer )[ LIBEWF_DIRECT_FILE_BUFFER_SIZE ] );
+
+			read_count = pread(
+			              file_io_handle->descriptor,
+			              (void *) block_data,
+			              LIBEWF_DIRECT_FILE_BLOCK_SIZE,
+			              (off_t) ( data_end - (off64_t) block_offset ) );
+
+			if( read_count < 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 errno,
+				 "%s: unable to read last block from file.",
+				 function );
+
+				return( -1 );
+			}
+			if( (size_t) read_count > block_offset )
+			{
+				if( memory_copy(
+				     &( ( file_io_handle->buffer )[ write_size ] ),
+				     &( block_data[ block_offset ] ),
+				     (size_t) read_count - block_offset ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy last block data.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		write_size += padding_size;
+	}
+	while( write_offset < write_size )
+	{
+		write_count = pwrite(
+		               file_io_handle->descriptor,
+		               (void *) &( ( file_io_handle->buffer )[ write_offset ] ),
+		               write_size - write_offset,
+		               (off_t) ( file_io_handle->buffer_offset + (off64_t) write_offset ) );
+
+		if( write_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to write to file.",
+			 function );
+
+			return( -1 );
+		}
+		if( write_count == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write to file.",
+			 function );
+
+			return( -1 );
+		}
+		write_offset += (size_t) write_count;
+	}
+	write_count = (ssize_t) file_io_handle->buffer_data_size;
+
+	file_io_handle->buffer_data_size = 0;
+
+	return( write_count );
+}
+
+/* Reads a buffer from the direct file IO handle
+ * The data is read as whole blocks by means of the buffer
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libewf_direct_file_io_handle_read(
+         libewf_direct_file_io_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_read";
+	size_t block_offset   = 0;
+	size_t buffer_offset  = 0;
+	size_t copy_size      = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	off64_t read_offset   = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* The buffer is also used for reading, hence the buffered data is written first
+	 */
+	if( libewf_direct_file_io_handle_flush(
+	     file_io_handle,
+	     error ) < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) file_io_handle->current_offset >= file_io_handle->size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) size > ( file_io_handle->size - file_io_handle->current_offset ) )
+	{
+		size = (size_t) ( file_io_handle->size - file_io_handle->current_offset );
+	}
+	while( buffer_offset < size )
+	{
+		block_offset = (size_t) ( file_io_handle->current_offset % LIBEWF_DIRECT_FILE_BLOCK_SIZE );
+		read_offset  = file_io_handle->current_offset - (off64_t) block_offset;
+		read_size    = block_offset + size - buffer_offset;
+
+		if( ( read_size % LIBEWF_DIRECT_FILE_BLOCK_SIZE ) != 0 )
+		{
+			read_size += LIBEWF_DIRECT_FILE_BLOCK_SIZE - ( read_size % LIBEWF_DIRECT_FILE_BLOCK_SIZE );
+		}
+		if( read_size > LIBEWF_DIRECT_FILE_BUFFER_SIZE )
+		{
+			read_size = LIBEWF_DIRECT_FILE_BUFFER_SIZE;
+		}
+		read_count = pread(
+		              file_io_handle->descriptor,
+		              (void *) file_io_handle->buffer,
+		              read_size,
+		              (off_t) read_offset );
+
+		if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read from file.",
+			 function );
+
+			return( -1 );
+		}
+		if( (size_t) read_count <= block_offset )
+		{
+			break;
+		}
+		copy_size = (size_t) read_count - block_offset;
+
+		if( copy_size > ( size - buffer_offset ) )
+		{
+			copy_size = size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     &( ( file_io_handle->buffer )[ block_offset ] ),
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset                  += copy_size;
+		file_io_handle->current_offset += (off64_t) copy_size;
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes a buffer to the direct file IO handle
+ * Consecutive writes are aggregated in the buffer, which is written as whole blocks
+ * when full, when a write is not consecutive, and when the file is read or closed
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libewf_direct_file_io_handle_write(
+         libewf_direct_file_io_handle_t *file_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_write";
+	size_t block_offset   = 0;
+	size_t buffer_offset  = 0;
+	size_t copy_size      = 0;
+	ssize_t read_count    = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_handle->access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid file IO handle - not opened for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		if( ( file_io_handle->buffer_data_size > 0 )
+		 && ( file_io_handle->current_offset != ( file_io_handle->buffer_offset + (off64_t) file_io_handle->buffer_data_size ) ) )
+		{
+			if( libewf_direct_file_io_handle_flush(
+			     file_io_handle,
+			     error ) < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( file_io_handle->buffer_data_size == 0 )
+		{
+			block_offset = (size_t) ( file_io_handle->current_offset % LIBEWF_DIRECT_FILE_BLOCK_SIZE );
+
+			file_io_handle->buffer_offset = file_io_handle->current_offset - (off64_t) block_offset;
+
+			/* Data that precedes the current offset in the first block is preserved
+			 */
+			if( block_offset > 0 )
+			{
+				if( memory_set(
+				     file_io_handle->buffer,
+				     0,
+				     LIBEWF_DIRECT_FILE_BLOCK_SIZE ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear first block.",
+					 function );
+
+					return( -1 );
+				}
+				if( (size64_t) file_io_handle->buffer_offset < file_io_handle->size )
+				{
+					read_count = pread(
+					              file_io_handle->descriptor,
+					              (void *) file_io_handle->buffer,
+					              LIBEWF_DIRECT_FILE_BLOCK_SIZE,
+					              (off_t) file_io_handle->buffer_offset );
+
+					if( read_count < 0 )
+					{
+						libcerror_system_set_error(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 errno,
+						 "%s: unable to read first block from file.",
+						 function );
+
+						return( -1 );
+					}
+				}
+				file_io_handle->buffer_data_size = block_offset;
+			}
+		}
+		copy_size = LIBEWF_DIRECT_FILE_BUFFER_SIZE - file_io_handle->buffer_data_size;
+
+		if( copy_size > ( size - buffer_offset ) )
+		{
+			copy_size = size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( ( file_io_handle->buffer )[ file_io_handle->buffer_data_size ] ),
+		     &( buffer[ buffer_offset ] ),
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data.",
+			 function );
+
+			return( -1 );
+		}
+		file_io_handle->buffer_data_size += copy_size;
+		file_io_handle->current_offset   += (off64_t) copy_size;
+		buffer_offset                    += copy_size;
+
+		if( (size64_t) file_io_handle->current_offset > file_io_handle->size )
+		{
+			file_io_handle->size = (size64_t) file_io_handle->current_offset;
+		}
+		if( file_io_handle->buffer_data_size == LIBEWF_DIRECT_FILE_BUFFER_SIZE )
+		{
+			if( libewf_direct_file_io_handle_flush(
+			     file_io_handle,
+			     error ) < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( (ssize_t) size );
+}
+
+/* Seeks a certain offset within the direct file IO handle
+ * The buffered data is written when the next write is not consecutive
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libewf_direct_file_io_handle_seek_offset(
+         libewf_direct_file_io_handle_t *file_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_seek_offset";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += file_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) file_io_handle->size;
+	}
+	else if( whence != SEEK_SET )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libewf_direct_file_io_handle_exists(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "libewf_direct_file_io_handle_exists";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( stat(
+	     file_io_handle->name,
+	     &file_statistics ) != 0 )
+	{
+		if( errno == ENOENT )
+		{
+			return( 0 );
+		}
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Check if the file is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libewf_direct_file_io_handle_is_open(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_direct_file_io_handle_is_open";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the file size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_direct_file_io_handle_get_size(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "libewf_direct_file_io_handle_get_size";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor != -1 )
+	{
+		*size = file_io_handle->size;
+
+		return( 1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( stat(
+	     file_io_handle->name,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		return( -1 );
+	}
+	*size = (size64_t) file_statistics.st_size;
+
+	return( 1 );
+}
+
+/* Retrieves the name size of a direct file
+ * The name size includes the end of string character
+ * Returns 1 if succesful or -1 on error
+ */
+int libewf_direct_file_get_name_size(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error )
+{
+	libewf_direct_file_io_handle_t *file_io_handle = NULL;
+	static char *function                          = "libewf_direct_file_get_name_size";
+
+	if( name_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_io_handle(
+	     handle,
+	     (intptr_t **) &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	*name_size = file_io_handle->name_size;
+
+	return( 1 );
+}
+
+/* Retrieves the name of a direct file
+ * The name size should include the end of string character
+ * Returns 1 if succesful or -1 on error
+ */
+int libewf_direct_file_get_name(
+     libbfio_handle_t *handle,
+     char *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	libewf_direct_file_io_handle_t *file_io_handle = NULL;
+	static char *function                          = "libewf_direct_file_get_name";
+
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_io_handle(
+	     handle,
+	     (intptr_t **) &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size < file_io_handle->name_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: name too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( narrow_string_copy(
+	     name,
+	     file_io_handle->name,
+	     file_io_handle->name_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Retrieves the name size of a direct file
+ * The name size includes the end of string character
+ * Returns 1 if succesful or -1 on error
+ */
+int libewf_direct_file_get_name_size_wide(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error )
+{
+	libewf_direct_file_io_handle_t *file_io_handle = NULL;
+	static char *function                          = "libewf_direct_file_get_name_size_wide";
+	int result                                     = 0;
+
+	if( name_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_io_handle(
+	     handle,
+	     (intptr_t **) &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_size_from_utf8(
+		          (libuna_utf8_character_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          name_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_size_from_utf8(
+		          (libuna_utf8_character_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          name_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_size_from_byte_stream(
+		          (uint8_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          libclocale_codepage,
+		          name_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_size_from_byte_stream(
+		          (uint8_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          libclocale_codepage,
+		          name_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine name size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the name of a direct file
+ * The name size should include the end of string character
+ * Returns 1 if succesful or -1 on error
+ */
+int libewf_direct_file_get_name_wide(
+     libbfio_handle_t *handle,
+     wchar_t *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	libewf_direct_file_io_handle_t *file_io_handle = NULL;
+	static char *function                          = "libewf_direct_file_get_name_wide";
+	int result                                     = 0;
+
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_io_handle(
+	     handle,
+	     (intptr_t **) &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_copy_from_utf8(
+		          (libuna_utf32_character_t *) name,
+		          name_size,
+		          (libuna_utf8_character_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_copy_from_utf8(
+		          (libuna_utf16_character_t *) name,
+		          name_size,
+		          (libuna_utf8_character_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_copy_from_byte_stream(
+		          (libuna_utf32_character_t *) name,
+		          name_size,
+		          (uint8_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          libclocale_codepage,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_copy_from_byte_stream(
+		          (libuna_utf16_character_t *) name,
+		          name_size,
+		          (uint8_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          libclocale_codepage,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to copy name.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+#endif /* defined( HAVE_LIBEWF_DIRECT_FILE_IO_HANDLE ) */
+
@@ -0,0 +1,186 @@
+/*
+ * Direct file IO handle functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_DIRECT_FILE_IO_HANDLE_H )
+#define _LIBEWF_DIRECT_FILE_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+/* Direct IO requires block aligned memory and positional reads and writes
+ */
+#if defined( HAVE_POSIX_MEMALIGN ) && defined( HAVE_PREAD ) && defined( HAVE_PWRITE ) && defined( HAVE_FTRUNCATE ) && defined( HAVE_FCNTL_H ) && defined( HAVE_UNISTD_H ) && !defined( HAVE_GLIB_H ) && !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define HAVE_LIBEWF_DIRECT_FILE_IO_HANDLE	1
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_HANDLE )
+
+typedef struct libewf_direct_file_io_handle libewf_direct_file_io_handle_t;
+
+struct libewf_direct_file_io_handle
+{
+	/* The name
+	 */
+	char *name;
+
+	/* The name size
+	 */
+	size_t name_size;
+
+	/* The file descriptor, -1 if not open
+	 */
+	int descriptor;
+
+	/* Value to indicate the file descriptor bypasses the page cache
+	 */
+	uint8_t is_direct;
+
+	/* The block aligned buffer
+	 */
+	uint8_t *buffer;
+
+	/* The offset of the data in the buffer, which is block aligned
+	 */
+	off64_t buffer_offset;
+
+	/* The size of the data in the buffer
+	 */
+	size_t buffer_data_size;
+
+	/* The size, which excludes the padding of the last block
+	 */
+	size64_t size;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The access flags
+	 */
+	int access_flags;
+};
+
+int libewf_direct_file_io_handle_initialize(
+     libewf_direct_file_io_handle_t **file_io_handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int libewf_direct_file_initialize(
+     libbfio_handle_t **handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_free(
+     libewf_direct_file_io_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_clone(
+     libewf_direct_file_io_handle_t **destination_file_io_handle,
+     libewf_direct_file_io_handle_t *source_file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_open(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_close(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+ssize_t libewf_direct_file_io_handle_flush(
+         libewf_direct_file_io_handle_t *file_io_handle,
+         libcerror_error_t **error );
+
+ssize_t libewf_direct_file_io_handle_read(
+         libewf_direct_file_io_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libewf_direct_file_io_handle_write(
+         libewf_direct_file_io_handle_t *file_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libewf_direct_file_io_handle_seek_offset(
+         libewf_direct_file_io_handle_t *file_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_exists(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_is_open(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_direct_file_io_handle_get_size(
+     libewf_direct_file_io_handle_t *file_io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+int libewf_direct_file_get_name_size(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error );
+
+int libewf_direct_file_get_name(
+     libbfio_handle_t *handle,
+     char *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libewf_direct_file_get_name_size_wide(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error );
+
+int libewf_direct_file_get_name_wide(
+     libbfio_handle_t *handle,
+     wchar_t *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+#endif /* defined( HAVE_LIBEWF_DIRECT_FILE_IO_HANDLE ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_DIRECT_FILE_IO_HANDLE_H ) */
+
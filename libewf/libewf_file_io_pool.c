@@ -0,0 +1,148 @@
+/*
+ * File IO pool functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_file_io_pool.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+/* Reads a buffer at a specific offset from a file IO pool entry
+ * When libbfio provides positional reads the seek and read are done in
+ * a single call, otherwise the seek is only done when the current offset
+ * of the file IO pool entry differs from the offset
+ * After the read the current offset of the file IO pool entry is
+ * the offset after the data read
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_file_io_pool_read_buffer_at_offset(
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_file_io_pool_read_buffer_at_offset";
+	ssize_t read_count    = 0;
+
+#if !defined( HAVE_LIBBFIO_POOL_READ_BUFFER_AT_OFFSET )
+	off64_t current_offset = 0;
+#endif
+
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBFIO_POOL_READ_BUFFER_AT_OFFSET )
+	read_count = libbfio_pool_read_buffer_at_offset(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") from file IO pool entry: %d.",
+		 function,
+		 offset,
+		 offset,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+#else
+	if( libbfio_pool_get_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &current_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current offset of file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	if( current_offset != offset )
+	{
+		if( libbfio_pool_seek_offset(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in file IO pool entry: %d.",
+			 function,
+			 offset,
+			 offset,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+	}
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              buffer,
+	              buffer_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer from file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+#endif /* defined( HAVE_LIBBFIO_POOL_READ_BUFFER_AT_OFFSET ) */
+
+	return( read_count );
+}
+
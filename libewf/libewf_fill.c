@@ -0,0 +1,390 @@
+/*
+ * Fill detection functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_fill.h"
+#include "libewf_libcerror.h"
+
+#if defined( LIBEWF_FILL_HAVE_X86_SIMD )
+#include <immintrin.h>
+#endif
+
+#if defined( LIBEWF_FILL_HAVE_NEON )
+#include <arm_neon.h>
+#endif
+
+/* Compares the data with a repeating 64-bit pattern
+ * The pattern is stored in the byte order of the data, the data is compared from the start of the pattern
+ * Returns 1 if the data consists of the pattern or 0 if not
+ */
+int libewf_fill_compare_pattern_scalar(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern )
+{
+	uint8_t pattern_data[ 8 ];
+
+	uint64_t value_64bit = 0;
+	size_t data_offset   = 0;
+
+	memory_copy(
+	 pattern_data,
+	 &pattern,
+	 8 );
+
+	while( data_size >= 32 )
+	{
+		memory_copy(
+		 &value_64bit,
+		 data,
+		 8 );
+
+		if( value_64bit != pattern )
+		{
+			return( 0 );
+		}
+		memory_copy(
+		 &value_64bit,
+		 &( data[ 8 ] ),
+		 8 );
+
+		if( value_64bit != pattern )
+		{
+			return( 0 );
+		}
+		memory_copy(
+		 &value_64bit,
+		 &( data[ 16 ] ),
+		 8 );
+
+		if( value_64bit != pattern )
+		{
+			return( 0 );
+		}
+		memory_copy(
+		 &value_64bit,
+		 &( data[ 24 ] ),
+		 8 );
+
+		if( value_64bit != pattern )
+		{
+			return( 0 );
+		}
+		data      += 32;
+		data_size -= 32;
+	}
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		if( data[ data_offset ] != pattern_data[ data_offset % 8 ] )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+#if defined( LIBEWF_FILL_HAVE_X86_SIMD )
+
+/* Compares the data with a repeating 64-bit pattern using SSE2 instructions
+ * The data is processed in blocks of 64 bytes, the remainder is processed by the scalar implementation
+ * Returns 1 if the data consists of the pattern or 0 if not
+ */
+__attribute__ ((target( "sse2" )))
+int libewf_fill_compare_pattern_sse2(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern )
+{
+	__m128i block_data;
+	__m128i differences;
+	__m128i pattern_data;
+	__m128i zero;
+
+	pattern_data = _mm_set1_epi64x( (long long) pattern );
+	zero         = _mm_setzero_si128();
+
+	while( data_size >= 64 )
+	{
+		block_data  = _mm_loadu_si128( (const __m128i *) data );
+		differences = _mm_xor_si128( block_data, pattern_data );
+
+		block_data  = _mm_loadu_si128( (const __m128i *) &( data[ 16 ] ) );
+		differences = _mm_or_si128( differences, _mm_xor_si128( block_data, pattern_data ) );
+
+		block_data  = _mm_loadu_si128( (const __m128i *) &( data[ 32 ] ) );
+		differences = _mm_or_si128( differences, _mm_xor_si128( block_data, pattern_data ) );
+
+		block_data  = _mm_loadu_si128( (const __m128i *) &( data[ 48 ] ) );
+		differences = _mm_or_si128( differences, _mm_xor_si128( block_data, pattern_data ) );
+
+		if( _mm_movemask_epi8( _mm_cmpeq_epi8( differences, zero ) ) != 0xffff )
+		{
+			return( 0 );
+		}
+		data      += 64;
+		data_size -= 64;
+	}
+	return( libewf_fill_compare_pattern_scalar(
+	         data,
+	         data_size,
+	         pattern ) );
+}
+
+/* Compares the data with a repeating 64-bit pattern using AVX2 instructions
+ * The data is processed in blocks of 128 bytes, the remainder is processed by the scalar implementation
+ * Returns 1 if the data consists of the pattern or 0 if not
+ */
+__attribute__ ((target( "avx2" )))
+int libewf_fill_compare_pattern_avx2(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern )
+{
+	__m256i block_data;
+	__m256i differences;
+	__m256i pattern_data;
+
+	pattern_data = _mm256_set1_epi64x( (long long) pattern );
+
+	while( data_size >= 128 )
+	{
+		block_data  = _mm256_loadu_si256( (const __m256i *) data );
+		differences = _mm256_xor_si256( block_data, pattern_data );
+
+		block_data  = _mm256_loadu_si256( (const __m256i *) &( data[ 32 ] ) );
+		differences = _mm256_or_si256( differences, _mm256_xor_si256( block_data, pattern_data ) );
+
+		block_data  = _mm256_loadu_si256( (const __m256i *) &( data[ 64 ] ) );
+		differences = _mm256_or_si256( differences, _mm256_xor_si256( block_data, pattern_data ) );
+
+		block_data  = _mm256_loadu_si256( (const __m256i *) &( data[ 96 ] ) );
+		differences = _mm256_or_si256( differences, _mm256_xor_si256( block_data, pattern_data ) );
+
+		if( _mm256_testz_si256( differences, differences ) == 0 )
+		{
+			return( 0 );
+		}
+		data      += 128;
+		data_size -= 128;
+	}
+	return( libewf_fill_compare_pattern_scalar(
+	         data,
+	         data_size,
+	         pattern ) );
+}
+
+#endif /* defined( LIBEWF_FILL_HAVE_X86_SIMD ) */
+
+#if defined( LIBEWF_FILL_HAVE_NEON )
+
+/* Compares the data with a repeating 64-bit pattern using NEON instructions
+ * The data is processed in blocks of 64 bytes, the remainder is processed by the scalar implementation
+ * Returns 1 if the data consists of the pattern or 0 if not
+ */
+int libewf_fill_compare_pattern_neon(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern )
+{
+	uint8x16_t differences;
+	uint8x16_t pattern_data;
+	uint64x2_t differences_64bit;
+
+	pattern_data = vreinterpretq_u8_u64( vdupq_n_u64( pattern ) );
+
+	while( data_size >= 64 )
+	{
+		differences = veorq_u8( vld1q_u8( data ), pattern_data );
+		differences = vorrq_u8( differences, veorq_u8( vld1q_u8( &( data[ 16 ] ) ), pattern_data ) );
+		differences = vorrq_u8( differences, veorq_u8( vld1q_u8( &( data[ 32 ] ) ), pattern_data ) );
+		differences = vorrq_u8( differences, veorq_u8( vld1q_u8( &( data[ 48 ] ) ), pattern_data ) );
+
+		differences_64bit = vreinterpretq_u64_u8( differences );
+
+		if( ( vgetq_lane_u64( differences_64bit, 0 ) | vgetq_lane_u64( differences_64bit, 1 ) ) != 0 )
+		{
+			return( 0 );
+		}
+		data      += 64;
+		data_size -= 64;
+	}
+	return( libewf_fill_compare_pattern_scalar(
+	         data,
+	         data_size,
+	         pattern ) );
+}
+
+#endif /* defined( LIBEWF_FILL_HAVE_NEON ) */
+
+/* Determines the fill type of the data in a single pass
+ * If the data size is a multiple of 8 and larger than 8 the data is checked for a 64-bit pattern fill,
+ * otherwise the data is checked for zero bytes (empty-block)
+ * The fill pattern is set to the little-endian 64-bit value of the pattern
+ * The implementation is selected at run-time based on the instructions supported by the CPU
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_fill_get_type(
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t *fill_type,
+     uint64_t *fill_pattern,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_fill_get_type";
+	size_t compare_size   = 0;
+	uint64_t pattern      = 0;
+	int result            = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( fill_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fill type.",
+		 function );
+
+		return( -1 );
+	}
+	if( fill_pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fill pattern.",
+		 function );
+
+		return( -1 );
+	}
+	*fill_type    = LIBEWF_FILL_TYPE_NONE;
+	*fill_pattern = 0;
+
+	if( data_size <= 1 )
+	{
+		return( 1 );
+	}
+	/* The first 8 bytes define the pattern, the remaining data is compared against it
+	 */
+	if( ( data_size > 8 )
+	 && ( ( data_size % 8 ) == 0 ) )
+	{
+		memory_copy(
+		 &pattern,
+		 data,
+		 8 );
+
+		data         += 8;
+		compare_size  = data_size - 8;
+	}
+	else
+	{
+		compare_size = data_size;
+	}
+#if defined( LIBEWF_FILL_HAVE_X86_SIMD )
+	if( compare_size >= 128 )
+	{
+		if( __builtin_cpu_supports( "avx2" ) )
+		{
+			result = libewf_fill_compare_pattern_avx2(
+			          data,
+			          compare_size,
+			          pattern );
+		}
+		else if( __builtin_cpu_supports( "sse2" ) )
+		{
+			result = libewf_fill_compare_pattern_sse2(
+			          data,
+			          compare_size,
+			          pattern );
+		}
+		else
+		{
+			result = libewf_fill_compare_pattern_scalar(
+			          data,
+			          compare_size,
+			          pattern );
+		}
+	}
+	else
+#elif defined( LIBEWF_FILL_HAVE_NEON )
+	if( compare_size >= 64 )
+	{
+		result = libewf_fill_compare_pattern_neon(
+		          data,
+		          compare_size,
+		          pattern );
+	}
+	else
+#endif
+	{
+		result = libewf_fill_compare_pattern_scalar(
+		          data,
+		          compare_size,
+		          pattern );
+	}
+	if( result != 0 )
+	{
+		if( pattern == 0 )
+		{
+			*fill_type = LIBEWF_FILL_TYPE_EMPTY_BLOCK;
+		}
+		else
+		{
+			*fill_type = LIBEWF_FILL_TYPE_64_BIT_PATTERN;
+
+			byte_stream_copy_to_uint64_little_endian(
+			 (uint8_t *) &pattern,
+			 *fill_pattern );
+		}
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,89 @@
+/*
+ * Fill detection functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_FILL_H )
+#define _LIBEWF_FILL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+/* The x86 SIMD implementations require compiler support for the target function attribute
+ * and run-time CPU feature detection
+ */
+#if !defined( LIBEWF_FILL_HAVE_X86_SIMD ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#if defined( __clang__ ) || ( defined( __GNUC__ ) && ( ( __GNUC__ > 4 ) || ( ( __GNUC__ == 4 ) && ( __GNUC_MINOR__ >= 9 ) ) ) )
+#define LIBEWF_FILL_HAVE_X86_SIMD
+#endif
+#endif
+
+/* The NEON implementation is used when the target supports NEON instructions
+ */
+#if !defined( LIBEWF_FILL_HAVE_NEON ) && ( defined( __ARM_NEON ) || defined( __ARM_NEON__ ) )
+#define LIBEWF_FILL_HAVE_NEON
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+int libewf_fill_compare_pattern_scalar(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern );
+
+#if defined( LIBEWF_FILL_HAVE_X86_SIMD )
+
+int libewf_fill_compare_pattern_sse2(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern );
+
+int libewf_fill_compare_pattern_avx2(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern );
+
+#endif /* defined( LIBEWF_FILL_HAVE_X86_SIMD ) */
+
+#if defined( LIBEWF_FILL_HAVE_NEON )
+
+int libewf_fill_compare_pattern_neon(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern );
+
+#endif /* defined( LIBEWF_FILL_HAVE_NEON ) */
+
+int libewf_fill_get_type(
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t *fill_type,
+     uint64_t *fill_pattern,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_FILL_H ) */
+
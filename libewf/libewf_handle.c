@@ -28,18 +28,23 @@
 #include "libewf_analytical_data.h"
 #include "libewf_case_data.h"
 #include "libewf_chunk_data.h"
+#include "libewf_buffer_pool.h"
+#include "libewf_chunk_index.h"
 #include "libewf_chunk_table.h"
+#include "libewf_coalesced_read_buffer.h"
 #include "libewf_compression.h"
 #include "libewf_data_chunk.h"
 #include "libewf_debug.h"
 #include "libewf_definitions.h"
 #include "libewf_device_information.h"
+#include "libewf_direct_file_io_handle.h"
 #include "libewf_file_entry.h"
 #include "libewf_hash_sections.h"
 #include "libewf_handle.h"
 #include "libewf_header_sections.h"
 #include "libewf_header_values.h"
 #include "libewf_io_handle.h"
+#include "libewf_io_uring.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
@@ -48,16 +53,20 @@
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_libfvalue.h"
+#include "libewf_memory_mapped_file_io_handle.h"
 #include "libewf_metadata.h"
 #include "libewf_restart_data.h"
 #include "libewf_sector_range.h"
 #include "libewf_segment_file.h"
+#include "libewf_segment_file_reader.h"
 #include "libewf_single_file_entry.h"
 #include "libewf_single_file_tree.h"
 #include "libewf_single_files.h"
 #include "libewf_types.h"
 #include "libewf_unused.h"
+#include "libewf_write_behind_buffer.h"
 #include "libewf_write_io_handle.h"
+#include "libewf_write_pipeline.h"
 
 #include "ewf_data.h"
 #include "ewf_file_header.h"
@@ -139,6 +148,21 @@ int libewf_handle_initialize(
 
 		goto on_error;
 	}
+	if( libewf_buffer_pool_initialize(
+	     &( internal_handle->buffer_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create buffer pool.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle->io_handle->buffer_pool = internal_handle->buffer_pool;
+
 	if( libewf_media_values_initialize(
 	     &( internal_handle->media_values ),
 	     error ) != 1 )
@@ -207,9 +231,25 @@ int libewf_handle_initialize(
 
 		goto on_error;
 	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_handle->read_chunk_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to intialize read chunk mutex.",
+		 function );
+
+		goto on_error;
+	}
 #endif
 	internal_handle->date_format                    = LIBEWF_DATE_FORMAT_CTIME;
 	internal_handle->maximum_number_of_open_handles = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
+	internal_handle->chunk_cache_size               = LIBEWF_DEFAULT_CHUNK_CACHE_SIZE;
+	internal_handle->coalesced_read_size            = LIBEWF_DEFAULT_COALESCED_READ_SIZE;
+	internal_handle->write_behind_size              = LIBEWF_DEFAULT_WRITE_BEHIND_SIZE;
 
 	*handle = (libewf_handle_t *) internal_handle;
 
@@ -218,6 +258,14 @@ int libewf_handle_initialize(
 on_error:
 	if( internal_handle != NULL )
 	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_handle->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_handle->read_write_lock ),
+			 NULL );
+		}
+#endif
 		if( internal_handle->acquiry_errors != NULL )
 		{
 			libcdata_range_list_free(
@@ -245,6 +293,12 @@ on_error:
 			 &( internal_handle->media_values ),
 			 NULL );
 		}
+		if( internal_handle->buffer_pool != NULL )
+		{
+			libewf_buffer_pool_free(
+			 &( internal_handle->buffer_pool ),
+			 NULL );
+		}
 		if( internal_handle->io_handle != NULL )
 		{
 			libewf_io_handle_free(
@@ -315,6 +369,19 @@ int libewf_handle_free(
 
 			result = -1;
 		}
+		if( libcthreads_mutex_free(
+		     &( internal_handle->read_chunk_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read chunk mutex.",
+			 function );
+
+			result = -1;
+		}
 #endif
 		if( libewf_io_handle_free(
 		     &( internal_handle->io_handle ),
@@ -329,6 +396,24 @@ int libewf_handle_free(
 
 			result = -1;
 		}
+		if( libewf_buffer_pool_free(
+		     &( internal_handle->buffer_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free buffer pool.",
+			 function );
+
+			result = -1;
+		}
+		if( internal_handle->chunk_index_filename != NULL )
+		{
+			memory_free(
+			 internal_handle->chunk_index_filename );
+		}
 		if( libewf_media_values_free(
 		     &( internal_handle->media_values ),
 		     error ) != 1 )
@@ -496,6 +581,22 @@ int libewf_handle_clone(
 
 		goto on_error;
 	}
+	if( libewf_buffer_pool_clone(
+	     &( internal_destination_handle->buffer_pool ),
+	     internal_source_handle->buffer_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination buffer pool.",
+		 function );
+
+		goto on_error;
+	}
+	internal_destination_handle->io_handle->buffer_pool = internal_destination_handle->buffer_pool;
+
 	if( libewf_media_values_clone(
 	     &( internal_destination_handle->media_values ),
 	     internal_source_handle->media_values,
@@ -728,7 +829,49 @@ int libewf_handle_clone(
 		}
 		internal_destination_handle->hash_values_parsed = internal_source_handle->hash_values_parsed;
 	}
+	if( internal_source_handle->chunk_index_filename != NULL )
+	{
+		internal_destination_handle->chunk_index_filename = narrow_string_allocate(
+		                                                     internal_source_handle->chunk_index_filename_size );
+
+		if( internal_destination_handle->chunk_index_filename == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create destination chunk index filename.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     internal_destination_handle->chunk_index_filename,
+		     internal_source_handle->chunk_index_filename,
+		     sizeof( char ) * internal_source_handle->chunk_index_filename_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy source to destination chunk index filename.",
+			 function );
+
+			goto on_error;
+		}
+		internal_destination_handle->chunk_index_filename_size = internal_source_handle->chunk_index_filename_size;
+	}
 	internal_destination_handle->maximum_number_of_open_handles = internal_source_handle->maximum_number_of_open_handles;
+	internal_destination_handle->read_ahead_number_of_chunks    = internal_source_handle->read_ahead_number_of_chunks;
+	internal_destination_handle->write_number_of_threads        = internal_source_handle->write_number_of_threads;
+	internal_destination_handle->write_behind_size              = internal_source_handle->write_behind_size;
+	internal_destination_handle->chunk_cache_size               = internal_source_handle->chunk_cache_size;
+	internal_destination_handle->chunk_groups_cache_size        = internal_source_handle->chunk_groups_cache_size;
+	internal_destination_handle->coalesced_read_size            = internal_source_handle->coalesced_read_size;
+	internal_destination_handle->io_engine                      = internal_source_handle->io_engine;
+	internal_destination_handle->lazy_open                      = internal_source_handle->lazy_open;
+	internal_destination_handle->number_of_mapped_segments      = internal_source_handle->number_of_mapped_segments;
+	internal_destination_handle->file_io_pool_io_engine         = internal_source_handle->file_io_pool_io_engine;
 	internal_destination_handle->date_format                    = internal_source_handle->date_format;
 
 	return( 1 );
@@ -736,6 +879,11 @@ int libewf_handle_clone(
 on_error:
 	if( internal_destination_handle != NULL )
 	{
+		if( internal_destination_handle->chunk_index_filename != NULL )
+		{
+			memory_free(
+			 internal_destination_handle->chunk_index_filename );
+		}
 		if( internal_destination_handle->hash_values != NULL )
 		{
 			libfvalue_table_free(
@@ -823,6 +971,12 @@ on_error:
 			 &( internal_destination_handle->media_values ),
 			 NULL );
 		}
+		if( internal_destination_handle->buffer_pool != NULL )
+		{
+			libewf_buffer_pool_free(
+			 &( internal_destination_handle->buffer_pool ),
+			 NULL );
+		}
 		if( internal_destination_handle->io_handle != NULL )
 		{
 			libewf_io_handle_free(
@@ -874,31 +1028,23 @@ int libewf_handle_signal_abort(
 	return( 1 );
 }
 
-/* Opens a set of EWF file(s)
- * For reading files should contain all filenames that make up an EWF image
- * For writing files should contain the base of the filename, extentions like .e01 will be automatically added
+/* Retrieves the values used to open a set of EWF file(s)
+ * The IO engine is only used when opened for reading only
+ * except for the direct IO engine, which is only used for the segment files
+ * that are created when opened for writing
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_open(
-     libewf_handle_t *handle,
-     char * const filenames[],
-     int number_of_filenames,
+int libewf_internal_handle_get_open_values(
+     libewf_internal_handle_t *internal_handle,
      int access_flags,
+     int *maximum_number_of_open_handles,
+     int *io_engine,
+     int *access_behavior,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle          = NULL;
-	libbfio_pool_t *file_io_pool              = NULL;
-	libewf_internal_handle_t *internal_handle = NULL;
-	libewf_segment_table_t *segment_table     = NULL;
-	char *first_segment_filename              = NULL;
-	static char *function                     = "libewf_handle_open";
-	size_t filename_length                    = 0;
-	int file_io_pool_entry                    = 0;
-	int filename_index                        = 0;
-	int maximum_number_of_open_handles        = 0;
-	int result                                = 0;
+	static char *function = "libewf_internal_handle_get_open_values";
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -909,26 +1055,35 @@ int libewf_handle_open(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	if( maximum_number_of_open_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of open handles.",
+		 function );
 
-	if( filenames == NULL )
+		return( -1 );
+	}
+	if( io_engine == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid filenames.",
+		 "%s: invalid IO engine.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_filenames <= 0 )
+	if( access_behavior == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
-		 "%s: invalid number of files zero or less.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid access behavior.",
 		 function );
 
 		return( -1 );
@@ -948,8 +1103,30 @@ int libewf_handle_open(
 		return( -1 );
 	}
 #endif
-	maximum_number_of_open_handles = internal_handle->maximum_number_of_open_handles;
+	*maximum_number_of_open_handles = internal_handle->maximum_number_of_open_handles;
+	*io_engine                      = LIBEWF_IO_ENGINE_BUFFERED;
+	*access_behavior                = LIBEWF_MEMORY_MAPPED_FILE_ACCESS_BEHAVIOR_RANDOM;
 
+	if( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 )
+	{
+		if( internal_handle->io_engine != LIBEWF_IO_ENGINE_DIRECT )
+		{
+			*io_engine = internal_handle->io_engine;
+		}
+	}
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_HANDLE )
+	else if( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 )
+	{
+		if( internal_handle->io_engine == LIBEWF_IO_ENGINE_DIRECT )
+		{
+			*io_engine = internal_handle->io_engine;
+		}
+	}
+#endif
+	if( internal_handle->read_ahead_number_of_chunks > 0 )
+	{
+		*access_behavior = LIBEWF_MEMORY_MAPPED_FILE_ACCESS_BEHAVIOR_SEQUENTIAL;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -965,188 +1142,180 @@ int libewf_handle_open(
 		return( -1 );
 	}
 #endif
-	if( libbfio_pool_initialize(
-	     &file_io_pool,
-	     0,
-	     maximum_number_of_open_handles,
-	     error ) != 1 )
+	return( 1 );
+}
+
+/* Creates a file IO handle of a segment file for the IO engine
+ * Make sure the value file_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_initialize_file_io_handle(
+     libbfio_handle_t **file_io_handle,
+     const char *filename,
+     size_t filename_length,
+     int io_engine,
+     int access_behavior,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_initialize_file_io_handle";
+
+	if( file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+#if defined( HAVE_LIBEWF_MEMORY_MAPPED_FILE_IO_HANDLE )
+	if( io_engine == LIBEWF_IO_ENGINE_MEMORY_MAPPED )
 	{
-		for( filename_index = 0;
-		     filename_index < number_of_filenames;
-		     filename_index++ )
+		if( libewf_memory_mapped_file_initialize(
+		     file_io_handle,
+		     filename,
+		     filename_length,
+		     access_behavior,
+		     error ) != 1 )
 		{
-			filename_length = narrow_string_length(
-					   filenames[ filename_index ] );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create memory mapped file IO handle.",
+			 function );
 
-			/* Make sure there is more to the filename than the extension
-			 */
-			if( filename_length <= 4 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-				 "%s: filename: %s is too small.",
-				 function,
-				 filenames[ filename_index ] );
+			goto on_error;
+		}
+	}
+	else
+#endif
+	{
+		if( libbfio_file_initialize(
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
 
-				goto on_error;
-			}
-			if( libbfio_file_initialize(
-			     &file_io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create file IO handle.",
-				 function );
+			goto on_error;
+		}
+		if( libbfio_file_set_name(
+		     *file_io_handle,
+		     filename,
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name in file IO handle.",
+			 function );
 
-				goto on_error;
-			}
+			goto on_error;
+		}
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
-			if( libbfio_handle_set_track_offsets_read(
-			     file_io_handle,
-			     1,
-			     error ) != 1 )
-			{
-		                libcerror_error_set(
-		                 error,
-		                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		                 "%s: unable to set track offsets read in file IO handle.",
-		                 function );
+	if( libbfio_handle_set_track_offsets_read(
+	     *file_io_handle,
+	     1,
+	     error ) != 1 )
+	{
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to set track offsets read in file IO handle.",
+                 function );
 
-				goto on_error;
-			}
+		goto on_error;
+	}
 #endif
-			if( libbfio_file_set_name(
-			     file_io_handle,
-			     filenames[ filename_index ],
-			     filename_length,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set name in file IO handle.",
-				 function );
+	return( 1 );
 
-				goto on_error;
-			}
-			if( libbfio_pool_append_handle(
-			     file_io_pool,
-			     &file_io_pool_entry,
-			     file_io_handle,
-			     LIBBFIO_OPEN_READ,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append file IO handle to pool.",
-				 function );
+on_error:
+	if( *file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
 
-				goto on_error;
-			}
-			file_io_handle = NULL;
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
 
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: added file IO pool entry: %d with filename: %s.\n",
-				 function,
-				 file_io_pool_entry,
-				 filenames[ filename_index ] );
-			}
-#endif
-			if( ( filenames[ filename_index ][ filename_length - 3 ] == 'e' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'E' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'l' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'L' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 's' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'S' ) )
-			{
-				if( ( filenames[ filename_index ][ filename_length - 2 ] == '0' )
-				 && ( filenames[ filename_index ][ filename_length - 1 ] == '1' ) )
-				{
-					first_segment_filename = filenames[ filename_index ];
-				}
-			}
-		}
-	}
-	if( libewf_segment_table_initialize(
-	     &segment_table,
-	     internal_handle->io_handle,
-	     LIBEWF_DEFAULT_SEGMENT_FILE_SIZE,
-	     error ) != 1 )
+/* Creates a file IO handle of a segment file for the IO engine
+ * Make sure the value file_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_initialize_file_io_handle_wide(
+     libbfio_handle_t **file_io_handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     int io_engine,
+     int access_behavior,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_initialize_file_io_handle_wide";
+
+	if( file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segment table.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+#if defined( HAVE_LIBEWF_MEMORY_MAPPED_FILE_IO_HANDLE )
+	if( io_engine == LIBEWF_IO_ENGINE_MEMORY_MAPPED )
 	{
-		/* Get the basename of the first segment file
-		 */
-		if( first_segment_filename != NULL )
+		if( libewf_memory_mapped_file_initialize_wide(
+		     file_io_handle,
+		     filename,
+		     filename_length,
+		     access_behavior,
+		     error ) != 1 )
 		{
-			filename_length = narrow_string_length(
-					   first_segment_filename );
-
-			/* Set segment table basename
-			 */
-			if( libewf_segment_table_set_basename(
-			     segment_table,
-			     first_segment_filename,
-			     filename_length - 4,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set basename in segment table.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create memory mapped file IO handle.",
+			 function );
 
-				goto on_error;
-			}
+			goto on_error;
 		}
 	}
-	else if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	else
+#endif
 	{
-		/* Get the basename and store it in the segment tables
-		 */
-		filename_length = narrow_string_length(
-				   filenames[ 0 ] );
+		if( libbfio_file_initialize(
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
 
-		/* Set segment table basename
-		 */
-		if( libewf_segment_table_set_basename(
-		     segment_table,
-		     filenames[ 0 ],
+			goto on_error;
+		}
+		if( libbfio_file_set_name_wide(
+		     *file_io_handle,
+		     filename,
 		     filename_length,
 		     error ) != 1 )
 		{
@@ -1154,117 +1323,59 @@ int libewf_handle_open(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set basename in segment table.",
+			 "%s: unable to set name in file IO handle.",
 			 function );
 
 			goto on_error;
 		}
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libbfio_handle_set_track_offsets_read(
+	     *file_io_handle,
+	     1,
 	     error ) != 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
-		 function );
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to set track offsets read in file IO handle.",
+                 function );
 
 		goto on_error;
 	}
 #endif
-	result = libewf_internal_handle_open_file_io_pool(
-	          internal_handle,
-	          file_io_pool,
-	          access_flags,
-	          segment_table,
-	          error );
-
-	if( result != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open handle using a file IO pool.",
-		 function );
-	}
-	else
-	{
-		internal_handle->file_io_pool_created_in_library = 1;
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	result = libcthreads_read_write_lock_release_for_write(
-	          internal_handle->read_write_lock,
-	          error );
-
-	if( result != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
-	}
-#endif
-	if( result != 1 )
-	{
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
-	if( segment_table != NULL )
-	{
-		libewf_segment_table_free(
-		 &segment_table,
-		 NULL );
-	}
-	if( file_io_handle != NULL )
+	if( *file_io_handle != NULL )
 	{
 		libbfio_handle_free(
-		 &file_io_handle,
-		 NULL );
-	}
-	if( file_io_pool != NULL )
-	{
-		libbfio_pool_free(
-		 &file_io_pool,
+		 file_io_handle,
 		 NULL );
 	}
 	return( -1 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
-/* Opens a set of EWF file(s)
- * For reading files should contain all filenames that make up an EWF image
- * For writing files should contain the base of the filename, extentions like .e01 will be automatically added
+/* Opens a set of EWF file(s) using a file IO pool created by the library
+ * The chunk index is read before and written after the segment files are opened
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_open_wide(
-     libewf_handle_t *handle,
-     wchar_t * const filenames[],
-     int number_of_filenames,
+int libewf_internal_handle_open_created_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
      int access_flags,
+     libewf_segment_table_t *segment_table,
+     int io_engine,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle          = NULL;
-	libbfio_pool_t *file_io_pool              = NULL;
-	libewf_internal_handle_t *internal_handle = NULL;
-	libewf_segment_table_t *segment_table     = NULL;
-	wchar_t *first_segment_filename           = NULL;
-	static char *function                     = "libewf_handle_open_wide";
-	size_t filename_length                    = 0;
-	int file_io_pool_entry                    = 0;
-	int filename_index                        = 0;
-	int maximum_number_of_open_handles        = 0;
-	int result                                = 0;
+	static char *function = "libewf_internal_handle_open_created_file_io_pool";
+	int result            = 0;
+	int use_chunk_index   = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1275,32 +1386,8 @@ int libewf_handle_open_wide(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( filenames == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid filenames.",
-		 function );
-
-		return( -1 );
-	}
-	if( number_of_filenames <= 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
-		 "%s: invalid number of files zero or less.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1308,29 +1395,250 @@ int libewf_handle_open_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	maximum_number_of_open_handles = internal_handle->maximum_number_of_open_handles;
+	/* Memory mapped chunk data is copied directly from the mapping
+	 * coalescing the reads would only add a copy
+	 */
+	if( ( io_engine == LIBEWF_IO_ENGINE_MEMORY_MAPPED )
+	 && ( internal_handle->coalesced_read_buffer != NULL ) )
+	{
+		internal_handle->io_handle->coalesced_read_buffer = NULL;
+
+		if( libewf_coalesced_read_buffer_free(
+		     &( internal_handle->coalesced_read_buffer ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free coalesced read buffer.",
+			 function );
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+			libcthreads_read_write_lock_release_for_write(
+			 internal_handle->read_write_lock,
+			 NULL );
+#endif
+			return( -1 );
+		}
+	}
+	/* The chunk index is only used when opened for reading only
+	 */
+	if( ( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 )
+	 && ( internal_handle->chunk_index_filename != NULL ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		use_chunk_index = 1;
+
+		if( libewf_internal_handle_open_read_chunk_index(
+		     internal_handle,
+		     file_io_pool,
+		     io_engine,
+		     error ) == -1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+	}
+	result = libewf_internal_handle_open_file_io_pool(
+	          internal_handle,
+	          file_io_pool,
+	          access_flags,
+	          segment_table,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle using a file IO pool.",
 		 function );
+	}
+	else
+	{
+		internal_handle->file_io_pool_created_in_library = 1;
+		internal_handle->file_io_pool_io_engine          = io_engine;
 
-		return( -1 );
+		if( internal_handle->write_io_handle != NULL )
+		{
+			internal_handle->write_io_handle->io_engine = io_engine;
+		}
+
+		/* Writing the chunk index is best effort
+		 */
+		if( ( use_chunk_index != 0 )
+		 && ( internal_handle->chunk_index == NULL ) )
+		{
+			if( libewf_internal_handle_write_chunk_index(
+			     internal_handle,
+			     error ) == -1 )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( ( error != NULL )
+					 && ( *error != NULL ) )
+					{
+						libcnotify_print_error_backtrace(
+						 *error );
+					}
+				}
+#endif
+				libcerror_error_free(
+				 error );
+			}
+		}
+
+#if defined( HAVE_LIBEWF_IO_URING ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( io_engine == LIBEWF_IO_ENGINE_IO_URING )
+		 && ( internal_handle->read_ahead != NULL ) )
+		{
+			/* The read-ahead falls back to reading the chunk data
+			 * using the file IO pool if io_uring cannot be used
+			 */
+			if( libewf_read_ahead_initialize_io_uring(
+			     internal_handle->read_ahead,
+			     error ) == -1 )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( ( error != NULL )
+					 && ( *error != NULL ) )
+					{
+						libcnotify_print_error_backtrace(
+						 *error );
+					}
+				}
+#endif
+				libcerror_error_free(
+				 error );
+			}
+		}
+#endif
+	}
+	if( ( result != 1 )
+	 && ( internal_handle->chunk_index != NULL ) )
+	{
+		internal_handle->io_handle->chunk_index = NULL;
+
+		libewf_chunk_index_free(
+		 &( internal_handle->chunk_index ),
+		 NULL );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
 	}
 #endif
+	return( result );
+}
+
+/* Opens a set of EWF file(s)
+ * For reading files should contain all filenames that make up an EWF image
+ * For writing files should contain the base of the filename, extentions like .e01 will be automatically added
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_open(
+     libewf_handle_t *handle,
+     char * const filenames[],
+     int number_of_filenames,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle          = NULL;
+	libbfio_pool_t *file_io_pool              = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	libewf_segment_table_t *segment_table     = NULL;
+	char *first_segment_filename              = NULL;
+	static char *function                     = "libewf_handle_open";
+	size_t filename_length                    = 0;
+	int access_behavior                       = 0;
+	int file_io_pool_entry                    = 0;
+	int filename_index                        = 0;
+	int io_engine                             = 0;
+	int maximum_number_of_open_handles        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of files zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_internal_handle_get_open_values(
+	     internal_handle,
+	     access_flags,
+	     &maximum_number_of_open_handles,
+	     &io_engine,
+	     &access_behavior,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve open values.",
+		 function );
+
+		return( -1 );
+	}
 	if( libbfio_pool_initialize(
 	     &file_io_pool,
 	     0,
@@ -1353,7 +1661,7 @@ int libewf_handle_open_wide(
 		     filename_index < number_of_filenames;
 		     filename_index++ )
 		{
-			filename_length = wide_string_length(
+			filename_length = narrow_string_length(
 					   filenames[ filename_index ] );
 
 			/* Make sure there is more to the filename than the extension
@@ -1364,52 +1672,25 @@ int libewf_handle_open_wide(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-				 "%s: filename: %ls is too small.",
+				 "%s: filename: %s is too small.",
 				 function,
 				 filenames[ filename_index ] );
 
 				goto on_error;
 			}
-			if( libbfio_file_initialize(
+			if( libewf_internal_handle_initialize_file_io_handle(
 			     &file_io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create file IO handle.",
-				 function );
-
-				goto on_error;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libbfio_handle_set_track_offsets_read(
-			     file_io_handle,
-			     1,
-			     error ) != 1 )
-			{
-		                libcerror_error_set(
-		                 error,
-		                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		                 "%s: unable to set track offsets read in file IO handle.",
-		                 function );
-
-				goto on_error;
-			}
-#endif
-			if( libbfio_file_set_name_wide(
-			     file_io_handle,
 			     filenames[ filename_index ],
 			     filename_length,
+			     io_engine,
+			     access_behavior,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set name in file IO handle.",
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create file IO handle.",
 				 function );
 
 				goto on_error;
@@ -1436,7 +1717,7 @@ int libewf_handle_open_wide(
 			if( libcnotify_verbose != 0 )
 			{
 				libcnotify_printf(
-				 "%s: added file IO pool entry: %d with filename: %ls.\n",
+				 "%s: added file IO pool entry: %d with filename: %s.\n",
 				 function,
 				 file_io_pool_entry,
 				 filenames[ filename_index ] );
@@ -1479,12 +1760,12 @@ int libewf_handle_open_wide(
 		 */
 		if( first_segment_filename != NULL )
 		{
-			filename_length = wide_string_length(
+			filename_length = narrow_string_length(
 					   first_segment_filename );
 
 			/* Set segment table basename
 			 */
-			if( libewf_segment_table_set_basename_wide(
+			if( libewf_segment_table_set_basename(
 			     segment_table,
 			     first_segment_filename,
 			     filename_length - 4,
@@ -1505,12 +1786,12 @@ int libewf_handle_open_wide(
 	{
 		/* Get the basename and store it in the segment tables
 		 */
-		filename_length = wide_string_length(
+		filename_length = narrow_string_length(
 				   filenames[ 0 ] );
 
 		/* Set segment table basename
 		 */
-		if( libewf_segment_table_set_basename_wide(
+		if( libewf_segment_table_set_basename(
 		     segment_table,
 		     filenames[ 0 ],
 		     filename_length,
@@ -1526,29 +1807,13 @@ int libewf_handle_open_wide(
 			goto on_error;
 		}
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libewf_internal_handle_open_created_file_io_pool(
+	     internal_handle,
+	     file_io_pool,
+	     access_flags,
+	     segment_table,
+	     io_engine,
 	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
-		 function );
-
-		goto on_error;
-	}
-#endif
-	result = libewf_internal_handle_open_file_io_pool(
-	          internal_handle,
-	          file_io_pool,
-	          access_flags,
-	          segment_table,
-	          error );
-
-	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -1556,28 +1821,7 @@ int libewf_handle_open_wide(
 		 LIBCERROR_IO_ERROR_OPEN_FAILED,
 		 "%s: unable to open handle using a file IO pool.",
 		 function );
-	}
-	else
-	{
-		internal_handle->file_io_pool_created_in_library = 1;
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	result = libcthreads_read_write_lock_release_for_write(
-	          internal_handle->read_write_lock,
-	          error );
 
-	if( result != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
-	}
-#endif
-	if( result != 1 )
-	{
 		goto on_error;
 	}
 	return( 1 );
@@ -1604,40 +1848,34 @@ on_error:
 	return( -1 );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
 
-/* Reads the section data from a segment file
+/* Opens a set of EWF file(s)
+ * For reading files should contain all filenames that make up an EWF image
+ * For writing files should contain the base of the filename, extentions like .e01 will be automatically added
  * Returns 1 if successful or -1 on error
  */
-int libewf_internal_handle_open_read_segment_file_section_data(
-     libewf_internal_handle_t *internal_handle,
-     libewf_segment_file_t *segment_file,
-     libbfio_pool_t *file_io_pool,
-     int file_io_pool_entry,
+int libewf_handle_open_wide(
+     libewf_handle_t *handle,
+     wchar_t * const filenames[],
+     int number_of_filenames,
+     int access_flags,
      libcerror_error_t **error )
 {
-	libewf_header_sections_t *header_sections = NULL;
-	libewf_section_t *section                 = NULL;
-	libfcache_cache_t *sections_cache         = NULL;
-	uint8_t *string_data                      = NULL;
-	static char *function                     = "libewf_internal_handle_open_read_segment_file_section_data";
-	off64_t section_data_offset               = 0;
-	size_t string_data_size                   = 0;
-	ssize_t read_count                        = 0;
-	int initialize_chunk_values               = 0;
-	int header_section_found                  = 0;
-	int number_of_sections                    = 0;
-	int section_index                         = 0;
-	int set_identifier_change                 = 0;
-	int single_files_section_found            = 0;
-	int read_table_sections                   = 0;
-	int result                                = 0;
-
-#if defined( HAVE_VERBOSE_OUTPUT )
-	int known_section                         = 0;
-#endif
+	libbfio_handle_t *file_io_handle          = NULL;
+	libbfio_pool_t *file_io_pool              = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	libewf_segment_table_t *segment_table     = NULL;
+	wchar_t *first_segment_filename           = NULL;
+	static char *function                     = "libewf_handle_open_wide";
+	size_t filename_length                    = 0;
+	int access_behavior                       = 0;
+	int file_io_pool_entry                    = 0;
+	int filename_index                        = 0;
+	int io_engine                             = 0;
+	int maximum_number_of_open_handles        = 0;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1648,135 +1886,429 @@ int libewf_internal_handle_open_read_segment_file_section_data(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-		return( -1 );
-	}
-	if( internal_handle->read_io_handle == NULL )
+	if( filenames == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing read IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	if( number_of_filenames <= 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of files zero or less.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->single_files == NULL )
+	if( libewf_internal_handle_get_open_values(
+	     internal_handle,
+	     access_flags,
+	     &maximum_number_of_open_handles,
+	     &io_engine,
+	     &access_behavior,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing single files.",
-		 function );
-
-		return( -1 );
-	}
-	if( segment_file == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment file.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve open values.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfcache_cache_initialize(
-	     &sections_cache,
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     0,
+	     maximum_number_of_open_handles,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sections cache.",
+		 "%s: unable to create file IO pool.",
 		 function );
 
 		goto on_error;
 	}
-	if( libewf_header_sections_initialize(
-	     &header_sections,
-	     error ) != 1 )
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create header sections.",
-		 function );
+		for( filename_index = 0;
+		     filename_index < number_of_filenames;
+		     filename_index++ )
+		{
+			filename_length = wide_string_length(
+					   filenames[ filename_index ] );
 
-		goto on_error;
+			/* Make sure there is more to the filename than the extension
+			 */
+			if( filename_length <= 4 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: filename: %ls is too small.",
+				 function,
+				 filenames[ filename_index ] );
+
+				goto on_error;
+			}
+			if( libewf_internal_handle_initialize_file_io_handle_wide(
+			     &file_io_handle,
+			     filenames[ filename_index ],
+			     filename_length,
+			     io_engine,
+			     access_behavior,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create file IO handle.",
+				 function );
+
+				goto on_error;
+			}
+			if( libbfio_pool_append_handle(
+			     file_io_pool,
+			     &file_io_pool_entry,
+			     file_io_handle,
+			     LIBBFIO_OPEN_READ,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append file IO handle to pool.",
+				 function );
+
+				goto on_error;
+			}
+			file_io_handle = NULL;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: added file IO pool entry: %d with filename: %ls.\n",
+				 function,
+				 file_io_pool_entry,
+				 filenames[ filename_index ] );
+			}
+#endif
+			if( ( filenames[ filename_index ][ filename_length - 3 ] == 'e' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'E' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'l' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'L' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 's' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'S' ) )
+			{
+				if( ( filenames[ filename_index ][ filename_length - 2 ] == '0' )
+				 && ( filenames[ filename_index ][ filename_length - 1 ] == '1' ) )
+				{
+					first_segment_filename = filenames[ filename_index ];
+				}
+			}
+		}
 	}
-	if( libfdata_list_get_number_of_elements(
-	     segment_file->sections_list,
-	     &number_of_sections,
+	if( libewf_segment_table_initialize(
+	     &segment_table,
+	     internal_handle->io_handle,
+	     LIBEWF_DEFAULT_SEGMENT_FILE_SIZE,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve the number of sections in the sections list.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment table.",
 		 function );
 
 		goto on_error;
 	}
-	/* Make sure to read the device information section first so we
-	 * have the correct chunk size when reading Lx01 files.
-	 */
-	if( segment_file->device_information_section_index >= 0 )
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
 	{
-		if( libfdata_list_get_element_value_by_index(
-		     segment_file->sections_list,
-		     (intptr_t *) file_io_pool,
-		     sections_cache,
-		     segment_file->device_information_section_index,
-		     (intptr_t **) &section,
-		     0,
-		     error ) != 1 )
+		/* Get the basename of the first segment file
+		 */
+		if( first_segment_filename != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve section: %d from sections list.",
-			 function,
-			 segment_file->device_information_section_index );
+			filename_length = wide_string_length(
+					   first_segment_filename );
 
-			goto on_error;
+			/* Set segment table basename
+			 */
+			if( libewf_segment_table_set_basename_wide(
+			     segment_table,
+			     first_segment_filename,
+			     filename_length - 4,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set basename in segment table.",
+				 function );
+
+				goto on_error;
+			}
 		}
-		if( section == NULL )
+	}
+	else if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		/* Get the basename and store it in the segment tables
+		 */
+		filename_length = wide_string_length(
+				   filenames[ 0 ] );
+
+		/* Set segment table basename
+		 */
+		if( libewf_segment_table_set_basename_wide(
+		     segment_table,
+		     filenames[ 0 ],
+		     filename_length,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing section: %d.",
-			 function,
-			 segment_file->device_information_section_index );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set basename in segment table.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_internal_handle_open_created_file_io_pool(
+	     internal_handle,
+	     file_io_pool,
+	     access_flags,
+	     segment_table,
+	     io_engine,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle using a file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( segment_table != NULL )
+	{
+		libewf_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Reads the section data from a segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_read_segment_file_section_data(
+     libewf_internal_handle_t *internal_handle,
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	libewf_header_sections_t *header_sections = NULL;
+	libewf_section_t *section                 = NULL;
+	libfcache_cache_t *sections_cache         = NULL;
+	uint8_t *string_data                      = NULL;
+	static char *function                     = "libewf_internal_handle_open_read_segment_file_section_data";
+	off64_t section_data_offset               = 0;
+	size_t string_data_size                   = 0;
+	ssize_t read_count                        = 0;
+	int initialize_chunk_values               = 0;
+	int header_section_found                  = 0;
+	int number_of_sections                    = 0;
+	int section_index                         = 0;
+	int set_identifier_change                 = 0;
+	int single_files_section_found            = 0;
+	int read_table_sections                   = 0;
+	int result                                = 0;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+	int known_section                         = 0;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->read_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing read IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing single files.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_initialize(
+	     &sections_cache,
+	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sections cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_header_sections_initialize(
+	     &header_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create header sections.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of sections in the sections list.",
+		 function );
+
+		goto on_error;
+	}
+	/* Make sure to read the device information section first so we
+	 * have the correct chunk size when reading Lx01 files.
+	 */
+	if( segment_file->device_information_section_index >= 0 )
+	{
+		if( libfdata_list_get_element_value_by_index(
+		     segment_file->sections_list,
+		     (intptr_t *) file_io_pool,
+		     sections_cache,
+		     segment_file->device_information_section_index,
+		     (intptr_t **) &section,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d from sections list.",
+			 function,
+			 segment_file->device_information_section_index );
+
+			goto on_error;
+		}
+		if( section == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing section: %d.",
+			 function,
+			 segment_file->device_information_section_index );
 
 			goto on_error;
 		}
@@ -2922,23 +3454,32 @@ on_error:
 	return( -1 );
 }
 
-/* Opens the segment files for reading
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Reads segment files in parallel
+ * The segment files that were read are stored in the segment table, a segment file
+ * that could not be read is read again when it is retrieved from the segment table
  * Returns 1 if successful or -1 on error
  */
-int libewf_internal_handle_open_read_segment_files(
+int libewf_internal_handle_open_read_segment_files_in_parallel(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
+     uint32_t first_segment_number,
+     uint32_t number_of_segments,
      libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_open_read_segment_files";
-	size64_t maximum_segment_size       = 0;
-	size64_t segment_file_size          = 0;
-	uint32_t number_of_segments         = 0;
-	uint32_t segment_number             = 0;
-	int file_io_pool_entry              = 0;
-	int last_segment_file               = 0;
+	libewf_segment_file_reader_t *segment_file_readers[ LIBEWF_OPEN_READ_NUMBER_OF_SEGMENT_FILES ];
+
+	libbfio_handle_t *file_io_handle         = NULL;
+	libbfio_handle_t *segment_file_io_handle = NULL;
+	libcthreads_thread_pool_t *thread_pool   = NULL;
+	static char *function                    = "libewf_internal_handle_open_read_segment_files_in_parallel";
+	size64_t segment_file_size               = 0;
+	uint32_t reader_index                    = 0;
+	uint32_t segment_number                  = 0;
+	int file_io_pool_entry                   = 0;
+	int number_of_threads                    = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -2962,57 +3503,52 @@ int libewf_internal_handle_open_read_segment_files(
 
 		return( -1 );
 	}
-	if( internal_handle->read_io_handle == NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - missing read IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_table == NULL )
+	if( ( number_of_segments == 0 )
+	 || ( number_of_segments > LIBEWF_OPEN_READ_NUMBER_OF_SEGMENT_FILES ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment table.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_table_get_number_of_segments(
-	     segment_table,
-	     &number_of_segments,
-	     error ) != 1 )
+	if( memory_set(
+	     segment_file_readers,
+	     0,
+	     sizeof( libewf_segment_file_reader_t * ) * LIBEWF_OPEN_READ_NUMBER_OF_SEGMENT_FILES ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments from segment table.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment file readers.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_segments == 0 )
+	/* The file IO pool is not thread safe, hence every segment file
+	 * is read using its own file IO handle
+	 */
+	for( reader_index = 0;
+	     reader_index < number_of_segments;
+	     reader_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid number of segments value out of bounds.",
-		 function );
+		segment_number = first_segment_number + reader_index;
 
-		return( -1 );
-	}
-	for( segment_number = 0;
-	     segment_number < number_of_segments;
-	     segment_number++ )
-	{
 		if( libewf_segment_table_get_segment_by_index(
 		     segment_table,
 		     segment_number,
@@ -3028,239 +3564,219 @@ int libewf_internal_handle_open_read_segment_files(
 			 function,
 			 segment_number );
 
-			return( -1 );
-		}
-		if( ( segment_number == 0 )
-		 && ( number_of_segments > 1 ) )
-		{
-			/* Round the maximum segment size to nearest number of KiB
-			 */
-			maximum_segment_size = ( segment_file_size >> 10 ) << 10;
-
-			if( libewf_segment_table_set_maximum_segment_size(
-			     segment_table,
-			     maximum_segment_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set maximum segment size in segment table.",
-				 function );
-
-				return( -1 );
-			}
+			goto on_error;
 		}
-		if( libewf_segment_table_get_segment_file_by_index(
-		     segment_table,
-		     segment_number,
+		if( libbfio_pool_get_handle(
 		     file_io_pool,
-		     &segment_file,
+		     file_io_pool_entry,
+		     &file_io_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 "%s: unable to retrieve file IO handle: %d from pool.",
 			 function,
-			 segment_number );
+			 file_io_pool_entry );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( segment_file == NULL )
+		if( libbfio_handle_clone(
+		     &segment_file_io_handle,
+		     file_io_handle,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing segment file: %" PRIu32 ".",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment file: %" PRIu32 " IO handle.",
 			 function,
 			 segment_number );
 
-			return( -1 );
-		}
-		if( segment_file->segment_number != ( segment_number + 1 ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_INPUT,
-			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-			 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
-			 function,
-			 segment_file->segment_number,
-			 segment_number + 1 );
-
-			return( -1 );
-		}
-		if( segment_file->segment_number == 1 )
-		{
-			internal_handle->io_handle->segment_file_type  = segment_file->type;
-			internal_handle->io_handle->major_version      = segment_file->major_version;
-			internal_handle->io_handle->minor_version      = segment_file->minor_version;
-			internal_handle->io_handle->compression_method = segment_file->compression_method;
-
-			if( segment_file->major_version == 2 )
-			{
-				if( memory_copy(
-				     internal_handle->media_values->set_identifier,
-				     segment_file->set_identifier,
-				     16 ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-					 "%s: unable to copy segment file set identifier to media values.",
-					 function );
-
-					return( -1 );
-				}
-			}
-		}
-		else
-		{
-			if( ( segment_file->major_version != internal_handle->io_handle->major_version )
-			 || ( segment_file->minor_version != internal_handle->io_handle->minor_version ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_INPUT,
-				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-				 "%s: segment file format version value mismatch.",
-				 function );
-
-				return( -1 );
-			}
-			if( internal_handle->io_handle->major_version == 2 )
-			{
-				if( segment_file->compression_method != internal_handle->io_handle->compression_method )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_INPUT,
-					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-					 "%s: segment file compression method value mismatch.",
-					 function );
-
-					return( -1 );
-				}
-				if( memory_compare(
-				     internal_handle->media_values->set_identifier,
-				     segment_file->set_identifier,
-				     16 ) != 0 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_INPUT,
-					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-					 "%s: segment file set identifier value mismatch.",
-					 function );
-
-					return( -1 );
-				}
-			}
-		}
-		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_LAST ) != 0 )
-		{
-			last_segment_file = 1;
-		}
-		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED ) != 0 )
-		{
-/* TODO get key info */
-			internal_handle->io_handle->format       = LIBEWF_FORMAT_V2_ENCASE7;
-			internal_handle->io_handle->is_encrypted = 1;
-		}
-		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
-		{
-			segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+			goto on_error;
 		}
-		if( libewf_internal_handle_open_read_segment_file_section_data(
-		     internal_handle,
-		     segment_file,
-		     file_io_pool,
+		if( libewf_segment_file_reader_initialize(
+		     &( segment_file_readers[ reader_index ] ),
+		     internal_handle->io_handle,
+		     &segment_file_io_handle,
 		     file_io_pool_entry,
+		     segment_file_size,
+		     internal_handle->media_values->chunk_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read section data from segment file: %" PRIu32 ".",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment file: %" PRIu32 " reader.",
 			 function,
 			 segment_number );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( libewf_segment_table_set_segment_storage_media_size_by_index(
-		     segment_table,
-		     segment_number,
-		     segment_file->storage_media_size,
-		     error ) != 1 )
+	}
+	number_of_threads = (int) number_of_segments;
+
+	if( number_of_threads > LIBEWF_MAXIMUM_OPEN_READ_NUMBER_OF_THREADS )
+	{
+		number_of_threads = LIBEWF_MAXIMUM_OPEN_READ_NUMBER_OF_THREADS;
+	}
+	if( libcthreads_thread_pool_create(
+	     &thread_pool,
+	     NULL,
+	     number_of_threads,
+	     (int) number_of_segments,
+	     (int (*)(intptr_t *, void *)) &libewf_segment_file_reader_read_callback,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	for( reader_index = 0;
+	     reader_index < number_of_segments;
+	     reader_index++ )
+	{
+		if( libcthreads_thread_pool_push(
+		     thread_pool,
+		     (intptr_t *) segment_file_readers[ reader_index ],
+		     error ) == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to set mapped range of element: %" PRIu32 " in segment table.",
-			 function,
-			 segment_number );
+			 "%s: unable to push segment file reader onto queue.",
+			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		internal_handle->read_io_handle->storage_media_size_read += segment_file->storage_media_size;
-		internal_handle->read_io_handle->number_of_chunks_read   += segment_file->number_of_chunks;
 	}
-	if( last_segment_file == 0 )
+	if( libcthreads_thread_pool_join(
+	     &thread_pool,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing done section.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join thread pool.",
 		 function );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		goto on_error;
+	}
+	/* The segment files are stored in order after all of them have been read
+	 */
+	for( reader_index = 0;
+	     reader_index < number_of_segments;
+	     reader_index++ )
+	{
+		segment_number = first_segment_number + reader_index;
+
+		if( segment_file_readers[ reader_index ]->segment_file != NULL )
 		{
-			if( ( error != NULL )
-			 && ( *error != NULL ) )
+			if( libewf_segment_table_set_segment_file_by_index(
+			     segment_table,
+			     file_io_pool,
+			     segment_number,
+			     segment_file_readers[ reader_index ]->segment_file,
+			     error ) != 1 )
 			{
-				libcnotify_print_error_backtrace(
-				 *error );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set segment file: %" PRIu32 " in segment table.",
+				 function,
+				 segment_number );
+
+				goto on_error;
 			}
+			segment_file_readers[ reader_index ]->segment_file = NULL;
 		}
-#endif
-		libcerror_error_free(
-		 error );
+		if( libewf_segment_file_reader_free(
+		     &( segment_file_readers[ reader_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment file: %" PRIu32 " reader.",
+			 function,
+			 segment_number );
 
-		segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+			goto on_error;
+		}
 	}
 	return( 1 );
+
+on_error:
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	if( segment_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &segment_file_io_handle,
+		 NULL );
+	}
+	for( reader_index = 0;
+	     reader_index < number_of_segments;
+	     reader_index++ )
+	{
+		if( segment_file_readers[ reader_index ] != NULL )
+		{
+			libewf_segment_file_reader_free(
+			 &( segment_file_readers[ reader_index ] ),
+			 NULL );
+		}
+	}
+	return( -1 );
 }
 
-/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
- * This function is not multi-thread safe acquire write lock before call
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Opens the segment files for reading
+ * If lazy open is set only the first and last segment file are read
+ * the other segment files are read on demand
  * Returns 1 if successful or -1 on error
  */
-int libewf_internal_handle_open_file_io_pool(
+int libewf_internal_handle_open_read_segment_files(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
-     int access_flags,
      libewf_segment_table_t *segment_table,
+     uint8_t lazy_open,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle    = NULL;
 	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_open_file_io_pool";
+	static char *function               = "libewf_internal_handle_open_read_segment_files";
+	size64_t maximum_segment_size       = 0;
 	size64_t segment_file_size          = 0;
-	ssize_t read_count                  = 0;
+	size64_t storage_media_size         = 0;
+	uint32_t number_of_segments         = 0;
+	uint32_t segment_number             = 0;
 	int file_io_pool_entry              = 0;
-	int number_of_file_io_handles       = 0;
+	int last_segment_file               = 0;
 
-	if( internal_handle == NULL )
-	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	uint32_t number_of_parallel_segments = 0;
+	uint32_t parallel_segment_number     = 1;
+#endif
+
+	if( internal_handle == NULL )
+	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
@@ -3270,17 +3786,6 @@ int libewf_internal_handle_open_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->file_io_pool != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - file IO pool value already set.",
-		 function );
-
-		return( -1 );
-	}
 	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -3292,561 +3797,688 @@ int libewf_internal_handle_open_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_table != NULL )
+	if( internal_handle->read_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk table value already set.",
+		 "%s: invalid handle - missing read IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_groups_cache != NULL )
+	if( segment_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunks group cache value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunks_cache != NULL )
+	if( libewf_segment_table_get_number_of_segments(
+	     segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunks cache value already set.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->hash_sections != NULL )
+	if( number_of_segments == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - hash sections value already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->single_files != NULL )
+	for( segment_number = 0;
+	     segment_number < number_of_segments;
+	     segment_number++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - single files value already set.",
-		 function );
+		if( libewf_segment_table_get_segment_by_index(
+		     segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
 
-		return( -1 );
-	}
-	if( file_io_pool == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file IO pool.",
-		 function );
+			return( -1 );
+		}
+		if( ( segment_number == 0 )
+		 && ( number_of_segments > 1 ) )
+		{
+			/* Round the maximum segment size to nearest number of KiB
+			 */
+			maximum_segment_size = ( segment_file_size >> 10 ) << 10;
 
-		return( -1 );
-	}
-	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
-	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported access flags.",
-		 function );
+			if( libewf_segment_table_set_maximum_segment_size(
+			     segment_table,
+			     maximum_segment_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum segment size in segment table.",
+				 function );
 
-		return( -1 );
-	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
-	{
-		if( libewf_read_io_handle_initialize(
-		     &( internal_handle->read_io_handle ),
+				return( -1 );
+			}
+		}
+		if( ( lazy_open != 0 )
+		 && ( segment_number > 0 )
+		 && ( segment_number < ( number_of_segments - 1 ) ) )
+		{
+			/* The storage media range of the segment file is mapped when it is read
+			 */
+			if( libewf_segment_table_set_segment_storage_media_size_by_index(
+			     segment_table,
+			     segment_number,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set mapped range of element: %" PRIu32 " in segment table.",
+				 function,
+				 segment_number );
+
+				return( -1 );
+			}
+			continue;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		/* The first segment file is read before the others since it
+		 * provides the values needed to read the others, e.g. the chunk size
+		 */
+		if( ( lazy_open == 0 )
+		 && ( segment_number == parallel_segment_number ) )
+		{
+			number_of_parallel_segments = number_of_segments - segment_number;
+
+			if( number_of_parallel_segments > LIBEWF_OPEN_READ_NUMBER_OF_SEGMENT_FILES )
+			{
+				number_of_parallel_segments = LIBEWF_OPEN_READ_NUMBER_OF_SEGMENT_FILES;
+			}
+			if( number_of_parallel_segments > 1 )
+			{
+				if( libewf_internal_handle_open_read_segment_files_in_parallel(
+				     internal_handle,
+				     file_io_pool,
+				     segment_table,
+				     segment_number,
+				     number_of_parallel_segments,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read segment files: %" PRIu32 " - %" PRIu32 " in parallel.",
+					 function,
+					 segment_number,
+					 segment_number + number_of_parallel_segments - 1 );
+
+					return( -1 );
+				}
+			}
+			parallel_segment_number += number_of_parallel_segments;
+		}
+#endif
+		if( libewf_segment_table_get_segment_file_by_index(
+		     segment_table,
+		     segment_number,
+		     file_io_pool,
+		     &segment_file,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create read IO handle.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
 
-			goto on_error;
+			return( -1 );
 		}
-	}
-	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
-	{
-		if( libewf_write_io_handle_initialize(
-		     &( internal_handle->write_io_handle ),
-		     error ) != 1 )
+		if( segment_file == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create write IO handle.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
 
-			goto on_error;
+			return( -1 );
 		}
-	}
-	if( libewf_chunk_table_initialize(
-	     &( internal_handle->chunk_table ),
-	     internal_handle->io_handle,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk table.",
-		 function );
+		if( segment_file->segment_number != ( segment_number + 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
+			 function,
+			 segment_file->segment_number,
+			 segment_number + 1 );
 
-		goto on_error;
-	}
-	if( libfcache_cache_initialize(
-	     &( internal_handle->chunk_groups_cache ),
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNK_GROUPS,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk groups cache.",
-		 function );
+			return( -1 );
+		}
+		if( segment_file->segment_number == 1 )
+		{
+			internal_handle->io_handle->segment_file_type  = segment_file->type;
+			internal_handle->io_handle->major_version      = segment_file->major_version;
+			internal_handle->io_handle->minor_version      = segment_file->minor_version;
+			internal_handle->io_handle->compression_method = segment_file->compression_method;
 
-		goto on_error;
-	}
-	if( libfcache_cache_initialize(
-	     &( internal_handle->chunks_cache ),
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunks cache.",
-		 function );
+			if( segment_file->major_version == 2 )
+			{
+				if( memory_copy(
+				     internal_handle->media_values->set_identifier,
+				     segment_file->set_identifier,
+				     16 ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy segment file set identifier to media values.",
+					 function );
 
-		goto on_error;
-	}
-	if( libewf_header_values_initialize(
-	     &( internal_handle->header_values ),
-	     error ) != 1 )
+					return( -1 );
+				}
+			}
+		}
+		else
+		{
+			if( ( segment_file->major_version != internal_handle->io_handle->major_version )
+			 || ( segment_file->minor_version != internal_handle->io_handle->minor_version ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+				 "%s: segment file format version value mismatch.",
+				 function );
+
+				return( -1 );
+			}
+			if( internal_handle->io_handle->major_version == 2 )
+			{
+				if( segment_file->compression_method != internal_handle->io_handle->compression_method )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_INPUT,
+					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+					 "%s: segment file compression method value mismatch.",
+					 function );
+
+					return( -1 );
+				}
+				if( memory_compare(
+				     internal_handle->media_values->set_identifier,
+				     segment_file->set_identifier,
+				     16 ) != 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_INPUT,
+					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+					 "%s: segment file set identifier value mismatch.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_LAST ) != 0 )
+		{
+			last_segment_file = 1;
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED ) != 0 )
+		{
+/* TODO get key info */
+			internal_handle->io_handle->format       = LIBEWF_FORMAT_V2_ENCASE7;
+			internal_handle->io_handle->is_encrypted = 1;
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
+		{
+			segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+		}
+		if( libewf_internal_handle_open_read_segment_file_section_data(
+		     internal_handle,
+		     segment_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read section data from segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( ( internal_handle->io_handle->chunk_index != NULL )
+		 && ( internal_handle->io_handle->chunk_index->chunk_size != internal_handle->media_values->chunk_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: chunk index chunk size value mismatch.",
+			 function );
+
+			return( -1 );
+		}
+		/* With lazy open the storage media range of the last segment file
+		 * is mapped after the storage media ranges of the preceding segment files
+		 */
+		if( ( lazy_open != 0 )
+		 && ( segment_number > 0 ) )
+		{
+			storage_media_size = 0;
+		}
+		else
+		{
+			storage_media_size = segment_file->storage_media_size;
+		}
+		if( libewf_segment_table_set_segment_storage_media_size_by_index(
+		     segment_table,
+		     segment_number,
+		     storage_media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to set mapped range of element: %" PRIu32 " in segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( storage_media_size != 0 )
+		{
+			internal_handle->read_io_handle->storage_media_size_read += segment_file->storage_media_size;
+			internal_handle->read_io_handle->number_of_chunks_read   += segment_file->number_of_chunks;
+		}
+	}
+	if( lazy_open != 0 )
+	{
+		internal_handle->number_of_mapped_segments = 1;
+	}
+	else
+	{
+		internal_handle->number_of_mapped_segments = number_of_segments;
+	}
+	if( last_segment_file == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create header values.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing done section.",
 		 function );
 
-		goto on_error;
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
 	}
-	if( libewf_hash_sections_initialize(
-	     &( internal_handle->hash_sections ),
-	     error ) != 1 )
+	return( 1 );
+}
+
+/* Reads the segment files deferred by lazy open up to and including the segment file
+ * that contains the storage media offset
+ * The storage media ranges are mapped in order since they are relative to the preceding segment files
+ * This function is not multi-thread safe acquire read chunk mutex or write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_deferred_segment_files(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t storage_media_offset,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_read_deferred_segment_files";
+	size64_t segment_file_size          = 0;
+	uint32_t number_of_segments         = 0;
+	uint32_t segment_number             = 0;
+	int file_io_pool_entry              = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create hash sections.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_single_files_initialize(
-	     &( internal_handle->single_files ),
-	     error ) != 1 )
+	if( internal_handle->read_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create single files.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing read IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_handle->sessions,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty sessions array.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_handle->tracks,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
+	if( internal_handle->segment_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty tracks array.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_range_list_empty(
-	     internal_handle->acquiry_errors,
-	     NULL,
+	if( storage_media_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid storage media offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty acquiry errors range list.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	while( ( internal_handle->number_of_mapped_segments < number_of_segments )
+	    && ( internal_handle->read_io_handle->storage_media_size_read <= (size64_t) storage_media_offset ) )
 	{
-		if( libbfio_pool_get_number_of_handles(
-		     file_io_pool,
-		     &number_of_file_io_handles,
+		segment_number = internal_handle->number_of_mapped_segments;
+
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve the number of handles in the pool.",
-			 function );
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( libewf_segment_file_initialize(
+		if( libewf_segment_table_get_segment_file_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     file_io_pool,
 		     &segment_file,
-		     internal_handle->io_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create segment file.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
 
-			goto on_error;
-		}
-		for( file_io_pool_entry = 0;
-		     file_io_pool_entry < number_of_file_io_handles;
-		     file_io_pool_entry++ )
-		{
-			if( libbfio_pool_get_size(
-			     file_io_pool,
-			     file_io_pool_entry,
-			     &segment_file_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve size of file IO pool entry: %d.",
-				 function,
-				 file_io_pool_entry );
-
-				goto on_error;
-			}
-			if( libbfio_pool_get_handle(
-			     file_io_pool,
-			     file_io_pool_entry,
-			     &file_io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to retrieve file IO handle: %d from pool.",
-				 function,
-				 file_io_pool_entry );
-
-				goto on_error;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: processing file IO pool entry: %d.\n",
-				 function,
-				 file_io_pool_entry );
-			}
-#endif
-			read_count = libewf_segment_file_read_file_header(
-				      segment_file,
-				      file_io_pool,
-				      file_io_pool_entry,
-				      error );
-
-			if( read_count < 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read segment file header.",
-				 function );
-
-				goto on_error;
-			}
-			if( segment_file->segment_number == 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_INPUT,
-				 LIBCERROR_INPUT_ERROR_INVALID_DATA,
-				 "%s: invalid segment number: 0 in file IO pool entry: %d.",
-				 function,
-				 file_io_pool_entry );
-
-				goto on_error;
-			}
-			if( libewf_segment_table_append_segment_by_segment_file(
-			     segment_table,
-			     segment_file,
-			     file_io_pool_entry,
-			     segment_file_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append segment: %" PRIu32 " to segment table.",
-				 function,
-				 segment_file->segment_number );
-
-				goto on_error;
-			}
+			return( -1 );
 		}
-		if( libewf_segment_file_free(
-		     &segment_file,
-		     error ) != 1 )
+		if( segment_file == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free segment file.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( libewf_internal_handle_open_read_segment_files(
-		     internal_handle,
-		     file_io_pool,
-		     segment_table,
-		     error ) != 1 )
+		if( segment_file->segment_number != ( segment_number + 1 ) )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read segment files.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
+			 function,
+			 segment_file->segment_number,
+			 segment_number + 1 );
 
-			if( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 )
-			{
-				goto on_error;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				if( ( error != NULL )
-				 && ( *error != NULL ) )
-				{
-					libcnotify_print_error_backtrace(
-					 *error );
-				}
-			}
-#endif
-			libcerror_error_free(
-			 error );
+			return( -1 );
 		}
-		if( internal_handle->media_values == NULL )
+		if( ( segment_file->major_version != internal_handle->io_handle->major_version )
+		 || ( segment_file->minor_version != internal_handle->io_handle->minor_version ) )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid handle - missing media values.",
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: segment file format version value mismatch.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-/* TODO refactor */
-		if( internal_handle->single_files->ltree_data == NULL )
+		if( internal_handle->io_handle->major_version == 2 )
 		{
-			if( libewf_internal_handle_get_media_values(
-			     internal_handle,
-			     &( internal_handle->media_values->media_size ),
-			     error ) != 1 )
+			if( segment_file->compression_method != internal_handle->io_handle->compression_method )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine media values.",
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+				 "%s: segment file compression method value mismatch.",
 				 function );
 
-				goto on_error;
+				return( -1 );
 			}
-		}
-	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
-	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
-	{
-		if( internal_handle->write_io_handle->values_initialized == 0 )
-		{
-			if( libewf_write_io_handle_initialize_values(
-			     internal_handle->write_io_handle,
-			     internal_handle->io_handle,
-			     internal_handle->media_values,
-			     segment_table,
-			     error ) != 1 )
+			if( memory_compare(
+			     internal_handle->media_values->set_identifier,
+			     segment_file->set_identifier,
+			     16 ) != 0 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to initialize write IO handle values.",
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+				 "%s: segment file set identifier value mismatch.",
 				 function );
 
-				goto on_error;
+				return( -1 );
 			}
 		}
-		if( libewf_write_io_handle_initialize_resume(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     segment_table,
-		     internal_handle->chunk_table,
-		     internal_handle->read_io_handle,
-		     &( internal_handle->current_offset ),
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
+		{
+			internal_handle->segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+		}
+		if( libewf_segment_table_set_segment_storage_media_size_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     segment_file->storage_media_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle to resume.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set mapped range of element: %" PRIu32 " in segment table.",
+			 function,
+			 segment_number );
 
-			goto on_error;
+			return( -1 );
 		}
-	}
-			internal_handle->io_handle->chunk_size = internal_handle->media_values->chunk_size;
-	internal_handle->io_handle->access_flags = access_flags;
-	internal_handle->file_io_pool            = file_io_pool;
-	internal_handle->segment_table           = segment_table;
+		internal_handle->read_io_handle->storage_media_size_read += segment_file->storage_media_size;
+		internal_handle->read_io_handle->number_of_chunks_read   += segment_file->number_of_chunks;
 
+		internal_handle->number_of_mapped_segments += 1;
+	}
 	return( 1 );
+}
 
-on_error:
-	if( segment_file != NULL )
+/* Determines the number of chunk groups cache entries from the chunk groups cache size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_get_chunk_groups_cache_number_of_entries(
+     libewf_internal_handle_t *internal_handle,
+     int *number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function           = "libewf_internal_handle_get_chunk_groups_cache_number_of_entries";
+	size64_t chunk_group_size       = 0;
+	size64_t number_of_chunk_groups = 0;
+
+	if( internal_handle == NULL )
 	{
-		libewf_segment_file_free(
-		 &segment_file,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
 	}
-	if( internal_handle->single_files != NULL )
+	if( number_of_entries == NULL )
 	{
-		libewf_single_files_free(
-		 &( internal_handle->single_files ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
+		 function );
+
+		return( -1 );
 	}
-	if( internal_handle->hash_sections != NULL )
+	if( internal_handle->chunk_groups_cache_size == 0 )
 	{
-		libewf_hash_sections_free(
-		 &( internal_handle->hash_sections ),
-		 NULL );
+		*number_of_entries = LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNK_GROUPS;
+
+		return( 1 );
 	}
-	if( internal_handle->header_values != NULL )
-	{
-		libfvalue_table_free(
-		 &( internal_handle->header_values ),
-		 NULL );
-	}
-	if( internal_handle->chunks_cache != NULL )
-	{
-		libfcache_cache_free(
-		 &( internal_handle->chunks_cache ),
-		 NULL );
-	}
-	if( internal_handle->chunk_groups_cache != NULL )
-	{
-		libfcache_cache_free(
-		 &( internal_handle->chunk_groups_cache ),
-		 NULL );
-	}
-	if( internal_handle->chunk_table != NULL )
-	{
-		libewf_chunk_table_free(
-		 &( internal_handle->chunk_table ),
-		 NULL );
-	}
-	if( internal_handle->write_io_handle != NULL )
+	/* A chunk group contains at most the maximum number of table entries
+	 * where each chunk requires an estimated amount of memory
+	 */
+	chunk_group_size = (size64_t) LIBEWF_CHUNK_GROUP_ESTIMATED_SIZE_PER_CHUNK * LIBEWF_MAXIMUM_TABLE_ENTRIES_EWF;
+
+	number_of_chunk_groups = internal_handle->chunk_groups_cache_size / chunk_group_size;
+
+	if( number_of_chunk_groups == 0 )
 	{
-		libewf_write_io_handle_free(
-		 &( internal_handle->write_io_handle ),
-		 error );
+		number_of_chunk_groups = 1;
 	}
-	if( internal_handle->read_io_handle != NULL )
+	else if( number_of_chunk_groups > (size64_t) LIBEWF_MAXIMUM_CHUNK_GROUPS_CACHE_NUMBER_OF_ENTRIES )
 	{
-		libewf_read_io_handle_free(
-		 &( internal_handle->read_io_handle ),
-		 error );
+		number_of_chunk_groups = LIBEWF_MAXIMUM_CHUNK_GROUPS_CACHE_NUMBER_OF_ENTRIES;
 	}
-	return( -1 );
+	*number_of_entries = (int) number_of_chunk_groups;
+
+	return( 1 );
 }
 
-/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+/* Initializes the chunk cache if the handle was opened for reading only
+ * and the chunk cache size is set
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_open_file_io_pool(
-     libewf_handle_t *handle,
-     libbfio_pool_t *file_io_pool,
-     int access_flags,
+int libewf_internal_handle_initialize_chunk_cache(
+     libewf_internal_handle_t *internal_handle,
      libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	libewf_segment_table_t *segment_table     = NULL;
-	static char *function                     = "libewf_handle_open_file_io_pool";
-	int result                                = 0;
+	static char *function = "libewf_internal_handle_initialize_chunk_cache";
+	int number_of_shards  = 1;
 
-	if( handle == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	size64_t minimum_size = 0;
+#endif
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -3857,109 +4489,103 @@ int libewf_handle_open_file_io_pool(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool != NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - file IO pool value already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_table_initialize(
-	     &segment_table,
-	     internal_handle->io_handle,
-	     LIBEWF_DEFAULT_SEGMENT_FILE_SIZE,
-	     error ) != 1 )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segment table.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->chunk_cache != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk cache value already set.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	result = libewf_internal_handle_open_file_io_pool(
-	          internal_handle,
-	          file_io_pool,
-	          access_flags,
-	          segment_table,
-	          error );
-
-	if( result != 1 )
+	/* The chunk cache is not invalidated on write
+	 */
+	if( ( ( internal_handle->io_handle->access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
+	 || ( internal_handle->chunk_cache_size == 0 )
+	 || ( internal_handle->media_values->chunk_size == 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open handle using a file IO pool.",
-		 function );
+		return( 1 );
+	}
+	/* The chunk cache size is a budget, no chunk cache is used if it cannot contain a single chunk
+	 */
+	if( internal_handle->chunk_cache_size < ( (size64_t) internal_handle->media_values->chunk_size + sizeof( libewf_chunk_cache_entry_t ) ) )
+	{
+		return( 1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	result = libcthreads_read_write_lock_release_for_write(
-	          internal_handle->read_write_lock,
-	          error );
+	/* Only use as many shards as can contain the minimum number of chunks
+	 */
+	minimum_size = (size64_t) internal_handle->media_values->chunk_size * LIBEWF_MINIMUM_CHUNK_CACHE_NUMBER_OF_ENTRIES;
 
-	if( result != 1 )
+	for( number_of_shards = LIBEWF_CHUNK_CACHE_NUMBER_OF_SHARDS;
+	     number_of_shards > 1;
+	     number_of_shards /= 2 )
+	{
+		if( ( internal_handle->chunk_cache_size / number_of_shards ) >= minimum_size )
+		{
+			break;
+		}
+	}
+#endif
+	if( libewf_sharded_chunk_cache_initialize(
+	     &( internal_handle->chunk_cache ),
+	     internal_handle->chunk_cache_size,
+	     internal_handle->media_values->chunk_size,
+	     number_of_shards,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk cache.",
 		 function );
-	}
-#endif
-	if( result != 1 )
-	{
-		goto on_error;
-	}
-	return( 1 );
 
-on_error:
-	if( segment_table != NULL )
-	{
-		libewf_segment_table_free(
-		 &segment_table,
-		 NULL );
+		return( -1 );
 	}
-	return( -1 );
+	return( 1 );
 }
 
-/* Closes the EWF handle
- * Returns 0 if successful or -1 on error
+/* Reads the chunk index
+ * The chunk index is only used if it matches the segment files
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if no matching chunk index is available or -1 on error
  */
-int libewf_handle_close(
-     libewf_handle_t *handle,
+int libewf_internal_handle_open_read_chunk_index(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int io_engine,
      libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_close";
-	ssize_t write_count                       = 0;
-	int result                                = 0;
+	libewf_chunk_index_t *chunk_index = NULL;
+	static char *function             = "libewf_internal_handle_open_read_chunk_index";
+	int result                        = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -3970,358 +4596,155 @@ int libewf_handle_close(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( ( internal_handle->write_io_handle != NULL )
-	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
+	if( internal_handle->chunk_index_filename == NULL )
 	{
-		write_count = libewf_internal_handle_write_finalize_file_io_pool(
-		               internal_handle,
-		               internal_handle->file_io_pool,
-		               error );
-
-		if( write_count < 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to finalize write.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk index filename.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-	if( internal_handle->file_io_pool_created_in_library != 0 )
+	if( internal_handle->chunk_index != NULL )
 	{
-		if( libbfio_pool_close_all(
-		     internal_handle->file_io_pool,
-		     error ) != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close all file IO pool handles.",
-			 function );
-
-			result = -1;
-		}
-		if( libbfio_pool_free(
-		     &( internal_handle->file_io_pool ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file IO pool.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk index value already set.",
+		 function );
 
-			result = -1;
-		}
-		internal_handle->file_io_pool_created_in_library = 0;
+		return( -1 );
 	}
-	internal_handle->file_io_pool = NULL;
-
-	if( libewf_io_handle_clear(
-	     internal_handle->io_handle,
+	if( libewf_chunk_index_initialize(
+	     &chunk_index,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk index.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( libewf_media_values_clear(
-	     internal_handle->media_values,
-	     error ) != 1 )
+	result = libewf_chunk_index_read_file(
+	          chunk_index,
+	          internal_handle->chunk_index_filename,
+	          internal_handle->chunk_index_filename_size - 1,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear media values.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk index.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( internal_handle->read_io_handle != NULL )
+	else if( result != 0 )
 	{
-		if( libewf_read_io_handle_free(
-		     &( internal_handle->read_io_handle ),
-		     error ) != 1 )
+		result = libewf_chunk_index_matches_file_io_pool(
+		          chunk_index,
+		          file_io_pool,
+		          io_engine,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free read IO handle.",
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to determine if chunk index matches segment files.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
 	}
-	if( internal_handle->write_io_handle != NULL )
+	if( result == 0 )
 	{
-		if( libewf_write_io_handle_free(
-		     &( internal_handle->write_io_handle ),
+		if( libewf_chunk_index_free(
+		     &chunk_index,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free write IO handle.",
+			 "%s: unable to free chunk index.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
+		return( 0 );
 	}
-	/* Free the chunk data if it could not be passed to libfcache_cache_set_value_by_index
-	 */
-	if( internal_handle->chunk_data != NULL )
-	{
-		if( libewf_chunk_data_free(
-		     &( internal_handle->chunk_data ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk data.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->segment_table != NULL )
-	{
-		if( libewf_segment_table_free(
-		     &( internal_handle->segment_table ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free segment table.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->chunk_table != NULL )
-	{
-		if( libewf_chunk_table_free(
-		     &( internal_handle->chunk_table ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk table.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->chunk_groups_cache != NULL )
-	{
-		if( libfcache_cache_free(
-		     &( internal_handle->chunk_groups_cache ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk groups cache.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->chunks_cache != NULL )
-	{
-		if( libfcache_cache_free(
-		     &( internal_handle->chunks_cache ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunks cache.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->hash_sections != NULL )
-	{
-		if( libewf_hash_sections_free(
-		     &( internal_handle->hash_sections ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free hash sections.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->header_values != NULL )
-	{
-		if( libfvalue_table_free(
-		     &( internal_handle->header_values ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free header values.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->hash_values != NULL )
-	{
-		if( libfvalue_table_free(
-		     &( internal_handle->hash_values ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free hash values.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->single_files != NULL )
-	{
-		if( libewf_single_files_free(
-		     &( internal_handle->single_files ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free single files.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( libcdata_array_empty(
-	     internal_handle->sessions,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty sessions array.",
-		 function );
-
-		result = -1;
-	}
-	if( libcdata_array_empty(
-	     internal_handle->tracks,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty tracks array.",
-		 function );
+	internal_handle->chunk_index            = chunk_index;
+	internal_handle->io_handle->chunk_index = chunk_index;
 
-		result = -1;
-	}
-	if( libcdata_range_list_empty(
-	     internal_handle->acquiry_errors,
-	     NULL,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty acquiry errors range list.",
-		 function );
+	return( 1 );
 
-		result = -1;
-	}
-/* TODO clear IO handle, segment tables */
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+on_error:
+	if( chunk_index != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
-
-		result = -1;
+		libewf_chunk_index_free(
+		 &chunk_index,
+		 NULL );
 	}
-#endif
-	return( result );
+	return( -1 );
 }
 
-/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
+/* Writes the chunk index
+ * The chunk index is built from the segment files read on open
  * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ * Returns 1 if successful, 0 if the chunk index cannot be represented or -1 on error
  */
-ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_internal_handle_write_chunk_index(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_read_buffer_from_file_io_pool";
-	off64_t chunk_data_offset       = 0;
-	uint64_t chunk_index            = 0;
-	size_t buffer_offset            = 0;
-	size_t read_size                = 0;
-	ssize_t total_read_count        = 0;
+	libbfio_handle_t *file_io_handle                  = NULL;
+	libewf_chunk_index_t *chunk_index                 = NULL;
+	libewf_chunk_index_segment_t *chunk_index_segment = NULL;
+	libewf_segment_file_t *segment_file               = NULL;
+	static char *function                             = "libewf_internal_handle_write_chunk_index";
+	off64_t chunk_group_data_offset                   = 0;
+	size64_t chunk_group_data_size                    = 0;
+	size64_t chunk_group_mapped_size                  = 0;
+	off64_t section_offset                            = 0;
+	size64_t section_size                             = 0;
+	size64_t segment_file_size                        = 0;
+	uint64_t number_of_chunks                         = 0;
+	uint32_t chunk_group_range_flags                  = 0;
+	uint32_t number_of_segments                       = 0;
+	uint32_t section_flags                            = 0;
+	uint32_t segment_index                            = 0;
+	int chunk_group_file_io_pool_entry                = 0;
+	int chunk_group_index                             = 0;
+	int file_io_pool_entry                            = 0;
+	int number_of_chunk_groups                        = 0;
+	int number_of_file_io_handles                     = 0;
+	int number_of_sections                            = 0;
+	int result                                        = 0;
+	int section_file_io_pool_entry                    = 0;
+	int section_index                                 = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -4345,192 +4768,463 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( internal_handle->chunk_index_filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk index filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
 		return( -1 );
 	}
 	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		return( 0 );
+	}
+	if( libbfio_pool_get_number_of_handles(
+	     internal_handle->file_io_pool,
+	     &number_of_file_io_handles,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of file IO handles.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( number_of_file_io_handles <= 0 )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_index_initialize(
+	     &chunk_index,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk index.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( libewf_chunk_index_set_number_of_segments(
+	     chunk_index,
+	     (uint32_t) number_of_file_io_handles,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of segments in chunk index.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	chunk_index->chunk_size = internal_handle->media_values->chunk_size;
+
+	if( memory_copy(
+	     chunk_index->set_identifier,
+	     internal_handle->media_values->set_identifier,
+	     16 ) == NULL )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		goto on_error;
 	}
-	if( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size )
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
 	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
 	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+	if( number_of_segments != (uint32_t) number_of_file_io_handles )
+	{
+		libewf_chunk_index_free(
+		 &chunk_index,
+		 NULL );
 
-	while( buffer_size > 0 )
+		return( 0 );
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
 	{
-		if( libewf_chunk_table_get_chunk_data_by_offset(
-		     internal_handle->chunk_table,
-		     chunk_index,
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
+		if( libewf_segment_table_get_segment_by_index(
 		     internal_handle->segment_table,
-		     internal_handle->chunk_groups_cache,
-		     internal_handle->chunks_cache,
-		     internal_handle->current_offset,
-		     &chunk_data,
-		     &chunk_data_offset,
+		     segment_index,
+		     &file_io_pool_entry,
+		     &segment_file_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
 			 function,
-			 chunk_index );
+			 segment_index );
 
-			return( -1 );
+			goto on_error;
+		}
+		if( ( file_io_pool_entry < 0 )
+		 || ( file_io_pool_entry >= number_of_file_io_handles ) )
+		{
+			libewf_chunk_index_free(
+			 &chunk_index,
+			 NULL );
+
+			return( 0 );
+		}
+		if( libewf_segment_table_get_segment_file_by_index(
+		     internal_handle->segment_table,
+		     segment_index,
+		     internal_handle->file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_index );
+
+			goto on_error;
 		}
-		if( chunk_data == NULL )
+		if( segment_file == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk: %" PRIu64 " data.",
+			 "%s: missing segment file: %" PRIu32 ".",
 			 function,
-			 chunk_index );
+			 segment_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+		chunk_index_segment = &( chunk_index->segments[ file_io_pool_entry ] );
+
+		if( libbfio_pool_get_handle(
+		     internal_handle->file_io_pool,
+		     file_io_pool_entry,
+		     &file_io_handle,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d from pool.",
 			 function,
-			 chunk_index );
+			 file_io_pool_entry );
 
-			return( -1 );
+			goto on_error;
 		}
-		read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+		result = libewf_chunk_index_get_file_io_handle_values(
+		          file_io_handle,
+		          internal_handle->file_io_pool_io_engine,
+		          &( chunk_index_segment->file_size ),
+		          &( chunk_index_segment->modification_time ),
+		          &( chunk_index_segment->device_identifier ),
+		          &( chunk_index_segment->inode_number ),
+		          error );
 
-		if( read_size > buffer_size )
+		if( result == -1 )
 		{
-			read_size = buffer_size;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file values of file IO handle: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
 		}
-		if( read_size == 0 )
+		else if( ( result == 0 )
+		      || ( chunk_index_segment->file_size != segment_file_size ) )
 		{
-			break;
+			libewf_chunk_index_free(
+			 &chunk_index,
+			 NULL );
+
+			return( 0 );
 		}
-		if( memory_copy(
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     &( ( chunk_data->data )[ chunk_data_offset ] ),
-		     read_size ) == NULL )
+		chunk_index_segment->segment_number                   = segment_file->segment_number;
+		chunk_index_segment->flags                            = segment_file->flags & ( LIBEWF_SEGMENT_FILE_FLAG_IS_LAST | LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED | LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED );
+		chunk_index_segment->previous_last_chunk_filled       = segment_file->previous_last_chunk_filled;
+		chunk_index_segment->last_chunk_filled                = segment_file->last_chunk_filled;
+		chunk_index_segment->last_section_offset              = segment_file->last_section_offset;
+		chunk_index_segment->device_information_section_index = segment_file->device_information_section_index;
+
+		if( libfdata_list_get_number_of_elements(
+		     segment_file->sections_list,
+		     &number_of_sections,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of sections of segment file: %" PRIu32 ".",
 			 function,
-			 chunk_index );
+			 segment_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		buffer_offset    += read_size;
-		buffer_size      -= read_size;
-		total_read_count += (ssize_t) read_size;
-		chunk_index      += 1;
+		for( section_index = 0;
+		     section_index < number_of_sections;
+		     section_index++ )
+		{
+			if( libfdata_list_get_element_by_index(
+			     segment_file->sections_list,
+			     section_index,
+			     &section_file_io_pool_entry,
+			     &section_offset,
+			     &section_size,
+			     &section_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve element: %d from sections list.",
+				 function,
+				 section_index );
 
-		internal_handle->current_offset += (off64_t) read_size;
+				goto on_error;
+			}
+			if( section_file_io_pool_entry != file_io_pool_entry )
+			{
+				libewf_chunk_index_free(
+				 &chunk_index,
+				 NULL );
 
-		if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
-		{
-			break;
+				return( 0 );
+			}
+			if( libewf_chunk_index_append_section(
+			     chunk_index,
+			     chunk_index_segment,
+			     section_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append section: %d to chunk index.",
+				 function,
+				 section_index );
+
+				goto on_error;
+			}
 		}
-		if( internal_handle->io_handle->abort != 0 )
+
+		if( libfdata_list_get_number_of_elements(
+		     segment_file->chunk_groups_list,
+		     &number_of_chunk_groups,
+		     error ) != 1 )
 		{
-			break;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of chunk groups of segment file: %" PRIu32 ".",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		for( chunk_group_index = 0;
+		     chunk_group_index < number_of_chunk_groups;
+		     chunk_group_index++ )
+		{
+			if( libfdata_list_get_element_by_index(
+			     segment_file->chunk_groups_list,
+			     chunk_group_index,
+			     &chunk_group_file_io_pool_entry,
+			     &chunk_group_data_offset,
+			     &chunk_group_data_size,
+			     &chunk_group_range_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve element: %d from chunk groups list.",
+				 function,
+				 chunk_group_index );
+
+				goto on_error;
+			}
+			if( libfdata_list_get_mapped_size_by_index(
+			     segment_file->chunk_groups_list,
+			     chunk_group_index,
+			     &chunk_group_mapped_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve mapped size of element: %d from chunk groups list.",
+				 function,
+				 chunk_group_index );
+
+				goto on_error;
+			}
+			/* The chunk index only stores whole chunks
+			 */
+			if( ( chunk_group_file_io_pool_entry != file_io_pool_entry )
+			 || ( ( chunk_group_mapped_size % chunk_index->chunk_size ) != 0 ) )
+			{
+				libewf_chunk_index_free(
+				 &chunk_index,
+				 NULL );
+
+				return( 0 );
+			}
+			number_of_chunks = chunk_group_mapped_size / chunk_index->chunk_size;
+
+			if( ( number_of_chunks == 0 )
+			 || ( number_of_chunks > (uint64_t) UINT32_MAX ) )
+			{
+				libewf_chunk_index_free(
+				 &chunk_index,
+				 NULL );
+
+				return( 0 );
+			}
+			if( libewf_chunk_index_append_chunk_group(
+			     chunk_index,
+			     chunk_index_segment,
+			     chunk_group_data_offset,
+			     chunk_group_data_size,
+			     (uint32_t) number_of_chunks,
+			     chunk_group_range_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append chunk group: %d to chunk index.",
+				 function,
+				 chunk_group_index );
+
+				goto on_error;
+			}
 		}
-		chunk_data        = NULL;
-		chunk_data_offset = 0;
 	}
-	return( total_read_count );
+	if( libewf_chunk_index_write_file(
+	     chunk_index,
+	     internal_handle->chunk_index_filename,
+	     internal_handle->chunk_index_filename_size - 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_chunk_index_free(
+	     &chunk_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( chunk_index != NULL )
+	{
+		libewf_chunk_index_free(
+		 &chunk_index,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Reads (media) data at the current offset into a buffer
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_read_buffer(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_internal_handle_open_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer";
-	ssize_t read_count                        = 0;
+	libbfio_handle_t *file_io_handle         = NULL;
+	libewf_segment_file_t *segment_file      = NULL;
+	static char *function                    = "libewf_internal_handle_open_file_io_pool";
+	size64_t segment_file_size               = 0;
+	ssize_t read_count                       = 0;
+	int file_io_pool_entry                   = 0;
+	int number_of_chunk_groups_cache_entries = 0;
+	int number_of_file_io_handles            = 0;
+	uint8_t lazy_open                        = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -4541,671 +5235,767 @@ ssize_t libewf_handle_read_buffer(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
+	if( internal_handle->file_io_pool != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
-		      internal_handle,
-		      internal_handle->file_io_pool,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
+	if( internal_handle->chunk_table != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk table value already set.",
 		 function );
 
-		read_count = -1;
+		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->chunk_groups_cache != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunks group cache value already set.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( read_count );
-}
-
-/* Reads (media) data at a specific offset
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
- */
-ssize_t libewf_handle_read_buffer_at_offset(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer_at_offset";
-	ssize_t read_count                        = 0;
-
-	if( handle == NULL )
+	if( internal_handle->chunks_cache != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunks cache value already set.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	if( internal_handle->read_ahead != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - read-ahead value already set.",
+		 function );
 
-	if( internal_handle->file_io_pool == NULL )
+		return( -1 );
+	}
+	if( internal_handle->coalesced_read_buffer != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - coalesced read buffer value already set.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->write_pipeline != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - write pipeline value already set.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libewf_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( internal_handle->chunk_cache != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk cache value already set.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
-	              internal_handle,
-	              internal_handle->file_io_pool,
-	              buffer,
-	              buffer_size,
-	              error );
-
-	if( read_count == -1 )
+	if( internal_handle->hash_sections != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - hash sections value already set.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->single_files != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - single files value already set.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( read_count );
-
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
-
-/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
- */
-ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         const void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-	static char *function     = "libewf_internal_handle_write_buffer_to_file_io_pool";
-	off64_t chunk_data_offset = 0;
-	size_t buffer_offset      = 0;
-	size_t input_data_size    = 0;
-	size_t write_size         = 0;
-	ssize_t write_count       = 0;
-	uint64_t chunk_index      = 0;
-	int write_chunk           = 0;
-
-	if( internal_handle == NULL )
+	if( file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
+	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
-		 function );
+		if( libewf_read_io_handle_initialize(
+		     &( internal_handle->read_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read IO handle.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
 	{
-		if( internal_handle->chunk_data != NULL )
+		if( libewf_write_io_handle_initialize(
+		     &( internal_handle->write_io_handle ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create write IO handle.",
 			 function );
 
-			return( -1 );
+			goto on_error;
+		}
+		if( internal_handle->write_behind_size > 0 )
+		{
+			if( libewf_write_behind_buffer_initialize(
+			     &( internal_handle->write_io_handle->write_behind_buffer ),
+			     (size_t) internal_handle->write_behind_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create write-behind buffer.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_handle->write_number_of_threads > 0 )
+		{
+			if( libewf_write_pipeline_initialize(
+			     &( internal_handle->write_pipeline ),
+			     internal_handle->io_handle,
+			     internal_handle->write_number_of_threads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create write pipeline.",
+				 function );
+
+				goto on_error;
+			}
 		}
+#endif
 	}
-	if( internal_handle->media_values == NULL )
+	if( libewf_chunk_table_initialize(
+	     &( internal_handle->chunk_table ),
+	     internal_handle->io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk table.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( libewf_internal_handle_get_chunk_groups_cache_number_of_entries(
+	     internal_handle,
+	     &number_of_chunk_groups_cache_entries,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of chunk groups cache entries.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->write_io_handle == NULL )
+	if( libfcache_cache_initialize(
+	     &( internal_handle->chunk_groups_cache ),
+	     number_of_chunk_groups_cache_entries,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk groups cache.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( buffer == NULL )
+	if( libfcache_cache_initialize(
+	     &( internal_handle->chunks_cache ),
+	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunks cache.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 )
 	{
-		libcerror_error_set(
+		if( libewf_read_ahead_initialize(
+		     &( internal_handle->read_ahead ),
+		     internal_handle->io_handle,
+		     internal_handle->read_ahead_number_of_chunks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read-ahead.",
+			 function );
+
+			goto on_error;
+		}
+		if( internal_handle->coalesced_read_size > 0 )
+		{
+			if( libewf_coalesced_read_buffer_initialize(
+			     &( internal_handle->coalesced_read_buffer ),
+			     (size_t) internal_handle->coalesced_read_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create coalesced read buffer.",
+				 function );
+
+				goto on_error;
+			}
+			internal_handle->io_handle->coalesced_read_buffer = internal_handle->coalesced_read_buffer;
+		}
+	}
+	if( libewf_header_values_initialize(
+	     &( internal_handle->header_values ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create header values.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->current_offset < 0 )
+	if( libewf_hash_sections_initialize(
+	     &( internal_handle->hash_sections ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create hash sections.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	if( libewf_single_files_initialize(
+	     &( internal_handle->single_files ),
+	     error ) != 1 )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create single files.",
+		 function );
+
+		goto on_error;
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
+	if( libcdata_array_empty(
+	     internal_handle->sessions,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
 	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
-	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty sessions array.",
+		 function );
 
-	if( chunk_index >= (uint64_t) INT_MAX )
+		goto on_error;
+	}
+	if( libcdata_array_empty(
+	     internal_handle->tracks,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk index value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty tracks array.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
-	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
-
-	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
+	if( libcdata_range_list_empty(
+	     internal_handle->acquiry_errors,
+	     NULL,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk data offset value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty acquiry errors range list.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	while( buffer_size > 0 )
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
 	{
-		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+		if( libbfio_pool_get_number_of_handles(
+		     file_io_pool,
+		     &number_of_file_io_handles,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already set.",
-			 function,
-			 chunk_index );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve the number of handles in the pool.",
+			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( internal_handle->write_io_handle->write_finalized != 0 )
+		if( libewf_segment_file_initialize(
+		     &segment_file,
+		     internal_handle->io_handle,
+		     error ) != 1 )
 		{
-			break;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment file.",
+			 function );
+
+			goto on_error;
 		}
-		if( internal_handle->chunk_data == NULL )
+		for( file_io_pool_entry = 0;
+		     file_io_pool_entry < number_of_file_io_handles;
+		     file_io_pool_entry++ )
 		{
-			if( libewf_chunk_data_initialize(
-			     &( internal_handle->chunk_data ),
-			     internal_handle->media_values->chunk_size,
-			     0,
+			if( libbfio_pool_get_size(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &segment_file_size,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create chunk: %" PRIu64 " data.",
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve size of file IO pool entry: %d.",
 				 function,
-				 chunk_index );
+				 file_io_pool_entry );
 
-				return( -1 );
+				goto on_error;
 			}
-		}
-		if( internal_handle->chunk_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: internal handle - missing chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
+			if( libbfio_pool_get_handle(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to retrieve file IO handle: %d from pool.",
+				 function,
+				 file_io_pool_entry );
 
-			return( -1 );
+				goto on_error;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: processing file IO pool entry: %d.\n",
+				 function,
+				 file_io_pool_entry );
+			}
+#endif
+			read_count = libewf_segment_file_read_file_header(
+				      segment_file,
+				      file_io_pool,
+				      file_io_pool_entry,
+				      error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read segment file header.",
+				 function );
+
+				goto on_error;
+			}
+			if( segment_file->segment_number == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_INVALID_DATA,
+				 "%s: invalid segment number: 0 in file IO pool entry: %d.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+			if( libewf_segment_table_append_segment_by_segment_file(
+			     segment_table,
+			     segment_file,
+			     file_io_pool_entry,
+			     segment_file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append segment: %" PRIu32 " to segment table.",
+				 function,
+				 segment_file->segment_number );
+
+				goto on_error;
+			}
 		}
-		if( chunk_data_offset > internal_handle->media_values->chunk_size )
+		if( libewf_segment_file_free(
+		     &segment_file,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk offset exceeds chunk data size.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment file.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
-
-		if( write_size > buffer_size )
+		/* Lazy open is only supported for read-only access
+		 */
+		if( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 )
 		{
-			write_size = buffer_size;
+			lazy_open = internal_handle->lazy_open;
 		}
-		if( write_size == 0 )
-		{
-			break;
-		}
-		if( memory_copy(
-		     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     write_size ) == NULL )
+		if( libewf_internal_handle_open_read_segment_files(
+		     internal_handle,
+		     file_io_pool,
+		     segment_table,
+		     lazy_open,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy buffer to chunk data.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment files.",
 			 function );
 
-			return( -1 );
-		}
-		internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
-
-		buffer_offset += write_size;
-		buffer_size   -= write_size;
-
-		if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
-		{
-			write_chunk = 1;
-		}
-		else if( ( internal_handle->media_values->media_size != 0 )
-		      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
-		{
-			write_chunk = 1;
+			if( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 )
+			{
+				goto on_error;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
 		}
-		else
+		if( internal_handle->media_values == NULL )
 		{
-			write_chunk = 0;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing media values.",
+			 function );
+
+			goto on_error;
 		}
-		if( write_chunk != 0 )
+/* TODO refactor */
+		if( internal_handle->single_files->ltree_data == NULL )
 		{
-			input_data_size = internal_handle->chunk_data->data_size;
-
-			if( libewf_chunk_data_pack(
-			     internal_handle->chunk_data,
-			     internal_handle->io_handle,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-			     internal_handle->write_io_handle->pack_flags,
+			if( libewf_internal_handle_get_media_values(
+			     internal_handle,
+			     &( internal_handle->media_values->media_size ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to pack chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
-
-				return( -1 );
-			}
-			write_count = libewf_write_io_handle_write_new_chunk(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-			               file_io_pool,
-			               internal_handle->media_values,
-			               internal_handle->segment_table,
-			               internal_handle->header_values,
-			               internal_handle->hash_values,
-			               internal_handle->hash_sections,
-			               internal_handle->sessions,
-			               internal_handle->tracks,
-			               internal_handle->acquiry_errors,
-			               chunk_index,
-			               internal_handle->chunk_data,
-			               input_data_size,
-			               error );
-
-			if( write_count <= 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write new chunk.",
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine media values.",
 				 function );
 
-				return( -1 );
+				goto on_error;
 			}
-			if( libewf_chunk_data_free(
-			     &( internal_handle->chunk_data ),
+		}
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		if( internal_handle->write_io_handle->values_initialized == 0 )
+		{
+			if( libewf_write_io_handle_initialize_values(
+			     internal_handle->write_io_handle,
+			     internal_handle->io_handle,
+			     internal_handle->media_values,
+			     segment_table,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free chunk data.",
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize write IO handle values.",
 				 function );
 
-				return( -1 );
+				goto on_error;
 			}
 		}
-		chunk_index      += 1;
-		chunk_data_offset = 0;
-
-		internal_handle->current_offset += (off64_t) write_size;
-
-		if( ( internal_handle->media_values->media_size != 0 )
-		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
-		{
-			break;
-		}
-		if( internal_handle->io_handle->abort != 0 )
-		{
-			break;
-		}
-	}
-	return( (ssize_t) buffer_offset );
-}
-
-/* Writes (media) data at the current offset
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
- */
-ssize_t libewf_handle_write_buffer(
-         libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer";
-	ssize_t write_count                       = 0;
-
-	if( handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		return( -1 );
-	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
-		 function );
-
-		return( -1 );
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
-		 function );
-
-		return( -1 );
-	}
-#endif
-	if( internal_handle->write_io_handle->values_initialized == 0 )
-	{
-		if( libewf_write_io_handle_initialize_values(
+		if( libewf_write_io_handle_initialize_resume(
 		     internal_handle->write_io_handle,
 		     internal_handle->io_handle,
+		     file_io_pool,
 		     internal_handle->media_values,
-		     internal_handle->segment_table,
+		     segment_table,
+		     internal_handle->chunk_table,
+		     internal_handle->read_io_handle,
+		     &( internal_handle->current_offset ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
+			 "%s: unable to initialize write IO handle to resume.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               buffer,
-	               buffer_size,
-	               error );
+			internal_handle->io_handle->chunk_size = internal_handle->media_values->chunk_size;
 
-	if( write_count == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write buffer.",
-		 function );
+	internal_handle->io_handle->access_flags = access_flags;
 
-		goto on_error;
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
+	/* The chunk cache is created after the segment files have been read
+	 * since the chunk size is not known before
+	 */
+	if( libewf_internal_handle_initialize_chunk_cache(
+	     internal_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize chunk cache.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( write_count );
+	internal_handle->file_io_pool            = file_io_pool;
+	internal_handle->segment_table           = segment_table;
 
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
+	return( 1 );
 
-/* Writes (media) data at a specific offset,
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
- */
-ssize_t libewf_handle_write_buffer_at_offset(
-         libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+on_error:
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		libewf_single_files_free(
+		 &( internal_handle->single_files ),
+		 NULL );
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		libewf_hash_sections_free(
+		 &( internal_handle->hash_sections ),
+		 NULL );
+	}
+	if( internal_handle->header_values != NULL )
+	{
+		libfvalue_table_free(
+		 &( internal_handle->header_values ),
+		 NULL );
+	}
+	if( internal_handle->chunk_cache != NULL )
+	{
+		libewf_sharded_chunk_cache_free(
+		 &( internal_handle->chunk_cache ),
+		 NULL );
+	}
+	if( internal_handle->coalesced_read_buffer != NULL )
+	{
+		internal_handle->io_handle->coalesced_read_buffer = NULL;
+
+		libewf_coalesced_read_buffer_free(
+		 &( internal_handle->coalesced_read_buffer ),
+		 NULL );
+	}
+	if( internal_handle->read_ahead != NULL )
+	{
+		libewf_read_ahead_free(
+		 &( internal_handle->read_ahead ),
+		 NULL );
+	}
+	if( internal_handle->chunks_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &( internal_handle->chunks_cache ),
+		 NULL );
+	}
+	if( internal_handle->chunk_groups_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &( internal_handle->chunk_groups_cache ),
+		 NULL );
+	}
+	if( internal_handle->chunk_table != NULL )
+	{
+		libewf_chunk_table_free(
+		 &( internal_handle->chunk_table ),
+		 NULL );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->write_pipeline != NULL )
+	{
+		libewf_write_pipeline_free(
+		 &( internal_handle->write_pipeline ),
+		 NULL );
+	}
+#endif
+	if( internal_handle->write_io_handle != NULL )
+	{
+		libewf_write_io_handle_free(
+		 &( internal_handle->write_io_handle ),
+		 error );
+	}
+	if( internal_handle->read_io_handle != NULL )
+	{
+		libewf_read_io_handle_free(
+		 &( internal_handle->read_io_handle ),
+		 error );
+	}
+	return( -1 );
+}
+
+/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_open_file_io_pool(
+     libewf_handle_t *handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer_at_offset";
-	ssize_t write_count                       = 0;
+	libewf_segment_table_t *segment_table     = NULL;
+	static char *function                     = "libewf_handle_open_file_io_pool";
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -5220,17 +6010,32 @@ ssize_t libewf_handle_write_buffer_at_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( internal_handle->file_io_pool != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
 		 function );
 
 		return( -1 );
 	}
+	if( libewf_segment_table_initialize(
+	     &segment_table,
+	     internal_handle->io_handle,
+	     LIBEWF_DEFAULT_SEGMENT_FILE_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment table.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -5246,62 +6051,28 @@ ssize_t libewf_handle_write_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	if( internal_handle->write_io_handle->values_initialized == 0 )
-	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	if( libewf_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
-
-		goto on_error;
-	}
-	write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               buffer,
-	               buffer_size,
-	               error );
+	result = libewf_internal_handle_open_file_io_pool(
+	          internal_handle,
+	          file_io_pool,
+	          access_flags,
+	          segment_table,
+	          error );
 
-	if( write_count == -1 )
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write buffer.",
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle using a file IO pool.",
 		 function );
-
-		goto on_error;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	result = libcthreads_read_write_lock_release_for_write(
+	          internal_handle->read_write_lock,
+	          error );
+
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -5309,31 +6080,35 @@ ssize_t libewf_handle_write_buffer_at_offset(
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
 		 "%s: unable to release read/write lock for writing.",
 		 function );
-
-		return( -1 );
 	}
 #endif
-	return( write_count );
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
 
 on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
+	if( segment_table != NULL )
+	{
+		libewf_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
 	return( -1 );
 }
 
-/* Retrieves a (media) data chunk
- * Returns 1 if successful or -1 on error
+/* Closes the EWF handle
+ * Returns 0 if successful or -1 on error
  */
-int libewf_handle_get_data_chunk(
+int libewf_handle_close(
      libewf_handle_t *handle,
-     libewf_data_chunk_t **data_chunk,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_data_chunk";
+	static char *function                     = "libewf_handle_close";
+	ssize_t write_count                       = 0;
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -5348,39 +6123,6 @@ int libewf_handle_get_data_chunk(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
-
-		return( -1 );
-	}
-	if( data_chunk == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
-		 function );
-
-		return( -1 );
-	}
-	if( *data_chunk != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: data chunk value already set.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -5397,298 +6139,412 @@ int libewf_handle_get_data_chunk(
 	}
 #endif
 	if( ( internal_handle->write_io_handle != NULL )
-	 && ( internal_handle->write_io_handle->values_initialized == 0 ) )
+	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
 	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
+		write_count = libewf_internal_handle_write_finalize_file_io_pool(
+		               internal_handle,
+		               internal_handle->file_io_pool,
+		               error );
+
+		if( write_count < 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to finalize write.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
 	}
-	if( libewf_data_chunk_initialize(
-	     data_chunk,
-	     internal_handle->io_handle,
-	     internal_handle->write_io_handle,
-	     error ) != 1 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The chunks that are read ahead are read from the file IO pool
+	 * by the unpack thread pool and must be discarded before it is closed
+	 */
+	if( internal_handle->read_ahead != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create data chunk.",
-		 function );
+		if( libewf_read_ahead_discard(
+		     internal_handle->read_ahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to discard chunks read ahead.",
+			 function );
 
-		goto on_error;
+			result = -1;
+		}
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->write_pipeline != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
+		if( libewf_write_pipeline_free(
+		     &( internal_handle->write_pipeline ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write pipeline.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
 #endif
-	return( 1 );
+	if( internal_handle->file_io_pool_created_in_library != 0 )
+	{
+		if( libbfio_pool_close_all(
+		     internal_handle->file_io_pool,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close all file IO pool handles.",
+			 function );
 
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
+			result = -1;
+		}
+		if( libbfio_pool_free(
+		     &( internal_handle->file_io_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO pool.",
+			 function );
 
-/* Reads a (media) data chunk at the current offset
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
- */
-ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
-         libcerror_error_t **error )
-{
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_read_data_chunk_from_file_io_pool";
-	off64_t chunk_data_offset       = 0;
-	ssize_t read_count              = 0;
+			result = -1;
+		}
+		internal_handle->file_io_pool_created_in_library = 0;
+	}
+	internal_handle->file_io_pool              = NULL;
+	internal_handle->file_io_pool_io_engine    = LIBEWF_IO_ENGINE_BUFFERED;
+	internal_handle->number_of_mapped_segments = 0;
 
-	if( internal_handle == NULL )
+	if( internal_handle->chunk_index != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
+		if( libewf_chunk_index_free(
+		     &( internal_handle->chunk_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk index.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( internal_handle->io_handle == NULL )
+
+	if( libewf_io_handle_clear(
+	     internal_handle->io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear IO handle.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( internal_handle->chunk_data != NULL )
+	internal_handle->io_handle->buffer_pool = internal_handle->buffer_pool;
+
+	if( libewf_media_values_clear(
+	     internal_handle->media_values,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear media values.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( internal_handle->current_offset < 0 )
+	if( internal_handle->read_io_handle != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
-		 function );
+		if( libewf_read_io_handle_free(
+		     &( internal_handle->read_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read IO handle.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->write_io_handle != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+		if( libewf_write_io_handle_free(
+		     &( internal_handle->write_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write IO handle.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	/* Free the chunk data if it could not be passed to libfcache_cache_set_value_by_index
+	 */
+	if( internal_handle->chunk_data != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
-		 function );
+		if( libewf_chunk_data_free(
+		     &( internal_handle->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( internal_data_chunk == NULL )
+	if( internal_handle->segment_table != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
-		 function );
+		if( libewf_segment_table_free(
+		     &( internal_handle->segment_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment table.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	if( internal_handle->chunk_table != NULL )
 	{
-		return( 0 );
-	}
-/* TODO remove need to calculate */
-	internal_handle->current_chunk_index = internal_handle->current_offset
-	                                     / internal_handle->media_values->chunk_size;
+		if( libewf_chunk_table_free(
+		     &( internal_handle->chunk_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk table.",
+			 function );
 
-	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
-	                                * (off64_t) internal_handle->media_values->chunk_size;
+			result = -1;
+		}
+	}
+	if( internal_handle->chunk_groups_cache != NULL )
+	{
+		if( libfcache_cache_free(
+		     &( internal_handle->chunk_groups_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk groups cache.",
+			 function );
 
-	if( libewf_chunk_table_get_chunk_data_by_offset(
-	     internal_handle->chunk_table,
-	     internal_handle->current_chunk_index,
-	     internal_handle->io_handle,
-	     file_io_pool,
-	     internal_handle->media_values,
-	     internal_handle->segment_table,
-	     internal_handle->chunk_groups_cache,
-	     internal_handle->chunks_cache,
-	     internal_handle->current_offset,
-	     &chunk_data,
-	     &chunk_data_offset,
-	     error ) != 1 )
+			result = -1;
+		}
+	}
+	if( internal_handle->read_ahead != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve chunk: %" PRIu64 " data.",
-		 function,
-		 internal_handle->current_chunk_index );
+		if( libewf_read_ahead_free(
+		     &( internal_handle->read_ahead ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( chunk_data == NULL )
+	if( internal_handle->coalesced_read_buffer != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing chunk: %" PRIu64 " data.",
-		 function,
-		 internal_handle->current_chunk_index );
+		internal_handle->io_handle->coalesced_read_buffer = NULL;
 
-		return( -1 );
-	}
-	read_count = (ssize_t) chunk_data->data_size;
+		if( libewf_coalesced_read_buffer_free(
+		     &( internal_handle->coalesced_read_buffer ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free coalesced read buffer.",
+			 function );
 
-	if( libewf_internal_data_chunk_set_chunk_data(
-	     internal_data_chunk,
-	     internal_handle->current_chunk_index,
-	     chunk_data,
-	     error ) != 1 )
+			result = -1;
+		}
+	}
+	if( internal_handle->chunk_cache != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
-		 function,
-		 internal_handle->current_chunk_index );
+		if( libewf_sharded_chunk_cache_free(
+		     &( internal_handle->chunk_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk cache.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	internal_handle->current_offset += read_count;
-
-	internal_handle->current_chunk_index++;
+	if( internal_handle->chunks_cache != NULL )
+	{
+		if( libfcache_cache_free(
+		     &( internal_handle->chunks_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunks cache.",
+			 function );
 
-	return( read_count );
-}
+			result = -1;
+		}
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		if( libewf_hash_sections_free(
+		     &( internal_handle->hash_sections ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free hash sections.",
+			 function );
 
-/* Reads a (media) data chunk at the current offset
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
- */
-ssize_t libewf_handle_read_data_chunk(
-         libewf_handle_t *handle,
-         libewf_data_chunk_t *data_chunk,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_data_chunk";
-	ssize_t read_count                        = 0;
+			result = -1;
+		}
+	}
+	if( internal_handle->header_values != NULL )
+	{
+		if( libfvalue_table_free(
+		     &( internal_handle->header_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free header values.",
+			 function );
 
-	if( handle == NULL )
+			result = -1;
+		}
+	}
+	if( internal_handle->hash_values != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
+		if( libfvalue_table_free(
+		     &( internal_handle->hash_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free hash values.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	if( internal_handle->single_files != NULL )
+	{
+		if( libewf_single_files_free(
+		     &( internal_handle->single_files ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free single files.",
+			 function );
 
-	if( internal_handle->file_io_pool == NULL )
+			result = -1;
+		}
+	}
+	if( libcdata_array_empty(
+	     internal_handle->sessions,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty sessions array.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libcdata_array_empty(
+	     internal_handle->tracks,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty tracks array.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#endif
-	read_count = libewf_internal_handle_read_data_chunk_from_file_io_pool(
-	              internal_handle,
-	              internal_handle->file_io_pool,
-	              (libewf_internal_data_chunk_t *) data_chunk,
-	              error );
-
-	if( read_count < 0 )
+	if( libcdata_range_list_empty(
+	     internal_handle->acquiry_errors,
+	     NULL,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty acquiry errors range list.",
 		 function );
 
-		read_count = -1;
+		result = -1;
 	}
+/* TODO clear IO handle, segment tables */
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -5701,26 +6557,24 @@ ssize_t libewf_handle_read_data_chunk(
 		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
 #endif
-	return( read_count );
+	return( result );
 }
 
-/* Writes a (media) data chunk at the current offset
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Appends a checksum error for a specific chunk
+ * This function is not multi-thread safe grab the read chunk mutex before call
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
-         libcerror_error_t **error )
+int libewf_internal_handle_append_chunk_checksum_error(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
 {
-	static char *function = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
-	size_t data_size      = 0;
-	ssize_t write_count   = 0;
-	int chunk_exists      = 0;
+	static char *function      = "libewf_internal_handle_append_chunk_checksum_error";
+	uint64_t number_of_sectors = 0;
+	uint64_t start_sector      = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -5733,796 +6587,874 @@ ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	start_sector      = chunk_index * internal_handle->media_values->sectors_per_chunk;
+	number_of_sectors = internal_handle->media_values->sectors_per_chunk;
+
+	if( ( start_sector + number_of_sectors ) > (uint64_t) internal_handle->media_values->number_of_sectors )
+	{
+		number_of_sectors = (uint64_t) internal_handle->media_values->number_of_sectors - start_sector;
+	}
+	if( libewf_chunk_table_append_checksum_error(
+	     internal_handle->chunk_table,
+	     start_sector,
+	     number_of_sectors,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append chunk: %" PRIu64 " checksum error.",
+		 function,
+		 chunk_index );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->media_values == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+	return( 1 );
+}
 
-		return( -1 );
-	}
-	if( internal_handle->media_values->chunk_size == 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
-		 function );
+/* Reads (media) data of a specific chunk into a buffer using a Basic File IO (bfio) pool
+ * When the handle is opened for reading only the chunk data is read by means of its range
+ * in the chunk table and stored in the chunk cache if available, the chunks cache is not used.
+ * Otherwise the chunk data is read by means of the chunk table and the chunks cache
+ * The chunk table, chunks cache, read-ahead and coalesced read buffer are shared therefore
+ * the read chunk mutex is grabbed while these are used when multi-thread support is enabled.
+ * Positional reads of the chunk data and unpacking are done without the read chunk mutex
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_chunk_buffer_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint64_t chunk_index,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data      = NULL;
+	libewf_chunk_data_t *safe_chunk_data = NULL;
+	static char *function                = "libewf_internal_handle_read_chunk_buffer_from_file_io_pool";
+	off64_t chunk_data_offset            = 0;
+	off64_t range_offset                 = 0;
+	size64_t contiguous_data_size        = 0;
+	size64_t maximum_contiguous_size     = 0;
+	size64_t range_size                  = 0;
+	size_t read_size                     = 0;
+	ssize_t read_count                   = 0;
+	uint64_t pattern                     = 0;
+	uint32_t range_flags                 = 0;
+	uint8_t is_fill_pattern              = 0;
+	uint8_t read_chunk_data              = 0;
+	int file_io_pool_entry               = 0;
+	int result                           = 0;
 
-		return( -1 );
-	}
-	if( internal_handle->write_io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
-		 function );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	uint8_t read_chunk_mutex_grabbed     = 0;
+#endif
 
-		return( -1 );
-	}
-	if( internal_data_chunk == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
-	{
-		return( 0 );
-	}
-	data_size = internal_data_chunk->data_size;
-
-	if( internal_handle->media_values->media_size != 0 )
-	{
-		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: last data chunk size value out of bounds.",
-			 function );
-
-			return( -1 );
-		}
-	}
-/* TODO remove need to calculate */
-	internal_handle->current_chunk_index = internal_handle->current_offset
-	                                     / internal_handle->media_values->chunk_size;
-
-	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
-	                                * (off64_t) internal_handle->media_values->chunk_size;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: writing chunk: %" PRIu64 " of size: %" PRIzd ".\n",
-		 function,
-		 internal_handle->current_chunk_index,
-		 data_size );
-	}
-#endif
-	chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
-	                internal_handle->chunk_table,
-	                internal_handle->current_chunk_index,
-	                file_io_pool,
-	                internal_handle->segment_table,
-	                internal_handle->chunk_groups_cache,
-	                internal_handle->current_offset,
-			error );
-
-	if( chunk_exists == -1 )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
-		 function,
-		 internal_handle->current_chunk_index );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
 
 		return( -1 );
 	}
-	else if( chunk_exists != 0 )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: chunk: %" PRIu64 " already exists.",
-		 function,
-		 internal_handle->current_chunk_index );
-
-		return( -1 );
-	}
-	write_count = libewf_write_io_handle_write_new_chunk(
-	               internal_handle->write_io_handle,
-	               internal_handle->io_handle,
-	               file_io_pool,
-	               internal_handle->media_values,
-	               internal_handle->segment_table,
-	               internal_handle->header_values,
-	               internal_handle->hash_values,
-	               internal_handle->hash_sections,
-	               internal_handle->sessions,
-	               internal_handle->tracks,
-	               internal_handle->acquiry_errors,
-	               internal_handle->current_chunk_index,
-	               internal_data_chunk->chunk_data,
-	               data_size,
-	               error );
-
-	if( write_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write chunk data.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->current_offset += (off64_t) data_size;
-
-	return( write_count );
-}
-
-/* Writes a (media) data chunk at the current offset
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
- */
-ssize_t libewf_handle_write_data_chunk(
-         libewf_handle_t *handle,
-         libewf_data_chunk_t *data_chunk,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_data_chunk";
-	ssize_t write_count                       = 0;
-
-	if( handle == NULL )
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid buffer.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	chunk_data_offset = offset - ( (off64_t) chunk_index * internal_handle->media_values->chunk_size );
 
-	if( internal_handle->file_io_pool == NULL )
+	if( ( chunk_data_offset < 0 )
+	 || ( chunk_data_offset > (off64_t) internal_handle->media_values->chunk_size ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: chunk: %" PRIu64 " offset value out of bounds.",
+		 function,
+		 chunk_index );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libcthreads_mutex_grab(
+	     internal_handle->read_chunk_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read chunk mutex.",
 		 function );
 
 		return( -1 );
 	}
+	read_chunk_mutex_grabbed = 1;
 #endif
-	write_count = libewf_internal_handle_write_data_chunk_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               (libewf_internal_data_chunk_t *) data_chunk,
-	               error );
-
-	if( write_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write data chunk.",
-		 function );
-
-		write_count = -1;
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
+	if( libewf_internal_handle_read_deferred_segment_files(
+	     internal_handle,
+	     file_io_pool,
+	     (off64_t) chunk_index * internal_handle->media_values->chunk_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred segment files.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( write_count );
-}
-
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
- */
-ssize_t libewf_internal_handle_write_finalize_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libcerror_error_t **error )
-{
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
-	size64_t segment_file_size          = 0;
-	size_t input_data_size              = 0;
-	ssize_t write_count                 = 0;
-	ssize_t write_finalize_count        = 0;
-	uint64_t chunk_index                = 0;
-	uint32_t number_of_segments         = 0;
-	uint32_t segment_number             = 0;
-	int chunk_exists                    = 0;
-	int file_io_pool_entry              = -1;
+	/* The data of sparse and pattern fill chunks is determined from the table entries
+	 * without reading and caching the chunk data
+	 */
+	result = libewf_chunk_table_get_chunk_fill_pattern_by_offset(
+	          internal_handle->chunk_table,
+	          chunk_index,
+	          file_io_pool,
+	          internal_handle->segment_table,
+	          internal_handle->chunk_groups_cache,
+	          offset,
+	          &pattern,
+	          error );
 
-	if( internal_handle == NULL )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " fill pattern.",
+		 function,
+		 chunk_index );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->io_handle == NULL )
+	else if( result != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
-
-		return( -1 );
+		is_fill_pattern = 1;
 	}
-	if( internal_handle->current_offset < 0 )
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
-		 function );
+		if( internal_handle->read_ahead != NULL )
+		{
+			if( libewf_read_ahead_prepare_chunk(
+			     internal_handle->read_ahead,
+			     chunk_index,
+			     internal_handle->chunk_table,
+			     file_io_pool,
+			     internal_handle->media_values,
+			     internal_handle->segment_table,
+			     internal_handle->chunk_groups_cache,
+			     &safe_chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to prepare read-ahead of chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
 
-		return( -1 );
-	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		if( internal_handle->chunk_data != NULL )
+				goto on_error;
+			}
+		}
+		/* The chunk cache replaces the chunks cache when the handle is opened for reading only
+		 */
+		if( ( safe_chunk_data == NULL )
+		 && ( ( internal_handle->io_handle->access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
-			 function );
+			if( internal_handle->coalesced_read_buffer != NULL )
+			{
+				maximum_contiguous_size = (size64_t) internal_handle->coalesced_read_buffer->maximum_data_size;
+			}
+			result = libewf_chunk_table_get_chunk_range_by_offset(
+			          internal_handle->chunk_table,
+			          chunk_index,
+			          file_io_pool,
+			          internal_handle->segment_table,
+			          internal_handle->chunk_groups_cache,
+			          (off64_t) chunk_index * internal_handle->media_values->chunk_size,
+			          maximum_contiguous_size,
+			          &file_io_pool_entry,
+			          &range_offset,
+			          &range_size,
+			          &range_flags,
+			          &contiguous_data_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %" PRIu64 " range.",
+				 function,
+				 chunk_index );
 
-			return( -1 );
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				if( libewf_chunk_data_initialize(
+				     &safe_chunk_data,
+				     internal_handle->media_values->chunk_size,
+				     internal_handle->io_handle->buffer_pool,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+				read_chunk_data = 1;
+
+				/* Chunks that are stored back to back are read with a single read
+				 * into the shared coalesced read buffer
+				 */
+				if( contiguous_data_size > 0 )
+				{
+					read_count = libewf_chunk_data_read_from_coalesced_read_buffer(
+						      safe_chunk_data,
+						      internal_handle->coalesced_read_buffer,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      range_offset,
+						      range_size,
+						      range_flags,
+						      contiguous_data_size,
+						      error );
+
+					if( read_count < 0 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read chunk: %" PRIu64 " data.",
+						 function,
+						 chunk_index );
+
+						goto on_error;
+					}
+					read_chunk_data = 0;
+				}
+			}
 		}
-	}
-	if( internal_handle->write_io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing write IO handle.",
-		 function );
+#if !defined( HAVE_LIBBFIO_POOL_READ_BUFFER_AT_OFFSET )
+		/* Without positional reads the seek and read of the file IO pool entry
+		 * must not be interleaved with those of other threads
+		 */
+		if( read_chunk_data != 0 )
+		{
+			read_count = libewf_chunk_data_read_from_file_io_pool(
+				      safe_chunk_data,
+				      file_io_pool,
+				      file_io_pool_entry,
+				      range_offset,
+				      range_size,
+				      range_flags,
+				      error );
 
-		return( -1 );
-	}
-	if( internal_handle->media_values == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
 
-		return( -1 );
+				goto on_error;
+			}
+			read_chunk_data = 0;
+		}
+#endif
+		if( safe_chunk_data == NULL )
+		{
+			/* The chunks cache takes over management of the chunk data
+			 * of chunks that are not available, the data of which is marked as corrupted
+			 */
+			if( libewf_chunk_table_get_chunk_data_by_offset(
+			     internal_handle->chunk_table,
+			     chunk_index,
+			     internal_handle->io_handle,
+			     file_io_pool,
+			     internal_handle->media_values,
+			     internal_handle->segment_table,
+			     internal_handle->chunk_groups_cache,
+			     internal_handle->chunks_cache,
+			     offset,
+			     &chunk_data,
+			     &chunk_data_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			if( chunk_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			/* The chunk data is managed by the chunks cache and is copied
+			 * before the read chunk mutex is released
+			 */
+			if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+
+			if( read_size > buffer_size )
+			{
+				read_size = buffer_size;
+			}
+			if( read_size > 0 )
+			{
+				if( memory_copy(
+				     buffer,
+				     &( ( chunk_data->data )[ chunk_data_offset ] ),
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+			}
+		}
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	read_chunk_mutex_grabbed = 0;
+
+	if( libcthreads_mutex_release(
+	     internal_handle->read_chunk_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read chunk mutex.",
 		 function );
 
-		return( -1 );
-	}
-	if( internal_handle->write_io_handle->write_finalized != 0 )
-	{
-		return( 0 );
-	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		return( 0 );
+		goto on_error;
 	}
-	if( internal_handle->chunk_data != NULL )
+#endif
+	if( is_fill_pattern != 0 )
 	{
-		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+		read_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
 
-		chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
-				internal_handle->chunk_table,
-				chunk_index,
-				file_io_pool,
-				internal_handle->segment_table,
-				internal_handle->chunk_groups_cache,
-				internal_handle->current_offset,
-				error );
-
-		if( chunk_exists == -1 )
+		if( read_size > buffer_size )
+		{
+			read_size = buffer_size;
+		}
+		if( libewf_chunk_data_fill_buffer_with_64_bit_pattern(
+		     buffer,
+		     read_size,
+		     (size_t) chunk_data_offset,
+		     pattern,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill buffer with chunk: %" PRIu64 " pattern.",
 			 function,
 			 chunk_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( chunk_exists != 0 )
+		return( (ssize_t) read_size );
+	}
+	if( safe_chunk_data == NULL )
+	{
+		return( (ssize_t) read_size );
+	}
+	if( read_chunk_data != 0 )
+	{
+		read_count = libewf_chunk_data_read_from_file_io_pool(
+			      safe_chunk_data,
+			      file_io_pool,
+			      file_io_pool_entry,
+			      range_offset,
+			      range_size,
+			      range_flags,
+			      error );
+
+		if( read_count < 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already exists.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
 			 function,
 			 chunk_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		input_data_size = internal_handle->chunk_data->data_size;
+	}
+	/* Chunk data that was read ahead is already unpacked
+	 */
+	if( libewf_chunk_data_unpack(
+	     safe_chunk_data,
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
 
-		if( libewf_chunk_data_pack(
-		     internal_handle->chunk_data,
-		     internal_handle->io_handle,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-		     internal_handle->write_io_handle->pack_flags,
+		goto on_error;
+	}
+	if( ( safe_chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_handle->read_chunk_mutex,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to pack chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read chunk mutex.",
+			 function );
 
-			return( -1 );
-		}
-		write_count = libewf_write_io_handle_write_new_chunk(
-			       internal_handle->write_io_handle,
-			       internal_handle->io_handle,
-			       file_io_pool,
-			       internal_handle->media_values,
-			       internal_handle->segment_table,
-			       internal_handle->header_values,
-			       internal_handle->hash_values,
-			       internal_handle->hash_sections,
-			       internal_handle->sessions,
-			       internal_handle->tracks,
-			       internal_handle->acquiry_errors,
-			       chunk_index,
-			       internal_handle->chunk_data,
-			       input_data_size,
-			       error );
-
-		if( write_count <= 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write new chunk.",
-			 function );
-
-			return( -1 );
+			goto on_error;
 		}
-		write_finalize_count += write_count;
-
-		if( libfcache_cache_set_value_by_index(
-		     internal_handle->chunks_cache,
-		     chunk_index % LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
-		     0,
-		     internal_handle->current_offset,
-		     0,
-		     (intptr_t *) internal_handle->chunk_data,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
-		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+		read_chunk_mutex_grabbed = 1;
+#endif
+		if( libewf_internal_handle_append_chunk_checksum_error(
+		     internal_handle,
+		     chunk_index,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set chunk: %" PRIu64 " data.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append chunk: %" PRIu64 " checksum error.",
 			 function,
 			 chunk_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		/* chunks_cache takes over management of chunk_data
-		 */
-		internal_handle->chunk_data = NULL;
-	}
-	/* Check if all media data has been written
-	 */
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
-	{
-		return( write_finalize_count );
-	}
-	if( libewf_segment_table_get_number_of_segments(
-	     internal_handle->segment_table,
-	     &number_of_segments,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments.",
-		 function );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		read_chunk_mutex_grabbed = 0;
 
-		return( -1 );
-	}
-	if( number_of_segments == 0 )
-	{
-		/* No segment file needs to be created
-		 */
-/* TODO clean up this logic: when is this triggered? */
-		if( internal_handle->media_values->media_size != 0 )
-		{
-			return( write_finalize_count );
-		}
-		/* Create the segment file if required
-		 */
-		if( libewf_write_io_handle_create_segment_file(
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->segment_table,
-		     internal_handle->io_handle->segment_file_type,
-		     0,
-		     internal_handle->write_io_handle->maximum_number_of_segments,
-		     internal_handle->media_values->set_identifier,
-		     &file_io_pool_entry,
-		     &segment_file,
+		if( libcthreads_mutex_release(
+		     internal_handle->read_chunk_mutex,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to create segment file: 0.",
-			 function );
-
-			return( -1 );
-		}
-		write_count = libewf_segment_file_write_start(
-		               segment_file,
-		               file_io_pool,
-		               file_io_pool_entry,
-		               &( internal_handle->write_io_handle->case_data ),
-		               &( internal_handle->write_io_handle->case_data_size ),
-		               &( internal_handle->write_io_handle->device_information ),
-		               &( internal_handle->write_io_handle->device_information_size ),
-		               &( internal_handle->write_io_handle->data_section ),
-		               internal_handle->media_values,
-		               internal_handle->header_values,
-		               internal_handle->write_io_handle->timestamp,
-		               error );
-
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write segment file: 0 start.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read chunk mutex.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		write_finalize_count += write_count;
+#endif
 	}
-	else
+	/* Only chunks that fit in a cache entry are stored, e.g. not
+	 * the data of a chunk that could not be unpacked
+	 */
+	if( ( internal_handle->chunk_cache != NULL )
+	 && ( safe_chunk_data->data_size <= (size_t) internal_handle->media_values->chunk_size ) )
 	{
-		segment_number = number_of_segments - 1;
-
-		if( libewf_segment_table_get_segment_by_index(
-		     internal_handle->segment_table,
-		     segment_number,
-		     &file_io_pool_entry,
-		     &segment_file_size,
+		if( libewf_sharded_chunk_cache_set_data(
+		     internal_handle->chunk_cache,
+		     chunk_index,
+		     safe_chunk_data->data,
+		     safe_chunk_data->data_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " data in chunk cache.",
 			 function,
-			 segment_number );
+			 chunk_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( libewf_segment_table_get_segment_file_by_index(
-		     internal_handle->segment_table,
-		     segment_number,
-		     file_io_pool,
-		     &segment_file,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
-			 function,
-			 segment_number );
+	}
+	if( (off64_t) chunk_data_offset > (off64_t) safe_chunk_data->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+		 function,
+		 chunk_index );
 
-			return( -1 );
-		}
-		if( segment_file == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing segment file: %" PRIu32 ".",
-			 function,
-			 segment_number );
+		goto on_error;
+	}
+	read_size = (size_t) ( safe_chunk_data->data_size - chunk_data_offset );
 
-			return( -1 );
-		}
+	if( read_size > buffer_size )
+	{
+		read_size = buffer_size;
 	}
-	/* Set segment file to the correct offset if write is resumed
-	 */
-	if( internal_handle->write_io_handle->resume_segment_file_offset > 0 )
+	if( read_size > 0 )
 	{
-		if( libbfio_pool_seek_offset(
-		     file_io_pool,
-		     file_io_pool_entry,
-		     internal_handle->write_io_handle->resume_segment_file_offset,
-		     SEEK_SET,
-		     error ) == -1 )
+		if( memory_copy(
+		     buffer,
+		     &( ( safe_chunk_data->data )[ chunk_data_offset ] ),
+		     read_size ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to seek resume segment file offset: %" PRIi64 " in segment file: %" PRIu32 ".",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
 			 function,
-			 internal_handle->write_io_handle->resume_segment_file_offset,
-			 segment_number );
+			 chunk_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		internal_handle->write_io_handle->resume_segment_file_offset = 0;
 	}
-	/* Check if the last segment file is still open for writing
-	 */
-	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN ) != 0 )
+	if( libewf_chunk_data_free(
+	     &safe_chunk_data,
+	     error ) != 1 )
 	{
-		/* Check if chunks section needs to be corrected
-		 */
-		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
-		{
-			write_count = libewf_write_io_handle_write_chunks_section_end(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-				       file_io_pool,
-				       file_io_pool_entry,
-			               segment_file,
-			               error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
 
-			if( write_count == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write chunks section end.",
-				 function );
+		goto on_error;
+	}
+	return( (ssize_t) read_size );
 
-				return( -1 );
-			}
-			write_finalize_count += write_count;
-		}
-		/* Close the segment file
-		 */
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: closing last segment file.\n",
-			 function );
-		}
+on_error:
+	if( safe_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &safe_chunk_data,
+		 NULL );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( read_chunk_mutex_grabbed != 0 )
+	{
+		libcthreads_mutex_release(
+		 internal_handle->read_chunk_mutex,
+		 NULL );
+	}
 #endif
-		write_count = libewf_segment_file_write_close(
-		               segment_file,
-		               file_io_pool,
-		               file_io_pool_entry,
-		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
-		               1,
-		               internal_handle->hash_sections,
-		               internal_handle->hash_values,
-		               internal_handle->media_values,
-		               internal_handle->sessions,
-		               internal_handle->tracks,
-		               internal_handle->acquiry_errors,
-		               &( internal_handle->write_io_handle->data_section ),
-		               error );
+	return( -1 );
+}
 
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to close segment file.",
-			 function );
+/* Reads (media) data at a specific offset into a buffer using a Basic File IO (bfio) pool
+ * The current offset is not changed
+ * This function can be called concurrently when the read lock is held
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function    = "libewf_internal_handle_read_buffer_at_offset_from_file_io_pool";
+	size_t buffer_offset     = 0;
+	size_t chunk_data_offset = 0;
+	size_t read_size         = 0;
+	ssize_t read_count       = 0;
+	ssize_t total_read_count = 0;
+	uint64_t chunk_index     = 0;
+	int result               = 0;
 
-			return( -1 );
-		}
-		write_finalize_count += write_count;
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
 	}
-	/* Correct the media values if streamed write was used
-	 */
-	if( internal_handle->media_values->media_size == 0 )
+	if( internal_handle->io_handle == NULL )
 	{
-		/* Determine the media values
-		 */
-		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
-		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
-		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
 
-		/* Flush the section write caches
-		 */
-		if( internal_handle->write_io_handle->case_data != NULL )
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) ( offset + buffer_size ) >= internal_handle->media_values->media_size )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - offset );
+	}
+	chunk_index = offset / internal_handle->media_values->chunk_size;
+
+	while( buffer_size > 0 )
+	{
+		result = 0;
+
+		if( internal_handle->chunk_cache != NULL )
 		{
-			memory_free(
-			 internal_handle->write_io_handle->case_data );
+			chunk_data_offset = (size_t) ( offset - ( (off64_t) chunk_index * internal_handle->media_values->chunk_size ) );
 
-			internal_handle->write_io_handle->case_data      = NULL;
-			internal_handle->write_io_handle->case_data_size = 0;
+			result = libewf_sharded_chunk_cache_copy_data(
+			          internal_handle->chunk_cache,
+			          chunk_index,
+			          chunk_data_offset,
+			          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			          buffer_size,
+			          &read_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data from chunk cache.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
 		}
-		if( internal_handle->write_io_handle->device_information != NULL )
+		if( result == 0 )
 		{
-			memory_free(
-			 internal_handle->write_io_handle->device_information );
+			read_count = libewf_internal_handle_read_chunk_buffer_from_file_io_pool(
+			              internal_handle,
+			              file_io_pool,
+			              chunk_index,
+			              offset,
+			              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			              buffer_size,
+			              error );
 
-			internal_handle->write_io_handle->device_information      = NULL;
-			internal_handle->write_io_handle->device_information_size = 0;
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			read_size = (size_t) read_count;
 		}
-		if( internal_handle->write_io_handle->data_section != NULL )
+		if( read_size == 0 )
 		{
-			memory_free(
-			 internal_handle->write_io_handle->data_section );
+			break;
+		}
+		buffer_offset    += read_size;
+		buffer_size      -= read_size;
+		total_read_count += (ssize_t) read_size;
+		chunk_index      += 1;
+		offset           += (off64_t) read_size;
 
-			internal_handle->write_io_handle->data_section = NULL;
+		if( (size64_t) offset >= internal_handle->media_values->media_size )
+		{
+			break;
 		}
-		/* Correct the sections in the segment files
-		 */
-		if( libewf_write_io_handle_finalize_write_sections_corrections(
-		     internal_handle->write_io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     internal_handle->header_values,
-		     internal_handle->hash_values,
-		     internal_handle->hash_sections,
-		     internal_handle->sessions,
-		     internal_handle->tracks,
-		     internal_handle->acquiry_errors,
-		     error ) != 1 )
+		if( internal_handle->io_handle->abort != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write sections corrections to segment files.",
-			 function );
-
-			return( -1 );
+			break;
 		}
 	}
-	internal_handle->write_io_handle->write_finalized = 1;
-
-	return( write_finalize_count );
+	return( total_read_count );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
+/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
  */
-ssize_t libewf_handle_write_finalize(
-         libewf_handle_t *handle,
+ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
          libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_finalize";
-	ssize_t write_count                       = 0;
+	static char *function = "libewf_internal_handle_read_buffer_from_file_io_pool";
+	ssize_t read_count    = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -6533,19 +7465,3671 @@ ssize_t libewf_handle_write_finalize(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+	              internal_handle,
+	              file_io_pool,
+	              buffer,
+	              buffer_size,
+	              internal_handle->current_offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 ".",
+		 function,
+		 internal_handle->current_offset );
+
+		return( -1 );
+	}
+	internal_handle->current_offset += (off64_t) read_count;
+
+	return( read_count );
+}
+
+/* Reads (media) data at the current offset into a buffer
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
+		      internal_handle,
+		      internal_handle->file_io_pool,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (media) data at a specific offset
+ * The current offset is not changed, which allows multiple threads to read
+ * from the same handle concurrently
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer_at_offset(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer_at_offset";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Writes the chunks that have been packed by the write pipeline
+ * The chunks are written in order, a chunk that is still being packed
+ * holds back the chunks that follow it
+ * If flush is set the function waits for all the chunks to be packed and written
+ * otherwise it only waits when the write pipeline is full
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_packed_chunks_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint8_t flush,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_write_packed_chunks_to_file_io_pool";
+	size_t input_data_size          = 0;
+	ssize_t total_write_count       = 0;
+	ssize_t write_count             = 0;
+	uint64_t chunk_index            = 0;
+	uint8_t wait_for_chunk          = 0;
+	int result                      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		wait_for_chunk = flush;
+
+		if( wait_for_chunk == 0 )
+		{
+			result = libewf_write_pipeline_is_full(
+			          internal_handle->write_pipeline,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if write pipeline is full.",
+				 function );
+
+				goto on_error;
+			}
+			wait_for_chunk = (uint8_t) result;
+		}
+		result = libewf_write_pipeline_pop_chunk(
+		          internal_handle->write_pipeline,
+		          wait_for_chunk,
+		          &chunk_index,
+		          &chunk_data,
+		          &input_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve packed chunk from write pipeline.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			write_count = libewf_write_io_handle_write_new_chunk(
+			               internal_handle->write_io_handle,
+			               internal_handle->io_handle,
+			               file_io_pool,
+			               internal_handle->media_values,
+			               internal_handle->segment_table,
+			               internal_handle->header_values,
+			               internal_handle->hash_values,
+			               internal_handle->hash_sections,
+			               internal_handle->sessions,
+			               internal_handle->tracks,
+			               internal_handle->acquiry_errors,
+			               chunk_index,
+			               chunk_data,
+			               input_data_size,
+			               error );
+
+			if( write_count <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write new chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			total_write_count += write_count;
+
+			if( libewf_chunk_data_free(
+			     &chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+	}
+	while( result != 0 );
+
+	return( total_write_count );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function         = "libewf_internal_handle_write_buffer_to_file_io_pool";
+	off64_t chunk_data_offset     = 0;
+	size_t buffer_offset          = 0;
+	size_t input_data_size        = 0;
+	size_t write_size             = 0;
+	ssize_t write_count           = 0;
+	uint64_t chunk_index          = 0;
+	uint64_t number_of_chunks_set = 0;
+	int write_chunk               = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int result                    = 0;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+	}
+	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	if( chunk_index >= (uint64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk index value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
+	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
+
+	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk data offset value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_size > 0 )
+	{
+		/* The chunks queued in the write pipeline are set but not yet written
+		 */
+		number_of_chunks_set = internal_handle->write_io_handle->number_of_chunks_written;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_handle->write_pipeline != NULL )
+		{
+			number_of_chunks_set += (uint64_t) internal_handle->write_pipeline->number_of_used_entries;
+		}
+#endif
+		if( chunk_index < number_of_chunks_set )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already set.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( internal_handle->write_io_handle->write_finalized != 0 )
+		{
+			break;
+		}
+		if( internal_handle->chunk_data == NULL )
+		{
+			if( libewf_chunk_data_initialize(
+			     &( internal_handle->chunk_data ),
+			     internal_handle->media_values->chunk_size,
+			     internal_handle->io_handle->buffer_pool,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+		}
+		if( internal_handle->chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: internal handle - missing chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( chunk_data_offset > internal_handle->media_values->chunk_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: chunk offset exceeds chunk data size.",
+			 function );
+
+			return( -1 );
+		}
+		write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
+
+		if( write_size > buffer_size )
+		{
+			write_size = buffer_size;
+		}
+		if( write_size == 0 )
+		{
+			break;
+		}
+		if( memory_copy(
+		     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
+		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		     write_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy buffer to chunk data.",
+			 function );
+
+			return( -1 );
+		}
+		internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
+
+		buffer_offset += write_size;
+		buffer_size   -= write_size;
+
+		if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
+		{
+			write_chunk = 1;
+		}
+		else if( ( internal_handle->media_values->media_size != 0 )
+		      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
+		{
+			write_chunk = 1;
+		}
+		else
+		{
+			write_chunk = 0;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( write_chunk != 0 )
+		 && ( internal_handle->write_pipeline != NULL ) )
+		{
+			/* Make sure there is room in the write pipeline for the chunk
+			 */
+			if( libewf_internal_handle_write_packed_chunks_to_file_io_pool(
+			     internal_handle,
+			     file_io_pool,
+			     0,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write packed chunks.",
+				 function );
+
+				return( -1 );
+			}
+			/* The write pipeline takes over management of the chunk data
+			 */
+			result = libewf_write_pipeline_push_chunk(
+			          internal_handle->write_pipeline,
+			          chunk_index,
+			          internal_handle->chunk_data,
+			          internal_handle->chunk_data->data_size,
+			          internal_handle->io_handle->compression_level,
+			          internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+			          internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+			          internal_handle->write_io_handle->pack_flags,
+			          error );
+
+			internal_handle->chunk_data = NULL;
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push chunk: %" PRIu64 " onto write pipeline.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+		}
+		else
+#endif
+		if( write_chunk != 0 )
+		{
+			input_data_size = internal_handle->chunk_data->data_size;
+
+			if( libewf_chunk_data_pack(
+			     internal_handle->chunk_data,
+			     internal_handle->io_handle,
+			     internal_handle->io_handle->compression_level,
+			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+			     internal_handle->write_io_handle->pack_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to pack chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			write_count = libewf_write_io_handle_write_new_chunk(
+			               internal_handle->write_io_handle,
+			               internal_handle->io_handle,
+			               file_io_pool,
+			               internal_handle->media_values,
+			               internal_handle->segment_table,
+			               internal_handle->header_values,
+			               internal_handle->hash_values,
+			               internal_handle->hash_sections,
+			               internal_handle->sessions,
+			               internal_handle->tracks,
+			               internal_handle->acquiry_errors,
+			               chunk_index,
+			               internal_handle->chunk_data,
+			               input_data_size,
+			               error );
+
+			if( write_count <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write new chunk.",
+				 function );
+
+				return( -1 );
+			}
+			if( libewf_chunk_data_free(
+			     &( internal_handle->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		chunk_index      += 1;
+		chunk_data_offset = 0;
+
+		internal_handle->current_offset += (off64_t) write_size;
+
+		if( ( internal_handle->media_values->media_size != 0 )
+		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes (media) data at the current offset
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               buffer,
+	               buffer_size,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Writes (media) data at a specific offset,
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer_at_offset(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer_at_offset";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_internal_handle_seek_offset(
+	     internal_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               buffer,
+	               buffer_size,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves a (media) data chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_data_chunk(
+     libewf_handle_t *handle,
+     libewf_data_chunk_t **data_chunk,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_data_chunk";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_chunk != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: data chunk value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->write_io_handle != NULL )
+	 && ( internal_handle->write_io_handle->values_initialized == 0 ) )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_data_chunk_initialize(
+	     data_chunk,
+	     internal_handle->io_handle,
+	     internal_handle->write_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data chunk.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads a (media) data chunk at the current offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_data_chunk_from_file_io_pool";
+	off64_t chunk_data_offset       = 0;
+	ssize_t read_count              = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+/* TODO remove need to calculate */
+	internal_handle->current_chunk_index = internal_handle->current_offset
+	                                     / internal_handle->media_values->chunk_size;
+
+	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
+	                                * (off64_t) internal_handle->media_values->chunk_size;
+
+	if( libewf_internal_handle_read_deferred_segment_files(
+	     internal_handle,
+	     file_io_pool,
+	     internal_handle->current_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred segment files.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_table_get_chunk_data_by_offset(
+	     internal_handle->chunk_table,
+	     internal_handle->current_chunk_index,
+	     internal_handle->io_handle,
+	     file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     internal_handle->chunk_groups_cache,
+	     internal_handle->chunks_cache,
+	     internal_handle->current_offset,
+	     &chunk_data,
+	     &chunk_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk: %" PRIu64 " data.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	read_count = (ssize_t) chunk_data->data_size;
+
+	if( libewf_internal_data_chunk_set_chunk_data(
+	     internal_data_chunk,
+	     internal_handle->current_chunk_index,
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	internal_handle->current_offset += read_count;
+
+	internal_handle->current_chunk_index++;
+
+	return( read_count );
+}
+
+/* Reads a (media) data chunk at the current offset
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_data_chunk";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_data_chunk_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              (libewf_internal_data_chunk_t *) data_chunk,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data chunk.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Writes a (media) data chunk at the current offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
+	size_t data_size      = 0;
+	ssize_t write_count   = 0;
+	int chunk_exists      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	data_size = internal_data_chunk->data_size;
+
+	if( internal_handle->media_values->media_size != 0 )
+	{
+		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: last data chunk size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The chunks queued in the write pipeline precede the data chunk
+	 */
+	if( internal_handle->write_pipeline != NULL )
+	{
+		if( libewf_internal_handle_write_packed_chunks_to_file_io_pool(
+		     internal_handle,
+		     file_io_pool,
+		     1,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write packed chunks.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+/* TODO remove need to calculate */
+	internal_handle->current_chunk_index = internal_handle->current_offset
+	                                     / internal_handle->media_values->chunk_size;
+
+	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
+	                                * (off64_t) internal_handle->media_values->chunk_size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: writing chunk: %" PRIu64 " of size: %" PRIzd ".\n",
+		 function,
+		 internal_handle->current_chunk_index,
+		 data_size );
+	}
+#endif
+	chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
+	                internal_handle->chunk_table,
+	                internal_handle->current_chunk_index,
+	                file_io_pool,
+	                internal_handle->segment_table,
+	                internal_handle->chunk_groups_cache,
+	                internal_handle->current_offset,
+			error );
+
+	if( chunk_exists == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	else if( chunk_exists != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: chunk: %" PRIu64 " already exists.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	write_count = libewf_write_io_handle_write_new_chunk(
+	               internal_handle->write_io_handle,
+	               internal_handle->io_handle,
+	               file_io_pool,
+	               internal_handle->media_values,
+	               internal_handle->segment_table,
+	               internal_handle->header_values,
+	               internal_handle->hash_values,
+	               internal_handle->hash_sections,
+	               internal_handle->sessions,
+	               internal_handle->tracks,
+	               internal_handle->acquiry_errors,
+	               internal_handle->current_chunk_index,
+	               internal_data_chunk->chunk_data,
+	               data_size,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset += (off64_t) data_size;
+
+	return( write_count );
+}
+
+/* Writes a (media) data chunk at the current offset
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_data_chunk";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libewf_internal_handle_write_data_chunk_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               (libewf_internal_data_chunk_t *) data_chunk,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data chunk.",
+		 function );
+
+		write_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_finalize_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
+	size64_t segment_file_size          = 0;
+	size_t input_data_size              = 0;
+	ssize_t write_count                 = 0;
+	ssize_t write_finalize_count        = 0;
+	uint64_t chunk_index                = 0;
+	uint32_t number_of_segments         = 0;
+	uint32_t segment_number             = 0;
+	int chunk_exists                    = 0;
+	int file_io_pool_entry              = -1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle->write_finalized != 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->write_pipeline != NULL )
+	{
+		write_count = libewf_internal_handle_write_packed_chunks_to_file_io_pool(
+		               internal_handle,
+		               file_io_pool,
+		               1,
+		               error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write packed chunks.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+#endif
+	if( internal_handle->chunk_data != NULL )
+	{
+		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+		chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
+				internal_handle->chunk_table,
+				chunk_index,
+				file_io_pool,
+				internal_handle->segment_table,
+				internal_handle->chunk_groups_cache,
+				internal_handle->current_offset,
+				error );
+
+		if( chunk_exists == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( chunk_exists != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		input_data_size = internal_handle->chunk_data->data_size;
+
+		if( libewf_chunk_data_pack(
+		     internal_handle->chunk_data,
+		     internal_handle->io_handle,
+		     internal_handle->io_handle->compression_level,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+		     internal_handle->write_io_handle->pack_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		write_count = libewf_write_io_handle_write_new_chunk(
+			       internal_handle->write_io_handle,
+			       internal_handle->io_handle,
+			       file_io_pool,
+			       internal_handle->media_values,
+			       internal_handle->segment_table,
+			       internal_handle->header_values,
+			       internal_handle->hash_values,
+			       internal_handle->hash_sections,
+			       internal_handle->sessions,
+			       internal_handle->tracks,
+			       internal_handle->acquiry_errors,
+			       chunk_index,
+			       internal_handle->chunk_data,
+			       input_data_size,
+			       error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write new chunk.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+
+		if( libfcache_cache_set_value_by_index(
+		     internal_handle->chunks_cache,
+		     chunk_index % LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
+		     0,
+		     internal_handle->current_offset,
+		     0,
+		     (intptr_t *) internal_handle->chunk_data,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		/* chunks_cache takes over management of chunk_data
+		 */
+		internal_handle->chunk_data = NULL;
+	}
+	/* Check if all media data has been written
+	 */
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
+	{
+		return( write_finalize_count );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == 0 )
+	{
+		/* No segment file needs to be created
+		 */
+/* TODO clean up this logic: when is this triggered? */
+		if( internal_handle->media_values->media_size != 0 )
+		{
+			return( write_finalize_count );
+		}
+		/* Create the segment file if required
+		 */
+		if( libewf_write_io_handle_create_segment_file(
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     internal_handle->write_io_handle->io_engine,
+		     internal_handle->segment_table,
+		     internal_handle->io_handle->segment_file_type,
+		     0,
+		     internal_handle->write_io_handle->maximum_number_of_segments,
+		     internal_handle->media_values->set_identifier,
+		     &file_io_pool_entry,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to create segment file: 0.",
+			 function );
+
+			return( -1 );
+		}
+		write_count = libewf_segment_file_write_start(
+		               segment_file,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               &( internal_handle->write_io_handle->case_data ),
+		               &( internal_handle->write_io_handle->case_data_size ),
+		               &( internal_handle->write_io_handle->device_information ),
+		               &( internal_handle->write_io_handle->device_information_size ),
+		               &( internal_handle->write_io_handle->data_section ),
+		               internal_handle->media_values,
+		               internal_handle->header_values,
+		               internal_handle->write_io_handle->timestamp,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write segment file: 0 start.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	else
+	{
+		segment_number = number_of_segments - 1;
+
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( libewf_segment_table_get_segment_file_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+	}
+	/* Set segment file to the correct offset if write is resumed
+	 */
+	if( internal_handle->write_io_handle->resume_segment_file_offset > 0 )
+	{
+		if( libbfio_pool_seek_offset(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     internal_handle->write_io_handle->resume_segment_file_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to seek resume segment file offset: %" PRIi64 " in segment file: %" PRIu32 ".",
+			 function,
+			 internal_handle->write_io_handle->resume_segment_file_offset,
+			 segment_number );
+
+			return( -1 );
+		}
+		internal_handle->write_io_handle->resume_segment_file_offset = 0;
+	}
+	/* Check if the last segment file is still open for writing
+	 */
+	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN ) != 0 )
+	{
+		/* Check if chunks section needs to be corrected
+		 */
+		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
+		{
+			write_count = libewf_write_io_handle_write_chunks_section_end(
+			               internal_handle->write_io_handle,
+			               internal_handle->io_handle,
+				       file_io_pool,
+				       file_io_pool_entry,
+			               segment_file,
+			               error );
+
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write chunks section end.",
+				 function );
+
+				return( -1 );
+			}
+			write_finalize_count += write_count;
+		}
+		/* Close the segment file
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: closing last segment file.\n",
+			 function );
+		}
+#endif
+		write_count = libewf_segment_file_write_close(
+		               segment_file,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
+		               1,
+		               internal_handle->hash_sections,
+		               internal_handle->hash_values,
+		               internal_handle->media_values,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               &( internal_handle->write_io_handle->data_section ),
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to close segment file.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	/* Correct the media values if streamed write was used
+	 */
+	if( internal_handle->media_values->media_size == 0 )
+	{
+		/* Determine the media values
+		 */
+		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
+		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
+		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
+
+		/* Flush the section write caches
+		 */
+		if( internal_handle->write_io_handle->case_data != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->case_data );
+
+			internal_handle->write_io_handle->case_data      = NULL;
+			internal_handle->write_io_handle->case_data_size = 0;
+		}
+		if( internal_handle->write_io_handle->device_information != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->device_information );
+
+			internal_handle->write_io_handle->device_information      = NULL;
+			internal_handle->write_io_handle->device_information_size = 0;
+		}
+		if( internal_handle->write_io_handle->data_section != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->data_section );
+
+			internal_handle->write_io_handle->data_section = NULL;
+		}
+		/* Correct the sections in the segment files
+		 */
+		if( libewf_write_io_handle_finalize_write_sections_corrections(
+		     internal_handle->write_io_handle,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     internal_handle->header_values,
+		     internal_handle->hash_values,
+		     internal_handle->hash_sections,
+		     internal_handle->sessions,
+		     internal_handle->tracks,
+		     internal_handle->acquiry_errors,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write sections corrections to segment files.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	internal_handle->write_io_handle->write_finalized = 1;
+
+	return( write_finalize_count );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_handle_write_finalize(
+         libewf_handle_t *handle,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_finalize";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libewf_internal_handle_write_finalize_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write finalize.",
+		 function );
+
+		write_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Seeks a certain offset of the (media) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_internal_handle_seek_offset(
+         libewf_internal_handle_t *internal_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_seek_offset";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{	
+		offset += internal_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{	
+		offset += (off64_t) internal_handle->media_values->media_size;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: seeking media data offset: %" PRIi64 ".\n",
+		 function,
+		 offset );
+	}
+#endif
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the (media) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_handle_seek_offset(
+         libewf_handle_t *handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_seek_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libewf_internal_handle_seek_offset(
+	          internal_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (media) data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_offset(
+     libewf_handle_t *handle,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_handle->current_offset;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the descriptor of a specific chunk using a Basic File IO (bfio) pool
+ * The descriptor is determined from the chunk table without reading the chunk data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the chunk is not available or -1 on error
+ */
+int libewf_internal_handle_get_chunk_descriptor(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     uint32_t *segment_number,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_get_chunk_descriptor";
+	off64_t offset        = 0;
+	int result            = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= internal_handle->media_values->number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	offset = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
+
+	if( libewf_internal_handle_read_deferred_segment_files(
+	     internal_handle,
+	     file_io_pool,
+	     offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred segment files.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_chunk_descriptor_by_offset(
+	          internal_handle->chunk_table,
+	          chunk_index,
+	          file_io_pool,
+	          internal_handle->segment_table,
+	          internal_handle->chunk_groups_cache,
+	          offset,
+	          segment_number,
+	          chunk_data_offset,
+	          chunk_data_size,
+	          chunk_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " descriptor.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the descriptor of a specific chunk
+ * The descriptor contains the segment number, the offset and size of the chunk data
+ * in the segment file and the chunk flags, determined without reading the chunk data
+ * Returns 1 if successful, 0 if the chunk is not available or -1 on error
+ */
+int libewf_handle_get_chunk_descriptor(
+     libewf_handle_t *handle,
+     uint64_t chunk_index,
+     uint32_t *segment_number,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_flags,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_chunk_descriptor";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_get_chunk_descriptor(
+	          internal_handle,
+	          internal_handle->file_io_pool,
+	          chunk_index,
+	          segment_number,
+	          chunk_data_offset,
+	          chunk_data_size,
+	          chunk_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " descriptor.",
+		 function,
+		 chunk_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the descriptors of consecutive chunks starting with a specific chunk
+ * The descriptors are stored in the segment numbers, chunk data offsets, chunk data sizes
+ * and chunk flags arrays, which must be able to contain the number of descriptors
+ * A chunk that is not available is described with segment number 0 and the corrupted flag
+ * Returns the number of descriptors retrieved, 0 when no more chunks are available or -1 on error
+ */
+ssize_t libewf_handle_get_chunk_descriptors(
+         libewf_handle_t *handle,
+         uint64_t first_chunk_index,
+         uint32_t *segment_numbers,
+         off64_t *chunk_data_offsets,
+         size64_t *chunk_data_sizes,
+         uint32_t *chunk_flags,
+         size_t number_of_descriptors,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_chunk_descriptors";
+	size_t descriptor_index                   = 0;
+	ssize_t number_of_descriptors_read        = 0;
+	uint64_t chunk_index                      = 0;
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_numbers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment numbers.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_descriptors > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of descriptors value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	chunk_index = first_chunk_index;
+
+	for( descriptor_index = 0;
+	     descriptor_index < number_of_descriptors;
+	     descriptor_index++ )
+	{
+		if( chunk_index >= internal_handle->media_values->number_of_chunks )
+		{
+			break;
+		}
+		result = libewf_internal_handle_get_chunk_descriptor(
+		          internal_handle,
+		          internal_handle->file_io_pool,
+		          chunk_index,
+		          &( segment_numbers[ descriptor_index ] ),
+		          &( chunk_data_offsets[ descriptor_index ] ),
+		          &( chunk_data_sizes[ descriptor_index ] ),
+		          &( chunk_flags[ descriptor_index ] ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " descriptor.",
+			 function,
+			 chunk_index );
+
+			number_of_descriptors_read = -1;
+
+			break;
+		}
+		else if( result == 0 )
+		{
+			segment_numbers[ descriptor_index ]    = 0;
+			chunk_data_offsets[ descriptor_index ] = 0;
+			chunk_data_sizes[ descriptor_index ]   = 0;
+			chunk_flags[ descriptor_index ]        = LIBEWF_CHUNK_FLAG_IS_CORRUPTED;
+		}
+		number_of_descriptors_read++;
+
+		chunk_index++;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( number_of_descriptors_read );
+}
+
+/* Sets the maximum number of (concurrent) open file handles
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_number_of_open_handles(
+     libewf_handle_t *handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_io_pool != NULL )
+	{
+		result = libbfio_pool_set_maximum_number_of_open_handles(
+		          internal_handle->file_io_pool,
+		          maximum_number_of_open_handles,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in file IO pool.",
+			 function );
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the number of chunks to read ahead
+ * When the media data is read sequentially the next chunks are read
+ * and unpacked (decompressed and verified) on worker threads
+ * A value of 0 disables read-ahead, which is the default
+ * Read-ahead requires multi-thread support otherwise the value is ignored
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_read_ahead_number_of_chunks(
+     libewf_handle_t *handle,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_read_ahead_number_of_chunks";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( number_of_chunks < 0 )
+	 || ( number_of_chunks > LIBEWF_MAXIMUM_READ_AHEAD_NUMBER_OF_CHUNKS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->read_ahead != NULL )
+	{
+		result = libewf_read_ahead_set_number_of_chunks(
+		          internal_handle->read_ahead,
+		          number_of_chunks,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set number of chunks in read-ahead.",
+			 function );
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->read_ahead_number_of_chunks = number_of_chunks;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the size of the chunk cache
+ * The chunk cache contains the unpacked data of recently read chunks and
+ * is resistant to a large sequential read evicting frequently read chunks
+ * The default is 8 MiB, a value of 0 or a size that cannot contain a single chunk
+ * disables caching of the unpacked data of chunks
+ * The chunk cache is only used when the handle is opened for reading only
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_chunk_cache_size(
+     libewf_handle_t *handle,
+     size64_t chunk_cache_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_chunk_cache_size";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->chunk_cache != NULL )
+	{
+		if( libewf_sharded_chunk_cache_free(
+		     &( internal_handle->chunk_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->chunk_cache_size = chunk_cache_size;
+
+		if( internal_handle->file_io_pool != NULL )
+		{
+			result = libewf_internal_handle_initialize_chunk_cache(
+			          internal_handle,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize chunk cache.",
+				 function );
+			}
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the size of the chunk groups cache
+ * The chunk groups cache contains the chunk offsets of recently read chunk groups
+ * A value of 0 uses the default number of chunk groups
+ * The size is applied the next time the handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_chunk_groups_cache_size(
+     libewf_handle_t *handle,
+     size64_t chunk_groups_cache_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_chunk_groups_cache_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->chunk_groups_cache_size = chunk_groups_cache_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum size of a coalesced read
+ * Chunks that are stored back to back in a segment file are read with a single read
+ * of up to this size, a value of 0 reads every chunk separately
+ * A coalesced read is only done when the chunks are read sequentially
+ * The size is applied the next time the handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_coalesced_read_size(
+     libewf_handle_t *handle,
+     size64_t coalesced_read_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_coalesced_read_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( coalesced_read_size > (size64_t) LIBEWF_MAXIMUM_COALESCED_READ_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid coalesced read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->coalesced_read_size = coalesced_read_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the IO engine used to read or write the segment files
+ * The IO engine is applied the next time the handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_io_engine(
+     libewf_handle_t *handle,
+     int io_engine,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_io_engine";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( io_engine != LIBEWF_IO_ENGINE_BUFFERED )
+	 && ( io_engine != LIBEWF_IO_ENGINE_MEMORY_MAPPED )
+	 && ( io_engine != LIBEWF_IO_ENGINE_IO_URING )
+	 && ( io_engine != LIBEWF_IO_ENGINE_DIRECT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported IO engine.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->io_engine = io_engine;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the chunk index filename
+ * The chunk index filename is applied the next time the handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_chunk_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	char *chunk_index_filename                = NULL;
+	static char *function                     = "libewf_handle_set_chunk_index_filename";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) ( SSIZE_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_index_filename = narrow_string_allocate(
+	                        filename_length + 1 );
+
+	if( chunk_index_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk index filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( narrow_string_copy(
+	     chunk_index_filename,
+	     filename,
+	     filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy chunk index filename.",
+		 function );
+
+		memory_free(
+		 chunk_index_filename );
+
+		return( -1 );
+	}
+	chunk_index_filename[ filename_length ] = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		memory_free(
+		 chunk_index_filename );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->chunk_index_filename != NULL )
+	{
+		memory_free(
+		 internal_handle->chunk_index_filename );
+	}
+	internal_handle->chunk_index_filename      = chunk_index_filename;
+	internal_handle->chunk_index_filename_size = filename_length + 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the lazy open
+ * The lazy open is applied the next time the handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_lazy_open(
+     libewf_handle_t *handle,
+     uint8_t lazy_open,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_lazy_open";
 
-	if( internal_handle->file_io_pool == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -6561,22 +11145,8 @@ ssize_t libewf_handle_write_finalize(
 		return( -1 );
 	}
 #endif
-	write_count = libewf_internal_handle_write_finalize_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               error );
-
-	if( write_count == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write finalize.",
-		 function );
+	internal_handle->lazy_open = lazy_open;
 
-		write_count = -1;
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -6592,22 +11162,26 @@ ssize_t libewf_handle_write_finalize(
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( 1 );
 }
 
-/* Seeks a certain offset of the (media) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+/* Sets the buffer pool values
+ * The buffer pool retains the buffers of the chunk data for reuse up to the maximum size,
+ * a maximum size of 0 disables the retention of buffers
+ * The buffer pool values cannot be changed while buffers of the pool are in use
+ * Returns 1 if successful or -1 on error
  */
-off64_t libewf_internal_handle_seek_offset(
-         libewf_internal_handle_t *internal_handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libewf_handle_set_buffer_pool_values(
+     libewf_handle_t *handle,
+     size64_t maximum_size,
+     uint8_t flags,
+     libcerror_error_t **error )
 {
-	static char *function = "libewf_internal_handle_seek_offset";
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_buffer_pool_values";
+	int result                                = 1;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -6618,96 +11192,71 @@ off64_t libewf_internal_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
-		 function );
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-		return( -1 );
-	}
-	if( internal_handle->media_values == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+#endif
+	if( libewf_buffer_pool_set_values(
+	     internal_handle->buffer_pool,
+	     maximum_size,
+	     flags,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set buffer pool values.",
 		 function );
 
-		return( -1 );
-	}
-	if( whence == SEEK_CUR )
-	{	
-		offset += internal_handle->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{	
-		offset += (off64_t) internal_handle->media_values->media_size;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: seeking media data offset: %" PRIi64 ".\n",
-		 function,
-		 offset );
+		result = -1;
 	}
-#endif
-	if( offset < 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->current_offset = offset;
-
-	return( offset );
+#endif
+	return( result );
 }
 
-/* Seeks a certain offset of the (media) data
- * Returns the offset if seek is successful or -1 on error
+/* Sets the arena from which the buffer pool carves the buffers of the chunk data
+ * The arena is not managed by the handle and must remain available until the handle is freed
+ * or another arena is set, an arena of NULL removes a previously set arena
+ * The arena cannot be changed while buffers of the pool are in use
+ * Returns 1 if successful or -1 on error
  */
-off64_t libewf_handle_seek_offset(
-         libewf_handle_t *handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libewf_handle_set_buffer_pool_arena(
+     libewf_handle_t *handle,
+     uint8_t *arena,
+     size_t arena_size,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_seek_offset";
+	static char *function                     = "libewf_handle_set_buffer_pool_arena";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -6722,17 +11271,6 @@ off64_t libewf_handle_seek_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -6748,20 +11286,20 @@ off64_t libewf_handle_seek_offset(
 		return( -1 );
 	}
 #endif
-	offset = libewf_internal_handle_seek_offset(
-	          internal_handle,
-	          offset,
-	          whence,
-	          error );
-
-	if( offset == -1 )
+	if( libewf_buffer_pool_set_arena(
+	     internal_handle->buffer_pool,
+	     arena,
+	     arena_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set buffer pool arena.",
 		 function );
+
+		result = -1;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -6778,19 +11316,24 @@ off64_t libewf_handle_seek_offset(
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( result );
 }
 
-/* Retrieves the current offset of the (media) data
+/* Sets the number of threads used to pack (compress) the chunks that are written
+ * The chunks are packed on worker threads and written in order, the number of chunks
+ * that are kept in memory is bounded by the number of threads
+ * A value of 0 packs the chunks on the calling thread, which is the default
+ * The number of threads is applied the next time the handle is opened for writing
+ * Requires multi-thread support otherwise the value is ignored
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_offset(
+int libewf_handle_set_write_number_of_threads(
      libewf_handle_t *handle,
-     off64_t *offset,
+     int number_of_threads,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_offset";
+	static char *function                     = "libewf_handle_set_write_number_of_threads";
 
 	if( handle == NULL )
 	{
@@ -6805,19 +11348,20 @@ int libewf_handle_get_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( offset == NULL )
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_WRITE_NUMBER_OF_THREADS ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6825,16 +11369,16 @@ int libewf_handle_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	*offset = internal_handle->current_offset;
+	internal_handle->write_number_of_threads = number_of_threads;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6842,7 +11386,7 @@ int libewf_handle_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -6851,17 +11395,19 @@ int libewf_handle_get_offset(
 	return( 1 );
 }
 
-/* Sets the maximum number of (concurrent) open file handles
+/* Sets the size of a write of the write-behind buffer
+ * The chunks written to a segment file are aggregated into writes of this size
+ * a value of 0 writes every chunk separately
+ * The size is applied the next time the handle is opened for writing
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_maximum_number_of_open_handles(
+int libewf_handle_set_write_behind_size(
      libewf_handle_t *handle,
-     int maximum_number_of_open_handles,
+     size64_t write_behind_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
-	int result                                = 1;
+	static char *function                     = "libewf_handle_set_write_behind_size";
 
 	if( handle == NULL )
 	{
@@ -6876,6 +11422,17 @@ int libewf_handle_set_maximum_number_of_open_handles(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( write_behind_size > (size64_t) LIBEWF_MAXIMUM_WRITE_BEHIND_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid write-behind size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -6891,27 +11448,8 @@ int libewf_handle_set_maximum_number_of_open_handles(
 		return( -1 );
 	}
 #endif
-	if( internal_handle->file_io_pool != NULL )
-	{
-		result = libbfio_pool_set_maximum_number_of_open_handles(
-		          internal_handle->file_io_pool,
-		          maximum_number_of_open_handles,
-		          error );
+	internal_handle->write_behind_size = write_behind_size;
 
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set maximum number of open handles in file IO pool.",
-			 function );
-		}
-	}
-	if( result == 1 )
-	{
-		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -6927,7 +11465,7 @@ int libewf_handle_set_maximum_number_of_open_handles(
 		return( -1 );
 	}
 #endif
-	return( result );
+	return( 1 );
 }
 
 /* Determine if the segment files are corrupted
@@ -7801,10 +12339,32 @@ int libewf_handle_get_filename_size(
 	}
 	else if( result != 0 )
 	{
-		result = libbfio_file_get_name_size(
-		          file_io_handle,
-		          filename_size,
-		          error );
+#if defined( HAVE_LIBEWF_MEMORY_MAPPED_FILE_IO_HANDLE )
+		if( internal_handle->file_io_pool_io_engine == LIBEWF_IO_ENGINE_MEMORY_MAPPED )
+		{
+			result = libewf_memory_mapped_file_get_name_size(
+			          file_io_handle,
+			          filename_size,
+			          error );
+		}
+		else
+#endif
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_HANDLE )
+		if( internal_handle->file_io_pool_io_engine == LIBEWF_IO_ENGINE_DIRECT )
+		{
+			result = libewf_direct_file_get_name_size(
+			          file_io_handle,
+			          filename_size,
+			          error );
+		}
+		else
+#endif
+		{
+			result = libbfio_file_get_name_size(
+			          file_io_handle,
+			          filename_size,
+			          error );
+		}
 
 		if( result != 1 )
 		{
@@ -7893,11 +12453,35 @@ int libewf_handle_get_filename(
 	}
 	else if( result != 0 )
 	{
-		result = libbfio_file_get_name(
-		          file_io_handle,
-		          filename,
-		          filename_size,
-		          error );
+#if defined( HAVE_LIBEWF_MEMORY_MAPPED_FILE_IO_HANDLE )
+		if( internal_handle->file_io_pool_io_engine == LIBEWF_IO_ENGINE_MEMORY_MAPPED )
+		{
+			result = libewf_memory_mapped_file_get_name(
+			          file_io_handle,
+			          filename,
+			          filename_size,
+			          error );
+		}
+		else
+#endif
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_HANDLE )
+		if( internal_handle->file_io_pool_io_engine == LIBEWF_IO_ENGINE_DIRECT )
+		{
+			result = libewf_direct_file_get_name(
+			          file_io_handle,
+			          filename,
+			          filename_size,
+			          error );
+		}
+		else
+#endif
+		{
+			result = libbfio_file_get_name(
+			          file_io_handle,
+			          filename,
+			          filename_size,
+			          error );
+		}
 
 		if( result != 1 )
 		{
@@ -7987,10 +12571,32 @@ int libewf_handle_get_filename_size_wide(
 	}
 	else if( result != 0 )
 	{
-		result = libbfio_file_get_name_size_wide(
-		          file_io_handle,
-		          filename_size,
-		          error );
+#if defined( HAVE_LIBEWF_MEMORY_MAPPED_FILE_IO_HANDLE )
+		if( internal_handle->file_io_pool_io_engine == LIBEWF_IO_ENGINE_MEMORY_MAPPED )
+		{
+			result = libewf_memory_mapped_file_get_name_size_wide(
+			          file_io_handle,
+			          filename_size,
+			          error );
+		}
+		else
+#endif
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_HANDLE )
+		if( internal_handle->file_io_pool_io_engine == LIBEWF_IO_ENGINE_DIRECT )
+		{
+			result = libewf_direct_file_get_name_size_wide(
+			          file_io_handle,
+			          filename_size,
+			          error );
+		}
+		else
+#endif
+		{
+			result = libbfio_file_get_name_size_wide(
+			          file_io_handle,
+			          filename_size,
+			          error );
+		}
 
 		if( result != 1 )
 		{
@@ -8079,11 +12685,35 @@ int libewf_handle_get_filename_wide(
 	}
 	else if( result != 0 )
 	{
-		result = libbfio_file_get_name_wide(
-		          file_io_handle,
-		          filename,
-		          filename_size,
-		          error );
+#if defined( HAVE_LIBEWF_MEMORY_MAPPED_FILE_IO_HANDLE )
+		if( internal_handle->file_io_pool_io_engine == LIBEWF_IO_ENGINE_MEMORY_MAPPED )
+		{
+			result = libewf_memory_mapped_file_get_name_wide(
+			          file_io_handle,
+			          filename,
+			          filename_size,
+			          error );
+		}
+		else
+#endif
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_HANDLE )
+		if( internal_handle->file_io_pool_io_engine == LIBEWF_IO_ENGINE_DIRECT )
+		{
+			result = libewf_direct_file_get_name_wide(
+			          file_io_handle,
+			          filename,
+			          filename_size,
+			          error );
+		}
+		else
+#endif
+		{
+			result = libbfio_file_get_name_wide(
+			          file_io_handle,
+			          filename,
+			          filename_size,
+			          error );
+		}
 
 		if( result != 1 )
 		{
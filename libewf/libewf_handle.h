@@ -25,9 +25,12 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_buffer_pool.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
+#include "libewf_chunk_index.h"
 #include "libewf_chunk_table.h"
+#include "libewf_coalesced_read_buffer.h"
 #include "libewf_data_chunk.h"
 #include "libewf_extern.h"
 #include "libewf_hash_sections.h"
@@ -40,11 +43,14 @@
 #include "libewf_libfvalue.h"
 #include "libewf_io_handle.h"
 #include "libewf_media_values.h"
+#include "libewf_read_ahead.h"
 #include "libewf_read_io_handle.h"
 #include "libewf_segment_table.h"
+#include "libewf_sharded_chunk_cache.h"
 #include "libewf_single_files.h"
 #include "libewf_types.h"
 #include "libewf_write_io_handle.h"
+#include "libewf_write_pipeline.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -82,6 +88,10 @@ struct libewf_internal_handle
 	 */
 	uint8_t file_io_pool_created_in_library;
 
+	/* The IO engine of the file IO handles in the pool that was created inside the library
+	 */
+	int file_io_pool_io_engine;
+
 	/* The read IO handle
 	 */
 	libewf_read_io_handle_t *read_io_handle;
@@ -118,10 +128,76 @@ struct libewf_internal_handle
 	 */
 	libfcache_cache_t *chunks_cache;
 
+	/* The chunks read-ahead
+	 */
+	libewf_read_ahead_t *read_ahead;
+
+	/* The number of chunks to read ahead
+	 */
+	int read_ahead_number_of_chunks;
+
+	/* The chunk cache
+	 */
+	libewf_sharded_chunk_cache_t *chunk_cache;
+
+	/* The chunk cache size
+	 */
+	size64_t chunk_cache_size;
+
+	/* The chunk groups cache size
+	 */
+	size64_t chunk_groups_cache_size;
+
+	/* The maximum size of a coalesced read
+	 */
+	size64_t coalesced_read_size;
+
+	/* The coalesced read buffer
+	 */
+	libewf_coalesced_read_buffer_t *coalesced_read_buffer;
+
+	/* The IO engine used to read the segment files
+	 */
+	int io_engine;
+
+	/* The chunk index filename
+	 */
+	char *chunk_index_filename;
+
+	/* The chunk index filename size
+	 */
+	size_t chunk_index_filename_size;
+
+	/* The chunk index
+	 */
+	libewf_chunk_index_t *chunk_index;
+
+	/* Value to indicate if the table sections of the segment files
+	 * other than the first and last should be read on demand
+	 */
+	uint8_t lazy_open;
+
+	/* The number of segment files of which the storage media range is mapped
+	 * the remaining segment files are read on demand
+	 */
+	uint32_t number_of_mapped_segments;
+
 	/* The current chunk data
 	 */
 	libewf_chunk_data_t *chunk_data;
 
+	/* The buffer pool of the chunk data
+	 */
+	libewf_buffer_pool_t *buffer_pool;
+
+	/* The number of threads used to pack the chunks that are written
+	 */
+	int write_number_of_threads;
+
+	/* The size of a write of the write-behind buffer
+	 */
+	size64_t write_behind_size;
+
 	/* The date format for certain header values
 	 */
 	int date_format;
@@ -154,6 +230,15 @@ struct libewf_internal_handle
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The mutex that serializes access to the chunk table, chunks cache,
+	 * read-ahead and coalesced read buffer when reading chunks
+	 */
+	libcthreads_mutex_t *read_chunk_mutex;
+
+	/* The write pipeline
+	 */
+	libewf_write_pipeline_t *write_pipeline;
 #endif
 };
 
@@ -178,6 +263,42 @@ int libewf_handle_signal_abort(
      libewf_handle_t *handle,
      libcerror_error_t **error );
 
+int libewf_internal_handle_get_open_values(
+     libewf_internal_handle_t *internal_handle,
+     int access_flags,
+     int *maximum_number_of_open_handles,
+     int *io_engine,
+     int *access_behavior,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_initialize_file_io_handle(
+     libbfio_handle_t **file_io_handle,
+     const char *filename,
+     size_t filename_length,
+     int io_engine,
+     int access_behavior,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libewf_internal_handle_initialize_file_io_handle_wide(
+     libbfio_handle_t **file_io_handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     int io_engine,
+     int access_behavior,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libewf_internal_handle_open_created_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libewf_segment_table_t *segment_table,
+     int io_engine,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_open(
      libewf_handle_t *handle,
@@ -205,10 +326,48 @@ int libewf_internal_handle_open_read_segment_file_section_data(
      int file_io_pool_entry,
      libcerror_error_t **error );
 
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_internal_handle_open_read_segment_files_in_parallel(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint32_t first_segment_number,
+     uint32_t number_of_segments,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
 int libewf_internal_handle_open_read_segment_files(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
+     uint8_t lazy_open,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_deferred_segment_files(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t storage_media_offset,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_open_read_chunk_index(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int io_engine,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_write_chunk_index(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_chunk_groups_cache_number_of_entries(
+     libewf_internal_handle_t *internal_handle,
+     int *number_of_entries,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_initialize_chunk_cache(
+     libewf_internal_handle_t *internal_handle,
      libcerror_error_t **error );
 
 int libewf_internal_handle_open_file_io_pool(
@@ -230,6 +389,28 @@ int libewf_handle_close(
      libewf_handle_t *handle,
      libcerror_error_t **error );
 
+int libewf_internal_handle_append_chunk_checksum_error(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_chunk_buffer_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint64_t chunk_index,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -252,6 +433,16 @@ ssize_t libewf_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+ssize_t libewf_internal_handle_write_packed_chunks_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint8_t flush,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
 ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -333,12 +524,112 @@ int libewf_handle_get_offset(
      off64_t *offset,
      libcerror_error_t **error );
 
+int libewf_internal_handle_get_chunk_descriptor(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     uint32_t *segment_number,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_flags,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_descriptor(
+     libewf_handle_t *handle,
+     uint64_t chunk_index,
+     uint32_t *segment_number,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_flags,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_get_chunk_descriptors(
+         libewf_handle_t *handle,
+         uint64_t first_chunk_index,
+         uint32_t *segment_numbers,
+         off64_t *chunk_data_offsets,
+         size64_t *chunk_data_sizes,
+         uint32_t *chunk_flags,
+         size_t number_of_descriptors,
+         libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_set_maximum_number_of_open_handles(
      libewf_handle_t *handle,
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_set_read_ahead_number_of_chunks(
+     libewf_handle_t *handle,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_chunk_cache_size(
+     libewf_handle_t *handle,
+     size64_t chunk_cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_chunk_groups_cache_size(
+     libewf_handle_t *handle,
+     size64_t chunk_groups_cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_coalesced_read_size(
+     libewf_handle_t *handle,
+     size64_t coalesced_read_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_io_engine(
+     libewf_handle_t *handle,
+     int io_engine,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_chunk_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_lazy_open(
+     libewf_handle_t *handle,
+     uint8_t lazy_open,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_buffer_pool_values(
+     libewf_handle_t *handle,
+     size64_t maximum_size,
+     uint8_t flags,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_buffer_pool_arena(
+     libewf_handle_t *handle,
+     uint8_t *arena,
+     size_t arena_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_write_number_of_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_write_behind_size(
+     libewf_handle_t *handle,
+     size64_t write_behind_size,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_segment_files_corrupted(
      libewf_handle_t *handle,
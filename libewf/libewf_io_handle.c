@@ -266,7 +266,10 @@ int libewf_io_handle_clone(
 
 		goto on_error;
 	}
-	( *destination_io_handle )->zero_on_error = source_io_handle->zero_on_error;
+	( *destination_io_handle )->zero_on_error         = source_io_handle->zero_on_error;
+	( *destination_io_handle )->chunk_index           = NULL;
+	( *destination_io_handle )->buffer_pool           = NULL;
+	( *destination_io_handle )->coalesced_read_buffer = NULL;
 
 	return( 1 );
 
@@ -25,6 +25,9 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_buffer_pool.h"
+#include "libewf_coalesced_read_buffer.h"
+#include "libewf_chunk_index.h"
 #include "libewf_libcerror.h"
 
 #if defined( __cplusplus )
@@ -67,6 +70,10 @@ struct libewf_io_handle
 	 */
 	uint8_t compression_flags;
 
+	/* The deflate codec
+	 */
+	uint8_t deflate_codec;
+
 	/* Value to indicate the data and some metadata is encrypted
 	 */
 	uint8_t is_encrypted;
@@ -86,6 +93,21 @@ struct libewf_io_handle
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
+
+	/* The chunk index
+	 * The chunk index is not managed by the IO handle
+	 */
+	libewf_chunk_index_t *chunk_index;
+
+	/* The buffer pool
+	 * The buffer pool is not managed by the IO handle
+	 */
+	libewf_buffer_pool_t *buffer_pool;
+
+	/* The coalesced read buffer, NULL if reads are not coalesced
+	 * The coalesced read buffer is not managed by the IO handle
+	 */
+	libewf_coalesced_read_buffer_t *coalesced_read_buffer;
 };
 
 int libewf_io_handle_initialize(
@@ -0,0 +1,914 @@
+/*
+ * io_uring asynchronous IO functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_io_uring.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+
+#if defined( HAVE_LIBEWF_IO_URING )
+
+/* The io_uring reads the chunk data using file descriptors of its own
+ * since libbfio does not expose the descriptors of its file IO handles.
+ * The descriptors are opened read-only on first use and are independent
+ * of the file IO pool, so that the maximum number of open handles
+ * of the pool does not affect the queued reads.
+ */
+
+/* Creates an io_uring
+ * Make sure the value io_uring is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_uring_initialize(
+     libewf_io_uring_t **io_uring,
+     int queue_depth,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_io_uring_initialize";
+	size_t reads_size     = 0;
+	int result            = 0;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_uring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid io_uring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( queue_depth <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid queue depth value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*io_uring = memory_allocate_structure(
+	             libewf_io_uring_t );
+
+	if( *io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create io_uring.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *io_uring,
+	     0,
+	     sizeof( libewf_io_uring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear io_uring.",
+		 function );
+
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+
+		return( -1 );
+	}
+	reads_size = sizeof( libewf_io_uring_read_t ) * queue_depth;
+
+	( *io_uring )->reads = (libewf_io_uring_read_t *) memory_allocate(
+	                                                   reads_size );
+
+	if( ( *io_uring )->reads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reads.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *io_uring )->reads,
+	     0,
+	     reads_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reads.",
+		 function );
+
+		goto on_error;
+	}
+	/* The kernel can refuse to set up the ring, e.g. if io_uring
+	 * is not supported or disabled, in which case the caller
+	 * should fall back to the regular read path
+	 */
+	result = io_uring_queue_init(
+	          (unsigned int) queue_depth,
+	          &( ( *io_uring )->ring ),
+	          0 );
+
+	if( result < 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 -result,
+		 "%s: unable to initialize ring.",
+		 function );
+
+		goto on_error;
+	}
+	( *io_uring )->queue_depth = queue_depth;
+
+	return( 1 );
+
+on_error:
+	if( *io_uring != NULL )
+	{
+		if( ( *io_uring )->reads != NULL )
+		{
+			memory_free(
+			 ( *io_uring )->reads );
+		}
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an io_uring
+ * The submitted reads must have completed before the io_uring is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_uring_free(
+     libewf_io_uring_t **io_uring,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_io_uring_free";
+	int descriptor_index  = 0;
+	int result            = 1;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_uring != NULL )
+	{
+		io_uring_queue_exit(
+		 &( ( *io_uring )->ring ) );
+
+		if( ( *io_uring )->descriptors != NULL )
+		{
+			for( descriptor_index = 0;
+			     descriptor_index < ( *io_uring )->number_of_descriptors;
+			     descriptor_index++ )
+			{
+				if( ( *io_uring )->descriptors[ descriptor_index ] < 0 )
+				{
+					continue;
+				}
+				if( close(
+				     ( *io_uring )->descriptors[ descriptor_index ] ) != 0 )
+				{
+					libcerror_system_set_error(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+					 errno,
+					 "%s: unable to close descriptor: %d.",
+					 function,
+					 descriptor_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *io_uring )->descriptors );
+		}
+		memory_free(
+		 ( *io_uring )->reads );
+
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the file descriptor of a specific file IO pool entry
+ * The file is opened on first use using the name of the file IO handle,
+ * if the file IO handle is not a libbfio file handle no descriptor is available
+ * Returns 1 if successful, 0 if no descriptor is available or -1 on error
+ */
+int libewf_io_uring_get_descriptor(
+     libewf_io_uring_t *io_uring,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     int *descriptor,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	char *name                       = NULL;
+	void *reallocation               = NULL;
+	static char *function            = "libewf_io_uring_get_descriptor";
+	size_t name_size                 = 0;
+	int descriptor_index             = 0;
+	int number_of_descriptors        = 0;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry < 0 )
+	 || ( file_io_pool_entry == INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry >= io_uring->number_of_descriptors )
+	{
+		number_of_descriptors = file_io_pool_entry + 1;
+
+		reallocation = memory_reallocate(
+		                io_uring->descriptors,
+		                sizeof( int ) * number_of_descriptors );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize descriptors.",
+			 function );
+
+			return( -1 );
+		}
+		io_uring->descriptors = (int *) reallocation;
+
+		for( descriptor_index = io_uring->number_of_descriptors;
+		     descriptor_index < number_of_descriptors;
+		     descriptor_index++ )
+		{
+			io_uring->descriptors[ descriptor_index ] = -1;
+		}
+		io_uring->number_of_descriptors = number_of_descriptors;
+	}
+	if( io_uring->descriptors[ file_io_pool_entry ] == -1 )
+	{
+		/* Mark the descriptor as unavailable so that a file
+		 * that cannot be opened is not retried on every read
+		 */
+		io_uring->descriptors[ file_io_pool_entry ] = -2;
+
+		if( libbfio_pool_get_handle(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d from pool.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		if( libbfio_file_get_name_size(
+		     file_io_handle,
+		     &name_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve name size of file IO handle: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		if( ( name_size == 0 )
+		 || ( name_size > (size_t) SSIZE_MAX ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid name size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		name = narrow_string_allocate(
+		        name_size );
+
+		if( name == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create name.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_file_get_name(
+		     file_io_handle,
+		     name,
+		     name_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve name of file IO handle: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		io_uring->descriptors[ file_io_pool_entry ] = open(
+		                                               name,
+		                                               O_RDONLY );
+
+		if( io_uring->descriptors[ file_io_pool_entry ] == -1 )
+		{
+			io_uring->descriptors[ file_io_pool_entry ] = -2;
+		}
+		memory_free(
+		 name );
+
+		name = NULL;
+	}
+	if( io_uring->descriptors[ file_io_pool_entry ] < 0 )
+	{
+		return( 0 );
+	}
+	*descriptor = io_uring->descriptors[ file_io_pool_entry ];
+
+	return( 1 );
+
+on_error:
+	if( name != NULL )
+	{
+		memory_free(
+		 name );
+	}
+	/* The descriptor is marked as unavailable, the chunk data
+	 * is read using the file IO pool instead
+	 */
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( ( error != NULL )
+		 && ( *error != NULL ) )
+		{
+			libcnotify_print_error_backtrace(
+			 *error );
+		}
+	}
+#endif
+	libcerror_error_free(
+	 error );
+
+	return( 0 );
+}
+
+/* Appends a read to the submission queue
+ * The buffer must remain valid until the read has completed
+ * Returns 1 if successful, 0 if the queue is full or -1 on error
+ */
+int libewf_io_uring_append_read(
+     libewf_io_uring_t *io_uring,
+     int descriptor,
+     uint8_t *buffer,
+     size_t size,
+     off64_t offset,
+     int *read_index,
+     libcerror_error_t **error )
+{
+	struct io_uring_sqe *submission_queue_entry = NULL;
+	static char *function                       = "libewf_io_uring_append_read";
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( descriptor < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid descriptor value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size_t) UINT32_MAX )
+	 || ( size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read index.",
+		 function );
+
+		return( -1 );
+	}
+	/* Reads cannot be appended to a batch that was already submitted
+	 */
+	if( ( io_uring->number_of_reads >= io_uring->queue_depth )
+	 || ( io_uring->number_of_submitted_reads != 0 ) )
+	{
+		return( 0 );
+	}
+	submission_queue_entry = io_uring_get_sqe(
+	                          &( io_uring->ring ) );
+
+	if( submission_queue_entry == NULL )
+	{
+		return( 0 );
+	}
+	io_uring_prep_read(
+	 submission_queue_entry,
+	 descriptor,
+	 buffer,
+	 (unsigned int) size,
+	 (uint64_t) offset );
+
+	io_uring_sqe_set_data(
+	 submission_queue_entry,
+	 (void *) (intptr_t) io_uring->number_of_reads );
+
+	io_uring->reads[ io_uring->number_of_reads ].buffer       = buffer;
+	io_uring->reads[ io_uring->number_of_reads ].size         = size;
+	io_uring->reads[ io_uring->number_of_reads ].offset       = offset;
+	io_uring->reads[ io_uring->number_of_reads ].descriptor   = descriptor;
+	io_uring->reads[ io_uring->number_of_reads ].read_count   = -1;
+	io_uring->reads[ io_uring->number_of_reads ].is_completed = 0;
+
+	*read_index = io_uring->number_of_reads;
+
+	io_uring->number_of_reads += 1;
+
+	return( 1 );
+}
+
+/* Submits the queued reads without waiting for them to complete
+ * The reads are submitted with a single system call, if possible, so that
+ * the reads of the batch are outstanding at the same time
+ * If the submission fails the ring is no longer usable, the reads that were
+ * submitted must be waited for before the ring is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_uring_submit_reads(
+     libewf_io_uring_t *io_uring,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_io_uring_submit_reads";
+	int result            = 0;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	while( io_uring->number_of_submitted_reads < io_uring->number_of_reads )
+	{
+		result = io_uring_submit(
+		          &( io_uring->ring ) );
+
+		if( result == -EINTR )
+		{
+			continue;
+		}
+		if( result <= 0 )
+		{
+			if( result == 0 )
+			{
+				result = -EIO;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 -result,
+			 "%s: unable to submit reads.",
+			 function );
+
+			return( -1 );
+		}
+		io_uring->number_of_submitted_reads += result;
+	}
+	return( 1 );
+}
+
+/* Waits for the completion of a submitted read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_uring_get_completion(
+     libewf_io_uring_t *io_uring,
+     libcerror_error_t **error )
+{
+	struct io_uring_cqe *completion_queue_entry = NULL;
+	static char *function                       = "libewf_io_uring_get_completion";
+	int read_index                              = 0;
+	int result                                  = 0;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_uring->number_of_completed_reads >= io_uring->number_of_submitted_reads )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid io_uring - no reads in progress.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		result = io_uring_wait_cqe(
+		          &( io_uring->ring ),
+		          &completion_queue_entry );
+	}
+	while( result == -EINTR );
+
+	if( result < 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 -result,
+		 "%s: unable to wait for read completion.",
+		 function );
+
+		return( -1 );
+	}
+	read_index = (int) (intptr_t) io_uring_cqe_get_data(
+	                               completion_queue_entry );
+
+	if( ( read_index >= 0 )
+	 && ( read_index < io_uring->number_of_reads ) )
+	{
+		io_uring->reads[ read_index ].read_count   = (ssize_t) completion_queue_entry->res;
+		io_uring->reads[ read_index ].is_completed = 1;
+	}
+	io_uring_cqe_seen(
+	 &( io_uring->ring ),
+	 completion_queue_entry );
+
+	io_uring->number_of_completed_reads += 1;
+
+	return( 1 );
+}
+
+/* Waits until a specific submitted read has completed
+ * The completions of other reads that are retrieved in the meantime are stored as well
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_uring_wait_for_read(
+     libewf_io_uring_t *io_uring,
+     int read_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_io_uring_wait_for_read";
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_index < 0 )
+	 || ( read_index >= io_uring->number_of_reads ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( io_uring->reads[ read_index ].is_completed == 0 )
+	{
+		if( libewf_io_uring_get_completion(
+		     io_uring,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve completion of read: %d.",
+			 function,
+			 read_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Waits until all the submitted reads have completed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_uring_wait_for_reads(
+     libewf_io_uring_t *io_uring,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_io_uring_wait_for_reads";
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	while( io_uring->number_of_completed_reads < io_uring->number_of_submitted_reads )
+	{
+		if( libewf_io_uring_get_completion(
+		     io_uring,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve completion.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the read count of a specific read
+ * The read count is negative if the read failed or has not completed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_uring_get_read_count(
+     libewf_io_uring_t *io_uring,
+     int read_index,
+     ssize_t *read_count,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_io_uring_get_read_count";
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_index < 0 )
+	 || ( read_index >= io_uring->number_of_reads ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_count == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read count.",
+		 function );
+
+		return( -1 );
+	}
+	*read_count = io_uring->reads[ read_index ].read_count;
+
+	return( 1 );
+}
+
+/* Clears the queued reads
+ * The submitted reads must have completed before the reads are cleared
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_uring_clear_reads(
+     libewf_io_uring_t *io_uring,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_io_uring_clear_reads";
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_uring->number_of_completed_reads < io_uring->number_of_submitted_reads )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid io_uring - reads still in progress.",
+		 function );
+
+		return( -1 );
+	}
+	io_uring->number_of_reads           = 0;
+	io_uring->number_of_submitted_reads = 0;
+	io_uring->number_of_completed_reads = 0;
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_IO_URING ) */
+
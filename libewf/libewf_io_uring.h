@@ -0,0 +1,171 @@
+/*
+ * io_uring asynchronous IO functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_IO_URING_H )
+#define _LIBEWF_IO_URING_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( HAVE_LIBURING ) && !defined( WINAPI )
+#define HAVE_LIBEWF_IO_URING	1
+#endif
+
+#if defined( HAVE_LIBEWF_IO_URING )
+#include <liburing.h>
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_IO_URING )
+
+typedef struct libewf_io_uring_read libewf_io_uring_read_t;
+
+struct libewf_io_uring_read
+{
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The file descriptor
+	 */
+	int descriptor;
+
+	/* The read count, negative if the read failed
+	 */
+	ssize_t read_count;
+
+	/* Value to indicate the read has completed
+	 */
+	uint8_t is_completed;
+};
+
+typedef struct libewf_io_uring libewf_io_uring_t;
+
+struct libewf_io_uring
+{
+	/* The ring
+	 */
+	struct io_uring ring;
+
+	/* The queue depth
+	 */
+	int queue_depth;
+
+	/* The queued reads
+	 */
+	libewf_io_uring_read_t *reads;
+
+	/* The number of queued reads
+	 */
+	int number_of_reads;
+
+	/* The number of queued reads that were submitted
+	 */
+	int number_of_submitted_reads;
+
+	/* The number of submitted reads that have completed
+	 */
+	int number_of_completed_reads;
+
+	/* The file descriptors, one per file IO pool entry
+	 * -1 if not yet opened or -2 if the file cannot be opened
+	 */
+	int *descriptors;
+
+	/* The number of file descriptors
+	 */
+	int number_of_descriptors;
+};
+
+int libewf_io_uring_initialize(
+     libewf_io_uring_t **io_uring,
+     int queue_depth,
+     libcerror_error_t **error );
+
+int libewf_io_uring_free(
+     libewf_io_uring_t **io_uring,
+     libcerror_error_t **error );
+
+int libewf_io_uring_get_descriptor(
+     libewf_io_uring_t *io_uring,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     int *descriptor,
+     libcerror_error_t **error );
+
+int libewf_io_uring_append_read(
+     libewf_io_uring_t *io_uring,
+     int descriptor,
+     uint8_t *buffer,
+     size_t size,
+     off64_t offset,
+     int *read_index,
+     libcerror_error_t **error );
+
+int libewf_io_uring_submit_reads(
+     libewf_io_uring_t *io_uring,
+     libcerror_error_t **error );
+
+int libewf_io_uring_get_completion(
+     libewf_io_uring_t *io_uring,
+     libcerror_error_t **error );
+
+int libewf_io_uring_wait_for_read(
+     libewf_io_uring_t *io_uring,
+     int read_index,
+     libcerror_error_t **error );
+
+int libewf_io_uring_wait_for_reads(
+     libewf_io_uring_t *io_uring,
+     libcerror_error_t **error );
+
+int libewf_io_uring_get_read_count(
+     libewf_io_uring_t *io_uring,
+     int read_index,
+     ssize_t *read_count,
+     libcerror_error_t **error );
+
+int libewf_io_uring_clear_reads(
+     libewf_io_uring_t *io_uring,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_IO_URING ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_IO_URING_H ) */
+
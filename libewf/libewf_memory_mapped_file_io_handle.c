@@ -0,0 +1,1565 @@
+/*
+ * Memory mapped file IO handle functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libclocale.h"
+#include "libewf_libuna.h"
+#include "libewf_memory_mapped_file_io_handle.h"
+#include "libewf_unused.h"
+
+#if defined( HAVE_LIBEWF_MEMORY_MAPPED_FILE_IO_HANDLE )
+
+/* Creates a memory mapped file IO handle
+ * Make sure the value file_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_memory_mapped_file_io_handle_initialize(
+     libewf_memory_mapped_file_io_handle_t **file_io_handle,
+     const char *name,
+     size_t name_length,
+     int access_behavior,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_memory_mapped_file_io_handle_initialize";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_length == 0 )
+	 || ( name_length > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_behavior != LIBEWF_MEMORY_MAPPED_FILE_ACCESS_BEHAVIOR_NORMAL )
+	 && ( access_behavior != LIBEWF_MEMORY_MAPPED_FILE_ACCESS_BEHAVIOR_SEQUENTIAL )
+	 && ( access_behavior != LIBEWF_MEMORY_MAPPED_FILE_ACCESS_BEHAVIOR_RANDOM ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access behavior.",
+		 function );
+
+		return( -1 );
+	}
+	*file_io_handle = memory_allocate_structure(
+	                   libewf_memory_mapped_file_io_handle_t );
+
+	if( *file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_io_handle,
+	     0,
+	     sizeof( libewf_memory_mapped_file_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file IO handle.",
+		 function );
+
+		memory_free(
+		 *file_io_handle );
+
+		*file_io_handle = NULL;
+
+		return( -1 );
+	}
+	( *file_io_handle )->name = narrow_string_allocate(
+	                             name_length + 1 );
+
+	if( ( *file_io_handle )->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		goto on_error;
+	}
+	if( narrow_string_copy(
+	     ( *file_io_handle )->name,
+	     name,
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		goto on_error;
+	}
+	( *file_io_handle )->name[ name_length ] = 0;
+
+	( *file_io_handle )->name_size       = name_length + 1;
+	( *file_io_handle )->descriptor      = -1;
+	( *file_io_handle )->access_behavior = access_behavior;
+
+	return( 1 );
+
+on_error:
+	if( *file_io_handle != NULL )
+	{
+		if( ( *file_io_handle )->name != NULL )
+		{
+			memory_free(
+			 ( *file_io_handle )->name );
+		}
+		memory_free(
+		 *file_io_handle );
+
+		*file_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates a file IO handle that reads the file using a memory mapping
+ * Make sure the value handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_memory_mapped_file_initialize(
+     libbfio_handle_t **handle,
+     const char *name,
+     size_t name_length,
+     int access_behavior,
+     libcerror_error_t **error )
+{
+	libewf_memory_mapped_file_io_handle_t *file_io_handle = NULL;
+	static char *function                                 = "libewf_memory_mapped_file_initialize";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_memory_mapped_file_io_handle_initialize(
+	     &file_io_handle,
+	     name,
+	     name_length,
+	     access_behavior,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     handle,
+	     (intptr_t *) file_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libewf_memory_mapped_file_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libewf_memory_mapped_file_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libewf_memory_mapped_file_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_memory_mapped_file_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libewf_memory_mapped_file_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libewf_memory_mapped_file_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libewf_memory_mapped_file_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_memory_mapped_file_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_memory_mapped_file_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libewf_memory_mapped_file_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libewf_memory_mapped_file_io_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Creates a memory mapped file handle
+ * The name is converted to the narrow system string used to open the file
+ * Make sure the value handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_memory_mapped_file_initialize_wide(
+     libbfio_handle_t **handle,
+     const wchar_t *name,
+     size_t name_length,
+     int access_behavior,
+     libcerror_error_t **error )
+{
+	char *narrow_name       = NULL;
+	static char *function   = "libewf_memory_mapped_file_initialize_wide";
+	size_t narrow_name_size = 0;
+	int result              = 0;
+
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf8_string_size_from_utf32(
+		          (libuna_utf32_character_t *) name,
+		          name_length + 1,
+		          &narrow_name_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf8_string_size_from_utf16(
+		          (libuna_utf16_character_t *) name,
+		          name_length + 1,
+		          &narrow_name_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_byte_stream_size_from_utf32(
+		          (libuna_utf32_character_t *) name,
+		          name_length + 1,
+		          libclocale_codepage,
+		          &narrow_name_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_byte_stream_size_from_utf16(
+		          (libuna_utf16_character_t *) name,
+		          name_length + 1,
+		          libclocale_codepage,
+		          &narrow_name_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine narrow name size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( narrow_name_size == 0 )
+	 || ( narrow_name_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid narrow name size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	narrow_name = narrow_string_allocate(
+	               narrow_name_size );
+
+	if( narrow_name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create narrow name.",
+		 function );
+
+		goto on_error;
+	}
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf8_string_copy_from_utf32(
+		          (libuna_utf8_character_t *) narrow_name,
+		          narrow_name_size,
+		          (libuna_utf32_character_t *) name,
+		          name_length + 1,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf8_string_copy_from_utf16(
+		          (libuna_utf8_character_t *) narrow_name,
+		          narrow_name_size,
+		          (libuna_utf16_character_t *) name,
+		          name_length + 1,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_byte_stream_copy_from_utf32(
+		          (uint8_t *) narrow_name,
+		          narrow_name_size,
+		          libclocale_codepage,
+		          (libuna_utf32_character_t *) name,
+		          name_length + 1,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_byte_stream_copy_from_utf16(
+		          (uint8_t *) narrow_name,
+		          narrow_name_size,
+		          libclocale_codepage,
+		          (libuna_utf16_character_t *) name,
+		          name_length + 1,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set narrow name.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_memory_mapped_file_initialize(
+	     handle,
+	     narrow_name,
+	     narrow_name_size - 1,
+	     access_behavior,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 narrow_name );
+
+	return( 1 );
+
+on_error:
+	if( narrow_name != NULL )
+	{
+		memory_free(
+		 narrow_name );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Frees a memory mapped file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_memory_mapped_file_io_handle_free(
+     libewf_memory_mapped_file_io_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_memory_mapped_file_io_handle_free";
+	int result            = 1;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle != NULL )
+	{
+		if( ( *file_io_handle )->descriptor != -1 )
+		{
+			if( libewf_memory_mapped_file_io_handle_close(
+			     *file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *file_io_handle )->name != NULL )
+		{
+			memory_free(
+			 ( *file_io_handle )->name );
+		}
+		memory_free(
+		 *file_io_handle );
+
+		*file_io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the memory mapped file IO handle and its attributes
+ * The destination file IO handle is not opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_memory_mapped_file_io_handle_clone(
+     libewf_memory_mapped_file_io_handle_t **destination_file_io_handle,
+     libewf_memory_mapped_file_io_handle_t *source_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_memory_mapped_file_io_handle_clone";
+
+	if( destination_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_file_io_handle == NULL )
+	{
+		*destination_file_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libewf_memory_mapped_file_io_handle_initialize(
+	     destination_file_io_handle,
+	     source_file_io_handle->name,
+	     source_file_io_handle->name_size - 1,
+	     source_file_io_handle->access_behavior,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the memory mapped file IO handle
+ * Files that cannot be mapped, such as devices and empty files,
+ * are read using positional reads on the file descriptor
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_memory_mapped_file_io_handle_open(
+     libewf_memory_mapped_file_io_handle_t *file_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "libewf_memory_mapped_file_io_handle_open";
+	void *mapped_data     = NULL;
+	off_t end_offset      = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle - descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & LIBBFIO_ACCESS_FLAG_READ ) == 0 )
+	 || ( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle->descriptor = open(
+	                              file_io_handle->name,
+	                              O_RDONLY );
+
+	if( file_io_handle->descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 file_io_handle->name );
+
+		return( -1 );
+	}
+	if( fstat(
+	     file_io_handle->descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( S_ISREG( file_statistics.st_mode ) )
+	{
+		file_io_handle->size = (size64_t) file_statistics.st_size;
+	}
+	else
+	{
+		end_offset = lseek(
+		              file_io_handle->descriptor,
+		              0,
+		              SEEK_END );
+
+		if( end_offset == -1 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 errno,
+			 "%s: unable to determine size.",
+			 function );
+
+			goto on_error;
+		}
+		file_io_handle->size = (size64_t) end_offset;
+	}
+	/* The mapping is not used for devices, since their size is not fixed
+	 * and for empty files, since these cannot be mapped
+	 */
+	if( S_ISREG( file_statistics.st_mode )
+	 && ( file_io_handle->size > 0 )
+	 && ( file_io_handle->size <= (size64_t) SSIZE_MAX ) )
+	{
+		mapped_data = mmap(
+		               NULL,
+		               (size_t) file_io_handle->size,
+		               PROT_READ,
+		               MAP_SHARED,
+		               file_io_handle->descriptor,
+		               0 );
+
+		/* If the file cannot be mapped it is read using the descriptor
+		 */
+		if( mapped_data != MAP_FAILED )
+		{
+			file_io_handle->data = (uint8_t *) mapped_data;
+		}
+	}
+#if defined( HAVE_MADVISE )
+	if( file_io_handle->data != NULL )
+	{
+		/* The access behavior is an optimization hint, failure is not an error
+		 */
+		if( file_io_handle->access_behavior == LIBEWF_MEMORY_MAPPED_FILE_ACCESS_BEHAVIOR_SEQUENTIAL )
+		{
+			madvise(
+			 (void *) file_io_handle->data,
+			 (size_t) file_io_handle->size,
+			 MADV_SEQUENTIAL );
+		}
+		else if( file_io_handle->access_behavior == LIBEWF_MEMORY_MAPPED_FILE_ACCESS_BEHAVIOR_RANDOM )
+		{
+			madvise(
+			 (void *) file_io_handle->data,
+			 (size_t) file_io_handle->size,
+			 MADV_RANDOM );
+		}
+	}
+#endif
+	file_io_handle->current_offset = 0;
+	file_io_handle->access_flags   = access_flags;
+
+	return( 1 );
+
+on_error:
+	close(
+	 file_io_handle->descriptor );
+
+	file_io_handle->descriptor = -1;
+	file_io_handle->size       = 0;
+
+	return( -1 );
+}
+
+/* Closes the memory mapped file IO handle
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_memory_mapped_file_io_handle_close(
+     libewf_memory_mapped_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_memory_mapped_file_io_handle_close";
+	int result            = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->data != NULL )
+	{
+		if( munmap(
+		     (void *) file_io_handle->data,
+		     (size_t) file_io_handle->size ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to unmap file.",
+			 function );
+
+			result = -1;
+		}
+		file_io_handle->data = NULL;
+	}
+	if( close(
+	     file_io_handle->descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file.",
+		 function );
+
+		result = -1;
+	}
+	file_io_handle->descriptor     = -1;
+	file_io_handle->size           = 0;
+	file_io_handle->current_offset = 0;
+	file_io_handle->access_flags   = 0;
+
+	return( result );
+}
+
+/* Reads a buffer from the memory mapped file IO handle
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libewf_memory_mapped_file_io_handle_read(
+         libewf_memory_mapped_file_io_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_memory_mapped_file_io_handle_read";
+	ssize_t read_count    = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->data != NULL )
+	{
+		if( (size64_t) file_io_handle->current_offset >= file_io_handle->size )
+		{
+			return( 0 );
+		}
+		if( (size64_t) size > ( file_io_handle->size - file_io_handle->current_offset ) )
+		{
+			size = (size_t) ( file_io_handle->size - file_io_handle->current_offset );
+		}
+		if( memory_copy(
+		     buffer,
+		     &( file_io_handle->data[ file_io_handle->current_offset ] ),
+		     size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data.",
+			 function );
+
+			return( -1 );
+		}
+		read_count = (ssize_t) size;
+	}
+	else
+	{
+#if defined( HAVE_PREAD )
+		read_count = pread(
+		              file_io_handle->descriptor,
+		              (void *) buffer,
+		              size,
+		              (off_t) file_io_handle->current_offset );
+#else
+		if( lseek(
+		     file_io_handle->descriptor,
+		     (off_t) file_io_handle->current_offset,
+		     SEEK_SET ) == -1 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 errno,
+			 "%s: unable to seek offset: %" PRIi64 ".",
+			 function,
+			 file_io_handle->current_offset );
+
+			return( -1 );
+		}
+		read_count = read(
+		              file_io_handle->descriptor,
+		              (void *) buffer,
+		              size );
+#endif
+		if( read_count < 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read from file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	file_io_handle->current_offset += (off64_t) read_count;
+
+	return( read_count );
+}
+
+/* Writes a buffer to the memory mapped file IO handle
+ * Writing is not supported since the file is only mapped for reading
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libewf_memory_mapped_file_io_handle_write(
+         libewf_memory_mapped_file_io_handle_t *file_io_handle LIBEWF_ATTRIBUTE_UNUSED,
+         const uint8_t *buffer LIBEWF_ATTRIBUTE_UNUSED,
+         size_t size LIBEWF_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_memory_mapped_file_io_handle_write";
+
+	LIBEWF_UNREFERENCED_PARAMETER( file_io_handle )
+	LIBEWF_UNREFERENCED_PARAMETER( buffer )
+	LIBEWF_UNREFERENCED_PARAMETER( size )
+
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: write access currently not supported.",
+	 function );
+
+	return( -1 );
+}
+
+/* Seeks a certain offset within the memory mapped file IO handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libewf_memory_mapped_file_io_handle_seek_offset(
+         libewf_memory_mapped_file_io_handle_t *file_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_memory_mapped_file_io_handle_seek_offset";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += file_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) file_io_handle->size;
+	}
+	else if( whence != SEEK_SET )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libewf_memory_mapped_file_io_handle_exists(
+     libewf_memory_mapped_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "libewf_memory_mapped_file_io_handle_exists";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( stat(
+	     file_io_handle->name,
+	     &file_statistics ) != 0 )
+	{
+		if( errno == ENOENT )
+		{
+			return( 0 );
+		}
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Check if the file is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libewf_memory_mapped_file_io_handle_is_open(
+     libewf_memory_mapped_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_memory_mapped_file_io_handle_is_open";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor == -1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the file size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_memory_mapped_file_io_handle_get_size(
+     libewf_memory_mapped_file_io_handle_t *file_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "libewf_memory_mapped_file_io_handle_get_size";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->descriptor != -1 )
+	{
+		*size = file_io_handle->size;
+
+		return( 1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( stat(
+	     file_io_handle->name,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		return( -1 );
+	}
+	*size = (size64_t) file_statistics.st_size;
+
+	return( 1 );
+}
+
+/* Retrieves the name size of a memory mapped file
+ * The name size includes the end of string character
+ * Returns 1 if succesful or -1 on error
+ */
+int libewf_memory_mapped_file_get_name_size(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error )
+{
+	libewf_memory_mapped_file_io_handle_t *file_io_handle = NULL;
+	static char *function                                 = "libewf_memory_mapped_file_get_name_size";
+
+	if( name_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_io_handle(
+	     handle,
+	     (intptr_t **) &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	*name_size = file_io_handle->name_size;
+
+	return( 1 );
+}
+
+/* Retrieves the name of a memory mapped file
+ * The name size should include the end of string character
+ * Returns 1 if succesful or -1 on error
+ */
+int libewf_memory_mapped_file_get_name(
+     libbfio_handle_t *handle,
+     char *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	libewf_memory_mapped_file_io_handle_t *file_io_handle = NULL;
+	static char *function                                 = "libewf_memory_mapped_file_get_name";
+
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_io_handle(
+	     handle,
+	     (intptr_t **) &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size < file_io_handle->name_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: name too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( narrow_string_copy(
+	     name,
+	     file_io_handle->name,
+	     file_io_handle->name_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Retrieves the name size of a memory mapped file
+ * The name size includes the end of string character
+ * Returns 1 if succesful or -1 on error
+ */
+int libewf_memory_mapped_file_get_name_size_wide(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error )
+{
+	libewf_memory_mapped_file_io_handle_t *file_io_handle = NULL;
+	static char *function                                 = "libewf_memory_mapped_file_get_name_size_wide";
+	int result                                            = 0;
+
+	if( name_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_io_handle(
+	     handle,
+	     (intptr_t **) &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_size_from_utf8(
+		          (libuna_utf8_character_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          name_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_size_from_utf8(
+		          (libuna_utf8_character_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          name_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_size_from_byte_stream(
+		          (uint8_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          libclocale_codepage,
+		          name_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_size_from_byte_stream(
+		          (uint8_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          libclocale_codepage,
+		          name_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine name size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the name of a memory mapped file
+ * The name size should include the end of string character
+ * Returns 1 if succesful or -1 on error
+ */
+int libewf_memory_mapped_file_get_name_wide(
+     libbfio_handle_t *handle,
+     wchar_t *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	libewf_memory_mapped_file_io_handle_t *file_io_handle = NULL;
+	static char *function                                 = "libewf_memory_mapped_file_get_name_wide";
+	int result                                            = 0;
+
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_io_handle(
+	     handle,
+	     (intptr_t **) &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_copy_from_utf8(
+		          (libuna_utf32_character_t *) name,
+		          name_size,
+		          (libuna_utf8_character_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_copy_from_utf8(
+		          (libuna_utf16_character_t *) name,
+		          name_size,
+		          (libuna_utf8_character_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_copy_from_byte_stream(
+		          (libuna_utf32_character_t *) name,
+		          name_size,
+		          (uint8_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          libclocale_codepage,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_copy_from_byte_stream(
+		          (libuna_utf16_character_t *) name,
+		          name_size,
+		          (uint8_t *) file_io_handle->name,
+		          file_io_handle->name_size,
+		          libclocale_codepage,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to copy name.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+#endif /* defined( HAVE_LIBEWF_MEMORY_MAPPED_FILE_IO_HANDLE ) */
+
@@ -0,0 +1,188 @@
+/*
+ * Memory mapped file IO handle functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_MEMORY_MAPPED_FILE_IO_HANDLE_H )
+#define _LIBEWF_MEMORY_MAPPED_FILE_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+/* Memory mapping is only used when the address space is large enough
+ * to map segment files of several GiB
+ */
+#if defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && defined( HAVE_SYS_MMAN_H ) && !defined( WINAPI ) && ( SIZEOF_SIZE_T >= 8 )
+#define HAVE_LIBEWF_MEMORY_MAPPED_FILE_IO_HANDLE	1
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MEMORY_MAPPED_FILE_IO_HANDLE )
+
+typedef struct libewf_memory_mapped_file_io_handle libewf_memory_mapped_file_io_handle_t;
+
+struct libewf_memory_mapped_file_io_handle
+{
+	/* The name
+	 */
+	char *name;
+
+	/* The name size
+	 */
+	size_t name_size;
+
+	/* The file descriptor, -1 if not open
+	 */
+	int descriptor;
+
+	/* The mapped data, NULL if the file could not be mapped
+	 */
+	uint8_t *data;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The access flags
+	 */
+	int access_flags;
+
+	/* The access behavior
+	 */
+	int access_behavior;
+};
+
+int libewf_memory_mapped_file_io_handle_initialize(
+     libewf_memory_mapped_file_io_handle_t **file_io_handle,
+     const char *name,
+     size_t name_length,
+     int access_behavior,
+     libcerror_error_t **error );
+
+int libewf_memory_mapped_file_initialize(
+     libbfio_handle_t **handle,
+     const char *name,
+     size_t name_length,
+     int access_behavior,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libewf_memory_mapped_file_initialize_wide(
+     libbfio_handle_t **handle,
+     const wchar_t *name,
+     size_t name_length,
+     int access_behavior,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libewf_memory_mapped_file_io_handle_free(
+     libewf_memory_mapped_file_io_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_memory_mapped_file_io_handle_clone(
+     libewf_memory_mapped_file_io_handle_t **destination_file_io_handle,
+     libewf_memory_mapped_file_io_handle_t *source_file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_memory_mapped_file_io_handle_open(
+     libewf_memory_mapped_file_io_handle_t *file_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libewf_memory_mapped_file_io_handle_close(
+     libewf_memory_mapped_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+ssize_t libewf_memory_mapped_file_io_handle_read(
+         libewf_memory_mapped_file_io_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libewf_memory_mapped_file_io_handle_write(
+         libewf_memory_mapped_file_io_handle_t *file_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libewf_memory_mapped_file_io_handle_seek_offset(
+         libewf_memory_mapped_file_io_handle_t *file_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libewf_memory_mapped_file_io_handle_exists(
+     libewf_memory_mapped_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_memory_mapped_file_io_handle_is_open(
+     libewf_memory_mapped_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_memory_mapped_file_io_handle_get_size(
+     libewf_memory_mapped_file_io_handle_t *file_io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+int libewf_memory_mapped_file_get_name_size(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error );
+
+int libewf_memory_mapped_file_get_name(
+     libbfio_handle_t *handle,
+     char *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libewf_memory_mapped_file_get_name_size_wide(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error );
+
+int libewf_memory_mapped_file_get_name_wide(
+     libbfio_handle_t *handle,
+     wchar_t *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+#endif /* defined( HAVE_LIBEWF_MEMORY_MAPPED_FILE_IO_HANDLE ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_MEMORY_MAPPED_FILE_IO_HANDLE_H ) */
+
@@ -107,6 +107,26 @@ int libewf_handle_set_compression_values(
      uint8_t compression_flags,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_deflate_codec(
+     libewf_handle_t *handle,
+     int *deflate_codec,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_deflate_codec(
+     libewf_handle_t *handle,
+     int deflate_codec,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_compression_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_compressed_chunks,
+     uint64_t *number_of_incompressible_chunks,
+     uint64_t *number_of_skipped_chunks,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_media_size(
      libewf_handle_t *handle,
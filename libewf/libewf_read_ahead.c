@@ -0,0 +1,2120 @@
+/*
+ * Read-ahead functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_group.h"
+#include "libewf_chunk_table.h"
+#include "libewf_coalesced_read_buffer.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_io_uring.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfcache.h"
+#include "libewf_libfdata.h"
+#include "libewf_media_values.h"
+#include "libewf_read_ahead.h"
+#include "libewf_segment_file.h"
+#include "libewf_segment_table.h"
+
+/* Creates a read-ahead
+ * Make sure the value read_ahead is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_initialize(
+     libewf_read_ahead_t **read_ahead,
+     libewf_io_handle_t *io_handle,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_initialize";
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read-ahead value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	*read_ahead = memory_allocate_structure(
+	               libewf_read_ahead_t );
+
+	if( *read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_ahead,
+	     0,
+	     sizeof( libewf_read_ahead_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read-ahead.",
+		 function );
+
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+
+		return( -1 );
+	}
+	( *read_ahead )->io_handle = io_handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_ahead )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *read_ahead )->status_changed_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create status changed condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( libewf_read_ahead_set_number_of_chunks(
+	     *read_ahead,
+	     number_of_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of chunks.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *read_ahead != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *read_ahead )->status_changed_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *read_ahead )->status_changed_condition ),
+			 NULL );
+		}
+		if( ( *read_ahead )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *read_ahead )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read-ahead
+ * Chunk data that was read ahead but not used is discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_free(
+     libewf_read_ahead_t **read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_free";
+	int result            = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		/* Setting the number of chunks to 0 discards the entries
+		 * and stops the unpack thread pool
+		 */
+		if( libewf_read_ahead_set_number_of_chunks(
+		     *read_ahead,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop read-ahead.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+#if defined( HAVE_LIBEWF_IO_URING )
+		if( ( *read_ahead )->io_uring != NULL )
+		{
+			if( libewf_io_uring_free(
+			     &( ( *read_ahead )->io_uring ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free io_uring.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( libcthreads_condition_free(
+		     &( ( *read_ahead )->status_changed_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free status changed condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *read_ahead )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( result );
+}
+
+/* Discards the chunks that were read ahead
+ * This function waits for chunks that are still being unpacked
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_discard(
+     libewf_read_ahead_t *read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function            = "libewf_read_ahead_discard";
+	int result                       = 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libewf_read_ahead_entry_t *entry = NULL;
+	int entry_index                  = 0;
+#endif
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+#if defined( HAVE_LIBEWF_IO_URING )
+	if( ( read_ahead->entries != NULL )
+	 && ( read_ahead->io_uring != NULL ) )
+	{
+		/* The chunk data buffers of queued reads cannot be freed
+		 * before the reads have completed
+		 */
+		if( libewf_read_ahead_complete_queued_entries(
+		     read_ahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to complete queued reads.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	if( read_ahead->entries != NULL )
+	{
+		for( entry_index = 0;
+		     entry_index < read_ahead->number_of_chunks;
+		     entry_index++ )
+		{
+			entry = &( ( read_ahead->entries )[ entry_index ] );
+
+			if( entry->status == LIBEWF_READ_AHEAD_ENTRY_STATUS_UNUSED )
+			{
+				continue;
+			}
+#if defined( HAVE_LIBEWF_IO_URING )
+			if( entry->status == LIBEWF_READ_AHEAD_ENTRY_STATUS_QUEUED )
+			{
+				/* The entry is still in use by the io_uring
+				 */
+				continue;
+			}
+#endif
+			if( libewf_read_ahead_wait_for_entry(
+			     read_ahead,
+			     entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to wait for entry: %d.",
+				 function,
+				 entry_index );
+
+				result = -1;
+
+				/* The entry is still in use by the unpack thread pool
+				 */
+				continue;
+			}
+			if( entry->chunk_data != NULL )
+			{
+				if( libewf_chunk_data_free(
+				     &( entry->chunk_data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk: %" PRIu64 " data.",
+					 function,
+					 entry->chunk_index );
+
+					result = -1;
+				}
+			}
+			entry->status = LIBEWF_READ_AHEAD_ENTRY_STATUS_UNUSED;
+		}
+	}
+#endif
+	read_ahead->last_chunk_index     = 0;
+	read_ahead->next_chunk_index     = 0;
+	read_ahead->last_chunk_index_set = 0;
+	read_ahead->is_sequential        = 0;
+
+	return( result );
+}
+
+/* Sets the number of chunks to read ahead
+ * A value of 0 disables read-ahead
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_set_number_of_chunks(
+     libewf_read_ahead_t *read_ahead,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_set_number_of_chunks";
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	size_t entries_size   = 0;
+	int number_of_threads = 0;
+#endif
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunks < 0 )
+	 || ( number_of_chunks > LIBEWF_MAXIMUM_READ_AHEAD_NUMBER_OF_CHUNKS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_read_ahead_discard(
+	     read_ahead,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to discard chunks read ahead.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( read_ahead->unpack_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( read_ahead->unpack_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join unpack thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( read_ahead->entries != NULL )
+	{
+		memory_free(
+		 read_ahead->entries );
+
+		read_ahead->entries = NULL;
+	}
+	read_ahead->number_of_chunks = 0;
+
+	if( number_of_chunks > 0 )
+	{
+		entries_size = sizeof( libewf_read_ahead_entry_t ) * number_of_chunks;
+
+		read_ahead->entries = (libewf_read_ahead_entry_t *) memory_allocate(
+		                                                     entries_size );
+
+		if( read_ahead->entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entries.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     read_ahead->entries,
+		     0,
+		     entries_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entries.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_threads = number_of_chunks;
+
+		if( number_of_threads > LIBEWF_MAXIMUM_READ_AHEAD_NUMBER_OF_THREADS )
+		{
+			number_of_threads = LIBEWF_MAXIMUM_READ_AHEAD_NUMBER_OF_THREADS;
+		}
+		if( libcthreads_thread_pool_create(
+		     &( read_ahead->unpack_thread_pool ),
+		     NULL,
+		     number_of_threads,
+		     number_of_chunks,
+		     (int (*)(intptr_t *, void *)) &libewf_read_ahead_read_entry_callback,
+		     (void *) read_ahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create unpack thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	read_ahead->number_of_chunks = number_of_chunks;
+
+	return( 1 );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+on_error:
+	if( read_ahead->entries != NULL )
+	{
+		memory_free(
+		 read_ahead->entries );
+
+		read_ahead->entries = NULL;
+	}
+	return( -1 );
+#endif
+}
+
+/* Prepares reading a specific chunk
+ * Retrieves the unpacked chunk data that was read ahead for the chunk, if available, and,
+ * if the access is sequential, schedules the next chunks to be read ahead
+ * The caller takes over management of the chunk data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_prepare_chunk(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t chunk_index,
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function            = "libewf_read_ahead_prepare_chunk";
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libewf_read_ahead_entry_t *entry = NULL;
+	uint64_t maximum_chunk_index     = 0;
+	int result                       = 0;
+#endif
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_data = NULL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( ( read_ahead->number_of_chunks == 0 )
+	 || ( read_ahead->entries == NULL )
+	 || ( media_values->number_of_chunks == 0 ) )
+	{
+		return( 1 );
+	}
+	if( read_ahead->last_chunk_index_set != 0 )
+	{
+		/* Small reads can request the same chunk multiple times
+		 */
+		if( chunk_index == read_ahead->last_chunk_index )
+		{
+			return( 1 );
+		}
+		if( chunk_index != ( read_ahead->last_chunk_index + 1 ) )
+		{
+			if( libewf_read_ahead_discard(
+			     read_ahead,
+			     error ) != 1 )
+			{
+				/* Entries that could not be discarded are still in use by
+				 * the unpack thread pool and are not scheduled again
+				 */
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to discard chunks read ahead.",
+				 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( ( error != NULL )
+					 && ( *error != NULL ) )
+					{
+						libcnotify_print_error_backtrace(
+						 *error );
+					}
+				}
+#endif
+				libcerror_error_free(
+				 error );
+			}
+		}
+		else
+		{
+			read_ahead->is_sequential = 1;
+		}
+	}
+	read_ahead->last_chunk_index     = chunk_index;
+	read_ahead->last_chunk_index_set = 1;
+
+	entry = &( ( read_ahead->entries )[ chunk_index % read_ahead->number_of_chunks ] );
+
+	if( ( entry->status != LIBEWF_READ_AHEAD_ENTRY_STATUS_UNUSED )
+	 && ( entry->chunk_index == chunk_index ) )
+	{
+#if defined( HAVE_LIBEWF_IO_URING )
+		if( entry->status == LIBEWF_READ_AHEAD_ENTRY_STATUS_QUEUED )
+		{
+			if( libewf_read_ahead_complete_queued_entry(
+			     read_ahead,
+			     entry,
+			     error ) != 1 )
+			{
+				/* Reading ahead is best effort, the chunk is read by the regular read path.
+				 * The entry is still in use by the io_uring and is left as is
+				 */
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to complete read of chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( ( error != NULL )
+					 && ( *error != NULL ) )
+					{
+						libcnotify_print_error_backtrace(
+						 *error );
+					}
+				}
+#endif
+				libcerror_error_free(
+				 error );
+
+				return( 1 );
+			}
+		}
+#endif
+		if( libewf_read_ahead_wait_for_entry(
+		     read_ahead,
+		     entry,
+		     error ) != 1 )
+		{
+			/* Reading ahead is best effort, the chunk is read by the regular read path.
+			 * The entry is still in use by the unpack thread pool and is left as is
+			 */
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			return( 1 );
+		}
+		if( entry->status == LIBEWF_READ_AHEAD_ENTRY_STATUS_UNPACKED )
+		{
+			/* The caller takes over management of chunk_data
+			 */
+			*chunk_data       = entry->chunk_data;
+			entry->chunk_data = NULL;
+		}
+		else if( entry->chunk_data != NULL )
+		{
+			/* The chunk is read again by the regular read path
+			 * so that the error is reported to the caller
+			 */
+			if( libewf_chunk_data_free(
+			     &( entry->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( ( error != NULL )
+					 && ( *error != NULL ) )
+					{
+						libcnotify_print_error_backtrace(
+						 *error );
+					}
+				}
+#endif
+				libcerror_error_free(
+				 error );
+
+				entry->chunk_data = NULL;
+			}
+		}
+		entry->status = LIBEWF_READ_AHEAD_ENTRY_STATUS_UNUSED;
+	}
+	if( read_ahead->is_sequential == 0 )
+	{
+		return( 1 );
+	}
+	if( read_ahead->next_chunk_index <= chunk_index )
+	{
+		read_ahead->next_chunk_index = chunk_index + 1;
+	}
+	maximum_chunk_index = chunk_index + read_ahead->number_of_chunks;
+
+	if( maximum_chunk_index >= media_values->number_of_chunks )
+	{
+		maximum_chunk_index = media_values->number_of_chunks - 1;
+	}
+#if defined( HAVE_LIBEWF_IO_URING )
+	if( ( read_ahead->io_uring != NULL )
+	 && ( read_ahead->next_chunk_index <= maximum_chunk_index ) )
+	{
+		/* The chunks are read ahead in batches of at least half the number
+		 * of chunks, or the remaining chunks, so that every submission
+		 * keeps a deep queue of reads outstanding
+		 */
+		if( ( ( ( maximum_chunk_index - read_ahead->next_chunk_index + 1 ) * 2 ) < (uint64_t) read_ahead->number_of_chunks )
+		 && ( maximum_chunk_index < ( media_values->number_of_chunks - 1 ) ) )
+		{
+			return( 1 );
+		}
+		/* The reads of the previous batch are completed before a new batch is queued
+		 */
+		if( libewf_read_ahead_complete_queued_entries(
+		     read_ahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to complete queued reads.",
+			 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+	}
+#endif
+	while( read_ahead->next_chunk_index <= maximum_chunk_index )
+	{
+		result = libewf_read_ahead_schedule_chunk(
+		          read_ahead,
+		          read_ahead->next_chunk_index,
+		          chunk_table,
+		          file_io_pool,
+		          media_values,
+		          segment_table,
+		          chunk_groups_cache,
+		          error );
+
+		if( result == -1 )
+		{
+			/* Reading ahead is best effort, the regular read path
+			 * reports the error if the chunk cannot be read
+			 */
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+		if( result != 1 )
+		{
+			break;
+		}
+		read_ahead->next_chunk_index += 1;
+	}
+#if defined( HAVE_LIBEWF_IO_URING )
+	if( read_ahead->io_uring != NULL )
+	{
+		if( libewf_read_ahead_submit_queued_entries(
+		     read_ahead,
+		     error ) != 1 )
+		{
+			/* The chunks that could not be read are read again
+			 * by the regular read path
+			 */
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+	}
+#endif
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	return( 1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Schedules a chunk to be read ahead
+ * The chunk data is read and unpacked by the unpack thread pool, or read using
+ * the io_uring if available. Without positional reads the chunk data is read
+ * on the calling thread since the seek and read of the file IO pool entry
+ * must not be interleaved with those of other threads
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the chunk cannot be read ahead or -1 on error
+ */
+int libewf_read_ahead_schedule_chunk(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t chunk_index,
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data     = NULL;
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_read_ahead_entry_t *entry    = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_read_ahead_schedule_chunk";
+	off64_t chunk_data_offset           = 0;
+	off64_t chunk_group_data_offset     = 0;
+	off64_t element_data_offset         = 0;
+	off64_t segment_file_data_offset    = 0;
+	size64_t chunk_data_size            = 0;
+	uint64_t pattern                    = 0;
+	uint32_t chunk_data_flags           = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int chunks_list_index               = 0;
+	int file_io_pool_entry              = 0;
+	int result                          = 0;
+
+#if !defined( HAVE_LIBBFIO_POOL_READ_BUFFER_AT_OFFSET )
+	size64_t contiguous_data_size       = 0;
+	ssize_t read_count                  = 0;
+#endif
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read-ahead - missing entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read-ahead - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	entry = &( ( read_ahead->entries )[ chunk_index % read_ahead->number_of_chunks ] );
+
+	if( entry->status != LIBEWF_READ_AHEAD_ENTRY_STATUS_UNUSED )
+	{
+		return( 0 );
+	}
+	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+		  chunk_table,
+		  file_io_pool,
+		  segment_table,
+		  chunk_groups_cache,
+		  (off64_t) chunk_index * media_values->chunk_size,
+		  &segment_number,
+		  &segment_file_data_offset,
+		  &segment_file,
+		  &chunk_groups_list_index,
+		  &chunk_group_data_offset,
+		  &chunk_group,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file chunk group of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( ( result == 0 )
+	      || ( chunk_group == NULL ) )
+	{
+		return( 0 );
+	}
+	result = libewf_chunk_group_get_chunk_at_offset(
+		  chunk_group,
+		  chunk_group_data_offset,
+		  &chunks_list_index,
+		  &element_data_offset,
+		  &file_io_pool_entry,
+		  &chunk_data_offset,
+		  &chunk_data_size,
+		  &chunk_data_flags,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " from chunk group: %d in segment file: %" PRIu32 ".",
+		 function,
+		 chunk_index,
+		 chunk_groups_list_index,
+		 segment_number );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( ( chunk_data_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		return( 0 );
+	}
+	/* Pattern fill chunks are filled from the table entries and do not need to be read
+	 */
+	result = libewf_chunk_group_get_chunk_fill_pattern_at_offset(
+		  chunk_group,
+		  chunk_group_data_offset,
+		  &pattern,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " fill pattern.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_data_initialize(
+	     &chunk_data,
+	     read_ahead->io_handle->chunk_size,
+	     read_ahead->io_handle->buffer_pool,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_IO_URING )
+	if( read_ahead->io_uring != NULL )
+	{
+		entry->chunk_index = chunk_index;
+		entry->chunk_data  = chunk_data;
+
+		result = libewf_read_ahead_queue_entry(
+		          read_ahead,
+		          entry,
+		          file_io_pool,
+		          file_io_pool_entry,
+		          chunk_data_offset,
+		          chunk_data_size,
+		          chunk_data_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to queue chunk: %" PRIu64 " data read.",
+			 function,
+			 chunk_index );
+
+			entry->chunk_data = NULL;
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			return( 1 );
+		}
+		/* The chunk data is read using the file IO pool if it cannot be queued
+		 */
+		entry->chunk_data = NULL;
+	}
+#endif
+#if defined( HAVE_LIBBFIO_POOL_READ_BUFFER_AT_OFFSET )
+	if( ( chunk_data_size == 0 )
+	 || ( chunk_data_size > (size64_t) chunk_data->allocated_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk: %" PRIu64 " data size value out of bounds.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	/* The chunk data is read with a positional read by the unpack thread pool
+	 * so that the calling thread does not block on the read
+	 */
+	entry->file_io_pool       = file_io_pool;
+	entry->file_io_pool_entry = file_io_pool_entry;
+	entry->read_offset        = chunk_data_offset;
+	entry->read_size          = (size_t) chunk_data_size;
+	entry->read_flags         = chunk_data_flags;
+#else
+	/* Chunks that are stored back to back are read with a single read
+	 * into the coalesced read buffer, if available
+	 */
+	result = 0;
+
+	if( read_ahead->io_handle->coalesced_read_buffer != NULL )
+	{
+		result = libewf_chunk_group_get_contiguous_chunk_data_size(
+		          chunk_group,
+		          chunk_group_data_offset,
+		          (size64_t) read_ahead->io_handle->coalesced_read_buffer->maximum_data_size,
+		          &contiguous_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " contiguous data size.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	if( result != 0 )
+	{
+		read_count = libewf_chunk_data_read_from_coalesced_read_buffer(
+			      chunk_data,
+			      read_ahead->io_handle->coalesced_read_buffer,
+			      file_io_pool,
+			      file_io_pool_entry,
+			      chunk_data_offset,
+			      chunk_data_size,
+			      chunk_data_flags,
+			      contiguous_data_size,
+			      error );
+	}
+	else
+	{
+		read_count = libewf_chunk_data_read_from_file_io_pool(
+			      chunk_data,
+			      file_io_pool,
+			      file_io_pool_entry,
+			      chunk_data_offset,
+			      chunk_data_size,
+			      chunk_data_flags,
+			      error );
+	}
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	entry->file_io_pool = NULL;
+#endif /* defined( HAVE_LIBBFIO_POOL_READ_BUFFER_AT_OFFSET ) */
+
+	entry->chunk_index = chunk_index;
+	entry->chunk_data  = chunk_data;
+	entry->status      = LIBEWF_READ_AHEAD_ENTRY_STATUS_PENDING;
+
+	if( libcthreads_thread_pool_push(
+	     read_ahead->unpack_thread_pool,
+	     (intptr_t *) entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push chunk: %" PRIu64 " onto unpack thread pool queue.",
+		 function,
+		 chunk_index );
+
+		entry->file_io_pool = NULL;
+		entry->chunk_data   = NULL;
+		entry->status       = LIBEWF_READ_AHEAD_ENTRY_STATUS_UNUSED;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_LIBEWF_IO_URING )
+
+/* Initializes the io_uring used to read the chunk data
+ * The chunk data is read using the regular read path if io_uring is not available
+ * Returns 1 if successful, 0 if io_uring is not available or -1 on error
+ */
+int libewf_read_ahead_initialize_io_uring(
+     libewf_read_ahead_t *read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_initialize_io_uring";
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead->io_uring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read-ahead - io_uring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	/* The queue depth covers the maximum number of chunks to read ahead
+	 * so that the number of chunks can be changed while the handle is open
+	 */
+	if( libewf_io_uring_initialize(
+	     &( read_ahead->io_uring ),
+	     LIBEWF_MAXIMUM_READ_AHEAD_NUMBER_OF_CHUNKS,
+	     error ) != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Queues the read of the chunk data of an entry
+ * The chunk data is read by submit_queued_entries
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the read cannot be queued or -1 on error
+ */
+int libewf_read_ahead_queue_entry(
+     libewf_read_ahead_t *read_ahead,
+     libewf_read_ahead_entry_t *entry,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t chunk_data_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_queue_entry";
+	int descriptor        = -1;
+	int read_index        = 0;
+	int result            = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead->io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read-ahead - missing io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid entry - missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data_size == 0 )
+	 || ( chunk_data_size > (size64_t) entry->chunk_data->allocated_data_size ) )
+	{
+		return( 0 );
+	}
+	result = libewf_io_uring_get_descriptor(
+	          read_ahead->io_uring,
+	          file_io_pool,
+	          file_io_pool_entry,
+	          &descriptor,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve descriptor of file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	result = libewf_io_uring_append_read(
+	          read_ahead->io_uring,
+	          descriptor,
+	          entry->chunk_data->data,
+	          (size_t) chunk_data_size,
+	          chunk_data_offset,
+	          &read_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append read.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	entry->read_index = read_index;
+	entry->read_size  = (size_t) chunk_data_size;
+	entry->read_flags = chunk_data_flags;
+	entry->status     = LIBEWF_READ_AHEAD_ENTRY_STATUS_QUEUED;
+
+	return( 1 );
+}
+
+/* Pushes an entry of which the queued read has completed onto the unpack thread pool
+ * The entry is discarded if the chunk data could not be read
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_push_queued_entry(
+     libewf_read_ahead_t *read_ahead,
+     libewf_read_ahead_entry_t *entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_push_queued_entry";
+	ssize_t read_count    = -1;
+	int result            = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->status != LIBEWF_READ_AHEAD_ENTRY_STATUS_QUEUED )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry - unsupported status.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead->io_uring != NULL )
+	{
+		if( libewf_io_uring_get_read_count(
+		     read_ahead->io_uring,
+		     entry->read_index,
+		     &read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve read count of chunk: %" PRIu64 ".",
+			 function,
+			 entry->chunk_index );
+
+			read_count = -1;
+			result     = -1;
+		}
+	}
+	if( read_count == (ssize_t) entry->read_size )
+	{
+		if( libewf_chunk_data_set_packed_data_size(
+		     entry->chunk_data,
+		     entry->read_size,
+		     entry->read_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " data size.",
+			 function,
+			 entry->chunk_index );
+
+			read_count = -1;
+			result     = -1;
+		}
+	}
+	if( read_count == (ssize_t) entry->read_size )
+	{
+		entry->file_io_pool = NULL;
+		entry->status       = LIBEWF_READ_AHEAD_ENTRY_STATUS_PENDING;
+
+		if( libcthreads_thread_pool_push(
+		     read_ahead->unpack_thread_pool,
+		     (intptr_t *) entry,
+		     error ) == 1 )
+		{
+			return( result );
+		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push chunk: %" PRIu64 " onto unpack thread pool queue.",
+		 function,
+		 entry->chunk_index );
+
+		result = -1;
+	}
+	/* The chunk is read again by the regular read path
+	 * so that the error is reported to the caller
+	 */
+	libewf_chunk_data_free(
+	 &( entry->chunk_data ),
+	 NULL );
+
+	entry->status = LIBEWF_READ_AHEAD_ENTRY_STATUS_UNUSED;
+
+	return( result );
+}
+
+/* Waits for the queued read of an entry to complete and pushes the entry
+ * onto the unpack thread pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_complete_queued_entry(
+     libewf_read_ahead_t *read_ahead,
+     libewf_read_ahead_entry_t *entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_complete_queued_entry";
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead->io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read-ahead - missing io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_io_uring_wait_for_read(
+	     read_ahead->io_uring,
+	     entry->read_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to wait for read of chunk: %" PRIu64 ".",
+		 function,
+		 entry->chunk_index );
+
+		return( -1 );
+	}
+	if( libewf_read_ahead_push_queued_entry(
+	     read_ahead,
+	     entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push chunk: %" PRIu64 ".",
+		 function,
+		 entry->chunk_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Submits the reads of the queued entries as a single batch
+ * The reads are completed by complete_queued_entry or complete_queued_entries
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_submit_queued_entries(
+     libewf_read_ahead_t *read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_submit_queued_entries";
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead->io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read-ahead - missing io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_io_uring_submit_reads(
+	     read_ahead->io_uring,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to submit reads.",
+		 function );
+
+		/* The ring is no longer usable, the reads that were submitted are completed
+		 * and the chunk data is read using the regular read path from now on
+		 */
+		if( libewf_read_ahead_complete_queued_entries(
+		     read_ahead,
+		     NULL ) == 1 )
+		{
+			libewf_io_uring_free(
+			 &( read_ahead->io_uring ),
+			 NULL );
+		}
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Waits for the queued reads to complete and pushes the entries
+ * that were read onto the unpack thread pool
+ * Entries that could not be read are discarded
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_complete_queued_entries(
+     libewf_read_ahead_t *read_ahead,
+     libcerror_error_t **error )
+{
+	libewf_read_ahead_entry_t *entry = NULL;
+	static char *function            = "libewf_read_ahead_complete_queued_entries";
+	int entry_index                  = 0;
+	int result                       = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read-ahead - missing entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead->io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read-ahead - missing io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	/* The entries are left queued if the reads cannot be waited for
+	 * since the chunk data can still be written by the kernel
+	 */
+	if( libewf_io_uring_wait_for_reads(
+	     read_ahead->io_uring,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to wait for reads.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < read_ahead->number_of_chunks;
+	     entry_index++ )
+	{
+		entry = &( ( read_ahead->entries )[ entry_index ] );
+
+		if( entry->status != LIBEWF_READ_AHEAD_ENTRY_STATUS_QUEUED )
+		{
+			continue;
+		}
+		if( libewf_read_ahead_push_queued_entry(
+		     read_ahead,
+		     entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk: %" PRIu64 ".",
+			 function,
+			 entry->chunk_index );
+
+			result = -1;
+		}
+	}
+	if( libewf_io_uring_clear_reads(
+	     read_ahead->io_uring,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to clear reads.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_IO_URING ) */
+
+/* Waits until an entry is no longer being read or unpacked
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_wait_for_entry(
+     libewf_read_ahead_t *read_ahead,
+     libewf_read_ahead_entry_t *entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_wait_for_entry";
+	int result            = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( entry->status == LIBEWF_READ_AHEAD_ENTRY_STATUS_PENDING )
+	{
+		if( libcthreads_condition_wait(
+		     read_ahead->status_changed_condition,
+		     read_ahead->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for status changed condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the status of an entry and signals the threads waiting for the entry
+ * The status is also set and signalled if the mutex cannot be grabbed,
+ * so that threads waiting for the entry are not blocked indefinitely
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_set_entry_status(
+     libewf_read_ahead_t *read_ahead,
+     libewf_read_ahead_entry_t *entry,
+     uint8_t status,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_set_entry_status";
+	uint8_t mutex_grabbed = 0;
+	int result            = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		mutex_grabbed = 1;
+	}
+	entry->status = status;
+
+	if( libcthreads_condition_broadcast(
+	     read_ahead->status_changed_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to broadcast status changed condition.",
+		 function );
+
+		result = -1;
+	}
+	if( mutex_grabbed != 0 )
+	{
+		if( libcthreads_mutex_release(
+		     read_ahead->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Reads, if needed, and unpacks the chunk data of an entry
+ * Callback function for the unpack thread pool
+ * The entry is marked as unpacked or failed on every return so that
+ * threads waiting for the entry are not blocked indefinitely
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_read_entry_callback(
+     libewf_read_ahead_entry_t *entry,
+     libewf_read_ahead_t *read_ahead )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_read_ahead_read_entry_callback";
+	ssize_t read_count       = 0;
+	uint8_t status           = LIBEWF_READ_AHEAD_ENTRY_STATUS_UNPACKED;
+	int result               = 1;
+
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		result = -1;
+	}
+	else if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		/* Without the read-ahead no thread can wait for the entry
+		 */
+		entry->status = LIBEWF_READ_AHEAD_ENTRY_STATUS_FAILED;
+
+		result = -1;
+	}
+	else
+	{
+		if( entry->file_io_pool != NULL )
+		{
+			read_count = libewf_chunk_data_read_from_file_io_pool(
+				      entry->chunk_data,
+				      entry->file_io_pool,
+				      entry->file_io_pool_entry,
+				      entry->read_offset,
+				      (size64_t) entry->read_size,
+				      entry->read_flags,
+				      &error );
+
+			entry->file_io_pool = NULL;
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 entry->chunk_index );
+
+				status = LIBEWF_READ_AHEAD_ENTRY_STATUS_FAILED;
+				result = -1;
+			}
+		}
+		/* Unpacking decompresses the chunk data and verifies its checksum
+		 */
+		if( ( status == LIBEWF_READ_AHEAD_ENTRY_STATUS_UNPACKED )
+		 && ( libewf_chunk_data_unpack(
+		       entry->chunk_data,
+		       read_ahead->io_handle,
+		       &error ) != 1 ) )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 function,
+			 entry->chunk_index );
+
+			status = LIBEWF_READ_AHEAD_ENTRY_STATUS_FAILED;
+			result = -1;
+		}
+		if( libewf_read_ahead_set_entry_status(
+		     read_ahead,
+		     entry,
+		     status,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " status.",
+			 function,
+			 entry->chunk_index );
+
+			result = -1;
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,240 @@
+/*
+ * Read-ahead functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_READ_AHEAD_H )
+#define _LIBEWF_READ_AHEAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_table.h"
+#include "libewf_io_handle.h"
+#include "libewf_io_uring.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfcache.h"
+#include "libewf_media_values.h"
+#include "libewf_segment_table.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_read_ahead_entry libewf_read_ahead_entry_t;
+
+struct libewf_read_ahead_entry
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The status
+	 */
+	uint8_t status;
+
+	/* The file IO pool the chunk data is read from by the unpack thread pool,
+	 * NULL if the chunk data was already read
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The file IO pool entry of the read
+	 */
+	int file_io_pool_entry;
+
+	/* The offset of the read
+	 */
+	off64_t read_offset;
+
+	/* The size of the read
+	 */
+	size_t read_size;
+
+	/* The chunk data flags of the read
+	 */
+	uint32_t read_flags;
+
+#if defined( HAVE_LIBEWF_IO_URING )
+	/* The index of the queued read
+	 */
+	int read_index;
+#endif
+};
+
+typedef struct libewf_read_ahead libewf_read_ahead_t;
+
+struct libewf_read_ahead
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The number of chunks to read ahead
+	 */
+	int number_of_chunks;
+
+	/* The index of the last chunk that was requested
+	 */
+	uint64_t last_chunk_index;
+
+	/* The index of the next chunk to read ahead
+	 */
+	uint64_t next_chunk_index;
+
+	/* Value to indicate the last chunk index was set
+	 */
+	uint8_t last_chunk_index_set;
+
+	/* Value to indicate the access is sequential
+	 */
+	uint8_t is_sequential;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The entries
+	 */
+	libewf_read_ahead_entry_t *entries;
+
+	/* The unpack thread pool
+	 */
+	libcthreads_thread_pool_t *unpack_thread_pool;
+
+	/* The mutex that protects the entry status
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that signals an entry status change
+	 */
+	libcthreads_condition_t *status_changed_condition;
+
+#if defined( HAVE_LIBEWF_IO_URING )
+	/* The io_uring used to read the chunk data, NULL if not used
+	 */
+	libewf_io_uring_t *io_uring;
+#endif
+#endif
+};
+
+int libewf_read_ahead_initialize(
+     libewf_read_ahead_t **read_ahead,
+     libewf_io_handle_t *io_handle,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_free(
+     libewf_read_ahead_t **read_ahead,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_discard(
+     libewf_read_ahead_t *read_ahead,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_set_number_of_chunks(
+     libewf_read_ahead_t *read_ahead,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_prepare_chunk(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t chunk_index,
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_read_ahead_schedule_chunk(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t chunk_index,
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_IO_URING )
+
+int libewf_read_ahead_initialize_io_uring(
+     libewf_read_ahead_t *read_ahead,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_queue_entry(
+     libewf_read_ahead_t *read_ahead,
+     libewf_read_ahead_entry_t *entry,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t chunk_data_flags,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_push_queued_entry(
+     libewf_read_ahead_t *read_ahead,
+     libewf_read_ahead_entry_t *entry,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_complete_queued_entry(
+     libewf_read_ahead_t *read_ahead,
+     libewf_read_ahead_entry_t *entry,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_submit_queued_entries(
+     libewf_read_ahead_t *read_ahead,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_complete_queued_entries(
+     libewf_read_ahead_t *read_ahead,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_IO_URING ) */
+
+int libewf_read_ahead_wait_for_entry(
+     libewf_read_ahead_t *read_ahead,
+     libewf_read_ahead_entry_t *entry,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_set_entry_status(
+     libewf_read_ahead_t *read_ahead,
+     libewf_read_ahead_entry_t *entry,
+     uint8_t status,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_read_entry_callback(
+     libewf_read_ahead_entry_t *entry,
+     libewf_read_ahead_t *read_ahead );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_READ_AHEAD_H ) */
+
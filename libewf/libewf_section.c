@@ -29,6 +29,7 @@
 #include "libewf_compression.h"
 #include "libewf_debug.h"
 #include "libewf_definitions.h"
+#include "libewf_file_io_pool.h"
 #include "libewf_hash_sections.h"
 #include "libewf_header_values.h"
 #include "libewf_header_sections.h"
@@ -509,24 +510,6 @@ ssize_t libewf_section_descriptor_read(
 		 file_offset );
 	}
 #endif
-	if( libbfio_pool_seek_offset(
-	     file_io_pool,
-	     file_io_pool_entry,
-	     file_offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek section descriptor offset: %" PRIi64 " in file IO pool entry: %d.",
-		 function,
-		 file_offset,
-		 file_io_pool_entry );
-
-		goto on_error;
-	}
 	section_descriptor_data = (uint8_t *) memory_allocate(
 	                                       section_descriptor_data_size );
 
@@ -541,11 +524,12 @@ ssize_t libewf_section_descriptor_read(
 
 		goto on_error;
 	}
-	read_count = libbfio_pool_read_buffer(
+	read_count = libewf_file_io_pool_read_buffer_at_offset(
 	              file_io_pool,
 	              file_io_pool_entry,
 	              section_descriptor_data,
 	              section_descriptor_data_size,
+	              file_offset,
 	              error );
 
 	if( read_count != (ssize_t) section_descriptor_data_size )
@@ -1714,6 +1698,17 @@ ssize_t libewf_section_compressed_string_read(
 
 		return( -1 );
 	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( uncompressed_string == NULL )
 	{
 		libcerror_error_set(
@@ -1816,6 +1811,7 @@ ssize_t libewf_section_compressed_string_read(
 	          section_data,
 	          section_data_size,
 	          compression_method,
+	          io_handle->deflate_codec,
 	          *uncompressed_string,
 	          uncompressed_string_size,
 	          error );
@@ -1846,6 +1842,7 @@ ssize_t libewf_section_compressed_string_read(
 		          section_data,
 		          section_data_size,
 		          compression_method,
+		          io_handle->deflate_codec,
 		          *uncompressed_string,
 		          uncompressed_string_size,
 		          error );
@@ -1941,6 +1938,17 @@ ssize_t libewf_section_write_compressed_string(
 
 		return( -1 );
 	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( format_version == 1 )
 	{
 		section_descriptor_data_size = sizeof( ewf_section_descriptor_v1_t );
@@ -2034,6 +2042,7 @@ ssize_t libewf_section_write_compressed_string(
 	          &compressed_string_size,
 	          compression_method,
 	          compression_level,
+	          io_handle->deflate_codec,
 	          uncompressed_string,
 	          uncompressed_string_size,
 	          error );
@@ -2097,6 +2106,7 @@ ssize_t libewf_section_write_compressed_string(
 		          &compressed_string_size,
 		          compression_method,
 		          compression_level,
+		          io_handle->deflate_codec,
 		          uncompressed_string,
 		          uncompressed_string_size,
 		          error );
@@ -7864,6 +7874,7 @@ ssize_t libewf_section_table_read(
 {
 	uint8_t *table_data           = NULL;
 	static char *function         = "libewf_section_table_read";
+	off64_t section_data_offset   = 0;
 	size_t table_data_size        = 0;
 	size_t table_entry_data_size  = 0;
 	size_t table_header_data_size = 0;
@@ -8050,6 +8061,21 @@ ssize_t libewf_section_table_read(
 	}
 /* TODO add support for table with chunk data */
 
+	if( libewf_section_get_data_offset(
+	     section,
+	     format_version,
+	     &section_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve section data offset.",
+		 function );
+
+		goto on_error;
+	}
 	*section_data = (uint8_t *) memory_allocate(
 	                             sizeof( uint8_t ) * *section_data_size );
 
@@ -8064,11 +8090,12 @@ ssize_t libewf_section_table_read(
 
 		goto on_error;
 	}
-	read_count = libbfio_pool_read_buffer(
+	read_count = libewf_file_io_pool_read_buffer_at_offset(
 	              file_io_pool,
 	              file_io_pool_entry,
 	              *section_data,
 	              *section_data_size,
+	              section_data_offset,
 	              error );
 
 	if( read_count != (ssize_t) *section_data_size )
@@ -25,6 +25,10 @@
 #include <system_string.h>
 #include <types.h>
 
+#if defined( HAVE_LIMITS_H ) || defined( WINAPI )
+#include <limits.h>
+#endif
+
 #if defined( TIME_WITH_SYS_TIME )
 #include <sys/time.h>
 #include <time.h>
@@ -36,6 +40,7 @@
 
 #include "libewf_case_data.h"
 #include "libewf_chunk_data.h"
+#include "libewf_chunk_index.h"
 #include "libewf_debug.h"
 #include "libewf_definitions.h"
 #include "libewf_device_information.h"
@@ -55,6 +60,7 @@
 #include "libewf_segment_table.h"
 #include "libewf_single_files.h"
 #include "libewf_unused.h"
+#include "libewf_write_behind_buffer.h"
 
 #include "ewf_file_header.h"
 #include "ewf_section.h"
@@ -1615,6 +1621,247 @@ on_error:
 	return( -1 );
 }
 
+/* Reads the section descriptors and chunk groups of the segment file from the chunk index
+ * Returns 1 if successful, 0 if the chunk index does not match the segment file or -1 on error
+ */
+int libewf_segment_file_read_chunk_index(
+     libewf_segment_file_t *segment_file,
+     libewf_chunk_index_t *chunk_index,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_index_chunk_group_t *chunk_group = NULL;
+	libewf_chunk_index_section_t *section         = NULL;
+	libewf_chunk_index_segment_t *segment         = NULL;
+	static char *function                         = "libewf_segment_file_read_chunk_index";
+	size64_t section_descriptor_size              = 0;
+	size64_t storage_media_size                   = 0;
+	uint64_t number_of_chunks                     = 0;
+	uint32_t chunk_group_index                    = 0;
+	uint32_t section_index                        = 0;
+	int element_index                             = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->sections_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing sections list.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->chunk_groups_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing chunk groups list.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry < 0 )
+	 || ( (uint32_t) file_io_pool_entry >= chunk_index->number_of_segments ) )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_index_get_segment_by_index(
+	     chunk_index,
+	     (uint32_t) file_io_pool_entry,
+	     &segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment: %d from chunk index.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	if( ( segment->segment_number != segment_file->segment_number )
+	 || ( segment->file_size != segment_file_size ) )
+	{
+		return( 0 );
+	}
+	if( ( segment_file->io_handle->chunk_size != 0 )
+	 && ( segment_file->io_handle->chunk_size != chunk_index->chunk_size ) )
+	{
+		return( 0 );
+	}
+	if( segment_file->major_version == 2 )
+	{
+		if( memory_compare(
+		     segment_file->set_identifier,
+		     chunk_index->set_identifier,
+		     16 ) != 0 )
+		{
+			return( 0 );
+		}
+	}
+	if( segment_file->major_version == 1 )
+	{
+		section_descriptor_size = sizeof( ewf_section_descriptor_v1_t );
+	}
+	else if( segment_file->major_version == 2 )
+	{
+		section_descriptor_size = sizeof( ewf_section_descriptor_v2_t );
+	}
+	else
+	{
+		return( 0 );
+	}
+	if( ( segment->number_of_sections == 0 )
+	 || ( segment->number_of_sections > (uint32_t) INT_MAX ) )
+	{
+		return( 0 );
+	}
+	/* The sections are stored in the order of the sections list
+	 */
+	for( section_index = 0;
+	     section_index < segment->number_of_sections;
+	     section_index++ )
+	{
+		if( libewf_chunk_index_get_section_by_index(
+		     chunk_index,
+		     segment,
+		     section_index,
+		     &section,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %" PRIu32 " from chunk index.",
+			 function,
+			 section_index );
+
+			return( -1 );
+		}
+		if( libfdata_list_append_element(
+		     segment_file->sections_list,
+		     &element_index,
+		     file_io_pool_entry,
+		     section->descriptor_offset,
+		     section_descriptor_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append section to sections list.",
+			 function );
+
+			return( -1 );
+		}
+		/* Mimic the offset the section descriptors walk would have ended at
+		 */
+		if( ( ( segment_file->major_version == 1 )
+		  &&  ( section_index == ( segment->number_of_sections - 1 ) ) )
+		 || ( ( segment_file->major_version == 2 )
+		  &&  ( section_index == 0 ) ) )
+		{
+			segment_file->current_offset = section->descriptor_offset + section_descriptor_size;
+		}
+	}
+	segment_file->last_section_offset              = segment->last_section_offset;
+	segment_file->device_information_section_index = segment->device_information_section_index;
+	segment_file->previous_last_chunk_filled       = segment->previous_last_chunk_filled;
+
+	for( chunk_group_index = 0;
+	     chunk_group_index < segment->number_of_chunk_groups;
+	     chunk_group_index++ )
+	{
+		if( libewf_chunk_index_get_chunk_group_by_index(
+		     chunk_index,
+		     segment,
+		     chunk_group_index,
+		     &chunk_group,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk group: %" PRIu32 " from chunk index.",
+			 function,
+			 chunk_group_index );
+
+			return( -1 );
+		}
+		storage_media_size = (size64_t) chunk_index->chunk_size * chunk_group->number_of_chunks;
+
+		if( libfdata_list_append_element_with_mapped_size(
+		     segment_file->chunk_groups_list,
+		     &( segment_file->chunk_groups_index ),
+		     file_io_pool_entry,
+		     chunk_group->data_offset,
+		     chunk_group->data_size,
+		     chunk_group->range_flags,
+		     storage_media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element with mapped size to chunk groups list.",
+			 function );
+
+			return( -1 );
+		}
+		segment_file->storage_media_size += storage_media_size;
+		number_of_chunks                 += chunk_group->number_of_chunks;
+	}
+	segment_file->number_of_chunks  = number_of_chunks;
+	segment_file->last_chunk_filled = segment->last_chunk_filled;
+	segment_file->flags            |= (uint8_t) ( segment->flags & ( LIBEWF_SEGMENT_FILE_FLAG_IS_LAST | LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED | LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) );
+
+	return( 1 );
+}
+
 /* Reads a volume section
  * Returns the number of bytes read if successful or -1 on error
  */
@@ -3969,6 +4216,8 @@ on_error:
 }
 
 /* Write a chunk of data to a segment file and update the chunk table
+ * If a write-behind buffer is provided the chunk is written by means of the write-behind buffer
+ * which needs to be flushed before anything else is written to the segment file
  * Returns the number of bytes written or -1 on error
  */
 ssize_t libewf_segment_file_write_chunk_data(
@@ -3977,6 +4226,7 @@ ssize_t libewf_segment_file_write_chunk_data(
          int file_io_pool_entry,
          uint64_t chunk_index,
          libewf_chunk_data_t *chunk_data,
+         libewf_write_behind_buffer_t *write_behind_buffer,
          libcerror_error_t **error )
 {
 	static char *function     = "libewf_segment_file_write_chunk_data";
@@ -4144,12 +4394,23 @@ ssize_t libewf_segment_file_write_chunk_data(
 		 "\n" );
 	}
 #endif
-	write_count = libewf_chunk_data_write(
-	               chunk_data,
-	               file_io_pool,
-	               file_io_pool_entry,
-	               error );
-
+	if( write_behind_buffer != NULL )
+	{
+		write_count = libewf_chunk_data_write_to_write_behind_buffer(
+		               chunk_data,
+		               write_behind_buffer,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               error );
+	}
+	else
+	{
+		write_count = libewf_chunk_data_write(
+		               chunk_data,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               error );
+	}
 	if( write_count != (ssize_t) chunk_write_size )
 	{
 		libcerror_error_set(
@@ -5878,60 +6139,50 @@ on_error:
 }
 
 /* Reads a segment file
- * Callback function for the segment files list
+ * The table sections are only read if the chunk size is known
  * Returns 1 if successful or -1 on error
  */
-int libewf_segment_file_read_element_data(
-     libewf_io_handle_t *io_handle,
+int libewf_segment_file_read_file_io_pool(
+     libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
-     libfdata_list_element_t *element,
-     libfcache_cache_t *segment_file_cache,
      int file_io_pool_entry,
-     off64_t segment_file_offset,
      size64_t segment_file_size,
-     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     size32_t chunk_size,
      libcerror_error_t **error )
 {
-	libfcache_cache_t *sections_cache   = NULL;
-	libewf_section_t *section           = NULL;
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_segment_file_read_element_data";
-	off64_t section_data_offset         = 0;
-	ssize_t read_count                  = 0;
-	int element_index                   = 0;
-	int last_section                    = 0;
-	int number_of_sections              = 0;
-	int result                          = 0;
-	int section_index                   = 0;
-
-	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
-	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
+	libfcache_cache_t *sections_cache = NULL;
+	libewf_section_t *section         = NULL;
+	static char *function             = "libewf_segment_file_read_file_io_pool";
+	off64_t section_data_offset       = 0;
+	off64_t segment_file_offset       = 0;
+	ssize_t read_count                = 0;
+	int element_index                 = 0;
+	int last_section                  = 0;
+	int number_of_sections            = 0;
+	int result                        = 0;
+	int section_index                 = 0;
 
-	if( io_handle == NULL )
+	if( segment_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 "%s: invalid segment file.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_file_initialize(
-	     &segment_file,
-	     io_handle,
-	     error ) != 1 )
+	if( segment_file->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segment file.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	read_count = libewf_segment_file_read_file_header(
 		      segment_file,
@@ -5966,13 +6217,13 @@ int libewf_segment_file_read_element_data(
 
 		goto on_error;
 	}
-	if( ( io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	if( ( segment_file->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
 	 && ( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 ) )
 	{
 		segment_file->type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
 	}
-	else if( ( io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED )
-	      && ( io_handle->segment_file_type != segment_file->type ) )
+	else if( ( segment_file->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED )
+	      && ( segment_file->io_handle->segment_file_type != segment_file->type ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -5998,6 +6249,33 @@ int libewf_segment_file_read_element_data(
 			return( -1 );
 		}
 	}
+	/* If a chunk index is available the section descriptors and table sections do not need to be read
+	 */
+	if( segment_file->io_handle->chunk_index != NULL )
+	{
+		result = libewf_segment_file_read_chunk_index(
+		          segment_file,
+		          segment_file->io_handle->chunk_index,
+		          file_io_pool_entry,
+		          segment_file_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk index.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			return( 1 );
+		}
+	}
 	/* Read the section descriptors:
 	 * EWF version 1 read from front to back
 	 * EWF version 2 read from back to front
@@ -6237,7 +6515,7 @@ int libewf_segment_file_read_element_data(
 			                                               - segment_file->device_information_section_index;
 		}
 	}
-	if( io_handle->chunk_size != 0 )
+	if( chunk_size != 0 )
 	{
 		if( libfcache_cache_initialize(
 		     &sections_cache,
@@ -6331,7 +6609,7 @@ int libewf_segment_file_read_element_data(
 					      section,
 					      file_io_pool,
 					      file_io_pool_entry,
-					      io_handle->chunk_size,
+					      chunk_size,
 					      error );
 
 				if( read_count == -1 )
@@ -6424,6 +6702,89 @@ int libewf_segment_file_read_element_data(
 			goto on_error;
 		}
 	}
+	return( 1 );
+
+on_error:
+	if( sections_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &sections_cache,
+		 NULL );
+	}
+	if( section != NULL )
+	{
+		libewf_section_free(
+		 &section,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a segment file
+ * Callback function for the segment files list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_element_data(
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfcache_cache_t *segment_file_cache,
+     int file_io_pool_entry,
+     off64_t segment_file_offset LIBEWF_ATTRIBUTE_UNUSED,
+     size64_t segment_file_size,
+     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
+     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_file_read_element_data";
+
+	LIBEWF_UNREFERENCED_PARAMETER( segment_file_offset )
+	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
+	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_read_file_io_pool(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     segment_file_size,
+	     io_handle->chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfdata_list_element_set_element_value(
 	     element,
 	     (intptr_t *) file_io_pool,
@@ -6445,18 +6806,6 @@ int libewf_segment_file_read_element_data(
 	return( 1 );
 
 on_error:
-	if( sections_cache != NULL )
-	{
-		libfcache_cache_free(
-		 &sections_cache,
-		 NULL );
-	}
-	if( section != NULL )
-	{
-		libewf_section_free(
-		 &section,
-		 NULL );
-	}
 	if( segment_file != NULL )
 	{
 		libewf_segment_file_free(
@@ -6707,24 +7056,8 @@ int libewf_segment_file_read_chunk_group_element_data(
 
 			goto on_error;
 		}
-		if( libbfio_pool_seek_offset(
-		     file_io_pool,
-		     file_io_pool_entry,
-		     chunk_group_data_offset,
-		     SEEK_SET,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek chunk table offset: %" PRIi64 " in file IO pool entry: %d.",
-			 function,
-			 chunk_group_data_offset,
-			 file_io_pool_entry );
-
-			goto on_error;
-		}
+		/* The table section is read at the section start offset
+		 */
 		segment_file->current_offset = chunk_group_data_offset;
 		section->start_offset        = chunk_group_data_offset;
 		section->data_size           = (uint32_t) chunk_group_data_size;
@@ -36,6 +36,7 @@
 
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
+#include "libewf_chunk_index.h"
 #include "libewf_hash_sections.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
@@ -47,6 +48,7 @@
 #include "libewf_media_values.h"
 #include "libewf_section.h"
 #include "libewf_single_files.h"
+#include "libewf_write_behind_buffer.h"
 
 #include "ewf_data.h"
 #include "ewf_table.h"
@@ -203,6 +205,13 @@ ssize_t libewf_segment_file_read_table2_section(
          int file_io_pool_entry,
          libcerror_error_t **error );
 
+int libewf_segment_file_read_chunk_index(
+     libewf_segment_file_t *segment_file,
+     libewf_chunk_index_t *chunk_index,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
 ssize_t libewf_segment_file_read_volume_section(
          libewf_segment_file_t *segment_file,
          libewf_section_t *section,
@@ -317,6 +326,7 @@ ssize_t libewf_segment_file_write_chunk_data(
          int file_io_pool_entry,
          uint64_t chunk_index,
          libewf_chunk_data_t *chunk_data,
+         libewf_write_behind_buffer_t *write_behind_buffer,
          libcerror_error_t **error );
 
 ssize_t libewf_segment_file_write_hash_sections(
@@ -371,6 +381,14 @@ int libewf_segment_file_write_sections_correction(
      ewf_data_t **data_section,
      libcerror_error_t **error );
 
+int libewf_segment_file_read_file_io_pool(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     size32_t chunk_size,
+     libcerror_error_t **error );
+
 int libewf_segment_file_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
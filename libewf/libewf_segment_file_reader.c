@@ -0,0 +1,426 @@
+/*
+ * Segment file reader functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_segment_file.h"
+#include "libewf_segment_file_reader.h"
+#include "libewf_unused.h"
+
+/* Creates a segment file reader
+ * Make sure the value segment_file_reader is referencing, is set to NULL
+ * The file IO handle is managed by the segment file reader if successful
+ * and the value file_io_handle is referencing is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_reader_initialize(
+     libewf_segment_file_reader_t **segment_file_reader,
+     libewf_io_handle_t *io_handle,
+     libbfio_handle_t **file_io_handle,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     size32_t chunk_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_reader_initialize";
+
+	if( segment_file_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_file_reader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment file reader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry < 0 )
+	 || ( file_io_pool_entry == INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_file_reader = memory_allocate_structure(
+	                        libewf_segment_file_reader_t );
+
+	if( *segment_file_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment file reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment_file_reader,
+	     0,
+	     sizeof( libewf_segment_file_reader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment file reader.",
+		 function );
+
+		memory_free(
+		 *segment_file_reader );
+
+		*segment_file_reader = NULL;
+
+		return( -1 );
+	}
+	/* The file IO pool entry of the segment file is retained
+	 * since it is stored in the sections and chunk groups lists
+	 */
+	if( libbfio_pool_initialize(
+	     &( ( *segment_file_reader )->file_io_pool ),
+	     file_io_pool_entry + 1,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_set_handle(
+	     ( *segment_file_reader )->file_io_pool,
+	     file_io_pool_entry,
+	     *file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file IO handle: %d in file IO pool.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	/* The file IO handle is now managed by the file IO pool
+	 */
+	*file_io_handle = NULL;
+
+	( *segment_file_reader )->io_handle          = io_handle;
+	( *segment_file_reader )->file_io_pool_entry = file_io_pool_entry;
+	( *segment_file_reader )->segment_file_size  = segment_file_size;
+	( *segment_file_reader )->chunk_size         = chunk_size;
+
+	return( 1 );
+
+on_error:
+	if( *segment_file_reader != NULL )
+	{
+		if( ( *segment_file_reader )->file_io_pool != NULL )
+		{
+			libbfio_pool_free(
+			 &( ( *segment_file_reader )->file_io_pool ),
+			 NULL );
+		}
+		memory_free(
+		 *segment_file_reader );
+
+		*segment_file_reader = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment file reader
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_reader_free(
+     libewf_segment_file_reader_t **segment_file_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_reader_free";
+	int result            = 1;
+
+	if( segment_file_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_file_reader != NULL )
+	{
+		/* The io_handle reference is freed elsewhere
+		 */
+		if( ( *segment_file_reader )->segment_file != NULL )
+		{
+			if( libewf_segment_file_free(
+			     &( ( *segment_file_reader )->segment_file ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free segment file.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libbfio_pool_close_all(
+		     ( *segment_file_reader )->file_io_pool,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close all file IO pool handles.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_pool_free(
+		     &( ( *segment_file_reader )->file_io_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO pool.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *segment_file_reader );
+
+		*segment_file_reader = NULL;
+	}
+	return( result );
+}
+
+/* Reads the segment file
+ * The segment file is only read if not read before
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_reader_read(
+     libewf_segment_file_reader_t *segment_file_reader,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_file_reader_read";
+
+	if( segment_file_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file_reader->segment_file != NULL )
+	{
+		return( 1 );
+	}
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     segment_file_reader->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_open(
+	     segment_file_reader->file_io_pool,
+	     segment_file_reader->file_io_pool_entry,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO pool entry: %d.",
+		 function,
+		 segment_file_reader->file_io_pool_entry );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_read_file_io_pool(
+	     segment_file,
+	     segment_file_reader->file_io_pool,
+	     segment_file_reader->file_io_pool_entry,
+	     segment_file_reader->segment_file_size,
+	     segment_file_reader->chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file.",
+		 function );
+
+		goto on_error;
+	}
+	segment_file_reader->segment_file = segment_file;
+
+	return( 1 );
+
+on_error:
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Reads the segment file
+ * Callback function for the thread pool
+ * A segment file that could not be read is not set, its error is reported
+ * when it is read again by the segment files list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_reader_read_callback(
+     libewf_segment_file_reader_t *segment_file_reader,
+     void *arguments LIBEWF_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_segment_file_reader_read_callback";
+
+	LIBEWF_UNREFERENCED_PARAMETER( arguments )
+
+	if( libewf_segment_file_reader_read(
+	     segment_file_reader,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
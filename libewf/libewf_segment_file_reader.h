@@ -0,0 +1,98 @@
+/*
+ * Segment file reader functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SEGMENT_FILE_READER_H )
+#define _LIBEWF_SEGMENT_FILE_READER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_segment_file.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_segment_file_reader libewf_segment_file_reader_t;
+
+struct libewf_segment_file_reader
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The file IO pool that only contains the file IO handle of the segment file
+	 * so the segment file can be read independent of the file IO pool of the handle
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The segment file size
+	 */
+	size64_t segment_file_size;
+
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The segment file, NULL if not read
+	 */
+	libewf_segment_file_t *segment_file;
+};
+
+int libewf_segment_file_reader_initialize(
+     libewf_segment_file_reader_t **segment_file_reader,
+     libewf_io_handle_t *io_handle,
+     libbfio_handle_t **file_io_handle,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     size32_t chunk_size,
+     libcerror_error_t **error );
+
+int libewf_segment_file_reader_free(
+     libewf_segment_file_reader_t **segment_file_reader,
+     libcerror_error_t **error );
+
+int libewf_segment_file_reader_read(
+     libewf_segment_file_reader_t *segment_file_reader,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_segment_file_reader_read_callback(
+     libewf_segment_file_reader_t *segment_file_reader,
+     void *arguments );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SEGMENT_FILE_READER_H ) */
+
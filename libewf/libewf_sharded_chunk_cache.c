@@ -0,0 +1,579 @@
+/*
+ * Sharded chunk cache functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_cache.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_sharded_chunk_cache.h"
+
+/* The sharded chunk cache divides the chunks over multiple chunk caches
+ * based on the chunk index. Every shard has its own mutex so that threads
+ * that read different chunks rarely have to wait for each other.
+ */
+
+/* Creates a sharded chunk cache
+ * Make sure the value sharded_chunk_cache is referencing, is set to NULL
+ * The maximum cache size is divided over the shards
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sharded_chunk_cache_initialize(
+     libewf_sharded_chunk_cache_t **sharded_chunk_cache,
+     size64_t maximum_cache_size,
+     size32_t chunk_size,
+     int number_of_shards,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sharded_chunk_cache_initialize";
+	size_t shards_size    = 0;
+	int shard_index       = 0;
+
+	if( sharded_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sharded chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sharded_chunk_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sharded chunk cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_shards <= 0 )
+	 || ( number_of_shards > LIBEWF_MAXIMUM_CHUNK_CACHE_NUMBER_OF_SHARDS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of shards value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*sharded_chunk_cache = memory_allocate_structure(
+	                        libewf_sharded_chunk_cache_t );
+
+	if( *sharded_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sharded chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *sharded_chunk_cache,
+	     0,
+	     sizeof( libewf_sharded_chunk_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sharded chunk cache.",
+		 function );
+
+		memory_free(
+		 *sharded_chunk_cache );
+
+		*sharded_chunk_cache = NULL;
+
+		return( -1 );
+	}
+	shards_size = sizeof( libewf_chunk_cache_t * ) * number_of_shards;
+
+	( *sharded_chunk_cache )->shards = (libewf_chunk_cache_t **) memory_allocate(
+	                                                              shards_size );
+
+	if( ( *sharded_chunk_cache )->shards == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shards.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *sharded_chunk_cache )->shards,
+	     0,
+	     shards_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shards.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	shards_size = sizeof( libcthreads_mutex_t * ) * number_of_shards;
+
+	( *sharded_chunk_cache )->mutexes = (libcthreads_mutex_t **) memory_allocate(
+	                                                               shards_size );
+
+	if( ( *sharded_chunk_cache )->mutexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create mutexes.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *sharded_chunk_cache )->mutexes,
+	     0,
+	     shards_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear mutexes.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *sharded_chunk_cache )->number_of_shards = number_of_shards;
+
+	for( shard_index = 0;
+	     shard_index < number_of_shards;
+	     shard_index++ )
+	{
+		if( libewf_chunk_cache_initialize(
+		     &( ( *sharded_chunk_cache )->shards[ shard_index ] ),
+		     maximum_cache_size / number_of_shards,
+		     chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shard: %d.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_initialize(
+		     &( ( *sharded_chunk_cache )->mutexes[ shard_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create mutex: %d.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#endif
+	}
+	return( 1 );
+
+on_error:
+	if( *sharded_chunk_cache != NULL )
+	{
+		libewf_sharded_chunk_cache_free(
+		 sharded_chunk_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a sharded chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sharded_chunk_cache_free(
+     libewf_sharded_chunk_cache_t **sharded_chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sharded_chunk_cache_free";
+	int result            = 1;
+	int shard_index       = 0;
+
+	if( sharded_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sharded chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sharded_chunk_cache != NULL )
+	{
+		for( shard_index = 0;
+		     shard_index < ( *sharded_chunk_cache )->number_of_shards;
+		     shard_index++ )
+		{
+			if( ( *sharded_chunk_cache )->shards[ shard_index ] != NULL )
+			{
+				if( libewf_chunk_cache_free(
+				     &( ( *sharded_chunk_cache )->shards[ shard_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free shard: %d.",
+					 function,
+					 shard_index );
+
+					result = -1;
+				}
+			}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			if( ( *sharded_chunk_cache )->mutexes[ shard_index ] != NULL )
+			{
+				if( libcthreads_mutex_free(
+				     &( ( *sharded_chunk_cache )->mutexes[ shard_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free mutex: %d.",
+					 function,
+					 shard_index );
+
+					result = -1;
+				}
+			}
+#endif
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *sharded_chunk_cache )->mutexes != NULL )
+		{
+			memory_free(
+			 ( *sharded_chunk_cache )->mutexes );
+		}
+#endif
+		if( ( *sharded_chunk_cache )->shards != NULL )
+		{
+			memory_free(
+			 ( *sharded_chunk_cache )->shards );
+		}
+		memory_free(
+		 *sharded_chunk_cache );
+
+		*sharded_chunk_cache = NULL;
+	}
+	return( result );
+}
+
+/* Copies the data of a specific chunk from a specific offset into a buffer
+ * The data is copied while the shard is locked since another thread
+ * can replace the cached data once the shard is released
+ * Returns 1 if successful, 0 if the chunk is not cached or -1 on error
+ */
+int libewf_sharded_chunk_cache_copy_data(
+     libewf_sharded_chunk_cache_t *sharded_chunk_cache,
+     uint64_t chunk_index,
+     size_t data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *copy_size,
+     libcerror_error_t **error )
+{
+	uint8_t *data         = NULL;
+	static char *function = "libewf_sharded_chunk_cache_copy_data";
+	size_t data_size      = 0;
+	size_t safe_copy_size = 0;
+	int result            = 0;
+	int shard_index       = 0;
+
+	if( sharded_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sharded chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( sharded_chunk_cache->number_of_shards <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sharded chunk cache - number of shards value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( copy_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid copy size.",
+		 function );
+
+		return( -1 );
+	}
+	shard_index = (int) ( chunk_index % sharded_chunk_cache->number_of_shards );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     sharded_chunk_cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_chunk_cache_get_data(
+	          sharded_chunk_cache->shards[ shard_index ],
+	          chunk_index,
+	          &data,
+	          &data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data from shard: %d.",
+		 function,
+		 chunk_index,
+		 shard_index );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( data_offset > data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		safe_copy_size = data_size - data_offset;
+
+		if( safe_copy_size > buffer_size )
+		{
+			safe_copy_size = buffer_size;
+		}
+		if( safe_copy_size > 0 )
+		{
+			if( memory_copy(
+			     buffer,
+			     &( data[ data_offset ] ),
+			     safe_copy_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+		*copy_size = safe_copy_size;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     sharded_chunk_cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 sharded_chunk_cache->mutexes[ shard_index ],
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Sets the data of a specific chunk
+ * The data is copied into the cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sharded_chunk_cache_set_data(
+     libewf_sharded_chunk_cache_t *sharded_chunk_cache,
+     uint64_t chunk_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sharded_chunk_cache_set_data";
+	int result            = 1;
+	int shard_index       = 0;
+
+	if( sharded_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sharded chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( sharded_chunk_cache->number_of_shards <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sharded chunk cache - number of shards value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	shard_index = (int) ( chunk_index % sharded_chunk_cache->number_of_shards );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     sharded_chunk_cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_chunk_cache_set_data(
+	     sharded_chunk_cache->shards[ shard_index ],
+	     chunk_index,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in shard: %d.",
+		 function,
+		 chunk_index,
+		 shard_index );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     sharded_chunk_cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
@@ -0,0 +1,87 @@
+/*
+ * Sharded chunk cache functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SHARDED_CHUNK_CACHE_H )
+#define _LIBEWF_SHARDED_CHUNK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_cache.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_sharded_chunk_cache libewf_sharded_chunk_cache_t;
+
+struct libewf_sharded_chunk_cache
+{
+	/* The number of shards
+	 */
+	int number_of_shards;
+
+	/* The shards
+	 */
+	libewf_chunk_cache_t **shards;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutexes, one per shard
+	 */
+	libcthreads_mutex_t **mutexes;
+#endif
+};
+
+int libewf_sharded_chunk_cache_initialize(
+     libewf_sharded_chunk_cache_t **sharded_chunk_cache,
+     size64_t maximum_cache_size,
+     size32_t chunk_size,
+     int number_of_shards,
+     libcerror_error_t **error );
+
+int libewf_sharded_chunk_cache_free(
+     libewf_sharded_chunk_cache_t **sharded_chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_sharded_chunk_cache_copy_data(
+     libewf_sharded_chunk_cache_t *sharded_chunk_cache,
+     uint64_t chunk_index,
+     size_t data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *copy_size,
+     libcerror_error_t **error );
+
+int libewf_sharded_chunk_cache_set_data(
+     libewf_sharded_chunk_cache_t *sharded_chunk_cache,
+     uint64_t chunk_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SHARDED_CHUNK_CACHE_H ) */
+
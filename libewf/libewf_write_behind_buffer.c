@@ -0,0 +1,369 @@
+/*
+ * Write-behind buffer functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_write_behind_buffer.h"
+
+/* Creates a write-behind buffer
+ * Make sure the value write_behind_buffer is referencing, is set to NULL
+ * The data is allocated when it is first written
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_behind_buffer_initialize(
+     libewf_write_behind_buffer_t **write_behind_buffer,
+     size_t maximum_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_behind_buffer_initialize";
+
+	if( write_behind_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write-behind buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_behind_buffer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write-behind buffer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_data_size == 0 )
+	 || ( maximum_data_size > (size_t) LIBEWF_MAXIMUM_WRITE_BEHIND_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*write_behind_buffer = memory_allocate_structure(
+	                        libewf_write_behind_buffer_t );
+
+	if( *write_behind_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create write-behind buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *write_behind_buffer,
+	     0,
+	     sizeof( libewf_write_behind_buffer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear write-behind buffer.",
+		 function );
+
+		goto on_error;
+	}
+	( *write_behind_buffer )->maximum_data_size  = maximum_data_size;
+	( *write_behind_buffer )->file_io_pool_entry = -1;
+
+	return( 1 );
+
+on_error:
+	if( *write_behind_buffer != NULL )
+	{
+		memory_free(
+		 *write_behind_buffer );
+
+		*write_behind_buffer = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a write-behind buffer
+ * Data that was not flushed is discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_behind_buffer_free(
+     libewf_write_behind_buffer_t **write_behind_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_behind_buffer_free";
+
+	if( write_behind_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write-behind buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_behind_buffer != NULL )
+	{
+		if( ( *write_behind_buffer )->data != NULL )
+		{
+			memory_free(
+			 ( *write_behind_buffer )->data );
+		}
+		memory_free(
+		 *write_behind_buffer );
+
+		*write_behind_buffer = NULL;
+	}
+	return( 1 );
+}
+
+/* Writes a buffer to a file IO pool entry by means of the write-behind buffer
+ * The buffer is appended to the data of the write-behind buffer, which is written
+ * to the current offset of the file IO pool entry with a single write when full
+ * Data of another file IO pool entry is flushed first
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_write_behind_buffer_write_buffer(
+         libewf_write_behind_buffer_t *write_behind_buffer,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_write_behind_buffer_write_buffer";
+	size_t buffer_offset  = 0;
+	size_t copy_size      = 0;
+
+	if( write_behind_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write-behind buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file IO pool entry value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == 0 )
+	{
+		return( 0 );
+	}
+	if( ( write_behind_buffer->data_size > 0 )
+	 && ( write_behind_buffer->file_io_pool_entry != file_io_pool_entry ) )
+	{
+		if( libewf_write_behind_buffer_flush(
+		     write_behind_buffer,
+		     file_io_pool,
+		     error ) < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write-behind buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( write_behind_buffer->data == NULL )
+	{
+		write_behind_buffer->data = (uint8_t *) memory_allocate(
+		                                         sizeof( uint8_t ) * write_behind_buffer->maximum_data_size );
+
+		if( write_behind_buffer->data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	write_behind_buffer->file_io_pool_entry = file_io_pool_entry;
+
+	while( buffer_offset < buffer_size )
+	{
+		copy_size = write_behind_buffer->maximum_data_size - write_behind_buffer->data_size;
+
+		if( copy_size > ( buffer_size - buffer_offset ) )
+		{
+			copy_size = buffer_size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( ( write_behind_buffer->data )[ write_behind_buffer->data_size ] ),
+		     &( buffer[ buffer_offset ] ),
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy buffer to data.",
+			 function );
+
+			return( -1 );
+		}
+		write_behind_buffer->data_size += copy_size;
+		buffer_offset                  += copy_size;
+
+		if( write_behind_buffer->data_size == write_behind_buffer->maximum_data_size )
+		{
+			if( libewf_write_behind_buffer_flush(
+			     write_behind_buffer,
+			     file_io_pool,
+			     error ) < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush write-behind buffer.",
+				 function );
+
+				return( -1 );
+			}
+			write_behind_buffer->file_io_pool_entry = file_io_pool_entry;
+		}
+	}
+	return( (ssize_t) buffer_size );
+}
+
+/* Flushes the write-behind buffer
+ * Writes the data to the current offset of its file IO pool entry
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_write_behind_buffer_flush(
+         libewf_write_behind_buffer_t *write_behind_buffer,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_write_behind_buffer_flush";
+	ssize_t write_count   = 0;
+
+	if( write_behind_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write-behind buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_behind_buffer->data_size == 0 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: writing %" PRIzd " bytes to file IO pool entry: %d.\n",
+		 function,
+		 write_behind_buffer->data_size,
+		 write_behind_buffer->file_io_pool_entry );
+	}
+#endif
+	write_count = libbfio_pool_write_buffer(
+	               file_io_pool,
+	               write_behind_buffer->file_io_pool_entry,
+	               write_behind_buffer->data,
+	               write_behind_buffer->data_size,
+	               error );
+
+	if( write_count != (ssize_t) write_behind_buffer->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data to file IO pool entry: %d.",
+		 function,
+		 write_behind_buffer->file_io_pool_entry );
+
+		return( -1 );
+	}
+	write_behind_buffer->data_size          = 0;
+	write_behind_buffer->file_io_pool_entry = -1;
+
+	return( write_count );
+}
+
@@ -0,0 +1,83 @@
+/*
+ * Write-behind buffer functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_WRITE_BEHIND_BUFFER_H )
+#define _LIBEWF_WRITE_BEHIND_BUFFER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_write_behind_buffer libewf_write_behind_buffer_t;
+
+struct libewf_write_behind_buffer
+{
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The maximum data size, which is the size of a single write
+	 */
+	size_t maximum_data_size;
+
+	/* The file IO pool entry of the data
+	 */
+	int file_io_pool_entry;
+};
+
+int libewf_write_behind_buffer_initialize(
+     libewf_write_behind_buffer_t **write_behind_buffer,
+     size_t maximum_data_size,
+     libcerror_error_t **error );
+
+int libewf_write_behind_buffer_free(
+     libewf_write_behind_buffer_t **write_behind_buffer,
+     libcerror_error_t **error );
+
+ssize_t libewf_write_behind_buffer_write_buffer(
+         libewf_write_behind_buffer_t *write_behind_buffer,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+ssize_t libewf_write_behind_buffer_flush(
+         libewf_write_behind_buffer_t *write_behind_buffer,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_WRITE_BEHIND_BUFFER_H ) */
+
@@ -39,6 +39,7 @@
 #include "libewf_chunk_table.h"
 #include "libewf_compression.h"
 #include "libewf_definitions.h"
+#include "libewf_direct_file_io_handle.h"
 #include "libewf_filename.h"
 #include "libewf_header_sections.h"
 #include "libewf_header_values.h"
@@ -55,6 +56,7 @@
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
 #include "libewf_unused.h"
+#include "libewf_write_behind_buffer.h"
 #include "libewf_write_io_handle.h"
 
 #include "ewf_data.h"
@@ -210,6 +212,22 @@ int libewf_write_io_handle_free(
 			memory_free(
 			 ( *write_io_handle )->compressed_zero_byte_empty_block );
 		}
+		if( ( *write_io_handle )->write_behind_buffer != NULL )
+		{
+			if( libewf_write_behind_buffer_free(
+			     &( ( *write_io_handle )->write_behind_buffer ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free write-behind buffer.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libewf_chunk_group_free(
 		     &( ( *write_io_handle )->chunk_group ),
 		     error ) != 1 )
@@ -307,6 +325,7 @@ int libewf_write_io_handle_clone(
 	( *destination_write_io_handle )->table_entries_data      = NULL;
 	( *destination_write_io_handle )->table_entries_data_size = 0;
 	( *destination_write_io_handle )->number_of_table_entries = 0;
+	( *destination_write_io_handle )->write_behind_buffer     = NULL;
 
 	if( source_write_io_handle->case_data != NULL )
 	{
@@ -452,6 +471,29 @@ int libewf_write_io_handle_clone(
 
 		goto on_error;
 	}
+	/* The data of the source write-behind buffer is not cloned
+	 */
+	if( source_write_io_handle->write_behind_buffer != NULL )
+	{
+		if( libewf_write_behind_buffer_initialize(
+		     &( ( *destination_write_io_handle )->write_behind_buffer ),
+		     source_write_io_handle->write_behind_buffer->maximum_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination write-behind buffer.",
+			 function );
+
+			libewf_chunk_group_free(
+			 &( ( *destination_write_io_handle )->chunk_group ),
+			 NULL );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
@@ -773,6 +815,7 @@ int libewf_write_io_handle_initialize_values(
 				  &( write_io_handle->compressed_zero_byte_empty_block_size ),
 				  io_handle->compression_method,
 				  compression_level,
+				  io_handle->deflate_codec,
 				  zero_byte_empty_block,
 				  (size_t) media_values->chunk_size,
 				  error );
@@ -829,6 +872,7 @@ int libewf_write_io_handle_initialize_values(
 					  &( write_io_handle->compressed_zero_byte_empty_block_size ),
 					  io_handle->compression_method,
 					  compression_level,
+					  io_handle->deflate_codec,
 					  zero_byte_empty_block,
 					  (size_t) media_values->chunk_size,
 					  error );
@@ -2291,6 +2335,7 @@ int libewf_write_io_handle_test_chunks_section_full(
 int libewf_write_io_handle_create_segment_file(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
+     int io_engine,
      libewf_segment_table_t *segment_table,
      uint8_t segment_file_type,
      uint32_t segment_number,
@@ -2403,41 +2448,64 @@ int libewf_write_io_handle_create_segment_file(
 		 filename );
 	}
 #endif
-	if( libbfio_file_initialize(
-	     &file_io_handle,
-	     error ) != 1 )
+#if defined( HAVE_LIBEWF_DIRECT_FILE_IO_HANDLE )
+	if( io_engine == LIBEWF_IO_ENGINE_DIRECT )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO handle.",
-		 function );
+		if( libewf_direct_file_initialize(
+		     &file_io_handle,
+		     filename,
+		     filename_size - 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create direct file IO handle.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
+	else
+#endif
+	{
+		if( libbfio_file_initialize(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
+
+			goto on_error;
+		}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libbfio_file_set_name_wide(
-	     file_io_handle,
-	     filename,
-	     filename_size,
-	     error ) != 1 )
+		if( libbfio_file_set_name_wide(
+		     file_io_handle,
+		     filename,
+		     filename_size,
+		     error ) != 1 )
 #else
-	if( libbfio_file_set_name(
-	     file_io_handle,
-	     filename,
-	     filename_size,
-	     error ) != 1 )
+		if( libbfio_file_set_name(
+		     file_io_handle,
+		     filename,
+		     filename_size,
+		     error ) != 1 )
 #endif
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set filename in file IO handle.",
-		 function );
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set filename in file IO handle.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
 	memory_free(
 	 filename );
@@ -2772,6 +2840,25 @@ ssize_t libewf_write_io_handle_write_chunks_section_end(
 			return( -1 );
 		}
 	}
+	/* The chunks in the write-behind buffer need to be written before the end of the chunks section
+	 */
+	if( write_io_handle->write_behind_buffer != NULL )
+	{
+		if( libewf_write_behind_buffer_flush(
+		     write_io_handle->write_behind_buffer,
+		     file_io_pool,
+		     error ) < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write-behind buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
 /* TODO what about linen 7 */
 	if( ( io_handle->format == LIBEWF_FORMAT_ENCASE6 )
 	 || ( io_handle->format == LIBEWF_FORMAT_ENCASE7 ) )
@@ -3041,6 +3128,7 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 		if( libewf_write_io_handle_create_segment_file(
 		     io_handle,
 		     file_io_pool,
+		     write_io_handle->io_engine,
 		     segment_table,
 		     io_handle->segment_file_type,
 		     segment_number,
@@ -3313,6 +3401,7 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 		       file_io_pool_entry,
 		       chunk_index,
 		       chunk_data,
+		       write_io_handle->write_behind_buffer,
 	               error );
 
 	if( write_count <= -1 )
@@ -3356,6 +3445,18 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 	write_io_handle->number_of_chunks_written_to_section      += 1;
 	write_io_handle->number_of_chunks_written                 += 1;
 
+	if( chunk_data->pack_status == LIBEWF_PACK_STATUS_COMPRESSED )
+	{
+		write_io_handle->number_of_compressed_chunks += 1;
+	}
+	else if( chunk_data->pack_status == LIBEWF_PACK_STATUS_INCOMPRESSIBLE )
+	{
+		write_io_handle->number_of_incompressible_chunks += 1;
+	}
+	else if( chunk_data->pack_status == LIBEWF_PACK_STATUS_SKIPPED )
+	{
+		write_io_handle->number_of_skipped_chunks += 1;
+	}
 	/* Reserve space in the segment file for the chunk table entries
 	 */
 	write_io_handle->remaining_segment_file_size -= write_io_handle->chunk_table_entries_reserved_size;
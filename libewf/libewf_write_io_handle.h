@@ -48,6 +48,7 @@
 #include "libewf_read_io_handle.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_write_behind_buffer.h"
 
 #include "ewf_data.h"
 #include "ewf_table.h"
@@ -160,6 +161,20 @@ struct libewf_write_io_handle
          */
         uint64_t number_of_chunks_written;
 
+	/* The number of chunks written that were stored compressed
+	 */
+	uint64_t number_of_compressed_chunks;
+
+	/* The number of chunks written that were stored uncompressed
+	 * since compression did not reduce their size
+	 */
+	uint64_t number_of_incompressible_chunks;
+
+	/* The number of chunks written that were stored uncompressed
+	 * since they were estimated to be incompressible
+	 */
+	uint64_t number_of_skipped_chunks;
+
         /* The number of chunks written of the current segment file
          */
         uint64_t number_of_chunks_written_to_segment_file;
@@ -207,6 +222,14 @@ struct libewf_write_io_handle
 	/* The size of the compressed zero byte empty block
 	 */
 	size_t compressed_zero_byte_empty_block_size;
+
+	/* The write-behind buffer
+	 */
+	libewf_write_behind_buffer_t *write_behind_buffer;
+
+	/* The IO engine used to write the segment files
+	 */
+	int io_engine;
 };
 
 int libewf_write_io_handle_initialize(
@@ -274,6 +297,7 @@ int libewf_write_io_handle_test_chunks_section_full(
 int libewf_write_io_handle_create_segment_file(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
+     int io_engine,
      libewf_segment_table_t *segment_table,
      uint8_t segment_file_type,
      uint32_t segment_number,
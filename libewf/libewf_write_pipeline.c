@@ -0,0 +1,840 @@
+/*
+ * Write pipeline functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_write_pipeline.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a write pipeline
+ * Make sure the value write_pipeline is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_pipeline_initialize(
+     libewf_write_pipeline_t **write_pipeline,
+     libewf_io_handle_t *io_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_pipeline_initialize";
+	size_t entries_size   = 0;
+	int number_of_entries = 0;
+
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_pipeline != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write pipeline value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_WRITE_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*write_pipeline = memory_allocate_structure(
+	                   libewf_write_pipeline_t );
+
+	if( *write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create write pipeline.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *write_pipeline,
+	     0,
+	     sizeof( libewf_write_pipeline_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear write pipeline.",
+		 function );
+
+		memory_free(
+		 *write_pipeline );
+
+		*write_pipeline = NULL;
+
+		return( -1 );
+	}
+	/* The number of entries bounds the number of chunks that are kept in memory
+	 */
+	number_of_entries = number_of_threads * LIBEWF_WRITE_PIPELINE_NUMBER_OF_CHUNKS_PER_THREAD;
+	entries_size      = sizeof( libewf_write_pipeline_entry_t ) * number_of_entries;
+
+	( *write_pipeline )->entries = (libewf_write_pipeline_entry_t *) memory_allocate(
+	                                                                  entries_size );
+
+	if( ( *write_pipeline )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *write_pipeline )->entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	( *write_pipeline )->io_handle         = io_handle;
+	( *write_pipeline )->number_of_entries = number_of_entries;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *write_pipeline )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *write_pipeline )->status_changed_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create status changed condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *write_pipeline )->pack_thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     number_of_entries,
+	     (int (*)(intptr_t *, void *)) &libewf_write_pipeline_pack_entry_callback,
+	     (void *) *write_pipeline,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create pack thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *write_pipeline != NULL )
+	{
+		if( ( *write_pipeline )->status_changed_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *write_pipeline )->status_changed_condition ),
+			 NULL );
+		}
+		if( ( *write_pipeline )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *write_pipeline )->mutex ),
+			 NULL );
+		}
+		if( ( *write_pipeline )->entries != NULL )
+		{
+			memory_free(
+			 ( *write_pipeline )->entries );
+		}
+		memory_free(
+		 *write_pipeline );
+
+		*write_pipeline = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a write pipeline
+ * This function waits for chunks that are still being packed
+ * Chunks that were packed but not retrieved are discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_pipeline_free(
+     libewf_write_pipeline_t **write_pipeline,
+     libcerror_error_t **error )
+{
+	libewf_write_pipeline_entry_t *entry = NULL;
+	static char *function                = "libewf_write_pipeline_free";
+	int entry_index                      = 0;
+	int result                           = 1;
+
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_pipeline != NULL )
+	{
+		/* Joining the pack thread pool waits for the chunks that are still being packed
+		 */
+		if( ( *write_pipeline )->pack_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *write_pipeline )->pack_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join pack thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		/* The entries are only freed when no longer in use by the pack thread pool
+		 */
+		if( ( ( *write_pipeline )->entries != NULL )
+		 && ( result == 1 ) )
+		{
+			for( entry_index = 0;
+			     entry_index < ( *write_pipeline )->number_of_entries;
+			     entry_index++ )
+			{
+				entry = &( ( ( *write_pipeline )->entries )[ entry_index ] );
+
+				if( entry->chunk_data != NULL )
+				{
+					if( libewf_chunk_data_free(
+					     &( entry->chunk_data ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free chunk: %" PRIu64 " data.",
+						 function,
+						 entry->chunk_index );
+
+						result = -1;
+					}
+				}
+			}
+			memory_free(
+			 ( *write_pipeline )->entries );
+		}
+		if( libcthreads_condition_free(
+		     &( ( *write_pipeline )->status_changed_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free status changed condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *write_pipeline )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *write_pipeline );
+
+		*write_pipeline = NULL;
+	}
+	return( result );
+}
+
+/* Determines if all the entries of the write pipeline are in use
+ * Returns 1 if full, 0 if not or -1 on error
+ */
+int libewf_write_pipeline_is_full(
+     libewf_write_pipeline_t *write_pipeline,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_pipeline_is_full";
+
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_pipeline->number_of_used_entries >= write_pipeline->number_of_entries )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Pushes a chunk onto the write pipeline to be packed by the pack thread pool
+ * The write pipeline takes over management of the chunk data, also on error
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_pipeline_push_chunk(
+     libewf_write_pipeline_t *write_pipeline,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t input_data_size,
+     int8_t compression_level,
+     const uint8_t *compressed_zero_byte_empty_block,
+     size_t compressed_zero_byte_empty_block_size,
+     uint8_t pack_flags,
+     libcerror_error_t **error )
+{
+	libewf_write_pipeline_entry_t *entry = NULL;
+	static char *function                = "libewf_write_pipeline_push_chunk";
+	int entry_index                      = 0;
+
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		goto on_error;
+	}
+	if( write_pipeline->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid write pipeline - missing entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	if( write_pipeline->number_of_used_entries >= write_pipeline->number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid write pipeline - number of used entries value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	entry_index = ( write_pipeline->first_entry_index + write_pipeline->number_of_used_entries )
+	            % write_pipeline->number_of_entries;
+
+	entry = &( ( write_pipeline->entries )[ entry_index ] );
+
+	entry->chunk_index                           = chunk_index;
+	entry->chunk_data                            = chunk_data;
+	entry->input_data_size                       = input_data_size;
+	entry->compression_level                     = compression_level;
+	entry->compressed_zero_byte_empty_block      = compressed_zero_byte_empty_block;
+	entry->compressed_zero_byte_empty_block_size = compressed_zero_byte_empty_block_size;
+	entry->pack_flags                            = pack_flags;
+	entry->status                                = LIBEWF_WRITE_PIPELINE_ENTRY_STATUS_PENDING;
+
+	if( libcthreads_thread_pool_push(
+	     write_pipeline->pack_thread_pool,
+	     (intptr_t *) entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push chunk: %" PRIu64 " onto pack thread pool queue.",
+		 function,
+		 chunk_index );
+
+		entry->chunk_data = NULL;
+		entry->status     = LIBEWF_WRITE_PIPELINE_ENTRY_STATUS_UNUSED;
+
+		goto on_error;
+	}
+	write_pipeline->number_of_used_entries += 1;
+
+	return( 1 );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Pops the first (oldest) chunk from the write pipeline if it has been packed
+ * The chunks are retrieved in the order they were pushed onto the pipeline
+ * If wait_for_chunk is set the function waits until the chunk has been packed
+ * The caller takes over management of the chunk data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if no packed chunk is available or -1 on error
+ */
+int libewf_write_pipeline_pop_chunk(
+     libewf_write_pipeline_t *write_pipeline,
+     uint8_t wait_for_chunk,
+     uint64_t *chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *input_data_size,
+     libcerror_error_t **error )
+{
+	libewf_write_pipeline_entry_t *entry = NULL;
+	static char *function                = "libewf_write_pipeline_pop_chunk";
+	uint8_t status                       = 0;
+	int result                           = 1;
+
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_pipeline->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid write pipeline - missing entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_pipeline->number_of_used_entries == 0 )
+	{
+		return( 0 );
+	}
+	entry = &( ( write_pipeline->entries )[ write_pipeline->first_entry_index ] );
+
+	if( libcthreads_mutex_grab(
+	     write_pipeline->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( wait_for_chunk != 0 )
+	    && ( entry->status == LIBEWF_WRITE_PIPELINE_ENTRY_STATUS_PENDING ) )
+	{
+		if( libcthreads_condition_wait(
+		     write_pipeline->status_changed_condition,
+		     write_pipeline->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for status changed condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	status = entry->status;
+
+	if( libcthreads_mutex_release(
+	     write_pipeline->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	if( status == LIBEWF_WRITE_PIPELINE_ENTRY_STATUS_PENDING )
+	{
+		return( 0 );
+	}
+	write_pipeline->first_entry_index       = ( write_pipeline->first_entry_index + 1 )
+	                                        % write_pipeline->number_of_entries;
+	write_pipeline->number_of_used_entries -= 1;
+
+	entry->status = LIBEWF_WRITE_PIPELINE_ENTRY_STATUS_UNUSED;
+
+	if( status != LIBEWF_WRITE_PIPELINE_ENTRY_STATUS_PACKED )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk: %" PRIu64 " data.",
+		 function,
+		 entry->chunk_index );
+
+		libewf_chunk_data_free(
+		 &( entry->chunk_data ),
+		 NULL );
+
+		return( -1 );
+	}
+	*chunk_index     = entry->chunk_index;
+	*chunk_data      = entry->chunk_data;
+	*input_data_size = entry->input_data_size;
+
+	entry->chunk_data = NULL;
+
+	return( 1 );
+}
+
+/* Sets the status of an entry and signals the threads waiting for the entry
+ * The status is also set and signalled if the mutex cannot be grabbed,
+ * so that threads waiting for the entry are not blocked indefinitely
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_pipeline_set_entry_status(
+     libewf_write_pipeline_t *write_pipeline,
+     libewf_write_pipeline_entry_t *entry,
+     uint8_t status,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_pipeline_set_entry_status";
+	uint8_t mutex_grabbed = 0;
+	int result            = 1;
+
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     write_pipeline->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		mutex_grabbed = 1;
+	}
+	entry->status = status;
+
+	if( libcthreads_condition_broadcast(
+	     write_pipeline->status_changed_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to broadcast status changed condition.",
+		 function );
+
+		result = -1;
+	}
+	if( mutex_grabbed != 0 )
+	{
+		if( libcthreads_mutex_release(
+		     write_pipeline->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Packs the chunk data of an entry
+ * Callback function for the pack thread pool
+ * The entry is marked as packed or failed on every return so that
+ * threads waiting for the entry are not blocked indefinitely
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_pipeline_pack_entry_callback(
+     libewf_write_pipeline_entry_t *entry,
+     libewf_write_pipeline_t *write_pipeline )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_write_pipeline_pack_entry_callback";
+	uint8_t status           = LIBEWF_WRITE_PIPELINE_ENTRY_STATUS_PACKED;
+	int result               = 1;
+
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		result = -1;
+	}
+	else if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		/* Without the write pipeline no thread can wait for the entry
+		 */
+		entry->status = LIBEWF_WRITE_PIPELINE_ENTRY_STATUS_FAILED;
+
+		result = -1;
+	}
+	else
+	{
+		/* Packing compresses the chunk data and calculates its checksum
+		 */
+		if( libewf_chunk_data_pack(
+		     entry->chunk_data,
+		     write_pipeline->io_handle,
+		     entry->compression_level,
+		     entry->compressed_zero_byte_empty_block,
+		     entry->compressed_zero_byte_empty_block_size,
+		     entry->pack_flags,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 function,
+			 entry->chunk_index );
+
+			status = LIBEWF_WRITE_PIPELINE_ENTRY_STATUS_FAILED;
+			result = -1;
+		}
+		if( libewf_write_pipeline_set_entry_status(
+		     write_pipeline,
+		     entry,
+		     status,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " status.",
+			 function,
+			 entry->chunk_index );
+
+			result = -1;
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
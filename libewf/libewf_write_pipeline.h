@@ -0,0 +1,163 @@
+/*
+ * Write pipeline functions
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_WRITE_PIPELINE_H )
+#define _LIBEWF_WRITE_PIPELINE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_write_pipeline_entry libewf_write_pipeline_entry_t;
+
+struct libewf_write_pipeline_entry
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The size of the chunk data before it was packed
+	 */
+	size_t input_data_size;
+
+	/* The compression level
+	 */
+	int8_t compression_level;
+
+	/* The compressed zero byte empty block
+	 */
+	const uint8_t *compressed_zero_byte_empty_block;
+
+	/* The compressed zero byte empty block size
+	 */
+	size_t compressed_zero_byte_empty_block_size;
+
+	/* The pack flags
+	 */
+	uint8_t pack_flags;
+
+	/* The status
+	 */
+	uint8_t status;
+};
+
+typedef struct libewf_write_pipeline libewf_write_pipeline_t;
+
+struct libewf_write_pipeline
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The entries
+	 */
+	libewf_write_pipeline_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The index of the first (oldest) entry in use
+	 */
+	int first_entry_index;
+
+	/* The number of entries in use
+	 */
+	int number_of_used_entries;
+
+	/* The pack thread pool
+	 */
+	libcthreads_thread_pool_t *pack_thread_pool;
+
+	/* The mutex that protects the entry status
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that signals an entry status change
+	 */
+	libcthreads_condition_t *status_changed_condition;
+};
+
+int libewf_write_pipeline_initialize(
+     libewf_write_pipeline_t **write_pipeline,
+     libewf_io_handle_t *io_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_write_pipeline_free(
+     libewf_write_pipeline_t **write_pipeline,
+     libcerror_error_t **error );
+
+int libewf_write_pipeline_is_full(
+     libewf_write_pipeline_t *write_pipeline,
+     libcerror_error_t **error );
+
+int libewf_write_pipeline_push_chunk(
+     libewf_write_pipeline_t *write_pipeline,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t input_data_size,
+     int8_t compression_level,
+     const uint8_t *compressed_zero_byte_empty_block,
+     size_t compressed_zero_byte_empty_block_size,
+     uint8_t pack_flags,
+     libcerror_error_t **error );
+
+int libewf_write_pipeline_pop_chunk(
+     libewf_write_pipeline_t *write_pipeline,
+     uint8_t wait_for_chunk,
+     uint64_t *chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *input_data_size,
+     libcerror_error_t **error );
+
+int libewf_write_pipeline_set_entry_status(
+     libewf_write_pipeline_t *write_pipeline,
+     libewf_write_pipeline_entry_t *entry,
+     uint8_t status,
+     libcerror_error_t **error );
+
+int libewf_write_pipeline_pack_entry_callback(
+     libewf_write_pipeline_entry_t *entry,
+     libewf_write_pipeline_t *write_pipeline );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_WRITE_PIPELINE_H ) */
+
@@ -255,6 +255,13 @@ AC_DEFUN([AX_LIBBFIO_CHECK_LIB],
      [ac_cv_libbfio_dummy=yes],
      [ac_cv_libbfio=no])
 
+    dnl Check for the optional positional read function
+    AC_CHECK_LIB(
+     bfio,
+     libbfio_pool_read_buffer_at_offset,
+     [ac_cv_libbfio_pool_read_buffer_at_offset=yes],
+     [ac_cv_libbfio_pool_read_buffer_at_offset=no])
+
     ac_cv_libbfio_LIBADD="-lbfio"
     ])
    ])
@@ -268,6 +275,14 @@ AC_DEFUN([AX_LIBBFIO_CHECK_LIB],
    [Define to 1 if you have the `bfio' library (-lbfio).])
   ])
 
+ AS_IF(
+  [test "x$ac_cv_libbfio" = xyes && test "x$ac_cv_libbfio_pool_read_buffer_at_offset" = xyes],
+  [AC_DEFINE(
+   [HAVE_LIBBFIO_POOL_READ_BUFFER_AT_OFFSET],
+   [1],
+   [Define to 1 if libbfio has the libbfio_pool_read_buffer_at_offset function.])
+  ])
+
  AS_IF(
   [test "x$ac_cv_libbfio" = xyes],
   [AC_SUBST(
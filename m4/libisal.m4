@@ -0,0 +1,133 @@
+dnl Functions for libisal (Intel ISA-L)
+dnl
+dnl Version: 20161016
+
+dnl Function to detect if libisal is available
+AC_DEFUN([AX_LIBISAL_CHECK_LIB],
+ [dnl Check if parameters were provided
+ AS_IF(
+  [test "x$ac_cv_with_libisal" != x && test "x$ac_cv_with_libisal" != xno && test "x$ac_cv_with_libisal" != xauto-detect],
+  [AS_IF(
+   [test -d "$ac_cv_with_libisal"],
+   [CFLAGS="$CFLAGS -I${ac_cv_with_libisal}/include"
+   LDFLAGS="$LDFLAGS -L${ac_cv_with_libisal}/lib"],
+   [AC_MSG_WARN([no such directory: $ac_cv_with_libisal])
+   ])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_with_libisal" = xno],
+  [ac_cv_libisal=no],
+  [dnl Check for a pkg-config file
+  AS_IF(
+   [test "x$cross_compiling" != "xyes" && test "x$PKGCONFIG" != "x"],
+   [PKG_CHECK_MODULES(
+    [libisal],
+    [libisal >= 2.25],
+    [ac_cv_libisal=libisal],
+    [ac_cv_libisal=no])
+   ])
+
+  AS_IF(
+   [test "x$ac_cv_libisal" = xlibisal],
+   [ac_cv_libisal_CPPFLAGS="$pkg_cv_libisal_CFLAGS"
+   ac_cv_libisal_LIBADD="$pkg_cv_libisal_LIBS"],
+   [dnl Check for headers
+   AC_CHECK_HEADERS([isa-l.h])
+
+   AS_IF(
+    [test "x$ac_cv_header_isa_l_h" = xno],
+    [ac_cv_libisal=no],
+    [dnl Check for the individual functions
+    ac_cv_libisal=libisal
+    AC_CHECK_LIB(
+     isal,
+     isal_deflate_stateless_init,
+     [ac_libisal_dummy=yes],
+     [ac_cv_libisal=no])
+
+    AC_CHECK_LIB(
+     isal,
+     isal_deflate_stateless,
+     [ac_libisal_dummy=yes],
+     [ac_cv_libisal=no])
+
+    AC_CHECK_LIB(
+     isal,
+     isal_inflate_init,
+     [ac_libisal_dummy=yes],
+     [ac_cv_libisal=no])
+
+    AC_CHECK_LIB(
+     isal,
+     isal_inflate_stateless,
+     [ac_libisal_dummy=yes],
+     [ac_cv_libisal=no])
+
+    ac_cv_libisal_LIBADD="-lisal";
+    ])
+   ])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_libisal" = xlibisal],
+  [AC_DEFINE(
+   [HAVE_LIBISAL],
+   [1],
+   [Define to 1 if you have the 'libisal' library (-lisal).])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_libisal" != xno],
+  [AC_SUBST(
+   [HAVE_LIBISAL],
+   [1]) ],
+  [AC_SUBST(
+   [HAVE_LIBISAL],
+   [0])
+  ])
+ ])
+
+dnl Function to detect how to enable libisal
+AC_DEFUN([AX_LIBISAL_CHECK_ENABLE],
+ [AX_COMMON_ARG_WITH(
+  [libisal],
+  [libisal],
+  [search for libisal in includedir and libdir or in the specified DIR, or no if not to use libisal],
+  [auto-detect],
+  [DIR])
+
+ dnl Check for a shared library version
+ AX_LIBISAL_CHECK_LIB
+
+ AS_IF(
+  [test "x$ac_cv_libisal_CPPFLAGS" != "x"],
+  [AC_SUBST(
+   [LIBISAL_CPPFLAGS],
+   [$ac_cv_libisal_CPPFLAGS])
+  ])
+ AS_IF(
+  [test "x$ac_cv_libisal_LIBADD" != "x"],
+  [AC_SUBST(
+   [LIBISAL_LIBADD],
+   [$ac_cv_libisal_LIBADD])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_libisal" = xlibisal],
+  [AC_SUBST(
+   [ax_libisal_pc_libs_private],
+   [-lisal])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_libisal" = xlibisal],
+  [AC_SUBST(
+   [ax_libisal_spec_requires],
+   [libisal])
+  AC_SUBST(
+   [ax_libisal_spec_build_requires],
+   [libisal-devel])
+  ])
+ ])
+
@@ -4,9 +4,9 @@ dnl Version: 20160821
 
 dnl Function to detect if tests dependencies are available
 AC_DEFUN([AX_TESTS_CHECK_LOCAL],
- [AC_CHECK_HEADERS([dlfcn.h])
+ [AC_CHECK_HEADERS([dlfcn.h utime.h])
 
- AC_CHECK_FUNCS([fmemopen])
+ AC_CHECK_FUNCS([fmemopen utime])
 
  AC_CHECK_LIB(
   dl,
@@ -112,6 +112,13 @@ PyMethodDef pyewf_handle_object_methods[] = {
 	  "\n"
 	  "Writes a buffer of media data at a specific offset." },
 
+	{ "set_write_number_of_threads",
+	  (PyCFunction) pyewf_handle_set_write_number_of_threads,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "set_write_number_of_threads(number_of_threads) -> None\n"
+	  "\n"
+	  "Sets the number of threads used to compress the chunks that are written." },
+
 	{ "seek_offset",
 	  (PyCFunction) pyewf_handle_seek_offset,
 	  METH_VARARGS | METH_KEYWORDS,
@@ -1710,6 +1717,66 @@ PyObject *pyewf_handle_write_buffer_at_offset(
 	return( Py_None );
 }
 
+/* Sets the number of threads used to compress the chunks that are written
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_handle_set_write_number_of_threads(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	libcerror_error_t *error    = NULL;
+	static char *function       = "pyewf_handle_set_write_number_of_threads";
+	static char *keyword_list[] = { "number_of_threads", NULL };
+	int number_of_threads       = 0;
+	int result                  = 0;
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid pyewf handle.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "i",
+	     keyword_list,
+	     &number_of_threads ) == 0 )
+	{
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libewf_handle_set_write_number_of_threads(
+	          pyewf_handle->handle,
+	          number_of_threads,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to set write number of threads.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 Py_None );
+
+	return( Py_None );
+}
+
 /* Seeks a certain offset in the media data
  * Returns a Python object holding the offset if successful or NULL on error
  */
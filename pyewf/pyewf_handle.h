@@ -112,6 +112,11 @@ PyObject *pyewf_handle_write_buffer_at_offset(
            PyObject *arguments,
            PyObject *keywords );
 
+PyObject *pyewf_handle_set_write_number_of_threads(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
 PyObject *pyewf_handle_seek_offset(
            pyewf_handle_t *pyewf_handle,
            PyObject *arguments,
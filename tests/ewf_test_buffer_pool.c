@@ -0,0 +1,730 @@
+/*
+ * Library buffer pool type testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+#include "../libewf/libewf_buffer_pool.h"
+#include "../libewf/libewf_definitions.h"
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_buffer_pool_initialize and libewf_buffer_pool_free functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_buffer_pool_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_buffer_pool_t *buffer_pool = NULL;
+	int result                        = 0;
+
+	result = libewf_buffer_pool_initialize(
+	          &buffer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer_pool",
+	 buffer_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffer_pool_free(
+	          &buffer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "buffer_pool",
+	 buffer_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_buffer_pool_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffer_pool_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer_pool != NULL )
+	{
+		libewf_buffer_pool_free(
+		 &buffer_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_buffer_pool_get_buffer and libewf_buffer_pool_release_buffer functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_buffer_pool_get_buffer(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_buffer_pool_t *buffer_pool = NULL;
+	uint8_t *buffer1                  = NULL;
+	uint8_t *buffer2                  = NULL;
+	uint8_t *reused_buffer            = NULL;
+	int result                        = 0;
+
+	result = libewf_buffer_pool_initialize(
+	          &buffer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_buffer_pool_set_values(
+	          buffer_pool,
+	          2 * 32832,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffer_pool_get_buffer(
+	          buffer_pool,
+	          32784,
+	          &buffer1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer1",
+	 buffer1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "buffer_pool->buffer_size",
+	 buffer_pool->buffer_size,
+	 (size_t) 32832 );
+
+	/* A buffer of a different size is not provided while buffers are in use
+	 */
+	result = libewf_buffer_pool_get_buffer(
+	          buffer_pool,
+	          65552,
+	          &buffer2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The buffer pool values cannot be changed while buffers are in use
+	 */
+	result = libewf_buffer_pool_set_values(
+	          buffer_pool,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The buffer pool cannot be emptied or freed while buffers are in use
+	 */
+	result = libewf_buffer_pool_empty(
+	          buffer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffer_pool_free(
+	          &buffer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer_pool",
+	 buffer_pool );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffer_pool_get_buffer(
+	          buffer_pool,
+	          32784,
+	          &buffer2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer2",
+	 buffer2 );
+
+	result = libewf_buffer_pool_release_buffer(
+	          buffer_pool,
+	          buffer2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A released buffer is reused
+	 */
+	result = libewf_buffer_pool_get_buffer(
+	          buffer_pool,
+	          32784,
+	          &reused_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "reused_buffer",
+	 (int) ( reused_buffer == buffer2 ),
+	 1 );
+
+	buffer2 = NULL;
+
+	result = libewf_buffer_pool_release_buffer(
+	          buffer_pool,
+	          reused_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_buffer_pool_release_buffer(
+	          buffer_pool,
+	          buffer1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	buffer1 = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer_pool->number_of_free_buffers",
+	 buffer_pool->number_of_free_buffers,
+	 2 );
+
+	/* A release without a buffer in use is an error
+	 */
+	result = libewf_buffer_pool_release_buffer(
+	          buffer_pool,
+	          reused_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* A maximum size of 0 disables the buffer pool
+	 */
+	result = libewf_buffer_pool_set_values(
+	          buffer_pool,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_buffer_pool_get_buffer(
+	          buffer_pool,
+	          32784,
+	          &buffer1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_buffer_pool_get_buffer(
+	          NULL,
+	          32784,
+	          &buffer1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffer_pool_get_buffer(
+	          buffer_pool,
+	          0,
+	          &buffer1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffer_pool_get_buffer(
+	          buffer_pool,
+	          32784,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffer_pool_free(
+	          &buffer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer_pool != NULL )
+	{
+		if( buffer2 != NULL )
+		{
+			libewf_buffer_pool_release_buffer(
+			 buffer_pool,
+			 buffer2,
+			 NULL );
+		}
+		if( buffer1 != NULL )
+		{
+			libewf_buffer_pool_release_buffer(
+			 buffer_pool,
+			 buffer1,
+			 NULL );
+		}
+		libewf_buffer_pool_free(
+		 &buffer_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_buffer_pool_set_arena function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_buffer_pool_set_arena(
+     void )
+{
+	uint8_t *buffers[ 3 ]             = { NULL, NULL, NULL };
+	libcerror_error_t *error          = NULL;
+	libewf_buffer_pool_t *buffer_pool = NULL;
+	uint8_t *arena                    = NULL;
+	size_t arena_size                 = ( 2 * 4096 ) + 64;
+	int buffer_index                  = 0;
+	int result                        = 0;
+
+	arena = (uint8_t *) malloc(
+	                     sizeof( uint8_t ) * arena_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "arena",
+	 arena );
+
+	result = libewf_buffer_pool_initialize(
+	          &buffer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_buffer_pool_set_arena(
+	          buffer_pool,
+	          arena,
+	          arena_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The first two buffers are carved from the arena the third is allocated from the heap
+	 */
+	for( buffer_index = 0;
+	     buffer_index < 3;
+	     buffer_index++ )
+	{
+		result = libewf_buffer_pool_get_buffer(
+		          buffer_pool,
+		          4096,
+		          &( buffers[ buffer_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "buffer alignment",
+		 (int) ( (intptr_t) buffers[ buffer_index ] % 16 ),
+		 0 );
+
+		memory_set(
+		 buffers[ buffer_index ],
+		 0xff,
+		 4096 );
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer_pool->number_of_arena_buffers",
+	 buffer_pool->number_of_arena_buffers,
+	 2 );
+
+	for( buffer_index = 0;
+	     buffer_index < 3;
+	     buffer_index++ )
+	{
+		result = ( buffers[ buffer_index ] >= arena )
+		      && ( buffers[ buffer_index ] < &( arena[ arena_size ] ) );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "buffer in arena",
+		 result,
+		 (int) ( buffer_index < 2 ) );
+	}
+	/* The arena cannot be changed while buffers are in use
+	 */
+	result = libewf_buffer_pool_set_arena(
+	          buffer_pool,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	for( buffer_index = 0;
+	     buffer_index < 3;
+	     buffer_index++ )
+	{
+		result = libewf_buffer_pool_release_buffer(
+		          buffer_pool,
+		          buffers[ buffer_index ],
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		buffers[ buffer_index ] = NULL;
+	}
+	result = libewf_buffer_pool_free(
+	          &buffer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_buffer_pool_set_arena(
+	          NULL,
+	          arena,
+	          arena_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	free(
+	 arena );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer_pool != NULL )
+	{
+		for( buffer_index = 0;
+		     buffer_index < 3;
+		     buffer_index++ )
+		{
+			if( buffers[ buffer_index ] != NULL )
+			{
+				libewf_buffer_pool_release_buffer(
+				 buffer_pool,
+				 buffers[ buffer_index ],
+				 NULL );
+			}
+		}
+		libewf_buffer_pool_free(
+		 &buffer_pool,
+		 NULL );
+	}
+	if( arena != NULL )
+	{
+		free(
+		 arena );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_buffer_pool_initialize",
+	 ewf_test_buffer_pool_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_buffer_pool_get_buffer",
+	 ewf_test_buffer_pool_get_buffer );
+
+	EWF_TEST_RUN(
+	 "libewf_buffer_pool_set_arena",
+	 ewf_test_buffer_pool_set_arena );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,368 @@
+/*
+ * Library checksum functions testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+#include "../libewf/libewf_checksum.h"
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* The buffer sizes to test, these cover the SIMD block size, the modulo interval
+ * of 5552 bytes and common chunk sizes
+ */
+size_t ewf_test_checksum_buffer_sizes[ 20 ] = {
+	0, 1, 15, 16, 31, 32, 33, 63, 64, 65, 5551, 5552, 5553, 11104, 11137, 32768, 32769, 65536, 65557, 262144 };
+
+/* The initial values to test
+ */
+uint32_t ewf_test_checksum_initial_values[ 2 ] = {
+	0x00000001UL, 0xfff0fff0UL };
+
+/* Fills a buffer with pseudo random data
+ */
+void ewf_test_checksum_fill_buffer(
+      uint8_t *buffer,
+      size_t buffer_size,
+      uint32_t seed )
+{
+	size_t buffer_offset = 0;
+
+	for( buffer_offset = 0;
+	     buffer_offset < buffer_size;
+	     buffer_offset++ )
+	{
+		seed = ( seed * 1103515245UL ) + 12345;
+
+		buffer[ buffer_offset ] = (uint8_t) ( seed >> 16 );
+	}
+}
+
+/* Calculates the reference Adler-32 of a buffer
+ * Returns the Adler-32
+ */
+uint32_t ewf_test_checksum_calculate_reference_adler32(
+          const uint8_t *buffer,
+          size_t size,
+          uint32_t initial_value )
+{
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	return( (uint32_t) adler32(
+	                    (uLong) initial_value,
+	                    (const Bytef *) buffer,
+	                    (uInt) size ) );
+#else
+	size_t buffer_offset = 0;
+	uint32_t lower_word  = initial_value & 0xffff;
+	uint32_t upper_word  = ( initial_value >> 16 ) & 0xffff;
+
+	for( buffer_offset = 0;
+	     buffer_offset < size;
+	     buffer_offset++ )
+	{
+		lower_word = ( lower_word + buffer[ buffer_offset ] ) % 65521;
+		upper_word = ( upper_word + lower_word ) % 65521;
+	}
+	return( ( upper_word << 16 ) | lower_word );
+#endif
+}
+
+/* Tests the libewf_checksum_calculate_adler32 function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_calculate_adler32(
+     void )
+{
+	uint8_t *buffer          = NULL;
+	libcerror_error_t *error = NULL;
+	size_t buffer_size       = 262144 + 32;
+	size_t size              = 0;
+	uint32_t checksum_value  = 0;
+	uint32_t expected_value  = 0;
+	uint32_t initial_value   = 0;
+	int buffer_offset        = 0;
+	int initial_value_index  = 0;
+	int result               = 0;
+	int size_index           = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_checksum_calculate_adler32(
+	          &checksum_value,
+	          (uint8_t *) "Wikipedia",
+	          9,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum_value",
+	 checksum_value,
+	 (uint32_t) 0x11e60398UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	buffer = (uint8_t *) malloc(
+	                      sizeof( uint8_t ) * buffer_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	/* Test random data, data with the maximum byte value and unaligned buffers
+	 */
+	for( initial_value_index = 0;
+	     initial_value_index < 2;
+	     initial_value_index++ )
+	{
+		initial_value = ewf_test_checksum_initial_values[ initial_value_index ];
+
+		ewf_test_checksum_fill_buffer(
+		 buffer,
+		 buffer_size,
+		 initial_value );
+
+		for( size_index = 0;
+		     size_index < 20;
+		     size_index++ )
+		{
+			for( buffer_offset = 0;
+			     buffer_offset < 4;
+			     buffer_offset++ )
+			{
+				size = ewf_test_checksum_buffer_sizes[ size_index ];
+
+				expected_value = ewf_test_checksum_calculate_reference_adler32(
+				                  &( buffer[ buffer_offset ] ),
+				                  size,
+				                  initial_value );
+
+				result = libewf_checksum_calculate_adler32(
+				          &checksum_value,
+				          &( buffer[ buffer_offset ] ),
+				          size,
+				          initial_value,
+				          &error );
+
+				EWF_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				EWF_TEST_ASSERT_EQUAL_UINT32(
+				 "checksum_value",
+				 checksum_value,
+				 expected_value );
+
+				EWF_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				checksum_value = libewf_checksum_calculate_adler32_scalar(
+				                  &( buffer[ buffer_offset ] ),
+				                  size,
+				                  initial_value );
+
+				EWF_TEST_ASSERT_EQUAL_UINT32(
+				 "checksum_value",
+				 checksum_value,
+				 expected_value );
+
+#if defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD )
+				if( __builtin_cpu_supports( "sse2" ) )
+				{
+					checksum_value = libewf_checksum_calculate_adler32_sse2(
+					                  &( buffer[ buffer_offset ] ),
+					                  size,
+					                  initial_value );
+
+					EWF_TEST_ASSERT_EQUAL_UINT32(
+					 "checksum_value",
+					 checksum_value,
+					 expected_value );
+				}
+				if( __builtin_cpu_supports( "ssse3" ) )
+				{
+					checksum_value = libewf_checksum_calculate_adler32_ssse3(
+					                  &( buffer[ buffer_offset ] ),
+					                  size,
+					                  initial_value );
+
+					EWF_TEST_ASSERT_EQUAL_UINT32(
+					 "checksum_value",
+					 checksum_value,
+					 expected_value );
+				}
+				if( __builtin_cpu_supports( "avx2" ) )
+				{
+					checksum_value = libewf_checksum_calculate_adler32_avx2(
+					                  &( buffer[ buffer_offset ] ),
+					                  size,
+					                  initial_value );
+
+					EWF_TEST_ASSERT_EQUAL_UINT32(
+					 "checksum_value",
+					 checksum_value,
+					 expected_value );
+				}
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD ) */
+			}
+		}
+		memory_set(
+		 buffer,
+		 0xff,
+		 buffer_size );
+
+		result = libewf_checksum_calculate_adler32(
+		          &checksum_value,
+		          buffer,
+		          buffer_size,
+		          initial_value,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		expected_value = ewf_test_checksum_calculate_reference_adler32(
+		                  buffer,
+		                  buffer_size,
+		                  initial_value );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "checksum_value",
+		 checksum_value,
+		 expected_value );
+	}
+	/* Test error cases
+	 */
+	result = libewf_checksum_calculate_adler32(
+	          NULL,
+	          buffer,
+	          buffer_size,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_checksum_calculate_adler32(
+	          &checksum_value,
+	          NULL,
+	          buffer_size,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer != NULL )
+	{
+		free(
+		 buffer );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_checksum_calculate_adler32",
+	 ewf_test_checksum_calculate_adler32 );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
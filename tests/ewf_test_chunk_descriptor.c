@@ -0,0 +1,867 @@
+/*
+ * Library chunk descriptor functions testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_image.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#define EWF_TEST_CHUNK_DESCRIPTOR_FILENAME		"ewf_test_chunk_descriptor"
+
+/* The last chunk of the image is smaller than the chunk size
+ */
+#define EWF_TEST_CHUNK_DESCRIPTOR_NUMBER_OF_CHUNKS	14
+#define EWF_TEST_CHUNK_DESCRIPTOR_MEDIA_SIZE		( ( 13 * EWF_TEST_IMAGE_CHUNK_SIZE ) + 4096 )
+
+/* Writes the test image and opens it
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_descriptor_open_image(
+     libewf_handle_t **handle,
+     uint8_t format )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *media_data      = NULL;
+	int result               = 0;
+
+	media_data = (uint8_t *) memory_allocate(
+	                          EWF_TEST_CHUNK_DESCRIPTOR_MEDIA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "media_data",
+	 media_data );
+
+	result = ewf_test_image_generate_media_data(
+	          media_data,
+	          EWF_TEST_CHUNK_DESCRIPTOR_MEDIA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Empty-block compression stores the empty chunks as compressed
+	 * empty blocks in EWF version 1 and as pattern fills in EWF version 2
+	 */
+	result = ewf_test_image_write(
+	          EWF_TEST_CHUNK_DESCRIPTOR_FILENAME,
+	          format,
+	          media_data,
+	          EWF_TEST_CHUNK_DESCRIPTOR_MEDIA_SIZE,
+	          0,
+	          LIBEWF_COMPRESSION_FAST,
+	          LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	memory_free(
+	 media_data );
+
+	media_data = NULL;
+
+	result = libewf_handle_initialize(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_image_open(
+	          *handle,
+	          EWF_TEST_CHUNK_DESCRIPTOR_FILENAME,
+	          format,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( media_data != NULL )
+	{
+		memory_free(
+		 media_data );
+	}
+	return( 0 );
+}
+
+/* Closes the test image and removes it
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_descriptor_close_image(
+     libewf_handle_t **handle,
+     uint8_t format )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	result = libewf_handle_close(
+	          *handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_handle_free(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_image_remove(
+	          EWF_TEST_CHUNK_DESCRIPTOR_FILENAME,
+	          format,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Checks the chunk flags of a specific chunk in the test image
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_descriptor_check_chunk_flags(
+     uint64_t chunk_index,
+     uint8_t format,
+     uint32_t chunk_flags )
+{
+	int result = 0;
+
+	/* Sparse chunks are not written by the library
+	 */
+	result = ( chunk_flags & ( LIBEWF_CHUNK_FLAG_IS_SPARSE | LIBEWF_CHUNK_FLAG_IS_CORRUPTED ) ) != 0;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk is sparse or corrupted",
+	 result,
+	 0 );
+
+	switch( ewf_test_image_get_chunk_type(
+	         chunk_index ) )
+	{
+		case EWF_TEST_IMAGE_CHUNK_TYPE_EMPTY_BLOCK:
+			result = ( chunk_flags & LIBEWF_CHUNK_FLAG_IS_COMPRESSED ) != 0;
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "chunk is compressed",
+			 result,
+			 1 );
+
+			result = ( chunk_flags & LIBEWF_CHUNK_FLAG_USES_PATTERN_FILL ) != 0;
+
+			if( format == LIBEWF_FORMAT_V2_ENCASE7 )
+			{
+				EWF_TEST_ASSERT_EQUAL_INT(
+				 "chunk uses pattern fill",
+				 result,
+				 1 );
+			}
+			else
+			{
+				EWF_TEST_ASSERT_EQUAL_INT(
+				 "chunk uses pattern fill",
+				 result,
+				 0 );
+			}
+			break;
+
+		case EWF_TEST_IMAGE_CHUNK_TYPE_TEXT:
+		case EWF_TEST_IMAGE_CHUNK_TYPE_PATTERN_FILL:
+			result = ( chunk_flags & LIBEWF_CHUNK_FLAG_IS_COMPRESSED ) != 0;
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "chunk is compressed",
+			 result,
+			 1 );
+
+			break;
+
+		case EWF_TEST_IMAGE_CHUNK_TYPE_RANDOM:
+			result = ( chunk_flags & ( LIBEWF_CHUNK_FLAG_IS_COMPRESSED | LIBEWF_CHUNK_FLAG_USES_PATTERN_FILL ) ) != 0;
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "chunk is compressed",
+			 result,
+			 0 );
+
+			result = ( chunk_flags & LIBEWF_CHUNK_FLAG_HAS_CHECKSUM ) != 0;
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "chunk has checksum",
+			 result,
+			 1 );
+
+			break;
+	}
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_chunk_descriptor function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_chunk_descriptor(
+     uint8_t format )
+{
+	libcerror_error_t *error  = NULL;
+	libewf_handle_t *handle   = NULL;
+	off64_t chunk_data_offset = 0;
+	size64_t chunk_data_size  = 0;
+	uint64_t chunk_index      = 0;
+	uint32_t chunk_flags      = 0;
+	uint32_t segment_number   = 0;
+	int result                = 0;
+
+	result = ewf_test_chunk_descriptor_open_image(
+	          &handle,
+	          format );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases including the last chunk
+	 */
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_CHUNK_DESCRIPTOR_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		result = libewf_handle_get_chunk_descriptor(
+		          handle,
+		          chunk_index,
+		          &segment_number,
+		          &chunk_data_offset,
+		          &chunk_data_size,
+		          &chunk_flags,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "segment_number",
+		 segment_number,
+		 1 );
+
+		result = ewf_test_chunk_descriptor_check_chunk_flags(
+		          chunk_index,
+		          format,
+		          chunk_flags );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		/* The chunk data of a pattern fill chunk is stored in the table entry
+		 */
+		if( ( chunk_flags & LIBEWF_CHUNK_FLAG_USES_PATTERN_FILL ) == 0 )
+		{
+			result = ( chunk_data_offset > 0 ) && ( chunk_data_size > 0 );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "chunk data is stored",
+			 result,
+			 1 );
+		}
+		if( ewf_test_image_get_chunk_type(
+		     chunk_index ) == EWF_TEST_IMAGE_CHUNK_TYPE_TEXT )
+		{
+			EWF_TEST_ASSERT_LESS_THAN_UINT64(
+			 "chunk_data_size",
+			 (uint64_t) chunk_data_size,
+			 (uint64_t) EWF_TEST_IMAGE_CHUNK_SIZE );
+		}
+	}
+	/* Test error cases
+	 */
+	result = libewf_handle_get_chunk_descriptor(
+	          handle,
+	          EWF_TEST_CHUNK_DESCRIPTOR_NUMBER_OF_CHUNKS,
+	          &segment_number,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &chunk_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_descriptor(
+	          NULL,
+	          0,
+	          &segment_number,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &chunk_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_descriptor(
+	          handle,
+	          0,
+	          NULL,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &chunk_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_descriptor(
+	          handle,
+	          0,
+	          &segment_number,
+	          NULL,
+	          &chunk_data_size,
+	          &chunk_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_descriptor(
+	          handle,
+	          0,
+	          &segment_number,
+	          &chunk_data_offset,
+	          NULL,
+	          &chunk_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_descriptor(
+	          handle,
+	          0,
+	          &segment_number,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = ewf_test_chunk_descriptor_close_image(
+	          &handle,
+	          format );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	ewf_test_image_remove(
+	 EWF_TEST_CHUNK_DESCRIPTOR_FILENAME,
+	 format,
+	 NULL );
+
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_chunk_descriptors function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_chunk_descriptors(
+     uint8_t format )
+{
+	off64_t chunk_data_offsets[ EWF_TEST_CHUNK_DESCRIPTOR_NUMBER_OF_CHUNKS + 4 ];
+	size64_t chunk_data_sizes[ EWF_TEST_CHUNK_DESCRIPTOR_NUMBER_OF_CHUNKS + 4 ];
+	uint32_t chunk_flags[ EWF_TEST_CHUNK_DESCRIPTOR_NUMBER_OF_CHUNKS + 4 ];
+	uint32_t segment_numbers[ EWF_TEST_CHUNK_DESCRIPTOR_NUMBER_OF_CHUNKS + 4 ];
+
+	libcerror_error_t *error        = NULL;
+	libewf_handle_t *handle         = NULL;
+	off64_t chunk_data_offset       = 0;
+	size64_t chunk_data_size        = 0;
+	ssize_t number_of_descriptors   = 0;
+	uint64_t chunk_index            = 0;
+	uint32_t single_chunk_flags     = 0;
+	uint32_t segment_number         = 0;
+	int result                      = 0;
+
+	result = ewf_test_chunk_descriptor_open_image(
+	          &handle,
+	          format );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test retrieving the descriptors of all chunks
+	 * the number of descriptors is limited to the number of chunks
+	 */
+	number_of_descriptors = libewf_handle_get_chunk_descriptors(
+	                         handle,
+	                         0,
+	                         segment_numbers,
+	                         chunk_data_offsets,
+	                         chunk_data_sizes,
+	                         chunk_flags,
+	                         EWF_TEST_CHUNK_DESCRIPTOR_NUMBER_OF_CHUNKS + 4,
+	                         &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "number_of_descriptors",
+	 number_of_descriptors,
+	 (ssize_t) EWF_TEST_CHUNK_DESCRIPTOR_NUMBER_OF_CHUNKS );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The descriptors match the descriptors of the individual chunks
+	 */
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_CHUNK_DESCRIPTOR_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		result = libewf_handle_get_chunk_descriptor(
+		          handle,
+		          chunk_index,
+		          &segment_number,
+		          &chunk_data_offset,
+		          &chunk_data_size,
+		          &single_chunk_flags,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "segment_numbers[ chunk_index ]",
+		 segment_numbers[ chunk_index ],
+		 segment_number );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "chunk_data_offsets[ chunk_index ]",
+		 (int64_t) chunk_data_offsets[ chunk_index ],
+		 (int64_t) chunk_data_offset );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "chunk_data_sizes[ chunk_index ]",
+		 (uint64_t) chunk_data_sizes[ chunk_index ],
+		 (uint64_t) chunk_data_size );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "chunk_flags[ chunk_index ]",
+		 chunk_flags[ chunk_index ],
+		 single_chunk_flags );
+
+		result = ewf_test_chunk_descriptor_check_chunk_flags(
+		          chunk_index,
+		          format,
+		          chunk_flags[ chunk_index ] );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	/* Test retrieving the descriptors up to and including the last chunk
+	 */
+	number_of_descriptors = libewf_handle_get_chunk_descriptors(
+	                         handle,
+	                         EWF_TEST_CHUNK_DESCRIPTOR_NUMBER_OF_CHUNKS - 2,
+	                         segment_numbers,
+	                         chunk_data_offsets,
+	                         chunk_data_sizes,
+	                         chunk_flags,
+	                         4,
+	                         &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "number_of_descriptors",
+	 number_of_descriptors,
+	 (ssize_t) 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test retrieving the descriptors beyond the last chunk
+	 */
+	number_of_descriptors = libewf_handle_get_chunk_descriptors(
+	                         handle,
+	                         EWF_TEST_CHUNK_DESCRIPTOR_NUMBER_OF_CHUNKS,
+	                         segment_numbers,
+	                         chunk_data_offsets,
+	                         chunk_data_sizes,
+	                         chunk_flags,
+	                         4,
+	                         &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "number_of_descriptors",
+	 number_of_descriptors,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	number_of_descriptors = libewf_handle_get_chunk_descriptors(
+	                         NULL,
+	                         0,
+	                         segment_numbers,
+	                         chunk_data_offsets,
+	                         chunk_data_sizes,
+	                         chunk_flags,
+	                         4,
+	                         &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "number_of_descriptors",
+	 number_of_descriptors,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	number_of_descriptors = libewf_handle_get_chunk_descriptors(
+	                         handle,
+	                         0,
+	                         NULL,
+	                         chunk_data_offsets,
+	                         chunk_data_sizes,
+	                         chunk_flags,
+	                         4,
+	                         &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "number_of_descriptors",
+	 number_of_descriptors,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	number_of_descriptors = libewf_handle_get_chunk_descriptors(
+	                         handle,
+	                         0,
+	                         segment_numbers,
+	                         NULL,
+	                         chunk_data_sizes,
+	                         chunk_flags,
+	                         4,
+	                         &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "number_of_descriptors",
+	 number_of_descriptors,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	number_of_descriptors = libewf_handle_get_chunk_descriptors(
+	                         handle,
+	                         0,
+	                         segment_numbers,
+	                         chunk_data_offsets,
+	                         NULL,
+	                         chunk_flags,
+	                         4,
+	                         &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "number_of_descriptors",
+	 number_of_descriptors,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	number_of_descriptors = libewf_handle_get_chunk_descriptors(
+	                         handle,
+	                         0,
+	                         segment_numbers,
+	                         chunk_data_offsets,
+	                         chunk_data_sizes,
+	                         NULL,
+	                         4,
+	                         &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "number_of_descriptors",
+	 number_of_descriptors,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	number_of_descriptors = libewf_handle_get_chunk_descriptors(
+	                         handle,
+	                         0,
+	                         segment_numbers,
+	                         chunk_data_offsets,
+	                         chunk_data_sizes,
+	                         chunk_flags,
+	                         (size_t) SSIZE_MAX + 1,
+	                         &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "number_of_descriptors",
+	 number_of_descriptors,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = ewf_test_chunk_descriptor_close_image(
+	          &handle,
+	          format );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	ewf_test_image_remove(
+	 EWF_TEST_CHUNK_DESCRIPTOR_FILENAME,
+	 format,
+	 NULL );
+
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN_WITH_ARGS(
+	 "libewf_handle_get_chunk_descriptor (EWF version 1)",
+	 ewf_test_handle_get_chunk_descriptor,
+	 LIBEWF_FORMAT_ENCASE6 );
+
+	EWF_TEST_RUN_WITH_ARGS(
+	 "libewf_handle_get_chunk_descriptor (EWF version 2)",
+	 ewf_test_handle_get_chunk_descriptor,
+	 LIBEWF_FORMAT_V2_ENCASE7 );
+
+	EWF_TEST_RUN_WITH_ARGS(
+	 "libewf_handle_get_chunk_descriptors (EWF version 1)",
+	 ewf_test_handle_get_chunk_descriptors,
+	 LIBEWF_FORMAT_ENCASE6 );
+
+	EWF_TEST_RUN_WITH_ARGS(
+	 "libewf_handle_get_chunk_descriptors (EWF version 2)",
+	 ewf_test_handle_get_chunk_descriptors,
+	 LIBEWF_FORMAT_V2_ENCASE7 );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
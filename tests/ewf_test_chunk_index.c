@@ -0,0 +1,622 @@
+/*
+ * Library chunk index testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UTIME_H )
+#include <utime.h>
+#endif
+
+#include "ewf_test_image.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#define EWF_TEST_CHUNK_INDEX_FILENAME		"ewf_test_chunk_index"
+#define EWF_TEST_CHUNK_INDEX_SEGMENT_FILENAME	"ewf_test_chunk_index.E01"
+#define EWF_TEST_CHUNK_INDEX_COPY_FILENAME	"ewf_test_chunk_index.tmp"
+#define EWF_TEST_CHUNK_INDEX_INDEX_FILENAME	"ewf_test_chunk_index.ewfidx"
+
+#define EWF_TEST_CHUNK_INDEX_MEDIA_SIZE		( 4 * EWF_TEST_IMAGE_CHUNK_SIZE )
+
+#if defined( HAVE_SYS_STAT_H ) && defined( HAVE_UTIME_H ) && defined( HAVE_UTIME ) && !defined( WINAPI )
+
+/* Reads the data of a file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_chunk_index_read_file(
+     const char *filename,
+     uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	FILE *file_stream     = NULL;
+	static char *function = "ewf_test_chunk_index_read_file";
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( stat(
+	     filename,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file statistics of: %s.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	if( ( file_statistics.st_size <= 0 )
+	 || ( (size64_t) file_statistics.st_size > (size64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*data_size = (size_t) file_statistics.st_size;
+
+	*data = (uint8_t *) memory_allocate(
+	                     *data_size );
+
+	if( *data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	file_stream = file_stream_open(
+	               filename,
+	               "rb" );
+
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( file_stream_read(
+	     file_stream,
+	     *data,
+	     *data_size ) != *data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close: %s.",
+		 function,
+		 filename );
+
+		file_stream = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	if( *data != NULL )
+	{
+		memory_free(
+		 *data );
+
+		*data = NULL;
+	}
+	return( -1 );
+}
+
+/* Writes the data of a file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_chunk_index_write_file(
+     const char *filename,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	FILE *file_stream     = NULL;
+	static char *function = "ewf_test_chunk_index_write_file";
+
+	file_stream = file_stream_open(
+	               filename,
+	               "wb" );
+
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open: %s.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	if( file_stream_write(
+	     file_stream,
+	     data,
+	     data_size ) != data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data.",
+		 function );
+
+		file_stream_close(
+		 file_stream );
+
+		return( -1 );
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close: %s.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the test image using the chunk index and reads the media data
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_index_open_read(
+     const uint8_t *media_data )
+{
+	uint8_t read_data[ EWF_TEST_CHUNK_INDEX_MEDIA_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	libewf_handle_t *handle  = NULL;
+	ssize_t read_count       = 0;
+	int result               = 0;
+
+	result = libewf_handle_initialize(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_set_chunk_index_filename(
+	          handle,
+	          EWF_TEST_CHUNK_INDEX_INDEX_FILENAME,
+	          narrow_string_length(
+	           EWF_TEST_CHUNK_INDEX_INDEX_FILENAME ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_image_open(
+	          handle,
+	          EWF_TEST_CHUNK_INDEX_FILENAME,
+	          LIBEWF_FORMAT_ENCASE6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	read_count = libewf_handle_read_buffer(
+	              handle,
+	              read_data,
+	              EWF_TEST_CHUNK_INDEX_MEDIA_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) EWF_TEST_CHUNK_INDEX_MEDIA_SIZE );
+
+	result = memory_compare(
+	          read_data,
+	          media_data,
+	          EWF_TEST_CHUNK_INDEX_MEDIA_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests that the chunk index is rejected after a segment file was rewritten
+ * with the same size within the same second
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_index_rewritten_segment(
+     void )
+{
+	uint8_t media_data[ EWF_TEST_CHUNK_INDEX_MEDIA_SIZE ];
+
+	struct stat file_statistics;
+	struct utimbuf file_times;
+
+	libcerror_error_t *error           = NULL;
+	uint8_t *chunk_index_data          = NULL;
+	uint8_t *segment_data              = NULL;
+	uint8_t *stale_chunk_index_data    = NULL;
+	size_t chunk_index_data_size       = 0;
+	size_t segment_data_size           = 0;
+	size_t stale_chunk_index_data_size = 0;
+	int result                         = 0;
+
+	result = ewf_test_image_generate_media_data(
+	          media_data,
+	          EWF_TEST_CHUNK_INDEX_MEDIA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_image_write(
+	          EWF_TEST_CHUNK_INDEX_FILENAME,
+	          LIBEWF_FORMAT_ENCASE6,
+	          media_data,
+	          EWF_TEST_CHUNK_INDEX_MEDIA_SIZE,
+	          0,
+	          LIBEWF_COMPRESSION_NONE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* The chunk index is written when the image is first opened
+	 */
+	result = ewf_test_chunk_index_open_read(
+	          media_data );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_chunk_index_read_file(
+	          EWF_TEST_CHUNK_INDEX_INDEX_FILENAME,
+	          &stale_chunk_index_data,
+	          &stale_chunk_index_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Rewrite the segment file with the same size and modification time in seconds
+	 */
+	result = stat(
+	          EWF_TEST_CHUNK_INDEX_SEGMENT_FILENAME,
+	          &file_statistics );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = ewf_test_chunk_index_read_file(
+	          EWF_TEST_CHUNK_INDEX_SEGMENT_FILENAME,
+	          &segment_data,
+	          &segment_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_chunk_index_write_file(
+	          EWF_TEST_CHUNK_INDEX_COPY_FILENAME,
+	          segment_data,
+	          segment_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	memory_free(
+	 segment_data );
+
+	segment_data = NULL;
+
+	result = rename(
+	          EWF_TEST_CHUNK_INDEX_COPY_FILENAME,
+	          EWF_TEST_CHUNK_INDEX_SEGMENT_FILENAME );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	file_times.actime  = file_statistics.st_atime;
+	file_times.modtime = file_statistics.st_mtime;
+
+	result = utime(
+	          EWF_TEST_CHUNK_INDEX_SEGMENT_FILENAME,
+	          &file_times );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* The stale chunk index must not be used and is rewritten
+	 */
+	result = ewf_test_chunk_index_open_read(
+	          media_data );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_chunk_index_read_file(
+	          EWF_TEST_CHUNK_INDEX_INDEX_FILENAME,
+	          &chunk_index_data,
+	          &chunk_index_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_index_data_size",
+	 chunk_index_data_size,
+	 stale_chunk_index_data_size );
+
+	result = memory_compare(
+	          chunk_index_data,
+	          stale_chunk_index_data,
+	          chunk_index_data_size );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	memory_free(
+	 chunk_index_data );
+
+	chunk_index_data = NULL;
+
+	memory_free(
+	 stale_chunk_index_data );
+
+	stale_chunk_index_data = NULL;
+
+	result = remove(
+	          EWF_TEST_CHUNK_INDEX_INDEX_FILENAME );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = ewf_test_image_remove(
+	          EWF_TEST_CHUNK_INDEX_FILENAME,
+	          LIBEWF_FORMAT_ENCASE6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_index_data != NULL )
+	{
+		memory_free(
+		 chunk_index_data );
+	}
+	if( stale_chunk_index_data != NULL )
+	{
+		memory_free(
+		 stale_chunk_index_data );
+	}
+	if( segment_data != NULL )
+	{
+		memory_free(
+		 segment_data );
+	}
+	remove(
+	 EWF_TEST_CHUNK_INDEX_COPY_FILENAME );
+	remove(
+	 EWF_TEST_CHUNK_INDEX_INDEX_FILENAME );
+
+	ewf_test_image_remove(
+	 EWF_TEST_CHUNK_INDEX_FILENAME,
+	 LIBEWF_FORMAT_ENCASE6,
+	 NULL );
+
+	return( 0 );
+}
+
+#endif /* defined( HAVE_SYS_STAT_H ) && defined( HAVE_UTIME_H ) && defined( HAVE_UTIME ) && !defined( WINAPI ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_SYS_STAT_H ) && defined( HAVE_UTIME_H ) && defined( HAVE_UTIME ) && !defined( WINAPI )
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_index_rewritten_segment",
+	 ewf_test_chunk_index_rewritten_segment );
+
+#endif /* defined( HAVE_SYS_STAT_H ) && defined( HAVE_UTIME_H ) && defined( HAVE_UTIME ) && !defined( WINAPI ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
@@ -0,0 +1,801 @@
+/*
+ * Library coalesced read buffer type testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+#include "../libewf/libewf_coalesced_read_buffer.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_libbfio.h"
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+#define EWF_TEST_COALESCED_READ_FILE_NAME	"ewf_test_coalesced_read_buffer.raw"
+
+/* The size of a coalesced read used by the tests, coalesced reads are disabled by default
+ */
+#define EWF_TEST_COALESCED_READ_SIZE		( 4 * 1024 * 1024 )
+
+/* The size of a chunk and of the test file
+ */
+#define EWF_TEST_COALESCED_READ_CHUNK_SIZE	512
+#define EWF_TEST_COALESCED_READ_DATA_SIZE	( 16 * EWF_TEST_COALESCED_READ_CHUNK_SIZE )
+
+/* Tests the libewf_coalesced_read_buffer_initialize and libewf_coalesced_read_buffer_free functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_coalesced_read_buffer_initialize(
+     void )
+{
+	libcerror_error_t *error                              = NULL;
+	libewf_coalesced_read_buffer_t *coalesced_read_buffer = NULL;
+	int result                                            = 0;
+
+	result = libewf_coalesced_read_buffer_initialize(
+	          &coalesced_read_buffer,
+	          EWF_TEST_COALESCED_READ_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "coalesced_read_buffer",
+	 coalesced_read_buffer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The data is allocated when it is first read
+	 */
+	EWF_TEST_ASSERT_IS_NULL(
+	 "coalesced_read_buffer->data",
+	 coalesced_read_buffer->data );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "coalesced_read_buffer->maximum_data_size",
+	 coalesced_read_buffer->maximum_data_size,
+	 (size_t) EWF_TEST_COALESCED_READ_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "coalesced_read_buffer->file_io_pool_entry",
+	 coalesced_read_buffer->file_io_pool_entry,
+	 -1 );
+
+	result = libewf_coalesced_read_buffer_free(
+	          &coalesced_read_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "coalesced_read_buffer",
+	 coalesced_read_buffer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_coalesced_read_buffer_initialize(
+	          NULL,
+	          EWF_TEST_COALESCED_READ_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_coalesced_read_buffer_initialize(
+	          &coalesced_read_buffer,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_coalesced_read_buffer_initialize(
+	          &coalesced_read_buffer,
+	          (size_t) LIBEWF_MAXIMUM_COALESCED_READ_SIZE + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_coalesced_read_buffer_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( coalesced_read_buffer != NULL )
+	{
+		libewf_coalesced_read_buffer_free(
+		 &coalesced_read_buffer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_coalesced_read_buffer_clear function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_coalesced_read_buffer_clear(
+     void )
+{
+	libcerror_error_t *error                              = NULL;
+	libewf_coalesced_read_buffer_t *coalesced_read_buffer = NULL;
+	int result                                            = 0;
+
+	result = libewf_coalesced_read_buffer_initialize(
+	          &coalesced_read_buffer,
+	          EWF_TEST_COALESCED_READ_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	coalesced_read_buffer->data_size          = 512;
+	coalesced_read_buffer->file_io_pool_entry = 1;
+	coalesced_read_buffer->data_offset        = 1024;
+
+	result = libewf_coalesced_read_buffer_clear(
+	          coalesced_read_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "coalesced_read_buffer->data_size",
+	 coalesced_read_buffer->data_size,
+	 (size_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "coalesced_read_buffer->file_io_pool_entry",
+	 coalesced_read_buffer->file_io_pool_entry,
+	 -1 );
+
+	/* Test error cases
+	 */
+	result = libewf_coalesced_read_buffer_clear(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_coalesced_read_buffer_free(
+	          &coalesced_read_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( coalesced_read_buffer != NULL )
+	{
+		libewf_coalesced_read_buffer_free(
+		 &coalesced_read_buffer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_coalesced_read_buffer_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_coalesced_read_buffer_read_buffer_at_offset(
+     void )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error                              = NULL;
+	libewf_coalesced_read_buffer_t *coalesced_read_buffer = NULL;
+	ssize_t read_count                                    = 0;
+	int result                                            = 0;
+
+	result = libewf_coalesced_read_buffer_initialize(
+	          &coalesced_read_buffer,
+	          EWF_TEST_COALESCED_READ_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* An empty buffer is read without accessing the file IO pool
+	 */
+	read_count = libewf_coalesced_read_buffer_read_buffer_at_offset(
+	              coalesced_read_buffer,
+	              NULL,
+	              0,
+	              buffer,
+	              0,
+	              0,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libewf_coalesced_read_buffer_read_buffer_at_offset(
+	              NULL,
+	              NULL,
+	              0,
+	              buffer,
+	              16,
+	              0,
+	              16,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_coalesced_read_buffer_read_buffer_at_offset(
+	              coalesced_read_buffer,
+	              NULL,
+	              0,
+	              NULL,
+	              16,
+	              0,
+	              16,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_coalesced_read_buffer_read_buffer_at_offset(
+	              coalesced_read_buffer,
+	              NULL,
+	              0,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              16,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_coalesced_read_buffer_read_buffer_at_offset(
+	              coalesced_read_buffer,
+	              NULL,
+	              0,
+	              buffer,
+	              16,
+	              -1,
+	              16,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_coalesced_read_buffer_free(
+	          &coalesced_read_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( coalesced_read_buffer != NULL )
+	{
+		libewf_coalesced_read_buffer_free(
+		 &coalesced_read_buffer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests that the libewf_coalesced_read_buffer_read_buffer_at_offset function
+ * only reads more than the buffer when the buffer directly follows the previous read
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_coalesced_read_buffer_read_sequential(
+     void )
+{
+	uint8_t buffer[ EWF_TEST_COALESCED_READ_CHUNK_SIZE ];
+	uint8_t data[ EWF_TEST_COALESCED_READ_DATA_SIZE ];
+
+	libbfio_handle_t *file_io_handle                      = NULL;
+	libbfio_pool_t *file_io_pool                          = NULL;
+	libcerror_error_t *error                              = NULL;
+	libewf_coalesced_read_buffer_t *coalesced_read_buffer = NULL;
+	FILE *file_stream                                     = NULL;
+	size_t data_index                                     = 0;
+	size_t write_count                                    = 0;
+	ssize_t read_count                                    = 0;
+	int file_io_pool_entry                                = 0;
+	int result                                            = 0;
+
+	for( data_index = 0;
+	     data_index < EWF_TEST_COALESCED_READ_DATA_SIZE;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) ( data_index % 251 );
+	}
+	file_stream = file_stream_open(
+	               EWF_TEST_COALESCED_READ_FILE_NAME,
+	               "wb" );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_stream",
+	 file_stream );
+
+	write_count = file_stream_write(
+	               file_stream,
+	               data,
+	               EWF_TEST_COALESCED_READ_DATA_SIZE );
+
+	file_stream_close(
+	 file_stream );
+
+	file_stream = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "write_count",
+	 write_count,
+	 (size_t) EWF_TEST_COALESCED_READ_DATA_SIZE );
+
+	result = libbfio_file_initialize(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libbfio_file_set_name(
+	          file_io_handle,
+	          EWF_TEST_COALESCED_READ_FILE_NAME,
+	          narrow_string_length(
+	           EWF_TEST_COALESCED_READ_FILE_NAME ) + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libbfio_pool_initialize(
+	          &file_io_pool,
+	          0,
+	          LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libbfio_pool_append_handle(
+	          file_io_pool,
+	          &file_io_pool_entry,
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* The file IO pool takes over management of the file IO handle
+	 */
+	file_io_handle = NULL;
+
+	result = libewf_coalesced_read_buffer_initialize(
+	          &coalesced_read_buffer,
+	          EWF_TEST_COALESCED_READ_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* A random read of a single chunk only reads that chunk
+	 */
+	read_count = libewf_coalesced_read_buffer_read_buffer_at_offset(
+	              coalesced_read_buffer,
+	              file_io_pool,
+	              file_io_pool_entry,
+	              buffer,
+	              EWF_TEST_COALESCED_READ_CHUNK_SIZE,
+	              4 * EWF_TEST_COALESCED_READ_CHUNK_SIZE,
+	              8 * EWF_TEST_COALESCED_READ_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) EWF_TEST_COALESCED_READ_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "coalesced_read_buffer->data_size",
+	 coalesced_read_buffer->data_size,
+	 (size_t) EWF_TEST_COALESCED_READ_CHUNK_SIZE );
+
+	result = memory_compare(
+	          buffer,
+	          &( data[ 4 * EWF_TEST_COALESCED_READ_CHUNK_SIZE ] ),
+	          EWF_TEST_COALESCED_READ_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* A read that directly follows the previous read coalesces the chunks that follow
+	 */
+	read_count = libewf_coalesced_read_buffer_read_buffer_at_offset(
+	              coalesced_read_buffer,
+	              file_io_pool,
+	              file_io_pool_entry,
+	              buffer,
+	              EWF_TEST_COALESCED_READ_CHUNK_SIZE,
+	              5 * EWF_TEST_COALESCED_READ_CHUNK_SIZE,
+	              8 * EWF_TEST_COALESCED_READ_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) EWF_TEST_COALESCED_READ_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "coalesced_read_buffer->data_size",
+	 coalesced_read_buffer->data_size,
+	 (size_t) ( 8 * EWF_TEST_COALESCED_READ_CHUNK_SIZE ) );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "coalesced_read_buffer->data_offset",
+	 (int64_t) coalesced_read_buffer->data_offset,
+	 (int64_t) ( 5 * EWF_TEST_COALESCED_READ_CHUNK_SIZE ) );
+
+	/* The next chunk is copied from the coalesced read buffer
+	 */
+	read_count = libewf_coalesced_read_buffer_read_buffer_at_offset(
+	              coalesced_read_buffer,
+	              file_io_pool,
+	              file_io_pool_entry,
+	              buffer,
+	              EWF_TEST_COALESCED_READ_CHUNK_SIZE,
+	              6 * EWF_TEST_COALESCED_READ_CHUNK_SIZE,
+	              7 * EWF_TEST_COALESCED_READ_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) EWF_TEST_COALESCED_READ_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "coalesced_read_buffer->data_offset",
+	 (int64_t) coalesced_read_buffer->data_offset,
+	 (int64_t) ( 5 * EWF_TEST_COALESCED_READ_CHUNK_SIZE ) );
+
+	result = memory_compare(
+	          buffer,
+	          &( data[ 6 * EWF_TEST_COALESCED_READ_CHUNK_SIZE ] ),
+	          EWF_TEST_COALESCED_READ_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* A random read after sequential reads only reads that chunk again
+	 */
+	read_count = libewf_coalesced_read_buffer_read_buffer_at_offset(
+	              coalesced_read_buffer,
+	              file_io_pool,
+	              file_io_pool_entry,
+	              buffer,
+	              EWF_TEST_COALESCED_READ_CHUNK_SIZE,
+	              0,
+	              8 * EWF_TEST_COALESCED_READ_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) EWF_TEST_COALESCED_READ_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "coalesced_read_buffer->data_size",
+	 coalesced_read_buffer->data_size,
+	 (size_t) EWF_TEST_COALESCED_READ_CHUNK_SIZE );
+
+	result = memory_compare(
+	          buffer,
+	          data,
+	          EWF_TEST_COALESCED_READ_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libewf_coalesced_read_buffer_free(
+	          &coalesced_read_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libbfio_pool_close_all(
+	          file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libbfio_pool_free(
+	          &file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	remove(
+	 EWF_TEST_COALESCED_READ_FILE_NAME );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( coalesced_read_buffer != NULL )
+	{
+		libewf_coalesced_read_buffer_free(
+		 &coalesced_read_buffer,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	remove(
+	 EWF_TEST_COALESCED_READ_FILE_NAME );
+
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_coalesced_read_buffer_initialize",
+	 ewf_test_coalesced_read_buffer_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_coalesced_read_buffer_clear",
+	 ewf_test_coalesced_read_buffer_clear );
+
+	EWF_TEST_RUN(
+	 "libewf_coalesced_read_buffer_read_buffer_at_offset",
+	 ewf_test_coalesced_read_buffer_read_buffer_at_offset );
+
+	EWF_TEST_RUN(
+	 "libewf_coalesced_read_buffer_read_sequential",
+	 ewf_test_coalesced_read_buffer_read_sequential );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,766 @@
+/*
+ * Library compression functions testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+#include "../libewf/libewf_compression.h"
+#include "../libewf/libewf_compression_context.h"
+#include "../libewf/libewf_deflate.h"
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && ( defined( HAVE_LIBDEFLATE ) || defined( HAVE_LIBISAL ) )
+
+/* The size of the test data buffers
+ */
+#define EWF_TEST_COMPRESSION_BUFFER_SIZE		65536
+
+/* The size of the compressed data buffer, which exceeds the bound of the compressed size of the test data
+ */
+#define EWF_TEST_COMPRESSION_COMPRESSED_BUFFER_SIZE	( 2 * EWF_TEST_COMPRESSION_BUFFER_SIZE )
+
+typedef int (*ewf_test_compression_compress_function_t)(
+             libewf_compression_context_t *compression_context,
+             uint8_t *compressed_data,
+             size_t *compressed_data_size,
+             int8_t compression_level,
+             const uint8_t *uncompressed_data,
+             size_t uncompressed_data_size,
+             libcerror_error_t **error );
+
+typedef int (*ewf_test_compression_decompress_function_t)(
+             libewf_compression_context_t *compression_context,
+             const uint8_t *compressed_data,
+             size_t compressed_data_size,
+             uint8_t *uncompressed_data,
+             size_t *uncompressed_data_size,
+             libcerror_error_t **error );
+
+/* The data sizes to test, these cover data smaller and larger than the compression window
+ */
+size_t ewf_test_compression_data_sizes[ 4 ] = {
+	1, 257, 32768, EWF_TEST_COMPRESSION_BUFFER_SIZE };
+
+/* The compression levels to test
+ */
+int8_t ewf_test_compression_levels[ 3 ] = {
+	LIBEWF_COMPRESSION_DEFAULT, LIBEWF_COMPRESSION_FAST, LIBEWF_COMPRESSION_BEST };
+
+/* Fills a buffer with test data
+ * Data type 0 is skewed pseudo random data, which results in dynamic Huffman blocks,
+ * data type 1 is data of a repeating pattern, which results in matches
+ */
+void ewf_test_compression_fill_buffer(
+      uint8_t *buffer,
+      size_t buffer_size,
+      int data_type )
+{
+	size_t buffer_offset = 0;
+	uint32_t seed        = 0x12345678UL;
+	uint8_t byte_value   = 0;
+
+	for( buffer_offset = 0;
+	     buffer_offset < buffer_size;
+	     buffer_offset++ )
+	{
+		if( data_type == 0 )
+		{
+			seed = ( seed * 1103515245UL ) + 12345;
+
+			byte_value = 0;
+
+			while( ( byte_value < 24 )
+			    && ( ( seed & ( 0x00000100UL << byte_value ) ) == 0 ) )
+			{
+				byte_value++;
+			}
+			buffer[ buffer_offset ] = (uint8_t) ( 'a' + byte_value );
+		}
+		else
+		{
+			buffer[ buffer_offset ] = (uint8_t) ( ( buffer_offset % 251 ) ^ ( buffer_offset / 4099 ) );
+		}
+	}
+}
+
+/* Tests that data compressed by a codec can be decompressed by zlib and the built-in inflater
+ * and that data compressed by zlib can be decompressed by the codec
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_codec_round_trip(
+     ewf_test_compression_compress_function_t compress_function,
+     ewf_test_compression_decompress_function_t decompress_function )
+{
+	libcerror_error_t *error                          = NULL;
+	libewf_compression_context_t *compression_context = NULL;
+	libewf_compression_context_t *context             = NULL;
+	uint8_t *compressed_data                          = NULL;
+	uint8_t *data                                     = NULL;
+	uint8_t *uncompressed_data                        = NULL;
+	size_t compressed_data_size                       = 0;
+	size_t size                                       = 0;
+	size_t uncompressed_data_size                     = 0;
+	int context_index                                 = 0;
+	int data_type                                     = 0;
+	int level_index                                   = 0;
+	int result                                        = 0;
+	int size_index                                    = 0;
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	uLongf zlib_compressed_data_size                  = 0;
+	uLongf zlib_uncompressed_data_size                = 0;
+#endif
+
+	data = (uint8_t *) malloc(
+	                    sizeof( uint8_t ) * EWF_TEST_COMPRESSION_BUFFER_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	uncompressed_data = (uint8_t *) malloc(
+	                                 sizeof( uint8_t ) * EWF_TEST_COMPRESSION_BUFFER_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "uncompressed_data",
+	 uncompressed_data );
+
+	compressed_data = (uint8_t *) malloc(
+	                               sizeof( uint8_t ) * EWF_TEST_COMPRESSION_COMPRESSED_BUFFER_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data",
+	 compressed_data );
+
+	result = libewf_compression_context_initialize(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test without and with a compression context, the latter is reused
+	 * for all compression levels
+	 */
+	for( context_index = 0;
+	     context_index < 2;
+	     context_index++ )
+	{
+		if( context_index == 0 )
+		{
+			context = NULL;
+		}
+		else
+		{
+			context = compression_context;
+		}
+		for( data_type = 0;
+		     data_type < 2;
+		     data_type++ )
+		{
+			ewf_test_compression_fill_buffer(
+			 data,
+			 EWF_TEST_COMPRESSION_BUFFER_SIZE,
+			 data_type );
+
+			for( level_index = 0;
+			     level_index < 3;
+			     level_index++ )
+			{
+				for( size_index = 0;
+				     size_index < 4;
+				     size_index++ )
+				{
+					size = ewf_test_compression_data_sizes[ size_index ];
+
+					compressed_data_size = EWF_TEST_COMPRESSION_COMPRESSED_BUFFER_SIZE;
+
+					result = compress_function(
+					          context,
+					          compressed_data,
+					          &compressed_data_size,
+					          ewf_test_compression_levels[ level_index ],
+					          data,
+					          size,
+					          &error );
+
+					EWF_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 1 );
+
+					EWF_TEST_ASSERT_IS_NULL(
+					 "error",
+					 error );
+
+					/* Test decompression with the built-in inflater
+					 */
+					uncompressed_data_size = EWF_TEST_COMPRESSION_BUFFER_SIZE;
+
+					result = libewf_deflate_decompress(
+					          compressed_data,
+					          compressed_data_size,
+					          uncompressed_data,
+					          &uncompressed_data_size,
+					          &error );
+
+					EWF_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 1 );
+
+					EWF_TEST_ASSERT_EQUAL_SIZE(
+					 "uncompressed_data_size",
+					 uncompressed_data_size,
+					 size );
+
+					EWF_TEST_ASSERT_IS_NULL(
+					 "error",
+					 error );
+
+					result = memory_compare(
+					          uncompressed_data,
+					          data,
+					          size );
+
+					EWF_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 0 );
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+					/* Test decompression with zlib
+					 */
+					zlib_uncompressed_data_size = (uLongf) EWF_TEST_COMPRESSION_BUFFER_SIZE;
+
+					result = uncompress(
+					          (Bytef *) uncompressed_data,
+					          &zlib_uncompressed_data_size,
+					          (const Bytef *) compressed_data,
+					          (uLong) compressed_data_size );
+
+					EWF_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 Z_OK );
+
+					EWF_TEST_ASSERT_EQUAL_SIZE(
+					 "zlib_uncompressed_data_size",
+					 (size_t) zlib_uncompressed_data_size,
+					 size );
+
+					result = memory_compare(
+					          uncompressed_data,
+					          data,
+					          size );
+
+					EWF_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 0 );
+#endif
+					/* Test decompression with the codec
+					 */
+					uncompressed_data_size = EWF_TEST_COMPRESSION_BUFFER_SIZE;
+
+					result = decompress_function(
+					          context,
+					          compressed_data,
+					          compressed_data_size,
+					          uncompressed_data,
+					          &uncompressed_data_size,
+					          &error );
+
+					EWF_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 1 );
+
+					EWF_TEST_ASSERT_EQUAL_SIZE(
+					 "uncompressed_data_size",
+					 uncompressed_data_size,
+					 size );
+
+					EWF_TEST_ASSERT_IS_NULL(
+					 "error",
+					 error );
+
+					result = memory_compare(
+					          uncompressed_data,
+					          data,
+					          size );
+
+					EWF_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 0 );
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+					/* Test decompression with the codec of data compressed by zlib
+					 */
+					zlib_compressed_data_size = (uLongf) EWF_TEST_COMPRESSION_COMPRESSED_BUFFER_SIZE;
+
+					result = compress2(
+					          (Bytef *) compressed_data,
+					          &zlib_compressed_data_size,
+					          (const Bytef *) data,
+					          (uLong) size,
+					          Z_DEFAULT_COMPRESSION );
+
+					EWF_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 Z_OK );
+
+					uncompressed_data_size = EWF_TEST_COMPRESSION_BUFFER_SIZE;
+
+					result = decompress_function(
+					          context,
+					          compressed_data,
+					          (size_t) zlib_compressed_data_size,
+					          uncompressed_data,
+					          &uncompressed_data_size,
+					          &error );
+
+					EWF_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 1 );
+
+					EWF_TEST_ASSERT_EQUAL_SIZE(
+					 "uncompressed_data_size",
+					 uncompressed_data_size,
+					 size );
+
+					EWF_TEST_ASSERT_IS_NULL(
+					 "error",
+					 error );
+
+					result = memory_compare(
+					          uncompressed_data,
+					          data,
+					          size );
+
+					EWF_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 0 );
+#endif
+				}
+			}
+		}
+	}
+	result = libewf_compression_context_free(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	free(
+	 compressed_data );
+
+	free(
+	 uncompressed_data );
+
+	free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+	if( compressed_data != NULL )
+	{
+		free(
+		 compressed_data );
+	}
+	if( uncompressed_data != NULL )
+	{
+		free(
+		 uncompressed_data );
+	}
+	if( data != NULL )
+	{
+		free(
+		 data );
+	}
+	return( 0 );
+}
+
+/* Tests the error cases of a codec
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_codec_errors(
+     ewf_test_compression_compress_function_t compress_function,
+     ewf_test_compression_decompress_function_t decompress_function )
+{
+	libcerror_error_t *error      = NULL;
+	uint8_t *compressed_data      = NULL;
+	uint8_t *data                 = NULL;
+	uint8_t *uncompressed_data    = NULL;
+	size_t compressed_data_size   = 0;
+	size_t uncompressed_data_size = 0;
+	int result                    = 0;
+
+	data = (uint8_t *) malloc(
+	                    sizeof( uint8_t ) * EWF_TEST_COMPRESSION_BUFFER_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	uncompressed_data = (uint8_t *) malloc(
+	                                 sizeof( uint8_t ) * EWF_TEST_COMPRESSION_BUFFER_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "uncompressed_data",
+	 uncompressed_data );
+
+	compressed_data = (uint8_t *) malloc(
+	                               sizeof( uint8_t ) * EWF_TEST_COMPRESSION_COMPRESSED_BUFFER_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data",
+	 compressed_data );
+
+	ewf_test_compression_fill_buffer(
+	 data,
+	 EWF_TEST_COMPRESSION_BUFFER_SIZE,
+	 0 );
+
+	/* Test compression with a compressed data buffer that is too small
+	 */
+	compressed_data_size = 16;
+
+	result = compress_function(
+	          NULL,
+	          compressed_data,
+	          &compressed_data_size,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          data,
+	          EWF_TEST_COMPRESSION_BUFFER_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "compressed_data_size",
+	 (int) compressed_data_size,
+	 16 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	compressed_data_size = EWF_TEST_COMPRESSION_COMPRESSED_BUFFER_SIZE;
+
+	result = compress_function(
+	          NULL,
+	          compressed_data,
+	          &compressed_data_size,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          data,
+	          EWF_TEST_COMPRESSION_BUFFER_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test decompression with an uncompressed data buffer that is too small
+	 */
+	uncompressed_data_size = EWF_TEST_COMPRESSION_BUFFER_SIZE - 1;
+
+	result = decompress_function(
+	          NULL,
+	          compressed_data,
+	          compressed_data_size,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test decompression of data without a valid zlib header
+	 */
+	compressed_data[ 0 ] = 0x00;
+
+	uncompressed_data_size = EWF_TEST_COMPRESSION_BUFFER_SIZE;
+
+	result = decompress_function(
+	          NULL,
+	          compressed_data,
+	          compressed_data_size,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error cases
+	 */
+	result = compress_function(
+	          NULL,
+	          compressed_data,
+	          NULL,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          data,
+	          EWF_TEST_COMPRESSION_BUFFER_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	compressed_data_size = EWF_TEST_COMPRESSION_COMPRESSED_BUFFER_SIZE;
+
+	result = compress_function(
+	          NULL,
+	          compressed_data,
+	          &compressed_data_size,
+	          LIBEWF_COMPRESSION_NONE,
+	          data,
+	          EWF_TEST_COMPRESSION_BUFFER_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = decompress_function(
+	          NULL,
+	          compressed_data,
+	          compressed_data_size,
+	          uncompressed_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	free(
+	 compressed_data );
+
+	free(
+	 uncompressed_data );
+
+	free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compressed_data != NULL )
+	{
+		free(
+		 compressed_data );
+	}
+	if( uncompressed_data != NULL )
+	{
+		free(
+		 uncompressed_data );
+	}
+	if( data != NULL )
+	{
+		free(
+		 data );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_LIBDEFLATE )
+
+/* Tests the libewf_compress_data_libdeflate and libewf_decompress_data_libdeflate functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_libdeflate(
+     void )
+{
+	if( ewf_test_compression_codec_round_trip(
+	     &libewf_compress_data_libdeflate,
+	     &libewf_decompress_data_libdeflate ) != 1 )
+	{
+		return( 0 );
+	}
+	if( ewf_test_compression_codec_errors(
+	     &libewf_compress_data_libdeflate,
+	     &libewf_decompress_data_libdeflate ) != 1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBDEFLATE ) */
+
+#if defined( HAVE_LIBISAL )
+
+/* Tests the libewf_compress_data_isal and libewf_decompress_data_isal functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_isal(
+     void )
+{
+	if( ewf_test_compression_codec_round_trip(
+	     &libewf_compress_data_isal,
+	     &libewf_decompress_data_isal ) != 1 )
+	{
+		return( 0 );
+	}
+	if( ewf_test_compression_codec_errors(
+	     &libewf_compress_data_isal,
+	     &libewf_decompress_data_isal ) != 1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBISAL ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && ( defined( HAVE_LIBDEFLATE ) || defined( HAVE_LIBISAL ) ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+#if defined( HAVE_LIBDEFLATE )
+
+	EWF_TEST_RUN(
+	 "libewf_compress_data_libdeflate",
+	 ewf_test_compression_libdeflate );
+
+#endif /* defined( HAVE_LIBDEFLATE ) */
+
+#if defined( HAVE_LIBISAL )
+
+	EWF_TEST_RUN(
+	 "libewf_compress_data_isal",
+	 ewf_test_compression_isal );
+
+#endif /* defined( HAVE_LIBISAL ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && ( defined( HAVE_LIBDEFLATE ) || defined( HAVE_LIBISAL ) )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif
+}
@@ -27,12 +27,15 @@
 #include <stdlib.h>
 #endif
 
+#include "ewf_test_image.h"
 #include "ewf_test_libcerror.h"
 #include "ewf_test_libewf.h"
 #include "ewf_test_macros.h"
 #include "ewf_test_memory.h"
 #include "ewf_test_unused.h"
 
+#define EWF_TEST_DATA_CHUNK_FILENAME	"ewf_test_data_chunk"
+
 /* Tests the libewf_data_chunk_free function
  * Returns 1 if successful or 0 if not
  */
@@ -71,6 +74,194 @@ on_error:
 	return( 0 );
 }
 
+/* Tests freeing a data chunk after the handle it was retrieved from
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_data_chunk_free_after_handle(
+     void )
+{
+	uint8_t buffer[ EWF_TEST_IMAGE_CHUNK_SIZE ];
+
+	libcerror_error_t *error        = NULL;
+	libewf_data_chunk_t *data_chunk = NULL;
+	libewf_handle_t *handle         = NULL;
+	const char *filename            = EWF_TEST_DATA_CHUNK_FILENAME;
+	ssize_t write_count             = 0;
+	int result                      = 0;
+
+	result = ewf_test_image_generate_media_data(
+	          buffer,
+	          EWF_TEST_IMAGE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_initialize(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_open(
+	          handle,
+	          (char * const *) &filename,
+	          1,
+	          LIBEWF_OPEN_WRITE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_set_format(
+	          handle,
+	          LIBEWF_FORMAT_ENCASE6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_set_media_size(
+	          handle,
+	          EWF_TEST_IMAGE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_get_data_chunk(
+	          handle,
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	write_count = libewf_data_chunk_write_buffer(
+	               data_chunk,
+	               buffer,
+	               EWF_TEST_IMAGE_CHUNK_SIZE,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) EWF_TEST_IMAGE_CHUNK_SIZE );
+
+	write_count = libewf_handle_write_data_chunk(
+	               handle,
+	               data_chunk,
+	               &error );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "write_count",
+	 (int) write_count,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The chunk data of the data chunk is not taken from the buffer pool of the handle,
+	 * hence the handle can be freed while the data chunk is still in use
+	 */
+	result = libewf_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_data_chunk_free(
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_image_remove(
+	          EWF_TEST_DATA_CHUNK_FILENAME,
+	          LIBEWF_FORMAT_ENCASE6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	ewf_test_image_remove(
+	 EWF_TEST_DATA_CHUNK_FILENAME,
+	 LIBEWF_FORMAT_ENCASE6,
+	 NULL );
+
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -90,6 +281,10 @@ int main(
 	 "libewf_data_chunk_free",
 	 ewf_test_data_chunk_free );
 
+	EWF_TEST_RUN(
+	 "libewf_data_chunk_free_after_handle",
+	 ewf_test_data_chunk_free_after_handle );
+
 	return( EXIT_SUCCESS );
 
 on_error:
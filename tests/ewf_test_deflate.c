@@ -0,0 +1,1620 @@
+/*
+ * Library deflate functions testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+#include "../libewf/libewf_deflate.h"
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* A zlib stream with a single dynamic Huffman block of which the literal codes
+ * 'A' to 'O' have a size of 1 to 15 bits, so that the codes of 10 bits and larger
+ * are stored in the sub tables of the literals table
+ */
+uint8_t ewf_test_deflate_long_codes_data[ 95 ] = {
+	0x78, 0x01, 0x05, 0xe0, 0x01, 0x82, 0x24, 0x49, 0x92, 0x24, 0x49, 0xbe,
+	0x0d, 0x90, 0x58, 0xd4, 0x3c, 0xb2, 0x7a, 0xf6, 0xfe, 0xff, 0x9b, 0x83,
+	0xff, 0xdf, 0xff, 0xf7, 0xff, 0xfe, 0xef, 0x7f, 0xff, 0xfd, 0xfb, 0xfb,
+	0x7d, 0xef, 0x96, 0xff, 0xdf, 0xff, 0xf7, 0xff, 0xfe, 0xef, 0x7f, 0xff,
+	0xfd, 0xfb, 0xfb, 0x7d, 0xef, 0x96, 0xff, 0xdf, 0xff, 0xf7, 0xff, 0xfe,
+	0xef, 0x7f, 0xff, 0xfd, 0xfb, 0xfb, 0x7d, 0xef, 0x96, 0xff, 0xdf, 0xff,
+	0xef, 0xff, 0xfb, 0xff, 0xfe, 0xdf, 0xff, 0xfb, 0xbf, 0xff, 0xfb, 0xdf,
+	0xff, 0xfe, 0xfb, 0x0f, 0x80, 0xff, 0x3f, 0x86, 0x99, 0x12, 0xc9 };
+
+/* The uncompressed data of the long codes zlib stream
+ */
+uint8_t ewf_test_deflate_long_codes_uncompressed_data[ 67 ] = {
+	'O', 'N', 'M', 'L', 'K', 'J', 'I', 'H', 'G', 'F', 'E', 'D', 'C', 'B', 'A',
+	'O', 'N', 'M', 'L', 'K', 'J', 'I', 'H', 'G', 'F', 'E', 'D', 'C', 'B', 'A',
+	'O', 'N', 'M', 'L', 'K', 'J', 'I', 'H', 'G', 'F', 'E', 'D', 'C', 'B', 'A',
+	'O', 'O', 'N', 'N', 'M', 'M', 'L', 'L', 'K', 'K', 'J', 'J',
+	'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A' };
+
+/* The long codes zlib stream with an additional literal code of 15 bits
+ * which makes the literal code sizes over-subscribed
+ */
+uint8_t ewf_test_deflate_over_subscribed_data[ 96 ] = {
+	0x78, 0x01, 0x05, 0xe0, 0x01, 0x82, 0x24, 0x49, 0x92, 0x24, 0x49, 0xbe,
+	0x0d, 0x90, 0x58, 0xd4, 0x3c, 0xb2, 0x7a, 0xf6, 0xee, 0xff, 0xaf, 0x39,
+	0xf8, 0xff, 0xfd, 0x7f, 0xff, 0xef, 0xff, 0xfe, 0xf7, 0xdf, 0xbf, 0xbf,
+	0xdf, 0xf7, 0x6e, 0xf9, 0xff, 0xfd, 0x7f, 0xff, 0xef, 0xff, 0xfe, 0xf7,
+	0xdf, 0xbf, 0xbf, 0xdf, 0xf7, 0x6e, 0xf9, 0xff, 0xfd, 0x7f, 0xff, 0xef,
+	0xff, 0xfe, 0xf7, 0xdf, 0xbf, 0xbf, 0xdf, 0xf7, 0x6e, 0xf9, 0xff, 0xfd,
+	0xff, 0xfe, 0xbf, 0xff, 0xef, 0xff, 0xfd, 0xbf, 0xff, 0xfb, 0xbf, 0xff,
+	0xfd, 0xef, 0xbf, 0xff, 0x00, 0x00, 0x00, 0x00, 0x86, 0x99, 0x12, 0xc9 };
+
+/* The long codes zlib stream without the literal code of 15 bits for 'O'
+ * which makes the literal code sizes incomplete
+ */
+uint8_t ewf_test_deflate_incomplete_data[ 69 ] = {
+	0x78, 0x01, 0x05, 0xe0, 0x01, 0x82, 0x24, 0x49, 0x92, 0x24, 0x49, 0xbe,
+	0x0d, 0x90, 0x58, 0xd4, 0x3c, 0xb2, 0x7a, 0xf6, 0xff, 0xcf, 0x39, 0xf8,
+	0xff, 0xfe, 0xdf, 0xff, 0xfd, 0xef, 0xbf, 0x7f, 0x7f, 0xbf, 0xef, 0xdd,
+	0xf2, 0xff, 0xfd, 0xbf, 0xff, 0xfb, 0xdf, 0x7f, 0xff, 0xfe, 0x7e, 0xdf,
+	0xbb, 0xe5, 0xff, 0xfb, 0x7f, 0xff, 0xf7, 0xbf, 0xff, 0xfe, 0xfd, 0xfd,
+	0xbe, 0x77, 0xcb, 0xff, 0x0f, 0xff, 0x09, 0x0b, 0xbc };
+
+/* A zlib stream with a fixed Huffman block "abc", an uncompressed block
+ * "0123456789ABCDEFGHIJ" and a fixed Huffman block "xyz", where the uncompressed
+ * block starts while whole bytes of the stream are buffered in the bit buffer
+ */
+uint8_t ewf_test_deflate_stored_block_data[ 40 ] = {
+	0x78, 0x01, 0x4a, 0x4c, 0x4a, 0x06, 0x00, 0x14, 0x00, 0xeb, 0xff, 0x30,
+	0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x41, 0x42, 0x43,
+	0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0xab, 0xa8, 0xac, 0x02, 0x00,
+	0x5c, 0x01, 0x07, 0x56 };
+
+/* The stored block zlib stream with a mismatch in the uncompressed block size copy
+ */
+uint8_t ewf_test_deflate_stored_block_size_mismatch_data[ 40 ] = {
+	0x78, 0x01, 0x4a, 0x4c, 0x4a, 0x06, 0x00, 0x14, 0x00, 0xea, 0xff, 0x30,
+	0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x41, 0x42, 0x43,
+	0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0xab, 0xa8, 0xac, 0x02, 0x00,
+	0x5c, 0x01, 0x07, 0x56 };
+
+/* The number of codes per code size of 285 literal codes of which most
+ * are larger than 9 bits, which requires 844 lookup table entries
+ */
+int ewf_test_deflate_sub_tables_code_counts[ 16 ] = {
+	0, 1, 1, 1, 0, 0, 0, 1, 1, 0, 80, 47, 17, 30, 38, 68 };
+
+/* The number of codes per code size of 320 literal codes of which most
+ * are larger than 9 bits, which requires 882 lookup table entries
+ */
+int ewf_test_deflate_exhaustion_code_counts[ 16 ] = {
+	0, 1, 1, 1, 0, 0, 0, 1, 0, 0, 90, 18, 43, 33, 64, 68 };
+
+/* Fills a buffer with pseudo random data
+ * The data is skewed so that the Huffman codes of the most infrequent bytes are large
+ */
+void ewf_test_deflate_fill_buffer(
+      uint8_t *buffer,
+      size_t buffer_size,
+      uint32_t seed )
+{
+	size_t buffer_offset = 0;
+	uint8_t byte_value   = 0;
+
+	for( buffer_offset = 0;
+	     buffer_offset < buffer_size;
+	     buffer_offset++ )
+	{
+		seed = ( seed * 1103515245UL ) + 12345;
+
+		byte_value = 0;
+
+		while( ( byte_value < 24 )
+		    && ( ( seed & ( 0x00000100UL << byte_value ) ) == 0 ) )
+		{
+			byte_value++;
+		}
+		buffer[ buffer_offset ] = (uint8_t) ( 'a' + byte_value );
+	}
+}
+
+/* Expands the number of codes per code size into a code sizes array
+ * Returns the number of code sizes
+ */
+int ewf_test_deflate_expand_code_counts(
+     const int *code_counts_array,
+     uint16_t *code_sizes_array )
+{
+	int code_size            = 0;
+	int code_index           = 0;
+	int number_of_code_sizes = 0;
+
+	for( code_size = 1;
+	     code_size <= 15;
+	     code_size++ )
+	{
+		for( code_index = 0;
+		     code_index < code_counts_array[ code_size ];
+		     code_index++ )
+		{
+			code_sizes_array[ number_of_code_sizes++ ] = (uint16_t) code_size;
+		}
+	}
+	return( number_of_code_sizes );
+}
+
+/* Writes the canonical Huffman code of every symbol, in symbol order, to a buffer
+ * The codes are written in reversed bit order, as they are stored in a deflate stream
+ * Returns the number of bytes written
+ */
+size_t ewf_test_deflate_write_huffman_codes(
+        const uint16_t *code_sizes_array,
+        int number_of_code_sizes,
+        uint8_t *buffer,
+        size_t buffer_size )
+{
+	int code_counts_array[ 16 ];
+	uint32_t next_codes_array[ 16 ];
+
+	size_t buffer_offset    = 0;
+	uint64_t bit_buffer     = 0;
+	uint32_t huffman_code   = 0;
+	uint32_t reversed_code  = 0;
+	uint16_t code_size      = 0;
+	uint8_t bit_buffer_size = 0;
+	uint8_t bit_index       = 0;
+	int symbol              = 0;
+
+	memory_set(
+	 code_counts_array,
+	 0,
+	 16 * sizeof( int ) );
+
+	for( symbol = 0;
+	     symbol < number_of_code_sizes;
+	     symbol++ )
+	{
+		code_counts_array[ code_sizes_array[ symbol ] ] += 1;
+	}
+	code_counts_array[ 0 ] = 0;
+	next_codes_array[ 0 ]  = 0;
+
+	for( bit_index = 1;
+	     bit_index <= 15;
+	     bit_index++ )
+	{
+		huffman_code = ( huffman_code + code_counts_array[ bit_index - 1 ] ) << 1;
+
+		next_codes_array[ bit_index ] = huffman_code;
+	}
+	for( symbol = 0;
+	     symbol < number_of_code_sizes;
+	     symbol++ )
+	{
+		code_size = code_sizes_array[ symbol ];
+
+		if( code_size == 0 )
+		{
+			continue;
+		}
+		huffman_code  = next_codes_array[ code_size ]++;
+		reversed_code = 0;
+
+		for( bit_index = 0;
+		     bit_index < code_size;
+		     bit_index++ )
+		{
+			reversed_code <<= 1;
+			reversed_code  |= ( huffman_code >> bit_index ) & 0x00000001UL;
+		}
+		bit_buffer      |= (uint64_t) reversed_code << bit_buffer_size;
+		bit_buffer_size += (uint8_t) code_size;
+
+		while( ( bit_buffer_size >= 8 )
+		    && ( buffer_offset < buffer_size ) )
+		{
+			buffer[ buffer_offset++ ] = (uint8_t) bit_buffer;
+
+			bit_buffer     >>= 8;
+			bit_buffer_size -= 8;
+		}
+	}
+	if( ( bit_buffer_size > 0 )
+	 && ( buffer_offset < buffer_size ) )
+	{
+		buffer[ buffer_offset++ ] = (uint8_t) bit_buffer;
+	}
+	return( buffer_offset );
+}
+
+/* Tests the libewf_deflate_bit_stream_get_value and libewf_deflate_bit_stream_align_to_byte functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_bit_stream_get_value(
+     void )
+{
+	uint8_t byte_stream[ 16 ] = {
+		0xa5, 0x5a, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+		0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e };
+
+	libewf_deflate_bit_stream_t bit_stream;
+
+	libcerror_error_t *error = NULL;
+	uint32_t value_32bit     = 0;
+	int result               = 0;
+
+	bit_stream.byte_stream        = byte_stream;
+	bit_stream.byte_stream_size   = 16;
+	bit_stream.byte_stream_offset = 0;
+	bit_stream.bit_buffer         = 0;
+	bit_stream.bit_buffer_size    = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_deflate_bit_stream_get_value(
+	          &bit_stream,
+	          3,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0x00000005UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The bit buffer contains 61 bits of which the 7 whole bytes
+	 * are returned to the byte stream
+	 */
+	result = libewf_deflate_bit_stream_align_to_byte(
+	          &bit_stream,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "bit_stream.byte_stream_offset",
+	 bit_stream.byte_stream_offset,
+	 (size_t) 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "bit_stream.bit_buffer_size",
+	 (int) bit_stream.bit_buffer_size,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_deflate_bit_stream_get_value(
+	          &bit_stream,
+	          16,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0x0000015aUL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_deflate_bit_stream_get_value(
+	          &bit_stream,
+	          32,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0x05040302UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reading beyond the end of the byte stream
+	 */
+	result = libewf_deflate_bit_stream_get_value(
+	          &bit_stream,
+	          32,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0x09080706UL );
+
+	result = libewf_deflate_bit_stream_get_value(
+	          &bit_stream,
+	          32,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0x0d0c0b0aUL );
+
+	result = libewf_deflate_bit_stream_get_value(
+	          &bit_stream,
+	          16,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error cases
+	 */
+	result = libewf_deflate_bit_stream_get_value(
+	          NULL,
+	          3,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_bit_stream_get_value(
+	          &bit_stream,
+	          33,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_bit_stream_get_value(
+	          &bit_stream,
+	          3,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_bit_stream_align_to_byte(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_deflate_huffman_table_construct function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_huffman_table_construct(
+     void )
+{
+	uint16_t code_sizes_array[ 320 ];
+
+	libewf_deflate_huffman_table_t table;
+
+	libcerror_error_t *error = NULL;
+	int number_of_code_sizes = 0;
+	int result               = 0;
+	int symbol               = 0;
+
+	/* Test regular cases
+	 */
+	for( symbol = 0;
+	     symbol < 288;
+	     symbol++ )
+	{
+		if( symbol < 144 )
+		{
+			code_sizes_array[ symbol ] = 8;
+		}
+		else if( symbol < 256 )
+		{
+			code_sizes_array[ symbol ] = 9;
+		}
+		else if( symbol < 280 )
+		{
+			code_sizes_array[ symbol ] = 7;
+		}
+		else
+		{
+			code_sizes_array[ symbol ] = 8;
+		}
+	}
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          code_sizes_array,
+	          288,
+	          LIBEWF_DEFLATE_LITERALS_TABLE_NUMBER_OF_LOOKUP_BITS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test codes that are larger than the number of lookup bits
+	 */
+	number_of_code_sizes = ewf_test_deflate_expand_code_counts(
+	                        ewf_test_deflate_sub_tables_code_counts,
+	                        code_sizes_array );
+
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          code_sizes_array,
+	          number_of_code_sizes,
+	          LIBEWF_DEFLATE_LITERALS_TABLE_NUMBER_OF_LOOKUP_BITS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a single code of 1 bit, which is the only incomplete set of codes that is allowed
+	 */
+	memory_set(
+	 code_sizes_array,
+	 0,
+	 sizeof( uint16_t ) * 30 );
+
+	code_sizes_array[ 0 ] = 1;
+
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          code_sizes_array,
+	          30,
+	          LIBEWF_DEFLATE_DISTANCES_TABLE_NUMBER_OF_LOOKUP_BITS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a table without codes
+	 */
+	code_sizes_array[ 0 ] = 0;
+
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          code_sizes_array,
+	          30,
+	          LIBEWF_DEFLATE_DISTANCES_TABLE_NUMBER_OF_LOOKUP_BITS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_deflate_huffman_table_construct(
+	          NULL,
+	          code_sizes_array,
+	          30,
+	          LIBEWF_DEFLATE_DISTANCES_TABLE_NUMBER_OF_LOOKUP_BITS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          NULL,
+	          30,
+	          LIBEWF_DEFLATE_DISTANCES_TABLE_NUMBER_OF_LOOKUP_BITS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          code_sizes_array,
+	          321,
+	          LIBEWF_DEFLATE_DISTANCES_TABLE_NUMBER_OF_LOOKUP_BITS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          code_sizes_array,
+	          30,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          code_sizes_array,
+	          30,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a code size that exceeds the maximum
+	 */
+	code_sizes_array[ 0 ] = 16;
+
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          code_sizes_array,
+	          30,
+	          LIBEWF_DEFLATE_DISTANCES_TABLE_NUMBER_OF_LOOKUP_BITS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test over-subscribed code sizes
+	 */
+	number_of_code_sizes = ewf_test_deflate_expand_code_counts(
+	                        ewf_test_deflate_sub_tables_code_counts,
+	                        code_sizes_array );
+
+	code_sizes_array[ number_of_code_sizes++ ] = 15;
+
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          code_sizes_array,
+	          number_of_code_sizes,
+	          LIBEWF_DEFLATE_LITERALS_TABLE_NUMBER_OF_LOOKUP_BITS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test incomplete code sizes
+	 */
+	number_of_code_sizes -= 2;
+
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          code_sizes_array,
+	          number_of_code_sizes,
+	          LIBEWF_DEFLATE_LITERALS_TABLE_NUMBER_OF_LOOKUP_BITS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test code sizes that require more than the maximum number of lookup table entries
+	 */
+	number_of_code_sizes = ewf_test_deflate_expand_code_counts(
+	                        ewf_test_deflate_exhaustion_code_counts,
+	                        code_sizes_array );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_code_sizes",
+	 number_of_code_sizes,
+	 320 );
+
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          code_sizes_array,
+	          number_of_code_sizes,
+	          LIBEWF_DEFLATE_LITERALS_TABLE_NUMBER_OF_LOOKUP_BITS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_deflate_bit_stream_get_huffman_encoded_value function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_bit_stream_get_huffman_encoded_value(
+     void )
+{
+	uint8_t byte_stream[ 512 ];
+	uint16_t code_sizes_array[ 320 ];
+
+	libewf_deflate_bit_stream_t bit_stream;
+	libewf_deflate_huffman_table_t table;
+
+	libcerror_error_t *error = NULL;
+	size_t byte_stream_size  = 0;
+	uint32_t value_32bit     = 0;
+	int number_of_code_sizes = 0;
+	int result               = 0;
+	int symbol               = 0;
+
+	/* Test regular cases
+	 * The symbols are ordered by code size, which are ordered from 1 to 15 bits
+	 */
+	number_of_code_sizes = ewf_test_deflate_expand_code_counts(
+	                        ewf_test_deflate_sub_tables_code_counts,
+	                        code_sizes_array );
+
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          code_sizes_array,
+	          number_of_code_sizes,
+	          LIBEWF_DEFLATE_LITERALS_TABLE_NUMBER_OF_LOOKUP_BITS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	byte_stream_size = ewf_test_deflate_write_huffman_codes(
+	                    code_sizes_array,
+	                    number_of_code_sizes,
+	                    byte_stream,
+	                    512 );
+
+	bit_stream.byte_stream        = byte_stream;
+	bit_stream.byte_stream_size   = byte_stream_size;
+	bit_stream.byte_stream_offset = 0;
+	bit_stream.bit_buffer         = 0;
+	bit_stream.bit_buffer_size    = 0;
+
+	for( symbol = 0;
+	     symbol < number_of_code_sizes;
+	     symbol++ )
+	{
+		result = libewf_deflate_bit_stream_get_huffman_encoded_value(
+		          &bit_stream,
+		          &table,
+		          &value_32bit,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "value_32bit",
+		 value_32bit,
+		 (uint32_t) symbol );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "bit_stream.byte_stream_offset",
+	 bit_stream.byte_stream_offset,
+	 byte_stream_size );
+
+	EWF_TEST_ASSERT_LESS_THAN_INT(
+	 "bit_stream.bit_buffer_size",
+	 (int) bit_stream.bit_buffer_size,
+	 8 );
+
+	/* Test reading beyond the end of the byte stream
+	 */
+	bit_stream.byte_stream_size   = byte_stream_size - 1;
+	bit_stream.byte_stream_offset = byte_stream_size - 2;
+	bit_stream.bit_buffer         = 0;
+	bit_stream.bit_buffer_size    = 0;
+
+	byte_stream[ byte_stream_size - 2 ] = 0xff;
+
+	result = libewf_deflate_bit_stream_get_huffman_encoded_value(
+	          &bit_stream,
+	          &table,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test an invalid Huffman code
+	 * The code 1 is not used by a table of a single code of 1 bit
+	 */
+	memory_set(
+	 code_sizes_array,
+	 0,
+	 sizeof( uint16_t ) * 30 );
+
+	code_sizes_array[ 0 ] = 1;
+
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          code_sizes_array,
+	          30,
+	          LIBEWF_DEFLATE_DISTANCES_TABLE_NUMBER_OF_LOOKUP_BITS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	byte_stream[ 0 ] = 0x02;
+
+	bit_stream.byte_stream_size   = 1;
+	bit_stream.byte_stream_offset = 0;
+	bit_stream.bit_buffer         = 0;
+	bit_stream.bit_buffer_size    = 0;
+
+	result = libewf_deflate_bit_stream_get_huffman_encoded_value(
+	          &bit_stream,
+	          &table,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_deflate_bit_stream_get_huffman_encoded_value(
+	          &bit_stream,
+	          &table,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error cases
+	 */
+	result = libewf_deflate_bit_stream_get_huffman_encoded_value(
+	          NULL,
+	          &table,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_bit_stream_get_huffman_encoded_value(
+	          &bit_stream,
+	          NULL,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_bit_stream_get_huffman_encoded_value(
+	          &bit_stream,
+	          &table,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_deflate_decompress function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_decompress(
+     void )
+{
+	uint8_t uncompressed_data[ 128 ];
+
+	libcerror_error_t *error      = NULL;
+	size_t uncompressed_data_size = 0;
+	int result                    = 0;
+
+	/* Test codes that are larger than the number of lookup bits
+	 */
+	uncompressed_data_size = 128;
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_long_codes_data,
+	          95,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 67 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          uncompressed_data,
+	          ewf_test_deflate_long_codes_uncompressed_data,
+	          67 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test an uncompressed block that follows a fixed Huffman block
+	 */
+	uncompressed_data_size = 128;
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_stored_block_data,
+	          40,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 26 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          uncompressed_data,
+	          "abc0123456789ABCDEFGHIJxyz",
+	          26 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	uncompressed_data_size = 128;
+
+	result = libewf_deflate_decompress(
+	          NULL,
+	          95,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_long_codes_data,
+	          95,
+	          NULL,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_long_codes_data,
+	          95,
+	          uncompressed_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test an uncompressed data buffer that is too small
+	 */
+	uncompressed_data_size = 66;
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_long_codes_data,
+	          95,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	uncompressed_data_size = 25;
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_stored_block_data,
+	          40,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a compressed data stream that is truncated within a code
+	 * that is larger than the number of lookup bits
+	 */
+	uncompressed_data_size = 128;
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_long_codes_data,
+	          30,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test over-subscribed literal code sizes
+	 */
+	uncompressed_data_size = 128;
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_over_subscribed_data,
+	          96,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test incomplete literal code sizes
+	 */
+	uncompressed_data_size = 128;
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_incomplete_data,
+	          69,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a mismatch in the uncompressed block size
+	 */
+	uncompressed_data_size = 128;
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_stored_block_size_mismatch_data,
+	          40,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a compressed data stream that is truncated within an uncompressed block
+	 */
+	uncompressed_data_size = 128;
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_stored_block_data,
+	          20,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+
+/* The buffer sizes to test, these cover empty data, data smaller and larger
+ * than the compression window and common chunk sizes
+ */
+size_t ewf_test_deflate_buffer_sizes[ 8 ] = {
+	0, 1, 257, 4096, 32768, 32769, 65536, 262144 };
+
+/* Tests the libewf_deflate_decompress function with data compressed by zlib
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_decompress_zlib(
+     void )
+{
+	int compression_levels[ 4 ] = {
+		Z_NO_COMPRESSION, Z_BEST_SPEED, Z_DEFAULT_COMPRESSION, Z_BEST_COMPRESSION };
+
+	uint8_t *compressed_data      = NULL;
+	uint8_t *data                 = NULL;
+	uint8_t *uncompressed_data    = NULL;
+	libcerror_error_t *error      = NULL;
+	uLongf compressed_data_size   = 0;
+	size_t buffer_size            = 262144;
+	size_t size                   = 0;
+	size_t uncompressed_data_size = 0;
+	int compression_level_index   = 0;
+	int data_type                 = 0;
+	int result                    = 0;
+	int size_index                = 0;
+
+	data = (uint8_t *) malloc(
+	                    sizeof( uint8_t ) * buffer_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	uncompressed_data = (uint8_t *) malloc(
+	                                 sizeof( uint8_t ) * buffer_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "uncompressed_data",
+	 uncompressed_data );
+
+	compressed_data = (uint8_t *) malloc(
+	                               sizeof( uint8_t ) * compressBound( (uLong) buffer_size ) );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data",
+	 compressed_data );
+
+	/* Test skewed pseudo random data, which results in dynamic Huffman blocks
+	 * with large codes, and data of a repeating pattern, which results in matches
+	 */
+	for( data_type = 0;
+	     data_type < 2;
+	     data_type++ )
+	{
+		if( data_type == 0 )
+		{
+			ewf_test_deflate_fill_buffer(
+			 data,
+			 buffer_size,
+			 0x12345678UL );
+		}
+		else
+		{
+			for( size = 0;
+			     size < buffer_size;
+			     size++ )
+			{
+				data[ size ] = (uint8_t) ( ( size % 251 ) ^ ( size / 4099 ) );
+			}
+		}
+		for( compression_level_index = 0;
+		     compression_level_index < 4;
+		     compression_level_index++ )
+		{
+			for( size_index = 0;
+			     size_index < 8;
+			     size_index++ )
+			{
+				size = ewf_test_deflate_buffer_sizes[ size_index ];
+
+				compressed_data_size = compressBound(
+				                        (uLong) buffer_size );
+
+				result = compress2(
+				          (Bytef *) compressed_data,
+				          &compressed_data_size,
+				          (const Bytef *) data,
+				          (uLong) size,
+				          compression_levels[ compression_level_index ] );
+
+				EWF_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 Z_OK );
+
+				uncompressed_data_size = buffer_size;
+
+				result = libewf_deflate_decompress(
+				          compressed_data,
+				          (size_t) compressed_data_size,
+				          uncompressed_data,
+				          &uncompressed_data_size,
+				          &error );
+
+				EWF_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				EWF_TEST_ASSERT_EQUAL_SIZE(
+				 "uncompressed_data_size",
+				 uncompressed_data_size,
+				 size );
+
+				EWF_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				result = memory_compare(
+				          uncompressed_data,
+				          data,
+				          size );
+
+				EWF_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 0 );
+			}
+		}
+	}
+	free(
+	 compressed_data );
+
+	free(
+	 uncompressed_data );
+
+	free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compressed_data != NULL )
+	{
+		free(
+		 compressed_data );
+	}
+	if( uncompressed_data != NULL )
+	{
+		free(
+		 uncompressed_data );
+	}
+	if( data != NULL )
+	{
+		free(
+		 data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_bit_stream_get_value",
+	 ewf_test_deflate_bit_stream_get_value );
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_huffman_table_construct",
+	 ewf_test_deflate_huffman_table_construct );
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_bit_stream_get_huffman_encoded_value",
+	 ewf_test_deflate_bit_stream_get_huffman_encoded_value );
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_decompress",
+	 ewf_test_deflate_decompress );
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_decompress (zlib)",
+	 ewf_test_deflate_decompress_zlib );
+
+#endif /* defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
@@ -0,0 +1,534 @@
+/*
+ * Library direct file IO handle type testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_direct_file_io_handle.h"
+#include "../libewf/libewf_libbfio.h"
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_DIRECT_FILE_IO_HANDLE )
+
+#define EWF_TEST_DIRECT_FILE_NAME	"ewf_test_direct_file_io_handle.raw"
+
+/* Tests the libewf_direct_file_io_handle_initialize and libewf_direct_file_io_handle_free functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_direct_file_io_handle_initialize(
+     void )
+{
+	libcerror_error_t *error                       = NULL;
+	libewf_direct_file_io_handle_t *file_io_handle = NULL;
+	int result                                     = 0;
+
+	result = libewf_direct_file_io_handle_initialize(
+	          &file_io_handle,
+	          EWF_TEST_DIRECT_FILE_NAME,
+	          34,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_handle->descriptor",
+	 file_io_handle->descriptor,
+	 -1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "file_io_handle->name_size",
+	 file_io_handle->name_size,
+	 (size_t) 35 );
+
+	result = libewf_direct_file_io_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_direct_file_io_handle_initialize(
+	          NULL,
+	          EWF_TEST_DIRECT_FILE_NAME,
+	          34,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_direct_file_io_handle_initialize(
+	          &file_io_handle,
+	          NULL,
+	          34,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_direct_file_io_handle_initialize(
+	          &file_io_handle,
+	          EWF_TEST_DIRECT_FILE_NAME,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_direct_file_io_handle_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libewf_direct_file_io_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_direct_file_io_handle_write, libewf_direct_file_io_handle_seek_offset
+ * and libewf_direct_file_io_handle_read functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_direct_file_io_handle_write_read(
+     void )
+{
+	uint8_t *expected_data                         = NULL;
+	uint8_t *data                                  = NULL;
+	libcerror_error_t *error                       = NULL;
+	libewf_direct_file_io_handle_t *file_io_handle = NULL;
+	size64_t size                                  = 0;
+	size_t data_index                              = 0;
+	size_t data_size                               = 3 * LIBEWF_DIRECT_FILE_BLOCK_SIZE + 1000;
+	ssize_t read_count                             = 0;
+	ssize_t write_count                            = 0;
+	off64_t offset                                 = 0;
+	int result                                     = 0;
+
+	expected_data = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * data_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "expected_data",
+	 expected_data );
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	for( data_index = 0;
+	     data_index < data_size;
+	     data_index++ )
+	{
+		expected_data[ data_index ] = (uint8_t) ( data_index % 251 );
+	}
+	result = libewf_direct_file_io_handle_initialize(
+	          &file_io_handle,
+	          EWF_TEST_DIRECT_FILE_NAME,
+	          34,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_direct_file_io_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_WRITE_TRUNCATE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Write the data in parts that are not block aligned
+	 */
+	write_count = libewf_direct_file_io_handle_write(
+	               file_io_handle,
+	               expected_data,
+	               100,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 100 );
+
+	write_count = libewf_direct_file_io_handle_write(
+	               file_io_handle,
+	               &( expected_data[ 100 ] ),
+	               data_size - 100,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) ( data_size - 100 ) );
+
+	/* Rewrite data in the middle of a block after the buffered data was written
+	 */
+	write_count = libewf_direct_file_io_handle_flush(
+	               file_io_handle,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) data_size );
+
+	expected_data[ 5000 ] = 0xff;
+	expected_data[ 5001 ] = 0xfe;
+
+	offset = libewf_direct_file_io_handle_seek_offset(
+	          file_io_handle,
+	          5000,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 5000 );
+
+	write_count = libewf_direct_file_io_handle_write(
+	               file_io_handle,
+	               &( expected_data[ 5000 ] ),
+	               2,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 2 );
+
+	result = libewf_direct_file_io_handle_get_size(
+	          file_io_handle,
+	          &size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 (uint64_t) size,
+	 (uint64_t) data_size );
+
+	result = libewf_direct_file_io_handle_close(
+	          file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Read the data back, the padding of the last block was truncated
+	 */
+	result = libewf_direct_file_io_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_io_handle->size",
+	 (uint64_t) file_io_handle->size,
+	 (uint64_t) data_size );
+
+	offset = libewf_direct_file_io_handle_seek_offset(
+	          file_io_handle,
+	          10,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 10 );
+
+	read_count = libewf_direct_file_io_handle_read(
+	              file_io_handle,
+	              data,
+	              data_size,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) ( data_size - 10 ) );
+
+	result = memory_compare(
+	          data,
+	          &( expected_data[ 10 ] ),
+	          data_size - 10 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	write_count = libewf_direct_file_io_handle_write(
+	               file_io_handle,
+	               expected_data,
+	               100,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_direct_file_io_handle_read(
+	              NULL,
+	              data,
+	              data_size,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libewf_direct_file_io_handle_seek_offset(
+	          file_io_handle,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_direct_file_io_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	unlink(
+	 EWF_TEST_DIRECT_FILE_NAME );
+
+	memory_free(
+	 data );
+
+	memory_free(
+	 expected_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libewf_direct_file_io_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	unlink(
+	 EWF_TEST_DIRECT_FILE_NAME );
+
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( expected_data != NULL )
+	{
+		memory_free(
+		 expected_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_DIRECT_FILE_IO_HANDLE ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_DIRECT_FILE_IO_HANDLE )
+
+	EWF_TEST_RUN(
+	 "libewf_direct_file_io_handle_initialize",
+	 ewf_test_direct_file_io_handle_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_direct_file_io_handle_write_read",
+	 ewf_test_direct_file_io_handle_write_read );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_DIRECT_FILE_IO_HANDLE ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,370 @@
+/*
+ * Library fill detection functions testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_fill.h"
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* The buffer sizes to test, these cover the SIMD block sizes and common chunk sizes
+ */
+size_t ewf_test_fill_buffer_sizes[ 16 ] = {
+	2, 7, 8, 9, 16, 24, 63, 64, 72, 127, 128, 136, 255, 32768, 32769, 65536 };
+
+/* The 64-bit patterns to test
+ */
+uint8_t ewf_test_fill_patterns[ 3 ][ 8 ] = {
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+	{ 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef },
+	{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } };
+
+/* Determines the reference fill type of a buffer
+ * Returns the fill type
+ */
+uint8_t ewf_test_fill_get_reference_type(
+         const uint8_t *buffer,
+         size_t size )
+{
+	size_t buffer_offset = 0;
+	uint8_t is_zero      = 1;
+	uint8_t is_pattern   = 1;
+
+	if( size <= 1 )
+	{
+		return( LIBEWF_FILL_TYPE_NONE );
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < size;
+	     buffer_offset++ )
+	{
+		if( buffer[ buffer_offset ] != 0 )
+		{
+			is_zero = 0;
+		}
+		if( buffer[ buffer_offset ] != buffer[ buffer_offset % 8 ] )
+		{
+			is_pattern = 0;
+		}
+	}
+	if( is_zero != 0 )
+	{
+		return( LIBEWF_FILL_TYPE_EMPTY_BLOCK );
+	}
+	if( ( is_pattern != 0 )
+	 && ( size > 8 )
+	 && ( ( size % 8 ) == 0 ) )
+	{
+		return( LIBEWF_FILL_TYPE_64_BIT_PATTERN );
+	}
+	return( LIBEWF_FILL_TYPE_NONE );
+}
+
+/* Tests the libewf_fill_get_type function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_fill_get_type(
+     void )
+{
+	uint8_t *buffer           = NULL;
+	libcerror_error_t *error  = NULL;
+	size_t buffer_offset      = 0;
+	size_t buffer_size        = 65536 + 8;
+	size_t data_offset        = 0;
+	size_t size               = 0;
+	uint64_t expected_pattern = 0;
+	uint64_t fill_pattern     = 0;
+	uint64_t pattern          = 0;
+	uint8_t expected_type     = 0;
+	uint8_t fill_type         = 0;
+	int expected_result       = 0;
+	int pattern_index         = 0;
+	int result                = 0;
+	int size_index            = 0;
+	int variant               = 0;
+
+	buffer = (uint8_t *) malloc(
+	                      sizeof( uint8_t ) * buffer_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	/* Test filled buffers, with a differing first, middle and last byte
+	 * and at an unaligned buffer offset
+	 */
+	for( pattern_index = 0;
+	     pattern_index < 3;
+	     pattern_index++ )
+	{
+		memory_copy(
+		 &pattern,
+		 ewf_test_fill_patterns[ pattern_index ],
+		 8 );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ewf_test_fill_patterns[ pattern_index ],
+		 expected_pattern );
+
+		for( size_index = 0;
+		     size_index < 16;
+		     size_index++ )
+		{
+			size = ewf_test_fill_buffer_sizes[ size_index ];
+
+			for( variant = 0;
+			     variant < 5;
+			     variant++ )
+			{
+				/* Variant 4 stores the pattern at an unaligned buffer offset
+				 */
+				data_offset = ( variant == 4 ) ? 1 : 0;
+
+				for( buffer_offset = 0;
+				     buffer_offset < size;
+				     buffer_offset++ )
+				{
+					buffer[ data_offset + buffer_offset ] = ewf_test_fill_patterns[ pattern_index ][ buffer_offset % 8 ];
+				}
+				if( variant == 1 )
+				{
+					buffer[ 0 ] ^= 0x10;
+				}
+				else if( variant == 2 )
+				{
+					buffer[ size / 2 ] ^= 0x10;
+				}
+				else if( variant == 3 )
+				{
+					buffer[ size - 1 ] ^= 0x10;
+				}
+				expected_type = ewf_test_fill_get_reference_type(
+				                 &( buffer[ data_offset ] ),
+				                 size );
+
+				result = libewf_fill_get_type(
+				          &( buffer[ data_offset ] ),
+				          size,
+				          &fill_type,
+				          &fill_pattern,
+				          &error );
+
+				EWF_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				EWF_TEST_ASSERT_EQUAL_INT(
+				 "fill_type",
+				 (int) fill_type,
+				 (int) expected_type );
+
+				EWF_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+
+				if( expected_type == LIBEWF_FILL_TYPE_64_BIT_PATTERN )
+				{
+					EWF_TEST_ASSERT_EQUAL_UINT64(
+					 "fill_pattern",
+					 fill_pattern,
+					 expected_pattern );
+				}
+				/* The implementations compare all the data with the pattern
+				 */
+				expected_result = ( variant == 0 ) || ( variant == 4 );
+
+				result = libewf_fill_compare_pattern_scalar(
+				          &( buffer[ data_offset ] ),
+				          size,
+				          pattern );
+
+				EWF_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 expected_result );
+
+#if defined( LIBEWF_FILL_HAVE_X86_SIMD )
+				if( __builtin_cpu_supports( "sse2" ) )
+				{
+					result = libewf_fill_compare_pattern_sse2(
+					          &( buffer[ data_offset ] ),
+					          size,
+					          pattern );
+
+					EWF_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 expected_result );
+				}
+				if( __builtin_cpu_supports( "avx2" ) )
+				{
+					result = libewf_fill_compare_pattern_avx2(
+					          &( buffer[ data_offset ] ),
+					          size,
+					          pattern );
+
+					EWF_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 expected_result );
+				}
+#endif /* defined( LIBEWF_FILL_HAVE_X86_SIMD ) */
+
+#if defined( LIBEWF_FILL_HAVE_NEON )
+				result = libewf_fill_compare_pattern_neon(
+				          &( buffer[ data_offset ] ),
+				          size,
+				          pattern );
+
+				EWF_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 expected_result );
+#endif /* defined( LIBEWF_FILL_HAVE_NEON ) */
+			}
+		}
+	}
+	/* Test error cases
+	 */
+	result = libewf_fill_get_type(
+	          NULL,
+	          buffer_size,
+	          &fill_type,
+	          &fill_pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_fill_get_type(
+	          buffer,
+	          buffer_size,
+	          NULL,
+	          &fill_pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_fill_get_type(
+	          buffer,
+	          buffer_size,
+	          &fill_type,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer != NULL )
+	{
+		free(
+		 buffer );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_fill_get_type",
+	 ewf_test_fill_get_type );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,629 @@
+/*
+ * EWF image functions for testing
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_image.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+
+/* Retrieves the type of a specific chunk in the generated media data
+ * Returns the chunk type
+ */
+int ewf_test_image_get_chunk_type(
+     uint64_t chunk_index )
+{
+	return( (int) ( chunk_index % EWF_TEST_IMAGE_NUMBER_OF_CHUNK_TYPES ) );
+}
+
+/* Generates the media data of a test image
+ * The chunks of the media data alternate between an empty block, text,
+ * random data and a 64-bit pattern fill, so that the image contains
+ * compressed, uncompressed and fill chunks
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_image_generate_media_data(
+     uint8_t *media_data,
+     size_t media_size,
+     libcerror_error_t **error )
+{
+	const char *text           = "The quick brown fox jumps over the lazy dog.\n";
+	static char *function      = "ewf_test_image_generate_media_data";
+	size_t chunk_data_size     = 0;
+	size_t data_offset         = 0;
+	size_t media_offset        = 0;
+	size_t text_length         = 0;
+	uint64_t chunk_index       = 0;
+	uint64_t pattern           = 0;
+	uint32_t random_value      = 0x12345678UL;
+
+	if( media_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media data.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid media size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	text_length = narrow_string_length(
+	               text );
+
+	while( media_offset < media_size )
+	{
+		chunk_data_size = media_size - media_offset;
+
+		if( chunk_data_size > EWF_TEST_IMAGE_CHUNK_SIZE )
+		{
+			chunk_data_size = EWF_TEST_IMAGE_CHUNK_SIZE;
+		}
+		switch( ewf_test_image_get_chunk_type(
+		         chunk_index ) )
+		{
+			case EWF_TEST_IMAGE_CHUNK_TYPE_EMPTY_BLOCK:
+				if( memory_set(
+				     &( media_data[ media_offset ] ),
+				     0,
+				     chunk_data_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				break;
+
+			case EWF_TEST_IMAGE_CHUNK_TYPE_TEXT:
+				for( data_offset = 0;
+				     data_offset < chunk_data_size;
+				     data_offset++ )
+				{
+					media_data[ media_offset + data_offset ] = (uint8_t) text[ data_offset % text_length ];
+				}
+				/* Make sure the text chunks differ from each other
+				 */
+				if( chunk_data_size >= 8 )
+				{
+					byte_stream_copy_from_uint64_little_endian(
+					 &( media_data[ media_offset ] ),
+					 chunk_index );
+				}
+				break;
+
+			case EWF_TEST_IMAGE_CHUNK_TYPE_RANDOM:
+				for( data_offset = 0;
+				     data_offset < chunk_data_size;
+				     data_offset++ )
+				{
+					/* A xorshift generator provides data that cannot be compressed
+					 */
+					random_value ^= random_value << 13;
+					random_value ^= random_value >> 17;
+					random_value ^= random_value << 5;
+
+					media_data[ media_offset + data_offset ] = (uint8_t) ( random_value >> 24 );
+				}
+				break;
+
+			case EWF_TEST_IMAGE_CHUNK_TYPE_PATTERN_FILL:
+				pattern = 0x0123456789abcdefULL + chunk_index;
+
+				for( data_offset = 0;
+				     data_offset < chunk_data_size;
+				     data_offset++ )
+				{
+					media_data[ media_offset + data_offset ] = (uint8_t) ( pattern >> ( ( data_offset % 8 ) * 8 ) );
+				}
+				break;
+		}
+		media_offset += chunk_data_size;
+
+		chunk_index++;
+	}
+	return( 1 );
+}
+
+/* Retrieves the filename of the first segment file of a test image
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_image_get_first_segment_filename(
+     const char *filename,
+     uint8_t format,
+     char *segment_filename,
+     size_t segment_filename_size,
+     libcerror_error_t **error )
+{
+	const char *extension  = ".E01";
+	static char *function  = "ewf_test_image_get_first_segment_filename";
+	size_t extension_size  = 5;
+	size_t filename_length = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( format == LIBEWF_FORMAT_V2_ENCASE7 )
+	{
+		extension      = ".Ex01";
+		extension_size = 6;
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( ( filename_length + extension_size ) > segment_filename_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid segment filename size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( narrow_string_copy(
+	     segment_filename,
+	     filename,
+	     filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( narrow_string_copy(
+	     &( segment_filename[ filename_length ] ),
+	     extension,
+	     extension_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy extension.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes the media data to a test image
+ * The filename is the base of the segment filenames
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_image_write(
+     const char *filename,
+     uint8_t format,
+     const uint8_t *media_data,
+     size64_t media_size,
+     size64_t maximum_segment_size,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle = NULL;
+	static char *function   = "ewf_test_image_write";
+	size64_t media_offset   = 0;
+	size_t write_size       = 0;
+	ssize_t write_count     = 0;
+
+	if( media_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_open(
+	     handle,
+	     (char * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_format(
+	     handle,
+	     format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set format.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( maximum_segment_size > 0 )
+	{
+		if( libewf_handle_set_maximum_segment_size(
+		     handle,
+		     maximum_segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum segment size.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     compression_level,
+	     compression_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compression values.",
+		 function );
+
+		goto on_error;
+	}
+	while( media_offset < media_size )
+	{
+		write_size = EWF_TEST_IMAGE_CHUNK_SIZE;
+
+		if( (size64_t) write_size > ( media_size - media_offset ) )
+		{
+			write_size = (size_t) ( media_size - media_offset );
+		}
+		write_count = libewf_handle_write_buffer(
+		               handle,
+		               &( media_data[ media_offset ] ),
+		               write_size,
+		               error );
+
+		if( write_count != (ssize_t) write_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer at offset: %" PRIu64 ".",
+			 function,
+			 media_offset );
+
+			goto on_error;
+		}
+		media_offset += write_size;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens a test image for reading
+ * The filename is the base of the segment filenames
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_image_open(
+     libewf_handle_t *handle,
+     const char *filename,
+     uint8_t format,
+     libcerror_error_t **error )
+{
+	char segment_filename[ 256 ];
+
+	char **filenames        = NULL;
+	static char *function   = "ewf_test_image_open";
+	int number_of_filenames = 0;
+
+	if( ewf_test_image_get_first_segment_filename(
+	     filename,
+	     format,
+	     segment_filename,
+	     256,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first segment filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_glob(
+	     segment_filename,
+	     narrow_string_length(
+	      segment_filename ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to glob filenames.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free globbed filenames.",
+		 function );
+
+		filenames = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( filenames != NULL )
+	{
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Removes the segment files of a test image
+ * The filename is the base of the segment filenames
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_image_remove(
+     const char *filename,
+     uint8_t format,
+     libcerror_error_t **error )
+{
+	char segment_filename[ 256 ];
+
+	char **filenames        = NULL;
+	static char *function   = "ewf_test_image_remove";
+	int filename_index      = 0;
+	int number_of_filenames = 0;
+	int result              = 1;
+
+	if( ewf_test_image_get_first_segment_filename(
+	     filename,
+	     format,
+	     segment_filename,
+	     256,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first segment filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_glob(
+	     segment_filename,
+	     narrow_string_length(
+	      segment_filename ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to glob filenames.",
+		 function );
+
+		return( -1 );
+	}
+	for( filename_index = 0;
+	     filename_index < number_of_filenames;
+	     filename_index++ )
+	{
+		if( remove(
+		     filenames[ filename_index ] ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 "%s: unable to remove: %s.",
+			 function,
+			 filenames[ filename_index ] );
+
+			result = -1;
+		}
+	}
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free globbed filenames.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
@@ -0,0 +1,94 @@
+/*
+ * EWF image functions for testing
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EWF_TEST_IMAGE_H )
+#define _EWF_TEST_IMAGE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The chunk size of the test images, which is the libewf default
+ */
+#define EWF_TEST_IMAGE_CHUNK_SIZE	32768
+
+/* The types of the chunks in the generated media data
+ */
+enum EWF_TEST_IMAGE_CHUNK_TYPES
+{
+	EWF_TEST_IMAGE_CHUNK_TYPE_EMPTY_BLOCK	= 0,
+	EWF_TEST_IMAGE_CHUNK_TYPE_TEXT		= 1,
+	EWF_TEST_IMAGE_CHUNK_TYPE_RANDOM	= 2,
+	EWF_TEST_IMAGE_CHUNK_TYPE_PATTERN_FILL	= 3
+};
+
+/* The number of chunk types in the generated media data
+ */
+#define EWF_TEST_IMAGE_NUMBER_OF_CHUNK_TYPES	4
+
+int ewf_test_image_get_chunk_type(
+     uint64_t chunk_index );
+
+int ewf_test_image_generate_media_data(
+     uint8_t *media_data,
+     size_t media_size,
+     libcerror_error_t **error );
+
+int ewf_test_image_get_first_segment_filename(
+     const char *filename,
+     uint8_t format,
+     char *segment_filename,
+     size_t segment_filename_size,
+     libcerror_error_t **error );
+
+int ewf_test_image_write(
+     const char *filename,
+     uint8_t format,
+     const uint8_t *media_data,
+     size64_t media_size,
+     size64_t maximum_segment_size,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     libcerror_error_t **error );
+
+int ewf_test_image_open(
+     libewf_handle_t *handle,
+     const char *filename,
+     uint8_t format,
+     libcerror_error_t **error );
+
+int ewf_test_image_remove(
+     const char *filename,
+     uint8_t format,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EWF_TEST_IMAGE_H ) */
+
@@ -0,0 +1,444 @@
+/*
+ * Library parallel open testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_image.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#define EWF_TEST_PARALLEL_OPEN_FILENAME			"ewf_test_parallel_open"
+
+/* The image is stored in more segment files than are read in parallel at once
+ * every segment file contains a single uncompressed chunk
+ */
+#define EWF_TEST_PARALLEL_OPEN_MEDIA_SIZE		( 48 * EWF_TEST_IMAGE_CHUNK_SIZE )
+#define EWF_TEST_PARALLEL_OPEN_MAXIMUM_SEGMENT_SIZE	( 64 * 1024 )
+
+/* Writes the test image
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_parallel_open_write_image(
+     uint8_t *media_data )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	result = ewf_test_image_generate_media_data(
+	          media_data,
+	          EWF_TEST_PARALLEL_OPEN_MEDIA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_image_write(
+	          EWF_TEST_PARALLEL_OPEN_FILENAME,
+	          LIBEWF_FORMAT_ENCASE6,
+	          media_data,
+	          EWF_TEST_PARALLEL_OPEN_MEDIA_SIZE,
+	          EWF_TEST_PARALLEL_OPEN_MAXIMUM_SEGMENT_SIZE,
+	          LIBEWF_COMPRESSION_NONE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests opening an image that consists of multiple segment files
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_parallel_open_read(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libewf_handle_t *handle  = NULL;
+	uint8_t *media_data      = NULL;
+	uint8_t *read_data       = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	int result               = 0;
+
+	media_data = (uint8_t *) memory_allocate(
+	                          EWF_TEST_PARALLEL_OPEN_MEDIA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "media_data",
+	 media_data );
+
+	read_data = (uint8_t *) memory_allocate(
+	                         EWF_TEST_PARALLEL_OPEN_MEDIA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_data",
+	 read_data );
+
+	result = ewf_test_parallel_open_write_image(
+	          media_data );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test open
+	 */
+	result = libewf_handle_initialize(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_image_open(
+	          handle,
+	          EWF_TEST_PARALLEL_OPEN_FILENAME,
+	          LIBEWF_FORMAT_ENCASE6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "media_size",
+	 media_size,
+	 (size64_t) EWF_TEST_PARALLEL_OPEN_MEDIA_SIZE );
+
+	/* The chunks of every segment file are available after open
+	 */
+	read_count = libewf_handle_read_buffer(
+	              handle,
+	              read_data,
+	              EWF_TEST_PARALLEL_OPEN_MEDIA_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) EWF_TEST_PARALLEL_OPEN_MEDIA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          read_data,
+	          media_data,
+	          EWF_TEST_PARALLEL_OPEN_MEDIA_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libewf_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_image_remove(
+	          EWF_TEST_PARALLEL_OPEN_FILENAME,
+	          LIBEWF_FORMAT_ENCASE6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	memory_free(
+	 read_data );
+
+	memory_free(
+	 media_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	ewf_test_image_remove(
+	 EWF_TEST_PARALLEL_OPEN_FILENAME,
+	 LIBEWF_FORMAT_ENCASE6,
+	 NULL );
+
+	if( read_data != NULL )
+	{
+		memory_free(
+		 read_data );
+	}
+	if( media_data != NULL )
+	{
+		memory_free(
+		 media_data );
+	}
+	return( 0 );
+}
+
+/* Tests opening an image with a corrupted segment file
+ * A segment file that cannot be read in parallel is read again sequentially,
+ * which fails as well and causes the open to fail
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_parallel_open_corrupted_segment_file(
+     void )
+{
+	uint8_t corrupted_data[ 8 ] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+	libcerror_error_t *error    = NULL;
+	libewf_handle_t *handle     = NULL;
+	FILE *file_stream           = NULL;
+	uint8_t *media_data         = NULL;
+	size_t write_count          = 0;
+	int result                  = 0;
+
+	media_data = (uint8_t *) memory_allocate(
+	                          EWF_TEST_PARALLEL_OPEN_MEDIA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "media_data",
+	 media_data );
+
+	result = ewf_test_parallel_open_write_image(
+	          media_data );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Overwrite the signature of the third segment file
+	 */
+	file_stream = file_stream_open(
+	               EWF_TEST_PARALLEL_OPEN_FILENAME ".E03",
+	               "r+b" );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_stream",
+	 file_stream );
+
+	write_count = file_stream_write(
+	               file_stream,
+	               corrupted_data,
+	               8 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "write_count",
+	 write_count,
+	 (size_t) 8 );
+
+	result = file_stream_close(
+	          file_stream );
+
+	file_stream = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test open
+	 */
+	result = libewf_handle_initialize(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_image_open(
+	          handle,
+	          EWF_TEST_PARALLEL_OPEN_FILENAME,
+	          LIBEWF_FORMAT_ENCASE6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_image_remove(
+	          EWF_TEST_PARALLEL_OPEN_FILENAME,
+	          LIBEWF_FORMAT_ENCASE6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	memory_free(
+	 media_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	ewf_test_image_remove(
+	 EWF_TEST_PARALLEL_OPEN_FILENAME,
+	 LIBEWF_FORMAT_ENCASE6,
+	 NULL );
+
+	if( media_data != NULL )
+	{
+		memory_free(
+		 media_data );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "libewf_handle_open",
+	 ewf_test_parallel_open_read );
+
+	EWF_TEST_RUN(
+	 "libewf_handle_open (corrupted segment file)",
+	 ewf_test_parallel_open_corrupted_segment_file );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
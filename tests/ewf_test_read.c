@@ -178,6 +178,8 @@ int ewf_test_read_buffer_at_offset(
 	uint8_t buffer[ EWF_TEST_READ_BUFFER_SIZE ];
 
 	libcerror_error_t *error = NULL;
+	off64_t current_offset   = 0;
+	off64_t read_offset      = 0;
 	off64_t result_offset    = 0;
 	size64_t remaining_size  = 0;
 	size64_t result_size     = 0;
@@ -190,6 +192,7 @@ int ewf_test_read_buffer_at_offset(
 		return( -1 );
 	}
 	remaining_size = input_size;
+	read_offset    = input_offset;
 
 	fprintf(
 	 stdout,
@@ -197,58 +200,77 @@ int ewf_test_read_buffer_at_offset(
 	 input_offset,
 	 input_size );
 
-	while( remaining_size > 0 )
-	{
-		read_size = EWF_TEST_READ_BUFFER_SIZE;
+	result = libewf_handle_get_offset(
+	          handle,
+	          &current_offset,
+	          &error );
 
-		if( remaining_size < (size64_t) read_size )
+	if( result == 1 )
+	{
+		while( remaining_size > 0 )
 		{
-			read_size = (size_t) remaining_size;
+			read_size = EWF_TEST_READ_BUFFER_SIZE;
+
+			if( remaining_size < (size64_t) read_size )
+			{
+				read_size = (size_t) remaining_size;
+			}
+			read_count = libewf_handle_read_buffer_at_offset(
+				      handle,
+				      buffer,
+				      read_size,
+				      read_offset,
+				      &error );
+
+			if( read_count <= 0 )
+			{
+				break;
+			}
+			read_offset    += (off64_t) read_count;
+			remaining_size -= (size64_t) read_count;
+			result_size    += (size64_t) read_count;
+
+			if( read_count != (ssize_t) read_size )
+			{
+				break;
+			}
 		}
-		read_count = libewf_handle_read_buffer_at_offset(
-			      handle,
-			      buffer,
-			      read_size,
-			      input_offset,
-			      &error );
+		/* Reading at a specific offset should not change the current offset
+		 */
+		result = libewf_handle_get_offset(
+		          handle,
+		          &result_offset,
+		          &error );
+	}
+	if( result == 1 )
+	{
+		result = 0;
 
-		if( read_count <= 0 )
+		if( current_offset != result_offset )
 		{
-			break;
+			fprintf(
+			 stderr,
+			 "Unexpected current offset: %" PRIi64 "\n",
+			 result_offset );
 		}
-		input_offset   += (size64_t) read_count;
-		remaining_size -= (size64_t) read_count;
-		result_size    += (size64_t) read_count;
-
-		if( read_count != (ssize_t) read_size )
+		else if( expected_offset != ( input_offset + (off64_t) result_size ) )
 		{
-			break;
+			fprintf(
+			 stderr,
+			 "Unexpected offset: %" PRIi64 "\n",
+			 input_offset + (off64_t) result_size );
+		}
+		else if( expected_size != result_size )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected read count: %" PRIu64 "\n",
+			 result_size );
+		}
+		else
+		{
+			result = 1;
 		}
-	}
-	if( libewf_handle_get_offset(
-	     handle,
-	     &result_offset,
-	     &error ) != 1 )
-	{
-		result = -1;
-	}
-	if( expected_offset != result_offset )
-	{
-		fprintf(
-		 stderr,
-		 "Unexpected offset: %" PRIi64 "\n",
-		 result_offset );
-	}
-	else if( expected_size != result_size )
-	{
-		fprintf(
-		 stderr,
-		 "Unexpected read count: %" PRIu64 "\n",
-		 result_size );
-	}
-	else
-	{
-		result = 1;
 	}
 	if( result == 1 )
 	{
@@ -0,0 +1,469 @@
+/*
+ * Library write-behind buffer type testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_write_behind_buffer.h"
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_write_behind_buffer_initialize and libewf_write_behind_buffer_free functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_behind_buffer_initialize(
+     void )
+{
+	libcerror_error_t *error                          = NULL;
+	libewf_write_behind_buffer_t *write_behind_buffer = NULL;
+	int result                                        = 0;
+
+	result = libewf_write_behind_buffer_initialize(
+	          &write_behind_buffer,
+	          LIBEWF_DEFAULT_WRITE_BEHIND_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_behind_buffer",
+	 write_behind_buffer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The data is allocated when it is first written
+	 */
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_behind_buffer->data",
+	 write_behind_buffer->data );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "write_behind_buffer->maximum_data_size",
+	 write_behind_buffer->maximum_data_size,
+	 (size_t) LIBEWF_DEFAULT_WRITE_BEHIND_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "write_behind_buffer->file_io_pool_entry",
+	 write_behind_buffer->file_io_pool_entry,
+	 -1 );
+
+	result = libewf_write_behind_buffer_free(
+	          &write_behind_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_behind_buffer",
+	 write_behind_buffer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_write_behind_buffer_initialize(
+	          NULL,
+	          LIBEWF_DEFAULT_WRITE_BEHIND_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_behind_buffer_initialize(
+	          &write_behind_buffer,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_behind_buffer_initialize(
+	          &write_behind_buffer,
+	          (size_t) LIBEWF_MAXIMUM_WRITE_BEHIND_SIZE + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_behind_buffer_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( write_behind_buffer != NULL )
+	{
+		libewf_write_behind_buffer_free(
+		 &write_behind_buffer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_write_behind_buffer_write_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_behind_buffer_write_buffer(
+     void )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error                          = NULL;
+	libewf_write_behind_buffer_t *write_behind_buffer = NULL;
+	ssize_t write_count                               = 0;
+	int result                                        = 0;
+
+	result = libewf_write_behind_buffer_initialize(
+	          &write_behind_buffer,
+	          LIBEWF_DEFAULT_WRITE_BEHIND_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* A buffer that fits in the write-behind buffer is written without accessing the file IO pool
+	 */
+	write_count = libewf_write_behind_buffer_write_buffer(
+	               write_behind_buffer,
+	               NULL,
+	               0,
+	               buffer,
+	               16,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 16 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "write_behind_buffer->data_size",
+	 write_behind_buffer->data_size,
+	 (size_t) 16 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "write_behind_buffer->file_io_pool_entry",
+	 write_behind_buffer->file_io_pool_entry,
+	 0 );
+
+	/* Test error cases
+	 */
+	write_count = libewf_write_behind_buffer_write_buffer(
+	               NULL,
+	               NULL,
+	               0,
+	               buffer,
+	               16,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_write_behind_buffer_write_buffer(
+	               write_behind_buffer,
+	               NULL,
+	               0,
+	               NULL,
+	               16,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_write_behind_buffer_write_buffer(
+	               write_behind_buffer,
+	               NULL,
+	               0,
+	               buffer,
+	               (size_t) SSIZE_MAX + 1,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_write_behind_buffer_write_buffer(
+	               write_behind_buffer,
+	               NULL,
+	               -1,
+	               buffer,
+	               16,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_behind_buffer_free(
+	          &write_behind_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( write_behind_buffer != NULL )
+	{
+		libewf_write_behind_buffer_free(
+		 &write_behind_buffer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_write_behind_buffer_flush function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_behind_buffer_flush(
+     void )
+{
+	libcerror_error_t *error                          = NULL;
+	libewf_write_behind_buffer_t *write_behind_buffer = NULL;
+	ssize_t write_count                               = 0;
+	int result                                        = 0;
+
+	result = libewf_write_behind_buffer_initialize(
+	          &write_behind_buffer,
+	          LIBEWF_DEFAULT_WRITE_BEHIND_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* An empty write-behind buffer is flushed without accessing the file IO pool
+	 */
+	write_count = libewf_write_behind_buffer_flush(
+	               write_behind_buffer,
+	               NULL,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	write_count = libewf_write_behind_buffer_flush(
+	               NULL,
+	               NULL,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_behind_buffer_free(
+	          &write_behind_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( write_behind_buffer != NULL )
+	{
+		libewf_write_behind_buffer_free(
+		 &write_behind_buffer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_write_behind_buffer_initialize",
+	 ewf_test_write_behind_buffer_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_write_behind_buffer_write_buffer",
+	 ewf_test_write_behind_buffer_write_buffer );
+
+	EWF_TEST_RUN(
+	 "libewf_write_behind_buffer_flush",
+	 ewf_test_write_behind_buffer_flush );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
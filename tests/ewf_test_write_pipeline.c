@@ -0,0 +1,568 @@
+/*
+ * Library write pipeline type testing program
+ *
+ * Copyright (C) 2006-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_io_handle.h"
+#include "../libewf/libewf_write_pipeline.h"
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* The chunk size used by the tests
+ */
+#define EWF_TEST_WRITE_PIPELINE_CHUNK_SIZE	32768
+
+/* Tests the libewf_write_pipeline_initialize and libewf_write_pipeline_free functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_pipeline_initialize(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libewf_io_handle_t *io_handle           = NULL;
+	libewf_write_pipeline_t *write_pipeline = NULL;
+	int result                              = 0;
+
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_write_pipeline_initialize(
+	          &write_pipeline,
+	          io_handle,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_pipeline",
+	 write_pipeline );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "write_pipeline->number_of_entries",
+	 write_pipeline->number_of_entries,
+	 2 * LIBEWF_WRITE_PIPELINE_NUMBER_OF_CHUNKS_PER_THREAD );
+
+	result = libewf_write_pipeline_free(
+	          &write_pipeline,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_pipeline",
+	 write_pipeline );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_write_pipeline_initialize(
+	          NULL,
+	          io_handle,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_pipeline_initialize(
+	          &write_pipeline,
+	          NULL,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_pipeline_initialize(
+	          &write_pipeline,
+	          io_handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_pipeline_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( write_pipeline != NULL )
+	{
+		libewf_write_pipeline_free(
+		 &write_pipeline,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_write_pipeline_push_chunk and libewf_write_pipeline_pop_chunk functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_pipeline_push_chunk(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libewf_chunk_data_t *chunk_data         = NULL;
+	libewf_io_handle_t *io_handle           = NULL;
+	libewf_write_pipeline_t *write_pipeline = NULL;
+	size_t input_data_size                  = 0;
+	uint64_t chunk_index                    = 0;
+	uint64_t expected_chunk_index           = 0;
+	int result                              = 0;
+
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	io_handle->chunk_size = EWF_TEST_WRITE_PIPELINE_CHUNK_SIZE;
+
+	result = libewf_write_pipeline_initialize(
+	          &write_pipeline,
+	          io_handle,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Fill the write pipeline with chunks of compressible data
+	 */
+	for( chunk_index = 0;
+	     chunk_index < (uint64_t) write_pipeline->number_of_entries;
+	     chunk_index++ )
+	{
+		result = libewf_chunk_data_initialize(
+		          &chunk_data,
+		          EWF_TEST_WRITE_PIPELINE_CHUNK_SIZE,
+		          NULL,
+		          1,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		chunk_data->data_size = EWF_TEST_WRITE_PIPELINE_CHUNK_SIZE;
+
+		result = libewf_write_pipeline_push_chunk(
+		          write_pipeline,
+		          chunk_index,
+		          chunk_data,
+		          chunk_data->data_size,
+		          LIBEWF_COMPRESSION_DEFAULT,
+		          NULL,
+		          0,
+		          0,
+		          &error );
+
+		chunk_data = NULL;
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_write_pipeline_is_full(
+	          write_pipeline,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* A chunk cannot be pushed onto a full write pipeline
+	 */
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          EWF_TEST_WRITE_PIPELINE_CHUNK_SIZE,
+	          NULL,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_write_pipeline_push_chunk(
+	          write_pipeline,
+	          chunk_index,
+	          chunk_data,
+	          EWF_TEST_WRITE_PIPELINE_CHUNK_SIZE,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          NULL,
+	          0,
+	          0,
+	          &error );
+
+	chunk_data = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The chunks are retrieved packed and in order
+	 */
+	for( expected_chunk_index = 0;
+	     expected_chunk_index < (uint64_t) write_pipeline->number_of_entries;
+	     expected_chunk_index++ )
+	{
+		result = libewf_write_pipeline_pop_chunk(
+		          write_pipeline,
+		          1,
+		          &chunk_index,
+		          &chunk_data,
+		          &input_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "chunk_index",
+		 chunk_index,
+		 expected_chunk_index );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "input_data_size",
+		 input_data_size,
+		 (size_t) EWF_TEST_WRITE_PIPELINE_CHUNK_SIZE );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "chunk_data",
+		 chunk_data );
+
+		result = ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0;
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "chunk data is packed",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_LESS_THAN_INT(
+		 "chunk_data->data_size",
+		 (int) chunk_data->data_size,
+		 EWF_TEST_WRITE_PIPELINE_CHUNK_SIZE );
+
+		result = libewf_chunk_data_free(
+		          &chunk_data,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	/* No chunk is retrieved from an empty write pipeline
+	 */
+	result = libewf_write_pipeline_pop_chunk(
+	          write_pipeline,
+	          1,
+	          &chunk_index,
+	          &chunk_data,
+	          &input_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_write_pipeline_push_chunk(
+	          write_pipeline,
+	          0,
+	          NULL,
+	          0,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          NULL,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_pipeline_pop_chunk(
+	          NULL,
+	          1,
+	          &chunk_index,
+	          &chunk_data,
+	          &input_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_pipeline_pop_chunk(
+	          write_pipeline,
+	          1,
+	          &chunk_index,
+	          NULL,
+	          &input_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_pipeline_free(
+	          &write_pipeline,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( write_pipeline != NULL )
+	{
+		libewf_write_pipeline_free(
+		 &write_pipeline,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_write_pipeline_initialize",
+	 ewf_test_write_pipeline_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_write_pipeline_push_chunk",
+	 ewf_test_write_pipeline_push_chunk );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
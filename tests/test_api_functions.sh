@@ -11,7 +11,7 @@ TEST_PREFIX=`dirname ${PWD}`;
 TEST_PREFIX=`basename ${TEST_PREFIX} | sed 's/^lib\([^-]*\).*$/\1/'`;
 
 TEST_PROFILE="lib${TEST_PREFIX}";
-TEST_FUNCTIONS="error notify support";
+TEST_FUNCTIONS="buffer_pool checksum chunk_descriptor chunk_index coalesced_read_buffer compression data_chunk deflate direct_file_io_handle error fill notify parallel_open support write_behind_buffer write_pipeline";
 TEST_FUNCTIONS_WITH_INPUT="open_close seek read";
 OPTION_SETS="";
 